@@ -0,0 +1,221 @@
+"""Numerical regression of the mixed precision build of SEIMS against the float64 build.
+
+    SEIMS can be built as (see the root CMakeLists.txt):
+      - float32 build (default), all floating point data are float;
+      - float64 build (`-DFLOAT64=1`), all floating point data are double;
+      - mixed precision build (`-DMIXED_PRECISION=1`), bulk per-cell data are float, while
+        accumulators (e.g., aggregated outputs and channel storages) are double.
+
+    This script compares the outputs of a candidate build (e.g., mixed precision) with the
+    outputs of a reference build (float64) of the same model and scenario, including:
+      - Time series text outputs, e.g., `Q.txt`, `CH_TN.txt`. Both the maximum relative error
+        of daily values and the relative error of the cumulative sum (i.e., mass balance
+        closure over the simulation period) are reported.
+      - Raster outputs in ASCII format (`*.asc`), or GeoTiff (`*.tif`) if GDAL is available.
+
+    The synthetic watershed of `seims_benchmark` (`-DBENCHMARK=1`) can be used to produce
+    identical runs of both builds without MongoDB, e.g.,
+        seims_benchmark -wp /tmp/bench_f64 -param model_param_ini.csv -days 3650 -save 1
+        seims_benchmark -wp /tmp/bench_mixed -param model_param_ini.csv -days 3650 -save 1
+        python compare_precision.py -r /tmp/bench_f64/OUTPUT_D8_UP_DOWN-- \
+                                    -c /tmp/bench_mixed/OUTPUT_D8_UP_DOWN--
+
+    The exit code is 0 if all compared outputs are within the tolerances, otherwise 1.
+
+    Usage:
+        python compare_precision.py -r <reference_outputs> -c <candidate_outputs>
+                                    [-rtol 1e-3] [-btol 1e-4] [-atol 1e-6] [-o report.json]
+
+    @author   : Liangjun Zhu
+
+    @changelog:
+    - 26-10-19  - lj - initial implementation.
+"""
+from __future__ import absolute_import, print_function, unicode_literals
+
+import argparse
+import json
+import math
+import os
+import sys
+
+
+def read_timeseries(filename):
+    """Read time series text output of PrintInfoItem.
+
+    Returns:
+        dict of {datetime string: [values]}, header lines are skipped.
+    """
+    data = dict()
+    with open(filename, 'r') as f:
+        for line in f:
+            items = line.split()
+            if len(items) < 3:
+                continue
+            try:
+                values = [float(v) for v in items[2:]]
+            except ValueError:
+                continue
+            data['%s %s' % (items[0], items[1])] = values
+    return data
+
+
+def read_raster(filename):
+    """Read raster as a flatten list of (value or None for nodata)."""
+    if filename.lower().endswith('.asc'):
+        nodata = None
+        values = list()
+        with open(filename, 'r') as f:
+            for line in f:
+                items = line.split()
+                if not items:
+                    continue
+                key = items[0].lower()
+                if key in ['ncols', 'nrows', 'xllcorner', 'yllcorner', 'xllcenter',
+                           'yllcenter', 'cellsize']:
+                    continue
+                if key == 'nodata_value':
+                    nodata = float(items[1])
+                    continue
+                values.extend(float(v) for v in items)
+        return [None if nodata is not None and v == nodata else v for v in values]
+    try:
+        from osgeo import gdal
+    except ImportError:
+        return None
+    ds = gdal.Open(filename)
+    if ds is None:
+        return None
+    values = list()
+    for band_idx in range(1, ds.RasterCount + 1):
+        band = ds.GetRasterBand(band_idx)
+        nodata = band.GetNoDataValue()
+        for row in band.ReadAsArray().tolist():
+            values.extend(None if nodata is not None and v == nodata else v for v in row)
+    return values
+
+
+class Metrics(object):
+    """Error metrics of candidate values against reference values."""
+
+    def __init__(self, atol):
+        self.atol = atol
+        self.count = 0
+        self.mismatch = 0  # valid in one output but not the other
+        self.max_abs = 0.
+        self.max_rel = 0.
+        self.sum_ref = 0.
+        self.sum_cand = 0.
+
+    def add(self, ref, cand):
+        if ref is None or cand is None or math.isnan(ref) or math.isnan(cand):
+            if (ref is None) != (cand is None):
+                self.mismatch += 1
+            return
+        self.count += 1
+        diff = abs(cand - ref)
+        self.max_abs = max(self.max_abs, diff)
+        if diff > self.atol:
+            self.max_rel = max(self.max_rel, diff / max(abs(ref), self.atol))
+        self.sum_ref += ref
+        self.sum_cand += cand
+
+    def balance_error(self):
+        """Relative error of cumulative sum, i.e., mass balance closure."""
+        if abs(self.sum_ref) <= self.atol:
+            return abs(self.sum_cand - self.sum_ref)
+        return abs(self.sum_cand - self.sum_ref) / abs(self.sum_ref)
+
+    def to_dict(self):
+        return {'count': self.count, 'mismatch': self.mismatch,
+                'max_abs_error': self.max_abs, 'max_rel_error': self.max_rel,
+                'sum_reference': self.sum_ref, 'sum_candidate': self.sum_cand,
+                'balance_error': self.balance_error()}
+
+
+def compare_timeseries(ref_file, cand_file, atol):
+    ref = read_timeseries(ref_file)
+    cand = read_timeseries(cand_file)
+    metrics = Metrics(atol)
+    for dt, ref_values in ref.items():
+        cand_values = cand.get(dt)
+        if cand_values is None or len(cand_values) != len(ref_values):
+            metrics.mismatch += 1
+            continue
+        for rv, cv in zip(ref_values, cand_values):
+            metrics.add(rv, cv)
+    metrics.mismatch += len(set(cand.keys()) - set(ref.keys()))
+    return metrics
+
+
+def compare_raster(ref_file, cand_file, atol):
+    ref = read_raster(ref_file)
+    cand = read_raster(cand_file)
+    if ref is None or cand is None:
+        return None
+    metrics = Metrics(atol)
+    if len(ref) != len(cand):
+        metrics.mismatch = abs(len(ref) - len(cand))
+    for rv, cv in zip(ref, cand):
+        metrics.add(rv, cv)
+    return metrics
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare outputs of mixed precision build '
+                                                 'against float64 build of SEIMS.')
+    parser.add_argument('-r', '--reference', required=True,
+                        help='Output directory of the reference (float64) build')
+    parser.add_argument('-c', '--candidate', required=True,
+                        help='Output directory of the candidate (e.g., mixed precision) build')
+    parser.add_argument('-rtol', type=float, default=1.e-3,
+                        help='Tolerance of maximum relative error of values, default 1e-3')
+    parser.add_argument('-btol', type=float, default=1.e-4,
+                        help='Tolerance of relative error of cumulative sum, default 1e-4')
+    parser.add_argument('-atol', type=float, default=1.e-6,
+                        help='Absolute errors below which are ignored, default 1e-6')
+    parser.add_argument('-o', '--output', help='Write the report as JSON')
+    args = parser.parse_args()
+
+    report = dict()
+    all_passed = True
+    for name in sorted(os.listdir(args.reference)):
+        ref_file = os.path.join(args.reference, name)
+        cand_file = os.path.join(args.candidate, name)
+        suffix = os.path.splitext(name)[1].lower()
+        if not os.path.isfile(ref_file) or suffix not in ['.txt', '.asc', '.tif']:
+            continue
+        if not os.path.isfile(cand_file):
+            print('%-30s MISSING in candidate outputs' % name)
+            report[name] = {'passed': False, 'error': 'missing'}
+            all_passed = False
+            continue
+        if suffix == '.txt':
+            metrics = compare_timeseries(ref_file, cand_file, args.atol)
+        else:
+            metrics = compare_raster(ref_file, cand_file, args.atol)
+        if metrics is None:
+            print('%-30s SKIPPED, GDAL is required to read GeoTiff' % name)
+            continue
+        passed = (metrics.mismatch == 0 and metrics.max_rel <= args.rtol
+                  and metrics.balance_error() <= args.btol)
+        all_passed = all_passed and passed
+        item = metrics.to_dict()
+        item['passed'] = passed
+        report[name] = item
+        print('%-30s %s  values: %d, max rel: %.3e, max abs: %.3e, balance: %.3e%s'
+              % (name, 'PASS' if passed else 'FAIL', metrics.count, metrics.max_rel,
+                 metrics.max_abs, metrics.balance_error(),
+                 ', mismatched: %d' % metrics.mismatch if metrics.mismatch else ''))
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'reference': args.reference, 'candidate': args.candidate,
+                       'rtol': args.rtol, 'btol': args.btol, 'atol': args.atol,
+                       'passed': all_passed, 'outputs': report}, f, indent=2)
+    print('Numerical regression %s.' % ('PASSED' if all_passed else 'FAILED'))
+    return 0 if all_passed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,138 @@
+"""Convert binary timeline traces of SEIMS to Chrome-trace/Perfetto JSON.
+
+    The SEIMS executables (seims_omp and seims_mpi) write compact binary traces when
+    running with `-trace <traceCapacity>`, e.g., `<scenario>.trace` of the OpenMP version,
+    and `<scenario>-mpi-rank<N>.trace` of each rank of the MPI version.
+    This script merges one or more trace files into a JSON file which can be opened by
+    `chrome://tracing` or https://ui.perfetto.dev, with one process per rank and one track per thread.
+
+    Usage:
+        python trace_timeline.py -o timeline.json path/to/*.trace
+        python trace_timeline.py -o timeline.json -s path/to/output_scenario_folder
+
+    @author   : Liangjun Zhu
+
+    @changelog:
+    - 26-10-19  - lj - initial implementation.
+"""
+from __future__ import absolute_import, print_function, unicode_literals
+
+import argparse
+import glob
+import json
+import os
+import struct
+from collections import defaultdict
+
+TRACE_MAGIC = b'SEIMSTRC'
+TRACE_VERSION = 1
+CATEGORIES = {0: 'module', 1: 'step', 2: 'mpi_wait', 3: 'io'}
+# category, name_id, begin, end, sim_time, subbasin_id, layer
+EVENT_STRUCT = struct.Struct('<iiddqii')
+
+
+class TraceFile(object):
+    """Binary trace of one process (rank)."""
+
+    def __init__(self, filename):
+        self.filename = filename
+        self.rank = 0
+        self.origin = 0.
+        self.names = list()
+        self.threads = list()  # [(thread_id, recorded, [events])]
+        self._read()
+
+    def _read(self):
+        with open(self.filename, 'rb') as f:
+            data = f.read()
+        if data[:8] != TRACE_MAGIC:
+            raise ValueError('%s is not a SEIMS trace file!' % self.filename)
+        pos = 8
+        version, self.rank, self.origin = struct.unpack_from('<iid', data, pos)
+        pos += 16
+        if version != TRACE_VERSION:
+            raise ValueError('Unsupported trace version %d of %s' % (version, self.filename))
+        n_names, = struct.unpack_from('<i', data, pos)
+        pos += 4
+        for _ in range(n_names):
+            length, = struct.unpack_from('<i', data, pos)
+            pos += 4
+            self.names.append(data[pos:pos + length].decode('utf-8'))
+            pos += length
+        n_threads, = struct.unpack_from('<i', data, pos)
+        pos += 4
+        for _ in range(n_threads):
+            tid, recorded, count = struct.unpack_from('<iqq', data, pos)
+            pos += 20
+            events = list()
+            for _ in range(count):
+                events.append(EVENT_STRUCT.unpack_from(data, pos))
+                pos += EVENT_STRUCT.size
+            self.threads.append((tid, recorded, events))
+
+    def dropped(self):
+        """Number of events overwritten in the ring buffers."""
+        return sum(rec - len(evts) for _, rec, evts in self.threads)
+
+
+def convert(trace_files, out_json):
+    """Merge traces into one Chrome-trace JSON, time zero is the earliest span of all ranks."""
+    traces = [TraceFile(f) for f in trace_files]
+    t0 = None
+    for tr in traces:
+        for _, _, events in tr.threads:
+            for evt in events:
+                t = tr.origin + evt[2]
+                if t0 is None or t < t0:
+                    t0 = t
+    if t0 is None:
+        t0 = 0.
+    trace_events = list()
+    busy = defaultdict(float)  # (rank, category) -> seconds
+    for tr in traces:
+        trace_events.append({'name': 'process_name', 'ph': 'M', 'pid': tr.rank, 'tid': 0,
+                             'args': {'name': 'rank %d' % tr.rank}})
+        for tid, _, events in tr.threads:
+            trace_events.append({'name': 'thread_name', 'ph': 'M', 'pid': tr.rank, 'tid': tid,
+                                 'args': {'name': 'thread %d' % tid}})
+            for cat, name_id, begin, end, sim_time, subbsn_id, lyr in events:
+                name = tr.names[name_id] if 0 <= name_id < len(tr.names) else str(name_id)
+                args = {'subbasin': subbsn_id, 'sim_time': sim_time}
+                if lyr >= 0:
+                    args['layer'] = lyr
+                trace_events.append({'name': name, 'cat': CATEGORIES.get(cat, str(cat)),
+                                     'ph': 'X', 'pid': tr.rank, 'tid': tid,
+                                     'ts': (tr.origin + begin - t0) * 1.e6,
+                                     'dur': (end - begin) * 1.e6,
+                                     'args': args})
+                busy[(tr.rank, cat)] += end - begin
+        if tr.dropped() > 0:
+            print('Warning: %d events of rank %d were overwritten, increase -trace capacity '
+                  'to keep the entire timeline.' % (tr.dropped(), tr.rank))
+    with open(out_json, 'w') as f:
+        json.dump({'traceEvents': trace_events, 'displayTimeUnit': 'ms'}, f)
+    # Brief summary of MPI waiting time of each rank to locate load imbalance
+    for tr in sorted(traces, key=lambda x: x.rank):
+        print('Rank %d: module %.3f s, MPI wait %.3f s' % (tr.rank, busy[(tr.rank, 0)],
+                                                          busy[(tr.rank, 2)]))
+    return len(trace_events)
+
+
+def main():
+    """Command line entrance."""
+    parser = argparse.ArgumentParser(description='Convert SEIMS binary traces to Chrome-trace JSON.')
+    parser.add_argument('traces', nargs='*', help='Binary trace files (*.trace)')
+    parser.add_argument('-s', '--scenario', help='Output scenario folder containing *.trace')
+    parser.add_argument('-o', '--output', required=True, help='Output JSON file')
+    args = parser.parse_args()
+    files = list(args.traces)
+    if args.scenario:
+        files += sorted(glob.glob(os.path.join(args.scenario, '*.trace')))
+    if not files:
+        parser.error('No trace files specified!')
+    n = convert(files, args.output)
+    print('%d events written to %s' % (n, args.output))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,195 @@
+"""Export the model data of SEIMS from MongoDB to a local folder.
+
+    The exported folder can be used by the OpenMP version of SEIMS with `-local <folder>`,
+    then no MongoDB server is required during simulation (see DataCenterLocal.h).
+
+    Layout of the exported folder:
+        MANIFEST                 KEY=VALUE lines, e.g., FORMAT, VERSION, and MODEL
+        FILE_IN.tsv, FILE_OUT.tsv, PARAMETERS.tsv, REACHES.tsv, SITELIST.tsv
+                                 Tab-separated tables with a header line
+        SPATIAL/<NAME>.sbin      GridFS files of the SPATIAL collection
+        CLIMATE/<TYPE>.sbin      Regular climate data of P, PET, TMEAN, TMAX, TMIN, SR, WS, and RM
+
+    Each `*.sbin` file is composed of the magic `SEIMSBIN`, int32 version, int32 length of
+    metadata, metadata as KEY=VALUE lines, zero padding to 8 bytes, and the raw payload.
+    The payload of climate data is float32 array of RECORDS x SITES in record-major order.
+
+    Usage:
+        python db_export_local.py -host 127.0.0.1 -port 27017 -db demo_youfang_model -o path/to/local
+
+    @author   : Liangjun Zhu
+
+    @changelog:
+    - 26-10-19  - lj - initial implementation.
+"""
+from __future__ import absolute_import, print_function, unicode_literals
+
+import argparse
+import os
+import struct
+import sys
+from datetime import timedelta
+from io import open
+
+if os.path.abspath(os.path.join(sys.path[0], '..')) not in sys.path:
+    sys.path.insert(0, os.path.abspath(os.path.join(sys.path[0], '..')))
+
+from gridfs import GridFS
+from pygeoc.utils import StringClass
+
+from preprocess.db_mongodb import ConnectMongoDB
+from preprocess.db_read_model import ReadModelData
+from preprocess.text import DBTableNames, DataValueFields, DataType, FieldNames, StationFields
+
+LOCAL_MAGIC = b'SEIMSBIN'
+LOCAL_VERSION = 1
+NODATA = -9999.
+TABLES = [DBTableNames.main_filein, DBTableNames.main_fileout, DBTableNames.main_parameter,
+          'REACHES', DBTableNames.main_sitelist]
+METEO_TYPES = [DataType.mean_tmp, DataType.max_tmp, DataType.min_tmp,
+               DataType.sr, DataType.ws, DataType.rm]
+
+
+def write_binary(filename, metadata, payload):
+    """Write metadata and payload to `*.sbin` file."""
+    meta = ''.join('%s=%s\n' % (k.upper(), v) for k, v in metadata.items()).encode('utf-8')
+    head_len = len(LOCAL_MAGIC) + 8 + len(meta)
+    padding = (8 - head_len % 8) % 8
+    with open(filename, 'wb') as f:
+        f.write(LOCAL_MAGIC)
+        f.write(struct.pack('<ii', LOCAL_VERSION, len(meta)))
+        f.write(meta)
+        f.write(b'\0' * padding)
+        f.write(payload)
+
+
+def clean_value(v):
+    """Convert value of a table cell to string without tab and newline."""
+    if v is None:
+        return ''
+    return ('%s' % v).replace('\t', ' ').replace('\r', ' ').replace('\n', ' ')
+
+
+def export_table(coll, filename):
+    """Export a MongoDB collection to tab-separated table."""
+    records = list(coll.find({}, {'_id': 0}))
+    fields = list()
+    for rec in records:
+        for k in rec:
+            if k not in fields:
+                fields.append(k)
+    with open(filename, 'w', encoding='utf-8') as f:
+        f.write('\t'.join(fields) + '\n')
+        for rec in records:
+            f.write('\t'.join(clean_value(rec.get(k)) for k in fields) + '\n')
+    return len(records)
+
+
+def export_spatial(maindb, outdir):
+    """Export GridFS files of SPATIAL, a file excluding NODATA is preferred if duplicated."""
+    spatial = GridFS(maindb, DBTableNames.gridfs_spatial)
+    exported = dict()
+    for gfile in spatial.find():
+        meta = gfile.metadata if gfile.metadata else dict()
+        inc_nodata = '%s' % meta.get('INCLUDE_NODATA', 'TRUE')
+        if gfile.filename in exported and inc_nodata.upper() != 'FALSE':
+            continue
+        write_binary(os.path.join(outdir, '%s.sbin' % gfile.filename), meta, gfile.read())
+        exported[gfile.filename] = inc_nodata
+    return len(exported)
+
+
+def export_climate(reader, outdir):
+    """Export regular climate data of the simulation period."""
+    stime, etime = reader.SimulationPeriod
+    sites = {FieldNames.site_p: set(), FieldNames.site_m: set(), FieldNames.site_pet: set()}
+    for item in reader.maindb[DBTableNames.main_sitelist].find({FieldNames.mode: reader.Mode}):
+        for fld in sites:
+            if fld in item and item[fld]:
+                sites[fld].update(int(v) for v in
+                                  StringClass.extract_numeric_values_from_string(item[fld]))
+    types = [(DataType.p, FieldNames.site_p, [DataType.p, DataType.m]),
+             (DataType.pet, FieldNames.site_pet, [DataType.m])]
+    types += [(t, FieldNames.site_m, [DataType.m]) for t in METEO_TYPES]
+    for dtype, fld, site_types in types:
+        site_ids = sorted(sites[fld])
+        if not site_ids:
+            continue
+        lats = dict()
+        elevs = dict()
+        for st in reader.climatedb[DBTableNames.sites].find({StationFields.id: {'$in': site_ids},
+                                                             StationFields.type: {'$in': site_types}}):
+            lats[st[StationFields.id]] = st[StationFields.lat]
+            elevs[st[StationFields.id]] = st[StationFields.elev]
+        values = dict()  # {utc: {site: value}}
+        for d in reader.climatedb[DBTableNames.data_values].find(
+            {DataValueFields.utc: {'$gte': stime, '$lte': etime},
+             DataValueFields.type: dtype,
+             DataValueFields.id: {'$in': site_ids}}):
+            values.setdefault(d[DataValueFields.utc], dict())[d[DataValueFields.id]] = \
+                d[DataValueFields.value]
+        if not values:
+            print('WARNING: No %s data found during the simulation period.' % dtype)
+            continue
+        utcs = sorted(values.keys())
+        # One record per INTERVAL from STARTTIME, i.e., the smallest spacing of timestamps,
+        #   the missing records are filled with NODATA.
+        gaps = [int((utcs[i + 1] - utcs[i]).total_seconds()) for i in range(len(utcs) - 1)]
+        interval = min(gaps) if gaps else 86400
+        if any(g % interval != 0 for g in gaps):
+            raise ValueError('Timestamps of %s data are not evenly spaced by %d seconds.'
+                             % (dtype, interval))
+        n_records = int((utcs[-1] - utcs[0]).total_seconds()) // interval + 1
+        nodata_rec = [float(NODATA)] * len(site_ids)
+        payload = list()
+        for irec in range(n_records):
+            utc = utcs[0] + timedelta(seconds=irec * interval)
+            if utc in values:
+                payload += [float(values[utc].get(sid, NODATA)) for sid in site_ids]
+            else:
+                payload += nodata_rec
+        if n_records > len(utcs):
+            print('WARNING: %d missing records of %s data are filled with %s.'
+                  % (n_records - len(utcs), dtype, NODATA))
+        meta = {'SITES': ','.join('%d' % sid for sid in site_ids),
+                'LAT': ','.join('%s' % lats.get(sid, NODATA) for sid in site_ids),
+                'ELEV': ','.join('%s' % elevs.get(sid, NODATA) for sid in site_ids),
+                'STARTTIME': utcs[0].strftime('%Y-%m-%d %H:%M:%S'),
+                'INTERVAL': interval,
+                'RECORDS': n_records}
+        write_binary(os.path.join(outdir, '%s.sbin' % dtype), meta,
+                     struct.pack('<%df' % len(payload), *payload))
+        print('  %s: %d sites, %d records' % (dtype, len(site_ids), n_records))
+
+
+def export_local(host, port, dbname, outdir):
+    """Export model data of `dbname` to `outdir`."""
+    conn = ConnectMongoDB(host, port).get_conn()
+    reader = ReadModelData(conn, dbname)
+    for d in [outdir, os.path.join(outdir, DBTableNames.gridfs_spatial), os.path.join(outdir, 'CLIMATE')]:
+        if not os.path.isdir(d):
+            os.makedirs(d)
+    with open(os.path.join(outdir, 'MANIFEST'), 'w', encoding='utf-8') as f:
+        f.write('FORMAT=SEIMS_LOCAL\nVERSION=%d\nMODEL=%s\n' % (LOCAL_VERSION, dbname))
+    for tab in TABLES:
+        n = export_table(reader.maindb[tab], os.path.join(outdir, '%s.tsv' % tab))
+        print('%s: %d records' % (tab, n))
+    n = export_spatial(reader.maindb, os.path.join(outdir, DBTableNames.gridfs_spatial))
+    print('%s: %d files' % (DBTableNames.gridfs_spatial, n))
+    print('CLIMATE:')
+    export_climate(reader, os.path.join(outdir, 'CLIMATE'))
+
+
+def main():
+    """Command line entrance."""
+    parser = argparse.ArgumentParser(description='Export SEIMS model data from MongoDB to local files.')
+    parser.add_argument('-host', default='127.0.0.1', help='IP address of MongoDB')
+    parser.add_argument('-port', type=int, default=27017, help='Port of MongoDB')
+    parser.add_argument('-db', required=True, help='Name of the main spatial database')
+    parser.add_argument('-o', '--output', required=True, help='Output folder')
+    args = parser.parse_args()
+    export_local(args.host, args.port, args.db, args.output)
+
+
+if __name__ == '__main__':
+    main()
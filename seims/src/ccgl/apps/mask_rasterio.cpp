@@ -5,6 +5,8 @@
  * \remarks
  *     - 1. 2021-11-25 - lj - Rewrite as an stand-alone application inside CCGL
  *     - 2. 2022-04-29 - lj - Support multiple subsets, support IO of file and MongoDB
+ *     - 3. 2026-10-19 - lj - Optional compression of raster data outputted to MongoDB
+ *     - 4. 2026-10-19 - lj - Optional statistics of layers and zones of mask layer outputted to CSV file
  *
  * \copyright 2017-2022. LREIS, IGSNRR, CAS
  *
@@ -47,6 +49,8 @@ void Usage(const string& appname, const string& error_msg /* = std::string() */)
             " [-out [<outFmt>] [<outFile>] [<outGFSName>]"
             " [-outdatatype <outDataType>] [-default <defaultValue>] [-nodata <updatedNodata>]"
             " [-include_nodata <includeNoData>]"
+            " [-compress <compress>]"
+            " [-stats <statsFile>]"
             " [-mongo <host> <port> <DB> <GFS>]"
             " [-thread <threadsNum>]\n\n";
     cout << "2. " << corename << " -configfile <configFile> [-thread <threadsNum>]\n\n";
@@ -63,6 +67,9 @@ void Usage(const string& appname, const string& error_msg /* = std::string() */)
     cout << "\t<defaultValue> is default value for nodata locations that covered by mask.\n";
     cout << "\t<updatedNodata> is updated nodata value.\n";
     cout << "\t<includeNoData> is used when output raster data into MongoDB, can be 1 or 0.\n";
+    cout << "\t<compress> is used when output raster data into MongoDB, can be 1 or 0 (default).\n";
+    cout << "\t<statsFile> is the CSV file of statistics of each input raster in MASK, DEC, and MASK&DEC mode,"
+            " including the entire raster and each zone of the mask layer.\n";
     cout << "\t<threadsNum> is the number of thread used by OpenMP, which must be >= 1 (default).\n";
     cout << "\t-mongo specify the MongoDB configuration, including host, port, DB, and GFS.\n";
     cout << "\t<configFile> is a plain text file that defines all input parameters, the format is:\n";
@@ -73,6 +80,8 @@ void Usage(const string& appname, const string& error_msg /* = std::string() */)
     cout << "\t\t[-out\t<outFmt>]\n";
     cout << "\t\t[-outdatatype\t<outDataType>]\n";
     cout << "\t\t[-include_nodata\t<includeNoData>]\n";
+    cout << "\t\t[-compress\t<compress>]\n";
+    cout << "\t\t[-stats\t<statsFile>]\n";
     cout << "\t\t\"<in1>,<in2>,...;<out>;[<defaultValue>];[<updatedNodata>];[<outDataType>];"
             "[<reclassifyList>]\"\n";
     cout << "\t\t...\n\n";
@@ -122,6 +131,16 @@ bool parse_fmt_paths(const string& tag, const vector<string>& strs, DATAFMT& fmt
     return true;
 }
 
+void write_statistics(std::ofstream& ofs, const string& name, const string& zone,
+                      const vector<RunningStatistics>& stats) {
+    for (auto it = stats.begin(); it != stats.end(); ++it) {
+        ofs << name << "," << zone << "," << it - stats.begin() + 1 << ","
+                << it->Count() << "," << it->Sum() << "," << it->Mean() << "," << it->Std() << ","
+                << it->Minimum() << "," << it->Quantile(0.25) << "," << it->Quantile(0.5) << ","
+                << it->Quantile(0.75) << "," << it->Maximum() << "," << it->Range() << "\n";
+    }
+}
+
 bool parse_key_values(string& kvstrs, map<vint, vector<double> >& kv) {
     if (kvstrs.empty()) { return false; }
     bool valid_kv = true;
@@ -166,9 +185,11 @@ int main(const int argc, const char** argv) {
     IOMODE mode = MASK;
     int thread_num = 1;
     bool inc_nodata = true;
+    string stats_path;
 
     bool use_mongo = false;
 #ifdef USE_MONGODB
+    bool compress = false;
     string mongo_host;
     vint16_t mongo_port;
     string dbname;
@@ -368,6 +389,18 @@ int main(const int argc, const char** argv) {
                 inc_nodata = true;
             }
         }
+#ifdef USE_MONGODB
+        else if (itkv->first == "COMPRESS") {
+            compress = IsInt(itkv->second.at(0), str2num_flag) > 0;
+            if (!str2num_flag) {
+                cout << "Warning: Illegal flag for COMPRESS, use 0 instead!\n";
+                compress = false;
+            }
+        }
+#endif
+        else if (itkv->first == "STATS") {
+            stats_path = itkv->second.at(0);
+        }
         else {
             cout << "Warning: Unknown Tag that will be ignored: " << itkv->first << "\n";
         }
@@ -376,6 +409,9 @@ int main(const int argc, const char** argv) {
     if (!use_mongo) {
         if (global_outfmt == GFS) { global_outfmt = SFILE; }
     }
+#ifdef USE_MONGODB
+    if (use_mongo) { gfs->SetCompression(compress); }
+#endif
     if (global_outfmt == UNKNOWNFMT) {
         global_outfmt = global_infmt;
     }
@@ -510,6 +546,16 @@ int main(const int argc, const char** argv) {
         output_all = true;
     }
 
+    std::ofstream stats_file;
+    if (!stats_path.empty()) {
+        stats_file.open(stats_path.c_str(), std::ios::out);
+        if (!stats_file.is_open()) {
+            cout << "Warning: Open statistics file failed: " << stats_path << "\n";
+        } else {
+            stats_file << setprecision(10);
+            stats_file << "RASTER,ZONE,LAYER,COUNT,SUM,MEAN,STD,MIN,P25,MEDIAN,P75,MAX,RANGE\n";
+        }
+    }
     if (inc_nodata) {
         UpdateStringMap(opts, HEADER_INC_NODATA, "TRUE");
     } else {
@@ -547,6 +593,19 @@ int main(const int argc, const char** argv) {
 
             if (update_nodata.at(in_idx)) { rs->ReplaceNoData(nodata_values.at(in_idx)); }
 
+            if (stats_file.is_open()) {
+                string rs_name = GetCoreFileName((*in_it).at(0));
+                vector<RunningStatistics> lyr_stats;
+                rs->GetLayerStatistics(lyr_stats);
+                write_statistics(stats_file, rs_name, "ALL", lyr_stats);
+                map<int, vector<RunningStatistics> > zone_stats;
+                if (nullptr != mask_layer && rs->GetZonalStatistics(mask_layer, zone_stats)) {
+                    for (auto zit = zone_stats.begin(); zit != zone_stats.end(); ++zit) {
+                        write_statistics(stats_file, rs_name, ValueToString(zit->first), zit->second);
+                    }
+                }
+            }
+
             if (reclass_data.at(in_idx)) {
                 rs->BuildSubSet();
             }
@@ -653,6 +712,7 @@ int main(const int argc, const char** argv) {
             // Nothing to do
         }
     }
+    if (stats_file.is_open()) { stats_file.close(); }
     delete mask_layer;
 #ifdef USE_MONGODB
     if (use_mongo) {
@@ -47,5 +47,15 @@ bool parse_fmt_paths(string& tag, vector<string>& strs, DATAFMT& fmt, vector<str
 
 bool parse_key_values(string& kvstrs, map<vint, vector<double> >& kv);
 
+/*!
+ * \brief Write statistics of each layer into CSV file, \sa RunningStatistics
+ * \param[in] ofs Opened CSV file
+ * \param[in] name Raster name
+ * \param[in] zone Zone ID, or ALL for the entire raster
+ * \param[in] stats Statistics of each layer
+ */
+void write_statistics(std::ofstream& ofs, const string& name, const string& zone,
+                      const vector<RunningStatistics>& stats);
+
 
 #endif /* CCGL_APP_MASK_RASTERIO_H */
@@ -17,6 +17,7 @@
 #include "basic.h"
 #include "utils_string.h"
 #include "utils_array.h"
+#include "utils_codec.h"
 #include "utils_math.h"
 #include "utils_time.h"
 #include "utils_filesystem.h"
@@ -5,12 +5,15 @@
  * \remarks
  *   - 1. Apr. 2022 - lj - Separated from clsRasterData class for widely use.
  *   - 2. Aug. 2023 - lj - Add GDAL data types added from versions 3.5 and 3.7
+ *   - 3. Oct. 2026 - lj - Add RowSpanIndex, remove local_pos_ of SubsetPositions.
  *
  * \author Liangjun Zhu, zlj(at)lreis.ac.cn
  */
 
 #include "data_raster.hpp"
 
+#include <algorithm>
+
 namespace ccgl {
 namespace data_raster {
 string RasterDataTypeToString(const int type) {
@@ -206,6 +209,93 @@ bool WriteAscHeaders(const string& filename, const STRDBL_MAP& header) {
     return true;
 }
 
+/* Start RowSpanIndex */
+RowSpanIndex::RowSpanIndex() : n_rows_(0), n_cols_(0), n_cells_(0) {
+}
+
+bool RowSpanIndex::Build(const int n_rows, const int n_cols, const int* pos_idx, const int n_cells) {
+    n_rows_ = 0;
+    n_cols_ = 0;
+    n_cells_ = 0;
+    row_spans_.clear();
+    span_scol_.clear();
+    span_ecol_.clear();
+    span_offset_.clear();
+    if (n_rows <= 0 || n_cols <= 0 || nullptr == pos_idx || n_cells <= 0) { return false; }
+    vint fullsize = CVT_VINT(n_rows) * n_cols;
+    if (n_cells > fullsize) { return false; }
+    row_spans_.assign(n_rows + 1, 0);
+    int prev_idx = -1;
+    for (int i = 0; i < n_cells; i++) {
+        int idx = pos_idx[i];
+        if (idx <= prev_idx || idx >= fullsize) { // not in ascending order or out of extent
+            row_spans_.clear();
+            span_scol_.clear();
+            span_ecol_.clear();
+            span_offset_.clear();
+            return false;
+        }
+        int row = idx / n_cols;
+        int col = idx % n_cols;
+        if (prev_idx >= 0 && idx == prev_idx + 1 && prev_idx / n_cols == row) {
+            span_ecol_.back() = col; // extend the current span
+        } else {
+            span_scol_.emplace_back(col);
+            span_ecol_.emplace_back(col);
+            span_offset_.emplace_back(i);
+            row_spans_[row + 1] += 1; // count spans of row
+        }
+        prev_idx = idx;
+    }
+    for (int row = 0; row < n_rows; row++) {
+        row_spans_[row + 1] += row_spans_[row]; // accumulate to the first span of each row
+    }
+    span_offset_.emplace_back(n_cells);
+    vector<int>(span_scol_).swap(span_scol_);
+    vector<int>(span_ecol_).swap(span_ecol_);
+    vector<int>(span_offset_).swap(span_offset_);
+    n_rows_ = n_rows;
+    n_cols_ = n_cols;
+    n_cells_ = n_cells;
+    return true;
+}
+
+int RowSpanIndex::GetPosition(const int row, const int col) const {
+    if (row < 0 || row >= n_rows_ || col < 0 || col >= n_cols_) { return -1; }
+    // Binary search the last span whose start col is not greater than col
+    int left = row_spans_[row];
+    int right = row_spans_[row + 1] - 1;
+    int found = -1;
+    while (left <= right) {
+        int middle = left + (right - left) / 2;
+        if (span_scol_[middle] <= col) {
+            found = middle;
+            left = middle + 1;
+        } else {
+            right = middle - 1;
+        }
+    }
+    if (found < 0 || col > span_ecol_[found]) { return -1; }
+    return span_offset_[found] + col - span_scol_[found];
+}
+
+bool RowSpanIndex::GetRowCol(const int index, int& row, int& col) const {
+    if (index < 0 || index >= n_cells_) { return false; }
+    // The last span whose offset is not greater than index
+    int span = CVT_INT(std::upper_bound(span_offset_.begin(), span_offset_.end(), index)
+                       - span_offset_.begin()) - 1;
+    // The last row whose first span is not greater than span
+    row = CVT_INT(std::upper_bound(row_spans_.begin(), row_spans_.end(), span)
+                  - row_spans_.begin()) - 1;
+    col = span_scol_[span] + index - span_offset_[span];
+    return true;
+}
+
+size_t RowSpanIndex::MemorySize() const {
+    return sizeof(RowSpanIndex) + sizeof(int) * (row_spans_.capacity() + span_scol_.capacity()
+        + span_ecol_.capacity() + span_offset_.capacity());
+}
+
 /* Start SubsetPositions */
 bool SubsetPositions::Initialization() {
     usable = true;
@@ -216,7 +306,6 @@ bool SubsetPositions::Initialization() {
     g_scol = -1;
     g_ecol = -1;
     alloc_ = false;
-    local_pos_ = nullptr;
     local_posidx_ = nullptr;
     global_ = nullptr;
     data_ = nullptr;
@@ -248,7 +337,6 @@ SubsetPositions::SubsetPositions(SubsetPositions*& src, const bool deep_copy) {
     if (deep_copy) {
         alloc_ = true;
         Initialize1DArray(n_cells, global_, src->global_);
-        Initialize2DArray(n_cells, 2, local_pos_, src->local_pos_);
         Initialize1DArray(n_cells, local_posidx_, src->local_posidx_);
         if (nullptr != src->data_) {
             Initialize1DArray(n_cells, data_, src->data_);
@@ -260,7 +348,6 @@ SubsetPositions::SubsetPositions(SubsetPositions*& src, const bool deep_copy) {
     else {
         alloc_ = false;
         global_ = src->global_;
-        local_pos_ = src->local_pos_;
         local_posidx_ = src->local_posidx_;
         if (nullptr != src->data_) { data_ = src->data_; }
         if (nullptr != src->data2d_) { data2d_ = src->data2d_; }
@@ -268,10 +355,6 @@ SubsetPositions::SubsetPositions(SubsetPositions*& src, const bool deep_copy) {
 }
 
 SubsetPositions::~SubsetPositions() {
-    if (nullptr != local_pos_) {
-        if (alloc_) { Release2DArray(local_pos_); }
-        else { local_pos_ = nullptr; }
-    }
     if (nullptr != local_posidx_) {
         if (alloc_) { Release1DArray(local_posidx_); }
         else { local_posidx_ = nullptr; }
@@ -310,7 +393,6 @@ bool SubsetPositions::ReadFromMongoDB(MongoGridFs* gfs, const string& fname, con
             Initialize1DArray(n_cells, data_, NODATA_VALUE);
         }
         for (int i = 0; i < n_cells; i++) {
-            //data_[i] = dbdata[local_pos_[i][0] * ncols + local_pos_[i][1]];
             data_[i] = dbdata[local_posidx_[i]];
         }
     }
@@ -321,7 +403,6 @@ bool SubsetPositions::ReadFromMongoDB(MongoGridFs* gfs, const string& fname, con
         for (int i = 0; i < n_cells; i++) {
             for (int j = 0; j < n_lyrs; j++) {
                 if (nfull == db_ncells) { // consider data from MongoDB is fullsize data
-                    //data2d_[i][j] = dbdata[(local_pos_[i][0] * ncols + local_pos_[i][1]) * n_lyrs + j];
                     data2d_[i][j] = dbdata[local_posidx_[i] * n_lyrs + j];
                 }
                 else { data2d_[i][j] = dbdata[i * n_lyrs + j]; }
@@ -24,6 +24,8 @@
  *                     Add subset feature to support data decomposition and combination.
  *   -12. Jul. 2023 lj Add valid position index (1D array, pos_idx_) and will remove pos_data_ in next version.
  *   -13. Aug. 2023 lj Add GDAL data types added from versions 3.5 and 3.7
+ *   -14. Oct. 2026 lj Add row-span index of valid positions shared with mask, pos_data_ is built on demand.
+ *   -15. Oct. 2026 lj Single-pass parallel statistics of layers and zones, including quantiles.
  *
  * \author Liangjun Zhu, zlj(at)lreis.ac.cn
  * \version 2.8
@@ -109,6 +111,7 @@ CONST_CHARS STATS_RS_MIN = "MIN"; /// Minimum value
 CONST_CHARS STATS_RS_MAX = "MAX"; /// Maximum value
 CONST_CHARS STATS_RS_STD = "STD"; /// Standard derivation value
 CONST_CHARS STATS_RS_RANGE = "RANGE"; /// Range value
+const int STATS_BLOCK_SIZE = 16384; /// Cells number of each block for parallel statistics
 CONST_CHARS ASCIIExtension = "asc"; /// ASCII extension
 CONST_CHARS GTiffExtension = "tif"; /// GeoTIFF extension
 
@@ -856,54 +859,25 @@ bool WriteRasterToFile(const string& filename, const STRDBL_MAP& header,
 #endif /* USE_GDAL */
 }
 
-#ifdef USE_MONGODB
 /*!
- * \brief Read GridFs file from MongoDB
- * \param[in] gfs MongoGridFs pointer
- * \param[in] filename GridFs filename
- * \param[out] data Data stored in GridFs file
- * \param[out] header Header information
- * \param[out] header_str Header information in strings
- * \param[in] opts Optional key-value stored in metadata, used to filter GridFs file
+ * \brief Convert stream data, e.g., content of GridFs file or local binary file, to array
+ * \param[in] buf Stream data
+ * \param[in] length Length of stream data in bytes
+ * \param[in] header Header information, NROWS, NCOLS, LAYERS, and CELLSNUM are required
+ * \param[in] header_str Header information in strings, DATATYPE is required
+ * \param[out] data Converted data with the length of CELLSNUM * LAYERS
  */
 template <typename T>
-bool ReadGridFsFile(MongoGridFs* gfs, const string& filename,
-                    T*& data, STRDBL_MAP& header,
-                    STRING_MAP& header_str,
-                    const STRING_MAP& opts /* = STRING_MAP() */) {
-    // Get stream data and metadata by file name
-    vint length;
-    char* buf = nullptr;
-    if (!gfs->GetStreamData(filename, buf, length, nullptr, &opts) ||
-        nullptr == buf) {
+bool ReadStreamData(const char* buf, const vint length, const STRDBL_MAP& header,
+                    const STRING_MAP& header_str, T*& data) {
+    if (nullptr == buf || header.find(HEADER_RS_CELLSNUM) == header.end()
+        || header.find(HEADER_RS_LAYERS) == header.end()) {
         return false;
     }
-    bson_t* bmeta = gfs->GetFileMetadata(filename, nullptr, opts);
-
-    // Retrieve raster header values
-    bson_iter_t iter; // Loop the metadata, add to `header_str` or `header`
-    if (nullptr != bmeta && bson_iter_init(&iter, bmeta)) {
-        while (bson_iter_next(&iter)) {
-            const char* key = bson_iter_key(&iter);
-            if (header.find(key) != header.end()) {
-                GetNumericFromBsonIterator(&iter, header[key]);
-            }
-            else {
-                header_str[key] = GetStringFromBsonIterator(&iter);
-            }
-        }
-    }
-    bson_destroy(bmeta); // Destroy bson of metadata immediately after use
-
-    int n_rows = CVT_INT(header.at(HEADER_RS_NROWS));
-    int n_cols = CVT_INT(header.at(HEADER_RS_NCOLS));
     int n_lyrs = CVT_INT(header.at(HEADER_RS_LAYERS));
     int n_cells = CVT_INT(header.at(HEADER_RS_CELLSNUM));
-    if (n_rows < 0 || n_cols < 0 || n_lyrs < 0) { // missing essential metadata
-        delete[] buf;
-        return false;
-    }
     int value_count = n_cells * n_lyrs;
+    if (value_count <= 0) { return false; }
     size_t size_dtype = length / value_count;
 
     RasterDataType rstype = RDT_Unknown;
@@ -911,68 +885,106 @@ bool ReadGridFsFile(MongoGridFs* gfs, const string& filename,
         rstype = StringToRasterDataType(header_str.at(HEADER_RSOUT_DATATYPE));
     }
     if (rstype == RDT_Unknown) {
-        StatusMessage("Unknown data type in MongoDB GridFS!");
-        delete[] buf;
+        StatusMessage("Unknown data type of stream data!");
         return false;
     }
 
     if (rstype == RDT_Double && size_dtype == sizeof(double)) {
-        double* data_dbl = reinterpret_cast<double*>(buf);
+        const double* data_dbl = reinterpret_cast<const double*>(buf);
         Initialize1DArray(value_count, data, data_dbl);
-        //Release1DArray(data_dbl);
     }
     else if (rstype == RDT_Float && size_dtype == sizeof(float)) {
-        float* data_flt = reinterpret_cast<float*>(buf);
+        const float* data_flt = reinterpret_cast<const float*>(buf);
         Initialize1DArray(value_count, data, data_flt);
-        //Release1DArray(data_flt);
     }
     else if (rstype == RDT_Int32 && size_dtype == sizeof(vint32_t)) {
-        vint32_t* data_int32 = reinterpret_cast<vint32_t*>(buf);
+        const vint32_t* data_int32 = reinterpret_cast<const vint32_t*>(buf);
         Initialize1DArray(value_count, data, data_int32);
-        //Release1DArray(data_int32);
     }
     else if (rstype == RDT_UInt32 && size_dtype == sizeof(vuint32_t)) {
-        vuint32_t* data_uint32 = reinterpret_cast<vuint32_t*>(buf);
+        const vuint32_t* data_uint32 = reinterpret_cast<const vuint32_t*>(buf);
         Initialize1DArray(value_count, data, data_uint32);
-        //Release1DArray(data_uint32);
     }
     else if (rstype == RDT_Int64 && size_dtype == sizeof(vint64_t)) {
-        vint64_t* data_int64 = reinterpret_cast<vint64_t*>(buf);
+        const vint64_t* data_int64 = reinterpret_cast<const vint64_t*>(buf);
         Initialize1DArray(value_count, data, data_int64);
-        //Release1DArray(data_int64);
     }
     else if (rstype == RDT_UInt64 && size_dtype == sizeof(vuint64_t)) {
-        vuint64_t* data_uint64 = reinterpret_cast<vuint64_t*>(buf);
+        const vuint64_t* data_uint64 = reinterpret_cast<const vuint64_t*>(buf);
         Initialize1DArray(value_count, data, data_uint64);
-        //Release1DArray(data_uint64);
     }
     else if (rstype == RDT_Int16 && size_dtype == sizeof(vint16_t)) {
-        vint16_t* data_int16 = reinterpret_cast<vint16_t*>(buf);
+        const vint16_t* data_int16 = reinterpret_cast<const vint16_t*>(buf);
         Initialize1DArray(value_count, data, data_int16);
-        //Release1DArray(data_int16);
     }
     else if (rstype == RDT_UInt16 && size_dtype == sizeof(vuint16_t)) {
-        vuint16_t* data_uint16 = reinterpret_cast<vuint16_t*>(buf);
+        const vuint16_t* data_uint16 = reinterpret_cast<const vuint16_t*>(buf);
         Initialize1DArray(value_count, data, data_uint16);
-        //Release1DArray(data_uint16);
     }
     else if (rstype == RDT_Int8 && size_dtype == sizeof(vint8_t)) {
-        vint8_t* data_int8 = reinterpret_cast<vint8_t*>(buf);
+        const vint8_t* data_int8 = reinterpret_cast<const vint8_t*>(buf);
         Initialize1DArray(value_count, data, data_int8);
-        //Release1DArray(data_int8);
     }
     else if (rstype == RDT_UInt8 && size_dtype == sizeof(vuint8_t)) {
-        vuint8_t* data_uint8 = reinterpret_cast<vuint8_t*>(buf);
+        const vuint8_t* data_uint8 = reinterpret_cast<const vuint8_t*>(buf);
         Initialize1DArray(value_count, data, data_uint8);
-        //Release1DArray(data_uint8);
     }
     else {
         StatusMessage("Unconsistent of data type and size!");
+        return false;
+    }
+    return true;
+}
+
+#ifdef USE_MONGODB
+/*!
+ * \brief Read GridFs file from MongoDB
+ * \param[in] gfs MongoGridFs pointer
+ * \param[in] filename GridFs filename
+ * \param[out] data Data stored in GridFs file
+ * \param[out] header Header information
+ * \param[out] header_str Header information in strings
+ * \param[in] opts Optional key-value stored in metadata, used to filter GridFs file
+ */
+template <typename T>
+bool ReadGridFsFile(MongoGridFs* gfs, const string& filename,
+                    T*& data, STRDBL_MAP& header,
+                    STRING_MAP& header_str,
+                    const STRING_MAP& opts /* = STRING_MAP() */) {
+    // Get stream data and metadata by file name
+    vint length;
+    char* buf = nullptr;
+    if (!gfs->GetStreamData(filename, buf, length, nullptr, &opts) ||
+        nullptr == buf) {
+        return false;
+    }
+    bson_t* bmeta = gfs->GetFileMetadata(filename, nullptr, opts);
+
+    // Retrieve raster header values
+    bson_iter_t iter; // Loop the metadata, add to `header_str` or `header`
+    if (nullptr != bmeta && bson_iter_init(&iter, bmeta)) {
+        while (bson_iter_next(&iter)) {
+            const char* key = bson_iter_key(&iter);
+            if (header.find(key) != header.end()) {
+                GetNumericFromBsonIterator(&iter, header[key]);
+            }
+            else {
+                header_str[key] = GetStringFromBsonIterator(&iter);
+            }
+        }
+    }
+    bson_destroy(bmeta); // Destroy bson of metadata immediately after use
+
+    int n_rows = CVT_INT(header.at(HEADER_RS_NROWS));
+    int n_cols = CVT_INT(header.at(HEADER_RS_NCOLS));
+    int n_lyrs = CVT_INT(header.at(HEADER_RS_LAYERS));
+    if (n_rows < 0 || n_cols < 0 || n_lyrs < 0) { // missing essential metadata
         delete[] buf;
         return false;
     }
+    bool flag = ReadStreamData(buf, length, header, header_str, data);
     delete[] buf;
-    return true;
+    return flag;
 }
 
 /*!
@@ -1067,7 +1079,8 @@ bool WriteStreamDataAsGridfs(MongoGridFs* gfs, const string& filename,
     int try_times = 0;
     bool gstatus = false;
     while (try_times <= 3) { // Try 3 times
-        gstatus = gfs->WriteStreamData(filename, buf, buflength, &p);
+        gstatus = gfs->WriteStreamData(filename, buf, buflength, &p, nullptr,
+                                       datalength > 0 ? CVT_INT(buflength / datalength) : 1);
         if (gstatus) { break; }
         SleepMs(2); // Sleep 0.002 sec and retry
         try_times++;
@@ -1079,6 +1092,70 @@ bool WriteStreamDataAsGridfs(MongoGridFs* gfs, const string& filename,
 
 #endif /* USE_MONGODB */
 
+/*!
+ * \class RowSpanIndex
+ * \brief Run-length index of valid cells' positions by rows
+ *
+ *        The valid cells are stored in row-major order, thus the valid cells of each row
+ *        form several spans of consecutive columns. Each span records its start and end
+ *        columns and the index of its first valid cell, and each row records its range of spans.
+ *        The memory size depends on the number of spans rather than the number of valid cells.
+ *
+ * \code
+ *        // Iterate all valid cells row by row
+ *        for (int row = 0; row < spans->GetRows(); row++) {
+ *            for (int s = spans->RowSpanBegin(row); s < spans->RowSpanEnd(row); s++) {
+ *                int idx = spans->SpanOffset(s);
+ *                for (int col = spans->SpanStartCol(s); col <= spans->SpanEndCol(s); col++, idx++) {
+ *                    // raster_data[idx] locates at (row, col)
+ *                }
+ *            }
+ *        }
+ * \endcode
+ */
+class RowSpanIndex: NotCopyable {
+public:
+    RowSpanIndex();
+
+    /*!
+     * \brief Build from valid cells' index, i.e., row * n_cols + col
+     * \param[in] n_rows Rows number
+     * \param[in] n_cols Cols number
+     * \param[in] pos_idx Valid cells' index in ascending order
+     * \param[in] n_cells Valid cells' number
+     * \return False if the index is not in ascending order or exceeds the extent
+     */
+    bool Build(int n_rows, int n_cols, const int* pos_idx, int n_cells);
+
+    /*! Get index of valid cell at (row, col), -1 if the cell is not valid */
+    int GetPosition(int row, int col) const;
+
+    /*! Get row and col of the valid cell index */
+    bool GetRowCol(int index, int& row, int& col) const;
+
+    int GetRows() const { return n_rows_; } ///< Rows number
+    int GetCols() const { return n_cols_; } ///< Cols number
+    int GetCellNumber() const { return n_cells_; } ///< Valid cells' number
+    int GetSpanNumber() const { return CVT_INT(span_scol_.size()); } ///< Spans number
+    int RowSpanBegin(const int row) const { return row_spans_[row]; } ///< The first span of row
+    int RowSpanEnd(const int row) const { return row_spans_[row + 1]; } ///< The past-the-end span of row
+    int SpanStartCol(const int span) const { return span_scol_[span]; } ///< Start col of span
+    int SpanEndCol(const int span) const { return span_ecol_[span]; } ///< End col (inclusive) of span
+    int SpanOffset(const int span) const { return span_offset_[span]; } ///< Index of the first cell of span
+
+    /*! Memory size in bytes */
+    size_t MemorySize() const;
+
+private:
+    int n_rows_; ///< Rows number
+    int n_cols_; ///< Cols number
+    int n_cells_; ///< Valid cells' number
+    vector<int> row_spans_; ///< The first span of each row, the last one is spans number
+    vector<int> span_scol_; ///< Start col of each span
+    vector<int> span_ecol_; ///< End col of each span
+    vector<int> span_offset_; ///< Index of the first cell of each span, the last one is n_cells_
+};
+
 /*!
  * \class SubsetPositions
  * \brief Subset positions of raster data
@@ -1142,7 +1219,6 @@ public:
             T* tmpdata = nullptr;
             Initialize1DArray(fullsize, tmpdata, nodata);
             for (int vi = 0; vi < n_cells; vi++) {
-                //int j = local_pos_[vi][0] * ncols + local_pos_[vi][1];
                 int j = local_posidx_[vi];
                 if (n_lyrs > 1 && nullptr != data2d_) {
                     tmpdata[j] = static_cast<T>(data2d_[vi][ilyr]);
@@ -1162,8 +1238,7 @@ public:
     int g_erow; ///< end row in global data
     int g_scol; ///< start col in global data
     int g_ecol; ///< end col in global data
-    bool alloc_; ///< local_pos_ and global_ are allocated?
-    int** local_pos_; ///< local position data
+    bool alloc_; ///< local_posidx_ and global_ are allocated?
     int* local_posidx_; ///< local position index
     int* global_; ///< global position index
     double* data_; ///< valid data array
@@ -1356,6 +1431,25 @@ public:
                        bool use_mask_ext = true, double default_value = NODATA_VALUE,
                        const STRING_MAP& opts = STRING_MAP());
 
+    /*!
+     * \brief Read raster data from stream data with metadata, e.g., a memory-mapped local file
+     *        which has the same content and metadata as the GridFs file in MongoDB
+     * \param[in] buf Stream data
+     * \param[in] length Length of stream data in bytes
+     * \param[in] metadata Key-value metadata, e.g., NROWS, NCOLS, CELLSNUM, LAYERS, DATATYPE, INCLUDE_NODATA
+     * \param[in] filename Raster name
+     * \param[in] calc_pos Calculate positions of valid cells excluding NODATA. The default is false.
+     * \param[in] mask \a clsRasterData<MASK_T>
+     * \param[in] use_mask_ext Use mask layer extent, even NoDATA exists.
+     * \param[in] default_value Default value when mask data exceeds the raster extend.
+     * \param[in] opts Optional key-value
+     */
+    bool ReadFromStream(const char* buf, vint length, const STRING_MAP& metadata,
+                        const string& filename, bool calc_pos = false,
+                        clsRasterData<MASK_T>* mask = nullptr, bool use_mask_ext = true,
+                        double default_value = NODATA_VALUE,
+                        const STRING_MAP& opts = STRING_MAP());
+
 #ifdef USE_MONGODB
     /*!
      * \brief Read raster data from MongoDB
@@ -1547,6 +1641,35 @@ public:
      */
     void GetStatistics(string sindex, int* lyrnum, double** values);
 
+    /*!
+     * \brief Calculate statistics of each layer in one sweep, including moments and quantiles
+     *
+     * The valid cells are divided into blocks that are swept in parallel if OpenMP is supported,
+     * and the statistics of blocks are merged in order, so the results are independent of the
+     * number of threads.
+     *
+     * \param[out] stats Statistics of each layer, \sa RunningStatistics
+     * \param[in] relative_accuracy Relative accuracy of quantiles, \sa QuantileSketch,
+     *                              zero or negative for moments only
+     */
+    void GetLayerStatistics(vector<RunningStatistics>& stats, double relative_accuracy = 0.01);
+
+    /*!
+     * \brief Calculate statistics of each layer within each zone in one sweep
+     *
+     * The zone of each valid cell is read from the zone raster by row and col if both rasters
+     * share the same extent, otherwise by the coordinate of the cell center.
+     * Cells located in NoData of the zone raster are skipped.
+     *
+     * \param[in] zones Zone raster with integer values, e.g., subbasin, landuse, or field
+     * \param[out] stats Statistics of each layer of each zone, key is the zone ID
+     * \param[in] relative_accuracy Relative accuracy of quantiles, \sa QuantileSketch
+     * \return False if the raster data or zone raster is not available
+     */
+    template <typename ZONE_T>
+    bool GetZonalStatistics(clsRasterData<ZONE_T>* zones, map<int, vector<RunningStatistics> >& stats,
+                            double relative_accuracy = 0.01);
+
     /*!
      * \brief Get the average of raster data
      * \param[in] lyr optional for 1D and the first layer of 2D raster data.
@@ -1658,7 +1781,8 @@ public:
     double GetDefaultValue() const { return default_value_; } /// Get default value
 
     /*!
-     * \brief Get position index in 1D raster data for specific row and column
+     * \brief Get position index in 1D raster data for specific row and column,
+     *        which is located by the row-span index of valid positions if available
      * \return -1 --- the position is nodata
      *         -2 --- the position is out of the extent, which indicates an error
      */
@@ -1700,7 +1824,8 @@ public:
     string GetCoreName() const { return core_name_; }
 
     /*!
-     * \brief Get position index data and the data length
+     * \brief Get position data and the data length, the position data is built from
+     *        position index on demand, or shared with the mask layer
      * \param[out] datalength Data length
      * \param[out] positiondata The pointer of 2D array (pointer)
      */
@@ -1709,8 +1834,9 @@ public:
     void GetRasterPositionData(int* datalength, int** positiondata);
 
     T* GetRasterDataPointer() const { return raster_; } /// Get pointer of raster 1D data
-    int** GetRasterPositionDataPointer() const { return pos_data_; } /// Get pointer of position data
-    int* GetRasterPositionIndexPointer() const { return pos_idx_; } /// Get pointer of position data
+    int** GetRasterPositionDataPointer(); /// Get pointer of position data, built on demand
+    int* GetRasterPositionIndexPointer() const { return pos_idx_; } /// Get pointer of position index
+    RowSpanIndex* GetRasterPositionSpans() const { return pos_spans_; } /// Get row-span index of positions
     T** Get2DRasterDataPointer() const { return raster_2d_; } /// Get pointer of raster 2D data
     const char* GetSrs(); /// Get the spatial reference (char*)
     string GetSrsString(); /// Get the spatial reference (string)
@@ -1854,6 +1980,14 @@ private:
      */
     void InitializeRasterClass(bool is_2d = false);
 
+    /*!
+     * \brief Construct raster from the data and headers of GridFs file or stream data
+     * \param[in] data Data of all cells and layers, which will be taken over or released
+     * \param[in] header_dbl Header information
+     * \param[in] header_str Header information in strings
+     */
+    bool ConstructFromStreamData(T* data, const STRDBL_MAP& header_dbl, const STRING_MAP& header_str);
+
     /*!
      * \brief Initialize read function for ASC, GDAL, and MongoDB
      */
@@ -1886,6 +2020,28 @@ private:
      */
     int MaskAndCalculateValidPosition();
 
+    /*!
+     * \brief Build position data from position index, or share the position data of mask layer
+     * \return False if the position index is not available
+     */
+    bool BuildPositionData();
+
+    /*!
+     * \brief Build row-span index from position index, should be invoked after
+     *        the position index is newly allocated, i.e., store_pos_ is true
+     */
+    void BuildPositionSpans();
+
+    /*!
+     * \brief Release position data, index, and row-span index if allocated, otherwise reset the pointers
+     */
+    void ReleasePositions();
+
+    /*!
+     * \brief Add values of all layers of the valid cell to statistics, excluding NoData
+     */
+    void AddCellStatistics(int cell_index, vector<RunningStatistics>& stats) const;
+
     /*!
      * \brief Calculate position index from rectangle grid values, if necessary.
      * To use this function, mask should be nullptr.
@@ -1968,10 +2124,13 @@ private:
     T* raster_;
     //! 2D raster data, data access format: raster_2d_[cellIndex][layer], layer starts from 1
     T** raster_2d_;
-    //! valid cells' position (row, col) in raster_data_ or the first layer of raster_2d_ (2D array)
+    //! valid cells' position (row, col) in raster_data_ or the first layer of raster_2d_ (2D array),
+    //!   which is built from pos_idx_ only when required, \sa GetRasterPositionData()
     int** pos_data_;
     //! valid cells' index (row * cols + col) in raster_data_ or the first layer of raster_2d_
     int* pos_idx_;
+    //! row-span index of valid cells, which is shared with mask like pos_idx_
+    RowSpanIndex* pos_spans_;
     //! Key-value options in string format, including spatial reference
     STRING_MAP options_;
     //! Header information, using double in case of truncation of coordinate value
@@ -1990,7 +2149,7 @@ private:
     bool is_2draster;
     //! calculate valid positions or not. The default is true.
     bool calc_pos_;
-    //! raster position data is newly allocated array (true), or just a pointer (false)
+    //! raster position data, index, and spans are newly allocated (true), or just pointers (false)
     bool store_pos_;
     //! To be consistent with other datesets, keep the extent of Mask layer, even include NoDATA.
     bool use_mask_ext_;
@@ -2037,6 +2196,7 @@ void clsRasterData<T, MASK_T>::InitializeRasterClass(bool is_2d /* = false */) {
     raster_ = nullptr;
     pos_data_ = nullptr;
     pos_idx_ = nullptr;
+    pos_spans_ = nullptr;
     mask_ = nullptr;
     subset_ = map<int, SubsetPositions*>();
     n_lyrs_ = -1;
@@ -2215,8 +2375,8 @@ clsRasterData<T, MASK_T>::clsRasterData(clsRasterData<MASK_T>* mask, T* const va
     mask_ = mask;
     use_mask_ext_ = true;
     n_lyrs_ = 1;
-    mask->GetRasterPositionData(&n_cells_, &pos_data_);
     mask->GetRasterPositionData(&n_cells_, &pos_idx_);
+    pos_spans_ = mask->GetRasterPositionSpans();
     if (n_cells_ != len) {
         StatusMessage("Input data length MUST EQUALS TO valid cell's number of mask!");
         initialized_ = false;
@@ -2237,8 +2397,8 @@ clsRasterData<T, MASK_T>::clsRasterData(clsRasterData<MASK_T>* mask, T** const v
     mask_ = mask;
     use_mask_ext_ = true;
     n_lyrs_ = lyrs;
-    mask->GetRasterPositionData(&n_cells_, &pos_data_);
     mask->GetRasterPositionData(&n_cells_, &pos_idx_);
+    pos_spans_ = mask->GetRasterPositionSpans();
     if (n_cells_ != len) {
         StatusMessage("Input data length MUST EQUALS TO valid cell's number of mask!");
         initialized_ = false;
@@ -2325,8 +2485,7 @@ template <typename T, typename MASK_T>
 clsRasterData<T, MASK_T>::~clsRasterData() {
     if (!core_name_.empty()) { StatusMessage(("Release raster: " + core_name_).c_str()); }
     if (nullptr != raster_) { Release1DArray(raster_); }
-    if (nullptr != pos_data_ && store_pos_) { Release2DArray(pos_data_); }
-    if (nullptr != pos_idx_ && store_pos_) { Release1DArray(pos_idx_); }
+    ReleasePositions();
     if (nullptr != raster_2d_ && is_2draster) { Release2DArray(raster_2d_); }
     if (is_2draster && stats_calculated_) { ReleaseStatsMap2D(); }
     ReleaseSubset();
@@ -2335,7 +2494,7 @@ clsRasterData<T, MASK_T>::~clsRasterData() {
 template <typename T, typename MASK_T>
 bool clsRasterData<T, MASK_T>::BuildSubSet(map<int, int> groups /* = map<int, int>() */) {
     if (!ValidateRasterData()) { return false; }
-    if (nullptr == pos_data_ || nullptr == pos_idx_) {
+    if (nullptr == pos_idx_) {
         if (!SetCalcPositions()) { return false; }
     }
     if (!subset_.empty()) { return true; }
@@ -2382,18 +2541,13 @@ bool clsRasterData<T, MASK_T>::BuildSubSet(map<int, int> groups /* = map<int, in
         }
     }
     for (auto it = subset_.begin(); it != subset_.end(); ++it) {
-        Initialize2DArray(it->second->n_cells, 2, it->second->local_pos_, -1);
         Initialize1DArray(it->second->n_cells, it->second->local_posidx_, -1);
 
         int nrows = it->second->g_erow - it->second->g_srow + 1;
         int local_ncols = it->second->g_ecol - it->second->g_scol + 1;
         for (int gidx = 0; gidx < it->second->n_cells; gidx++) {
-            //it->second->local_pos_[gidx][0] = pos_data_[it->second->global_[gidx]][0] - it->second->g_srow;
-            //it->second->local_pos_[gidx][1] = pos_data_[it->second->global_[gidx]][1] - it->second->g_scol;
             int local_row = pos_idx_[it->second->global_[gidx]] / global_ncols - it->second->g_srow;
             int local_col = pos_idx_[it->second->global_[gidx]] % global_ncols  - it->second->g_scol;
-            it->second->local_pos_[gidx][0] = local_row;
-            it->second->local_pos_[gidx][1] = local_col;
             it->second->local_posidx_[gidx] = local_row * local_ncols + local_col;
         }
         it->second->alloc_ = true;
@@ -2437,31 +2591,130 @@ template <typename T, typename MASK_T>
 void clsRasterData<T, MASK_T>::CalculateStatistics() {
     if (stats_calculated_) { return; }
     if (stats_.empty() || stats_2d_.empty()) { InitialStatsMap(stats_, stats_2d_); }
+    vector<RunningStatistics> lyr_stats;
+    GetLayerStatistics(lyr_stats, 0.); // moments only, without quantile sketch
     if (is_2draster && nullptr != raster_2d_) {
-        double** derivedvs = nullptr;
-        BasicStatistics(raster_2d_, n_cells_, n_lyrs_, &derivedvs, no_data_value_);
-        stats_2d_.at(STATS_RS_VALIDNUM) = derivedvs[0];
-        stats_2d_.at(STATS_RS_MEAN) = derivedvs[1];
-        stats_2d_.at(STATS_RS_MAX) = derivedvs[2];
-        stats_2d_.at(STATS_RS_MIN) = derivedvs[3];
-        stats_2d_.at(STATS_RS_STD) = derivedvs[4];
-        stats_2d_.at(STATS_RS_RANGE) = derivedvs[5];
-        // 1D array elements of derivedvs will be released by the destructor: releaseStatsMap2D()
-        Release1DArray(derivedvs);
-    } else {
-        double* derivedv = nullptr;
-        BasicStatistics(raster_, n_cells_, &derivedv, no_data_value_);
-        stats_.at(STATS_RS_VALIDNUM) = derivedv[0];
-        stats_.at(STATS_RS_MEAN) = derivedv[1];
-        stats_.at(STATS_RS_MAX) = derivedv[2];
-        stats_.at(STATS_RS_MIN) = derivedv[3];
-        stats_.at(STATS_RS_STD) = derivedv[4];
-        stats_.at(STATS_RS_RANGE) = derivedv[5];
-        Release1DArray(derivedv);
+        string snames[6] = {
+            STATS_RS_VALIDNUM, STATS_RS_MEAN, STATS_RS_MAX,
+            STATS_RS_MIN, STATS_RS_STD, STATS_RS_RANGE
+        };
+        for (int i = 0; i < 6; i++) {
+            double*& values = stats_2d_.at(snames[i]);
+            if (nullptr == values) { Initialize1DArray(n_lyrs_, values, NODATA_VALUE); }
+        }
+        // 1D arrays will be released by the destructor: releaseStatsMap2D()
+        for (int j = 0; j < n_lyrs_; j++) {
+            stats_2d_.at(STATS_RS_VALIDNUM)[j] = CVT_DBL(lyr_stats[j].Count());
+            stats_2d_.at(STATS_RS_MEAN)[j] = lyr_stats[j].Mean();
+            stats_2d_.at(STATS_RS_MAX)[j] = lyr_stats[j].Maximum();
+            stats_2d_.at(STATS_RS_MIN)[j] = lyr_stats[j].Minimum();
+            stats_2d_.at(STATS_RS_STD)[j] = lyr_stats[j].Std();
+            stats_2d_.at(STATS_RS_RANGE)[j] = lyr_stats[j].Range();
+        }
+    } else if (!lyr_stats.empty()) {
+        stats_.at(STATS_RS_VALIDNUM) = CVT_DBL(lyr_stats[0].Count());
+        stats_.at(STATS_RS_MEAN) = lyr_stats[0].Mean();
+        stats_.at(STATS_RS_MAX) = lyr_stats[0].Maximum();
+        stats_.at(STATS_RS_MIN) = lyr_stats[0].Minimum();
+        stats_.at(STATS_RS_STD) = lyr_stats[0].Std();
+        stats_.at(STATS_RS_RANGE) = lyr_stats[0].Range();
     }
     stats_calculated_ = true;
 }
 
+template <typename T, typename MASK_T>
+void clsRasterData<T, MASK_T>::AddCellStatistics(const int cell_index, vector<RunningStatistics>& stats) const {
+    if (is_2draster) {
+        for (int j = 0; j < n_lyrs_; j++) {
+            if (FloatEqual(raster_2d_[cell_index][j], no_data_value_)) { continue; }
+            stats[j].Add(CVT_DBL(raster_2d_[cell_index][j]));
+        }
+    } else {
+        if (FloatEqual(raster_[cell_index], no_data_value_)) { return; }
+        stats[0].Add(CVT_DBL(raster_[cell_index]));
+    }
+}
+
+template <typename T, typename MASK_T>
+void clsRasterData<T, MASK_T>::GetLayerStatistics(vector<RunningStatistics>& stats,
+                                                  const double relative_accuracy /* = 0.01 */) {
+    stats.clear();
+    if (!ValidateRasterData()) { return; }
+    int lyrs = is_2draster ? n_lyrs_ : 1;
+    stats.assign(lyrs, RunningStatistics(relative_accuracy));
+    int nblocks = (n_cells_ + STATS_BLOCK_SIZE - 1) / STATS_BLOCK_SIZE;
+    vector<vector<RunningStatistics> > block_stats(nblocks, stats);
+#pragma omp parallel for
+    for (int b = 0; b < nblocks; b++) {
+        int end = Min(n_cells_, (b + 1) * STATS_BLOCK_SIZE);
+        for (int i = b * STATS_BLOCK_SIZE; i < end; i++) {
+            AddCellStatistics(i, block_stats[b]);
+        }
+    }
+    for (int b = 0; b < nblocks; b++) {
+        for (int j = 0; j < lyrs; j++) {
+            stats[j].Merge(block_stats[b][j]);
+        }
+    }
+}
+
+template <typename T, typename MASK_T>
+template <typename ZONE_T>
+bool clsRasterData<T, MASK_T>::GetZonalStatistics(clsRasterData<ZONE_T>* zones,
+                                                  map<int, vector<RunningStatistics> >& stats,
+                                                  const double relative_accuracy /* = 0.01 */) {
+    stats.clear();
+    if (!ValidateRasterData() || nullptr == zones || !zones->ValidateRasterData()) { return false; }
+    int n_rows = GetRows();
+    int n_cols = GetCols();
+    double xll = GetXllCenter();
+    double yll = GetYllCenter();
+    double cellsize = GetCellWidth();
+    bool same_grid = n_rows == zones->GetRows() && n_cols == zones->GetCols() &&
+            FloatEqual(xll, zones->GetXllCenter()) && FloatEqual(yll, zones->GetYllCenter()) &&
+            FloatEqual(cellsize, zones->GetCellWidth());
+    ZONE_T zone_nodata = zones->GetNoDataValue();
+    int lyrs = is_2draster ? n_lyrs_ : 1;
+    bool use_pos = calc_pos_ && nullptr != pos_idx_;
+    int nblocks = (n_cells_ + STATS_BLOCK_SIZE - 1) / STATS_BLOCK_SIZE;
+    vector<map<int, vector<RunningStatistics> > > block_stats(nblocks);
+#pragma omp parallel for
+    for (int b = 0; b < nblocks; b++) {
+        map<int, vector<RunningStatistics> >& cur_stats = block_stats[b];
+        int end = Min(n_cells_, (b + 1) * STATS_BLOCK_SIZE);
+        for (int i = b * STATS_BLOCK_SIZE; i < end; i++) {
+            int idx = use_pos ? pos_idx_[i] : i;
+            int row = idx / n_cols;
+            int col = idx % n_cols;
+            ZONE_T zone_value = zone_nodata;
+            if (same_grid) {
+                zone_value = zones->GetValue(row, col);
+            } else {
+                int zone_idx = zones->GetPosition(xll + col * cellsize, yll + (n_rows - 1 - row) * cellsize);
+                if (zone_idx < 0) { continue; }
+                zone_value = zones->GetValueByIndex(zone_idx);
+            }
+            if (FloatEqual(zone_value, zone_nodata)) { continue; }
+            vector<RunningStatistics>& zone_stats = cur_stats[CVT_INT(zone_value)];
+            if (zone_stats.empty()) { zone_stats.assign(lyrs, RunningStatistics(relative_accuracy)); }
+            AddCellStatistics(i, zone_stats);
+        }
+    }
+    for (int b = 0; b < nblocks; b++) {
+        for (auto it = block_stats[b].begin(); it != block_stats[b].end(); ++it) {
+            vector<RunningStatistics>& zone_stats = stats[it->first];
+            if (zone_stats.empty()) {
+                zone_stats.swap(it->second);
+                continue;
+            }
+            for (int j = 0; j < lyrs; j++) {
+                zone_stats[j].Merge(it->second[j]);
+            }
+        }
+    }
+    return true;
+}
+
 template <typename T, typename MASK_T>
 void clsRasterData<T, MASK_T>::ReleaseStatsMap2D() {
     for (auto it = stats_2d_.begin(); it != stats_2d_.end(); ++it) {
@@ -2542,15 +2795,11 @@ int clsRasterData<T, MASK_T>::GetPosition(const int row, const int col) {
         return -2; // means error occurred!
     }
     int pos_idx = GetCols() * row + col;
-    if (!calc_pos_ || nullptr == pos_data_ || nullptr == pos_idx_) {
+    if (!calc_pos_ || nullptr == pos_idx_) {
         return pos_idx;
     }
-// previous low-efficiency code
-//    for (int i = 0; i < n_cells_; i++) {
-//        if (row == pos_data_[i][0] && col == pos_data_[i][1]) {
-//            return i;
-//        }
-//    }
+    // Search the spans of the row, i.e., O(log(spans of row))
+    if (nullptr != pos_spans_) { return pos_spans_->GetPosition(row, col); }
     // Use binary search method, refers to https://leetcode.cn/problems/binary-search
     //int search(vector<int>& nums, int target) {
     int left = 0;
@@ -2637,7 +2886,7 @@ bool clsRasterData<T, MASK_T>::Get2DRasterData(int* n_cells, int* n_lyrs, T*** d
 
 template <typename T, typename MASK_T>
 void clsRasterData<T, MASK_T>::GetRasterPositionData(int* datalength, int*** positiondata) {
-    if (nullptr != pos_data_) {
+    if (nullptr != pos_data_ || BuildPositionData()) {
         *datalength = n_cells_;
         *positiondata = pos_data_;
     } else {
@@ -2648,11 +2897,18 @@ void clsRasterData<T, MASK_T>::GetRasterPositionData(int* datalength, int*** pos
             return;
         }
         CalculateValidPositionsFromGridData();
+        BuildPositionData();
         *datalength = n_cells_;
         *positiondata = pos_data_;
     }
 }
 
+template <typename T, typename MASK_T>
+int** clsRasterData<T, MASK_T>::GetRasterPositionDataPointer() {
+    if (nullptr == pos_data_) { BuildPositionData(); }
+    return pos_data_;
+}
+
 template <typename T, typename MASK_T>
 void clsRasterData<T, MASK_T>::GetRasterPositionData(int* datalength, int** positiondata) {
     if (nullptr != pos_idx_) {
@@ -2814,7 +3070,7 @@ template <typename T, typename MASK_T>
 bool clsRasterData<T, MASK_T>::SetPositions(int len, int** pdata) {
     if (nullptr != pos_data_) {
         if (len != n_cells_) { return false; } // cannot change origin n_cells_
-        Release2DArray(pos_data_);
+        if (store_pos_) { Release2DArray(pos_data_); } // may be shared with mask
     }
     pos_data_ = pdata;
     calc_pos_ = true;
@@ -2826,8 +3082,10 @@ template <typename T, typename MASK_T>
 bool clsRasterData<T, MASK_T>::SetPositions(int len, int* pdata) {
     if (nullptr != pos_idx_) {
         if (len != n_cells_) { return false; } // cannot change origin n_cells_
-        Release1DArray(pos_idx_);
+        if (store_pos_) { Release1DArray(pos_idx_); } // may be shared with mask
     }
+    if (nullptr != pos_spans_ && store_pos_) { delete pos_spans_; }
+    pos_spans_ = nullptr; // GetPosition() uses binary search on the specified index instead
     pos_idx_ = pdata;
     calc_pos_ = true;
     store_pos_ = false;
@@ -3065,7 +3323,6 @@ bool clsRasterData<T, MASK_T>::PrepareSubsetData(const int sub_id, SubsetPositio
     Initialize1DArray(data_length, data1d, no_data_value_);
     for (int vi = 0; vi < sub->n_cells; vi++) {
         for (int ilyr = 0; ilyr < lyrs; ilyr++) {
-            //int j = sub->local_pos_[vi][0] * ncols + sub->local_pos_[vi][1];
             int j = sub->local_posidx_[vi];
             int gidx = sub->global_[vi];
             if (!include_nodata) { j = vi; }
@@ -3136,14 +3393,11 @@ bool clsRasterData<T, MASK_T>::OutputAscFile(const string& filename) {
     string abs_filename = GetAbsolutePath(filename);
     // Is there need to calculate valid position index?
     int count;
-    int** position = nullptr;
     int* position_idx = nullptr;
     bool outputdirectly = true;
-    if ((nullptr != pos_data_ || nullptr != pos_idx_)) {
-        GetRasterPositionData(&count, &position);
+    if (nullptr != pos_idx_) {
         GetRasterPositionData(&count, &position_idx);
         outputdirectly = false;
-        assert(nullptr != position);
         assert(nullptr != position_idx);
     }
     // Begin to write raster data
@@ -3168,7 +3422,7 @@ bool clsRasterData<T, MASK_T>::OutputAscFile(const string& filename) {
                         raster_file << setprecision(6) << raster_2d_[index][lyr] << " ";
                         continue;
                     }
-                    if (index < n_cells_ && (position[index][0] == i && position[index][1] == j)) {
+                    if (index < n_cells_ && position_idx[index] == i * cols + j) {
                         raster_file << setprecision(6) << raster_2d_[index][lyr] << " ";
                         index++;
                     } else { raster_file << setprecision(6) << NODATA_VALUE << " "; }
@@ -3193,7 +3447,7 @@ bool clsRasterData<T, MASK_T>::OutputAscFile(const string& filename) {
                     continue;
                 }
                 if (index < n_cells_) {
-                    if (position[index][0] == i && position[index][1] == j) {
+                    if (position_idx[index] == i * cols + j) {
                         raster_file << setprecision(6) << raster_[index] << " ";
                         index++;
                     } else { raster_file << setprecision(6) << no_data_value_ << " "; }
@@ -3203,7 +3457,7 @@ bool clsRasterData<T, MASK_T>::OutputAscFile(const string& filename) {
         }
         raster_file.close();
     }
-    position = nullptr;
+    position_idx = nullptr;
     return true;
 }
 
@@ -3211,7 +3465,7 @@ bool clsRasterData<T, MASK_T>::OutputAscFile(const string& filename) {
 template <typename T, typename MASK_T>
 bool clsRasterData<T, MASK_T>::OutputFileByGdal(const string& filename) {
     string abs_filename = GetAbsolutePath(filename);
-    bool outputdirectly = (nullptr == pos_data_ || nullptr == pos_idx_);
+    bool outputdirectly = nullptr == pos_idx_;
     int n_rows = CVT_INT(headers_.at(HEADER_RS_NROWS));
     int n_cols = CVT_INT(headers_.at(HEADER_RS_NCOLS));
     bool outflag = false;
@@ -3278,16 +3532,16 @@ bool clsRasterData<T, MASK_T>::OutputToMongoDB(MongoGridFs* gfs, const string& f
         UpdateStrHeader(options_, HEADER_RSOUT_DATATYPE,
                         RasterDataTypeToString(TypeToRasterDataType(typeid(T))));
     }
-    // Check if we can output directly: 1) pos_data_ is not NULL and include_nodata is false;
-    //                                  2) pos_data_ is NULL and include_nodata is true.
+    // Check if we can output directly: 1) pos_idx_ is not NULL and include_nodata is false;
+    //                                  2) pos_idx_ is NULL and include_nodata is true.
     bool outputdirectly = true; // output directly or create new full size array
     int cnt;
-    int** pos = nullptr;
-    if ((nullptr != pos_data_ || nullptr != pos_idx_) && include_nodata) {
+    int* pos = nullptr;
+    if (nullptr != pos_idx_ && include_nodata) {
         outputdirectly = false;
         GetRasterPositionData(&cnt, &pos);
     }
-    if ((nullptr == pos_data_ || nullptr == pos_idx_) && !include_nodata) {
+    if (nullptr == pos_idx_ && !include_nodata) {
         SetCalcPositions();
         GetRasterPositionData(&cnt, &pos);
     }
@@ -3312,7 +3566,7 @@ bool clsRasterData<T, MASK_T>::OutputToMongoDB(MongoGridFs* gfs, const string& f
             datalength = n_lyrs_ * n_fullsize;
             Initialize1DArray(datalength, data_1d, no_data_value);
             for (int idx = 0; idx < n_cells_; idx++) {
-                int rowcol_index = pos[idx][0] * n_cols + pos[idx][1];
+                int rowcol_index = pos[idx];
                 for (int k = 0; k < n_lyrs_; k++) {
                     data_1d[n_lyrs_ * rowcol_index + k] = raster_2d_[idx][k];
                 }
@@ -3326,7 +3580,7 @@ bool clsRasterData<T, MASK_T>::OutputToMongoDB(MongoGridFs* gfs, const string& f
             datalength = n_fullsize;
             Initialize1DArray(datalength, data_1d, no_data_value);
             for (int idx = 0; idx < n_cells_; idx++) {
-                data_1d[pos[idx][0] * n_cols + pos[idx][1]] = raster_[idx];
+                data_1d[pos[idx]] = raster_[idx];
             }
         }
     }
@@ -3526,7 +3780,43 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
         UpdateStringMap(opts_upd, HEADER_INC_NODATA, "TRUE");
     }
     if (!ReadGridFsFile(gfs, filename, dbdata, header_dbl, header_str, opts_upd)) { return false; }
+    return ConstructFromStreamData(dbdata, header_dbl, header_str);
+}
+
+#endif /* USE_MONGODB */
+
+template <typename T, typename MASK_T>
+bool clsRasterData<T, MASK_T>::ReadFromStream(const char* buf, const vint length, const STRING_MAP& metadata,
+                                              const string& filename, const bool calc_pos /* = false */,
+                                              clsRasterData<MASK_T>* mask /* = nullptr */,
+                                              const bool use_mask_ext /* = true */,
+                                              double default_value /* NODATA_VALUE */,
+                                              const STRING_MAP& opts /* = STRING_MAP() */) {
+    InitializeReadFunction(filename, calc_pos, mask, use_mask_ext, default_value, opts);
+    STRDBL_MAP header_dbl = InitialHeader();
+    STRING_MAP header_str = InitialStrHeader();
+    // The same as ReadGridFsFile, numeric header values to `header_dbl`, others to `header_str`
+    for (auto it = metadata.begin(); it != metadata.end(); ++it) {
+        if (header_dbl.find(it->first) != header_dbl.end()) {
+            bool flag = false;
+            double value = IsDouble(it->second, flag);
+            if (flag) { header_dbl[it->first] = value; }
+        } else {
+            header_str[it->first] = it->second;
+        }
+    }
+    if (header_dbl.at(HEADER_RS_NROWS) < 0 || header_dbl.at(HEADER_RS_NCOLS) < 0
+        || header_dbl.at(HEADER_RS_LAYERS) < 0) { // missing essential metadata
+        return false;
+    }
+    T* data = nullptr;
+    if (!ReadStreamData(buf, length, header_dbl, header_str, data)) { return false; }
+    return ConstructFromStreamData(data, header_dbl, header_str);
+}
 
+template <typename T, typename MASK_T>
+bool clsRasterData<T, MASK_T>::ConstructFromStreamData(T* dbdata, const STRDBL_MAP& header_dbl,
+                                                       const STRING_MAP& header_str) {
     if (headers_.at(HEADER_RS_NROWS) > 0 && headers_.at(HEADER_RS_NCOLS) > 0
         && headers_.at(HEADER_RS_LAYERS) > 0 && headers_.at(HEADER_RS_CELLSNUM) > 0) {
         // means the raster is preassigned header information, and this function is used for read data only
@@ -3559,9 +3849,9 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
     bool mask_pos_subset = true;
     if (nullptr != mask_ && calc_pos_ && use_mask_ext_ && n_cells_ == mask_->GetValidNumber()) {
         store_pos_ = false;
-        mask_->GetRasterPositionData(&n_cells_, &pos_data_);
         mask_->GetRasterPositionData(&n_cells_, &pos_idx_);
-        if (!mask->GetSubset().empty()) {
+        pos_spans_ = mask_->GetRasterPositionSpans();
+        if (!mask_->GetSubset().empty()) {
             map<int, SubsetPositions*>& mask_subset = mask_->GetSubset();
             for (auto it = mask_subset.begin(); it != mask_subset.end(); ++it) {
                 SubsetPositions* tmp = new SubsetPositions(it->second, true);
@@ -3576,7 +3866,7 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
         mask_pos_subset = false;
     }
 
-    if (!include_nodata && (nullptr == pos_data_ || nullptr == pos_idx_)) { return false; }
+    if (!include_nodata && nullptr == pos_idx_) { return false; }
 
     if (n_lyrs_ == 1) {
         is_2draster = false;
@@ -3584,7 +3874,6 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
             Initialize1DArray(n_cells_, raster_, no_data_value_);
 #pragma omp parallel for
             for (int i = 0; i < n_cells_; i++) {
-                //int tmpidx = pos_data_[i][0] * n_cols + pos_data_[i][1];
                 int tmpidx = pos_idx_[i];
                 raster_[i] = static_cast<T>(dbdata[tmpidx]);
             }
@@ -3598,7 +3887,6 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
         for (int i = 0; i < n_cells_; i++) {
             int tmpidx = i;
             if (include_nodata && !mask_pos_subset) {
-                //tmpidx = pos_data_[i][0] * n_cols + pos_data_[i][1];
                 tmpidx = pos_idx_[i];
             }
             for (int j = 0; j < n_lyrs_; j++) {
@@ -3616,8 +3904,6 @@ bool clsRasterData<T, MASK_T>::ReadFromMongoDB(MongoGridFs* gfs,
     return true;
 }
 
-#endif /* USE_MONGODB */
-
 template <typename T, typename MASK_T>
 void clsRasterData<T, MASK_T>::AddOtherLayerRasterData(const int row, const int col,
                                                        const int cellidx, const int lyr,
@@ -3650,12 +3936,7 @@ void clsRasterData<T, MASK_T>::Copy(clsRasterData<T, MASK_T>* orgraster) {
     if (!is_2draster && nullptr != raster_) {
         Release1DArray(raster_);
     }
-    if (nullptr != pos_data_) {
-        Release2DArray(pos_data_);
-    }
-    if (nullptr != pos_idx_) {
-        Release1DArray(pos_idx_);
-    }
+    ReleasePositions();
     if (stats_calculated_) {
         ReleaseStatsMap2D();
         stats_calculated_ = false;
@@ -3681,7 +3962,6 @@ void clsRasterData<T, MASK_T>::Copy(clsRasterData<T, MASK_T>* orgraster) {
     }
     if (calc_pos_) {
         store_pos_ = true;
-        Initialize2DArray(n_cells_, 2, pos_data_, orgraster->GetRasterPositionDataPointer());
         Initialize1DArray(n_cells_, pos_idx_, orgraster->GetRasterPositionIndexPointer());
     }
     stats_calculated_ = orgraster->StatisticsCalculated();
@@ -3701,6 +3981,7 @@ void clsRasterData<T, MASK_T>::Copy(clsRasterData<T, MASK_T>* orgraster) {
         }
     }
     CopyHeader(orgraster->GetRasterHeader(), headers_);
+    if (calc_pos_) { BuildPositionSpans(); }
     // deep copy subset
     if (!orgraster->GetSubset().empty()) {
         for (auto it = orgraster->GetSubset().begin(); it != orgraster->GetSubset().end(); ++it) {
@@ -3843,8 +4124,7 @@ void clsRasterData<T, MASK_T>::CalculateValidPositionsFromGridData() {
         Release1DArray(raster_);
         Initialize1DArray(n_cells_, raster_, no_data_value_);
     }
-    // pos_data_ is nullptr till now.
-    Initialize2DArray(n_cells_, 2, pos_data_, 0);
+    // pos_idx_ is nullptr till now, and pos_data_ will be built on demand.
     Initialize1DArray(n_cells_, pos_idx_, 0);
     store_pos_ = true;
 #pragma omp parallel for
@@ -3859,10 +4139,9 @@ void clsRasterData<T, MASK_T>::CalculateValidPositionsFromGridData() {
         } else {
             raster_[i] = values.at(i);
         }
-        pos_data_[i][0] = pos_rows.at(i);
-        pos_data_[i][1] = pos_cols.at(i);
         pos_idx_[i] = pos_rows.at(i) * ncols + pos_cols.at(i);
     }
+    BuildPositionSpans();
     calc_pos_ = true;
 }
 
@@ -3871,7 +4150,7 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
     int old_fullsize = GetRows() * GetCols();
     if (nullptr == mask_) {
         if (calc_pos_) {
-            if (nullptr == pos_data_ || nullptr == pos_idx_) {
+            if (nullptr == pos_idx_) {
                 CalculateValidPositionsFromGridData();
                 return 1;
             }
@@ -3885,10 +4164,10 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
     // Use mask data
     // 1. Get new values, positions, and subsets (if exist) according to Mask's position data
     int mask_ncells;
-    int** valid_pos = nullptr;
+    int* valid_pos = nullptr;
     int mask_rows = mask_->GetRows();
     int mask_cols = mask_->GetCols();
-    // Get the position data from mask
+    // Get the position index from mask
     if (!mask_->PositionsCalculated()) { mask_->SetCalcPositions(); }
     mask_->GetRasterPositionData(&mask_ncells, &valid_pos);
     // Masked raster data have the same size with mask's valid positions
@@ -3905,8 +4184,8 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
     int matched_count = 0; // valid value matched count
     // Get the valid data according to coordinate
     for (int i = 0; i < mask_ncells; i++) {
-        int tmp_row = valid_pos[i][0];
-        int tmp_col = valid_pos[i][1];
+        int tmp_row = valid_pos[i] / mask_cols;
+        int tmp_col = valid_pos[i] % mask_cols;
         XY_COOR tmp_xy = mask_->GetCoordinateByRowCol(tmp_row, tmp_col);
         ROW_COL tmp_pos = GetPositionByCoordinate(tmp_xy.first, tmp_xy.second);
         T tmp_value;
@@ -4102,27 +4381,23 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
         vector<int>(pos_rows).swap(pos_rows);
         vector<int>(pos_cols).swap(pos_cols);
 
+        ReleasePositions();
         store_pos_ = true;
         n_cells_ = CVT_INT(values.size());
-        if (nullptr != pos_data_) { Release2DArray(pos_data_); }
-        if (nullptr != pos_idx_) { Release1DArray(pos_idx_); }
-        Initialize2DArray(n_cells_, 2, pos_data_, 0);
         Initialize1DArray(n_cells_, pos_idx_, 0);
         for (size_t k = 0; k < pos_rows.size(); ++k) {
-            pos_data_[k][0] = pos_rows.at(k);
-            pos_data_[k][1] = pos_cols.at(k);
             if (upd_header_rowcol) {
                 pos_idx_[k] = pos_rows.at(k) * new_cols + pos_cols.at(k);
             } else {
                 pos_idx_[k] = pos_rows.at(k) * mask_cols + pos_cols.at(k);
             }
         }
+        BuildPositionSpans();
     } else {
-        if (nullptr != pos_data_) { Release2DArray(pos_data_); }
-        if (nullptr != pos_idx_) { Release1DArray(pos_idx_); }
-        if (calc_pos_) {
-            mask_->GetRasterPositionData(&n_cells_, &pos_data_);
+        ReleasePositions();
+        if (calc_pos_) { // share the position index and spans of mask
             mask_->GetRasterPositionData(&n_cells_, &pos_idx_);
+            pos_spans_ = mask_->GetRasterPositionSpans();
         }
         store_pos_ = false;
     }
@@ -4189,8 +4464,8 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
             vector<int> globalpos;
             for (int i = 0; i < it->second->n_cells; i++) {
                 int gi = it->second->global_[i];
-                int tmprow = valid_pos[gi][0];
-                int tmpcol = valid_pos[gi][1];
+                int tmprow = valid_pos[gi] / mask_cols;
+                int tmpcol = valid_pos[gi] % mask_cols;
                 XY_COOR tmpxy = mask_->GetCoordinateByRowCol(tmprow, tmpcol);
                 if (GetPosition(tmpxy.first, tmpxy.second) < 0) { continue; }
                 ROW_COL tmppos = GetPositionByCoordinate(tmpxy.first, tmpxy.second);
@@ -4217,31 +4492,24 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
                 int local_ncols = ecol - scol + 1;
                 if (it->second->alloc_) {
                     Release1DArray(it->second->global_);
-                    Release2DArray(it->second->local_pos_);
                     Release1DArray(it->second->local_posidx_);
                 }
                 it->second->global_ = nullptr; // not affect mask's subset
-                it->second->local_pos_ = nullptr;
                 it->second->local_posidx_ = nullptr;
                 it->second->alloc_ = true;
                 Initialize1DArray(count, it->second->global_, -1);
-                Initialize2DArray(count, 2, it->second->local_pos_, -1);
                 Initialize1DArray(count, it->second->local_posidx_, -1);
                 for (int ii = 0; ii < count; ii++) {
                     it->second->global_[ii] = globalpos[ii];
                     int local_row = -1;
                     int local_col = -1;
-                    if (nullptr == pos_data_ || nullptr == pos_idx_) {
+                    if (nullptr == pos_idx_) {
                         local_row = globalpos[ii] / ncols - it->second->g_srow;
                         local_col = globalpos[ii] % ncols - it->second->g_scol;
                     } else {
-                        //local_row = pos_data_[globalpos[ii]][0] - it->second->g_srow;
-                        //local_col = pos_data_[globalpos[ii]][1] - it->second->g_scol;
                         local_row = pos_idx_[globalpos[ii]] / ncols - it->second->g_srow;
                         local_col = pos_idx_[globalpos[ii]] % ncols - it->second->g_scol;
                     }
-                    it->second->local_pos_[ii][0] = local_row;
-                    it->second->local_pos_[ii][1] = local_col;
                     it->second->local_posidx_[ii] = local_row * local_ncols + local_col;
                 }
                 it->second->data_ = nullptr;
@@ -4257,6 +4525,51 @@ int clsRasterData<T, MASK_T>::MaskAndCalculateValidPosition() {
     return 2; // all situations that use mask data
 }
 
+template <typename T, typename MASK_T>
+bool clsRasterData<T, MASK_T>::BuildPositionData() {
+    if (nullptr != pos_data_) { return true; }
+    if (nullptr == pos_idx_ || n_cells_ <= 0) { return false; }
+    if (!store_pos_) {
+        // The position index is shared with mask, so does the position data
+        if (nullptr == mask_ || mask_->GetRasterPositionIndexPointer() != pos_idx_) { return false; }
+        pos_data_ = mask_->GetRasterPositionDataPointer();
+        return nullptr != pos_data_;
+    }
+    int ncols = GetCols();
+    Initialize2DArray(n_cells_, 2, pos_data_, 0);
+#pragma omp parallel for
+    for (int i = 0; i < n_cells_; i++) {
+        pos_data_[i][0] = pos_idx_[i] / ncols;
+        pos_data_[i][1] = pos_idx_[i] % ncols;
+    }
+    return true;
+}
+
+template <typename T, typename MASK_T>
+void clsRasterData<T, MASK_T>::BuildPositionSpans() {
+    if (nullptr != pos_spans_ && store_pos_) { delete pos_spans_; }
+    pos_spans_ = nullptr;
+    if (nullptr == pos_idx_ || n_cells_ <= 0) { return; }
+    RowSpanIndex* spans = new RowSpanIndex();
+    if (!spans->Build(GetRows(), GetCols(), pos_idx_, n_cells_)) {
+        delete spans; // GetPosition() uses binary search on pos_idx_ instead
+        return;
+    }
+    pos_spans_ = spans;
+}
+
+template <typename T, typename MASK_T>
+void clsRasterData<T, MASK_T>::ReleasePositions() {
+    if (store_pos_) {
+        if (nullptr != pos_data_) { Release2DArray(pos_data_); }
+        if (nullptr != pos_idx_) { Release1DArray(pos_idx_); }
+        if (nullptr != pos_spans_) { delete pos_spans_; }
+    }
+    pos_data_ = nullptr;
+    pos_idx_ = nullptr;
+    pos_spans_ = nullptr;
+}
+
 } // namespace data_raster
 } // namespace ccgl
 #endif /* CCGL_DATA_RASTER_H */
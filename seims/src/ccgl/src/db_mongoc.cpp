@@ -6,6 +6,7 @@
  *   - 1. 2017-12-02 - lj - Add unittest based on gtest/gmock.
  *   - 2. 2018-05-02 - lj - Make part of CCGL.
  *   - 3. 2019-08-16 - lj - Add or move detail description in the implementation code.
+ *   - 4. 2026-10-19 - lj - Chunked compression of GridFS file data flagged by metadata.
  *
  * \author Liangjun Zhu, zlj(at)lreis.ac.cn
  * \version 1.2
@@ -18,6 +19,7 @@
 #include "utils_string.h"
 #include "utils_math.h"
 #include "utils_time.h"
+#include "utils_codec.h"
 
 using std::cout;
 using std::endl;
@@ -26,6 +28,7 @@ using std::endl;
 namespace ccgl {
 using namespace utils_string;
 using namespace utils_time;
+using namespace utils_codec;
 
 namespace db_mongoc {
 ///////////////////////////////////////////////////
@@ -297,7 +300,7 @@ vint MongoCollection::QueryRecordsCount() {
 ///////////////////////////////////////////////////
 ////////////////  MongoGridFs  ////////////////////
 ///////////////////////////////////////////////////
-MongoGridFs::MongoGridFs(mongoc_gridfs_t* gfs /* = NULL */) : gfs_(gfs) {
+MongoGridFs::MongoGridFs(mongoc_gridfs_t* gfs /* = NULL */) : gfs_(gfs), compress_(false) {
     // Do nothing.
 }
 
@@ -435,18 +438,52 @@ bool MongoGridFs::GetStreamData(string const& gfilename, char*& databuf,
     // Set 10 milliseconds for timeout
     vint flag = mongoc_stream_readv(stream, &iov, 1, -1, 10);
     mongoc_stream_destroy(stream);
+    // Decode the data if flagged as compressed in metadata, otherwise the raw data are returned
+    //   as before, e.g., the files written by previous versions or without compression.
+    bool encoded = false;
+    const bson_t* meta = mongoc_gridfs_file_get_metadata(gfile);
+    bson_iter_t iter;
+    if (flag >= 0 && NULL != meta && bson_iter_init_find(&iter, meta, GFS_META_CODEC)
+        && BSON_ITER_HOLDS_UTF8(&iter)) {
+        encoded = StringMatch(bson_iter_utf8(&iter, NULL), GFS_CODEC_CHUNKS);
+    }
     mongoc_gridfs_file_destroy(gfile);
-    return flag >= 0;
+    if (!encoded || !IsEncodedChunks(databuf, datalength)) { return flag >= 0; }
+    vint rawlength = DecodedLength(databuf, datalength);
+    char* rawbuf = static_cast<char *>(malloc(rawlength > 0 ? rawlength : 1));
+    if (!DecodeChunks(databuf, datalength, rawbuf, rawlength)) {
+        StatusMessage(("MongoGridFs::GetStreamData(" + gfilename + ") failed to decode!").c_str());
+        free(rawbuf);
+        free(databuf);
+        databuf = NULL;
+        datalength = 0;
+        return false;
+    }
+    free(databuf);
+    databuf = rawbuf;
+    datalength = rawlength;
+    return true;
 }
 
 bool MongoGridFs::WriteStreamData(const string& gfilename, char*& buf,
                                   vint length, const bson_t* p,
-                                  mongoc_gridfs_t* gfs /* = NULL */) {
+                                  mongoc_gridfs_t* gfs /* = NULL */,
+                                  const int elem_size /* = 4 */) {
     if (gfs_ != NULL) { gfs = gfs_; }
     if (NULL == gfs) {
         StatusMessage("mongoc_gridfs_t must be provided for MongoGridFs!");
         return false;
     }
+    // Encode the data into compressed chunks and flag it in metadata, so that
+    //   GetStreamData() can decode it while the raw data remain readable.
+    vector<char> encoded;
+    bson_t meta = BSON_INITIALIZER;
+    bool compressed = compress_ && length > 0 && EncodeChunks(buf, length, elem_size, encoded);
+    if (compressed) {
+        if (NULL != p) { bson_copy_to_excluding_noinit(p, &meta, GFS_META_CODEC, NULL); }
+        BSON_APPEND_UTF8(&meta, GFS_META_CODEC, GFS_CODEC_CHUNKS);
+        p = &meta;
+    }
     mongoc_gridfs_file_t* gfile = NULL;
     bson_error_t gfileerr;
     mongoc_gridfs_file_opt_t gopt = {0};
@@ -455,8 +492,8 @@ bool MongoGridFs::WriteStreamData(const string& gfilename, char*& buf,
     gopt.metadata = p;
     gfile = mongoc_gridfs_create_file(gfs, &gopt);
     mongoc_iovec_t ovec;
-    ovec.iov_base = buf;
-    ovec.iov_len = static_cast<u_long>(length);
+    ovec.iov_base = compressed ? &encoded[0] : buf;
+    ovec.iov_len = static_cast<u_long>(compressed ? encoded.size() : length);
     // Modifying GridFS files is NOT thread-safe. Only one thread or process
     //   can access a GridFS file while it is being modified!
     ssize_t writesize = mongoc_gridfs_file_writev(gfile, &ovec, 1, 0);
@@ -467,6 +504,7 @@ bool MongoGridFs::WriteStreamData(const string& gfilename, char*& buf,
                           ". ERROR: " + gfileerr.message).c_str());
     }
     mongoc_gridfs_file_destroy(gfile);
+    bson_destroy(&meta);
     return gfilestatus;
 }
 
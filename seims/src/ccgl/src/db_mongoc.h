@@ -7,6 +7,7 @@
  *   - 1. 2017-12-02 - lj - Add unittest based on gtest/gmock.
  *   - 2. 2018-05-02 - lj - Make part of CCGL.
  *   - 3. 2019-08-16 - lj - Simplify brief desc. and move detail desc. to implementation.
+ *   - 4. 2026-10-19 - lj - Optional chunked compression of GridFS file data, \sa utils_codec.
  *
  * \note No exceptions will be thrown.
  * \author Liangjun Zhu, zlj(at)lreis.ac.cn
@@ -37,6 +38,11 @@ namespace ccgl {
  * see <a href="http://mongoc.org/">MongoDB C Driver</a> for more information.
  */
 namespace db_mongoc {
+/*! Metadata key of the codec of GridFS file data, absent for raw data */
+const char* const GFS_META_CODEC = "CODEC";
+/*! Codec value of data encoded by utils_codec::EncodeChunks() */
+const char* const GFS_CODEC_CHUNKS = "SHUFFLE_LZ";
+
 class MongoGridFs;
 
 /*!
@@ -164,17 +170,33 @@ public:
     bson_t* GetFileMetadata(string const& gfilename, mongoc_gridfs_t* gfs = NULL,
                             STRING_MAP opts = STRING_MAP());
 
-    /*! Get stream data of a given GridFS file name */
+    /*! Compress the stream data written by WriteStreamData() or not, false by default */
+    void SetCompression(const bool compress) { compress_ = compress; }
+
+    /*! Is the stream data compressed while writing */
+    bool GetCompression() const { return compress_; }
+
+    /*! Get stream data of a given GridFS file name, which is decoded if compressed */
     bool GetStreamData(string const& gfilename, char*& databuf, vint& datalength,
                        mongoc_gridfs_t* gfs = NULL,
                        const STRING_MAP* opts = nullptr);
 
-    /*! Write stream data to a GridFS file */
+    /*!
+     * \brief Write stream data to a GridFS file
+     * \param[in] gfilename GridFS file name
+     * \param[in] buf Stream data
+     * \param[in] length Length of stream data
+     * \param[in] p Metadata
+     * \param[in] gfs Instance of `mongoc_gridfs_t` if not specified in constructor
+     * \param[in] elem_size Element size in bytes of the stream data, used by the byte-shuffle
+     *                      filter when compression is enabled, \sa SetCompression()
+     */
     bool WriteStreamData(const string& gfilename, char*& buf, vint length,
-                         const bson_t* p, mongoc_gridfs_t* gfs = NULL);
+                         const bson_t* p, mongoc_gridfs_t* gfs = NULL, int elem_size = 4);
 
 private:
     mongoc_gridfs_t* gfs_; ///< Instance of `mongoc_gridfs_t`
+    bool compress_; ///< Compress the stream data while writing
 };
 
 /*! Append options to `bson_t` */
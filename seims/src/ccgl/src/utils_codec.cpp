@@ -0,0 +1,337 @@
+#include "utils_codec.h"
+
+#include <climits>
+#include <cstring>
+
+namespace ccgl {
+namespace utils_codec {
+const int LZ_MIN_MATCH = 4;          ///< Minimum length of matches
+const int LZ_HASH_LOG = 14;          ///< Log2 of the size of hash table of 4-byte sequences
+const int LZ_MAX_OFFSET = 65535;     ///< Maximum offset of matches, i.e., stored in 2 bytes
+const char CODEC_MAGIC[4] = {'C', 'C', 'Z', '1'};
+const vuint32_t CHUNK_STORED = 0;    ///< Chunk stored as is
+const vuint32_t CHUNK_SHUFFLE_LZ = 1; ///< Chunk shuffled and compressed
+
+/// Little-endian integers of encoded stream
+
+void PutUint32(char* p, const vuint32_t v) {
+    for (int i = 0; i < 4; i++) { p[i] = static_cast<char>((v >> (8 * i)) & 0xFF); }
+}
+
+void PutUint64(char* p, const vuint64_t v) {
+    for (int i = 0; i < 8; i++) { p[i] = static_cast<char>((v >> (8 * i)) & 0xFF); }
+}
+
+vuint32_t GetUint32(const char* p) {
+    vuint32_t v = 0;
+    for (int i = 0; i < 4; i++) { v |= static_cast<vuint32_t>(static_cast<vuint8_t>(p[i])) << (8 * i); }
+    return v;
+}
+
+vuint64_t GetUint64(const char* p) {
+    vuint64_t v = 0;
+    for (int i = 0; i < 8; i++) { v |= CVT_VUINT64(static_cast<vuint8_t>(p[i])) << (8 * i); }
+    return v;
+}
+
+bool InitCrc32Table(vuint32_t* table) {
+    for (vuint32_t i = 0; i < 256; i++) {
+        vuint32_t c = i;
+        for (int k = 0; k < 8; k++) {
+            c = c & 1 ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+        }
+        table[i] = c;
+    }
+    return true;
+}
+
+vuint32_t Crc32(const char* data, const vint64_t length, const vuint32_t crc /* = 0 */) {
+    static vuint32_t table[256];
+    static bool initialized = InitCrc32Table(table);
+    if (!initialized) { return 0; }
+    vuint32_t c = crc ^ 0xFFFFFFFFU;
+    for (vint64_t i = 0; i < length; i++) {
+        c = table[(c ^ static_cast<vuint8_t>(data[i])) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFU;
+}
+
+void ShuffleBytes(const char* src, const vint64_t length, const int elem_size, char* dst) {
+    if (elem_size <= 1) {
+        memcpy(dst, src, length);
+        return;
+    }
+    vint64_t n_elems = length / elem_size;
+    for (int b = 0; b < elem_size; b++) {
+        char* dst_b = dst + b * n_elems;
+        for (vint64_t e = 0; e < n_elems; e++) {
+            dst_b[e] = src[e * elem_size + b];
+        }
+    }
+    vint64_t shuffled = n_elems * elem_size;
+    memcpy(dst + shuffled, src + shuffled, length - shuffled);
+}
+
+void UnshuffleBytes(const char* src, const vint64_t length, const int elem_size, char* dst) {
+    if (elem_size <= 1) {
+        memcpy(dst, src, length);
+        return;
+    }
+    vint64_t n_elems = length / elem_size;
+    for (int b = 0; b < elem_size; b++) {
+        const char* src_b = src + b * n_elems;
+        for (vint64_t e = 0; e < n_elems; e++) {
+            dst[e * elem_size + b] = src_b[e];
+        }
+    }
+    vint64_t shuffled = n_elems * elem_size;
+    memcpy(dst + shuffled, src + shuffled, length - shuffled);
+}
+
+/// LZ77 compressor, each sequence is formatted as:
+///   token (high 4 bits: literal length, low 4 bits: match length - 4), extra bytes of literal length
+///   if it is not less than 15, literals, offset of match (2 bytes), and extra bytes of match length.
+///   The last sequence contains literals only.
+
+vuint32_t Read32(const vuint8_t* p) {
+    vuint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+vuint32_t LzHash(const vuint32_t seq) {
+    return (seq * 2654435761U) >> (32 - LZ_HASH_LOG);
+}
+
+bool WriteLength(vuint8_t*& op, const vuint8_t* oend, int len) {
+    while (len >= 255) {
+        if (op >= oend) { return false; }
+        *op++ = 255;
+        len -= 255;
+    }
+    if (op >= oend) { return false; }
+    *op++ = static_cast<vuint8_t>(len);
+    return true;
+}
+
+bool ReadLength(const vuint8_t*& ip, const vuint8_t* iend, int& len, const int max_len) {
+    vuint8_t b = 255;
+    while (b == 255) {
+        if (ip >= iend) { return false; }
+        b = *ip++;
+        len += b;
+        if (len > max_len) { return false; }
+    }
+    return true;
+}
+
+bool EmitSequence(const vuint8_t* literals, const int lit_len, const int offset, const int match_len,
+                  vuint8_t*& op, const vuint8_t* oend) {
+    if (op >= oend) { return false; }
+    vuint8_t* token = op++;
+    int ml = match_len > 0 ? match_len - LZ_MIN_MATCH : 0;
+    *token = static_cast<vuint8_t>(((lit_len >= 15 ? 15 : lit_len) << 4) | (ml >= 15 ? 15 : ml));
+    if (lit_len >= 15 && !WriteLength(op, oend, lit_len - 15)) { return false; }
+    if (oend - op < lit_len) { return false; }
+    memcpy(op, literals, lit_len);
+    op += lit_len;
+    if (match_len <= 0) { return true; }
+    if (oend - op < 2) { return false; }
+    *op++ = static_cast<vuint8_t>(offset & 0xFF);
+    *op++ = static_cast<vuint8_t>((offset >> 8) & 0xFF);
+    if (ml >= 15 && !WriteLength(op, oend, ml - 15)) { return false; }
+    return true;
+}
+
+int LzCompressBound(const int length) {
+    return length + length / 255 + 16;
+}
+
+int LzCompress(const char* src, const int length, char* dst, const int capacity) {
+    if (length < 0 || capacity <= 0) { return 0; }
+    const vuint8_t* base = reinterpret_cast<const vuint8_t*>(src);
+    vuint8_t* ostart = reinterpret_cast<vuint8_t*>(dst);
+    vuint8_t* op = ostart;
+    const vuint8_t* oend = ostart + capacity;
+    int anchor = 0;
+    if (length > LZ_MIN_MATCH) {
+        vector<int> table(1 << LZ_HASH_LOG, -1);
+        int limit = length - LZ_MIN_MATCH;
+        int ip = 0;
+        while (ip <= limit) {
+            vuint32_t seq = Read32(base + ip);
+            vuint32_t h = LzHash(seq);
+            int ref = table[h];
+            table[h] = ip;
+            if (ref < 0 || ip - ref > LZ_MAX_OFFSET || Read32(base + ref) != seq) {
+                ip += 1 + ((ip - anchor) >> 6); // Skip faster in incompressible data
+                continue;
+            }
+            int match_len = LZ_MIN_MATCH;
+            while (ip + match_len < length && base[ref + match_len] == base[ip + match_len]) {
+                match_len++;
+            }
+            if (!EmitSequence(base + anchor, ip - anchor, ip - ref, match_len, op, oend)) { return 0; }
+            ip += match_len;
+            anchor = ip;
+            if (ip - 2 <= limit) { table[LzHash(Read32(base + ip - 2))] = ip - 2; }
+        }
+    }
+    if (!EmitSequence(base + anchor, length - anchor, 0, 0, op, oend)) { return 0; }
+    return CVT_INT(op - ostart);
+}
+
+int LzDecompress(const char* src, const int length, char* dst, const int capacity) {
+    const vuint8_t* ip = reinterpret_cast<const vuint8_t*>(src);
+    const vuint8_t* iend = ip + length;
+    vuint8_t* ostart = reinterpret_cast<vuint8_t*>(dst);
+    vuint8_t* op = ostart;
+    const vuint8_t* oend = ostart + capacity;
+    while (ip < iend) {
+        int token = *ip++;
+        int lit_len = token >> 4;
+        if (lit_len == 15 && !ReadLength(ip, iend, lit_len, capacity)) { return -1; }
+        if (iend - ip < lit_len || oend - op < lit_len) { return -1; }
+        memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+        if (ip == iend) { break; } // The last sequence
+        if (iend - ip < 2) { return -1; }
+        int offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > op - ostart) { return -1; }
+        int match_len = token & 15;
+        if (match_len == 15 && !ReadLength(ip, iend, match_len, capacity)) { return -1; }
+        match_len += LZ_MIN_MATCH;
+        if (oend - op < match_len) { return -1; }
+        const vuint8_t* ref = op - offset;
+        if (offset >= match_len) {
+            memcpy(op, ref, match_len);
+        } else { // Overlapped match, i.e., repeated pattern
+            for (int i = 0; i < match_len; i++) { op[i] = ref[i]; }
+        }
+        op += match_len;
+    }
+    return CVT_INT(op - ostart);
+}
+
+bool EncodeChunks(const char* src, const vint64_t length, const int elem_size, vector<char>& encoded,
+                  vuint32_t chunk_size /* = CODEC_CHUNK_SIZE */) {
+    encoded.clear();
+    if (length < 0 || (nullptr == src && length > 0) || elem_size < 1 || chunk_size < static_cast<vuint32_t>(elem_size)) {
+        return false;
+    }
+    chunk_size -= chunk_size % elem_size; // Keep elements in the same chunk
+    vint64_t n_chunks64 = (length + chunk_size - 1) / chunk_size;
+    if (n_chunks64 > INT_MAX || chunk_size > INT_MAX) { return false; }
+    int n_chunks = CVT_INT(n_chunks64);
+    vector<vector<char> > stored(n_chunks);
+    vector<vuint32_t> raw_sizes(n_chunks);
+    vector<vuint32_t> crcs(n_chunks);
+    vector<vuint32_t> methods(n_chunks);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < n_chunks; i++) {
+        vint64_t start = static_cast<vint64_t>(i) * chunk_size;
+        int raw_size = CVT_INT(length - start < chunk_size ? length - start : chunk_size);
+        const char* raw = src + start;
+        raw_sizes[i] = static_cast<vuint32_t>(raw_size);
+        crcs[i] = Crc32(raw, raw_size);
+        vector<char> shuffled(raw_size);
+        ShuffleBytes(raw, raw_size, elem_size, &shuffled[0]);
+        stored[i].resize(LzCompressBound(raw_size));
+        // Compressed chunk should be smaller than the raw one, otherwise stored as is
+        int compressed = LzCompress(&shuffled[0], raw_size, &stored[i][0], raw_size - 1);
+        if (compressed > 0) {
+            stored[i].resize(compressed);
+            methods[i] = CHUNK_SHUFFLE_LZ;
+        } else {
+            stored[i].assign(raw, raw + raw_size);
+            methods[i] = CHUNK_STORED;
+        }
+    }
+    size_t total = CODEC_HEADER_SIZE + CVT_SIZET(n_chunks) * CODEC_CHUNK_ITEM_SIZE;
+    for (int i = 0; i < n_chunks; i++) { total += stored[i].size(); }
+    encoded.assign(total, 0);
+    char* p = &encoded[0];
+    memcpy(p, CODEC_MAGIC, 4);
+    PutUint32(p + 4, static_cast<vuint32_t>(elem_size));
+    PutUint64(p + 8, CVT_VUINT64(length));
+    PutUint32(p + 16, chunk_size);
+    PutUint32(p + 20, static_cast<vuint32_t>(n_chunks));
+    char* item = p + CODEC_HEADER_SIZE;
+    char* payload = item + CVT_SIZET(n_chunks) * CODEC_CHUNK_ITEM_SIZE;
+    for (int i = 0; i < n_chunks; i++) {
+        PutUint32(item, static_cast<vuint32_t>(stored[i].size()));
+        PutUint32(item + 4, raw_sizes[i]);
+        PutUint32(item + 8, crcs[i]);
+        PutUint32(item + 12, methods[i]);
+        item += CODEC_CHUNK_ITEM_SIZE;
+        if (!stored[i].empty()) { memcpy(payload, &stored[i][0], stored[i].size()); }
+        payload += stored[i].size();
+    }
+    return true;
+}
+
+bool IsEncodedChunks(const char* buf, const vint64_t length) {
+    return DecodedLength(buf, length) >= 0;
+}
+
+vint64_t DecodedLength(const char* buf, const vint64_t length) {
+    if (nullptr == buf || length < CODEC_HEADER_SIZE || memcmp(buf, CODEC_MAGIC, 4) != 0) { return -1; }
+    vuint32_t n_chunks = GetUint32(buf + 20);
+    if (length < CODEC_HEADER_SIZE + static_cast<vint64_t>(n_chunks) * CODEC_CHUNK_ITEM_SIZE) { return -1; }
+    return static_cast<vint64_t>(GetUint64(buf + 8));
+}
+
+bool DecodeChunks(const char* buf, const vint64_t length, char* dst, const vint64_t capacity) {
+    vint64_t raw_length = DecodedLength(buf, length);
+    if (raw_length < 0 || capacity < raw_length || (nullptr == dst && raw_length > 0)) { return false; }
+    int elem_size = CVT_INT(GetUint32(buf + 4));
+    vint64_t chunk_size = GetUint32(buf + 16);
+    int n_chunks = CVT_INT(GetUint32(buf + 20));
+    if (elem_size < 1 || (n_chunks > 0 && chunk_size == 0)) { return false; }
+    // Offsets of chunks in both encoded stream and decoded data
+    const char* items = buf + CODEC_HEADER_SIZE;
+    vector<vint64_t> offsets(n_chunks + 1);
+    offsets[0] = CODEC_HEADER_SIZE + static_cast<vint64_t>(n_chunks) * CODEC_CHUNK_ITEM_SIZE;
+    vint64_t raw_total = 0;
+    for (int i = 0; i < n_chunks; i++) {
+        offsets[i + 1] = offsets[i] + GetUint32(items + i * CODEC_CHUNK_ITEM_SIZE);
+        vint64_t raw_size = GetUint32(items + i * CODEC_CHUNK_ITEM_SIZE + 4);
+        if (raw_size > chunk_size || (i < n_chunks - 1 && raw_size != chunk_size)) { return false; }
+        raw_total += raw_size;
+    }
+    if (offsets[n_chunks] > length || raw_total != raw_length) { return false; }
+    int errors = 0;
+#pragma omp parallel for schedule(dynamic, 1) reduction(+:errors)
+    for (int i = 0; i < n_chunks; i++) {
+        const char* item = items + i * CODEC_CHUNK_ITEM_SIZE;
+        int stored_size = CVT_INT(GetUint32(item));
+        int raw_size = CVT_INT(GetUint32(item + 4));
+        vuint32_t crc = GetUint32(item + 8);
+        vuint32_t method = GetUint32(item + 12);
+        const char* stored = buf + offsets[i];
+        char* raw = dst + static_cast<vint64_t>(i) * chunk_size;
+        if (method == CHUNK_STORED) {
+            if (stored_size != raw_size) {
+                errors++;
+                continue;
+            }
+            memcpy(raw, stored, raw_size);
+        } else if (method == CHUNK_SHUFFLE_LZ) {
+            vector<char> shuffled(raw_size + 1);
+            if (LzDecompress(stored, stored_size, &shuffled[0], raw_size) != raw_size) {
+                errors++;
+                continue;
+            }
+            UnshuffleBytes(&shuffled[0], raw_size, elem_size, raw);
+        } else {
+            errors++;
+            continue;
+        }
+        if (Crc32(raw, raw_size) != crc) { errors++; }
+    }
+    return errors == 0;
+}
+} /* namespace: utils_codec */
+} /* namespace: ccgl */
@@ -0,0 +1,124 @@
+/*!
+ * \file utils_codec.h
+ * \brief Chunked binary codec with byte-shuffle filter and LZ77 compression,
+ *        e.g., for raster and array data stored as GridFS files.
+ *
+ * \remarks
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liangjun Zhu, zlj(at)lreis.ac.cn
+ * \version 1.0
+ */
+#ifndef CCGL_UTILS_CODEC_H
+#define CCGL_UTILS_CODEC_H
+
+#include <vector>
+
+#include "basic.h"
+
+using std::vector;
+
+namespace ccgl {
+/*!
+ * \namespace ccgl::utils_codec
+ * \brief Chunked binary codec.
+ *
+ * The data are split into chunks with the same raw size (except the last one). Each chunk is
+ * byte-shuffled by element size (i.e., the k-th bytes of all elements are grouped together, which
+ * makes the exponent bytes of floating point values and the high bytes of integers highly
+ * repetitive), compressed by a byte-oriented LZ77 (LZ4-like) compressor, and checked by CRC-32.
+ * The chunk is stored as is if not compressible. Since the sizes of all chunks are recorded in
+ * the chunk table, the chunks can be encoded and decoded in parallel.
+ *
+ * The encoded stream is formatted as follows, all integers are little-endian:
+ *   - Header (32 bytes): magic `CCZ1`, element size (uint32), raw length (uint64),
+ *     chunk size (uint32), chunk number (uint32), and 8 reserved bytes.
+ *   - Chunk table (16 bytes per chunk): stored size, raw size, CRC-32 of raw bytes,
+ *     and method (0 for stored, 1 for shuffled and compressed), all are uint32.
+ *   - Stored bytes of chunks in order.
+ */
+namespace utils_codec {
+/*! Default raw size of each chunk, 1 MB */
+const vuint32_t CODEC_CHUNK_SIZE = 1U << 20;
+/*! Size of header of encoded stream */
+const int CODEC_HEADER_SIZE = 32;
+/*! Size of each item of chunk table */
+const int CODEC_CHUNK_ITEM_SIZE = 16;
+
+/*!
+ * \brief CRC-32 (IEEE 802.3) checksum
+ * \param[in] data Data
+ * \param[in] length Length of data
+ * \param[in] crc Previous checksum to be continued, 0 for new data
+ */
+vuint32_t Crc32(const char* data, vint64_t length, vuint32_t crc = 0);
+
+/*!
+ * \brief Group the k-th bytes of all elements together, the remaining bytes are copied
+ * \param[in] src Source data
+ * \param[in] length Length of source data in bytes
+ * \param[in] elem_size Element size in bytes, e.g., 4 for float
+ * \param[out] dst Shuffled data with the same length, must not overlap with src
+ */
+void ShuffleBytes(const char* src, vint64_t length, int elem_size, char* dst);
+
+/*!
+ * \brief Restore the bytes shuffled by ShuffleBytes()
+ */
+void UnshuffleBytes(const char* src, vint64_t length, int elem_size, char* dst);
+
+/*! Maximum size of the compressed data of the given length */
+int LzCompressBound(int length);
+
+/*!
+ * \brief Compress data by byte-oriented LZ77 compressor
+ * \param[in] src Source data
+ * \param[in] length Length of source data
+ * \param[out] dst Compressed data
+ * \param[in] capacity Capacity of dst
+ * \return Length of compressed data, 0 if exceeds the capacity
+ */
+int LzCompress(const char* src, int length, char* dst, int capacity);
+
+/*!
+ * \brief Decompress data compressed by LzCompress()
+ * \param[in] src Compressed data
+ * \param[in] length Length of compressed data
+ * \param[out] dst Decompressed data
+ * \param[in] capacity Capacity of dst
+ * \return Length of decompressed data, -1 if the compressed data are corrupted
+ */
+int LzDecompress(const char* src, int length, char* dst, int capacity);
+
+/*!
+ * \brief Encode data into chunks, which are encoded in parallel if OpenMP is supported
+ * \param[in] src Source data
+ * \param[in] length Length of source data
+ * \param[in] elem_size Element size in bytes for byte-shuffle filter, 1 means no shuffle
+ * \param[out] encoded Encoded stream
+ * \param[in] chunk_size Raw size of each chunk
+ * \return True if succeed
+ */
+bool EncodeChunks(const char* src, vint64_t length, int elem_size, vector<char>& encoded,
+                  vuint32_t chunk_size = CODEC_CHUNK_SIZE);
+
+/*! Is the buffer encoded by EncodeChunks() */
+bool IsEncodedChunks(const char* buf, vint64_t length);
+
+/*! Raw length of the encoded stream, -1 if the buffer is not encoded by EncodeChunks() */
+vint64_t DecodedLength(const char* buf, vint64_t length);
+
+/*!
+ * \brief Decode the stream encoded by EncodeChunks(), the chunks are decoded in parallel
+ *        if OpenMP is supported
+ * \param[in] buf Encoded stream
+ * \param[in] length Length of encoded stream
+ * \param[out] dst Decoded data, which is allocated by caller with the size of DecodedLength()
+ * \param[in] capacity Capacity of dst
+ * \return False if the stream is corrupted, e.g., checksum mismatched
+ */
+bool DecodeChunks(const char* buf, vint64_t length, char* dst, vint64_t capacity);
+} /* namespace: utils_codec */
+} /* namespace: ccgl */
+
+#endif /* CCGL_UTILS_CODEC_H */
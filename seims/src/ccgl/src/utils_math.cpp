@@ -1,5 +1,7 @@
 #include "utils_math.h"
 
+#include <cfloat>
+
 namespace ccgl {
 namespace utils_math {
 float Expo(float xx, float upper /* = 20.f */, float lower /* = -20.f */) {
@@ -363,6 +365,162 @@ float pow_lookup(const float exp, const float log_base) {
     return u.f;
 }
 
+
+QuantileSketch::QuantileSketch(const double relative_accuracy /* = 0.01 */) :
+    accuracy_(relative_accuracy), gamma_(0.), log_gamma_(0.), zeros_(0), count_(0) {
+    if (accuracy_ <= 0. || accuracy_ >= 1.) { accuracy_ = 0.01; }
+    gamma_ = (1. + accuracy_) / (1. - accuracy_);
+    log_gamma_ = log(gamma_);
+}
+
+int QuantileSketch::Key(const double abs_value) const {
+    return CVT_INT(ceil(log(abs_value) / log_gamma_));
+}
+
+double QuantileSketch::Value(const int key) const {
+    // Center of (gamma^(k-1), gamma^k] with the same relative error to both bounds
+    return 2. * exp(key * log_gamma_) / (gamma_ + 1.);
+}
+
+void QuantileSketch::Add(const double value) {
+    if (value != value) { return; } // NaN
+    count_++;
+    if (value > DBL_MIN * gamma_) {
+        positives_[Key(value)]++;
+    } else if (value < -DBL_MIN * gamma_) {
+        negatives_[Key(-value)]++;
+    } else {
+        zeros_++;
+    }
+}
+
+bool QuantileSketch::Merge(const QuantileSketch& other) {
+    if (!FloatEqual(accuracy_, other.accuracy_)) { return false; }
+    for (auto it = other.positives_.begin(); it != other.positives_.end(); ++it) {
+        positives_[it->first] += it->second;
+    }
+    for (auto it = other.negatives_.begin(); it != other.negatives_.end(); ++it) {
+        negatives_[it->first] += it->second;
+    }
+    zeros_ += other.zeros_;
+    count_ += other.count_;
+    return true;
+}
+
+double QuantileSketch::Quantile(double q) const {
+    if (count_ <= 0) { return NODATA_VALUE; }
+    if (q < 0.) { q = 0.; }
+    if (q > 1.) { q = 1.; }
+    double rank = q * CVT_DBL(count_ - 1);
+    vint64_t cumulative = 0;
+    // Negative values in ascending order, i.e., descending order of absolute values
+    for (auto it = negatives_.rbegin(); it != negatives_.rend(); ++it) {
+        cumulative += it->second;
+        if (CVT_DBL(cumulative) > rank) { return -Value(it->first); }
+    }
+    cumulative += zeros_;
+    if (CVT_DBL(cumulative) > rank) { return 0.; }
+    for (auto it = positives_.begin(); it != positives_.end(); ++it) {
+        cumulative += it->second;
+        if (CVT_DBL(cumulative) > rank) { return Value(it->first); }
+    }
+    return positives_.empty() ? 0. : Value(positives_.rbegin()->first);
+}
+
+int QuantileSketch::GetBucketNumber() const {
+    return CVT_INT(positives_.size() + negatives_.size()) + (zeros_ > 0 ? 1 : 0);
+}
+
+RunningStatistics::RunningStatistics(const double relative_accuracy /* = 0.01 */) :
+    count_(0), mean_(0.), m2_(0.), sum_(0.), compensation_(0.),
+    min_(MAXIMUMFLOAT), max_(MISSINGFLOAT), with_sketch_(relative_accuracy > 0.),
+    sketch_(relative_accuracy) {
+}
+
+void RunningStatistics::Add(const double value) {
+    if (value != value) { return; } // NaN
+    count_++;
+    // Welford's algorithm
+    double delta = value - mean_;
+    mean_ += delta / CVT_DBL(count_);
+    m2_ += delta * (value - mean_);
+    // Kahan summation
+    double y = value - compensation_;
+    double t = sum_ + y;
+    compensation_ = t - sum_ - y;
+    sum_ = t;
+    if (value < min_) { min_ = value; }
+    if (value > max_) { max_ = value; }
+    if (with_sketch_) { sketch_.Add(value); }
+}
+
+void RunningStatistics::Merge(const RunningStatistics& other) {
+    if (other.count_ <= 0) { return; }
+    if (count_ <= 0) {
+        bool with_sketch = with_sketch_;
+        *this = other;
+        with_sketch_ = with_sketch && other.with_sketch_;
+        return;
+    }
+    // Chan's parallel algorithm
+    double n_a = CVT_DBL(count_);
+    double n_b = CVT_DBL(other.count_);
+    double n = n_a + n_b;
+    double delta = other.mean_ - mean_;
+    mean_ += delta * n_b / n;
+    m2_ += other.m2_ + delta * delta * n_a * n_b / n;
+    count_ += other.count_;
+    // Kahan summation of the compensated sums
+    compensation_ += other.compensation_;
+    double y = other.sum_ - compensation_;
+    double t = sum_ + y;
+    compensation_ = t - sum_ - y;
+    sum_ = t;
+    if (other.min_ < min_) { min_ = other.min_; }
+    if (other.max_ > max_) { max_ = other.max_; }
+    with_sketch_ = with_sketch_ && other.with_sketch_;
+    if (with_sketch_) { sketch_.Merge(other.sketch_); }
+}
+
+double RunningStatistics::Sum() const {
+    return sum_ - compensation_;
+}
+
+double RunningStatistics::Mean() const {
+    return count_ > 0 ? mean_ : NODATA_VALUE;
+}
+
+double RunningStatistics::Variance() const {
+    return count_ > 0 ? m2_ / CVT_DBL(count_) : NODATA_VALUE;
+}
+
+double RunningStatistics::Std() const {
+    return count_ > 0 ? sqrt(m2_ / CVT_DBL(count_)) : NODATA_VALUE;
+}
+
+double RunningStatistics::Minimum() const {
+    return count_ > 0 ? min_ : NODATA_VALUE;
+}
+
+double RunningStatistics::Maximum() const {
+    return count_ > 0 ? max_ : NODATA_VALUE;
+}
+
+double RunningStatistics::Range() const {
+    return count_ > 0 ? max_ - min_ : NODATA_VALUE;
+}
+
+double RunningStatistics::Quantile(const double q) const {
+    if (count_ <= 0) { return NODATA_VALUE; }
+    if (q <= 0.) { return min_; }
+    if (q >= 1.) { return max_; }
+    if (!with_sketch_) { return NODATA_VALUE; }
+    double v = sketch_.Quantile(q);
+    if (v < min_) { return min_; }
+    if (v > max_) { return max_; }
+    return v;
+}
+
 } /* namespace: utils_math */
 
 } /* namespace: ccgl */
@@ -5,6 +5,8 @@
  * \remarks
  *   - 1. 2018-05-02 - lj - Make part of CCGL.
  *   - 2. 2021-07-15 - lj - Integrate pal.math for fast pow, exp, and ln
+ *   - 3. 2026-10-19 - lj - Add single-pass mergeable statistics with quantile sketch
+ *   - 4. 2026-10-19 - lj - Allow moments-only statistics without quantile sketch
  *
  * \author Liangjun Zhu, zlj(a)lreis.ac.cn
  * \version 1.1
@@ -13,6 +15,8 @@
 #define CCGL_UTILS_MATH_H
 
 #include <cmath>
+#include <map>
+#include <vector>
 
 #include "basic.h"
 #include "utils_array.h"
@@ -212,6 +216,116 @@ template <typename T>
 void BasicStatistics(const T*const * values, int num, int lyrs,
                      double*** derivedvalues, T exclude = static_cast<T>(NODATA_VALUE));
 
+/*!
+ * \class QuantileSketch
+ * \brief Streaming and mergeable quantile sketch with relative accuracy
+ *
+ * Values are counted in logarithmically spaced buckets, i.e., the bucket with key `k` holds
+ * absolute values in (gamma^(k-1), gamma^k], where gamma = (1 + a) / (1 - a) and `a` is the
+ * relative accuracy. Thus any quantile is estimated within the relative error of `a`, the
+ * memory is proportional to the orders of magnitude of the data rather than its length, and
+ * sketches of different parts of the data (e.g., of different threads) can be merged exactly.
+ */
+class QuantileSketch {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] relative_accuracy Relative accuracy of quantiles, (0, 1), the default is 1%
+     */
+    explicit QuantileSketch(double relative_accuracy = 0.01);
+
+    //! Add a value
+    void Add(double value);
+
+    //! Merge another sketch, which should be constructed with the same relative accuracy
+    bool Merge(const QuantileSketch& other);
+
+    /*!
+     * \brief Estimated quantile
+     * \param[in] q Quantile in [0, 1], e.g., 0.5 for median
+     * \return Quantile value, or NODATA_VALUE if the sketch is empty
+     */
+    double Quantile(double q) const;
+
+    vint64_t Count() const { return count_; } ///< Number of values added
+    double GetRelativeAccuracy() const { return accuracy_; } ///< Relative accuracy
+    int GetBucketNumber() const; ///< Number of non-empty buckets
+
+private:
+    int Key(double abs_value) const; ///< Bucket key of the absolute value
+    double Value(int key) const; ///< Representative value of the bucket
+
+private:
+    double accuracy_; ///< Relative accuracy
+    double gamma_; ///< Base of logarithmic buckets
+    double log_gamma_; ///< Logarithm of gamma_
+    std::map<int, vint64_t> positives_; ///< Bucket counts of positive values
+    std::map<int, vint64_t> negatives_; ///< Bucket counts of absolute values of negative values
+    vint64_t zeros_; ///< Count of (nearly) zero values
+    vint64_t count_; ///< Count of all values
+};
+
+/*!
+ * \class RunningStatistics
+ * \brief Single-pass and mergeable statistics of a data stream
+ *
+ * Mean and variance are updated by Welford's algorithm and merged by Chan's parallel algorithm,
+ * sum is compensated by Kahan summation, and quantiles are estimated by QuantileSketch.
+ * The sketch costs a bucket update per value, thus it can be disabled for moments only.
+ * All statistics are available after one sweep over the data, and the partial statistics of
+ * chunks of data (e.g., of OpenMP threads) are combined by Merge().
+ *
+ * \code
+ *      RunningStatistics stats;
+ *      for (int i = 0; i < n; i++) { stats.Add(values[i]); }
+ *      double median = stats.Quantile(0.5);
+ * \endcode
+ */
+class RunningStatistics {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] relative_accuracy Relative accuracy of quantiles, \sa QuantileSketch.
+     *                              Zero or negative disables the sketch, i.e., moments only.
+     */
+    explicit RunningStatistics(double relative_accuracy = 0.01);
+
+    //! Add a value
+    void Add(double value);
+
+    //! Merge statistics of another part of data
+    void Merge(const RunningStatistics& other);
+
+    vint64_t Count() const { return count_; } ///< Number of values
+    double Sum() const; ///< Compensated sum
+    double Mean() const; ///< Mean, NODATA_VALUE if empty
+    double Variance() const; ///< Population variance, NODATA_VALUE if empty
+    double Std() const; ///< Population standard deviation, NODATA_VALUE if empty
+    double Minimum() const; ///< Minimum, NODATA_VALUE if empty
+    double Maximum() const; ///< Maximum, NODATA_VALUE if empty
+    double Range() const; ///< Range, NODATA_VALUE if empty
+    /*!
+     * \brief Estimated quantile within the range of data, e.g., 0.5 for median
+     *        Without the sketch, only minimum (q <= 0) and maximum (q >= 1) are available,
+     *        otherwise NODATA_VALUE.
+     * \sa QuantileSketch::Quantile
+     */
+    double Quantile(double q) const;
+    bool HasSketch() const { return with_sketch_; } ///< Are quantiles estimated
+    const QuantileSketch& GetSketch() const { return sketch_; } ///< Quantile sketch
+
+private:
+    vint64_t count_; ///< Count of values
+    double mean_; ///< Running mean
+    double m2_; ///< Running sum of squared deviations from the mean
+    double sum_; ///< Running sum
+    double compensation_; ///< Running compensation of sum
+    double min_; ///< Minimum
+    double max_; ///< Maximum
+    bool with_sketch_; ///< Is the quantile sketch updated
+    QuantileSketch sketch_; ///< Quantile sketch
+};
+
 /*!
  * \brief approximate sqrt
  *
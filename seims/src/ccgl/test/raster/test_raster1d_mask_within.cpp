@@ -20,6 +20,7 @@
  *          2021-07-20 - lj - Update after changes of GetValue and GetValueByIndex.
  *          2021-11-18 - lj - Rewrite unittest cases, avoid redundancy.
  *          2023-04-14 - lj - Update tests according to API changes of clsRasterData
+ *          2026-10-19 - lj - Check positions shared with mask
  *
  */
 #include "gtest/gtest.h"
@@ -171,6 +172,11 @@ TEST_P(clsRasterDataTestMaskWithin, MatchExactNoPosNoMaskExt) {
     EXPECT_EQ(nullptr, rs_->Get2DRasterDataPointer());       // m_raster2DData
     EXPECT_NE(nullptr, rs_->GetRasterPositionDataPointer()); // m_rasterPositionData
     EXPECT_NE(nullptr, rs_->GetRasterPositionIndexPointer()); // m_rasterPositionIndex
+    // Positions are shared with mask rather than copied
+    EXPECT_NE(nullptr, rs_->GetRasterPositionSpans());
+    EXPECT_EQ(maskrs_->GetRasterPositionSpans(), rs_->GetRasterPositionSpans());
+    EXPECT_EQ(maskrs_->GetRasterPositionIndexPointer(), rs_->GetRasterPositionIndexPointer());
+    EXPECT_EQ(maskrs_->GetRasterPositionDataPointer(), rs_->GetRasterPositionDataPointer());
 
     /** Get metadata, m_headers **/
     STRDBL_MAP header_info = rs_->GetRasterHeader();
@@ -8,6 +8,7 @@
  *          2021-07-20 - lj - Update after changes of GetValue and GetValueByIndex.
  *          2021-11-27 - lj - Add more tests.
  *          2023-04-13 - lj - Update tests according to API changes of clsRasterData
+ *          2026-10-19 - lj - Add tests of constructing from stream data
  *
  */
 #include "gtest/gtest.h"
@@ -207,6 +208,56 @@ TEST(clsRasterDataFailedConstructor, FailedCases) {
     delete noexisted_rs;
 }
 
+TEST(clsRasterDataStreamConstructor, FullAndValidCells) {
+    /// 1. Mask raster stored with NODATA, i.e., full size of 3 x 3
+    vint32_t mask_data[9] = {-9999, 1, 1, 1, 1, 1, 1, 1, -9999};
+    STRING_MAP mask_meta;
+    mask_meta[HEADER_RS_NCOLS] = "3";
+    mask_meta[HEADER_RS_NROWS] = "3";
+    mask_meta[HEADER_RS_CELLSNUM] = "9";
+    mask_meta[HEADER_RS_LAYERS] = "1";
+    mask_meta[HEADER_RS_NODATA] = "-9999";
+    mask_meta[HEADER_RS_CELLSIZE] = "2";
+    mask_meta[HEADER_RS_XLL] = "1";
+    mask_meta[HEADER_RS_YLL] = "1";
+    mask_meta[HEADER_RS_DATATYPE] = "INT32";
+    mask_meta[HEADER_INC_NODATA] = "TRUE";
+    mask_meta[HEADER_RSOUT_DATATYPE] = "INT32";
+    IntRaster* mask = new IntRaster();
+    EXPECT_TRUE(mask->ReadFromStream(reinterpret_cast<const char*>(mask_data), sizeof mask_data,
+                                     mask_meta, "mask", true));
+    EXPECT_EQ(3, mask->GetRows());
+    EXPECT_EQ(3, mask->GetCols());
+    EXPECT_EQ(7, mask->GetCellNumber());
+    EXPECT_TRUE(mask->IsNoData(0, 0));
+    EXPECT_EQ(1, mask->GetValue(1, 1));
+
+    /// 2. Raster stored with valid cells of mask only, e.g., exported from GridFS
+    float data[7] = {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f};
+    STRING_MAP meta(mask_meta);
+    meta[HEADER_RS_CELLSNUM] = "7";
+    meta[HEADER_RS_DATATYPE] = "FLOAT";
+    meta[HEADER_INC_NODATA] = "FALSE";
+    meta[HEADER_RSOUT_DATATYPE] = "FLOAT";
+    FltIntRaster* rs = new FltIntRaster();
+    EXPECT_TRUE(rs->ReadFromStream(reinterpret_cast<const char*>(data), sizeof data,
+                                   meta, "float", false, mask));
+    EXPECT_EQ(7, rs->GetCellNumber());
+    EXPECT_FLOAT_EQ(1.f, rs->GetValue(0, 1));
+    EXPECT_FLOAT_EQ(4.f, rs->GetValue(1, 1));
+    EXPECT_FLOAT_EQ(7.f, rs->GetValue(2, 1));
+    EXPECT_TRUE(rs->IsNoData(2, 2));
+
+    /// 3. Inconsistent length of stream
+    FltIntRaster* rs_failed = new FltIntRaster();
+    EXPECT_FALSE(rs_failed->ReadFromStream(reinterpret_cast<const char*>(data), 4 * sizeof(float),
+                                           meta, "float", false, mask));
+
+    delete rs_failed;
+    delete rs;
+    delete mask;
+}
+
 #ifdef USE_GDAL
 TEST(clsRasterDataUnsignedByte, FullIO) {
     clsRasterData<vuint8_t>* mask_rs = clsRasterData<vuint8_t>::Init(rs_mask);
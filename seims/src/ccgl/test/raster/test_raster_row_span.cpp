@@ -0,0 +1,99 @@
+/*!
+ * \brief Test description:
+ *
+ *        TEST CASE NAME (or TEST SUITE):
+ *            TestRowSpanIndex: Run-length index of valid cells' positions by rows.
+ *
+ * \authors Liangjun Zhu, zlj(at)lreis.ac.cn; crazyzlj(at)gmail.com
+ * \remarks 2026-10-19 - lj - Original version.
+ *
+ */
+#include "gtest/gtest.h"
+#include "../../src/data_raster.hpp"
+
+using namespace ccgl;
+using namespace ccgl::data_raster;
+
+namespace {
+/*
+ * Valid cells (X) of a 4 * 5 raster:
+ *     X X . X X
+ *     . . . . .
+ *     . X X X .
+ *     X . . . X
+ */
+const int nrows = 4;
+const int ncols = 5;
+const int ncells = 9;
+const int pos_idx[ncells] = {0, 1, 3, 4, 11, 12, 13, 15, 19};
+
+TEST(TestRowSpanIndex, Build) {
+    RowSpanIndex spans;
+    EXPECT_TRUE(spans.Build(nrows, ncols, pos_idx, ncells));
+    EXPECT_EQ(nrows, spans.GetRows());
+    EXPECT_EQ(ncols, spans.GetCols());
+    EXPECT_EQ(ncells, spans.GetCellNumber());
+    EXPECT_EQ(5, spans.GetSpanNumber());
+    EXPECT_EQ(2, spans.RowSpanEnd(0) - spans.RowSpanBegin(0));
+    EXPECT_EQ(0, spans.RowSpanEnd(1) - spans.RowSpanBegin(1));
+    EXPECT_EQ(1, spans.RowSpanEnd(2) - spans.RowSpanBegin(2));
+    EXPECT_EQ(2, spans.RowSpanEnd(3) - spans.RowSpanBegin(3));
+    int s = spans.RowSpanBegin(2);
+    EXPECT_EQ(1, spans.SpanStartCol(s));
+    EXPECT_EQ(3, spans.SpanEndCol(s));
+    EXPECT_EQ(4, spans.SpanOffset(s));
+
+    // Invalid index, i.e., not in ascending order or exceeds the extent
+    const int unordered[3] = {0, 4, 2};
+    EXPECT_FALSE(spans.Build(nrows, ncols, unordered, 3));
+    EXPECT_EQ(0, spans.GetCellNumber());
+    const int exceeded[2] = {0, 20};
+    EXPECT_FALSE(spans.Build(nrows, ncols, exceeded, 2));
+    EXPECT_FALSE(spans.Build(nrows, ncols, nullptr, 0));
+}
+
+TEST(TestRowSpanIndex, GetPosition) {
+    RowSpanIndex spans;
+    ASSERT_TRUE(spans.Build(nrows, ncols, pos_idx, ncells));
+    int idx = 0;
+    for (int row = 0; row < nrows; row++) {
+        for (int col = 0; col < ncols; col++) {
+            if (idx < ncells && pos_idx[idx] == row * ncols + col) {
+                EXPECT_EQ(idx, spans.GetPosition(row, col));
+                int r = -1;
+                int c = -1;
+                EXPECT_TRUE(spans.GetRowCol(idx, r, c));
+                EXPECT_EQ(row, r);
+                EXPECT_EQ(col, c);
+                idx++;
+            } else {
+                EXPECT_EQ(-1, spans.GetPosition(row, col));
+            }
+        }
+    }
+    EXPECT_EQ(-1, spans.GetPosition(-1, 0));
+    EXPECT_EQ(-1, spans.GetPosition(0, ncols));
+    EXPECT_EQ(-1, spans.GetPosition(nrows, 0));
+    int r;
+    int c;
+    EXPECT_FALSE(spans.GetRowCol(ncells, r, c));
+    EXPECT_FALSE(spans.GetRowCol(-1, r, c));
+}
+
+TEST(TestRowSpanIndex, Iteration) {
+    RowSpanIndex spans;
+    ASSERT_TRUE(spans.Build(nrows, ncols, pos_idx, ncells));
+    int count = 0;
+    for (int row = 0; row < spans.GetRows(); row++) {
+        for (int s = spans.RowSpanBegin(row); s < spans.RowSpanEnd(row); s++) {
+            int idx = spans.SpanOffset(s);
+            for (int col = spans.SpanStartCol(s); col <= spans.SpanEndCol(s); col++, idx++) {
+                EXPECT_EQ(count, idx);
+                EXPECT_EQ(pos_idx[idx], row * ncols + col);
+                count++;
+            }
+        }
+    }
+    EXPECT_EQ(ncells, count);
+}
+} /* namespace */
@@ -0,0 +1,142 @@
+/*!
+ * \brief Test description:
+ *
+ *        TEST CASE NAME (or TEST SUITE):
+ *            TestRasterStatistics: Single-pass statistics of layers and zones of raster data.
+ *
+ * \authors Liangjun Zhu, zlj(at)lreis.ac.cn; crazyzlj(at)gmail.com
+ * \remarks 2026-10-19 - lj - Original version.
+ *
+ */
+#include "gtest/gtest.h"
+#include "../../src/data_raster.hpp"
+
+using namespace ccgl;
+using namespace ccgl::data_raster;
+
+namespace {
+/*
+ * Values of a 4 * 5 raster (N for NoData):
+ *     1 2 N 4 5
+ *     N N N N N
+ *     N 3 4 5 N
+ *     6 N N N 7
+ *
+ * Zones of the same extent (N for NoData):
+ *     1 1 1 2 2
+ *     1 1 2 2 2
+ *     3 3 3 N 2
+ *     3 3 3 3 3
+ */
+const int nrows = 4;
+const int ncols = 5;
+const double nodata = -9999.;
+const double values[nrows * ncols] = {1., 2., nodata, 4., 5.,
+                                      nodata, nodata, nodata, nodata, nodata,
+                                      nodata, 3., 4., 5., nodata,
+                                      6., nodata, nodata, nodata, 7.};
+const int zones[nrows * ncols] = {1, 1, 1, 2, 2,
+                                  1, 1, 2, 2, 2,
+                                  3, 3, 3, -9999, 2,
+                                  3, 3, 3, 3, 3};
+
+TEST(TestRasterStatistics, LayerStatistics) {
+    double* data = nullptr;
+    Initialize1DArray(nrows * ncols, data, values);
+    DblRaster* rs = new DblRaster(data, ncols, nrows, nodata, 1., 0., 0.);
+    vector<RunningStatistics> stats;
+    rs->GetLayerStatistics(stats);
+    ASSERT_EQ(1, CVT_INT(stats.size()));
+    EXPECT_EQ(9, stats[0].Count());
+    EXPECT_DOUBLE_EQ(37., stats[0].Sum());
+    EXPECT_DOUBLE_EQ(37. / 9., stats[0].Mean());
+    EXPECT_DOUBLE_EQ(1., stats[0].Minimum());
+    EXPECT_DOUBLE_EQ(7., stats[0].Maximum());
+    EXPECT_NEAR(4., stats[0].Quantile(0.5), 0.04);
+    // Basic statistics are calculated by the same engine
+    EXPECT_EQ(9, rs->GetValidNumber());
+    EXPECT_DOUBLE_EQ(stats[0].Mean(), rs->GetAverage());
+    EXPECT_DOUBLE_EQ(stats[0].Std(), rs->GetStd());
+    EXPECT_DOUBLE_EQ(6., rs->GetRange());
+    delete rs;
+}
+
+TEST(TestRasterStatistics, LayerStatistics2D) {
+    int ncells = nrows * ncols;
+    double** data2d = nullptr;
+    Initialize2DArray(ncells, 2, data2d, nodata);
+    for (int i = 0; i < ncells; i++) {
+        data2d[i][0] = values[i];
+        data2d[i][1] = FloatEqual(values[i], nodata) ? nodata : values[i] * 10.;
+    }
+    data2d[0][1] = nodata;
+    DblRaster* rs = new DblRaster(data2d, ncols, nrows, 2, nodata, 1., 0., 0.);
+    vector<RunningStatistics> stats;
+    rs->GetLayerStatistics(stats);
+    ASSERT_EQ(2, CVT_INT(stats.size()));
+    EXPECT_EQ(9, stats[0].Count());
+    EXPECT_EQ(8, stats[1].Count());
+    EXPECT_DOUBLE_EQ(360., stats[1].Sum());
+    EXPECT_DOUBLE_EQ(20., stats[1].Minimum());
+    EXPECT_DOUBLE_EQ(8., rs->GetValidNumber(2));
+    EXPECT_DOUBLE_EQ(45., rs->GetAverage(2));
+    delete rs;
+}
+
+TEST(TestRasterStatistics, ZonalStatisticsSameExtent) {
+    double* data = nullptr;
+    Initialize1DArray(nrows * ncols, data, values);
+    int* zone_data = nullptr;
+    Initialize1DArray(nrows * ncols, zone_data, zones);
+    DblRaster* rs = new DblRaster(data, ncols, nrows, nodata, 1., 0., 0.);
+    IntRaster* zone_rs = new IntRaster(zone_data, ncols, nrows, -9999, 1., 0., 0.);
+    map<int, vector<RunningStatistics> > stats;
+    EXPECT_TRUE(rs->GetZonalStatistics(zone_rs, stats));
+    ASSERT_EQ(3, CVT_INT(stats.size()));
+    EXPECT_EQ(2, stats.at(1)[0].Count());
+    EXPECT_DOUBLE_EQ(1.5, stats.at(1)[0].Mean());
+    EXPECT_EQ(2, stats.at(2)[0].Count());
+    EXPECT_DOUBLE_EQ(9., stats.at(2)[0].Sum());
+    // The cell with value 5 at (2, 3) is located in NoData of zones
+    EXPECT_EQ(4, stats.at(3)[0].Count());
+    EXPECT_DOUBLE_EQ(20., stats.at(3)[0].Sum());
+    EXPECT_DOUBLE_EQ(3., stats.at(3)[0].Minimum());
+    EXPECT_DOUBLE_EQ(7., stats.at(3)[0].Maximum());
+
+    EXPECT_FALSE(rs->GetZonalStatistics<int>(nullptr, stats));
+    EXPECT_TRUE(stats.empty());
+    delete rs;
+    delete zone_rs;
+}
+
+TEST(TestRasterStatistics, ZonalStatisticsCoarseZones) {
+    double* data = nullptr;
+    Initialize1DArray(nrows * ncols, data, values);
+    DblRaster* rs = new DblRaster(data, ncols, nrows, nodata, 1., 0., 0.);
+    /*
+     * Zones with cell size of 2 covering the value raster, i.e., 2 * 3 cells whose lower left
+     * center is (0.5, 0.5), and the last column exceeds the extent of the value raster:
+     *     1 2 3
+     *     4 5 6
+     */
+    int* zone_data = nullptr;
+    Initialize1DArray(6, zone_data, 0);
+    for (int i = 0; i < 6; i++) { zone_data[i] = i + 1; }
+    IntRaster* zone_rs = new IntRaster(zone_data, 3, 2, -9999, 2., 0.5, 0.5);
+    map<int, vector<RunningStatistics> > stats;
+    EXPECT_TRUE(rs->GetZonalStatistics(zone_rs, stats));
+    ASSERT_EQ(6, CVT_INT(stats.size()));
+    EXPECT_EQ(2, stats.at(1)[0].Count()); // 1, 2
+    EXPECT_DOUBLE_EQ(3., stats.at(1)[0].Sum());
+    EXPECT_EQ(1, stats.at(2)[0].Count()); // 4
+    EXPECT_EQ(1, stats.at(3)[0].Count()); // 5
+    EXPECT_EQ(2, stats.at(4)[0].Count()); // 3, 6
+    EXPECT_DOUBLE_EQ(9., stats.at(4)[0].Sum());
+    EXPECT_EQ(2, stats.at(5)[0].Count()); // 4, 5
+    EXPECT_DOUBLE_EQ(4.5, stats.at(5)[0].Mean());
+    EXPECT_EQ(1, stats.at(6)[0].Count()); // 7
+    EXPECT_DOUBLE_EQ(7., stats.at(6)[0].Maximum());
+    delete rs;
+    delete zone_rs;
+}
+} /* namespace */
@@ -0,0 +1,121 @@
+#include "../../src/utils_codec.h"
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace ccgl;
+using namespace ccgl::utils_codec;
+
+TEST(TestutilsCodec, Crc32) {
+    const char* data = "123456789";
+    EXPECT_EQ(0xCBF43926U, Crc32(data, 9));
+    // Continued checksum
+    vuint32_t part = Crc32(data, 4);
+    EXPECT_EQ(0xCBF43926U, Crc32(data + 4, 5, part));
+}
+
+TEST(TestutilsCodec, ShuffleBytes) {
+    const char src[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    char shuffled[10];
+    char restored[10];
+    ShuffleBytes(src, 10, 4, shuffled);
+    const char expected[10] = {0, 4, 1, 5, 2, 6, 3, 7, 8, 9};
+    EXPECT_EQ(0, memcmp(expected, shuffled, 10));
+    UnshuffleBytes(shuffled, 10, 4, restored);
+    EXPECT_EQ(0, memcmp(src, restored, 10));
+}
+
+TEST(TestutilsCodec, LzRoundTrip) {
+    const char* text = "abcabcabcabcabcabcabcabcabcabcabcabcabcabcxyzxyzxyzxyzxyz0123456789";
+    int length = CVT_INT(strlen(text));
+    vector<char> compressed(LzCompressBound(length));
+    int clen = LzCompress(text, length, &compressed[0], CVT_INT(compressed.size()));
+    EXPECT_GT(clen, 0);
+    EXPECT_LT(clen, length);
+    vector<char> decompressed(length);
+    EXPECT_EQ(length, LzDecompress(&compressed[0], clen, &decompressed[0], length));
+    EXPECT_EQ(0, memcmp(text, &decompressed[0], length));
+    // Insufficient capacity
+    EXPECT_EQ(-1, LzDecompress(&compressed[0], clen, &decompressed[0], length - 1));
+    EXPECT_EQ(0, LzCompress(text, length, &compressed[0], 4));
+}
+
+TEST(TestutilsCodec, EncodeFloatRaster) {
+    int n = 300000;
+    vector<float> values(n);
+    for (int i = 0; i < n; i++) {
+        values[i] = i % 7 == 0 ? -9999.f : 100.f + CVT_FLT(i % 50) * 0.5f;
+    }
+    const char* src = reinterpret_cast<const char*>(&values[0]);
+    vint64_t length = CVT_VINT(n) * 4;
+    vector<char> encoded;
+    // Small chunk size to test multiple chunks
+    EXPECT_TRUE(EncodeChunks(src, length, 4, encoded, 65536));
+    EXPECT_LT(CVT_VINT(encoded.size()), length / 4);
+    EXPECT_TRUE(IsEncodedChunks(&encoded[0], CVT_VINT(encoded.size())));
+    EXPECT_EQ(length, DecodedLength(&encoded[0], CVT_VINT(encoded.size())));
+    vector<float> decoded(n);
+    EXPECT_TRUE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()),
+                             reinterpret_cast<char*>(&decoded[0]), length));
+    EXPECT_EQ(0, memcmp(&values[0], &decoded[0], length));
+    // Insufficient capacity
+    EXPECT_FALSE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()),
+                              reinterpret_cast<char*>(&decoded[0]), length - 1));
+}
+
+TEST(TestutilsCodec, EncodeIncompressible) {
+    int length = 100003;
+    vector<char> src(length);
+    srand(20261019);
+    for (int i = 0; i < length; i++) { src[i] = CVT_CHAR(rand() & 0xFF); }
+    vector<char> encoded;
+    EXPECT_TRUE(EncodeChunks(&src[0], length, 8, encoded, 40000));
+    // Stored as is, plus header and chunk table
+    EXPECT_EQ(length + CODEC_HEADER_SIZE + 3 * CODEC_CHUNK_ITEM_SIZE, CVT_INT(encoded.size()));
+    vector<char> decoded(length);
+    EXPECT_TRUE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()), &decoded[0], length));
+    EXPECT_EQ(0, memcmp(&src[0], &decoded[0], length));
+}
+
+TEST(TestutilsCodec, EncodeSmallData) {
+    vector<char> encoded;
+    EXPECT_TRUE(EncodeChunks(nullptr, 0, 4, encoded));
+    EXPECT_EQ(CODEC_HEADER_SIZE, CVT_INT(encoded.size()));
+    EXPECT_EQ(0, DecodedLength(&encoded[0], CVT_VINT(encoded.size())));
+    EXPECT_TRUE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()), nullptr, 0));
+
+    const char src[3] = {'a', 'b', 'c'};
+    char decoded[3];
+    EXPECT_TRUE(EncodeChunks(src, 3, 1, encoded));
+    EXPECT_TRUE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()), decoded, 3));
+    EXPECT_EQ(0, memcmp(src, decoded, 3));
+
+    EXPECT_FALSE(EncodeChunks(src, 3, 0, encoded));
+}
+
+TEST(TestutilsCodec, DecodeCorrupted) {
+    int n = 10000;
+    vector<int> values(n);
+    for (int i = 0; i < n; i++) { values[i] = i / 10; }
+    const char* src = reinterpret_cast<const char*>(&values[0]);
+    vector<char> encoded;
+    EXPECT_TRUE(EncodeChunks(src, n * 4, 4, encoded, 8192));
+    vector<int> decoded(n);
+    char* dst = reinterpret_cast<char*>(&decoded[0]);
+    // Not encoded, e.g., raw data written by previous versions
+    EXPECT_FALSE(IsEncodedChunks(src, n * 4));
+    EXPECT_FALSE(DecodeChunks(src, n * 4, dst, n * 4));
+    // Mismatched checksum of the second chunk
+    vector<char> corrupted(encoded);
+    corrupted[CODEC_HEADER_SIZE + CODEC_CHUNK_ITEM_SIZE + 8] ^= 1;
+    EXPECT_FALSE(DecodeChunks(&corrupted[0], CVT_VINT(corrupted.size()), dst, n * 4));
+    // Modified payload
+    corrupted = encoded;
+    corrupted[corrupted.size() - 2] ^= 0x5A;
+    EXPECT_FALSE(DecodeChunks(&corrupted[0], CVT_VINT(corrupted.size()), dst, n * 4));
+    // Truncated stream
+    EXPECT_FALSE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()) - 1, dst, n * 4));
+    EXPECT_TRUE(DecodeChunks(&encoded[0], CVT_VINT(encoded.size()), dst, n * 4));
+    EXPECT_EQ(0, memcmp(&values[0], dst, n * 4));
+}
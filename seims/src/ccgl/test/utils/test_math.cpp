@@ -119,3 +119,116 @@ TEST(TestutilsMath, ApprPow) {
     EXPECT_LE(err_ave, 0.02f);
     // EXPECT_LE(err_max, 0.02f);
 }
+
+TEST(TestutilsMath, RunningStatistics) {
+    int n = 1000;
+    double* values = new double[n];
+    for (int i = 0; i < n; i++) {
+        values[i] = i % 10 == 0 ? NODATA_VALUE : 1.e6 + CVT_DBL(i % 97) * 0.01;
+    }
+    RunningStatistics stats;
+    for (int i = 0; i < n; i++) {
+        if (FloatEqual(values[i], NODATA_VALUE)) { continue; }
+        stats.Add(values[i]);
+    }
+    double* derived = nullptr;
+    BasicStatistics(values, n, &derived, CVT_DBL(NODATA_VALUE));
+    EXPECT_EQ(CVT_INT(derived[0]), stats.Count());
+    EXPECT_TRUE(equals(derived[1], stats.Mean()));
+    EXPECT_DOUBLE_EQ(derived[2], stats.Maximum());
+    EXPECT_DOUBLE_EQ(derived[3], stats.Minimum());
+    EXPECT_NEAR(derived[4], stats.Std(), 1.e-6);
+    EXPECT_DOUBLE_EQ(derived[5], stats.Range());
+    EXPECT_NEAR(stats.Mean() * CVT_DBL(stats.Count()), stats.Sum(), 1.e-3);
+    delete[] derived;
+    delete[] values;
+}
+
+TEST(TestutilsMath, RunningStatisticsMerge) {
+    RunningStatistics all;
+    RunningStatistics part1;
+    RunningStatistics part2;
+    RunningStatistics empty;
+    for (int i = 1; i <= 100; i++) {
+        all.Add(CVT_DBL(i));
+        if (i <= 30) { part1.Add(CVT_DBL(i)); }
+        else { part2.Add(CVT_DBL(i)); }
+    }
+    part1.Merge(empty);
+    part1.Merge(part2);
+    EXPECT_EQ(100, part1.Count());
+    EXPECT_DOUBLE_EQ(50.5, part1.Mean());
+    EXPECT_DOUBLE_EQ(all.Variance(), part1.Variance());
+    EXPECT_DOUBLE_EQ(5050., part1.Sum());
+    EXPECT_DOUBLE_EQ(1., part1.Minimum());
+    EXPECT_DOUBLE_EQ(100., part1.Maximum());
+    EXPECT_DOUBLE_EQ(all.Quantile(0.5), part1.Quantile(0.5));
+    empty.Merge(part1);
+    EXPECT_EQ(100, empty.Count());
+    EXPECT_DOUBLE_EQ(50.5, empty.Mean());
+    // Empty statistics
+    RunningStatistics none;
+    EXPECT_EQ(0, none.Count());
+    EXPECT_DOUBLE_EQ(NODATA_VALUE, none.Mean());
+    EXPECT_DOUBLE_EQ(NODATA_VALUE, none.Quantile(0.5));
+}
+
+TEST(TestutilsMath, RunningStatisticsMomentsOnly) {
+    RunningStatistics moments(0.);
+    RunningStatistics full;
+    RunningStatistics part;
+    EXPECT_FALSE(moments.HasSketch());
+    EXPECT_TRUE(full.HasSketch());
+    for (int i = 1; i <= 100; i++) {
+        moments.Add(CVT_DBL(i));
+        full.Add(CVT_DBL(i));
+        if (i > 50) { part.Add(CVT_DBL(i)); }
+    }
+    EXPECT_EQ(0, moments.GetSketch().Count());
+    EXPECT_EQ(full.Count(), moments.Count());
+    EXPECT_DOUBLE_EQ(full.Mean(), moments.Mean());
+    EXPECT_DOUBLE_EQ(full.Variance(), moments.Variance());
+    EXPECT_DOUBLE_EQ(full.Sum(), moments.Sum());
+    EXPECT_DOUBLE_EQ(1., moments.Quantile(0.));
+    EXPECT_DOUBLE_EQ(100., moments.Quantile(1.));
+    EXPECT_DOUBLE_EQ(NODATA_VALUE, moments.Quantile(0.5));
+    // Quantiles are not available once merged with moments only
+    part.Merge(moments);
+    EXPECT_FALSE(part.HasSketch());
+    EXPECT_EQ(150, part.Count());
+    EXPECT_DOUBLE_EQ(NODATA_VALUE, part.Quantile(0.5));
+    RunningStatistics empty;
+    empty.Merge(moments);
+    EXPECT_FALSE(empty.HasSketch());
+    EXPECT_DOUBLE_EQ(full.Mean(), empty.Mean());
+}
+
+TEST(TestutilsMath, QuantileSketch) {
+    double accuracy = 0.01;
+    QuantileSketch sketch(accuracy);
+    RunningStatistics stats(accuracy);
+    int n = 20001;
+    for (int i = 0; i < n; i++) {
+        double v = CVT_DBL(i - 5000) * 0.1; // -500.0 ~ 1500.0
+        sketch.Add(v);
+        stats.Add(v);
+    }
+    EXPECT_EQ(n, sketch.Count());
+    double qs[5] = {0.01, 0.1, 0.5, 0.9, 0.99};
+    for (int i = 0; i < 5; i++) {
+        double expected = CVT_DBL(CVT_INT(qs[i] * (n - 1)) - 5000) * 0.1;
+        EXPECT_LE(Abs(sketch.Quantile(qs[i]) - expected), Abs(expected) * accuracy + 1.e-9);
+    }
+    EXPECT_DOUBLE_EQ(-500., stats.Quantile(0.));
+    EXPECT_DOUBLE_EQ(1500., stats.Quantile(1.));
+    // Zeros and memory bounded by orders of magnitude
+    EXPECT_LT(sketch.GetBucketNumber(), 2000);
+    QuantileSketch zeros;
+    zeros.Add(0.);
+    zeros.Add(0.);
+    zeros.Add(1.);
+    EXPECT_DOUBLE_EQ(0., zeros.Quantile(0.5));
+    // Different accuracy cannot be merged
+    QuantileSketch other(0.05);
+    EXPECT_FALSE(sketch.Merge(other));
+}
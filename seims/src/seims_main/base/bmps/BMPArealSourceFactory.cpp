@@ -15,7 +15,7 @@ BMPArealSrcFactory::BMPArealSrcFactory(int scenarioId, int bmpId, int subScenari
                                        int bmpType, int bmpPriority, vector<string>& distribution,
                                        const string& collection, const string& location) :
     BMPFactory(scenarioId, bmpId, subScenario, bmpType, bmpPriority, distribution, collection, location),
-    m_mgtFieldsRs(nullptr) {
+    m_mgtFieldsRs(nullptr), m_nCells(0) {
     m_arealSrcMgtTab = m_bmpCollection;
     SplitStringForValues(location, '-', m_arealSrcIDs);
     if (m_distribution.size() == 4 && StringMatch(m_distribution[0], FLD_SCENARIO_DIST_RASTER)) {
@@ -161,13 +161,20 @@ void BMPArealSrcFactory::Dump(std::ostream* fs) {
 
 void BMPArealSrcFactory::setRasterData(map<string, IntRaster *>& sceneRsMap) {
     if (sceneRsMap.find(m_arealSrcDistName) != sceneRsMap.end()) {
-        int n;
-        sceneRsMap.at(m_arealSrcDistName)->GetRasterData(&n, &m_mgtFieldsRs);
+        sceneRsMap.at(m_arealSrcDistName)->GetRasterData(&m_nCells, &m_mgtFieldsRs);
     } else {
         // raise Exception?
     }
 }
 
+bool BMPArealSrcFactory::IsLocatedInSubbasin(const int subbasin_id) {
+    if (nullptr == m_mgtFieldsRs || m_nCells <= 0) { return true; }
+    for (int i = 0; i < m_nCells; i++) {
+        if (ValueInVector(m_mgtFieldsRs[i], m_arealSrcIDs)) { return true; }
+    }
+    return false;
+}
+
 /************************************************************************/
 /*                  ArealSourceMgtParams                                */
 /************************************************************************/
@@ -4,6 +4,7 @@
  *
  * Changelog:
  *   - 1. 2016-04-12 - lj - Code reformat.
+ *   - 2. 2026-10-19 - lj - Check if the BMP is located in the subbasin by areal source distribution.
  *
  * \author Liang-Jun Zhu
  * \date Aug 2016
@@ -201,6 +202,9 @@ public:
     /// Get management fields data
     int* GetRasterData() OVERRIDE { return m_mgtFieldsRs; }
 
+    /// Is any areal source of current subScenario in the distribution data of the subbasin
+    bool IsLocatedInSubbasin(int subbasin_id) OVERRIDE;
+
     string GetArealSrcDistName() { return m_arealSrcDistName; }
 
     vector<int>& GetArealSrcMgtSeqs() { return m_arealSrcMgtSeqs; }
@@ -231,6 +235,8 @@ private:
     string m_arealSrcDistName;
     /// distribution data of areal source locations
     int* m_mgtFieldsRs;
+    /// cells number of distribution data
+    int m_nCells;
     /// areal source distribution table
     string m_arealSrcDistTab;
     /// Field IDs of areal source of current subScenario
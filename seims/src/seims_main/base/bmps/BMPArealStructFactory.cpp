@@ -1,5 +1,7 @@
 #include "BMPArealStructFactory.h"
 
+#include <set>
+
 #include "utils_string.h"
 
 #include "BMPText.h"
@@ -7,6 +9,7 @@
 
 using namespace utils_string;
 using namespace bmps;
+using std::set;
 
 BMPArealStruct::BMPArealStruct(const bson_t*& bsonTable, bson_iter_t& iter): m_id(-1), m_lastUpdateTime(-1){
     if (bson_iter_init_find(&iter, bsonTable, BMP_FLD_SUB)) {
@@ -88,7 +91,7 @@ BMPArealStructFactory::BMPArealStructFactory(const int scenarioId, const int bmp
                                              time_t changeFrequency, int variableTimes) :
     BMPFactory(scenarioId, bmpId, subScenario, bmpType, bmpPriority, distribution, collection, location,
                effectivenessChangeable, changeFrequency, variableTimes),
-    m_mgtFieldsRs(nullptr),m_unitIDsSeries(m_changeTimes),m_unitUpdateTimes(m_changeTimes),m_seriesIndex(0) {
+    m_mgtFieldsRs(nullptr), m_nCells(0), m_unitIDsSeries(m_changeTimes),m_unitUpdateTimes(m_changeTimes),m_seriesIndex(0) {
     if (m_distribution.size() >= 2 && StringMatch(m_distribution[0], FLD_SCENARIO_DIST_RASTER)) {
         m_mgtFieldsName = m_distribution[1];
     } else {
@@ -159,13 +162,24 @@ void BMPArealStructFactory::loadBMP(MongoClient* conn, const string& bmpDBName)
 
 void BMPArealStructFactory::setRasterData(map<string, IntRaster*>& sceneRsMap) {
     if (sceneRsMap.find(m_mgtFieldsName) != sceneRsMap.end()) {
-        int n;
-        sceneRsMap.at(m_mgtFieldsName)->GetRasterData(&n, &m_mgtFieldsRs);
+        sceneRsMap.at(m_mgtFieldsName)->GetRasterData(&m_nCells, &m_mgtFieldsRs);
     } else {
         // raise Exception?
     }
 }
 
+bool BMPArealStructFactory::IsLocatedInSubbasin(const int subbasin_id) {
+    if (nullptr == m_mgtFieldsRs || m_nCells <= 0) { return true; }
+    set<int> units(m_unitIDs.begin(), m_unitIDs.end());
+    for (auto it = m_unitIDsSeries.begin(); it != m_unitIDsSeries.end(); ++it) {
+        units.insert(it->begin(), it->end());
+    }
+    for (int i = 0; i < m_nCells; i++) {
+        if (units.find(m_mgtFieldsRs[i]) != units.end()) { return true; }
+    }
+    return false;
+}
+
 void BMPArealStructFactory::Dump(std::ostream* fs) {
     if (nullptr == fs) return;
     *fs << "Areal Structural BMP Management Factory: " << endl <<
@@ -7,6 +7,7 @@
  *                          DataCenter will perform the data updating.
  *   - 2. 2017-11-29 - lj - Code style review.
  *   - 3. 2018-04-12 - lj - Code reformat.
+ *   - 4. 2026-10-19 - lj - Check if the BMP is located in the subbasin by management units.
  *
  * \author Huiran Gao, Liangjun Zhu
  */
@@ -92,6 +93,9 @@ public:
     //! Get management fields data
     int* GetRasterData() OVERRIDE { return m_mgtFieldsRs; }
 
+    //! Is any management unit of the BMP, including the time-varying ones, in the raster of the subbasin
+    bool IsLocatedInSubbasin(int subbasin_id) OVERRIDE;
+
     //! Get effect unit IDs
     const vector<int>& getUnitIDs() const { return m_unitIDs; }
     const vector<int>& getUnitIDsByIndex(){ return m_unitIDsSeries[m_seriesIndex]; }
@@ -110,6 +114,8 @@ private:
     string m_mgtFieldsName;
     //! management units raster data
     int* m_mgtFieldsRs;
+    //! cells number of management units raster data
+    int m_nCells;
     //! locations
     vector<int> m_unitIDs;
     //! Store the spatial unit IDs that need to update every year
@@ -24,6 +24,10 @@ int* BMPFactory::GetRasterData() {
     return nullptr;
 }
 
+bool BMPFactory::IsLocatedInSubbasin(const int subbasin_id) {
+    return true;
+}
+
 int BMPFactory::bmpType() {
     return m_bmpType;
 }
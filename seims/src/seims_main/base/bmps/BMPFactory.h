@@ -4,6 +4,7 @@
  *
  * Changelog:
  *   - 1. 2018-04-12 - lj - Code reformat.
+ *   - 2. 2026-10-19 - lj - Add IsLocatedInSubbasin() for incremental scenario simulation.
  *
  * \author Liangjun Zhu
  */
@@ -57,6 +58,14 @@ public:
     */
     virtual int* GetRasterData();
 
+    /*!
+     * \brief Is the BMP placed on any spatial unit of the subbasin, i.e., changes its simulation.
+     *        The raster data should have been set by setRasterData() if needed, which are of the
+     *        subbasin for the MPI version. By default, return true, which is always safe.
+     * \param[in] subbasin_id Subbasin ID, 0 for the whole watershed
+     */
+    virtual bool IsLocatedInSubbasin(int subbasin_id);
+
     /*!  Get BMP type
        1 - reach BMPs which are attached to specific reaches and will change the character of the reach.
        2 - areal structural BMPs which are corresponding to a specific structure in the watershed and will change the character of subbasins/cells.
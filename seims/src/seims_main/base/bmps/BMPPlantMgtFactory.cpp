@@ -12,7 +12,7 @@ BMPPlantMgtFactory::BMPPlantMgtFactory(const int scenarioId, const int bmpId, co
                                        vector<string>& distribution,
                                        const string& collection, const string& location) :
     BMPFactory(scenarioId, bmpId, subScenario, bmpType, bmpPriority, distribution, collection, location),
-    m_mgtFieldsRs(nullptr), m_luccID(-1), m_parameters(nullptr) {
+    m_mgtFieldsRs(nullptr), m_nCells(0), m_luccID(-1), m_parameters(nullptr) {
     if (m_distribution.size() >= 2 && StringMatch(m_distribution[0], FLD_SCENARIO_DIST_RASTER)) {
         m_mgtFieldsName = m_distribution[1];
     } else {
@@ -280,8 +280,7 @@ void BMPPlantMgtFactory::Dump(std::ostream* fs) {
 
 void BMPPlantMgtFactory::setRasterData(map<string, IntRaster*>& sceneRsMap) {
     if (sceneRsMap.find(m_mgtFieldsName) != sceneRsMap.end()) {
-        int n;
-        sceneRsMap.at(m_mgtFieldsName)->GetRasterData(&n, &m_mgtFieldsRs);
+        sceneRsMap.at(m_mgtFieldsName)->GetRasterData(&m_nCells, &m_mgtFieldsRs);
     } else {
         // raise Exception?
     }
@@ -291,6 +290,15 @@ int* BMPPlantMgtFactory::GetRasterData() {
     return m_mgtFieldsRs;
 }
 
+bool BMPPlantMgtFactory::IsLocatedInSubbasin(const int subbasin_id) {
+    // Empty locations means ALL fields
+    if (m_location.empty() || nullptr == m_mgtFieldsRs || m_nCells <= 0) { return true; }
+    for (int i = 0; i < m_nCells; i++) {
+        if (m_location.find(m_mgtFieldsRs[i]) != m_location.end()) { return true; }
+    }
+    return false;
+}
+
 int BMPPlantMgtFactory::GetLUCCID() {
     return m_luccID;
 }
@@ -3,6 +3,9 @@
  * \brief Plant management operations factory
  * \author Liang-Jun Zhu
  * \date June 2016
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Check if the BMP is located in the subbasin by management fields.
  */
 #ifndef SEIMS_BMP_PLANTMGT_H
 #define SEIMS_BMP_PLANTMGT_H
@@ -45,6 +48,9 @@ public:
     /// Get management fields data
     int* GetRasterData() OVERRIDE;
 
+    /// Is any field of locations in the management fields of the subbasin
+    bool IsLocatedInSubbasin(int subbasin_id) OVERRIDE;
+
     /// Get landuse / landcover ID
     int GetLUCCID();
 
@@ -67,6 +73,8 @@ private:
     string m_mgtFieldsName;
     /// management fields data (1D array raster)
     int* m_mgtFieldsRs;
+    /// cells number of management fields data
+    int m_nCells;
     /// landuse / landcover
     int m_luccID;
     /// parameters
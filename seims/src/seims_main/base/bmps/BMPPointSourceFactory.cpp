@@ -146,6 +146,14 @@ map<int, PointSourceLocations *>& BMPPointSrcFactory::GetPointSrcLocsMap() {
     return m_pointSrcLocsMap;
 }
 
+bool BMPPointSrcFactory::IsLocatedInSubbasin(const int subbasin_id) {
+    if (subbasin_id <= 0) { return !m_pointSrcLocsMap.empty(); }
+    for (auto it = m_pointSrcLocsMap.begin(); it != m_pointSrcLocsMap.end(); ++it) {
+        if (it->second->GetSubbasinID() == subbasin_id) { return true; }
+    }
+    return false;
+}
+
 void BMPPointSrcFactory::Dump(std::ostream* fs) {
     if (nullptr == fs) return;
     *fs << "Point Source Management Factory: " << endl <<
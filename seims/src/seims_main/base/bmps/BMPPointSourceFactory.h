@@ -3,6 +3,9 @@
  * \brief Point source pollution and BMP factory
  * \author Liang-Jun Zhu
  * \date July 2016
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Check if the BMP is located in the subbasin by point source locations.
  */
 #ifndef SEIMS_BMP_POINTSOURCE_H
 #define SEIMS_BMP_POINTSOURCE_H
@@ -196,6 +199,9 @@ public:
     /// Output
     void Dump(std::ostream* fs) OVERRIDE;
 
+    /// Is any point source of current subScenario located in the subbasin
+    bool IsLocatedInSubbasin(int subbasin_id) OVERRIDE;
+
     /*!
      * \brief Load point BMP location related parameters from MongoDB
      * \param[in] conn MongoClient instance
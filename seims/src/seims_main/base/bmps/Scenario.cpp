@@ -239,4 +239,11 @@ void Scenario::setRasterForEachBMP() {
         it->second->setRasterData(m_sceneRsMap);
     }
 }
+
+bool Scenario::IsLocatedInSubbasin() {
+    for (auto it = m_bmpFactories.begin(); it != m_bmpFactories.end(); ++it) {
+        if (nullptr != it->second && it->second->IsLocatedInSubbasin(m_subbsnID)) { return true; }
+    }
+    return false;
+}
 } /* MainBMP */
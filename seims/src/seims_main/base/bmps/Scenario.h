@@ -4,6 +4,7 @@
  *
  * Changelog:
  *   - 1. 2016-06-16 - lj - Replaced SQLite by MongoDB to manager BMP scenario data.
+ *   - 2. 2026-10-19 - lj - Add IsLocatedInSubbasin() for incremental scenario simulation.
  *
  * \author Liang-Jun Zhu
  */
@@ -77,6 +78,12 @@ public:
     //! set raster data for BMPs
     void setRasterForEachBMP();
 
+    /*!
+     * \brief Is any BMP located in the current subbasin, i.e., the subbasin should be simulated
+     *        rather than reused from a baseline simulation. Should be invoked after setRasterForEachBMP().
+     */
+    bool IsLocatedInSubbasin();
+
 
 private:
     /*!
@@ -56,3 +56,39 @@ FLTPT StorageTimeConstant(const FLTPT ch_manning, const FLTPT ch_slope, const FL
     FLTPT celerity = velocity * 5. / 3.;
     return ch_len / celerity / 3600.;
 }
+
+FLTPT KinematicCourant(const FLTPT q, const FLTPT area, const FLTPT dt, const FLTPT dx) {
+    if (q < MIN_FLUX || area < UTIL_ZERO || dx < UTIL_ZERO) { return 0.; }
+    return 5. / 3. * q / area * dt / dx;
+}
+
+int CourantSubSteps(const FLTPT courant, const FLTPT courant_limit, const int max_steps /* = MAX_CH_SUBSTEPS */) {
+    if (courant_limit <= 0. || courant <= courant_limit) { return 1; }
+    FLTPT n = ceil(courant / courant_limit);
+    return n >= max_steps ? max_steps : CVT_INT(n);
+}
+
+void ReachScheduler::Build(const vector<vector<int> >& up_streams,
+                           const map<int, vector<int> >& reach_layers) {
+    n_cells_ = CVT_INT(up_streams.size());
+    for (auto it = reach_layers.begin(); it != reach_layers.end(); ++it) {
+        for (auto rch = it->second.begin(); rch != it->second.end(); ++rch) {
+            n_cells_ = Max(n_cells_, *rch + 1);
+        }
+    }
+    vector<int> up_offsets(n_cells_ + 1, 0);
+    vector<int> up_cells;
+    for (int i = 0; i < n_cells_; i++) {
+        if (i < CVT_INT(up_streams.size())) {
+            up_cells.insert(up_cells.end(), up_streams[i].begin(), up_streams[i].end());
+        }
+        up_offsets[i + 1] = CVT_INT(up_cells.size());
+    }
+    layer_offsets_.assign(1, 0);
+    layer_cells_.clear();
+    for (auto it = reach_layers.begin(); it != reach_layers.end(); ++it) {
+        layer_cells_.insert(layer_cells_.end(), it->second.begin(), it->second.end());
+        layer_offsets_.push_back(CVT_INT(layer_cells_.size()));
+    }
+    BuildTopology(up_offsets, up_cells);
+}
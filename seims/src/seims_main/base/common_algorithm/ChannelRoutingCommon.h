@@ -7,6 +7,11 @@
 #ifndef SEIMS_CHANNEL_ROUTING_COMMON_H
 #define SEIMS_CHANNEL_ROUTING_COMMON_H
 #include <seims.h>
+#include <map>
+
+#include "RoutingExecutor.h"
+
+using std::map;
 
 /*!
  * \defgroup ChannelRouting 
@@ -99,4 +104,58 @@ FLTPT ChannelCrossSectionalArea(FLTPT ch_btmwth, FLTPT wtr_depth, FLTPT ch_sides
 FLTPT StorageTimeConstant(FLTPT ch_manning, FLTPT ch_slope, FLTPT ch_len,
                           FLTPT radius);
 
+/// Maximum number of sub-steps of each reach within one channel routing step
+const int MAX_CH_SUBSTEPS = 64;
+
+/*!
+ * \ingroup ChannelRouting
+ * \brief Courant number of kinematic wave in a channel cell, i.e., c * dt / dx,
+ *        where the wave celerity c is approximated by 5/3 of the flow velocity for wide channel.
+ * \param[in] q Flow rate, m^3/s
+ * \param[in] area Cross-sectional flow area, m^2
+ * \param[in] dt Time step, sec
+ * \param[in] dx Flow length of the cell, m
+ * \return Courant number, 0 if the channel is dry
+ */
+FLTPT KinematicCourant(FLTPT q, FLTPT area, FLTPT dt, FLTPT dx);
+
+/*!
+ * \ingroup ChannelRouting
+ * \brief Number of sub-steps so that the Courant number of each sub-step does not exceed the limit
+ * \param[in] courant Maximum Courant number of the reach with the whole time step, \sa KinematicCourant()
+ * \param[in] courant_limit Courant number limit of sub-steps, 0 means the whole time step
+ * \param[in] max_steps Maximum number of sub-steps
+ * \return Number of sub-steps, 1 ~ max_steps
+ */
+int CourantSubSteps(FLTPT courant, FLTPT courant_limit, int max_steps = MAX_CH_SUBSTEPS);
+
+/*!
+ * \ingroup ChannelRouting
+ * \class ReachScheduler
+ * \brief Reach-tree scheduler which executes a reach as soon as all of its upstream reaches
+ *        are finished, rather than stream order layers one by one with a barrier between them.
+ *
+ *        All routing procedures of a reach within one module (e.g., sediment routing and
+ *        channel downcutting of SEDR_SBAGNOLD) should be chained in the executed function.
+ *
+ * \code
+ *      // in SetReaches()
+ *      m_reachScheduler.Build(reaches->GetUpStreamIDs(), reaches->GetReachLayers());
+ *      // in Execute()
+ *      int errCount = m_reachScheduler.Execute(this, &MUSK_CH::ChannelFlow);
+ * \endcode
+ */
+class ReachScheduler: public RoutingExecutor {
+public:
+    //! Constructor, each task starts with one reach
+    ReachScheduler() : RoutingExecutor(1) {}
+
+    /*!
+     * \brief Build upstream dependencies of reaches
+     * \param[in] up_streams Upstream reach IDs of each reach (1 ~ N), \sa clsReaches::GetUpStreamIDs()
+     * \param[in] reach_layers Reach IDs of each stream order layer, \sa clsReaches::GetReachLayers()
+     */
+    void Build(const vector<vector<int> >& up_streams, const map<int, vector<int> >& reach_layers);
+};
+
 #endif /* SEIMS_CHANNEL_ROUTING_COMMON_H */
@@ -0,0 +1,69 @@
+#include "RoutingExecutor.h"
+
+#include "Logging.h"
+
+RoutingExecutor::RoutingExecutor(const int chunk_size) :
+    n_cells_(-1), chunk_size_(chunk_size > 0 ? chunk_size : 64), dataflow_(false) {
+}
+
+void RoutingExecutor::BuildTopology(const vector<int>& up_offsets, const vector<int>& up_cells) {
+    /// Cells not in routing layers will not be executed, and are regarded as finished
+    vector<bool> in_layers(n_cells_, false);
+    int n_active = 0;
+    for (auto it = layer_cells_.begin(); it != layer_cells_.end(); ++it) {
+        if (*it < 0 || *it >= n_cells_ || in_layers[*it]) {
+            n_active = -1;
+            break;
+        }
+        in_layers[*it] = true;
+        n_active++;
+    }
+    bool valid = n_active >= 0;
+    up_counts_.assign(n_cells_, 0);
+    down_offsets_.assign(n_cells_ + 1, 0);
+    for (int i = 0; valid && i < n_cells_; i++) {
+        if (!in_layers[i]) { continue; }
+        for (int k = up_offsets[i]; k < up_offsets[i + 1]; k++) {
+            int up = up_cells[k];
+            if (up < 0 || up >= n_cells_) {
+                valid = false;
+                break;
+            }
+            if (!in_layers[up]) { continue; }
+            up_counts_[i]++;
+            down_offsets_[up + 1]++;
+        }
+    }
+    for (int i = 0; i < n_cells_; i++) {
+        down_offsets_[i + 1] += down_offsets_[i];
+    }
+    down_cells_.assign(down_offsets_[n_cells_], -1);
+    vector<int> filled(down_offsets_.begin(), down_offsets_.end() - 1);
+    sources_.clear();
+    for (int i = 0; valid && i < n_cells_; i++) {
+        if (!in_layers[i]) { continue; }
+        if (up_counts_[i] == 0) { sources_.push_back(i); }
+        for (int k = up_offsets[i]; k < up_offsets[i + 1]; k++) {
+            if (in_layers[up_cells[k]]) { down_cells_[filled[up_cells[k]]++] = i; }
+        }
+    }
+    /// Check whether all cells can be reached from source cells, i.e., no cycles
+    vector<int> remain(up_counts_);
+    vector<int> stack(sources_);
+    int visited = 0;
+    while (valid && !stack.empty()) {
+        int id = stack.back();
+        stack.pop_back();
+        visited++;
+        for (int k = down_offsets_[id]; k < down_offsets_[id + 1]; k++) {
+            if (--remain[down_cells_[k]] == 0) { stack.push_back(down_cells_[k]); }
+        }
+    }
+    dataflow_ = valid && visited == n_active;
+    if (!dataflow_) {
+        LOG(WARNING) << "Invalid flow in relationships or routing layers, "
+                "routing layers will be executed one by one.";
+        return;
+    }
+    vector<std::atomic<int> >(n_cells_).swap(pending_);
+}
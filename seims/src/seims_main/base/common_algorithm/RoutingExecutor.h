@@ -0,0 +1,246 @@
+/*!
+ * \file RoutingExecutor.h
+ * \brief Barrier-free dataflow executor of cell-level routing, e.g., IKW_OL, IKW_IF, and KinWavSed_OL.
+ *
+ *        The layer-by-layer routing opens an OpenMP parallel region (with an implicit barrier)
+ *        for each routing layer. Most of the layers of a fine-resolution watershed hold only
+ *        a few cells, so the fork/join overhead dwarfs the computation.
+ *        Instead, the executor counts the upstream cells of each cell, and processes a cell
+ *        as soon as all of its upstream cells are finished. Cells are grouped into chunks
+ *        executed as OpenMP tasks, which are balanced by the work-stealing of OpenMP runtime.
+ *
+ *        The layer-by-layer routing is used if OpenMP tasks are not supported (e.g., OpenMP 2.0
+ *        of MSVC), only one thread is available, or the flow-in relationships contain cycles.
+ *        Only the cells of routing layers are executed, the others are regarded as finished.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liang-Jun Zhu
+ */
+#ifndef SEIMS_ROUTING_EXECUTOR_H
+#define SEIMS_ROUTING_EXECUTOR_H
+
+#include <atomic>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
+#if defined(SUPPORT_OMP) && defined(_OPENMP) && _OPENMP >= 200805
+#define ROUTING_EXECUTOR_USE_TASKS
+#endif
+
+using namespace ccgl;
+using std::vector;
+
+/*!
+ * \ingroup common_algorithm
+ * \class RoutingExecutor
+ * \brief Dataflow executor of cells by the upstream dependencies derived from flow-in indexes.
+ *
+ * \code
+ *      // in module
+ *      if (!m_executor.IsBuilt()) {
+ *          m_executor.Build(m_nCells, m_flowInIndex, m_routingLayers, m_nLayers);
+ *      }
+ *      m_executor.Execute(this, &ImplicitKinematicWave_OL::OverlandFlow);
+ * \endcode
+ */
+class RoutingExecutor: NotCopyable {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] chunk_size Cells number of a task
+     */
+    explicit RoutingExecutor(int chunk_size = 64);
+
+    /*!
+     * \brief Build upstream counters and downstream indexes
+     * \param[in] n_cells Valid cells number
+     * \param[in] flow_in Flow in indexes, the first element of each cell is the number of upstream cells
+     * \param[in] routing_layers Routing layers, the first element of each layer is the number of cells,
+     *                           which are used when the dataflow execution is not available
+     * \param[in] n_layers Routing layers number
+     */
+    template <typename T>
+    void Build(int n_cells, T** flow_in, T** routing_layers, int n_layers);
+
+    //! Is built or not
+    bool IsBuilt() const { return n_cells_ > 0; }
+
+    //! Execute by dataflow or by routing layers
+    bool IsDataflow() const { return dataflow_; }
+
+    /*!
+     * \brief Execute the member function of module for each cell, after all its upstream cells
+     * \param[in] obj Module instance
+     * \param[in] func Member function, e.g., `void OverlandFlow(int id)`
+     */
+    template <typename M>
+    void Execute(M* obj, void (M::*func)(int));
+
+    /*!
+     * \brief Execute the member function of module for each cell, after all its upstream cells
+     * \param[in] obj Module instance
+     * \param[in] func Member function which returns false if failed, e.g., `bool FlowInSoil(int id)`
+     * \return Number of cells failed
+     */
+    template <typename M>
+    int Execute(M* obj, bool (M::*func)(int));
+
+protected:
+    /*!
+     * \brief Build downstream indexes and source cells from upstream indexes in CSR format,
+     *        `n_cells_`, `layer_offsets_`, and `layer_cells_` should be set before
+     */
+    void BuildTopology(const vector<int>& up_offsets, const vector<int>& up_cells);
+
+private:
+    //! Run cells in dataflow or in routing layers
+    template <typename F>
+    void Run(F& func);
+
+#ifdef ROUTING_EXECUTOR_USE_TASKS
+    //! Run a chunk of ready cells and the downstream cells once they become ready
+    template <typename F>
+    void RunChunk(vector<int> ready, F& func);
+#endif
+
+    /// Adaptor of `void (M::*)(int)`
+    template <typename M>
+    struct VoidCall {
+        VoidCall(M* o, void (M::*f)(int)) : obj(o), func(f) {}
+        void operator()(const int id) { (obj->*func)(id); }
+        M* obj;
+        void (M::*func)(int);
+    };
+
+    /// Adaptor of `bool (M::*)(int)` which counts failures
+    template <typename M>
+    struct BoolCall {
+        BoolCall(M* o, bool (M::*f)(int)) : obj(o), func(f), failed(0) {}
+        void operator()(const int id) { if (!(obj->*func)(id)) { failed.fetch_add(1); } }
+        M* obj;
+        bool (M::*func)(int);
+        std::atomic<int> failed;
+    };
+
+protected:
+    int n_cells_;                   ///< Cells number, including the cells not in routing layers
+    vector<int> layer_offsets_;     ///< CSR offsets of routing layers
+    vector<int> layer_cells_;       ///< Cells of routing layers
+
+private:
+    int chunk_size_;                ///< Cells number of a task
+    bool dataflow_;                 ///< Execute by dataflow, otherwise by routing layers
+    vector<int> up_counts_;         ///< Number of upstream cells
+    vector<int> down_offsets_;      ///< CSR offsets of downstream cells, size n_cells_ + 1
+    vector<int> down_cells_;        ///< Downstream cells
+    vector<int> sources_;           ///< Cells without upstream cells
+    vector<std::atomic<int> > pending_; ///< Unfinished upstream cells during execution
+};
+
+template <typename T>
+void RoutingExecutor::Build(const int n_cells, T** flow_in, T** routing_layers, const int n_layers) {
+    vector<int> up_offsets(n_cells + 1, 0);
+    vector<int> up_cells;
+    for (int i = 0; i < n_cells; i++) {
+        int n_up = CVT_INT(flow_in[i][0]);
+        for (int k = 1; k <= n_up; k++) {
+            up_cells.push_back(CVT_INT(flow_in[i][k]));
+        }
+        up_offsets[i + 1] = CVT_INT(up_cells.size());
+    }
+    layer_offsets_.assign(1, 0);
+    layer_cells_.clear();
+    for (int ilyr = 0; ilyr < n_layers; ilyr++) {
+        int n_lyr_cells = CVT_INT(routing_layers[ilyr][0]);
+        for (int k = 1; k <= n_lyr_cells; k++) {
+            layer_cells_.push_back(CVT_INT(routing_layers[ilyr][k]));
+        }
+        layer_offsets_.push_back(CVT_INT(layer_cells_.size()));
+    }
+    n_cells_ = n_cells;
+    BuildTopology(up_offsets, up_cells);
+}
+
+template <typename M>
+void RoutingExecutor::Execute(M* obj, void (M::*func)(int)) {
+    VoidCall<M> call(obj, func);
+    Run(call);
+}
+
+template <typename M>
+int RoutingExecutor::Execute(M* obj, bool (M::*func)(int)) {
+    BoolCall<M> call(obj, func);
+    Run(call);
+    return call.failed.load();
+}
+
+template <typename F>
+void RoutingExecutor::Run(F& func) {
+#ifdef ROUTING_EXECUTOR_USE_TASKS
+    if (dataflow_ && omp_get_max_threads() > 1) {
+#pragma omp parallel for
+        for (int i = 0; i < n_cells_; i++) {
+            pending_[i].store(up_counts_[i], std::memory_order_relaxed);
+        }
+        int n_sources = CVT_INT(sources_.size());
+#pragma omp parallel
+        {
+#pragma omp single nowait
+            {
+                for (int begin = 0; begin < n_sources; begin += chunk_size_) {
+                    int end = Min(begin + chunk_size_, n_sources);
+                    vector<int> chunk(sources_.begin() + begin, sources_.begin() + end);
+#pragma omp task default(shared) firstprivate(chunk)
+                    RunChunk(chunk, func);
+                }
+            }
+        } /* All tasks are finished at the implicit barrier */
+        return;
+    }
+#endif /* ROUTING_EXECUTOR_USE_TASKS */
+    int n_layers = CVT_INT(layer_offsets_.size()) - 1;
+    for (int ilyr = 0; ilyr < n_layers; ilyr++) {
+        // There are not any flow relationship within each routing layer.
+        // So parallelization can be done here.
+#pragma omp parallel for
+        for (int k = layer_offsets_[ilyr]; k < layer_offsets_[ilyr + 1]; k++) {
+            func(layer_cells_[k]);
+        }
+    }
+}
+
+#ifdef ROUTING_EXECUTOR_USE_TASKS
+template <typename F>
+void RoutingExecutor::RunChunk(vector<int> ready, F& func) {
+    while (!ready.empty()) {
+        int id = ready.back();
+        ready.pop_back();
+        func(id);
+        for (int k = down_offsets_[id]; k < down_offsets_[id + 1]; k++) {
+            int down = down_cells_[k];
+            // The last finished upstream cell releases the downstream cell,
+            //   acq_rel makes the outputs of all upstream cells visible to it.
+            if (pending_[down].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                ready.push_back(down);
+            }
+        }
+        // Share the surplus ready cells with idle threads
+        if (CVT_INT(ready.size()) >= chunk_size_ << 1) {
+            vector<int> chunk(ready.begin(), ready.begin() + chunk_size_);
+            ready.erase(ready.begin(), ready.begin() + chunk_size_);
+#pragma omp task default(shared) firstprivate(chunk)
+            RunChunk(chunk, func);
+        }
+    }
+}
+#endif /* ROUTING_EXECUTOR_USE_TASKS */
+
+#endif /* SEIMS_ROUTING_EXECUTOR_H */
@@ -6,12 +6,26 @@
 
 using namespace utils_time;
 
+const int METEO_VARS_NUM = 6;
+const char* METEO_VARS[] = {
+    DataType_MeanTemperature, DataType_MaximumTemperature,
+    DataType_MinimumTemperature, DataType_SolarRadiation,
+    DataType_WindSpeed, DataType_RelativeAirMoisture
+};
+
+const int SOILWATER_VARS_NUM = 5;
+const char* SOILWATER_VARS[] = {
+    VAR_SOL_WPMM[0], VAR_SOL_AWC[0], VAR_SOL_UL[0],
+    VAR_SOL_SUMAWC[0], VAR_SOL_SUMSAT[0]
+};
+
 DataCenter::DataCenter(InputArgs* input_args, ModuleFactory* factory, const int subbasin_id /* = 0 */) :
     model_name_(input_args->model_name), model_path_(input_args->model_path),
     fdir_method_(input_args->fdir_mtd), lyr_method_(input_args->lyr_mtd), subbasin_id_(subbasin_id),
     scenario_id_(input_args->scenario_id), calibration_id_(input_args->calibration_id),
     mpi_rank_(factory->m_mpi_rank), mpi_size_(factory->m_mpi_size),
-    thread_num_(input_args->thread_num),
+    thread_num_(input_args->thread_num), active_cells_(input_args->active_cells),
+    class_params_(input_args->class_params),
     use_scenario_(false),
     output_path_(input_args->output_path),
     n_subbasins_(-1), outlet_id_(-1), factory_(factory),
@@ -61,6 +75,17 @@ DataCenter::~DataCenter() {
         }
     }
     rs_map_.clear();
+    CLOG(TRACE, LOG_RELEASE) << "---release map of class-indexed raster data ...";
+    // The owners of shared class IDs are released after the others
+    for (int owner = 0; owner < 2; owner++) {
+        for (auto it = cls_map_.begin(); it != cls_map_.end(); ++it) {
+            if (nullptr == it->second || it->second->OwnsClassIDs() != (owner == 1)) { continue; }
+            CLOG(TRACE, LOG_RELEASE) << "-----" << it->first << " ...";
+            delete it->second;
+            it->second = nullptr;
+        }
+    }
+    cls_map_.clear();
     CLOG(TRACE, LOG_RELEASE) << "---release map of all integer 1D and 2D raster data ...";
     for (auto it = rs_int_map_.begin(); it != rs_int_map_.end(); ++it) {
         if (nullptr != it->second) {
@@ -129,6 +154,78 @@ bool DataCenter::GetFileInStringVector() {
     return true;
 }
 
+bool DataCenter::InsertInitParameter(const string& name, const string& desc, const string& unit,
+                                     const string& module, const FLTPT value, const string& change,
+                                     const FLTPT impact, const FLTPT maximum, const FLTPT minimum,
+                                     const bool isint) {
+    if (isint) {
+        ParamInfo<int>* intp = new ParamInfo<int>(name, desc, unit, module, CVT_INT(value),
+                                                  change, CVT_INT(impact), CVT_INT(maximum),
+                                                  CVT_INT(minimum), isint);
+#ifdef HAS_VARIADIC_TEMPLATES
+        if (!init_params_int_.emplace(name, intp).second) {
+#else
+        if (!init_params_int_.insert(make_pair(name, intp)).second) {
+#endif
+            delete intp;
+            LOG(ERROR) << "Load parameter: " << name << " failed!";
+            return false;
+        }
+        return true;
+    }
+    ParamInfo<FLTPT>* p = new ParamInfo<FLTPT>(name, desc, unit, module, value,
+                                               change, impact, maximum, minimum, isint);
+#ifdef HAS_VARIADIC_TEMPLATES
+    if (!init_params_.emplace(name, p).second) {
+#else
+    if (!init_params_.insert(make_pair(name, p)).second) {
+#endif
+        delete p;
+        LOG(ERROR) << "Load parameter: " << name << " failed!";
+        return false;
+    }
+    /// Special handling code for soil water capcity parameters
+    /// e.g., SOL_AWC, SOL_UL, WILTINGPOINT. By ljzhu, 2018-1-11
+    if (StringMatch(name, VAR_SW_CAP[0])) {
+        for (int si = 0; si < SOILWATER_VARS_NUM; si++) {
+            ParamInfo<FLTPT>* tmpp = new ParamInfo<FLTPT>(*p);
+            tmpp->Name = SOILWATER_VARS[si];
+#ifdef HAS_VARIADIC_TEMPLATES
+            init_params_.emplace(GetUpper(tmpp->Name), tmpp);
+#else
+            init_params_.insert(make_pair(GetUpper(tmpp->Name), tmpp));
+#endif
+        }
+    }
+    return true;
+}
+
+void DataCenter::ParseIuhData(const float* values, int& n, FLTPT**& data) {
+    // Customize code according to Initialize2DArray. LJ, 2022-08-23
+    int idx = 0;
+    n = CVT_INT(values[idx++]);
+    data = new(nothrow) FLTPT * [n];
+    FLTPT* pool = nullptr;
+    // Get actual data length of init_data, excluding the first element which is 'rows'
+    int* cols = new int[n];
+    int max_cols = -1;
+    for (int i = 0; i < n; i++) {
+        cols[i] = CVT_INT(values[idx + 1] - values[idx] + 3);
+        idx += cols[i];
+        if (cols[i] > max_cols) { max_cols = cols[i]; }
+    }
+    int length = idx - 1;
+    // New a 1d array to store data
+    Initialize1DArray(length, pool, values + 1);
+    // Now point the row pointers to the appropriate positions in the data pool
+    int pos = 0;
+    for (int i = 0; i < n; ++i) {
+        data[i] = pool + pos;
+        pos += cols[i];
+    }
+    delete[] cols;
+}
+
 void DataCenter::SetLapseData(const string& remote_filename, int& rows, int& cols, FLTPT**& data) {
     rows = 12;
     cols = 5;
@@ -724,7 +821,9 @@ void DataCenter::SetRaster(const string& para_name, const string& remote_filenam
     FLTPT* data = nullptr;
     FLTPT** data2d = nullptr;
     FloatRaster* raster = nullptr;
-    if (rs_map_.find(remote_filename) == rs_map_.end()) {
+    bool just_loaded = false;
+    if (rs_map_.find(remote_filename) == rs_map_.end() &&
+        cls_map_.find(remote_filename) == cls_map_.end()) {
         if (StringMatch(para_name.c_str(), Type_RasterPositionData)) {
             if (!rs_map_.empty()) {
                 raster = rs_map_.begin()->second;
@@ -739,8 +838,12 @@ void DataCenter::SetRaster(const string& para_name, const string& remote_filenam
         }
         else {
             LoadAdjustRasterData(para_name, remote_filename, is_optional);
+            just_loaded = true;
         }
     }
+    if (SetClassRaster(para_name, remote_filename, p_module, just_loaded)) {
+        return;
+    }
     if (rs_map_.find(remote_filename) == rs_map_.end()) {
         return; // when encounter optional parameters
     }
@@ -758,6 +861,76 @@ void DataCenter::SetRaster(const string& para_name, const string& remote_filenam
     }
 }
 
+bool DataCenter::SetClassRaster(const string& para_name, const string& remote_filename,
+                                SimulationModule* p_module, const bool just_loaded) {
+    auto cls_iter = cls_map_.find(remote_filename);
+    if (cls_iter == cls_map_.end()) {
+        /// Only the raster just loaded can be compressed, since the others may be set as full array
+        if (!class_params_ || !just_loaded) { return false; }
+        auto rs_iter = rs_map_.find(remote_filename);
+        if (rs_iter == rs_map_.end()) { return false; }
+        FloatRaster* raster = rs_iter->second;
+        int n, lyrs;
+        ClassParameter* cls = nullptr;
+        if (raster->Is2DRaster()) {
+            FLTPT** data2d = nullptr;
+            if (!raster->Get2DRasterData(&n, &lyrs, &data2d)) { return false; }
+            cls = ClassParameter::Compress(n, lyrs, data2d);
+        } else {
+            FLTPT* data = nullptr;
+            if (!raster->GetRasterData(&n, &data)) { return false; }
+            cls = ClassParameter::Compress(n, data);
+        }
+        if (nullptr == cls) { return false; }
+        if (!p_module->SetClassData(para_name.c_str(), cls)) {
+            delete cls;
+            return false;
+        }
+        for (auto it = cls_map_.begin(); it != cls_map_.end(); ++it) {
+            if (cls->ShareClassIDs(it->second)) { break; }
+        }
+        CLOG(TRACE, LOG_INIT) << "Class-indexed " << remote_filename << ": " << cls->GetClassNumber()
+                << " classes, " << cls->GetMemorySize() << " bytes"
+                << (cls->OwnsClassIDs() ? "" : " (class IDs shared)");
+        delete raster;
+        rs_map_.erase(rs_iter);
+        cls_map_[remote_filename] = cls;
+        return true;
+    }
+    ClassParameter* cls = cls_iter->second;
+    if (p_module->SetClassData(para_name.c_str(), cls)) { return true; }
+    if (cls->Is2DRaster()) {
+        p_module->Set2DData(para_name.c_str(), cls->GetCellNumber(), cls->GetLayers(), cls->Expand2D());
+    } else {
+        p_module->Set1DData(para_name.c_str(), cls->GetCellNumber(), cls->Expand());
+    }
+    return true;
+}
+
+bool DataCenter::GetAdjustableRasterData(const string& remote_filename, int& n, int& lyrs,
+                                         FLTPT*& data, FLTPT**& data2d) {
+    data = nullptr;
+    data2d = nullptr;
+    auto rs_iter = rs_map_.find(remote_filename);
+    if (rs_iter != rs_map_.end()) {
+        if (rs_iter->second->Is2DRaster()) {
+            return rs_iter->second->Get2DRasterData(&n, &lyrs, &data2d);
+        }
+        lyrs = 1;
+        return rs_iter->second->GetRasterData(&n, &data);
+    }
+    auto cls_iter = cls_map_.find(remote_filename);
+    if (cls_iter == cls_map_.end()) { return false; }
+    n = cls_iter->second->GetCellNumber();
+    lyrs = cls_iter->second->GetLayers();
+    if (cls_iter->second->Is2DRaster()) {
+        data2d = cls_iter->second->Expand2D();
+    } else {
+        data = cls_iter->second->Expand();
+    }
+    return true;
+}
+
 void DataCenter::SetRasterInt(const string& para_name, const string& remote_filename,
                               SimulationModule* p_module, const bool is_optional /* = false */) {
     int n, lyrs;
@@ -913,23 +1086,21 @@ void DataCenter::UpdateScenarioParametersStable(const int subbsn_id) {
                 iter3->second->Minimum = tmpparam->Minimum;
                 // Perform update
                 string remote_filename = GetUpper(ValueToString(subbsn_id) + "_" + paraname);
-                if (rs_map_.find(remote_filename) == rs_map_.end()) {
+                int lyr = -1;
+                FLTPT* data = nullptr;
+                FLTPT** data2d = nullptr;
+                if (!GetAdjustableRasterData(remote_filename, nsize, lyr, data, data2d)) {
                     cout << "      Warning: the parameter name: " << remote_filename <<
                             " is not loaded as 1D or 2D raster, and "
                             " will not work as expected." << endl;
                     continue;
                 }
                 int count = 0;
-                if (rs_map_[remote_filename]->Is2DRaster()) {
-                    int lyr = -1;
-                    FLTPT** data2d = nullptr;
-                    rs_map_[remote_filename]->Get2DRasterData(&nsize, &lyr, &data2d);
+                if (nullptr != data2d) {
                     count = iter3->second->Adjust2DRaster(nsize, lyr, data2d, mgtunits,
                                                           sel_ids, ludata, suitablelu);
                 }
                 else {
-                    FLTPT* data = nullptr;
-                    rs_map_[remote_filename]->GetRasterData(&nsize, &data);
                     count = iter3->second->Adjust1DRaster(nsize, data, mgtunits, sel_ids,
                                                           ludata, suitablelu);
                 }
@@ -1020,7 +1191,10 @@ bool DataCenter::UpdateScenarioParametersDynamic(const int subbsn_id, time_t t)
 
                         // Perform update
                         string remote_filename = GetUpper(ValueToString(subbsn_id) + "_" + paraname);
-                        if (rs_map_.find(remote_filename) == rs_map_.end()) {
+                        int lyr = -1;
+                        FLTPT* data = nullptr;
+                        FLTPT** data2d = nullptr;
+                        if (!GetAdjustableRasterData(remote_filename, nsize, lyr, data, data2d)) {
                             cout << "      Warning: the parameter name: " << remote_filename <<
                                     " is not loaded as 1D or 2D raster, and "
                                     " will not work as expected." << endl;
@@ -1034,16 +1208,11 @@ bool DataCenter::UpdateScenarioParametersDynamic(const int subbsn_id, time_t t)
                         output_params.push_back("0_CONDUCTIVITY"); //"0_DENSITY", "0_CONDUCTIVITY"
 #endif // _DEBUG
                         int count = 0;
-                        if (rs_map_[remote_filename]->Is2DRaster()) {
-                            int lyr = -1;
-                            FLTPT** data2d = nullptr;
-                            rs_map_[remote_filename]->Get2DRasterData(&nsize, &lyr, &data2d);
+                        if (nullptr != data2d) {
                             count = iter3->second->Adjust2DRasterWithImpactIndexes(nsize, lyr, data2d, mgtunits,
                                 sel_ids, unitUpdateTimes, ludata, suitablelu);
                         }
                         else {
-                            FLTPT* data = nullptr;
-                            rs_map_[remote_filename]->GetRasterData(&nsize, &data);
                             count = iter3->second->Adjust1DRasterWithImpactIndexes(nsize, data, mgtunits, sel_ids,
                                 unitUpdateTimes, ludata, suitablelu);
                         }
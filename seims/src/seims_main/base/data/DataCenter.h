@@ -9,6 +9,9 @@
  *   - 2. 2018-09-19 - lj - Separate load data from SetData. Compatible with optional parameters.
  *   - 3. 2021-04-06 - lj - Add fdir_method_ to handle different flow direction algorithms.
  *   - 4. 2022-08-20 - lj - Change float to FLTPT.
+ *   - 5. 2026-10-19 - lj - Extract common functions for MongoDB-based and file-based data centers.
+ *   - 6. 2026-10-19 - lj - Add active-cell tracking mode of modules.
+ *   - 7. 2026-10-19 - lj - Keep parameter rasters as class-indexed data for the supported modules.
  *
  * \author Liangjun Zhu
  */
@@ -27,6 +30,11 @@
 #include "clsSubbasin.h"
 #include "Scenario.h"
 #include "clsInterpolationWeightData.h"
+#include "ClassParameter.h"
+
+/// Meteorological data types, i.e., sites of SITELISTM
+extern const int METEO_VARS_NUM;
+extern const char* METEO_VARS[];
 
 /*!
  * \ingroup data
@@ -236,6 +244,30 @@ public:
     void SetRasterInt(const string& para_name, const string& remote_filename,
                       SimulationModule* p_module, bool is_optional = false);
 
+    /*!
+     * \brief Set class-indexed raster data, see ClassParameter.
+     *
+     *        The raster just loaded is compressed if the module supports the class-indexed data,
+     *        otherwise, it is kept as full array for all modules. For the modules that do not
+     *        support it, the full array of the compressed raster is materialized and set.
+     *
+     * \param[in] para_name Parameter name
+     * \param[in] remote_filename Actual file/data name stored in Database
+     * \param[in] p_module Module
+     * \param[in] just_loaded Is the raster loaded by the current call of SetRaster()
+     * \return False if the raster is not compressed, which should be set as full array
+     */
+    bool SetClassRaster(const string& para_name, const string& remote_filename,
+                        SimulationModule* p_module, bool just_loaded);
+
+    /*!
+     * \brief Get raster data to be adjusted spatially, e.g., by areal BMPs of scenario,
+     *        the full array of class-indexed raster will be materialized.
+     * \return False if the raster is not loaded
+     */
+    bool GetAdjustableRasterData(const string& remote_filename, int& n, int& lyrs,
+                                 FLTPT*& data, FLTPT**& data2d);
+
     //! Set BMPs Scenario data
     void SetScenario(SimulationModule* p_module, bool is_optional = false);
 
@@ -278,6 +310,8 @@ public:
     int GetScenarioID() const { return scenario_id_; }
     int GetCalibrationID() const { return calibration_id_; }
     int GetThreadNumber() const { return thread_num_; }
+    ActiveCellsMode GetActiveCellsMode() const { return active_cells_; }
+    bool UseClassParameters() const { return class_params_; }
     bool UseScenario() const { return use_scenario_; }
     string GetOutputScenePath() const { return output_path_; }
     string GetModelMode() const { return model_mode_; }
@@ -305,11 +339,31 @@ public:
     * \brief Get file.out configuration
     */
     virtual bool GetFileOutVector() = 0;
+    /*!
+     * \brief Get GridFS to store spatial outputs of subbasins (e.g., for MPI version), nullptr if not supported
+     */
+    virtual MongoGridFs* GetMongoGridFsOutput() const { return nullptr; }
     /*!
      * \brief Check date of output settings
      */
     void UpdateOutputDate(time_t start_time, time_t end_time);
 
+protected:
+    /*!
+     * \brief Insert initial parameter read from database to `init_params_` or `init_params_int_`
+     * \return False if the parameter has been existed
+     */
+    bool InsertInitParameter(const string& name, const string& desc, const string& unit,
+                             const string& module, FLTPT value, const string& change,
+                             FLTPT impact, FLTPT maximum, FLTPT minimum, bool isint);
+    /*!
+     * \brief Construct IUH data from float array stored in database
+     * \param[in] values Float array, the first element is valid cell number
+     * \param[out] n valid cell number
+     * \param[out] data returned data
+     */
+    static void ParseIuhData(const float* values, int& n, FLTPT**& data);
+
 protected:
     string model_name_;                    ///< Model name, e.g., model_dianbu30m_longterm
     const string model_path_;              ///< Model path
@@ -324,6 +378,8 @@ protected:
     const int mpi_rank_;                   ///< Rank ID for MPI, starts from 0 to mpi_size_ - 1
     const int mpi_size_;                   ///< Rank size for MPI
     const int thread_num_;                 ///< Thread number for OpenMP
+    const ActiveCellsMode active_cells_;   ///< Active-cell tracking mode of modules
+    const bool class_params_;              ///< Keep parameter rasters as class-indexed data
     bool use_scenario_;                    ///< Model Scenario
     string output_path_;                   ///< Output path (with / in the end) according to m_outputScene
     vector<string> file_in_strs_;          ///< file.in configuration
@@ -341,6 +397,7 @@ protected:
     IntRaster* mask_raster_;               ///< Mask data
     map<string, FloatRaster *> rs_map_;    ///< Map of spatial data, both 1D and 2D
     map<string, IntRaster*> rs_int_map_;   ///< Map of spatial data with integer, both 1D and 2D
+    map<string, ClassParameter*> cls_map_; ///< Map of class-indexed spatial data, both 1D and 2D
 	FloatRaster* ch_depth_;                /// reach depth data,every cell has a depth
     map<string, ParamInfo<FLTPT>*> init_params_; ///< Store parameters from Database (PARAMETERS collection)
     map<string, ParamInfo<int>*> init_params_int_; ///< Store integer parameters from Database (PARAMETERS collection)
@@ -0,0 +1,80 @@
+#include "DataCenterCache.h"
+
+#include "utils_array.h"
+#include "utils_string.h"
+
+using namespace utils_array;
+using namespace utils_string;
+
+DataCenterCache::DataCenterCache() : n_hits_(0) {
+}
+
+DataCenterCache::~DataCenterCache() {
+    for (auto it = arrays_.begin(); it != arrays_.end(); ++it) {
+        if (nullptr != it->second) { Release2DArray(it->second); }
+    }
+    arrays_.clear();
+}
+
+const vector<InitParamRecord>* DataCenterCache::GetParameters(const string& model_name, const int calibration_id) {
+    auto it = params_.find(CacheKey(model_name, calibration_id));
+    if (it == params_.end()) { return nullptr; }
+    n_hits_++;
+    return &it->second;
+}
+
+const vector<InitParamRecord>* DataCenterCache::AddParameters(const string& model_name, const int calibration_id,
+                                                              vector<InitParamRecord>& records) {
+    vector<InitParamRecord>& cached = params_[CacheKey(model_name, calibration_id)];
+    cached.swap(records);
+    return &cached;
+}
+
+bool DataCenterCache::GetSiteLists(const string& model_name, const string& model_mode, const int subbasin_id,
+                                   const vector<ClimateSiteList>*& lists) {
+    lists = nullptr;
+    auto it = sites_.find(model_name + "|" + model_mode);
+    if (it == sites_.end()) { return false; }
+    n_hits_++;
+    auto it_subbsn = it->second.find(subbasin_id);
+    if (it_subbsn != it->second.end()) { lists = &it_subbsn->second; }
+    return true;
+}
+
+void DataCenterCache::AddSiteLists(const string& model_name, const string& model_mode,
+                                   map<int, vector<ClimateSiteList> >& lists) {
+    sites_[model_name + "|" + model_mode].swap(lists);
+}
+
+bool DataCenterCache::Get2DArray(const string& remote_filename, const int calibration_id,
+                                 int& rows, int& cols, FLTPT**& data) {
+    string key = CacheKey(remote_filename, calibration_id);
+    auto it = arrays_.find(key);
+    if (it == arrays_.end()) { return false; }
+    n_hits_++;
+    data = it->second;
+    rows = array_rows_.at(key);
+    cols = array_cols_.at(key);
+    return true;
+}
+
+void DataCenterCache::Add2DArray(const string& remote_filename, const int calibration_id,
+                                 const int rows, const int cols, FLTPT** data) {
+    string key = CacheKey(remote_filename, calibration_id);
+    auto it = arrays_.find(key);
+    if (it != arrays_.end()) {
+        if (it->second == data) { return; }
+        Release2DArray(it->second);
+    }
+    arrays_[key] = data;
+    array_rows_[key] = rows;
+    array_cols_[key] = cols;
+}
+
+int DataCenterCache::GetCachedCount() const {
+    return CVT_INT(params_.size() + sites_.size() + arrays_.size());
+}
+
+string DataCenterCache::CacheKey(const string& name, const int id) {
+    return name + "|" + ValueToString(id);
+}
@@ -0,0 +1,149 @@
+/*!
+ * \file DataCenterCache.h
+ * \brief Read-only inputs cached once and shared by the data centers of one process.
+ *
+ *        In the MPI version, each rank constructs one data center for each of its subbasins,
+ *        which repeats the same queries of initial parameters, climate site lists, and lookup
+ *        tables (e.g., crop, fertilizer, tillage, and landuse). The cache keeps the first result
+ *        of each query, keyed by the collection or file name and the calibration ID, and the
+ *        following data centers reference the cached result instead of querying and holding
+ *        their own copy. Only the subbasin-specific data (e.g., rasters) are read by each one.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_DATA_CENTER_CACHE_H
+#define SEIMS_DATA_CENTER_CACHE_H
+
+#include <map>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+using namespace ccgl;
+using std::map;
+using std::vector;
+
+/*!
+ * \ingroup data
+ * \struct InitParamRecord
+ * \brief Fields of one initial parameter in PARAMETERS collection, \sa DataCenter::InsertInitParameter()
+ */
+struct InitParamRecord {
+    string name;   ///< Parameter name in upper case
+    string desc;   ///< Description
+    string unit;   ///< Unit
+    string module; ///< Modules that use the parameter
+    FLTPT value;   ///< Initial value
+    string change; ///< Change method
+    FLTPT impact;  ///< Impact value according to calibration ID
+    FLTPT maximum; ///< Maximum value
+    FLTPT minimum; ///< Minimum value
+    bool isint;    ///< Integer parameter or not
+};
+
+/*!
+ * \ingroup data
+ * \struct ClimateSiteList
+ * \brief Site lists of one record in SITELIST collection
+ */
+struct ClimateSiteList {
+    string clim_dbname;  ///< HydroClimate database name
+    string meteo_sites;  ///< Meteorological sites, empty if not existed
+    string pcp_sites;    ///< Precipitation sites, empty if not existed
+    string pet_sites;    ///< Potential evapotranspiration sites, empty if not existed
+};
+
+/*!
+ * \ingroup data
+ * \class DataCenterCache
+ * \brief Query results shared by the data centers of one process, e.g., one MPI rank.
+ *
+ *        The cached results are immutable and owned by the cache, which should be alive until all
+ *        data centers that reference them are released. The cache is not thread-safe, i.e., the
+ *        data centers should be constructed and loaded sequentially.
+ *
+ * \code
+ *      DataCenterCache* cache = new DataCenterCache();
+ *      DataCenterMongoDB* data_center = new DataCenterMongoDB(..., subbasin_id, shared_climate, cache);
+ *      ...
+ *      delete data_center;
+ *      delete cache; // after all data centers are released
+ * \endcode
+ */
+class DataCenterCache: NotCopyable {
+public:
+    //! Constructor
+    DataCenterCache();
+
+    //! Destructor, release the cached arrays
+    ~DataCenterCache();
+
+    /*!
+     * \brief Cached initial parameters of the model and calibration ID, nullptr if not cached
+     */
+    const vector<InitParamRecord>* GetParameters(const string& model_name, int calibration_id);
+
+    /*!
+     * \brief Cache initial parameters, the records are swapped into the cache
+     * \return Cached records
+     */
+    const vector<InitParamRecord>* AddParameters(const string& model_name, int calibration_id,
+                                                 vector<InitParamRecord>& records);
+
+    /*!
+     * \brief Cached site lists of the subbasin
+     * \param[in] model_name Main model database name
+     * \param[in] model_mode Model mode, i.e., Daily or Storm
+     * \param[in] subbasin_id Subbasin ID
+     * \param[out] lists Site lists of the subbasin, nullptr if the subbasin has no site lists
+     * \return False if the site lists of the model and mode are not cached
+     */
+    bool GetSiteLists(const string& model_name, const string& model_mode, int subbasin_id,
+                      const vector<ClimateSiteList>*& lists);
+
+    /*!
+     * \brief Cache site lists of all subbasins of the model and mode, which are swapped into the cache
+     */
+    void AddSiteLists(const string& model_name, const string& model_mode,
+                      map<int, vector<ClimateSiteList> >& lists);
+
+    /*!
+     * \brief Cached 2D array, e.g., lookup tables
+     * \param[in] remote_filename Data file name
+     * \param[in] calibration_id Calibration ID
+     * \param[out] rows Rows number
+     * \param[out] cols Cols number
+     * \param[out] data Cached data
+     * \return False if not cached
+     */
+    bool Get2DArray(const string& remote_filename, int calibration_id, int& rows, int& cols, FLTPT**& data);
+
+    /*!
+     * \brief Cache 2D array, which will be owned and released by the cache
+     */
+    void Add2DArray(const string& remote_filename, int calibration_id, int rows, int cols, FLTPT** data);
+
+    //! Number of queries replaced by cached results
+    int GetHitCount() const { return n_hits_; }
+
+    //! Number of cached query results
+    int GetCachedCount() const;
+
+private:
+    //! Key of cached data, i.e., name|calibration ID
+    static string CacheKey(const string& name, int id);
+
+private:
+    map<string, vector<InitParamRecord> > params_;              ///< Initial parameters
+    map<string, map<int, vector<ClimateSiteList> > > sites_;    ///< Site lists of subbasins
+    map<string, FLTPT**> arrays_;                               ///< 2D arrays
+    map<string, int> array_rows_;                               ///< Rows of 2D arrays
+    map<string, int> array_cols_;                               ///< Cols of 2D arrays
+    int n_hits_;                                                ///< Number of cache hits
+};
+
+#endif /* SEIMS_DATA_CENTER_CACHE_H */
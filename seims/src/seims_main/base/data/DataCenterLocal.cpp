@@ -0,0 +1,472 @@
+#include "DataCenterLocal.h"
+
+#include "utils_time.h"
+#include "LocalDataFile.h"
+#include "RegularMeasurement.h"
+#include "text.h"
+#include "Logging.h"
+
+using namespace utils_time;
+
+namespace {
+const char* LOCAL_MANIFEST = "MANIFEST";
+const char* LOCAL_TABLE_EXT = ".tsv";
+const char* LOCAL_BINARY_EXT = ".sbin";
+const char* LOCAL_CLIMATE_DIR = "CLIMATE";
+const char* LOCAL_TABS_REQ[] = {
+    DB_TAB_FILE_IN, DB_TAB_FILE_OUT, DB_TAB_SITELIST,
+    DB_TAB_PARAMETERS, DB_TAB_REACH, ""
+};
+
+string GetField(const STRING_MAP& record, const char* key) {
+    auto it = record.find(key);
+    if (it == record.end()) { return ""; }
+    return it->second;
+}
+
+template <typename T>
+bool GetNumericField(const STRING_MAP& record, const char* key, T& value) {
+    auto it = record.find(key);
+    if (it == record.end()) { return false; }
+    bool flag = false;
+    double tmp = IsDouble(it->second, flag);
+    if (flag) { value = static_cast<T>(tmp); }
+    return flag;
+}
+} /* namespace */
+
+DataCenterLocal::DataCenterLocal(InputArgs* input_args, ModuleFactory* factory,
+                                 const int subbasin_id /* = 0 */) :
+    DataCenter(input_args, factory, subbasin_id), local_path_(input_args->local_path) {
+    STRING_MAP manifest;
+    if (!ReadLocalKeyValues(local_path_ + SEP + LOCAL_MANIFEST, manifest)
+        || manifest.find("VERSION") == manifest.end()) {
+        throw ModelException("DataCenterLocal", "Constructor",
+                             "No valid MANIFEST found in " + local_path_ + "!");
+    }
+    if (manifest.at("VERSION") != ValueToString(LOCAL_DATA_VERSION)) {
+        throw ModelException("DataCenterLocal", "Constructor",
+                             "Unsupported version of local data: " + manifest.at("VERSION") +
+                             ", please export again by db_export_local.py!");
+    }
+    if (DataCenterLocal::GetFileInStringVector()) {
+        input_ = SettingsInput::Init(file_in_strs_);
+        if (nullptr == input_) {
+            throw ModelException("DataCenterLocal", "Constructor", "Failed to initialize m_input!");
+        }
+    } else {
+        throw ModelException("DataCenterLocal", "Constructor", "Failed to read FILE_IN!");
+    }
+    outlet_id_ = DataCenterLocal::ReadIntParameterInDB(VAR_OUTLETID[0]);
+    n_subbasins_ = DataCenterLocal::ReadIntParameterInDB(VAR_SUBBSNID_NUM[0]);
+    if (outlet_id_ < 0 || n_subbasins_ < 0) {
+        throw ModelException("DataCenterLocal", "Constructor", "Read subbasin number and outlet ID failed!");
+    }
+    if (DataCenterLocal::GetFileOutVector()) {
+        UpdateOutputDate(input_->getStartTime(), input_->getEndTime());
+        output_ = SettingsOutput::Init(n_subbasins_, outlet_id_, subbasin_id_, origin_out_items_,
+                                       scenario_id_, calibration_id_, mpi_rank_, mpi_size_);
+        if (nullptr == output_) {
+            throw ModelException("DataCenterLocal", "Constructor", "Failed to initialize m_output!");
+        }
+    } else {
+        throw ModelException("DataCenterLocal", "Constructor", "Failed to read FILE_OUT!");
+    }
+    if (!DataCenterLocal::CheckModelPreparedData()) {
+        throw ModelException("DataCenterLocal", "checkModelPreparedData", "Model data has not been set up!");
+    }
+}
+
+DataCenterLocal::~DataCenterLocal() {
+    CLOG(TRACE, LOG_RELEASE) << "Release DataCenterLocal...";
+}
+
+string DataCenterLocal::SpatialFilename(const string& name) const {
+    return local_path_ + SEP + DB_TAB_SPATIAL + SEP + name + LOCAL_BINARY_EXT;
+}
+
+string DataCenterLocal::TableFilename(const char* name) const {
+    return local_path_ + SEP + name + LOCAL_TABLE_EXT;
+}
+
+bool DataCenterLocal::CheckModelPreparedData() {
+    /// 1. Check the existence of FILE_IN, FILE_OUT, PARAMETERS, REACHES, SITELIST, SPATIAL, etc
+    for (int i = 0; *LOCAL_TABS_REQ[i] != '\0'; i++) {
+        if (!FileExists(TableFilename(LOCAL_TABS_REQ[i]))) {
+            LOG(ERROR) << "Table " << LOCAL_TABS_REQ[i] << " must be existed in " << local_path_;
+            return false;
+        }
+    }
+    if (!DirectoryExists(local_path_ + SEP + DB_TAB_SPATIAL)) {
+        LOG(ERROR) << "Folder " << DB_TAB_SPATIAL << " must be existed in " << local_path_;
+        return false;
+    }
+    /// 2. Read climate data
+    clim_station_ = new InputStation(nullptr, input_->getDtHillslope(), input_->getDtChannel());
+    ReadClimateSiteList();
+
+    /// 3. Read initial parameters
+    if (!ReadParametersInDB()) {
+        return false;
+    }
+    DumpCaliParametersInDB();
+
+    /// 4. Read Mask raster data
+    std::ostringstream oss;
+    oss << subbasin_id_ << "_" << VAR_SUBBSN[0];
+    string mask_filename = GetUpper(oss.str());
+    if (!ReadLocalRaster(mask_filename, mask_raster_, false)) {
+        LOG(ERROR) << "Failed to read mask raster: " << SpatialFilename(mask_filename);
+        return false;
+    }
+#ifdef HAS_VARIADIC_TEMPLATES
+    rs_int_map_.emplace(mask_filename, mask_raster_);
+#else
+    rs_int_map_.insert(make_pair(mask_filename, mask_raster_));
+#endif
+
+    /// 5. Constructor Subbasin data. Subbasin and slope data are required!
+    oss.str("");
+    oss << subbasin_id_ << "_" << VAR_SLOPE[0];
+    LoadAdjustRasterData(VAR_SLOPE[0], GetUpper(oss.str()));
+
+    subbasins_ = clsSubbasins::Init(rs_int_map_, rs_map_, subbasin_id_);
+    assert(nullptr != subbasins_);
+
+    /// 6. Read Reaches data, all reaches will be read for both MPI and OMP version
+    vector<STRING_MAP> reach_records;
+    ReadLocalRecords(TableFilename(DB_TAB_REACH), reach_records);
+    reaches_ = new clsReaches(reach_records, lyr_method_);
+    reaches_->Update(init_params_, mask_raster_);
+
+    /// 7. Scenario is not supported yet
+    if (scenario_id_ >= 0) {
+        LOG(WARNING) << "BMPs scenario is not supported by local data, scenario "
+                << scenario_id_ << " is ignored!";
+    }
+    return true;
+}
+
+bool DataCenterLocal::GetFileInStringVector() {
+    if (file_in_strs_.empty()) {
+        vector<STRING_MAP> records;
+        if (!ReadLocalRecords(TableFilename(DB_TAB_FILE_IN), records)) {
+            LOG(ERROR) << "Nothing found in " << TableFilename(DB_TAB_FILE_IN) << ".";
+            return false;
+        }
+        for (auto it = records.begin(); it != records.end(); ++it) {
+            string tag = GetField(*it, Tag_ConfTag);
+            string value = GetField(*it, Tag_ConfValue);
+            if (StringMatch(tag, Tag_Mode)) {
+                model_mode_ = value;
+            }
+            file_in_strs_.emplace_back(tag + "|" + value); // keep the interface consistent
+        }
+    }
+    for (auto it = file_in_strs_.begin(); it != file_in_strs_.end(); ++it) {
+        CLOG(TRACE, LOG_INIT) << "FILE_IN Info: " << *it;
+    }
+    return !file_in_strs_.empty();
+}
+
+bool DataCenterLocal::GetFileOutVector() {
+    if (!origin_out_items_.empty()) {
+        return true;
+    }
+    vector<STRING_MAP> records;
+    if (!ReadLocalRecords(TableFilename(DB_TAB_FILE_OUT), records)) {
+        LOG(ERROR) << "Nothing found in " << TableFilename(DB_TAB_FILE_OUT) << ".";
+        return false;
+    }
+    for (auto it = records.begin(); it != records.end(); ++it) {
+        OrgOutItem tmp_output_item;
+        GetNumericField(*it, Tag_OutputUSE, tmp_output_item.use);
+        tmp_output_item.modCls = GetField(*it, Tag_MODCLS);
+        tmp_output_item.outputID = GetField(*it, Tag_OutputID);
+        tmp_output_item.descprition = GetField(*it, Tag_OutputDESC);
+        tmp_output_item.outFileName = GetField(*it, Tag_FileName);
+        tmp_output_item.aggType = GetField(*it, Tag_AggType);
+        tmp_output_item.unit = GetField(*it, Tag_OutputUNIT);
+        tmp_output_item.subBsn = GetField(*it, Tag_OutputSubbsn);
+        string stime = GetField(*it, Tag_StartTime);
+        if (!stime.empty()) {
+            tmp_output_item.sTimet = ConvertToTime(stime, "%d-%d-%d %d:%d:%d", true);
+        }
+        string etime = GetField(*it, Tag_EndTime);
+        if (!etime.empty()) {
+            tmp_output_item.eTimet = ConvertToTime(etime, "%d-%d-%d %d:%d:%d", true);
+        }
+        GetNumericField(*it, Tag_Interval, tmp_output_item.interval);
+        tmp_output_item.intervalUnit = GetField(*it, Tag_IntervalUnit);
+        if (tmp_output_item.use > 0) {
+            origin_out_items_.emplace_back(tmp_output_item);
+        }
+    }
+    vector<OrgOutItem>(origin_out_items_).swap(origin_out_items_);
+    return !origin_out_items_.empty();
+}
+
+int DataCenterLocal::ReadIntParameterInDB(const char* param_name) {
+    if (param_records_.empty() && !ReadLocalRecords(TableFilename(DB_TAB_PARAMETERS), param_records_)) {
+        LOG(ERROR) << "ReadIntParameterInDB: " << "Nothing found for " << param_name;
+        return -9999;
+    }
+    int num_tmp = -1;
+    for (auto it = param_records_.begin(); it != param_records_.end(); ++it) {
+        if (!StringMatch(GetField(*it, PARAM_FLD_NAME), param_name)) { continue; }
+        GetNumericField(*it, PARAM_FLD_VALUE, num_tmp);
+    }
+    return num_tmp;
+}
+
+void DataCenterLocal::ReadClimateSiteList() {
+    if (input_->isStormMode()) {
+        throw ModelException("DataCenterLocal", "ReadClimateSiteList",
+                             "Storm mode is not supported by local data yet!");
+    }
+    vector<STRING_MAP> records;
+    ReadLocalRecords(TableFilename(DB_TAB_SITELIST), records);
+    for (auto it = records.begin(); it != records.end(); ++it) {
+        int subbsn_id = -1;
+        if (!GetNumericField(*it, Tag_SubbasinId, subbsn_id) || subbsn_id != subbasin_id_) { continue; }
+        if (!StringMatch(GetField(*it, Tag_Mode), input_->getModelMode())) { continue; }
+        string site_list = GetField(*it, SITELIST_TABLE_M);
+        if (!site_list.empty()) {
+            for (int i = 0; i < METEO_VARS_NUM; ++i) {
+                ReadClimateData(METEO_VARS[i], site_list);
+            }
+        }
+        site_list = GetField(*it, SITELIST_TABLE_P);
+        if (!site_list.empty()) {
+            ReadClimateData(DataType_Precipitation, site_list);
+        }
+        site_list = GetField(*it, SITELIST_TABLE_PET);
+        if (!site_list.empty()) {
+            ReadClimateData(DataType_PotentialEvapotranspiration, site_list);
+        }
+    }
+}
+
+void DataCenterLocal::ReadClimateData(const string& site_type, const string& sites_list) {
+    string filename = local_path_ + SEP + LOCAL_CLIMATE_DIR + SEP + GetUpper(site_type) + LOCAL_BINARY_EXT;
+    LocalDataFile climfile(filename);
+    if (!climfile.Valid()) {
+        throw ModelException("DataCenterLocal", "ReadClimateData", "Failed to read " + filename);
+    }
+    /// Sites stored in file, and their latitudes and elevations
+    vector<int> file_sites;
+    vector<FLTPT> file_lats;
+    vector<FLTPT> file_elevs;
+    SplitStringForValues(climfile.GetMetadata("SITES"), ',', file_sites);
+    SplitStringForValues(climfile.GetMetadata("LAT"), ',', file_lats);
+    SplitStringForValues(climfile.GetMetadata("ELEV"), ',', file_elevs);
+    int n_file_sites = CVT_INT(file_sites.size());
+    bool flag = false;
+    int n_records = CVT_INT(IsInt(climfile.GetMetadata("RECORDS"), flag));
+    time_t file_interval = CVT_TIMET(IsInt(climfile.GetMetadata("INTERVAL"), flag));
+    time_t file_start = ConvertToTime(climfile.GetMetadata(Tag_StartTime), "%d-%d-%d %d:%d:%d", true);
+    if (n_file_sites == 0 || file_lats.size() != file_sites.size() || file_elevs.size() != file_sites.size()
+        || file_interval <= 0 || CVT_VINT(n_records) * n_file_sites > climfile.GetFloatCount()) {
+        throw ModelException("DataCenterLocal", "ReadClimateData", "Invalid metadata of " + filename);
+    }
+    /// Sites required, which are in ascending order as Measurement
+    vector<int> sites;
+    SplitStringForValues(sites_list, ',', sites);
+    sort(sites.begin(), sites.end());
+    int n_sites = CVT_INT(sites.size());
+    vector<int> cols(n_sites);
+    vector<FLTPT> lats(n_sites);
+    vector<FLTPT> elevs(n_sites);
+    for (int i = 0; i < n_sites; i++) {
+        auto found = find(file_sites.begin(), file_sites.end(), sites[i]);
+        if (found == file_sites.end()) {
+            throw ModelException("DataCenterLocal", "ReadClimateData",
+                                 "Site " + ValueToString(sites[i]) + " is not existed in " + filename);
+        }
+        cols[i] = CVT_INT(distance(file_sites.begin(), found));
+        lats[i] = file_lats[cols[i]];
+        elevs[i] = file_elevs[cols[i]];
+    }
+    /// Records from the start time of simulation, the same as RegularMeasurement.
+    time_t start_time = input_->getStartTime();
+    time_t end_time = input_->getEndTime();
+    /// One record per time step of hillslope processes, which is also assumed by RegularMeasurement
+    if (file_interval != input_->getDtHillslope() || (start_time - file_start) % file_interval != 0) {
+        throw ModelException("DataCenterLocal", "ReadClimateData", "The interval of records in " + filename +
+                             " (" + ValueToString(file_interval) + " seconds since " +
+                             climfile.GetMetadata(Tag_StartTime) + ") does not match the time step of "
+                             "hillslope processes (" + ValueToString(input_->getDtHillslope()) + " seconds)");
+    }
+    int offset = CVT_INT((start_time - file_start) / file_interval);
+    if (start_time < file_start || offset >= n_records) {
+        throw ModelException("DataCenterLocal", "ReadClimateData", "No adequate data of " + site_type +
+                             " since " + ConvertToString2(start_time) + " in " + filename);
+    }
+    int n_used = CVT_INT((end_time - start_time) / input_->getDtHillslope() + 1);
+    if (offset + n_used > n_records) { n_used = n_records - offset; }
+    const float* values = climfile.GetFloats();
+    vector<FLTPT*> site_data(n_used, nullptr);
+    for (int irec = 0; irec < n_used; irec++) {
+        FLTPT* tmp_data = new FLTPT[n_sites];
+        const float* rec_values = values + CVT_VINT(offset + irec) * n_file_sites;
+        for (int i = 0; i < n_sites; i++) {
+            tmp_data[i] = rec_values[cols[i]];
+        }
+        site_data[irec] = tmp_data;
+    }
+    Measurement* m = new RegularMeasurement(sites_list, GetUpper(site_type), start_time, end_time,
+                                            input_->getDtHillslope(), site_data);
+    clim_station_->AddSitesData(site_type, m, lats, elevs);
+}
+
+bool DataCenterLocal::ReadParametersInDB() {
+    if (param_records_.empty() && !ReadLocalRecords(TableFilename(DB_TAB_PARAMETERS), param_records_)) {
+        LOG(ERROR) << "Nothing found in " << TableFilename(DB_TAB_PARAMETERS) << ".";
+        return false;
+    }
+    for (auto it = param_records_.begin(); it != param_records_.end(); ++it) {
+        string name = GetUpper(GetField(*it, PARAM_FLD_NAME));
+        FLTPT value = 0.;
+        FLTPT impact = 0.;
+        FLTPT maximum = 0.;
+        FLTPT minimum = 0.;
+        GetNumericField(*it, PARAM_FLD_VALUE, value);
+        GetNumericField(*it, PARAM_FLD_IMPACT, impact);
+        GetNumericField(*it, PARAM_FLD_MAX, maximum);
+        GetNumericField(*it, PARAM_FLD_MIN, minimum);
+        bool isint = StringMatch(GetField(*it, PARAM_FLD_DTYPE), "INT");
+        string cali_values_str = GetField(*it, PARAM_CALI_VALUES);
+        if (!cali_values_str.empty() && calibration_id_ >= 0) {
+            // Overwrite p->Impact according to calibration ID
+            vector<FLTPT> cali_values;
+            SplitStringForValues(cali_values_str, ',', cali_values);
+            if (calibration_id_ < CVT_INT(cali_values.size())) {
+                impact = cali_values[calibration_id_];
+            }
+        }
+        if (!InsertInitParameter(name, GetField(*it, PARAM_FLD_DESC), GetField(*it, PARAM_FLD_UNIT),
+                                 GetField(*it, PARAM_FLD_MIDS), value, GetField(*it, PARAM_FLD_CHANGE),
+                                 impact, maximum, minimum, isint)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+bool DataCenterLocal::ReadLocalRaster(const string& name, clsRasterData<T, int>*& raster,
+                                      const bool use_mask) {
+    LocalDataFile rsfile(SpatialFilename(name));
+    if (!rsfile.Valid()) { return false; }
+    clsRasterData<T, int>* raster_data = new clsRasterData<T, int>();
+    if (!raster_data->ReadFromStream(rsfile.GetPayload(), rsfile.GetPayloadLength(),
+                                     rsfile.GetMetadata(), name, true,
+                                     use_mask ? mask_raster_ : nullptr, true)) {
+        delete raster_data;
+        return false;
+    }
+    raster = raster_data;
+    return true;
+}
+
+bool DataCenterLocal::ReadRasterData(const string& remote_filename, FloatRaster*& flt_rst) {
+    FloatRaster* raster_data = nullptr;
+    if (!ReadLocalRaster(remote_filename, raster_data, true)) { return false; }
+#ifdef HAS_VARIADIC_TEMPLATES
+    if (!rs_map_.emplace(remote_filename, raster_data).second) {
+#else
+    if (!rs_map_.insert(make_pair(remote_filename, raster_data)).second) {
+#endif
+        delete raster_data;
+        return false;
+    }
+    flt_rst = raster_data;
+    return true;
+}
+
+bool DataCenterLocal::ReadRasterData(const string& remote_filename, IntRaster*& int_rst) {
+    IntRaster* raster_data = nullptr;
+    if (!ReadLocalRaster(remote_filename, raster_data, true)) { return false; }
+#ifdef HAS_VARIADIC_TEMPLATES
+    if (!rs_int_map_.emplace(remote_filename, raster_data).second) {
+#else
+    if (!rs_int_map_.insert(make_pair(remote_filename, raster_data)).second) {
+#endif
+        delete raster_data;
+        return false;
+    }
+    int_rst = raster_data;
+    return true;
+}
+
+void DataCenterLocal::ReadItpWeightData(const string& remote_filename, int& num, int& stations, FLTPT**& data) {
+    data = nullptr;
+    string wfilename = remote_filename;
+    if (!FileExists(SpatialFilename(wfilename))) {
+        // The same as ItpWeightData, all meteorological data share the weight of M
+        size_t index = remote_filename.find_last_of('_');
+        string type = remote_filename.substr(index + 1);
+        if (StringMatch(type, DataType_PotentialEvapotranspiration) || StringMatch(type, DataType_SolarRadiation)
+            || StringMatch(type, DataType_RelativeAirMoisture) || StringMatch(type, DataType_MeanTemperature)
+            || StringMatch(type, DataType_MaximumTemperature) || StringMatch(type, DataType_MinimumTemperature)) {
+            wfilename = remote_filename.substr(0, index + 1) + DataType_Meteorology;
+        }
+    }
+    LocalDataFile wfile(SpatialFilename(wfilename));
+    if (!wfile.Valid()) { return; }
+    bool flag1 = false;
+    bool flag2 = false;
+    num = CVT_INT(IsInt(wfile.GetMetadata(MONG_GRIDFS_WEIGHT_CELLS), flag1));
+    stations = CVT_INT(IsInt(wfile.GetMetadata(MONG_GRIDFS_WEIGHT_SITES), flag2));
+    if (!flag1 || !flag2 || num * stations > wfile.GetFloatCount()) { return; }
+    const float* values = wfile.GetFloats();
+    Initialize2DArray(num, stations, data, 0.);
+    for (int i = 0; i < num; i++) {
+        for (int j = 0; j < stations; j++) {
+            data[i][j] = values[i * stations + j];
+        }
+    }
+}
+
+void DataCenterLocal::Read1DArrayData(const string& remote_filename, int& num, FLTPT*& data) {
+    LocalDataFile arrfile(SpatialFilename(remote_filename));
+    if (!arrfile.Valid()) { return; }
+    num = arrfile.GetFloatCount();
+    Initialize1DArray(num, data, arrfile.GetFloats());
+}
+
+void DataCenterLocal::Read1DArrayData(const string& remote_filename, int& num, int*& data) {
+    LocalDataFile arrfile(SpatialFilename(remote_filename));
+    if (!arrfile.Valid()) { return; }
+    num = arrfile.GetFloatCount();
+    Initialize1DArray(num, data, arrfile.GetFloats());
+}
+
+void DataCenterLocal::Read2DArrayData(const string& remote_filename, int& rows, int& cols, FLTPT**& data) {
+    data = nullptr;
+    LocalDataFile arrfile(SpatialFilename(remote_filename));
+    if (!arrfile.Valid()) { return; }
+    if (!Initialize2DArray(arrfile.GetFloats(), rows, cols, data)) {
+        data = nullptr;
+    }
+}
+
+void DataCenterLocal::Read2DArrayData(const string& remote_filename, int& rows, int& cols, int**& data) {
+    data = nullptr;
+    LocalDataFile arrfile(SpatialFilename(remote_filename));
+    if (!arrfile.Valid()) { return; }
+    if (!Initialize2DArray(arrfile.GetFloats(), rows, cols, data)) {
+        data = nullptr;
+    }
+}
+
+void DataCenterLocal::ReadIuhData(const string& remote_filename, int& n, FLTPT**& data) {
+    data = nullptr;
+    LocalDataFile arrfile(SpatialFilename(remote_filename));
+    if (!arrfile.Valid()) { return; }
+    ParseIuhData(arrfile.GetFloats(), n, data);
+}
+
+bool DataCenterLocal::SetRasterForScenario() {
+    return false;
+}
@@ -0,0 +1,101 @@
+/*!
+ * \file DataCenterLocal.h
+ * \brief Data center for running SEIMS based on local files exported from MongoDB,
+ *        i.e., no MongoDB server is required during simulation.
+ *
+ *        The model data directory can be exported by `seims/preprocess/db_export_local.py`,
+ *        see LocalDataFile.h for the layout.
+ *
+ *        Limitations of the current version:
+ *          - BMPs scenario is not supported
+ *          - Only regular (e.g., daily) climate data is supported, i.e., the storm mode is not supported
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_DATA_CENTER_LOCAL_H
+#define SEIMS_DATA_CENTER_LOCAL_H
+
+#include "DataCenter.h"
+
+/*!
+ * \ingroup data
+ * \class DataCenterLocal
+ * \brief Class of Data center inherited from DataCenter based on local files
+ */
+class DataCenterLocal: public DataCenter {
+public:
+    /*!
+     * \brief Constructor based on local files
+     * \param[in] input_args Input arguments of SEIMS, `local_path` is required
+     * \param[in] factory SEIMS modules factory
+     * \param[in] subbasin_id Subbasin ID, 0 is the default for entire watershed
+     */
+    DataCenterLocal(InputArgs* input_args, ModuleFactory* factory, int subbasin_id = 0);
+    //! Destructor
+    ~DataCenterLocal();
+    /*!
+     * \brief Make sure all the required data are presented
+     */
+    bool CheckModelPreparedData() OVERRIDE;
+    /*!
+     * \brief Get file.in configuration from FILE_IN.tsv
+     */
+    bool GetFileInStringVector() OVERRIDE;
+    /*!
+     * \brief Get file.out configuration from FILE_OUT.tsv
+     */
+    bool GetFileOutVector() OVERRIDE;
+    /*!
+     * \brief Read climate site data from SITELIST.tsv and CLIMATE/<TYPE>.sbin
+     */
+    void ReadClimateSiteList() OVERRIDE;
+    /*!
+     * \brief Read initial and calibrated parameters from PARAMETERS.tsv
+     */
+    bool ReadParametersInDB() OVERRIDE;
+    /*!
+     * \brief Get subbasin number and outlet ID
+     */
+    int ReadIntParameterInDB(const char* param_name) OVERRIDE;
+    //! Read raster data from SPATIAL/<NAME>.sbin
+    bool ReadRasterData(const string& remote_filename, FloatRaster*& flt_rst) OVERRIDE;
+    //! Read integer raster data from SPATIAL/<NAME>.sbin
+    bool ReadRasterData(const string& remote_filename, IntRaster*& int_rst) OVERRIDE;
+    //! Read interpolated weight data
+    void ReadItpWeightData(const string& remote_filename, int& num, int& stations, FLTPT**& data) OVERRIDE;
+    //! Read 1D array data, the values are stored as float
+    void Read1DArrayData(const string& remote_filename, int& num, FLTPT*& data) OVERRIDE;
+    //! Read 1D integer array data, the values are stored as float
+    void Read1DArrayData(const string& remote_filename, int& num, int*& data) OVERRIDE;
+    //! Read 2D array data
+    void Read2DArrayData(const string& remote_filename, int& rows, int& cols, FLTPT**& data) OVERRIDE;
+    //! Read 2D integer array data
+    void Read2DArrayData(const string& remote_filename, int& rows, int& cols, int**& data) OVERRIDE;
+    //! Read IUH data
+    void ReadIuhData(const string& remote_filename, int& n, FLTPT**& data) OVERRIDE;
+    //! Scenario is not supported currently
+    bool SetRasterForScenario() OVERRIDE;
+
+    //! Local data directory
+    string GetLocalDataPath() const { return local_path_; }
+
+private:
+    //! Full path of spatial data file, i.e., SPATIAL/<NAME>.sbin
+    string SpatialFilename(const string& name) const;
+    //! Full path of table file, e.g., PARAMETERS.tsv
+    string TableFilename(const char* name) const;
+    //! Read raster from SPATIAL/<NAME>.sbin
+    template <typename T>
+    bool ReadLocalRaster(const string& name, clsRasterData<T, int>*& raster, bool use_mask);
+    //! Read regular time series of given type and sites
+    void ReadClimateData(const string& site_type, const string& sites_list);
+
+private:
+    string local_path_;                 ///< Local data directory
+    vector<STRING_MAP> param_records_;  ///< Records of PARAMETERS
+};
+
+#endif /* SEIMS_DATA_CENTER_LOCAL_H */
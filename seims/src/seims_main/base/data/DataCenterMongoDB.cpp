@@ -8,27 +8,17 @@ const char* MAIN_DB_TABS_REQ[] = {
     DB_TAB_PARAMETERS, DB_TAB_REACH, DB_TAB_SPATIAL
 };
 
-const int METEO_VARS_NUM = 6;
-const char* METEO_VARS[] = {
-    DataType_MeanTemperature, DataType_MaximumTemperature,
-    DataType_MinimumTemperature, DataType_SolarRadiation,
-    DataType_WindSpeed, DataType_RelativeAirMoisture
-};
-
-const int SOILWATER_VARS_NUM = 5;
-const char* SOILWATER_VARS[] = {
-    VAR_SOL_WPMM[0], VAR_SOL_AWC[0], VAR_SOL_UL[0],
-    VAR_SOL_SUMAWC[0], VAR_SOL_SUMSAT[0]
-};
-
 DataCenterMongoDB::DataCenterMongoDB(InputArgs* input_args, MongoClient* client,
                                      MongoGridFs* spatial_gfs_in, MongoGridFs* spatial_gfs_out,
                                      ModuleFactory* factory,
-                                     const int subbasin_id /* = 0 */) :
+                                     const int subbasin_id /* = 0 */,
+                                     SharedClimateData* shared_climate /* = nullptr */,
+                                     DataCenterCache* shared_cache /* = nullptr */) :
     DataCenter(input_args, factory, subbasin_id), mongodb_ip_(input_args->host.c_str()),
     mongodb_port_(input_args->port),
     mongo_client_(client), main_database_(nullptr),
-    spatial_gridfs_(spatial_gfs_in), spatial_gfs_out_(spatial_gfs_out) {
+    spatial_gridfs_(spatial_gfs_in), spatial_gfs_out_(spatial_gfs_out),
+    shared_climate_(shared_climate), shared_cache_(shared_cache) {
     //spatial_gridfs_ = new MongoGridFs(mongo_client_->GetGridFs(model_name_, DB_TAB_SPATIAL));
     //spatial_gfs_out_ = new MongoGridFs(mongo_client_->GetGridFs(model_name_, DB_TAB_OUT_SPATIAL));
     if (DataCenterMongoDB::GetFileInStringVector()) {
@@ -75,6 +65,11 @@ DataCenterMongoDB::~DataCenterMongoDB() {
         delete main_database_;
         main_database_ = nullptr;
     }
+    // The 2D arrays referenced from shared cache are released by the cache
+    for (auto it = shared_arrays_.begin(); it != shared_arrays_.end(); ++it) {
+        auto it_array = array2d_map_.find(*it);
+        if (it_array != array2d_map_.end()) { it_array->second = nullptr; }
+    }
 }
 
 bool DataCenterMongoDB::CheckModelPreparedData() {
@@ -97,6 +92,7 @@ bool DataCenterMongoDB::CheckModelPreparedData() {
     }
     /// 3. Read climate site information from Climate database
     clim_station_ = new InputStation(mongo_client_, input_->getDtHillslope(), input_->getDtChannel());
+    clim_station_->SetSharedData(shared_climate_);
     ReadClimateSiteList();
 
     /// 4. Read initial parameters
@@ -163,36 +159,47 @@ string DataCenterMongoDB::QueryDatabaseName(bson_t* query, const char* tabname)
     return dbname;
 }
 
+bool DataCenterMongoDB::ReadFileInStrings(MongoClient* client, const string& model_name,
+                                          vector<string>& file_in_strs) {
+    bson_t* b = bson_new();
+    std::unique_ptr<MongoCollection>
+            collection(new MongoCollection(client->GetCollection(model_name, DB_TAB_FILE_IN)));
+    mongoc_cursor_t* cursor = collection->ExecuteQuery(b);
+    bson_error_t err;
+    if (mongoc_cursor_error(cursor, &err)) {
+        LOG(ERROR) << "Nothing found in the collection: " << DB_TAB_FILE_IN << ".";
+        return false;
+    }
+    bson_iter_t it;
+    const bson_t* bson_table;
+    while (mongoc_cursor_more(cursor) && mongoc_cursor_next(cursor, &bson_table)) {
+        vector<string> tokens(2);
+        if (bson_iter_init_find(&it, bson_table, Tag_ConfTag)) {
+            tokens[0] = GetStringFromBsonIterator(&it);
+        }
+        if (bson_iter_init_find(&it, bson_table, Tag_ConfValue)) {
+            tokens[1] = GetStringFromBsonIterator(&it);
+        }
+        size_t sz = file_in_strs.size();                // get the current number of rows
+        file_in_strs.resize(sz + 1);                    // resize with one more row
+        file_in_strs[sz] = tokens[0] + "|" + tokens[1]; // keep the interface consistent
+    }
+    bson_destroy(b);
+    mongoc_cursor_destroy(cursor);
+    return true;
+}
+
 bool DataCenterMongoDB::GetFileInStringVector() {
     if (file_in_strs_.empty()) {
-        bson_t* b = bson_new();
-        std::unique_ptr<MongoCollection>
-                collection(new MongoCollection(mongo_client_->GetCollection(model_name_, DB_TAB_FILE_IN)));
-        mongoc_cursor_t* cursor = collection->ExecuteQuery(b);
-        bson_error_t err;
-        if (mongoc_cursor_error(cursor, &err)) {
-            LOG(ERROR) << "Nothing found in the collection: " << DB_TAB_FILE_IN << ".";
+        if (!ReadFileInStrings(mongo_client_, model_name_, file_in_strs_)) {
             return false;
         }
-        bson_iter_t it;
-        const bson_t* bson_table;
-        while (mongoc_cursor_more(cursor) && mongoc_cursor_next(cursor, &bson_table)) {
-            vector<string> tokens(2);
-            if (bson_iter_init_find(&it, bson_table, Tag_ConfTag)) {
-                tokens[0] = GetStringFromBsonIterator(&it);
-            }
-            if (bson_iter_init_find(&it, bson_table, Tag_ConfValue)) {
-                tokens[1] = GetStringFromBsonIterator(&it);
-            }
-            if (StringMatch(tokens[0], Tag_Mode)) {
+        for (auto it = file_in_strs_.begin(); it != file_in_strs_.end(); ++it) {
+            vector<string> tokens = SplitString(*it, '|');
+            if (tokens.size() == 2 && StringMatch(tokens[0], Tag_Mode)) {
                 model_mode_ = tokens[1];
             }
-            size_t sz = file_in_strs_.size();                // get the current number of rows
-            file_in_strs_.resize(sz + 1);                    // resize with one more row
-            file_in_strs_[sz] = tokens[0] + "|" + tokens[1]; // keep the interface consistent
         }
-        bson_destroy(b);
-        mongoc_cursor_destroy(cursor);
     }
     if (!file_in_strs_.empty()) {
         for (auto it = file_in_strs_.begin(); it != file_in_strs_.end(); ++it) {
@@ -301,52 +308,130 @@ int DataCenterMongoDB::ReadIntParameterInDB(const char* param_name) {
 }
 
 void DataCenterMongoDB::ReadClimateSiteList() {
-//    bson_t* query = bson_new();
-//    BSON_APPEND_INT32(query, Tag_SubbasinId, subbasin_id_); // subbasin id
-//    BSON_APPEND_UTF8(query, Tag_Mode, input_->getModelMode().c_str()); // mode
+    if (nullptr == shared_cache_) {
+        clim_dbname_ = ReadClimateSites(mongo_client_, model_name_, subbasin_id_, input_, clim_station_);
+        return;
+    }
+    // Site lists of all subbasins are queried once and cached
+    const vector<ClimateSiteList>* lists = nullptr;
+    if (!shared_cache_->GetSiteLists(model_name_, input_->getModelMode(), subbasin_id_, lists)) {
+        map<int, vector<ClimateSiteList> > all_lists;
+        QueryClimateSiteLists(mongo_client_, model_name_, input_->getModelMode(), -1, all_lists);
+        shared_cache_->AddSiteLists(model_name_, input_->getModelMode(), all_lists);
+        shared_cache_->GetSiteLists(model_name_, input_->getModelMode(), subbasin_id_, lists);
+    }
+    if (nullptr == lists) {
+        clim_dbname_ = "";
+        return;
+    }
+    clim_dbname_ = ReadClimateSites(*lists, input_, clim_station_);
+}
+
+string DataCenterMongoDB::ReadClimateSites(MongoClient* client, const string& model_name, const int subbasin_id,
+                                           SettingsInput* input, InputStation* station,
+                                           map<string, string>* site_lists /* = nullptr */) {
+    map<int, vector<ClimateSiteList> > lists;
+    QueryClimateSiteLists(client, model_name, input->getModelMode(), subbasin_id, lists);
+    if (lists.find(subbasin_id) == lists.end()) { return ""; }
+    return ReadClimateSites(lists.at(subbasin_id), input, station, site_lists);
+}
 
-    bson_t* query = BCON_NEW(Tag_SubbasinId, BCON_INT32(subbasin_id_),
-                             Tag_Mode, BCON_UTF8(input_->getModelMode().c_str()));
+void DataCenterMongoDB::QueryClimateSiteLists(MongoClient* client, const string& model_name,
+                                              const string& model_mode, const int subbasin_id,
+                                              map<int, vector<ClimateSiteList> >& lists) {
+    bson_t* query = nullptr;
+    if (subbasin_id >= 0) {
+        query = BCON_NEW(Tag_SubbasinId, BCON_INT32(subbasin_id), Tag_Mode, BCON_UTF8(model_mode.c_str()));
+    } else {
+        query = BCON_NEW(Tag_Mode, BCON_UTF8(model_mode.c_str()));
+    }
     CLOG(TRACE, LOG_INIT) << "ReadClimateSiteList: " << bson_as_json(query, NULL);
-    std::unique_ptr<MongoCollection> collection(new MongoCollection(mongo_client_->GetCollection(model_name_,
+    std::unique_ptr<MongoCollection> collection(new MongoCollection(client->GetCollection(model_name,
                                                                         DB_TAB_SITELIST)));
     mongoc_cursor_t* cursor = collection->ExecuteQuery(query);
 
     const bson_t* doc;
     while (mongoc_cursor_next(cursor, &doc)) {
         bson_iter_t iter;
+        ClimateSiteList site_list;
+        int id = subbasin_id;
+        if (bson_iter_init(&iter, doc) && bson_iter_find(&iter, Tag_SubbasinId)) {
+            GetNumericFromBsonIterator(&iter, id);
+        }
         if (bson_iter_init(&iter, doc) && bson_iter_find(&iter, MONG_SITELIST_DB)) {
-            clim_dbname_ = GetStringFromBsonIterator(&iter);
+            site_list.clim_dbname = GetStringFromBsonIterator(&iter);
         } else {
+            bson_destroy(query);
+            mongoc_cursor_destroy(cursor);
             throw ModelException("DataCenterMongoDB", "ReadClimateSiteList",
                                  "The DB field does not exist in SiteList table.");
         }
-        string site_list;
         if (bson_iter_init(&iter, doc) && bson_iter_find(&iter, SITELIST_TABLE_M)) {
-            site_list = GetStringFromBsonIterator(&iter);
-            for (int i = 0; i < METEO_VARS_NUM; ++i) {
-                clim_station_->ReadSitesData(clim_dbname_, site_list, METEO_VARS[i],
-                                             input_->getStartTime(), input_->getEndTime(), input_->isStormMode());
-            }
+            site_list.meteo_sites = GetStringFromBsonIterator(&iter);
         }
-
         if (bson_iter_init(&iter, doc) && bson_iter_find(&iter, SITELIST_TABLE_P)) {
-            site_list = GetStringFromBsonIterator(&iter);
-            clim_station_->ReadSitesData(clim_dbname_, site_list, DataType_Precipitation,
-                                         input_->getStartTime(), input_->getEndTime(), input_->isStormMode());
+            site_list.pcp_sites = GetStringFromBsonIterator(&iter);
         }
-
         if (bson_iter_init(&iter, doc) && bson_iter_find(&iter, SITELIST_TABLE_PET)) {
-            site_list = GetStringFromBsonIterator(&iter);
-            clim_station_->ReadSitesData(clim_dbname_, site_list, DataType_PotentialEvapotranspiration,
-                                         input_->getStartTime(), input_->getEndTime(), input_->isStormMode());
+            site_list.pet_sites = GetStringFromBsonIterator(&iter);
         }
+        lists[id].push_back(site_list);
     }
     bson_destroy(query);
     mongoc_cursor_destroy(cursor);
 }
 
+string DataCenterMongoDB::ReadClimateSites(const vector<ClimateSiteList>& lists, SettingsInput* input,
+                                           InputStation* station,
+                                           map<string, string>* site_lists /* = nullptr */) {
+    string clim_dbname;
+    for (auto it = lists.begin(); it != lists.end(); ++it) {
+        clim_dbname = it->clim_dbname;
+        if (!it->meteo_sites.empty()) {
+            for (int i = 0; i < METEO_VARS_NUM; ++i) {
+                station->ReadSitesData(clim_dbname, it->meteo_sites, METEO_VARS[i],
+                                       input->getStartTime(), input->getEndTime(), input->isStormMode());
+                if (nullptr != site_lists) { (*site_lists)[METEO_VARS[i]] = it->meteo_sites; }
+            }
+        }
+        if (!it->pcp_sites.empty()) {
+            station->ReadSitesData(clim_dbname, it->pcp_sites, DataType_Precipitation,
+                                   input->getStartTime(), input->getEndTime(), input->isStormMode());
+            if (nullptr != site_lists) { (*site_lists)[DataType_Precipitation] = it->pcp_sites; }
+        }
+        if (!it->pet_sites.empty()) {
+            station->ReadSitesData(clim_dbname, it->pet_sites, DataType_PotentialEvapotranspiration,
+                                   input->getStartTime(), input->getEndTime(), input->isStormMode());
+            if (nullptr != site_lists) { (*site_lists)[DataType_PotentialEvapotranspiration] = it->pet_sites; }
+        }
+    }
+    return clim_dbname;
+}
+
 bool DataCenterMongoDB::ReadParametersInDB() {
+    const vector<InitParamRecord>* records = nullptr;
+    vector<InitParamRecord> queried;
+    if (nullptr != shared_cache_) {
+        records = shared_cache_->GetParameters(model_name_, calibration_id_);
+    }
+    if (nullptr == records) {
+        if (!QueryParametersInDB(queried)) { return false; }
+        records = &queried;
+        if (nullptr != shared_cache_) {
+            records = shared_cache_->AddParameters(model_name_, calibration_id_, queried);
+        }
+    }
+    for (auto it = records->begin(); it != records->end(); ++it) {
+        if (!InsertInitParameter(it->name, it->desc, it->unit, it->module, it->value, it->change,
+                                 it->impact, it->maximum, it->minimum, it->isint)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DataCenterMongoDB::QueryParametersInDB(vector<InitParamRecord>& records) {
+    records.clear();
     bson_t* filter = bson_new();
     std::unique_ptr<MongoCollection>
             collection(new MongoCollection(mongo_client_->GetCollection(model_name_, DB_TAB_PARAMETERS)));
@@ -413,44 +498,18 @@ bool DataCenterMongoDB::ReadParametersInDB() {
                 impact = cali_values[calibration_id_];
             }
         }
-        if (isint) {
-            ParamInfo<int>* intp = new ParamInfo<int>(name, desc, unit, module, CVT_INT(value),
-                                                      change, CVT_INT(impact), CVT_INT(maximum),
-                                                      CVT_INT(minimum), isint);
-#ifdef HAS_VARIADIC_TEMPLATES
-            if (!init_params_int_.emplace(name, intp).second) {
-#else
-            if (!init_params_int_.insert(make_pair(name, intp)).second) {
-#endif
-                LOG(ERROR) << "Load parameter: " << name << " failed!";
-                return false;
-            }
-        }
-        else {
-            ParamInfo<FLTPT>* p = new ParamInfo<FLTPT>(name, desc, unit, module, value,
-                                                       change, impact, maximum, minimum, isint);
-#ifdef HAS_VARIADIC_TEMPLATES
-            if (!init_params_.emplace(name, p).second) {
-#else
-            if (!init_params_.insert(make_pair(name, p)).second) {
-#endif
-                LOG(ERROR) << "Load parameter: " << name << " failed!";
-                return false;
-            }
-            /// Special handling code for soil water capcity parameters
-            /// e.g., SOL_AWC, SOL_UL, WILTINGPOINT. By ljzhu, 2018-1-11
-            if (StringMatch(name, VAR_SW_CAP[0])) {
-                for (int si = 0; si < SOILWATER_VARS_NUM; si++) {
-                    ParamInfo<FLTPT>* tmpp = new ParamInfo<FLTPT>(*p);
-                    tmpp->Name = SOILWATER_VARS[si];
-#ifdef HAS_VARIADIC_TEMPLATES
-                    init_params_.emplace(GetUpper(tmpp->Name), tmpp);
-#else
-                    init_params_.insert(make_pair(GetUpper(tmpp->Name), tmpp));
-#endif
-                }
-            }
-        }
+        InitParamRecord record;
+        record.name = name;
+        record.desc = desc;
+        record.unit = unit;
+        record.module = module;
+        record.value = value;
+        record.change = change;
+        record.impact = impact;
+        record.maximum = maximum;
+        record.minimum = minimum;
+        record.isint = isint;
+        records.push_back(record);
     }
     bson_destroy(filter);
     mongoc_cursor_destroy(cursor);
@@ -547,6 +606,14 @@ void DataCenterMongoDB::Read1DArrayData(const string& remote_filename, int& num,
 }
 
 void DataCenterMongoDB::Read2DArrayData(const string& remote_filename, int& rows, int& cols, FLTPT**& data) {
+    /// Lookup tables, which are the same for all subbasins, are cached unless adjusted by calibration
+    string upper_name = GetUpper(remote_filename);
+    bool cached = nullptr != shared_cache_ && upper_name.find("LOOKUP") != string::npos
+            && !CheckAdjustment(upper_name);
+    if (cached && shared_cache_->Get2DArray(remote_filename, calibration_id_, rows, cols, data)) {
+        shared_arrays_.push_back(remote_filename);
+        return;
+    }
     char* databuf = nullptr;
     vint datalength;
     spatial_gridfs_->GetStreamData(remote_filename, databuf, datalength);
@@ -560,6 +627,10 @@ void DataCenterMongoDB::Read2DArrayData(const string& remote_filename, int& rows
     }
     Release1DArray(float_values);
     databuf = nullptr;
+    if (cached && nullptr != data) {
+        shared_cache_->Add2DArray(remote_filename, calibration_id_, rows, cols, data);
+        shared_arrays_.push_back(remote_filename);
+    }
 }
 
 void DataCenterMongoDB::Read2DArrayData(const string& remote_filename, int& rows, int& cols, int**& data) {
@@ -587,46 +658,7 @@ void DataCenterMongoDB::ReadIuhData(const string& remote_filename, int& n, FLTPT
         return;
     }
     float* float_values = reinterpret_cast<float*>(databuf); // deprecate C-style: (float *) databuf;
-    // Previous code, which will cause memory leak.
-    // n = CVT_INT(float_values[0]);
-    // data = new FLTPT*[n];
-    // int index = 1;
-    // for (int i = 0; i < n; i++) {
-    //     int n_sub = CVT_INT(float_values[index + 1] - float_values[index] + 3);
-    //     data[i] = new FLTPT[n_sub];
-    //
-    //     data[i][0] = float_values[index];
-    //     data[i][1] = float_values[index + 1];
-    //     for (int j = 2; j < n_sub; j++) {
-    //         data[i][j] = float_values[index + j];
-    //     }
-    //     index = index + n_sub;
-    // }
-
-    // Customize code according to Initialize2DArray. LJ, 2022-08-23
-    int idx = 0;
-    n = CVT_INT(float_values[idx++]);
-    data = new(nothrow) FLTPT * [n];
-    FLTPT* pool = nullptr;
-    // Get actual data length of init_data, excluding the first element which is 'rows'
-    int* cols = new int[n];
-    int max_cols = -1;
-    for (int i = 0; i < n; i++) {
-        cols[i] = CVT_INT(float_values[idx + 1] - float_values[idx] + 3);
-        idx += cols[i];
-        if (cols[i] > max_cols) { max_cols = cols[i]; }
-    }
-    int length = idx - 1;
-    // New a 1d array to store data
-    Initialize1DArray(length, pool, float_values + 1);
-    // Now point the row pointers to the appropriate positions in the data pool
-    int pos = 0;
-    for (int i = 0; i < n; ++i) {
-        data[i] = pool + pos;
-        pos += cols[i];
-    }
-    delete[] cols;
-
+    ParseIuhData(float_values, n, data);
     Release1DArray(float_values);
     databuf = nullptr;
 }
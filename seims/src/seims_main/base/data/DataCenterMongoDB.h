@@ -6,6 +6,9 @@
  * Changelog:
  *   - 1. 2017-05-30 - lj - Initial implementation.
  *   - 2. 2021-04-06 - lj - Compatible with different flow direction algorithms.
+ *   - 3. 2026-10-19 - lj - Move common functions to DataCenter, shared with DataCenterLocal.
+ *   - 4. 2026-10-19 - lj - Reference HydroClimate data shared by data centers, e.g., of MPI ranks.
+ *   - 5. 2026-10-19 - lj - Reference parameters, site lists, and lookup tables cached by DataCenterCache.
  *
  *
  * \author Liangjun Zhu
@@ -14,6 +17,8 @@
 #define SEIMS_DATA_CENTER_MONGODB_H
 
 #include "DataCenter.h"
+#include "SharedClimateData.h"
+#include "DataCenterCache.h"
 
 /*!
  * \ingroup data
@@ -31,10 +36,16 @@ public:
      * \param[in] spatial_gfs_out MongoDB GridFS that stores output data
      * \param[in] factory SEIMS modules factory
      * \param[in] subbasin_id Subbasin ID, 0 is the default for entire watershed
+     * \param[in] shared_climate HydroClimate data shared by data centers, e.g., in node-level
+     *                           shared memory of the MPI version, nullptr by default
+     * \param[in] shared_cache Query results shared by the data centers of current process, e.g.,
+     *                         of the subbasins of one MPI rank, nullptr by default
      */
     DataCenterMongoDB(InputArgs* input_args, MongoClient* client,
                       MongoGridFs* spatial_gfs_in, MongoGridFs* spatial_gfs_out,
-                      ModuleFactory* factory, int subbasin_id = 0);
+                      ModuleFactory* factory, int subbasin_id = 0,
+                      SharedClimateData* shared_climate = nullptr,
+                      DataCenterCache* shared_cache = nullptr);
     //! Destructor
     ~DataCenterMongoDB();
     /*!
@@ -102,7 +113,8 @@ public:
      */
     void Read1DArrayData(const string& remote_filename, int& num, int*& data) OVERRIDE;
     /*!
-     * \brief Read 2D array data from MongoDB database
+     * \brief Read 2D array data from MongoDB database.
+     *        The lookup tables are referenced from DataCenterCache if available.
      * \param[in] remote_filename \a string data file name
      * \param[out] rows \a int&, first dimension of the 2D Array, i.e., Rows
      * \param[out] cols \a int&, second dimension of the 2D Array, i.e., Cols. If each col are different, set cols to 1.
@@ -130,6 +142,53 @@ public:
      * \brief Query database name
      */
     string QueryDatabaseName(bson_t* query, const char* tabname);
+    /*!
+     * \brief Read FILE_IN configuration from the main model database
+     * \param[in] client MongoDB client
+     * \param[in] model_name Main model database name
+     * \param[out] file_in_strs Configuration items formatted as `TAG|VALUE`
+     * \return False if query failed
+     */
+    static bool ReadFileInStrings(MongoClient* client, const string& model_name, vector<string>& file_in_strs);
+    /*!
+     * \brief Read climate site data of subbasin from HydroClimate database into InputStation
+     * \param[in] client MongoDB client
+     * \param[in] model_name Main model database name
+     * \param[in] subbasin_id Subbasin ID, 0 for the entire watershed
+     * \param[in] input Input settings
+     * \param[out] station Climate station to store site data
+     * \param[out] site_lists Site list string of each data type if not nullptr
+     * \return HydroClimate database name
+     */
+    static string ReadClimateSites(MongoClient* client, const string& model_name, int subbasin_id,
+                                   SettingsInput* input, InputStation* station,
+                                   map<string, string>* site_lists = nullptr);
+    /*!
+     * \brief Query site lists of subbasins from SITELIST collection
+     * \param[in] client MongoDB client
+     * \param[in] model_name Main model database name
+     * \param[in] model_mode Model mode, i.e., Daily or Storm
+     * \param[in] subbasin_id Subbasin ID, -1 for all subbasins
+     * \param[out] lists Site lists of each subbasin
+     */
+    static void QueryClimateSiteLists(MongoClient* client, const string& model_name, const string& model_mode,
+                                      int subbasin_id, map<int, vector<ClimateSiteList> >& lists);
+    /*!
+     * \brief Read climate site data of the site lists into InputStation
+     * \param[in] lists Site lists of the subbasin
+     * \param[in] input Input settings
+     * \param[out] station Climate station to store site data
+     * \param[out] site_lists Site list string of each data type if not nullptr
+     * \return HydroClimate database name
+     */
+    static string ReadClimateSites(const vector<ClimateSiteList>& lists, SettingsInput* input,
+                                   InputStation* station, map<string, string>* site_lists = nullptr);
+    /*!
+     * \brief Query initial and calibrated parameters from PARAMETERS collection
+     * \param[out] records Parameters
+     * \return False if query failed
+     */
+    bool QueryParametersInDB(vector<InitParamRecord>& records);
 public:
     /**** Accessors: Set and Get *****/
 
@@ -140,7 +199,7 @@ public:
     MongoClient* GetMongoClient() const { return mongo_client_; }
     MongoDatabase* GetMainDatabase() const { return main_database_; }
     MongoGridFs* GetMongoGridFs() const { return spatial_gridfs_; }
-    MongoGridFs* GetMongoGridFsOutput() const { return spatial_gfs_out_; }
+    MongoGridFs* GetMongoGridFsOutput() const OVERRIDE { return spatial_gfs_out_; }
 private:
     const char* mongodb_ip_;       ///< Host IP address of MongoDB
     const uint16_t mongodb_port_;  ///< Port
@@ -150,5 +209,8 @@ private:
     MongoDatabase* main_database_; ///< Main model database
     MongoGridFs* spatial_gridfs_;  ///< Spatial data handler
     MongoGridFs* spatial_gfs_out_; ///< Spatial data handler
+    SharedClimateData* shared_climate_; ///< HydroClimate data shared by data centers, not owned
+    DataCenterCache* shared_cache_;     ///< Query results shared by data centers, not owned
+    vector<string> shared_arrays_;      ///< 2D arrays referenced from shared_cache_, not released
 };
 #endif /* SEIMS_DATA_CENTER_MONGODB_H */
@@ -1,5 +1,6 @@
 #include "InputStation.h"
 
+#include <algorithm>
 #include <sstream>
 #include <memory>
 
@@ -12,7 +13,7 @@
 using namespace utils_string;
 
 InputStation::InputStation(MongoClient* conn, const time_t dtHillslope, const time_t dtChannel) :
-    m_conn(conn), m_dtCh(dtChannel), m_dtHs(dtHillslope) {
+    m_conn(conn), m_dtCh(dtChannel), m_dtHs(dtHillslope), m_shared(nullptr) {
 }
 
 InputStation::~InputStation() {
@@ -145,6 +146,9 @@ void InputStation::ReadSitesInfo(const string& siteType, const string& hydroDBNa
 
 void InputStation::ReadSitesData(const string& hydroDBName, const string& sitesList, const string& siteType,
                                  const time_t startDate, const time_t endDate, const bool stormMode /* = false */) {
+    if (!stormMode && ReadSharedSitesData(hydroDBName, sitesList, siteType, startDate, endDate)) {
+        return;
+    }
     string siteTypeU = GetUpper(siteType);
     if (stormMode) {
         m_measurement[siteType] = new NotRegularMeasurement(m_conn, hydroDBName, sitesList, siteTypeU,
@@ -160,6 +164,92 @@ void InputStation::ReadSitesData(const string& hydroDBName, const string& sitesL
     }
 }
 
+bool InputStation::ReadSharedSitesData(const string& hydroDBName, const string& sitesList,
+                                       const string& siteType, const time_t startDate, const time_t endDate) {
+    if (nullptr == m_shared || !StringMatch(hydroDBName, m_shared->GetClimateDBName())) { return false; }
+    const SharedSiteSeries* series = m_shared->GetSeries(siteType);
+    if (nullptr == series || series->interval != m_dtHs || startDate < series->start_time ||
+        (startDate - series->start_time) % m_dtHs != 0) {
+        return false;
+    }
+    int first = CVT_INT((startDate - series->start_time) / m_dtHs);
+    int nRecords = CVT_INT((endDate - startDate) / m_dtHs + 1);
+    if (first + nRecords > series->n_records) { return false; }
+    // Columns of sites in ascending order, the same as Measurement
+    vector<int> siteIDs;
+    SplitStringForValues(sitesList, ',', siteIDs);
+    vector<int> sortedIDs(siteIDs);
+    sort(sortedIDs.begin(), sortedIDs.end());
+    vector<int> columns;
+    columns.reserve(sortedIDs.size());
+    for (auto it = sortedIDs.begin(); it != sortedIDs.end(); ++it) {
+        auto found = std::lower_bound(series->site_ids.begin(), series->site_ids.end(), *it);
+        if (found == series->site_ids.end() || *found != *it) { return false; }
+        columns.emplace_back(CVT_INT(found - series->site_ids.begin()));
+    }
+    // Sites information in the order of site list, the same as ReadSitesInfo
+    string infoType;
+    if (StringMatch(siteType, DataType_Precipitation)) {
+        infoType = DataType_Precipitation;
+    } else if (m_elevation.find(DataType_Meteorology) == m_elevation.end()) {
+        infoType = DataType_Meteorology;
+    }
+    vector<FLTPT> siteLats;
+    vector<FLTPT> siteElevs;
+    if (!infoType.empty()) {
+        const SharedSiteInfo* info = m_shared->GetSiteInfo(infoType);
+        if (nullptr == info) { return false; }
+        for (auto it = siteIDs.begin(); it != siteIDs.end(); ++it) {
+            auto found = find(info->site_ids.begin(), info->site_ids.end(), *it);
+            if (found == info->site_ids.end()) { return false; }
+            size_t idx = found - info->site_ids.begin();
+            siteLats.emplace_back(info->lats[idx]);
+            siteElevs.emplace_back(info->elevs[idx]);
+        }
+    }
+    int stride = CVT_INT(series->site_ids.size());
+    m_measurement[siteType] = new RegularMeasurement(sitesList, GetUpper(siteType), startDate, endDate, m_dtHs,
+                                                     series->values + static_cast<size_t>(first) * stride,
+                                                     stride, columns);
+    if (!infoType.empty()) {
+        SetSitesInfo(infoType, siteLats, siteElevs);
+    }
+    CLOG(TRACE, LOG_INIT) << "Reference shared data of " << siteType << " for sites: " << sitesList;
+    return true;
+}
+
+void InputStation::AddSitesData(const string& siteType, Measurement* measurement,
+                                const vector<FLTPT>& siteLats, const vector<FLTPT>& siteElevs) {
+    if (m_measurement.find(siteType) != m_measurement.end()) { delete m_measurement.at(siteType); }
+    m_measurement[siteType] = measurement;
+    // The same as ReadSitesData
+    if (StringMatch(siteType, DataType_Precipitation)) {
+        SetSitesInfo(DataType_Precipitation, siteLats, siteElevs);
+    } else if (m_elevation.find(DataType_Meteorology) == m_elevation.end()) {
+        SetSitesInfo(DataType_Meteorology, siteLats, siteElevs);
+    }
+}
+
+void InputStation::SetSitesInfo(const string& siteType, const vector<FLTPT>& siteLats,
+                                const vector<FLTPT>& siteElevs) {
+    int nSites = CVT_INT(siteLats.size());
+    if (nSites == 0 || siteElevs.size() != siteLats.size()) {
+        throw ModelException("InputStation", "SetSitesInfo",
+                             "Latitudes and elevations of sites are mismatched.");
+    }
+    FLTPT* pEle = new FLTPT[nSites];
+    FLTPT* pLat = new FLTPT[nSites];
+    for (int i = 0; i < nSites; i++) {
+        pLat[i] = siteLats[i];
+        pEle[i] = siteElevs[i];
+    }
+    if (m_elevation.find(siteType) != m_elevation.end()) { delete[] m_elevation.at(siteType); }
+    if (m_latitude.find(siteType) != m_latitude.end()) { delete[] m_latitude.at(siteType); }
+    m_elevation[siteType] = pEle;
+    m_latitude[siteType] = pLat;
+    m_numSites[siteType] = nSites;
+}
+
 bool InputStation::NumberOfSites(const char* site_type, int& site_count) {
     if (m_numSites.find(site_type) != m_numSites.end()) {
         site_count = m_numSites.at(site_type);
@@ -190,7 +280,13 @@ bool InputStation::GetLatitude(const char* site_type, FLTPT*& site_lats) {
 
 
 void InputStation::GetTimeSeriesData(const time_t time, const string& type, int* nRow, FLTPT** data) {
-    Measurement* m = m_measurement[type];
+    auto it = m_measurement.find(type);
+    if (it == m_measurement.end() || nullptr == it->second) {
+        *nRow = 0;
+        *data = nullptr;
+        return;
+    }
+    Measurement* m = it->second;
     *nRow = m->NumberOfSites();
     //cout << type << "\t" << *nRow << endl;
     *data = m->GetSiteDataByTime(time);
@@ -2,8 +2,12 @@
  * \file InputStation.h
  * \brief HydroClimate site information
  * \author Junzhi Liu, LiangJun Zhu
- * \version 1.2
+ * \version 1.3
  * \date Aug., 2022
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Reference regular time series stored in SharedClimateData if available.
+ *   - 2. 2026-10-19 - lj - Return empty time series data of the data type not loaded.
  */
 #ifndef SEIMS_CLIMATE_STATION_H
 #define SEIMS_CLIMATE_STATION_H
@@ -14,6 +18,7 @@
 #include "db_mongoc.h"
 
 #include "Measurement.h"
+#include "SharedClimateData.h"
 #include <seims.h>
 
 using namespace ccgl;
@@ -47,8 +52,8 @@ public:
      *
      * \param[in] time data time
      * \param[in] type data type
-     * \param[out] nRow data item number
-     * \param[out] data time series data
+     * \param[out] nRow data item number, 0 if the data type is not loaded
+     * \param[out] data time series data, nullptr if the data type is not loaded
      */
     void GetTimeSeriesData(time_t time, const string& type, int* nRow, FLTPT** data);
 
@@ -64,8 +69,34 @@ public:
      */
     void ReadSitesData(const string& hydroDBName, const string& sitesList, const string& siteType,
                        time_t startDate, time_t endDate, bool stormMode = false);
+    /*!
+     * \brief Add data of each site type which is read from other sources, e.g., local files
+     *
+     * \param[in] siteType site type
+     * \param[in] measurement \a Measurement instance, which will be released by InputStation
+     * \param[in] siteLats latitudes of sites, in ascending order of site IDs
+     * \param[in] siteElevs elevations of sites, in ascending order of site IDs
+     */
+    void AddSitesData(const string& siteType, Measurement* measurement,
+                      const vector<FLTPT>& siteLats, const vector<FLTPT>& siteElevs);
+
+    /*!
+     * \brief Set the HydroClimate data shared by data centers, which will be referenced
+     *        by ReadSitesData() instead of reading from MongoDB if all the required data are included
+     *
+     * \param[in] shared \a SharedClimateData instance, not owned by InputStation
+     */
+    void SetSharedData(SharedClimateData* shared) { m_shared = shared; }
 
 private:
+    /*!
+     * \brief Reference data of each site type from shared data, the same as ReadSitesData
+     *
+     * \return false if the shared data do not include all the required data
+     */
+    bool ReadSharedSitesData(const string& hydroDBName, const string& sitesList, const string& siteType,
+                             time_t startDate, time_t endDate);
+
     /*!
      * \brief build BSON query sentences for MongoDB
      *
@@ -76,6 +107,8 @@ private:
      */
     void build_query_bson(int nSites, const vector<int>& siteIDList, const string& siteType, bson_t* query);
 
+    //! Set sites information of given site type
+    void SetSitesInfo(const string& siteType, const vector<FLTPT>& siteLats, const vector<FLTPT>& siteElevs);
     /*!
      * \brief Read HydroClimate sites information from HydroClimateDB (MongoDB)
      *
@@ -100,5 +133,7 @@ private:
     map<string, FLTPT*> m_latitude;
     //! site numbers of each site type
     map<string, int> m_numSites;
+    //! HydroClimate data shared by data centers, nullptr by default
+    SharedClimateData* m_shared;
 };
 #endif /* SEIMS_CLIMATE_STATION_H */
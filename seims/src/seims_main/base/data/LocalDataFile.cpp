@@ -0,0 +1,189 @@
+#include "LocalDataFile.h"
+
+#include <fstream>
+
+#ifndef WINDOWS
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif /* not WINDOWS */
+
+#include "utils_string.h"
+
+using namespace utils_string;
+
+namespace {
+const char LOCAL_MAGIC[8] = {'S', 'E', 'I', 'M', 'S', 'B', 'I', 'N'};
+const vint LOCAL_HEADER_SIZE = 16; // magic, version, and metadata length
+
+void ParseKeyValueLine(const string& line, STRING_MAP& kvs) {
+    size_t pos = line.find('=');
+    if (pos == string::npos || pos == 0) { return; }
+    string key = line.substr(0, pos);
+    string value = line.substr(pos + 1);
+    kvs[GetUpper(Trim(key))] = Trim(value);
+}
+} /* namespace */
+
+LocalDataFile::LocalDataFile(const string& filename) :
+    base_(nullptr), length_(0), mapped_(false), payload_(nullptr), payload_length_(0) {
+#ifndef WINDOWS
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) { return; }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > LOCAL_HEADER_SIZE) {
+        void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            base_ = static_cast<char*>(addr);
+            length_ = CVT_VINT(st.st_size);
+            mapped_ = true;
+        }
+    }
+    close(fd); // The mapping is still valid after the file descriptor closed
+#else
+    std::ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    if (!ifs.is_open()) { return; }
+    length_ = CVT_VINT(ifs.tellg());
+    if (length_ > LOCAL_HEADER_SIZE) {
+        base_ = new(nothrow) char[length_];
+        if (nullptr != base_) {
+            ifs.seekg(0, std::ios::beg);
+            ifs.read(base_, length_);
+        }
+    }
+    ifs.close();
+#endif /* not WINDOWS */
+    if (nullptr == base_ || !Parse()) {
+        payload_ = nullptr;
+        payload_length_ = 0;
+    }
+}
+
+LocalDataFile::~LocalDataFile() {
+    if (nullptr == base_) { return; }
+#ifndef WINDOWS
+    if (mapped_) { munmap(base_, length_); }
+#else
+    delete[] base_;
+#endif /* not WINDOWS */
+    base_ = nullptr;
+}
+
+string LocalDataFile::GetMetadata(const string& key) const {
+    auto it = metadata_.find(key);
+    if (it == metadata_.end()) { return ""; }
+    return it->second;
+}
+
+bool LocalDataFile::Parse() {
+    if (memcmp(base_, LOCAL_MAGIC, sizeof LOCAL_MAGIC) != 0) { return false; }
+    vint32_t version = 0;
+    vint32_t meta_length = 0;
+    memcpy(&version, base_ + 8, sizeof(vint32_t));
+    memcpy(&meta_length, base_ + 12, sizeof(vint32_t));
+    if (version != LOCAL_DATA_VERSION || meta_length < 0
+        || LOCAL_HEADER_SIZE + meta_length > length_) {
+        return false;
+    }
+    vector<string> lines = SplitString(string(base_ + LOCAL_HEADER_SIZE, meta_length), '\n');
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+        ParseKeyValueLine(*it, metadata_);
+    }
+    vint offset = LOCAL_HEADER_SIZE + meta_length;
+    offset = (offset + 7) / 8 * 8;
+    if (offset > length_) { return false; }
+    payload_ = base_ + offset;
+    payload_length_ = length_ - offset;
+    return true;
+}
+
+bool ReadLocalRecords(const string& filename, vector<STRING_MAP>& records) {
+    std::ifstream ifs(filename.c_str());
+    if (!ifs.is_open()) { return false; }
+    string line;
+    vector<string> fields;
+    while (getline(ifs, line)) {
+        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+        if (line.empty()) { continue; }
+        vector<string> values = SplitString(line, '\t');
+        if (fields.empty()) {
+            fields = values;
+            continue;
+        }
+        STRING_MAP record;
+        for (size_t i = 0; i < fields.size() && i < values.size(); i++) {
+            if (values[i].empty()) { continue; }
+            record[fields[i]] = values[i];
+        }
+        records.emplace_back(record);
+    }
+    ifs.close();
+    return !fields.empty();
+}
+
+bool ReadLocalKeyValues(const string& filename, STRING_MAP& kvs) {
+    std::ifstream ifs(filename.c_str());
+    if (!ifs.is_open()) { return false; }
+    string line;
+    while (getline(ifs, line)) {
+        if (!line.empty() && line.back() == '\r') { line.pop_back(); }
+        ParseKeyValueLine(line, kvs);
+    }
+    ifs.close();
+    return true;
+}
+
+bool WriteLocalDataFile(const string& filename, const STRING_MAP& metadata,
+                        const char* payload, const vint length) {
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) { return false; }
+    string meta;
+    for (auto it = metadata.begin(); it != metadata.end(); ++it) {
+        meta += it->first + "=" + it->second + "\n";
+    }
+    vint32_t version = LOCAL_DATA_VERSION;
+    vint32_t meta_length = CVT_INT(meta.size());
+    ofs.write(LOCAL_MAGIC, sizeof LOCAL_MAGIC);
+    ofs.write(reinterpret_cast<const char*>(&version), sizeof(vint32_t));
+    ofs.write(reinterpret_cast<const char*>(&meta_length), sizeof(vint32_t));
+    ofs.write(meta.c_str(), meta_length);
+    vint offset = LOCAL_HEADER_SIZE + meta_length;
+    const char zeros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    ofs.write(zeros, (offset + 7) / 8 * 8 - offset);
+    if (nullptr != payload && length > 0) { ofs.write(payload, length); }
+    bool done = ofs.good();
+    ofs.close();
+    return done;
+}
+
+bool WriteLocalRecords(const string& filename, const vector<string>& fields,
+                       const vector<STRING_MAP>& records) {
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) { return false; }
+    for (size_t i = 0; i < fields.size(); i++) {
+        ofs << (i == 0 ? "" : "\t") << fields[i];
+    }
+    ofs << "\n";
+    for (auto it = records.begin(); it != records.end(); ++it) {
+        for (size_t i = 0; i < fields.size(); i++) {
+            auto itv = it->find(fields[i]);
+            ofs << (i == 0 ? "" : "\t") << (itv == it->end() ? "" : itv->second);
+        }
+        ofs << "\n";
+    }
+    bool done = ofs.good();
+    ofs.close();
+    return done;
+}
+
+bool WriteLocalKeyValues(const string& filename, const STRING_MAP& kvs) {
+    std::ofstream ofs(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) { return false; }
+    for (auto it = kvs.begin(); it != kvs.end(); ++it) {
+        ofs << it->first << "=" << it->second << "\n";
+    }
+    bool done = ofs.good();
+    ofs.close();
+    return done;
+}
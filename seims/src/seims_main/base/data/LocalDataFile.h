@@ -0,0 +1,128 @@
+/*!
+ * \file LocalDataFile.h
+ * \brief Access of the file-based model data exported from MongoDB,
+ *        see `seims/preprocess/db_export_local.py`.
+ *
+ *        Layout of a model data directory (version 1):
+ *          - MANIFEST            KEY=VALUE lines, e.g., FORMAT=SEIMS_LOCAL, VERSION=1, MODEL=<name>
+ *          - FILE_IN.tsv, FILE_OUT.tsv, PARAMETERS.tsv, REACHES.tsv, SITELIST.tsv
+ *                                tab-separated records, the first line is the field names
+ *          - SPATIAL/<NAME>.sbin GridFS files, e.g., rasters, 1D/2D arrays, IUH, and weights
+ *          - CLIMATE/<TYPE>.sbin Regular time series of all sites of each climate data type
+ *
+ *        Binary layout of *.sbin (native byte order, little-endian on all supported platforms):
+ *          - char[8]  magic "SEIMSBIN"
+ *          - int32    version
+ *          - int32    metadata length in bytes
+ *          - char[]   metadata, KEY=VALUE lines, the same as the metadata of GridFS file
+ *          - padding  zeros to align the payload to 8 bytes
+ *          - payload  until the end of file, the same as the content of GridFS file
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Add writers of *.sbin, TSV, and KEY=VALUE files, e.g., for synthetic data.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_LOCAL_DATA_FILE_H
+#define SEIMS_LOCAL_DATA_FILE_H
+
+#include <string>
+#include <vector>
+
+#include "basic.h"
+
+using namespace ccgl;
+using std::string;
+using std::vector;
+
+/// Version of the local data layout, should be updated synchronously with db_export_local.py
+const int LOCAL_DATA_VERSION = 1;
+
+/*!
+ * \ingroup data
+ * \class LocalDataFile
+ * \brief Memory-mapped binary file (*.sbin) with KEY=VALUE metadata and aligned payload.
+ *
+ * On POSIX systems the file is mapped by `mmap` so that only the accessed pages are loaded,
+ * otherwise, the entire file is read into memory.
+ */
+class LocalDataFile: NotCopyable {
+public:
+    //! Open and map the file, check Valid() before use
+    explicit LocalDataFile(const string& filename);
+
+    //! Destructor, unmap the file
+    ~LocalDataFile();
+
+    //! Is the file existed and in valid format?
+    bool Valid() const { return nullptr != payload_; }
+
+    //! Metadata
+    const STRING_MAP& GetMetadata() const { return metadata_; }
+
+    //! Get metadata value of the key, empty string if not existed
+    string GetMetadata(const string& key) const;
+
+    //! Payload, aligned to 8 bytes
+    const char* GetPayload() const { return payload_; }
+
+    //! Payload length in bytes
+    vint GetPayloadLength() const { return payload_length_; }
+
+    //! Payload as float array, which is the data type of all arrays stored in GridFS
+    const float* GetFloats() const { return reinterpret_cast<const float*>(payload_); }
+
+    //! Number of float values of payload
+    int GetFloatCount() const { return CVT_INT(payload_length_ / sizeof(float)); }
+
+private:
+    //! Parse header and metadata
+    bool Parse();
+
+private:
+    char* base_;             ///< Mapped or loaded address of the entire file
+    vint length_;            ///< File length in bytes
+    bool mapped_;            ///< Mapped by mmap or loaded into memory
+    const char* payload_;    ///< Payload address
+    vint payload_length_;    ///< Payload length
+    STRING_MAP metadata_;    ///< Metadata
+};
+
+/*!
+ * \brief Read tab-separated records, the first line is the field names.
+ *        The empty values are skipped, i.e., regarded as not existed.
+ * \param[in] filename TSV file
+ * \param[out] records Records as key-value maps
+ * \return True if the file is existed and readable
+ */
+bool ReadLocalRecords(const string& filename, vector<STRING_MAP>& records);
+
+/*!
+ * \brief Read KEY=VALUE lines, e.g., MANIFEST
+ */
+bool ReadLocalKeyValues(const string& filename, STRING_MAP& kvs);
+
+/*!
+ * \brief Write metadata and payload as a binary file (*.sbin) of current version
+ * \param[in] filename Output file
+ * \param[in] metadata Metadata, e.g., the header of raster
+ * \param[in] payload Payload data
+ * \param[in] length Payload length in bytes
+ * \return True if succeed
+ */
+bool WriteLocalDataFile(const string& filename, const STRING_MAP& metadata,
+                        const char* payload, vint length);
+
+/*!
+ * \brief Write records as tab-separated table, the first line is the field names
+ */
+bool WriteLocalRecords(const string& filename, const vector<string>& fields,
+                       const vector<STRING_MAP>& records);
+
+/*!
+ * \brief Write KEY=VALUE lines, e.g., MANIFEST
+ */
+bool WriteLocalKeyValues(const string& filename, const STRING_MAP& kvs);
+
+#endif /* SEIMS_LOCAL_DATA_FILE_H */
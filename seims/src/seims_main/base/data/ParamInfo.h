@@ -40,8 +40,8 @@ public:
     ParamInfo();
 
     //! Construct for initial parameters from DB
-    ParamInfo(string& name, string& desc, string& unit, string& mid, T value, string& change, T impact,
-              T maximum, T minimum, bool isint);
+    ParamInfo(const string& name, const string& desc, const string& unit, const string& mid, T value,
+              const string& change, T impact, T maximum, T minimum, bool isint);
 
     //! Construct for module Parameter
     ParamInfo(string& name, string& basicname, string& desc, string& unit, string& source, string& mid,
@@ -159,8 +159,8 @@ ParamInfo<T>::ParamInfo() :
 }
 
 template <typename T>
-ParamInfo<T>::ParamInfo(string& name, string& desc, string& unit, string& mid, T value, string& change,
-                        T impact, T maximum, T minimum, bool isint):
+ParamInfo<T>::ParamInfo(const string& name, const string& desc, const string& unit, const string& mid,
+                        T value, const string& change, T impact, T maximum, T minimum, bool isint):
     Name(name), BasicName(""), Description(desc), Units(unit), Source(""), ModuleID(mid),
     Dimension(DT_Unknown), Transfer(TF_None),
     Value(value), Change(change), Impact(impact), Maximum(maximum), Minimum(minimum), IsInteger(isint),
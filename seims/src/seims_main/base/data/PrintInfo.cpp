@@ -64,7 +64,8 @@ void PrintInfoItem::add1DRasterTimeSeriesResult(time_t t, int n, const float* da
     TimeSeriesDataForRaster[t] = temp;
     TimeSeriesDataForRasterCount = n;
 }
-void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster* templateRaster, const string& header) {
+void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster* templateRaster, const string& header,
+                          const bool out_subbasin_gfs /* = true */) {
     // For MPI version, 1) Output to MongoDB, then 2) combined to tiff
     /*   Currently, I cannot find a way to store GridFS files with the same filename but with
     *        different metadata information by mongo-c-driver, which can be done by pymongo.
@@ -84,7 +85,8 @@ void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster
     bool outToMongoDB = false; // By default, not output to MongoDB.
     // Additional metadata information
     map<string, string> opts;
-    if (SubbasinID != 0 && SubbasinID != 9999 && // Not the whole basin, Not the field-version
+    if (nullptr != gfs && // GridFS is not available for local data
+        SubbasinID != 0 && SubbasinID != 9999 && // Not the whole basin, Not the field-version
         (m_1DData != nullptr || m_2DData != nullptr)) {
         // Spatial outputs
         outToMongoDB = true;
@@ -110,6 +112,10 @@ void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster
     if (m_scenarioID >= 0) gfs_name += itoa(m_scenarioID);
     gfs_name += "_";
     if (m_calibrationID >= 0) gfs_name += itoa(m_calibrationID);
+    if (outToMongoDB && !out_subbasin_gfs) {
+        // Raster data of subbasin are kept in memory and combined by the MPI driver
+        return;
+    }
     if (outToMongoDB) {
         CLOG(TRACE, LOG_OUTPUT) << "Creating output file " << Filename << "(GridFS file: " << gfs_name << ")...";
     } else {
@@ -191,10 +197,15 @@ void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster
 
         if (Suffix == GTiffExtension || Suffix == ASCIIExtension) {
             FloatRaster* rs_data = nullptr;
+            // Aggregated values are converted to the storage precision of raster
+            FLTPT* out_1d = nullptr;
+            FLTPT** out_2d = nullptr;
             if (is1d) { // Single-layered and cell-based raster data
-                rs_data = new FloatRaster(templateRaster, m_1DData, m_nRows);
+                Initialize1DArray(m_nRows, out_1d, m_1DData);
+                rs_data = new FloatRaster(templateRaster, out_1d, m_nRows);
             } else { // Multi-layered and cell-based raster data
-                rs_data = new FloatRaster(templateRaster, m_2DData, m_nRows, m_nLayers);
+                Initialize2DArray(m_nRows, m_nLayers, out_2d, m_2DData);
+                rs_data = new FloatRaster(templateRaster, out_2d, m_nRows, m_nLayers);
             }
             if (outToMongoDB) {
                 gfs->RemoveFile(gfs_name);
@@ -214,6 +225,8 @@ void PrintInfoItem::Flush(const string& projectPath, MongoGridFs* gfs, IntRaster
                 rs_data->OutputToFile(projectPath + Filename + "." + Suffix);
             }
             delete rs_data; // Release temp raster data
+            Release1DArray(out_1d);
+            Release2DArray(out_2d);
         } else if (Suffix == TextExtension) { /// For field-version models, the Suffix is TextExtension
             std::ofstream fs;
             string filename = projectPath + Filename + "." + TextExtension;
@@ -51,12 +51,12 @@ public:
     FLTPT** m_1DDataWithRowCol;
     //! rows number, i.e., number of valid cells
     int m_nRows;
-    //! For 1D raster/array data
-    FLTPT* m_1DData;
+    //! For 1D raster/array data, aggregated in the precision of accumulators
+    FLTACC* m_1DData;
     //! number of layers of raster data, greater or equal than 1
     int m_nLayers;
-    //! For 2D raster/array data
-    FLTPT** m_2DData;
+    //! For 2D raster/array data, aggregated in the precision of accumulators
+    FLTACC** m_2DData;
 
     //! For time series data of a single subbasin, DT_Single
     map<time_t, FLTPT> TimeSeriesData;
@@ -117,8 +117,18 @@ public:
     //! Aggregation type string
     string AggType;
 
-    //! create "output" folder to store all results
-    void Flush(const string& projectPath, MongoGridFs* gfs, IntRaster* templateRaster, const string& header);
+    /*!
+     * \brief Write the aggregated results to files or MongoDB
+     * \param[in] projectPath Output directory
+     * \param[in] gfs GridFS of spatial outputs, only used for subbasins of MPI version
+     * \param[in] templateRaster Mask raster of the output raster data
+     * \param[in] header Header of output time series
+     * \param[in] out_subbasin_gfs Optional, write raster data of subbasin to GridFS for MPI version.
+     *                             If false, the raster data are only kept in memory, e.g., to be
+     *                             combined by the MPI driver directly.
+     */
+    void Flush(const string& projectPath, MongoGridFs* gfs, IntRaster* templateRaster, const string& header,
+               bool out_subbasin_gfs = true);
 
     //! Determine if the given date is within the date range for this item
     bool IsDateInRange(time_t dt);
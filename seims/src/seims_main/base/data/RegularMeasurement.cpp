@@ -15,7 +15,8 @@ using namespace utils_string;
 RegularMeasurement::RegularMeasurement(MongoClient* conn, const string& hydroDBName,
                                        const string& sitesList, const string& siteType,
                                        const time_t startTime, const time_t endTime, const time_t interval):
-    Measurement(conn, hydroDBName, sitesList, siteType, startTime, endTime), m_interval(interval) {
+    Measurement(conn, hydroDBName, sitesList, siteType, startTime, endTime), m_interval(interval),
+    m_sharedValues(nullptr), m_sharedStride(0) {
     int nSites = CVT_INT(m_siteIDList.size());
     int nRecords = CVT_INT((m_endTime - m_startTime) / m_interval + 1);
     m_siteData.reserve(nRecords);
@@ -127,6 +128,31 @@ RegularMeasurement::RegularMeasurement(MongoClient* conn, const string& hydroDBN
     mongoc_cursor_destroy(cursor);
 }
 
+RegularMeasurement::RegularMeasurement(const string& sitesList, const string& siteType,
+                                       const time_t startTime, const time_t endTime, const time_t interval,
+                                       vector<FLTPT*>& siteData):
+    Measurement(nullptr, "", sitesList, siteType, startTime, endTime), m_interval(interval),
+    m_sharedValues(nullptr), m_sharedStride(0) {
+    int nRecords = CVT_INT((m_endTime - m_startTime) / m_interval + 1);
+    m_siteData.swap(siteData);
+    if (CVT_INT(m_siteData.size()) < nRecords) {
+        throw ModelException("RegularMeasurement", "Constructor", "No adequate data of " + siteType +
+                             " during " + ConvertToString2(m_startTime) + " to " + ConvertToString2(m_endTime));
+    }
+}
+
+RegularMeasurement::RegularMeasurement(const string& sitesList, const string& siteType,
+                                       const time_t startTime, const time_t endTime, const time_t interval,
+                                       const FLTPT* sharedValues, const int sharedStride,
+                                       const vector<int>& sharedColumns):
+    Measurement(nullptr, "", sitesList, siteType, startTime, endTime), m_interval(interval),
+    m_sharedValues(sharedValues), m_sharedStride(sharedStride), m_sharedColumns(sharedColumns) {
+    if (nullptr == m_sharedValues || m_sharedColumns.size() != m_siteIDList.size()) {
+        throw ModelException("RegularMeasurement", "Constructor", "Shared data of " + siteType +
+                             " are mismatched with sites: " + sitesList);
+    }
+}
+
 RegularMeasurement::~RegularMeasurement() {
     for (auto it = m_siteData.begin(); it != m_siteData.end(); ++it) {
         if (*it != nullptr) {
@@ -143,6 +169,13 @@ FLTPT* RegularMeasurement::GetSiteDataByTime(const time_t t) {
         index = 0;
     }
     size_t nSites = m_siteIDList.size();
+    if (nullptr != m_sharedValues) {
+        const FLTPT* record = m_sharedValues + static_cast<size_t>(index) * m_sharedStride;
+        for (size_t i = 0; i < nSites; i++) {
+            pData[i] = record[m_sharedColumns[i]];
+        }
+        return pData;
+    }
     for (size_t i = 0; i < nSites; i++) {
         pData[i] = m_siteData[index][i];
     }
@@ -5,6 +5,8 @@
  * Changelog:
  *   - 1. 2016-05-30 - lj - Replace mongoc_client_t by MongoClient interface.
  *   - 2. 2022-08-18 - lj - Change float to FLTPT.
+ *   - 3. 2026-10-19 - lj - Construct from data read from local files.
+ *   - 4. 2026-10-19 - lj - Reference time series stored in shared memory.
  *
  * \author Junzhi Liu, Liangjun Zhu
  * \version 2.1
@@ -36,6 +38,35 @@ public:
     RegularMeasurement(MongoClient* conn,
                        const string& hydroDBName, const string& sitesList, const string& siteType,
                        time_t startTime, time_t endTime, time_t interval);
+    /*!
+     * \brief Initialize Regular Measurement instance from data that have been read, e.g., local files
+     *
+     * \param[in] sitesList \a string, site list
+     * \param[in] siteType \a string, site type
+     * \param[in] startTime \a time_t, start date time
+     * \param[in] endTime \a time_t, end date time
+     * \param[in] interval \a time_t, time interval
+     * \param[in] siteData data of each record ordered by sites, which will be released by this instance
+     */
+    RegularMeasurement(const string& sitesList, const string& siteType,
+                       time_t startTime, time_t endTime, time_t interval,
+                       vector<FLTPT*>& siteData);
+    /*!
+     * \brief Initialize Regular Measurement instance that references the time series of
+     *        more sites stored in shared memory, e.g., \a SharedClimateData
+     *
+     * \param[in] sitesList \a string, site list
+     * \param[in] siteType \a string, site type
+     * \param[in] startTime \a time_t, start date time
+     * \param[in] endTime \a time_t, end date time
+     * \param[in] interval \a time_t, time interval
+     * \param[in] sharedValues values of the record of startTime, ordered by records, not owned
+     * \param[in] sharedStride number of sites of each record in sharedValues
+     * \param[in] sharedColumns column of each site (in ascending order of site IDs) in sharedValues
+     */
+    RegularMeasurement(const string& sitesList, const string& siteType,
+                       time_t startTime, time_t endTime, time_t interval,
+                       const FLTPT* sharedValues, int sharedStride, const vector<int>& sharedColumns);
 
     //! Destructor
     ~RegularMeasurement();
@@ -44,7 +75,10 @@ public:
     FLTPT* GetSiteDataByTime(time_t t) OVERRIDE;
 
 private:
-    vector<FLTPT*> m_siteData; ///< data array ordered by sites
-    time_t m_interval;          ///< data record interval
+    vector<FLTPT*> m_siteData;    ///< data array ordered by sites
+    time_t m_interval;             ///< data record interval
+    const FLTPT* m_sharedValues;   ///< time series in shared memory, which is used instead of m_siteData
+    int m_sharedStride;            ///< number of sites of each record in m_sharedValues
+    vector<int> m_sharedColumns;   ///< column of each site in m_sharedValues
 };
 #endif /* SEIMS_REGULAR_MEASUREMENT_H */
@@ -0,0 +1,38 @@
+#include "SharedClimateData.h"
+
+SharedClimateData::SharedClimateData(const string& clim_dbname) : clim_dbname_(clim_dbname) {
+}
+
+void SharedClimateData::AddSeries(const string& site_type, const SharedSiteSeries& series) {
+    series_[site_type] = series;
+}
+
+void SharedClimateData::AddSiteInfo(const string& site_type, const SharedSiteInfo& info) {
+    infos_[site_type] = info;
+}
+
+const SharedSiteSeries* SharedClimateData::GetSeries(const string& site_type) const {
+    auto it = series_.find(site_type);
+    if (it == series_.end()) { return nullptr; }
+    return &it->second;
+}
+
+const SharedSiteInfo* SharedClimateData::GetSiteInfo(const string& site_type) const {
+    auto it = infos_.find(site_type);
+    if (it == infos_.end()) { return nullptr; }
+    return &it->second;
+}
+
+void SharedClimateData::GetSeriesTypes(vector<string>& site_types) const {
+    site_types.clear();
+    for (auto it = series_.begin(); it != series_.end(); ++it) {
+        site_types.push_back(it->first);
+    }
+}
+
+void SharedClimateData::GetSiteInfoTypes(vector<string>& site_types) const {
+    site_types.clear();
+    for (auto it = infos_.begin(); it != infos_.end(); ++it) {
+        site_types.push_back(it->first);
+    }
+}
@@ -0,0 +1,95 @@
+/*!
+ * \file SharedClimateData.h
+ * \brief Read-only HydroClimate data shared by data centers.
+ *
+ *        The data centers of subbasins read the time series of the same HydroClimate sites.
+ *        The shared data are loaded once (e.g., by one rank of each computing node of the MPI
+ *        version) into memory owned by others, and the InputStation of each data center references
+ *        them instead of reading and holding its own copy.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_SHARED_CLIMATE_DATA_H
+#define SEIMS_SHARED_CLIMATE_DATA_H
+
+#include <map>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+using namespace ccgl;
+using std::map;
+using std::vector;
+
+/*!
+ * \ingroup data
+ * \struct SharedSiteSeries
+ * \brief Regular time series of sites of one data type, e.g., TMEAN
+ */
+struct SharedSiteSeries {
+    vector<int> site_ids; ///< Site IDs in ascending order
+    time_t start_time;    ///< Time of the first record
+    time_t interval;      ///< Record interval
+    int n_records;        ///< Number of records
+    const FLTPT* values;  ///< Values ordered by records, i.e., n_records * site_ids.size()
+};
+
+/*!
+ * \ingroup data
+ * \struct SharedSiteInfo
+ * \brief Latitudes and elevations of sites, i.e., of precipitation or meteorology sites
+ */
+struct SharedSiteInfo {
+    vector<int> site_ids; ///< Site IDs in the order of site list
+    const FLTPT* lats;    ///< Latitudes of sites
+    const FLTPT* elevs;   ///< Elevations of sites
+};
+
+/*!
+ * \ingroup data
+ * \class SharedClimateData
+ * \brief Index of HydroClimate data stored in memory shared by data centers.
+ *
+ *        SharedClimateData does not own the values, which should be alive until all
+ *        data centers that reference them are released.
+ */
+class SharedClimateData: NotCopyable {
+public:
+    //! Constructor by the HydroClimate database name
+    explicit SharedClimateData(const string& clim_dbname);
+
+    //! Add time series of the given data type
+    void AddSeries(const string& site_type, const SharedSiteSeries& series);
+
+    //! Add site information of the given site type, i.e., "P" or "M"
+    void AddSiteInfo(const string& site_type, const SharedSiteInfo& info);
+
+    //! HydroClimate database name
+    const string& GetClimateDBName() const { return clim_dbname_; }
+
+    //! Time series of the given data type, nullptr if not existed
+    const SharedSiteSeries* GetSeries(const string& site_type) const;
+
+    //! Site information of the given site type, nullptr if not existed
+    const SharedSiteInfo* GetSiteInfo(const string& site_type) const;
+
+    //! Data types of time series
+    void GetSeriesTypes(vector<string>& site_types) const;
+
+    //! Site types of site information
+    void GetSiteInfoTypes(vector<string>& site_types) const;
+
+    //! Has no data
+    bool IsEmpty() const { return series_.empty(); }
+
+private:
+    string clim_dbname_;                    ///< HydroClimate database name
+    map<string, SharedSiteSeries> series_;  ///< Time series of data types
+    map<string, SharedSiteInfo> infos_;     ///< Site information of site types
+};
+
+#endif /* SEIMS_SHARED_CLIMATE_DATA_H */
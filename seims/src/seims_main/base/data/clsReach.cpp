@@ -115,6 +115,68 @@ clsReach::clsReach(const bson_t*& bson_table):
     }
 }
 
+clsReach::clsReach(const STRING_MAP& fields):
+    cells_num_(-9999), positions_(nullptr) {
+    // The same as the constructor by bson_t
+    int i = 0;
+    while (*REACH_PARAM_NAME[i] != '\0') {
+        FLTPT tmp_param = NODATA_VALUE;
+        bool flag = false;
+        auto it = fields.find(REACH_PARAM_NAME[i]);
+        if (it != fields.end()) { tmp_param = IsDouble(it->second, flag); }
+        if (flag) {
+            if (StringMatch(REACH_PARAM_NAME[i], REACH_BOD) && tmp_param < 1.e-6) tmp_param = 1.e-6;
+        } else {
+            tmp_param = NODATA_VALUE;
+            if (StringMatch(REACH_PARAM_NAME[i], REACH_BEDTC)) tmp_param = 0.;
+            if (StringMatch(REACH_PARAM_NAME[i], REACH_BNKTC)) tmp_param = 0.;
+        }
+#ifdef HAS_VARIADIC_TEMPLATES
+        param_map_.emplace(REACH_PARAM_NAME[i], tmp_param);
+#else
+        param_map_.insert(make_pair(REACH_PARAM_NAME[i], tmp_param));
+#endif
+        i++;
+    }
+    auto itx = fields.find(REACH_COORX);
+    auto ity = fields.find(REACH_COORY);
+    if (itx != fields.end() && SplitStringForValues(itx->second, ',', coor_x_) &&
+        ity != fields.end() && SplitStringForValues(ity->second, ',', coor_y_) &&
+        coor_x_.size() == coor_y_.size()) {
+        cells_num_ = CVT_INT(coor_x_.size());
+    } else {
+        cout << "No Coordinate fields found, or split for coordinate values failed, or "
+                "length mismathched between x and y coordinates!" << endl;
+    }
+    auto itg = fields.find(REACH_GROUP);
+    if (itg == fields.end() || !SplitStringForValues(itg->second, ',', group_number_)) {
+        cout << "No GROUP field found, or split for group numbers failed!" << endl;
+        return;
+    }
+    for (i = 0; *REACH_GROUP_NAME[i] != '\0'; i++) {
+        auto itm = fields.find(REACH_GROUP_NAME[i]);
+        if (itm == fields.end()) continue;
+        vector<int> g_idx;
+        if (!SplitStringForValues(itm->second, ',', g_idx) || group_number_.size() != g_idx.size()) {
+            cout << "The size of group method " << REACH_GROUP_NAME[i] << " is not equal to GROUP! " << endl;
+            continue;
+        }
+        map<int, int> group_index;
+        for (size_t j = 0; j < group_number_.size(); j++) {
+#ifdef HAS_VARIADIC_TEMPLATES
+            group_index.emplace(group_number_[j], g_idx[j]);
+#else
+            group_index.insert(make_pair(group_number_[j], g_idx[j]));
+#endif
+        }
+#ifdef HAS_VARIADIC_TEMPLATES
+        group_index_.emplace(REACH_GROUP_NAME[i], group_index);
+#else
+        group_index_.insert(make_pair(REACH_GROUP_NAME[i], group_index));
+#endif
+    }
+}
+
 clsReach::~clsReach() {
     if (nullptr != positions_) { Release1DArray(positions_); }
 }
@@ -364,8 +426,6 @@ clsReaches::clsReaches(MongoClient* conn, const string& db_name,
         throw ModelException("clsReaches", "ReadAllReachInfo",
                              "Failed to get document number of collection: " + collection_name + ".\n");
     }
-    reach_up_streams_.resize(reach_num_ + 1);
-
     mongoc_cursor_t* cursor = collection->ExecuteQuery(b, opts);
     const bson_t* bson_table;
     while (mongoc_cursor_more(cursor) && mongoc_cursor_next(cursor, &bson_table)) {
@@ -377,6 +437,33 @@ clsReaches::clsReaches(MongoClient* conn, const string& db_name,
         reaches_obj_.insert(make_pair(sub_id, cur_reach));
 #endif
     }
+    BuildTopology(mtd);
+    bson_destroy(b);
+    bson_destroy(opts);
+    mongoc_cursor_destroy(cursor);
+}
+
+clsReaches::clsReaches(const vector<STRING_MAP>& records, const LayeringMethod mtd /* = UP_DOWN */) {
+    reach_num_ = CVT_INT(records.size());
+    for (auto it = records.begin(); it != records.end(); ++it) {
+        clsReach* cur_reach = new clsReach(*it);
+        int sub_id = CVT_INT(cur_reach->Get(REACH_SUBBASIN));
+#ifdef HAS_VARIADIC_TEMPLATES
+        if (!reaches_obj_.emplace(sub_id, cur_reach).second) {
+#else
+        if (!reaches_obj_.insert(make_pair(sub_id, cur_reach)).second) {
+#endif
+            delete cur_reach;
+        }
+    }
+    if (CVT_INT(reaches_obj_.size()) != reach_num_) {
+        throw ModelException("clsReaches", "Constructor", "Subbasin IDs of reaches must be unique!");
+    }
+    BuildTopology(mtd);
+}
+
+void clsReaches::BuildTopology(const LayeringMethod mtd) {
+    reach_up_streams_.resize(reach_num_ + 1);
     // In SEIMS, reach ID is the same as Index of array and vector.
     for (int i = 1; i <= reach_num_; i++) {
         int down_stream_id = CVT_INT(reaches_obj_.at(i)->Get(REACH_DOWNSTREAM));
@@ -403,9 +490,6 @@ clsReaches::clsReaches(MongoClient* conn, const string& db_name,
         }
         reach_layers_.at(order).emplace_back(i);
     }
-    bson_destroy(b);
-    bson_destroy(opts);
-    mongoc_cursor_destroy(cursor);
 }
 
 clsReaches::~clsReaches() {
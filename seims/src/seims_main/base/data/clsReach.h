@@ -7,6 +7,7 @@
  *                          Get 1D arrays of reach properties to keep synchronization among modules.
  *   - 2. 2017-12-26 - lj - Code refactor.
  *   - 3. 2021-04-20 - lj - Add coordinates x and y of reach vertexes for some channel routing module.
+ *   - 4. 2026-10-19 - lj - Construct from key-value records, e.g., exported to local files.
  *
  * \author Liang-Jun Zhu
  * \version 1.3
@@ -36,6 +37,9 @@ public:
     //! Constructor
     explicit clsReach(const bson_t*& bson_table);
 
+    //! Constructor by key-value strings, the keys are the same as fields of REACHES table
+    explicit clsReach(const STRING_MAP& fields);
+
     //! Destructor
     ~clsReach();
 
@@ -96,6 +100,13 @@ public:
      */
     clsReaches(MongoClient* conn, const string& db_name, const string& collection_name, LayeringMethod mtd = UP_DOWN);
 
+    /*!
+     * \brief Constructor by key-value records of reach table, e.g., exported to local files
+     * \param[in] records Records of all reaches
+     * \param[in] mtd layering method, the default is UP_DOWN, \sa LayeringMethod
+     */
+    explicit clsReaches(const vector<STRING_MAP>& records, LayeringMethod mtd = UP_DOWN);
+
     /// Destructor
     ~clsReaches();
 
@@ -126,6 +137,10 @@ public:
      */
     void Update(map<string, ParamInfo<FLTPT> *>& caliparams_map, IntRaster* mask_raster);
 
+private:
+    /// Build upstream, downstream, and layers of reaches after all reaches are read
+    void BuildTopology(LayeringMethod mtd);
+
 private:
     /// reaches number
     int reach_num_;
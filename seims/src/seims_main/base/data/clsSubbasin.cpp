@@ -16,7 +16,7 @@ Subbasin::Subbasin(const int id) :
 }
 
 Subbasin::~Subbasin() {
-    if (cells_ != nullptr) { Release1DArray(cells_); }
+    // cells_ is owned by the ZoneIndex of clsSubbasins
 }
 
 bool Subbasin::CheckInputSize(const int n) {
@@ -35,7 +35,7 @@ bool Subbasin::CheckInputSize(const int n) {
     return true;
 }
 
-void Subbasin::SetCellList(const int n_cells, int* cells) {
+void Subbasin::SetCellList(const int n_cells, const int* cells) {
     CheckInputSize(n_cells);
     cells_ = cells;
 }
@@ -56,7 +56,8 @@ void Subbasin::SetSlope(FLTPT* slope) {
 //////////  clsSubbasins                           ///////////////////////
 //////////////////////////////////////////////////////////////////////////
 clsSubbasins::clsSubbasins(map<string, IntRaster*>& rs_int_map,
-                           map<string, FloatRaster *>& rs_map, const int prefix_id): n_subbasins_(-1) {
+                           map<string, FloatRaster *>& rs_map, const int prefix_id):
+    n_subbasins_(-1), subbasin_index_(nullptr) {
     subbasin_ids_.clear();
     subbasin_objs_.clear();
 
@@ -70,37 +71,22 @@ clsSubbasins::clsSubbasins(map<string, IntRaster*>& rs_int_map,
     rs_int_map[GetUpper(oss.str())]->GetRasterData(&n_cells, &subbasin_data);
     cell_width = rs_int_map[GetUpper(oss.str())]->GetCellWidth();
 
-    // valid cell indexes of each subbasin, key is subbasin ID, value is vector of cell's index
-    map<int, vector<int> > cell_list_map;
-    for (int i = 0; i < n_cells; i++) {
-        int sub_id = subbasin_data[i];
-        if (cell_list_map.find(sub_id) == cell_list_map.end()) {
+    // valid cell indexes of each subbasin are stored as CSR format, i.e., one flat array with offsets
+    subbasin_index_ = new ZoneIndex(n_cells, subbasin_data);
+    n_subbasins_ = subbasin_index_->GetZoneNumber();
+    subbasin_ids_ = subbasin_index_->GetZoneIDs();
+    for (int k = 0; k < n_subbasins_; k++) {
+        int sub_id = subbasin_ids_[k];
+        Subbasin* new_sub = new Subbasin(sub_id);
+        int n_cells_tmp = subbasin_index_->GetZoneCellCount(k);
+        new_sub->SetCellList(n_cells_tmp, subbasin_index_->GetZoneCells(k));
+        new_sub->SetArea(cell_width * cell_width * n_cells_tmp);
 #ifdef HAS_VARIADIC_TEMPLATES
-            cell_list_map.emplace(sub_id, vector<int>());
+        subbasin_objs_.emplace(sub_id, new_sub);
 #else
-            cell_list_map.insert(make_pair(sub_id, vector<int>()));
+        subbasin_objs_.insert(make_pair(sub_id, new_sub));
 #endif
-        }
-        cell_list_map[sub_id].emplace_back(i);
-    }
-    n_subbasins_ = CVT_INT(cell_list_map.size());
-    for (auto it = cell_list_map.begin(); it != cell_list_map.end(); ++it) {
-        // swap for saving memory, using shrink_to_fit() instead.
-        vector<int>(it->second).swap(it->second);
-        // (*it->second).shrink_to_fit();
-        int sub_id = it->first;
-        subbasin_ids_.emplace_back(sub_id);
-        Subbasin* new_sub = new Subbasin(sub_id);
-        int n_cells_tmp = CVT_INT(it->second.size());
-        int* tmp = new int[n_cells_tmp];
-        for (int j = 0; j < n_cells_tmp; j++)
-            tmp[j] = it->second.at(j);
-        new_sub->SetCellList(n_cells_tmp, tmp);
-        new_sub->SetArea(cell_width * cell_width * n_cells_tmp);
-        subbasin_objs_[sub_id] = new_sub;
     }
-    vector<int>(subbasin_ids_).swap(subbasin_ids_);
-    // m_subbasinIDs.shrink_to_fit();
 
     /// Set required parameters, e.g., slope
     FLTPT* slope_data = nullptr;
@@ -151,6 +137,7 @@ clsSubbasins::~clsSubbasins() {
         }
         subbasin_objs_.clear();
     }
+    delete subbasin_index_;
 }
 
 FLTPT clsSubbasins::Subbasin2Basin(const string& key) {
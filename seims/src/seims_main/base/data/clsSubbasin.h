@@ -12,6 +12,7 @@
 #include "data_raster.hpp"
 
 #include "seims.h"
+#include "clsZoneIndex.h"
 
 using namespace ccgl;
 
@@ -40,8 +41,12 @@ public:
 
     // Set functions
 
-    //! Set cell index list, as well as subbasin area
-    void SetCellList(int n_cells, int* cells);
+    /*!
+     * \brief Set cell index list
+     * \param[in] n_cells Count of valid cells
+     * \param[in] cells Cell indexes, which is a segment of the CSR index in clsSubbasins, i.e., not owned
+     */
+    void SetCellList(int n_cells, const int* cells);
 
     //! area of subbasin
     void SetArea(const FLTPT area) { area_ = area; }
@@ -88,7 +93,7 @@ public:
     int GetCellCount() { return n_cells_; }
 
     //! Get index of valid cells
-    int* GetCells() { return cells_; }
+    const int* GetCells() { return cells_; }
 
     //! Get the output flag (true mean output), the function will be deprecated. By LJ
     bool GetIsOutput() { return output_; }
@@ -130,8 +135,8 @@ private:
     int subbsn_id_;
     //! valid cells number
     int n_cells_;
-    //! index of valid cells
-    int* cells_;
+    //! index of valid cells, segment of the CSR index in clsSubbasins
+    const int* cells_;
     FLTPT cell_area_; ///< area of the cell(s)
                       ///< todo This should be float* when irregular polygon is supported. By lj.
     //! area of current Subbasin
@@ -244,6 +249,14 @@ public:
     /// Get map of subbasin objects
     map<int, Subbasin *>& GetSubbasinObjects() { return subbasin_objs_; }
 
+    /*!
+     * \brief Get the CSR index of cells grouped by subbasin IDs.
+     *
+     * The segmented reductions, e.g., ZoneIndex::Sum() and ZoneIndex::Mean(),
+     * can be used for subbasin-scale aggregation in modules.
+     */
+    ZoneIndex* GetSubbasinIndex() { return subbasin_index_; }
+
     /*!
      * \brief Set slope coefficient for each subbasin according to the basin slope
      * \todo This function will set slope_coef_ to 1.f in MPI version.
@@ -269,5 +282,7 @@ private:
      * value: Subbasin instance (pointer)
      */
     map<int, Subbasin *> subbasin_objs_;
+    /// CSR index of cells grouped by subbasin IDs, the cell lists of Subbasin objects point to it
+    ZoneIndex* subbasin_index_;
 };
 #endif /* SEIMS_SUBBASIN_CLS_H */
@@ -0,0 +1,54 @@
+#include "clsZoneIndex.h"
+
+ZoneIndex::ZoneIndex(const int n, const int* zones) :
+    n_cells_(n), n_zones_(0), max_zone_id_(-1) {
+    vector<int> tmp_zones(zones, zones + n);
+    Build(tmp_zones);
+}
+
+ZoneIndex::ZoneIndex(const int n, const FLTPT* zones) :
+    n_cells_(n), n_zones_(0), max_zone_id_(-1) {
+    vector<int> tmp_zones(n);
+    for (int i = 0; i < n; i++) {
+        tmp_zones[i] = CVT_INT(zones[i]);
+    }
+    Build(tmp_zones);
+}
+
+int ZoneIndex::GetZoneSequence(const int zone_id) const {
+    if (zone_id < 0 || zone_id > max_zone_id_) { return -1; }
+    return zone_seqs_[zone_id];
+}
+
+void ZoneIndex::Build(const vector<int>& zones) {
+    for (int i = 0; i < n_cells_; i++) {
+        if (zones[i] > max_zone_id_) { max_zone_id_ = zones[i]; }
+    }
+    if (max_zone_id_ < 0) {
+        offsets_.assign(1, 0);
+        return;
+    }
+    // 1. Count cells of each zone ID
+    vector<int> counts(max_zone_id_ + 1, 0);
+    for (int i = 0; i < n_cells_; i++) {
+        if (zones[i] >= 0) { counts[zones[i]]++; }
+    }
+    // 2. Zone IDs, sequences, and offsets
+    zone_seqs_.assign(max_zone_id_ + 1, -1);
+    offsets_.clear();
+    offsets_.emplace_back(0);
+    for (int id = 0; id <= max_zone_id_; id++) {
+        if (counts[id] == 0) { continue; }
+        zone_seqs_[id] = CVT_INT(zone_ids_.size());
+        zone_ids_.emplace_back(id);
+        offsets_.emplace_back(offsets_.back() + counts[id]);
+    }
+    n_zones_ = CVT_INT(zone_ids_.size());
+    // 3. Fill cell indexes, which keeps the ascending order of cells within each zone
+    cells_.resize(offsets_.back());
+    vector<int> pos(offsets_.begin(), offsets_.end() - 1);
+    for (int i = 0; i < n_cells_; i++) {
+        if (zones[i] < 0) { continue; }
+        cells_[pos[zone_seqs_[zones[i]]]++] = i;
+    }
+}
@@ -0,0 +1,162 @@
+/*!
+ * \file clsZoneIndex.h
+ * \brief Compressed Sparse Row (CSR) index of cells grouped by zones, e.g.,
+ *        subbasins, landuse, soil types, or fields, with segmented reductions.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liang-Jun Zhu
+ */
+#ifndef SEIMS_ZONE_INDEX_H
+#define SEIMS_ZONE_INDEX_H
+
+#include "basic.h"
+
+#include <vector>
+
+#include "seims.h"
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
+using namespace ccgl;
+using std::vector;
+
+/*!
+ * \class ZoneIndex
+ * \ingroup data
+ * \brief CSR-based index of valid cells grouped by integer zone IDs.
+ *
+ * The cell indexes of all zones are stored in one flat array sorted by zone,
+ * `offsets_[k]` ~ `offsets_[k + 1]` is the segment of the k-th zone.
+ * The segmented reductions (e.g., sum and mean) can be executed
+ * in parallel without private copies and critical sections.
+ *
+ * The result arrays of reductions are indexed by zone ID, i.e., the length
+ * should be at least `GetMaxZoneID() + 1`, which is coincident with
+ * the subbasin-based arrays in SEIMS modules (e.g., index 0 for the entire basin).
+ */
+class ZoneIndex: NotCopyable {
+public:
+    /*!
+     * \brief Constructor by integer zone data of valid cells
+     * \param[in] n Number of valid cells
+     * \param[in] zones Zone ID of each valid cell, the negative IDs will be ignored
+     */
+    ZoneIndex(int n, const int* zones);
+
+    /*!
+     * \brief Constructor by float zone data of valid cells, e.g., landuse or soil type raster
+     * \param[in] n Number of valid cells
+     * \param[in] zones Zone ID of each valid cell, the negative IDs will be ignored
+     */
+    ZoneIndex(int n, const FLTPT* zones);
+
+    //! Number of valid cells indexed
+    int GetCellNumber() const { return n_cells_; }
+
+    //! Number of zones
+    int GetZoneNumber() const { return n_zones_; }
+
+    //! Maximum zone ID
+    int GetMaxZoneID() const { return max_zone_id_; }
+
+    //! Zone IDs in ascending order
+    const vector<int>& GetZoneIDs() const { return zone_ids_; }
+
+    //! Get the sequence of zone in this index by zone ID, -1 if not exists
+    int GetZoneSequence(int zone_id) const;
+
+    //! Cells count of the k-th zone
+    int GetZoneCellCount(const int k) const { return offsets_[k + 1] - offsets_[k]; }
+
+    //! Cell indexes of the k-th zone
+    const int* GetZoneCells(const int k) const { return &cells_[offsets_[k]]; }
+
+    //! CSR offsets with the length of GetZoneNumber() + 1
+    const vector<int>& GetOffsets() const { return offsets_; }
+
+    //! Flat array of cell indexes sorted by zones
+    const vector<int>& GetCells() const { return cells_; }
+
+    /*!
+     * \brief Segmented reduction of the values computed by a functor for each cell.
+     *
+     * \param[in] cell_value Functor with the signature `double (int cell_index)`
+     * \param[out] sums Sum values indexed by zone ID, length >= GetMaxZoneID() + 1
+     * \param[in] average Calculate the average instead of sum
+     */
+    template <typename Func>
+    void Reduce(Func cell_value, FLTPT* sums, bool average = false) const;
+
+    /*!
+     * \brief Sum of values by zones.
+     * \param[in] values Values of all valid cells
+     * \param[out] sums Sum values indexed by zone ID, length >= GetMaxZoneID() + 1
+     */
+    template <typename T>
+    void Sum(const T* values, FLTPT* sums) const {
+        Reduce([values](const int i) { return CVT_DBL(values[i]); }, sums, false);
+    }
+
+    /*!
+     * \brief Average of values by zones.
+     * \param[in] values Values of all valid cells
+     * \param[out] means Average values indexed by zone ID, length >= GetMaxZoneID() + 1
+     */
+    template <typename T>
+    void Mean(const T* values, FLTPT* means) const {
+        Reduce([values](const int i) { return CVT_DBL(values[i]); }, means, true);
+    }
+
+private:
+    //! Build CSR arrays by counting sort
+    void Build(const vector<int>& zones);
+
+private:
+    int n_cells_;              ///< Number of valid cells
+    int n_zones_;              ///< Number of zones
+    int max_zone_id_;          ///< Maximum zone ID
+    vector<int> zone_ids_;     ///< Zone IDs in ascending order
+    vector<int> zone_seqs_;    ///< Sequence in zone_ids_ of each ID in [0, max_zone_id_], -1 for absence
+    vector<int> offsets_;      ///< CSR offsets, length n_zones_ + 1
+    vector<int> cells_;        ///< Flat cell indexes sorted by zones
+};
+
+template <typename Func>
+void ZoneIndex::Reduce(Func cell_value, FLTPT* sums, const bool average /* = false */) const {
+    int n_threads = 1;
+#ifdef SUPPORT_OMP
+    n_threads = omp_get_max_threads();
+#endif /* SUPPORT_OMP */
+    if (n_zones_ >= n_threads * 2) {
+        // Many zones, e.g., subbasins in the OpenMP version: one segment per iteration
+#pragma omp parallel for schedule(dynamic)
+        for (int k = 0; k < n_zones_; k++) {
+            double tmp = 0.;
+            for (int j = offsets_[k]; j < offsets_[k + 1]; j++) {
+                tmp += cell_value(cells_[j]);
+            }
+            int cnt = offsets_[k + 1] - offsets_[k];
+            if (average && cnt > 0) { tmp /= cnt; }
+            sums[zone_ids_[k]] = tmp;
+        }
+    } else {
+        // Few but large zones, e.g., one subbasin in the MPI version: parallel within each segment
+        for (int k = 0; k < n_zones_; k++) {
+            double tmp = 0.;
+            int start = offsets_[k];
+            int end = offsets_[k + 1];
+#pragma omp parallel for reduction(+: tmp)
+            for (int j = start; j < end; j++) {
+                tmp += cell_value(cells_[j]);
+            }
+            if (average && end > start) { tmp /= end - start; }
+            sums[zone_ids_[k]] = tmp;
+        }
+    }
+}
+
+#endif /* SEIMS_ZONE_INDEX_H */
@@ -0,0 +1,76 @@
+#include "ActiveCells.h"
+
+#include <algorithm>
+
+namespace {
+template <typename T>
+bool AddStatesTo(vector<const T*>& registered, const T* const* states, const int n_states) {
+    bool added = false;
+    for (int j = 0; j < n_states; j++) {
+        if (nullptr == states[j]) { continue; }
+        if (std::find(registered.begin(), registered.end(), states[j]) != registered.end()) { continue; }
+        registered.push_back(states[j]);
+        added = true;
+    }
+    return added;
+}
+} /* namespace */
+
+ActiveCells::ActiveCells() : n_cells_(0), refreshed_(false), count_(0) {
+}
+
+void ActiveCells::Initialize(const int n_cells) {
+    n_cells_ = n_cells > 0 ? n_cells : 0;
+    flags_.assign(n_cells_, 1);
+    listed_.assign(n_cells_, 1);
+    cells_.resize(n_cells_);
+    for (int i = 0; i < n_cells_; i++) {
+        cells_[i] = i;
+    }
+    count_.store(n_cells_, std::memory_order_release);
+    released_.clear();
+}
+
+bool ActiveCells::AddStates(const float* const* states, const int n_states) {
+    return AddStatesTo(flt_states_, states, n_states);
+}
+
+bool ActiveCells::AddStates(const double* const* states, const int n_states) {
+    return AddStatesTo(dbl_states_, states, n_states);
+}
+
+bool ActiveCells::IsWet(const int i) const {
+    for (auto it = flt_states_.begin(); it != flt_states_.end(); ++it) {
+        if ((*it)[i] > 0.f) { return true; }
+    }
+    for (auto it = dbl_states_.begin(); it != dbl_states_.end(); ++it) {
+        if ((*it)[i] > 0.) { return true; }
+    }
+    return false;
+}
+
+void ActiveCells::Update() {
+    released_.clear();
+    int changed = 0;
+#pragma omp parallel for reduction(+:changed)
+    for (int i = 0; i < n_cells_; i++) {
+        flags_[i] = IsWet(i) ? 1 : 0;
+        if (flags_[i] != listed_[i]) { changed++; }
+    }
+    if (changed == 0) { return; }
+    int count = 0;
+    for (int i = 0; i < n_cells_; i++) {
+        if (listed_[i] && !flags_[i]) { released_.push_back(i); }
+        listed_[i] = flags_[i];
+        if (listed_[i]) { cells_[count++] = i; }
+    }
+    count_.store(count, std::memory_order_release);
+}
+
+void ActiveCells::Activate(const int i) {
+    if (flags_[i]) { return; }
+    flags_[i] = 1;
+    if (listed_[i]) { return; }
+    listed_[i] = 1;
+    cells_[count_.fetch_add(1, std::memory_order_acq_rel)] = i;
+}
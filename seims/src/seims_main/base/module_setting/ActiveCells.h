@@ -0,0 +1,170 @@
+/*!
+ * \file ActiveCells.h
+ * \brief Active cells that carry water in current step, which are iterated by modules instead of all cells.
+ *
+ *        On dry days, and in most of the subhourly steps of storm simulation, only a fraction of cells
+ *        carry water, whereas the runoff and erosion modules (e.g., SUR_CN, SERO_MUSLE, and IKW_OL)
+ *        compute zero outputs for the others. The active cells are shared by the modules of a
+ *        (sub)watershed, which are maintained by ModelMain, i.e., refreshed once per hillslope step from
+ *        the states of precipitation, ponding depth, and overland flow registered by the modules,
+ *        see SimulationModule::RefreshActiveCells().
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Shared by modules and refreshed once per step in parallel, any floating-point states.
+ *
+ * \author Liang-Jun Zhu
+ */
+#ifndef SEIMS_ACTIVE_CELLS_H
+#define SEIMS_ACTIVE_CELLS_H
+
+#include <atomic>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+using namespace ccgl;
+using std::vector;
+
+/*!
+ * \ingroup module_setting
+ * \class ActiveCells
+ * \brief Flags and compact indexes of the cells that carry water.
+ *
+ *        A cell is active if any of the registered states is positive, i.e., the union of the states
+ *        of all modules sharing the active cells. The states are registered by the first refresh of
+ *        each module, and evaluated by the first refresh of each step, see NextStep().
+ *        The later refreshes of the same step only add the cells of newly registered states.
+ *
+ *        The flags are updated in place by a parallel scan, while the compact indexes are rebuilt
+ *        only if any cell enters or leaves the active cells. The cells activated during the step
+ *        (e.g., by upstream inflow) are appended to the compact indexes. The cells left by the
+ *        last refresh are kept, which should be reset to the dry state by each module.
+ *
+ * \code
+ *      ActiveCells* active = new ActiveCells();
+ *      active->NextStep(); // by ModelMain before the hillslope modules of each step
+ *      const float* states[2] = {pcp, ponding};
+ *      int n = active->Refresh(n_cells, states, 2);
+ *      for (int i = 0; i < n; i++) {
+ *          int icell = active->Cells()[i];
+ *      }
+ * \endcode
+ */
+class ActiveCells: NotCopyable {
+public:
+    //! Constructor, the cells are allocated by the first refresh, all of them are active initially
+    ActiveCells();
+
+    //! Start a new step, the registered states will be evaluated by the next refresh
+    void NextStep() { refreshed_ = false; }
+
+    /*!
+     * \brief Register the states and refresh the active cells of current step if not yet
+     * \param[in] n_cells Cells number
+     * \param[in] states State arrays that carry water, nullptr is ignored
+     * \param[in] n_states Number of state arrays
+     * \return Number of active cells
+     */
+    template <typename T>
+    int Refresh(int n_cells, const T* const* states, int n_states);
+
+    //! Cells number
+    int CellsNumber() const { return n_cells_; }
+
+    //! Number of active cells, including the ones activated in current step
+    int Count() const { return count_.load(std::memory_order_acquire); }
+
+    //! Compact indexes of active cells, ascending order except the ones activated in current step
+    const int* Cells() const { return cells_.empty() ? nullptr : &cells_[0]; }
+
+    //! Cells that left the active cells by the last refresh
+    const vector<int>& Released() const { return released_; }
+
+    //! Is the cell active
+    bool IsActive(const int i) const { return flags_[i] != 0; }
+
+    /*!
+     * \brief Activate the dry cell in current step, e.g., it receives flow from upstream cells.
+     *        The cell is appended to the compact indexes. Each cell should be activated by one thread only.
+     */
+    void Activate(int i);
+
+    //! Number of inactive cells with nonzero values, i.e., mismatch the dry state
+    template <typename T>
+    int CountMismatched(const T* data) const;
+
+private:
+    //! Allocate the cells, all of them are active
+    void Initialize(int n_cells);
+
+    //! Register the states, \return True if any of them is new
+    bool AddStates(const float* const* states, int n_states);
+
+    bool AddStates(const double* const* states, int n_states);
+
+    //! Is any of the registered states positive
+    bool IsWet(int i) const;
+
+    //! Evaluate all registered states, and rebuild the compact indexes if changed
+    void Update();
+
+    //! Activate the cells with any of the states positive, i.e., added to current step
+    template <typename T>
+    void Extend(const T* const* states, int n_states);
+
+private:
+    int n_cells_;                   ///< Cells number
+    bool refreshed_;                ///< Has current step been refreshed
+    vector<const float*> flt_states_;  ///< Registered states of float
+    vector<const double*> dbl_states_; ///< Registered states of double
+    vector<char> flags_;            ///< Active flags of current step
+    vector<char> listed_;           ///< Flags of the cells in compact indexes
+    vector<int> cells_;             ///< Compact indexes of active cells, length: n_cells_
+    std::atomic<int> count_;        ///< Number of compact indexes
+    vector<int> released_;          ///< Cells left by the last refresh
+};
+
+template <typename T>
+int ActiveCells::Refresh(const int n_cells, const T* const* states, const int n_states) {
+    if (n_cells != n_cells_) {
+        Initialize(n_cells);
+        refreshed_ = false;
+    }
+    bool added = AddStates(states, n_states);
+    if (!refreshed_) {
+        Update();
+        refreshed_ = true;
+    } else if (added) {
+        Extend(states, n_states);
+    }
+    return Count();
+}
+
+template <typename T>
+void ActiveCells::Extend(const T* const* states, const int n_states) {
+#pragma omp parallel for
+    for (int i = 0; i < n_cells_; i++) {
+        if (flags_[i]) { continue; }
+        for (int j = 0; j < n_states; j++) {
+            if (nullptr != states[j] && states[j][i] > 0.) {
+                Activate(i);
+                break;
+            }
+        }
+    }
+}
+
+template <typename T>
+int ActiveCells::CountMismatched(const T* data) const {
+    if (nullptr == data) { return 0; }
+    int count = 0;
+#pragma omp parallel for reduction(+:count)
+    for (int i = 0; i < n_cells_; i++) {
+        if (!flags_[i] && data[i] != 0.) { count++; }
+    }
+    return count;
+}
+
+#endif /* SEIMS_ACTIVE_CELLS_H */
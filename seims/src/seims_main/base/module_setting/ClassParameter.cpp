@@ -0,0 +1,137 @@
+#include "ClassParameter.h"
+
+#include <cstring>
+#include <map>
+
+#include "utils_array.h"
+
+using namespace utils_array;
+using std::map;
+
+ClassParameter::ClassParameter(const int n, const int lyrs, const bool is_2d) :
+    n_cells_(n), n_lyrs_(lyrs), is_2d_(is_2d), n_classes_(0),
+    ids_(nullptr), values_(nullptr), values2d_(nullptr) {
+}
+
+ClassParameter::~ClassParameter() {
+    if (nullptr != values_) { Release1DArray(values_); }
+    if (nullptr != values2d_) { Release2DArray(values2d_); }
+}
+
+ClassParameter* ClassParameter::Compress(const int n, const FLTPT* data, const int max_classes
+                                         /* = CLASS_PARAM_MAX_CLASSES */) {
+    if (n <= 0 || nullptr == data) { return nullptr; }
+    ClassParameter* cls = new ClassParameter(n, 1, false);
+    if (!cls->Assign(data, nullptr, max_classes) || !cls->IsWorthy()) {
+        delete cls;
+        return nullptr;
+    }
+    return cls;
+}
+
+ClassParameter* ClassParameter::Compress(const int n, const int lyrs, const FLTPT* const* data,
+                                         const int max_classes /* = CLASS_PARAM_MAX_CLASSES */) {
+    if (n <= 0 || lyrs <= 0 || nullptr == data) { return nullptr; }
+    ClassParameter* cls = new ClassParameter(n, lyrs, true);
+    if (!cls->Assign(nullptr, data, max_classes) || !cls->IsWorthy()) {
+        delete cls;
+        return nullptr;
+    }
+    return cls;
+}
+
+bool ClassParameter::Assign(const FLTPT* values, const FLTPT* const* rows, const int max_classes) {
+    int limit = max_classes < CLASS_PARAM_MAX_CLASSES ? max_classes : CLASS_PARAM_MAX_CLASSES;
+    size_t row_bytes = n_lyrs_ * sizeof(FLTPT);
+    own_ids_.resize(n_cells_);
+    // The classes with the same hash of layer values are chained by `next`
+    map<vuint64_t, int> heads;
+    vector<int> next;
+    for (int i = 0; i < n_cells_; i++) {
+        const FLTPT* row = nullptr != rows ? rows[i] : values + i;
+        // FNV-1a hash of the bytes of layer values
+        vuint64_t hash = 14695981039346656037ULL;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(row);
+        for (size_t b = 0; b < row_bytes; b++) {
+            hash = (hash ^ bytes[b]) * 1099511628211ULL;
+        }
+        int found = -1;
+        auto it = heads.find(hash);
+        if (it != heads.end()) {
+            for (int k = it->second; k >= 0; k = next[k]) {
+                if (memcmp(&table_[k * n_lyrs_], row, row_bytes) == 0) {
+                    found = k;
+                    break;
+                }
+            }
+        }
+        if (found < 0) {
+            if (n_classes_ >= limit) {
+                own_ids_.clear();
+                table_.clear();
+                n_classes_ = 0;
+                return false;
+            }
+            found = n_classes_++;
+            table_.insert(table_.end(), row, row + n_lyrs_);
+            if (it != heads.end()) {
+                next.push_back(it->second);
+                it->second = found;
+            } else {
+                next.push_back(-1);
+                heads[hash] = found;
+            }
+        }
+        own_ids_[i] = static_cast<vuint16_t>(found);
+    }
+    ids_ = &own_ids_[0];
+    return true;
+}
+
+bool ClassParameter::IsWorthy() const {
+    vint64_t full = CVT_VINT(n_cells_) * n_lyrs_ * sizeof(FLTPT);
+    if (is_2d_) { full += CVT_VINT(n_cells_) * sizeof(FLTPT*); }
+    return GetMemorySize() < full;
+}
+
+FLTPT* ClassParameter::Expand() {
+    if (is_2d_) { return nullptr; }
+    if (nullptr == values_) {
+        Initialize1DArray(n_cells_, values_, 0.);
+        for (int i = 0; i < n_cells_; i++) {
+            values_[i] = table_[ids_[i]];
+        }
+    }
+    return values_;
+}
+
+FLTPT** ClassParameter::Expand2D() {
+    if (!is_2d_) { return nullptr; }
+    if (nullptr == values2d_) {
+        Initialize2DArray(n_cells_, n_lyrs_, values2d_, 0.);
+        for (int i = 0; i < n_cells_; i++) {
+            const FLTPT* row = &table_[ids_[i] * n_lyrs_];
+            for (int j = 0; j < n_lyrs_; j++) {
+                values2d_[i][j] = row[j];
+            }
+        }
+    }
+    return values2d_;
+}
+
+bool ClassParameter::ShareClassIDs(const ClassParameter* other) {
+    if (nullptr == other || other == this || !other->OwnsClassIDs() || !OwnsClassIDs()) { return false; }
+    if (other->n_cells_ != n_cells_ || other->n_classes_ != n_classes_) { return false; }
+    if (memcmp(other->ids_, ids_, n_cells_ * sizeof(vuint16_t)) != 0) { return false; }
+    ids_ = other->ids_;
+    vector<vuint16_t>().swap(own_ids_);
+    return true;
+}
+
+vint64_t ClassParameter::GetMemorySize() const {
+    vint64_t size = CVT_VINT(table_.size()) * sizeof(FLTPT);
+    size += CVT_VINT(own_ids_.size()) * sizeof(vuint16_t);
+    if (nullptr != values_) { size += CVT_VINT(n_cells_) * sizeof(FLTPT); }
+    if (nullptr != values2d_) { size += CVT_VINT(n_cells_) * (n_lyrs_ * sizeof(FLTPT) + sizeof(FLTPT*)); }
+    return size;
+}
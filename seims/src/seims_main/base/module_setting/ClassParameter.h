@@ -0,0 +1,215 @@
+/*!
+ * \file ClassParameter.h
+ * \brief Class-indexed parameter rasters, i.e., a small table of class values and the class ID of each cell.
+ *
+ *        Many parameter rasters are functions of a few classes, e.g., CN2 of landuse and soil
+ *        hydrologic group, and plant parameters of the crop lookup table. Instead of the full
+ *        array of all cells, the distinct values (or distinct layer values of 2D raster) are kept
+ *        as the class table, and the class IDs of cells are shared by the parameters with the same
+ *        partition of cells. The full array is materialized only if the values are adjusted
+ *        spatially, e.g., by the areal BMPs of scenario.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liang-Jun Zhu
+ */
+#ifndef SEIMS_CLASS_PARAMETER_H
+#define SEIMS_CLASS_PARAMETER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+using namespace ccgl;
+using std::vector;
+
+/*! Maximum number of classes of one parameter raster, limited by the 2-byte class ID */
+const int CLASS_PARAM_MAX_CLASSES = 65535;
+
+/*!
+ * \ingroup module_setting
+ * \class ClassParameter
+ * \brief Read-only 1D or 2D parameter raster indexed by classes.
+ *
+ *        The class IDs are assigned by the first occurrence of the distinct values, thus two
+ *        parameters with the same partition of cells have the same class IDs, which are shared by
+ *        ShareClassIDs(). The owner of the shared class IDs should be released after the others.
+ *
+ *        Expand() and Expand2D() are not thread-safe, which should be called while setting data or
+ *        updating scenario, the values read by GetValue() and GetRow() are updated accordingly.
+ *
+ * \code
+ *      ClassParameter* cn2 = ClassParameter::Compress(n, cn2_data);
+ *      if (nullptr != cn2) {
+ *          FLTPT v = cn2->GetValue(i);
+ *          FLTPT* data = cn2->Expand(); // full array to be adjusted spatially
+ *      }
+ * \endcode
+ */
+class ClassParameter: NotCopyable {
+public:
+    /*!
+     * \brief Compress 1D raster data
+     * \param[in] n Number of valid cells
+     * \param[in] data Values of cells
+     * \param[in] max_classes Maximum number of classes, which is limited to CLASS_PARAM_MAX_CLASSES
+     * \return nullptr if too many classes or the class-indexed data are not smaller than the raster
+     */
+    static ClassParameter* Compress(int n, const FLTPT* data, int max_classes = CLASS_PARAM_MAX_CLASSES);
+
+    /*!
+     * \brief Compress 2D raster data, the classes are the distinct layer values of cells
+     * \param[in] n Number of valid cells
+     * \param[in] lyrs Number of layers
+     * \param[in] data Values of cells, `data[i][j]` is the j-th layer of i-th cell
+     * \param[in] max_classes Maximum number of classes, which is limited to CLASS_PARAM_MAX_CLASSES
+     * \return nullptr if too many classes or the class-indexed data are not smaller than the raster
+     */
+    static ClassParameter* Compress(int n, int lyrs, const FLTPT* const* data,
+                                    int max_classes = CLASS_PARAM_MAX_CLASSES);
+
+    //! Destructor
+    ~ClassParameter();
+
+    //! Number of valid cells
+    int GetCellNumber() const { return n_cells_; }
+
+    //! Number of layers, 1 for 1D raster
+    int GetLayers() const { return n_lyrs_; }
+
+    //! Is 2D raster
+    bool Is2DRaster() const { return is_2d_; }
+
+    //! Number of classes
+    int GetClassNumber() const { return n_classes_; }
+
+    //! Class ID of cell
+    int GetClassID(const int i) const { return ids_[i]; }
+
+    //! Values of classes, `GetClassNumber() * GetLayers()` values in class order
+    const vector<FLTPT>& GetClassValues() const { return table_; }
+
+    //! Value of 1D raster
+    FLTPT GetValue(const int i) const { return nullptr != values_ ? values_[i] : table_[ids_[i]]; }
+
+    //! Layer values of 2D raster
+    const FLTPT* GetRow(const int i) const {
+        return nullptr != values2d_ ? values2d_[i] : &table_[ids_[i] * n_lyrs_];
+    }
+
+    //! Is the full array materialized
+    bool IsExpanded() const { return nullptr != values_ || nullptr != values2d_; }
+
+    //! Materialize the full array of 1D raster if not yet
+    FLTPT* Expand();
+
+    //! Materialize the full array of 2D raster if not yet
+    FLTPT** Expand2D();
+
+    /*!
+     * \brief Reference the class IDs of the other parameter if they have the same partition of cells
+     * \return True if shared
+     */
+    bool ShareClassIDs(const ClassParameter* other);
+
+    //! Are the class IDs owned by this parameter
+    bool OwnsClassIDs() const { return !own_ids_.empty(); }
+
+    //! Memory size in bytes, excluding the shared class IDs
+    vint64_t GetMemorySize() const;
+
+private:
+    //! Constructor, which is called by Compress() only
+    ClassParameter(int n, int lyrs, bool is_2d);
+
+    //! Assign class IDs, the row of i-th cell is `rows[i]` or `values + i * lyrs`
+    bool Assign(const FLTPT* values, const FLTPT* const* rows, int max_classes);
+
+    //! Class-indexed data are smaller than the full raster or not
+    bool IsWorthy() const;
+
+private:
+    int n_cells_;              ///< Number of valid cells
+    int n_lyrs_;               ///< Number of layers
+    bool is_2d_;               ///< Is 2D raster
+    int n_classes_;            ///< Number of classes
+    vector<FLTPT> table_;      ///< Values of classes
+    vector<vuint16_t> own_ids_; ///< Class IDs owned by this parameter, empty if shared
+    const vuint16_t* ids_;     ///< Class IDs of cells, owned or shared
+    FLTPT* values_;            ///< Materialized values of 1D raster
+    FLTPT** values2d_;         ///< Materialized values of 2D raster
+};
+
+/*!
+ * \ingroup module_setting
+ * \class ParamRaster1D
+ * \brief Read-only accessor of 1D parameter raster, either a full array or class-indexed,
+ *        which can be used by modules as `FLTPT*`, e.g., `m_cn2[i]` and `CHECK_POINTER(M_XXX[0], m_cn2)`.
+ */
+class ParamRaster1D {
+public:
+    ParamRaster1D() : data_(nullptr), cls_(nullptr) {}
+
+    //! Set full array
+    void Set(FLTPT* data) {
+        data_ = data;
+        cls_ = nullptr;
+    }
+
+    //! Set class-indexed data
+    void Set(const ClassParameter* cls) {
+        data_ = nullptr;
+        cls_ = cls;
+    }
+
+    bool IsNull() const { return nullptr == data_ && nullptr == cls_; }
+
+    FLTPT operator[](const int i) const { return nullptr != cls_ ? cls_->GetValue(i) : data_[i]; }
+
+private:
+    FLTPT* data_;               ///< Full array
+    const ClassParameter* cls_; ///< Class-indexed data
+};
+
+/*!
+ * \ingroup module_setting
+ * \class ParamRaster2D
+ * \brief Read-only accessor of 2D parameter raster, either a full array or class-indexed,
+ *        which can be used by modules as `FLTPT**`, e.g., `m_soilClay[i][j]`.
+ */
+class ParamRaster2D {
+public:
+    ParamRaster2D() : data_(nullptr), cls_(nullptr) {}
+
+    //! Set full array
+    void Set(FLTPT** data) {
+        data_ = data;
+        cls_ = nullptr;
+    }
+
+    //! Set class-indexed data
+    void Set(const ClassParameter* cls) {
+        data_ = nullptr;
+        cls_ = cls;
+    }
+
+    bool IsNull() const { return nullptr == data_ && nullptr == cls_; }
+
+    const FLTPT* operator[](const int i) const { return nullptr != cls_ ? cls_->GetRow(i) : data_[i]; }
+
+private:
+    FLTPT** data_;              ///< Full array
+    const ClassParameter* cls_; ///< Class-indexed data
+};
+
+inline bool operator==(std::nullptr_t, const ParamRaster1D& data) { return data.IsNull(); }
+inline bool operator==(const ParamRaster1D& data, std::nullptr_t) { return data.IsNull(); }
+inline bool operator!=(const ParamRaster1D& data, std::nullptr_t) { return !data.IsNull(); }
+inline bool operator==(std::nullptr_t, const ParamRaster2D& data) { return data.IsNull(); }
+inline bool operator==(const ParamRaster2D& data, std::nullptr_t) { return data.IsNull(); }
+inline bool operator!=(const ParamRaster2D& data, std::nullptr_t) { return !data.IsNull(); }
+
+#endif /* SEIMS_CLASS_PARAMETER_H */
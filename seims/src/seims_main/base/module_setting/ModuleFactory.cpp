@@ -203,6 +203,8 @@ ModuleFactory::~ModuleFactory() {
     m_tfValueInputs.clear();
 
     CLOG(TRACE, LOG_RELEASE) << "---release dynamic library handles ...";
+    // The buffered messages of modules refer to the strings of libraries, e.g., the source file names
+    if (nullptr != LogBuffer::Context().buffer) { LogBuffer::Context().buffer->Drain(); }
     for (vector<DLLINSTANCE>::iterator dllit = m_dllHandles.begin(); dllit != m_dllHandles.end(); ) {
 #ifdef WIN32
         FreeLibrary(*dllit);
@@ -345,6 +347,7 @@ void ModuleFactory::CreateModuleList(vector<SimulationModule *>& modules, const
     for (auto it = m_moduleIDs.begin(); it != m_moduleIDs.end(); ++it) {
         SimulationModule* pModule = GetInstance(*it);
         pModule->SetTheadNumber(nthread);
+        pModule->SetLogContext(LogBuffer::ActiveContext());
         modules.emplace_back(pModule);
     }
 }
@@ -5,6 +5,7 @@
  * Changelog:
  *   - 1. 2017-05-30 - lj - Refactor and DeCoupling with Database I/O.
  *   - 2. 2022-08-19 - lj - Separate integer and floating point of parameter, input, output, and inoutput.
+ *   - 3. 2026-10-19 - lj - Share the log context with modules.
  *
  * \author Junzhi Liu, LiangJun Zhu
  * \version 2.1
@@ -0,0 +1,73 @@
+#include "SimulationCalendar.h"
+
+#include <cmath>
+#include <map>
+
+#include "utils_time.h"
+#include "ClimateParams.h"
+
+using namespace utils_time;
+using std::map;
+
+SimulationCalendar::SimulationCalendar(const FLTPT band_width /* = LAT_BAND_WIDTH */) :
+    band_width_(band_width > 0. ? band_width : LAT_BAND_WIDTH), date_(-1), year_idx_(-1),
+    year_(1900), month_(-1), day_(-1), day_of_year_(-1), geometry_year_(-1), geometry_day_(-1),
+    n_cells_(-1), cell_lats_(nullptr) {
+}
+
+bool SimulationCalendar::SetLatitudes(const int n_cells, const FLTPT* lats) {
+    if (n_cells <= 0 || nullptr == lats) { return false; }
+    n_cells_ = n_cells;
+    cell_lats_ = lats;
+    cell_bands_.assign(n_cells, 0);
+    band_lats_.clear();
+    map<vint, int> band_keys; // key of latitude band -> band index
+    for (int i = 0; i < n_cells; i++) {
+        vint key = CVT_VINT(floor(lats[i] / band_width_ + 0.5));
+        auto it = band_keys.find(key);
+        if (it != band_keys.end()) {
+            cell_bands_[i] = it->second;
+            continue;
+        }
+        cell_bands_[i] = CVT_INT(band_lats_.size());
+        band_keys[key] = cell_bands_[i];
+        band_lats_.emplace_back(static_cast<FLTPT>(key) * band_width_);
+    }
+    band_daylen_.assign(band_lats_.size(), 0.);
+    band_maxsr_.assign(band_lats_.size(), 0.);
+    geometry_day_ = -1;
+    if (day_of_year_ > 0) { UpdateSolarGeometry(); }
+    return true;
+}
+
+void SimulationCalendar::Update(const time_t t, const int year_idx) {
+    year_idx_ = year_idx;
+    if (t == date_) { return; }
+    date_ = t;
+    struct tm date_info;
+    LocalTime(date_, &date_info);
+    year_ = date_info.tm_year + 1900;
+    month_ = date_info.tm_mon + 1;
+    day_ = date_info.tm_mday;
+    day_of_year_ = date_info.tm_yday + 1;
+    if (day_of_year_ != geometry_day_ || year_ != geometry_year_) { UpdateSolarGeometry(); }
+}
+
+void SimulationCalendar::UpdateSolarGeometry() {
+    int n_bands = CVT_INT(band_lats_.size());
+    for (int i = 0; i < n_bands; i++) {
+        MaxSolarRadiation(day_of_year_, band_lats_[i], band_daylen_[i], band_maxsr_[i]);
+    }
+    geometry_year_ = year_;
+    geometry_day_ = day_of_year_;
+}
+
+void SimulationCalendar::GetMaxSolarRadiation(const int i, const FLTPT* lats,
+                                              FLTPT& day_l, FLTPT& max_sr) const {
+    if (SharesLatitudes(lats) && i < n_cells_) {
+        day_l = band_daylen_[cell_bands_[i]];
+        max_sr = band_maxsr_[cell_bands_[i]];
+        return;
+    }
+    MaxSolarRadiation(day_of_year_, lats[i], day_l, max_sr);
+}
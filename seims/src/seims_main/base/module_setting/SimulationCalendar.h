@@ -0,0 +1,116 @@
+/*!
+ * \file SimulationCalendar.h
+ * \brief Date and solar geometry of current step shared by all modules.
+ *
+ *        The date fields (e.g., year, month, and day of year) are derived once for each step instead of
+ *        by each module, and the daily solar geometry (i.e., day length and maximum solar radiation)
+ *        is calculated once for each day and each latitude band instead of for each cell by each
+ *        module, e.g., PET_H, PET_PT, and PET_PM.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liang-Jun Zhu
+ */
+#ifndef SEIMS_SIMULATION_CALENDAR_H
+#define SEIMS_SIMULATION_CALENDAR_H
+
+#include <ctime>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+
+using namespace ccgl;
+using std::vector;
+
+/*!
+ * \ingroup module_setting
+ * \brief Default width (degree) of latitude bands, about 110 m in the meridian direction.
+ *        The day length differs less than 0.001 hr within one band.
+ */
+const FLTPT LAT_BAND_WIDTH = 0.001;
+
+/*!
+ * \ingroup module_setting
+ * \class SimulationCalendar
+ * \brief Read-only date and solar geometry of current step for modules.
+ *
+ *        The latitudes of cells are grouped into bands of the same width, and the solar geometry of
+ *        each band is updated when the day changes. The module looks up the band of the cell only if
+ *        the latitudes are the ones set to the calendar, otherwise falls back to calculate by cell.
+ *
+ * \code
+ *      SimulationCalendar* calendar = new SimulationCalendar();
+ *      calendar->SetLatitudes(n_cells, cell_lat);
+ *      for (time_t t = start; t <= end; t += dt) {
+ *          calendar->Update(t, year_idx);
+ *          p_module->SetCalendar(calendar);
+ *          p_module->Execute(); // calendar->GetMaxSolarRadiation(i, cell_lat, day_len, max_sr);
+ *      }
+ * \endcode
+ */
+class SimulationCalendar: NotCopyable {
+public:
+    //! Constructor
+    explicit SimulationCalendar(FLTPT band_width = LAT_BAND_WIDTH);
+
+    /*!
+     * \brief Set latitudes (degree) of valid cells and group them into latitude bands
+     * \param[in] n_cells Cells number
+     * \param[in] lats Latitudes of cells, which should be alive during the simulation
+     * \return False if the latitudes are not available
+     */
+    bool SetLatitudes(int n_cells, const FLTPT* lats);
+
+    /*!
+     * \brief Update date of current step, the solar geometry is updated if the day changes
+     * \param[in] t Date time
+     * \param[in] year_idx Index of current year of simulation
+     */
+    void Update(time_t t, int year_idx);
+
+    time_t GetDate() const { return date_; } ///< Date time
+    int GetYearIndex() const { return year_idx_; } ///< Index of current year of simulation
+    int GetYear() const { return year_; } ///< Year
+    int GetMonth() const { return month_; } ///< Month since January - [1,12]
+    int GetDay() const { return day_; } ///< Day of the month - [1,31]
+    int GetDayOfYear() const { return day_of_year_; } ///< Day of year - [1,366]
+    int GetBandNumber() const { return CVT_INT(band_lats_.size()); } ///< Number of latitude bands
+
+    //! Are the latitudes the ones set to the calendar?
+    bool SharesLatitudes(const FLTPT* lats) const { return nullptr != lats && lats == cell_lats_; }
+
+    /*!
+     * \brief Day length (hr) and maximum solar radiation (MJ/m2/d) of the cell in current day,
+     *        \sa MaxSolarRadiation()
+     * \param[in] i Cell index
+     * \param[in] lats Latitudes of cells used by the module
+     * \param[out] day_l Day length
+     * \param[out] max_sr Maximum solar radiation
+     */
+    void GetMaxSolarRadiation(int i, const FLTPT* lats, FLTPT& day_l, FLTPT& max_sr) const;
+
+private:
+    //! Update day length and maximum solar radiation of all latitude bands
+    void UpdateSolarGeometry();
+
+private:
+    FLTPT band_width_;          ///< Width of latitude bands (degree)
+    time_t date_;               ///< Date time
+    int year_idx_;              ///< Index of current year of simulation
+    int year_;                  ///< Year
+    int month_;                 ///< Month
+    int day_;                   ///< Day of the month
+    int day_of_year_;           ///< Day of year
+    int geometry_year_;         ///< Year of the solar geometry
+    int geometry_day_;          ///< Day of year of the solar geometry
+    int n_cells_;               ///< Cells number
+    const FLTPT* cell_lats_;    ///< Latitudes of cells, not owned
+    vector<int> cell_bands_;    ///< Latitude band index of cells
+    vector<FLTPT> band_lats_;   ///< Central latitude of bands
+    vector<FLTPT> band_daylen_; ///< Day length of bands
+    vector<FLTPT> band_maxsr_;  ///< Maximum solar radiation of bands
+};
+
+#endif /* SEIMS_SIMULATION_CALENDAR_H */
@@ -1,13 +1,22 @@
 #include "SimulationModule.h"
 
+#include "ClimateParams.h"
+
 using std::string;
 
 SimulationModule::SimulationModule() :
     m_date(-1), m_yearIdx(-1), m_year(1900), m_month(-1), m_day(-1), m_dayOfYear(-1),
-    m_tsCounter(1), m_inputsSetDone(false), m_reCalIntermediates(true) {
+    m_tsCounter(1), m_inputsSetDone(false), m_reCalIntermediates(true),
+    m_activeCellsMode(ACTIVE_CELLS_OFF), m_activeCells(nullptr), m_ownActiveCells(false),
+    m_activeCellIdxs(nullptr), m_calendar(nullptr) {
     // Do nothing
 }
 
+SimulationModule::~SimulationModule() {
+    if (m_ownActiveCells) { delete m_activeCells; }
+    m_activeCells = nullptr;
+}
+
 void SimulationModule::SetDate(const time_t t, const int year_idx) {
     m_date = t;
     m_yearIdx = year_idx;
@@ -20,6 +29,26 @@ void SimulationModule::SetDate(const time_t t, const int year_idx) {
     delete date_info;
 }
 
+void SimulationModule::SetCalendar(const SimulationCalendar* calendar) {
+    m_calendar = calendar;
+    if (nullptr == calendar) { return; }
+    m_date = calendar->GetDate();
+    m_yearIdx = calendar->GetYearIndex();
+    m_year = calendar->GetYear();
+    m_month = calendar->GetMonth();
+    m_day = calendar->GetDay();
+    m_dayOfYear = calendar->GetDayOfYear();
+}
+
+void SimulationModule::CellMaxSolarRadiation(const int i, const FLTPT* lats,
+                                             FLTPT& day_l, FLTPT& max_sr) const {
+    if (nullptr != m_calendar && m_calendar->GetDayOfYear() == m_dayOfYear) {
+        m_calendar->GetMaxSolarRadiation(i, lats, day_l, max_sr);
+        return;
+    }
+    MaxSolarRadiation(m_dayOfYear, lats[i], day_l, max_sr);
+}
+
 
 bool SimulationModule::CheckInputSize(const char* module_id, const char* key, const int nrows, int& m_nrows) {
     if (nrows <= 0) {
@@ -43,3 +72,28 @@ bool SimulationModule::CheckInputSize2D(const char* module_id, const char* key,
                                         int& m_nrows, int& m_ncols) {
     return CheckInputSize(module_id, key, nrows, m_nrows) && CheckInputSize(module_id, key, ncols, m_ncols);
 }
+
+void SimulationModule::SetActiveCells(ActiveCells* active_cells) {
+    if (m_ownActiveCells) { delete m_activeCells; }
+    m_activeCells = active_cells;
+    m_ownActiveCells = false;
+}
+
+bool SimulationModule::PrepareActiveCells() {
+    m_activeCellIdxs = nullptr;
+    if (m_activeCellsMode == ACTIVE_CELLS_OFF) { return false; }
+    if (nullptr == m_activeCells) {
+        // Not shared by ModelMain, e.g., the module is executed alone
+        m_activeCells = new ActiveCells();
+        m_ownActiveCells = true;
+    }
+    if (m_ownActiveCells) { m_activeCells->NextStep(); }
+    return true;
+}
+
+void SimulationModule::ThrowInactiveCellsMismatched(const char* module_id, const char* key, const int count) const {
+    throw ModelException(module_id, "CheckInactiveCells",
+                         string(key) + " of " + ValueToString(count) +
+                         " inactive cells mismatch the results of iterating active cells only on " +
+                         ConvertToString2(m_date) + ".");
+}
@@ -8,6 +8,11 @@
  *   - 3. 2018-03-03 - lj - Add CHECK_XXX series macros for data checking.
  *   - 4. 2020-09-18 - lj - Using Easyloggingpp
  *   - 5. 2021-10-29 - ss,lj - Add InitialIntermediates to initialize intermediate params.
+ *   - 6. 2026-10-19 - lj - Add active-cell tracking to skip dry cells.
+ *   - 7. 2026-10-19 - lj - Date and solar geometry shared by SimulationCalendar.
+ *   - 8. 2026-10-19 - lj - Add SetClassData for class-indexed parameter rasters.
+ *   - 9. 2026-10-19 - lj - Share the log context of the main program for SLOG/SCLOG in modules.
+ *   - 10. 2026-10-19 - lj - Active cells are shared by modules, and templated on the type of states.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
@@ -19,6 +24,10 @@
 #include "Scenario.h"
 #include "clsReach.h"
 #include "clsSubbasin.h"
+#include "ActiveCells.h"
+#include "SimulationCalendar.h"
+#include "ClassParameter.h"
+#include "LogBuffer.h"
 
 #include <string>
 #include <ctime>
@@ -48,17 +57,34 @@ public:
     //! Constructor
     SimulationModule();
 
+    //! Destructor
+    ~SimulationModule();
+
     //! Execute the simulation. Return 0 for success.
     virtual int Execute() { return -1; }
 
     //! Set date time, as well as the sequence number of the entire simulation. Added by LJ for statistics convenient.
     virtual void SetDate(time_t t, int year_idx);
 
+    /*!
+     * \brief Set the calendar shared by modules, as well as the date of current step,
+     *        which avoids deriving date fields by each module, \sa SimulationCalendar
+     */
+    void SetCalendar(const SimulationCalendar* calendar);
+
     //! Set thread number for OpenMP
     virtual void SetTheadNumber(const int thread_num) {
         SetOpenMPThread(thread_num);
     }
 
+    /*!
+     * \brief Share the log context of the main program, i.e., level, buffer, and sink of SLOG/SCLOG.
+     *        It is virtual to be executed on the copy of LogBuffer in the module library.
+     */
+    virtual void SetLogContext(const LogContext* ctx) {
+        LogBuffer::ShareContext(ctx);
+    }
+
     //! Set climate data type, P, M, PET etc.
     virtual void SetClimateDataType(int data_type) {
     }
@@ -99,6 +125,13 @@ public:
                              "Set function of parameter " + string(key) + " is not implemented.");
     }
 
+    /*!
+     * \brief Set class-indexed 1D or 2D raster data, see ClassParameter.
+     *        The module that reads the parameter by ParamRaster1D or ParamRaster2D should override it.
+     * \return False if not supported, then the full array will be set by Set1DData() or Set2DData()
+     */
+    virtual bool SetClassData(const char* key, const ClassParameter* data) { return false; }
+
     //! Set 2D data, by default, DT_Raster2D, integer
     virtual void Set2DData(const char* key, int nrows, int ncols, int** data) {
         throw ModelException("SimulationModule", "Set2DData",
@@ -239,6 +272,12 @@ public:
     //! set whether intermediate parameters need to recalculated
     void SetReCalIntermediates(const bool recal) { m_reCalIntermediates = recal; }
 
+    //! Set active-cell tracking mode, which is used by the modules calling RefreshActiveCells()
+    void SetActiveCellsMode(const ActiveCellsMode mode) { m_activeCellsMode = mode; }
+
+    //! Set the active cells shared by the modules of the (sub)watershed, which are not owned by the module
+    void SetActiveCells(ActiveCells* active_cells);
+
 	// set 1D Array which contains position data of raster
 	virtual void SetRasterPositionDataPointer(const char* key, int** positions) {
 		throw ModelException("SimulationModule", "SetRasterPositionDataPointer",
@@ -262,6 +301,88 @@ public:
 	//}
 
 
+protected:
+    /*!
+     * \brief Refresh the active cells of current step before iterating cells, see ActiveCells.
+     *
+     *        The states are registered to the active cells shared by modules, which are evaluated once
+     *        per step, i.e., the active cells are the union of the states of all modules.
+     *        The module should reset the released cells to the dry state by ResetReleasedCells(),
+     *        and iterate cells by ActiveCellIndex(). The routing modules may skip the dry cells
+     *        without upstream inflow by IsDryCell() instead.
+     *
+     * \code
+     *      const FLTPT* states[2] = {m_pcp, m_ponding};
+     *      int n_iter = RefreshActiveCells(m_nCells, states, 2);
+     *      ResetReleasedCells(m_surfRf);
+     *      #pragma omp parallel for
+     *      for (int idx = 0; idx < n_iter; idx++) {
+     *          int i = ActiveCellIndex(idx);
+     *          ...
+     *      }
+     *      CheckInactiveCells(M_XXX[0], VAR_SURU[0], m_surfRf);
+     * \endcode
+     *
+     * \param[in] n_cells Cells number
+     * \param[in] states State arrays that carry water, e.g., precipitation, ponding depth, and overland flow
+     * \param[in] n_states Number of state arrays
+     * \return Number of cells to be iterated, i.e., all cells unless the mode is ACTIVE_CELLS_ON
+     */
+    template <typename T>
+    int RefreshActiveCells(const int n_cells, const T* const* states, const int n_states) {
+        if (n_cells <= 0 || !PrepareActiveCells()) { return n_cells; }
+        int n_active = m_activeCells->Refresh(n_cells, states, n_states);
+        if (m_activeCellsMode != ACTIVE_CELLS_ON) { return n_cells; }
+        m_activeCellIdxs = m_activeCells->Cells();
+        return n_active;
+    }
+
+    //! Index of the i-th iterated cell
+    int ActiveCellIndex(const int i) const { return nullptr == m_activeCellIdxs ? i : m_activeCellIdxs[i]; }
+
+    //! Is the cell dry in current step, always false if active-cell tracking is off
+    bool IsDryCell(const int i) const { return nullptr != m_activeCells && !m_activeCells->IsActive(i); }
+
+    //! Is the dry cell allowed to be skipped, i.e., the mode is ACTIVE_CELLS_ON
+    bool SkipDryCells() const { return m_activeCellsMode == ACTIVE_CELLS_ON; }
+
+    //! Activate the dry cell that receives upstream inflow, thus it is not checked
+    void ActivateCell(const int i) { if (nullptr != m_activeCells) { m_activeCells->Activate(i); } }
+
+    //! Reset the values of the cells released by the last refresh to zero
+    template <typename T>
+    void ResetReleasedCells(T* data) {
+        if (nullptr == m_activeCells || nullptr == data) { return; }
+        const vector<int>& released = m_activeCells->Released();
+        for (auto it = released.begin(); it != released.end(); ++it) {
+            data[*it] = T(0);
+        }
+    }
+
+    /*!
+     * \brief Check the values of inactive cells after iterating all cells in ACTIVE_CELLS_CHECK mode,
+     *        which should be zero as the results of iterating active cells only.
+     */
+    template <typename T>
+    void CheckInactiveCells(const char* module_id, const char* key, const T* data) {
+        if (m_activeCellsMode != ACTIVE_CELLS_CHECK || nullptr == m_activeCells) { return; }
+        int count = m_activeCells->CountMismatched(data);
+        if (count > 0) { ThrowInactiveCellsMismatched(module_id, key, count); }
+    }
+
+    /*!
+     * \brief Day length and maximum solar radiation of the cell in current day, which are looked up
+     *        from the latitude bands of the calendar if available, \sa MaxSolarRadiation()
+     */
+    void CellMaxSolarRadiation(int i, const FLTPT* lats, FLTPT& day_l, FLTPT& max_sr) const;
+
+private:
+    //! Clear the compact indexes, and create the own active cells if not shared, \return False if tracking is off
+    bool PrepareActiveCells();
+
+    //! Throw the exception of inactive cells that mismatch the dry state
+    void ThrowInactiveCellsMismatched(const char* module_id, const char* key, int count) const;
+
 protected:
     /// date time
     time_t m_date;
@@ -281,6 +402,16 @@ protected:
     bool m_inputsSetDone;
     /// need to recalculate intermediate parameters?
     bool m_reCalIntermediates;
+    /// Active-cell tracking mode
+    ActiveCellsMode m_activeCellsMode;
+    /// Active cells of current step, shared by ModelMain, nullptr if active-cell tracking is off
+    ActiveCells* m_activeCells;
+    /// Is m_activeCells owned by the module, i.e., not shared
+    bool m_ownActiveCells;
+    /// Compact indexes of the iterated cells, nullptr for iterating all cells
+    const int* m_activeCellIdxs;
+    /// Calendar shared by modules, nullptr if the date is set by SetDate()
+    const SimulationCalendar* m_calendar;
 };
 
 /*!
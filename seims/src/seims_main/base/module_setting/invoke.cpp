@@ -20,10 +20,21 @@ void Usage(const string& appname, const string& error_msg) {
             " -id <subbasinID>" // For MPI version or testing execution of a single subbasin
             // " -grp <groupMethod> -skd <scheduleMethdo> -ts <timeSlices>"
             " -ll <logLevel>"
-            "]\n";
+            " -trace <traceCapacity>"
+            " -active <activeCellsMode>"
+            " -class <classParams>"
+            " -local <localDataPath>";
+    if (mpi_version) {
+        cout << " -outsub <outSubbasin> -cache <cachePath> -incr <incremental> -ord <taskOrder> -indep <independentMode> -costs <costsFile>";
+    }
+    cout << "]\n";
     cout << "\t<modelPath> is the path of the SEIMS-based watershed model.\n";
     cout << "\t<configName> is the config name of specific model.\n";
     cout << "\t<threadsNum> is the number of thread used by OpenMP, which must be greater or equal than 1 (default).\n";
+    if (mpi_version) {
+        cout << "\t\tFor MPI version, the same-layer subbasins of each process are executed by "
+                "these threads concurrently.\n";
+    }
     cout << "\t<layeringMethod> can be 0 and 1, which means UP_DOWN (default) and DOWN_UP, respectively.\n";
     cout << "\t<flowDirMethod> can be 0, 1, and 2, which means D8 (default), Dinf, and MFDmd, respectively.\n";
     cout << "\t<IP> is the address of MongoDB database, and <port> is its port number.\n";
@@ -38,7 +49,52 @@ void Usage(const string& appname, const string& error_msg) {
     // cout << "\t<scheduleMethod> can be 0 and 1, which means "
     //         "SPATIAL (default) and TEMPOROSPATIAL, respectively.\n";
     // cout << "\t<timeSlices> should be greater than 1, required when <scheduleMethod> is 1.\n";
-    cout << "\t<logLevel> is the logging level: Trace, Debug, Info (default), Warning, Error, and Fatal.\n\n";
+    cout << "\t<logLevel> is the logging level: Trace, Debug, Info (default), Warning, Error, and Fatal.\n";
+    cout << "\t<traceCapacity> is the maximum timeline trace events kept per thread. "
+            "0 (default) means no tracing.\n";
+    cout << "\t\tThe trace file (*.trace) is saved beside the log file, "
+            "use seims/postprocess/trace_timeline.py to convert it to Chrome-trace JSON.\n";
+    cout << "\t<activeCellsMode> can be 0 (default), 1, and 2. 1 means the dry cells are skipped by the "
+            "runoff and erosion modules that support it, e.g., SUR_CN, IKW_OL, and SERO_MUSLE.\n";
+    cout << "\t\t2 means all cells are iterated, and the outputs of the dry cells are checked "
+            "against the results of skipping them.\n";
+    cout << "\t<classParams> can be 0 (default) and 1. 1 means the parameter rasters read by the modules "
+            "that support it (e.g., CN2 of SUR_CN) are kept as a table of class values and class IDs of cells.\n";
+    cout << "\t\tThe full arrays are materialized only when the values are adjusted spatially, "
+            "e.g., by the areal BMPs of scenario.\n";
+    cout << "\t<localDataPath> is the model data directory exported by seims/preprocess/db_export_local.py, "
+            "which will be used instead of MongoDB (OpenMP version only).\n";
+    if (mpi_version) {
+        cout << "\t<outSubbasin> can be 0 (default) and 1. 1 means the raster outputs of each subbasin "
+                "are also saved to GridFS, e.g., <subbasinID>_<outputName>_<scenarioID>_<calibrationID>.\n";
+        cout << "\t<cachePath> is the directory of cached results of each subbasin, "
+                "i.e., transferred values to the downstream and raster outputs.\n";
+        cout << "\t<incremental> can be 0 (default) and 1. 0 means the results of the current run "
+                "are saved to <cachePath> as the baseline.\n";
+        cout << "\t\t1 means only the subbasins affected by the BMPs scenario (of either the current or "
+                "the baseline run) and their downstream subbasins are simulated, "
+                "the others reuse the cached results.\n";
+        cout << "\t<taskOrder> can be 0 (default), 1, and 2. 1 means the same-layer subbasins of each process "
+                "are executed by their estimated costs descendingly,\n";
+        cout << "\t\ti.e., the longest ones are started first to balance the threads within each layer.\n";
+        cout << "\t\t2 means the subbasins of each process are executed once their upstreams are ready "
+                "instead of layer by layer, by the descending critical-path length to the outlet,\n";
+        cout << "\t\ti.e., the sum of the estimated costs of the subbasin and its downstream subbasins. "
+                "Only for the SPATIAL scheduling method.\n";
+        cout << "\t<independentMode> can be 0 (default), 1, and 2. 0 means each subbasin is simulated through "
+                "the entire period without the per-step synchronization\n";
+        cout << "\t\tif no channel processes and transferred values are declared by the modules. "
+                "1 means the subbasins are always simulated layer by layer.\n";
+        cout << "\t\t2 means there is no routing across subbasins, i.e., the transferred values are ignored, "
+                "whereas channel processes still require the layered simulation.\n";
+        cout << "\t\tThe OpenMP version always simulates the whole watershed step by step, "
+                "run the MPI version with -n 1 for hillslope-only models.\n";
+        cout << "\t<costsFile> is the computing costs of subbasins measured by a previous run, "
+                "i.e., subbasin_costs.csv in its output folder.\n";
+        cout << "\t\tIf specified, the subbasins are partitioned by METIS weighted by these costs, "
+                "otherwise the groups prepared by preprocessing are used if available.\n";
+    }
+    cout << endl;
     exit(1);
 }
 
@@ -58,6 +114,16 @@ InputArgs* InputArgs::Init(const int argc, const char** argv, bool mpi_version/*
     ScheduleMethod schedule_method = SPATIAL;
     int time_slices = -1;
     string log_level = "Info";
+    int trace_capacity = 0;
+    int active_cells = ACTIVE_CELLS_OFF; /// By default, all cells are iterated by modules.
+    bool class_params = false; /// By default, parameter rasters are read as full arrays.
+    string local_path;
+    bool out_subbasin_gfs = false; /// By default, raster outputs are combined in memory by MPI version.
+    string cache_path;
+    bool incremental = false;
+    int task_order = LAYER_ORDER;
+    int independent = INDEPENDENT_AUTO;
+    string costs_file;
     /// Parse input arguments.
     int i = 1;
     char* strend = nullptr;
@@ -195,6 +261,96 @@ InputArgs* InputArgs::Init(const int argc, const char** argv, bool mpi_version/*
                 Usage(argv[0]);
                 return nullptr;
             }
+        } else if (StringMatch(argv[i], "-trace")) {
+            i++;
+            if (argc > i) {
+                trace_capacity = strtol(argv[i], &strend, 10);
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-active")) {
+            i++;
+            if (argc > i) {
+                active_cells = strtol(argv[i], &strend, 10);
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-class")) {
+            i++;
+            if (argc > i) {
+                class_params = strtol(argv[i], &strend, 10) > 0;
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-local")) {
+            i++;
+            if (argc > i) {
+                local_path = argv[i];
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-outsub")) {
+            i++;
+            if (argc > i) {
+                out_subbasin_gfs = strtol(argv[i], &strend, 10) > 0;
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-cache")) {
+            i++;
+            if (argc > i) {
+                cache_path = argv[i];
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-incr")) {
+            i++;
+            if (argc > i) {
+                incremental = strtol(argv[i], &strend, 10) > 0;
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-ord")) {
+            i++;
+            if (argc > i) {
+                task_order = strtol(argv[i], &strend, 10);
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-indep")) {
+            i++;
+            if (argc > i) {
+                independent = strtol(argv[i], &strend, 10);
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
+        } else if (StringMatch(argv[i], "-costs")) {
+            i++;
+            if (argc > i) {
+                costs_file = argv[i];
+                i++;
+            } else {
+                Usage(argv[0]);
+                return nullptr;
+            }
         }
     }
     /// Check the validation of input arguments
@@ -213,6 +369,34 @@ InputArgs* InputArgs::Init(const int argc, const char** argv, bool mpi_version/*
         Usage(argv[0], "Thread number must greater or equal than 1.");
         return nullptr;
     }
+    if (trace_capacity < 0) {
+        Usage(argv[0], "Trace capacity must greater or equal than 0.");
+        return nullptr;
+    }
+    if (active_cells < ACTIVE_CELLS_OFF || active_cells > ACTIVE_CELLS_CHECK) {
+        Usage(argv[0], "Active-cell tracking mode must be 0, 1, or 2.");
+        return nullptr;
+    }
+    if (task_order < LAYER_ORDER || task_order > CRITICAL_PATH) {
+        Usage(argv[0], "Execution order of subbasins must be 0, 1, or 2.");
+        return nullptr;
+    }
+    if (independent < INDEPENDENT_AUTO || independent > INDEPENDENT_ON) {
+        Usage(argv[0], "Independent simulation mode of subbasins must be 0, 1, or 2.");
+        return nullptr;
+    }
+    if (!local_path.empty() && !PathExists(local_path)) {
+        Usage(argv[0], "Local data folder " + local_path + " is not existed!");
+        return nullptr;
+    }
+    if (!costs_file.empty() && !FileExists(costs_file)) {
+        Usage(argv[0], "Computing costs file " + costs_file + " is not existed!");
+        return nullptr;
+    }
+    if (incremental && (cache_path.empty() || !PathExists(cache_path))) {
+        Usage(argv[0], "Incremental simulation requires an existed cache folder of the baseline run!");
+        return nullptr;
+    }
     if (!IsIpAddress(mongodb_ip.c_str())) {
         Usage(argv[0], "MongoDB Hostname " + mongodb_ip + " is not a valid IP address!");
         return nullptr;
@@ -223,7 +407,10 @@ InputArgs* InputArgs::Init(const int argc, const char** argv, bool mpi_version/*
                          scenario_id, calibration_id,
                          subbasin_id,
                          group_method, schedule_method, time_slices,
-                         log_level, mpi_version);
+                         log_level, trace_capacity, local_path, mpi_version, out_subbasin_gfs,
+                         cache_path, incremental, static_cast<ActiveCellsMode>(active_cells),
+                         class_params, static_cast<TaskOrderMethod>(task_order),
+                         static_cast<IndependentMode>(independent), costs_file);
 }
 
 InputArgs::InputArgs(const string& model_path, const string& model_cfgname,
@@ -233,12 +420,25 @@ InputArgs::InputArgs(const string& model_path, const string& model_cfgname,
                      const int scenario_id, const int calibration_id,
                      const int subbasin_id, const GroupMethod grp_mtd,
                      const ScheduleMethod skd_mtd, const int time_slices,
-                     const string& log_level, bool mpi_version/* = false*/)
+                     const string& log_level, const int trace_capacity,
+                     const string& local_path, bool mpi_version/* = false*/,
+                     bool out_subbasin_gfs/* = false*/,
+                     const string& cache_path/* = std::string()*/,
+                     bool incremental/* = false*/,
+                     ActiveCellsMode active_cells/* = ACTIVE_CELLS_OFF*/,
+                     bool class_params/* = false*/,
+                     TaskOrderMethod task_order/* = LAYER_ORDER*/,
+                     IndependentMode independent/* = INDEPENDENT_AUTO*/,
+                     const string& costs_file/* = std::string()*/)
     : model_path(model_path), model_cfgname(model_cfgname), output_scene(DB_TAB_OUT_SPATIAL),
       thread_num(thread_num), fdir_mtd(fdir_mtd), lyr_mtd(lyr_mtd),
       host(host), port(port), scenario_id(scenario_id), calibration_id(calibration_id),
       subbasin_id(subbasin_id), grp_mtd(grp_mtd), skd_mtd(skd_mtd), time_slices(time_slices),
-      log_level(log_level), mpi_version(mpi_version) {
+      log_level(log_level), trace_capacity(trace_capacity), local_path(local_path),
+      mpi_version(mpi_version), out_subbasin_gfs(out_subbasin_gfs),
+      cache_path(cache_path), incremental(incremental), active_cells(active_cells),
+      class_params(class_params), task_order(task_order), independent(independent),
+      costs_file(costs_file) {
     /// Get model name
     size_t name_idx = model_path.rfind(SEP);
     model_name = model_path.substr(name_idx + 1);
@@ -6,6 +6,15 @@
  *   - 1. 2018-02-01 - lj - Initial implementation.
  *   - 2. 2018-06-06 - lj - Add parameters related to MPI version, e.g., group method.
  *   - 3. 2021-04-06 - lj - Add flow direction algorithm as an input argument
+ *   - 4. 2026-10-19 - lj - Add timeline tracing capacity as an input argument
+ *   - 5. 2026-10-19 - lj - Add local data path as an alternative of MongoDB
+ *   - 6. 2026-10-19 - lj - Add optional output of raster data of each subbasin to GridFS for MPI version
+ *   - 7. 2026-10-19 - lj - Add cache of subbasin results for incremental scenario simulation of MPI version
+ *   - 8. 2026-10-19 - lj - Add active-cell tracking mode of modules
+ *   - 9. 2026-10-19 - lj - Add class-indexed parameter rasters as an input argument
+ *   - 10. 2026-10-19 - lj - Add execution order of subbasins as an input argument of MPI version
+ *   - 11. 2026-10-19 - lj - Add independent simulation mode of subbasins as an input argument of MPI version
+ *   - 12. 2026-10-19 - lj - Add measured costs file of subbasins for partitioning as an input argument of MPI version
  *
  * \author Liangjun Zhu
  */
@@ -44,7 +53,17 @@ public:
      * \param[in] skd_mtd (TESTED) can be 0 and 1, which means SPATIAL (default) and TEMPOROSPATIAL, respectively
      * \param[in] time_slices (TESTED) should be greater than 1, required when <skd_mtd> is 1
      * \param[in] log_level logging level, the default is Info
+     * \param[in] trace_capacity maximum trace events per thread, 0 (default) means no tracing
+     * \param[in] local_path local data directory exported from MongoDB, empty (default) means using MongoDB
      * \param[in] mpi_version Optional, is running the MPI version?
+     * \param[in] out_subbasin_gfs Optional, output raster data of each subbasin to GridFS for MPI version
+     * \param[in] cache_path Optional, directory of cached subbasin results for MPI version
+     * \param[in] incremental Optional, reuse the cached results of subbasins unaffected by the scenario
+     * \param[in] active_cells Optional, active-cell tracking mode, see ActiveCellsMode
+     * \param[in] class_params Optional, keep parameter rasters as class-indexed data, see ClassParameter
+     * \param[in] task_order Optional, execution order of the subbasins of each process for MPI version
+     * \param[in] independent Optional, independent simulation mode of subbasins for MPI version
+     * \param[in] costs_file Optional, measured computing costs of subbasins to partition them for MPI version
      */
     InputArgs(const string& model_path, const string& model_cfgname,
               int thread_num, FlowDirMethod fdir_mtd, LayeringMethod lyr_mtd, 
@@ -52,7 +71,13 @@ public:
               int scenario_id, int calibration_id,
               int subbasin_id, GroupMethod grp_mtd,
               ScheduleMethod skd_mtd, int time_slices,
-              const string& log_level, bool mpi_version = false);
+              const string& log_level, int trace_capacity,
+              const string& local_path, bool mpi_version = false,
+              bool out_subbasin_gfs = false, const string& cache_path = std::string(),
+              bool incremental = false, ActiveCellsMode active_cells = ACTIVE_CELLS_OFF,
+              bool class_params = false, TaskOrderMethod task_order = LAYER_ORDER,
+              IndependentMode independent = INDEPENDENT_AUTO,
+              const string& costs_file = std::string());
 
     /*!
      * \brief Initializer.
@@ -80,7 +105,17 @@ public:
     ScheduleMethod skd_mtd; ///< Parallel task scheduling strategy at subbasin level by MPI
     int time_slices;        ///< Time slices for Temporal-Spatial discretization method, Wang et al. (2013). Unfinished!
     string log_level;       ///< logging level, i.e., Trace, Debug, Info (default), Warning, Error, and Fatal
+    int trace_capacity;     ///< maximum timeline trace events per thread, 0 for no tracing
+    string local_path;      ///< local data directory exported from MongoDB, empty for using MongoDB
     bool mpi_version;       ///< is running the MPI version?
+    bool out_subbasin_gfs;  ///< output raster data of each subbasin to GridFS for MPI version
+    string cache_path;      ///< directory of cached subbasin results for MPI version, empty for no use
+    bool incremental;       ///< reuse cached results of subbasins unaffected by scenario, otherwise save them
+    ActiveCellsMode active_cells; ///< active-cell tracking mode of modules, 0 (default) for no use
+    bool class_params;      ///< keep parameter rasters read by supported modules as class-indexed data
+    TaskOrderMethod task_order; ///< execution order of the subbasins of each process for MPI version
+    IndependentMode independent; ///< are subbasins simulated through the entire period independently by MPI version
+    string costs_file;      ///< measured computing costs of subbasins to partition them by MPI version, empty for no use
 };
 
 #endif /* SEIMS_INPUT_ARGUMENTS_H */
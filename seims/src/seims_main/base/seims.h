@@ -5,6 +5,9 @@
  * Changelog:
  *   - 1. 2017-03-22 - lj - Initial implementation.
  *   - 2. 2021-04-06 - lj - Add Flow direction method enum.
+ *   - 3. 2026-10-19 - lj - Add active-cell tracking mode enum.
+ *   - 4. 2026-10-19 - lj - Add execution order enum of subbasins by MPI.
+ *   - 5. 2026-10-19 - lj - Add independent simulation mode enum of subbasins by MPI.
  *
  * \author Liang-Jun Zhu
  * \date 2017-3-22
@@ -62,6 +65,41 @@ enum ScheduleMethod {
 };
 const char* const ScheduleMethodString[] = {"SPATIAL", "TEMPOROSPATIAL"};
 
+/*!
+ * \enum TaskOrderMethod
+ * \ingroup util
+ * \brief Execution order of the subbasins of each process by MPI.
+ */
+enum TaskOrderMethod {
+    LAYER_ORDER = 0,  ///< Ordered by subbasin ID, default
+    LONGEST_FIRST = 1, ///< Ordered by the estimated cost of each subbasin descendingly, i.e., longest processing time
+    CRITICAL_PATH = 2  ///< Executed once ready by the critical-path length to the outlet descendingly
+};
+const char* const TaskOrderMethodString[] = {"LAYER_ORDER", "LONGEST_FIRST", "CRITICAL_PATH"};
+
+/*!
+ * \enum IndependentMode
+ * \ingroup util
+ * \brief Whether the subbasins are simulated through the entire period independently by MPI,
+ *        i.e., without the per-step synchronization among subbasins.
+ */
+enum IndependentMode {
+    INDEPENDENT_AUTO = 0, ///< Detected by module metadata, i.e., no channel processes and transferred values, default
+    INDEPENDENT_OFF = 1,  ///< Always step the subbasins layer by layer
+    INDEPENDENT_ON = 2    ///< No routing across subbasins, i.e., transferred values are ignored
+};
+
+/*!
+ * \enum ActiveCellsMode
+ * \ingroup util
+ * \brief Active-cell tracking mode of modules, i.e., whether the dry cells are skipped.
+ */
+enum ActiveCellsMode {
+    ACTIVE_CELLS_OFF = 0,  ///< Iterate all cells, default
+    ACTIVE_CELLS_ON = 1,   ///< Iterate active cells only
+    ACTIVE_CELLS_CHECK = 2 ///< Iterate all cells, and check the outputs of inactive cells
+};
+
 /*!
  * \def DiagonalCCW
  * \ingroup util
@@ -102,6 +140,20 @@ typedef double FLTPT;
 typedef float FLTPT;
 #endif
 
+/*!
+ * \brief Floating point type of accumulators, e.g., aggregated outputs and channel storages
+ *
+ *        - Float64 build (USE_FLOAT64): double
+ *        - Mixed precision build (USE_MIXED_PRECISION): double, while the bulk per-cell
+ *          data are stored as float, i.e., FLTPT
+ *        - Float32 build: float
+ */
+#if defined(USE_FLOAT64) || defined(USE_MIXED_PRECISION)
+typedef double FLTACC;
+#else
+typedef float FLTACC;
+#endif
+
 ///
 /// Common used const.
 ///
@@ -486,12 +486,14 @@ CONST_CHARS_LIST VAR_C_SNOW6[] = {"c_snow6", "Melt factor on June 21, Maximum me
 CONST_CHARS_LIST VAR_C_WABA[] = {"C_WABA", "Channel water balance in a text format for each reach and at each time step"};
 CONST_CHARS_LIST VAR_CDN[] = {"cdn", "rate coefficient for denitrification"}; /// m_denitCoef
 CONST_CHARS_LIST VAR_CELL_LAT[] = {"celllat", "latitude of each valid cells"}; /// m_cellLat
+CONST_CHARS_LIST VAR_CH_COURANT[] = {"CH_Courant", "Courant number limit of adaptive sub-steps of storm channel routing, 0 means the whole time step"};
 CONST_CHARS_LIST VAR_CH_DEP[] = {"DEP", "distribution of channel sediment deposition"};
 CONST_CHARS_LIST VAR_CH_DET[] = {"DET", "distribution of channel flow detachment"};
 CONST_CHARS_LIST VAR_CH_DETCO[] = {"ChDetCo", "Calibration coefficient of channel flow detachment"};
 CONST_CHARS_LIST VAR_CH_FLOWCAP[] = {"CAP", "distribution of channel flow capacity"};
 //CONST_CHARS_LIST VAR_CH_MANNING_FACTOR[] = {"CH_ManningFactor", "Manning scaling factor for channel routing"};
 CONST_CHARS_LIST VAR_CH_SEDRATE[] = {"QSN", "distribution of channel sediment rate"};
+CONST_CHARS_LIST VAR_CH_SUBSTEP[] = {"CH_SUBSTEP", "number of sub-steps of each reach in current channel routing step"};
 CONST_CHARS_LIST VAR_CH_TCCO[] = {"ChTcCo", "Calibration coefficient of transport capacity calculation"};
 CONST_CHARS_LIST VAR_CH_V[] = {"CHANV", "flow velocity"};
 CONST_CHARS_LIST VAR_CH_VOL[] = {"CHANVOL", "water volume"};
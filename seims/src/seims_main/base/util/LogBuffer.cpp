@@ -0,0 +1,198 @@
+#include "LogBuffer.h"
+
+#include <chrono>
+#include <iostream>
+
+#include "utils_time.h"
+
+using namespace utils_time;
+using std::cout;
+using std::endl;
+
+namespace {
+const char* const LogLevelNames[] = {"TRACE", "DEBUG", "INFO", "WARNING", "ERROR", "FATAL"};
+
+//! Default sink, i.e., the standard output
+void WriteToStdout(const int level, const char* logger, const char* file, const int line, const string& msg) {
+    int lvl = level < SEIMS_LOG_TRACE || level > SEIMS_LOG_FATAL ? SEIMS_LOG_INFO : level;
+#pragma omp critical(LogBufferStdout)
+    {
+        cout << LogLevelNames[lvl] << " [" << logger << "] " << msg << endl;
+    }
+}
+
+//! Bits of the count of messages in the packed state of LogSampler, the others are the time step
+const int SAMPLER_COUNT_BITS = 24;
+const vuint64_t SAMPLER_COUNT_MASK = (static_cast<vuint64_t>(1) << SAMPLER_COUNT_BITS) - 1;
+} /* namespace */
+
+LogContext LogBuffer::context_;
+const LogContext* LogBuffer::active_ = &LogBuffer::context_;
+
+LogBuffer::LogBuffer(const int capacity, LogSinkFunc sink, const int max_threads) :
+    capacity_(capacity > 0 ? capacity : LOG_BUFFER_CAPACITY), sink_(sink),
+    slots_(max_threads > 0 ? max_threads : 1), claimed_(0), accepting_(false), running_(false) {
+    for (auto it = slots_.begin(); it != slots_.end(); ++it) {
+        it->records.resize(capacity_);
+    }
+}
+
+LogBuffer::~LogBuffer() {
+    Stop();
+}
+
+void LogBuffer::Start(const int interval_ms /* = LOG_BUFFER_INTERVAL */) {
+    if (thread_.joinable()) { return; }
+    running_ = true;
+    accepting_.store(true, std::memory_order_release);
+    thread_ = std::thread(&LogBuffer::Run, this, interval_ms > 0 ? interval_ms : LOG_BUFFER_INTERVAL);
+}
+
+void LogBuffer::Stop() {
+    accepting_.store(false, std::memory_order_release);
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(run_mutex_);
+            running_ = false;
+        }
+        run_cv_.notify_all();
+        thread_.join();
+    }
+    Drain();
+}
+
+void LogBuffer::Run(const int interval_ms) {
+    std::unique_lock<std::mutex> lock(run_mutex_);
+    while (running_) {
+        run_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms));
+        lock.unlock();
+        Drain();
+        lock.lock();
+    }
+}
+
+LogBuffer::Slot* LogBuffer::ThreadSlot() {
+    std::thread::id tid = std::this_thread::get_id();
+    int n_slots = CVT_INT(slots_.size());
+    int claimed = claimed_.load(std::memory_order_acquire);
+    if (claimed > n_slots) { claimed = n_slots; }
+    for (int i = 0; i < claimed; i++) {
+        if (slots_[i].owner.load(std::memory_order_acquire) == tid) { return &slots_[i]; }
+    }
+    if (claimed >= n_slots) { return nullptr; }
+    int idx = claimed_.fetch_add(1, std::memory_order_acq_rel);
+    if (idx >= n_slots) { return nullptr; }
+    slots_[idx].owner.store(tid, std::memory_order_release);
+    return &slots_[idx];
+}
+
+void LogBuffer::Push(const int level, const char* logger, const char* file, const int line, string& msg) {
+    Slot* slot = accepting_.load(std::memory_order_acquire) ? ThreadSlot() : nullptr;
+    if (nullptr == slot) {
+        ToSink(level, logger, file, line, msg);
+        return;
+    }
+    vint64_t head = slot->head.load(std::memory_order_relaxed);
+    vint64_t tail = slot->tail.load(std::memory_order_acquire);
+    if (head - tail >= capacity_) {
+        slot->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    LogRecord& rec = slot->records[head % capacity_];
+    rec.level = level;
+    rec.logger = logger;
+    rec.file = file;
+    rec.line = line;
+    rec.msg.swap(msg);
+    slot->head.store(head + 1, std::memory_order_release);
+}
+
+void LogBuffer::Drain() {
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    int n_slots = CVT_INT(slots_.size());
+    int claimed = claimed_.load(std::memory_order_acquire);
+    if (claimed > n_slots) { claimed = n_slots; }
+    for (int i = 0; i < claimed; i++) {
+        Slot& slot = slots_[i];
+        vint64_t tail = slot.tail.load(std::memory_order_relaxed);
+        vint64_t head = slot.head.load(std::memory_order_acquire);
+        for (vint64_t k = tail; k < head; k++) {
+            LogRecord& rec = slot.records[k % capacity_];
+            ToSink(rec.level, rec.logger, rec.file, rec.line, rec.msg);
+        }
+        slot.tail.store(head, std::memory_order_release);
+        vint64_t dropped = slot.dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::ostringstream oss;
+            oss << dropped << " log messages are dropped since the buffer of thread " << i << " is full";
+            ToSink(SEIMS_LOG_WARNING, "default", __FILE__, __LINE__, oss.str());
+        }
+    }
+}
+
+void LogBuffer::ToSink(const int level, const char* logger, const char* file, const int line,
+                       const string& msg) const {
+    if (nullptr != sink_) {
+        sink_(level, logger, file, line, msg);
+    } else {
+        WriteToStdout(level, logger, file, line, msg);
+    }
+}
+
+void LogBuffer::Write(const int level, const char* logger, const char* file, const int line, string& msg) {
+    if (nullptr != active_->buffer) {
+        active_->buffer->Push(level, logger, file, line, msg);
+    } else if (nullptr != active_->sink) {
+        active_->sink(level, logger, file, line, msg);
+    } else {
+        WriteToStdout(level, logger, file, line, msg);
+    }
+}
+
+LogSampler::LogSampler(const int level, const char* logger, const int first, const int every /* = 0 */) :
+    level_(level), logger_(logger), first_(first > 0 ? first : 0), every_(every > 0 ? every : 0),
+    state_(0), total_(0) {
+}
+
+LogSampler::~LogSampler() {
+    ReportSuppressed(state_.load());
+}
+
+bool LogSampler::Sample(const time_t step) {
+    total_.fetch_add(1, std::memory_order_relaxed);
+    vuint64_t key = static_cast<vuint64_t>(static_cast<vint64_t>(step)) << SAMPLER_COUNT_BITS;
+    vuint64_t cur = state_.load(std::memory_order_relaxed);
+    vuint64_t next = 0;
+    vint64_t n = 0; // messages of the time step before this one
+    do {
+        vuint64_t count = cur & SAMPLER_COUNT_MASK;
+        if (count > 0 && (cur & ~SAMPLER_COUNT_MASK) == key) {
+            n = static_cast<vint64_t>(count);
+            next = count < SAMPLER_COUNT_MASK ? cur + 1 : cur;
+        } else {
+            n = 0;
+            next = key | 1;
+        }
+    } while (!state_.compare_exchange_weak(cur, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    // Only the thread that switched the time step reports the previous one
+    if (n == 0) { ReportSuppressed(cur); }
+    return n < first_ || (every_ > 0 && (n - first_) % every_ == 0);
+}
+
+vint64_t LogSampler::Suppressed(const vint64_t n) const {
+    if (n <= first_) { return 0; }
+    vint64_t sampled = first_;
+    if (every_ > 0) { sampled += (n - first_ + every_ - 1) / every_; }
+    return n - sampled;
+}
+
+void LogSampler::ReportSuppressed(const vuint64_t state) const {
+    vint64_t suppressed = Suppressed(static_cast<vint64_t>(state & SAMPLER_COUNT_MASK));
+    if (suppressed <= 0) { return; }
+    // Restore the time step by the arithmetic shift, i.e., sign extension of the lower 40 bits
+    time_t step = CVT_TIMET(static_cast<vint64_t>(state) >> SAMPLER_COUNT_BITS);
+    std::ostringstream oss;
+    oss << suppressed << " similar messages are suppressed at " << ConvertToString2(step);
+    string msg = oss.str();
+    LogBuffer::Write(level_, logger_, __FILE__, __LINE__, msg);
+}
@@ -0,0 +1,301 @@
+/*!
+ * \file LogBuffer.h
+ * \brief Level-checked logging macros with per-thread lock-free buffers and sampling of
+ *        frequent messages, e.g., per-cell diagnostics in OpenMP loops.
+ *
+ *        The level of SLOG/SCLOG is checked at compile time (SEIMS_LOG_MIN_LEVEL) and at runtime
+ *        before any argument is formatted. The formatted messages are pushed into the ring buffer
+ *        of the calling thread without any lock, and written to the sink (i.e., easylogging++ and
+ *        the `.log` files, see Logging::startAsync()) by a background thread. Without an active
+ *        buffer, the messages are written to the sink directly.
+ *
+ *        This file does not depend on easylogging++, thus it can be used by the modules (shared
+ *        libraries), whose log context is shared by the main program, see LogBuffer::ShareContext().
+ *
+ * \code
+ *      SLOG(DEBUG) << ConvertToString2(t); // not formatted if DEBUG is disabled
+ *      SCLOG(INFO, LOG_OUTPUT) << "Write " << filename;
+ *
+ *      // Up to 10 messages of each time step, the others are counted and reported as suppressed
+ *      LogSampler sampler(SEIMS_LOG_WARNING, "default", 10);
+ *  #pragma omp parallel for
+ *      for (int i = 0; i < n; i++) {
+ *          if (value[i] < 0.) { SLOG_SAMPLED(sampler, m_date) << "Cell " << i << ": " << value[i]; }
+ *      }
+ * \endcode
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Pack the time step and count of LogSampler, so that they are reset together.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_UTIL_LOG_BUFFER
+#define SEIMS_UTIL_LOG_BUFFER
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "basic.h"
+
+using namespace ccgl;
+using std::string;
+using std::vector;
+
+/*! Log levels in ascending severity, which are independent of easylogging++ */
+#define SEIMS_LOG_TRACE 0
+#define SEIMS_LOG_DEBUG 1
+#define SEIMS_LOG_INFO 2
+#define SEIMS_LOG_WARNING 3
+#define SEIMS_LOG_ERROR 4
+#define SEIMS_LOG_FATAL 5
+#define SEIMS_LOG_NONE 6
+
+/*! Messages less severe than this level are removed at compile time, e.g., `-DSEIMS_LOG_MIN_LEVEL=2` */
+#ifndef SEIMS_LOG_MIN_LEVEL
+#define SEIMS_LOG_MIN_LEVEL SEIMS_LOG_TRACE
+#endif /* SEIMS_LOG_MIN_LEVEL */
+
+/*! Is the level, e.g., DEBUG, enabled at compile time and runtime */
+#define SLOG_IS_ON(LEVEL) (SEIMS_LOG_##LEVEL >= SEIMS_LOG_MIN_LEVEL && LogBuffer::IsEnabled(SEIMS_LOG_##LEVEL))
+
+/*! Log to the specific logger, e.g., `SCLOG(INFO, LOG_INIT) << ...`, the arguments are evaluated only if enabled */
+#define SCLOG(LEVEL, LOGGER) \
+    if (!SLOG_IS_ON(LEVEL)) {} else LogLine(SEIMS_LOG_##LEVEL, LOGGER, __FILE__, __LINE__).stream()
+
+/*! Log to the default logger, e.g., `SLOG(DEBUG) << ...` */
+#define SLOG(LEVEL) SCLOG(LEVEL, "default")
+
+/*! Log if the message is sampled by the LogSampler of the time step, e.g., `SLOG_SAMPLED(sampler, m_date) << ...` */
+#define SLOG_SAMPLED(SAMPLER, STEP) \
+    if (!((SAMPLER).Level() >= SEIMS_LOG_MIN_LEVEL && LogBuffer::IsEnabled((SAMPLER).Level()) && \
+          (SAMPLER).Sample(STEP))) {} \
+    else LogLine((SAMPLER).Level(), (SAMPLER).Logger(), __FILE__, __LINE__).stream()
+
+/*! Capacity of the ring buffer of each thread, messages */
+const int LOG_BUFFER_CAPACITY = 4096;
+
+/*! Interval of the background flushing, milliseconds */
+const int LOG_BUFFER_INTERVAL = 100;
+
+/*!
+ * \brief Sink of formatted messages, e.g., easylogging++
+ * \param[in] level Log level, SEIMS_LOG_TRACE ~ SEIMS_LOG_FATAL
+ * \param[in] logger Logger ID, e.g., "default"
+ * \param[in] file Source file, which should be a string literal
+ * \param[in] line Source line
+ * \param[in] msg Formatted message
+ */
+typedef void (*LogSinkFunc)(int level, const char* logger, const char* file, int line, const string& msg);
+
+class LogBuffer;
+
+/*!
+ * \struct LogContext
+ * \ingroup util
+ * \brief Log settings of the main program, which are shared with the modules
+ */
+struct LogContext {
+    LogContext() : buffer(nullptr), sink(nullptr), level(SEIMS_LOG_INFO) {}
+    LogBuffer* buffer; ///< Active buffer, nullptr to write to the sink directly
+    LogSinkFunc sink;  ///< Sink, nullptr for the standard output
+    int level;         ///< Minimum enabled level at runtime
+};
+
+/*!
+ * \class LogBuffer
+ * \ingroup util
+ * \brief Per-thread ring buffers of formatted messages, which are drained by a background thread.
+ *
+ *        Each thread claims its own slot at its first message, which is written by this thread only
+ *        and read by the draining thread only, thus pushing is lock-free. The slot of a thread is found
+ *        by the thread ID, which is the same for the main program and all modules. When the ring of a thread
+ *        is full, the message is dropped and counted, which is reported by the next draining.
+ *        The messages of each thread keep their order, whereas the messages of different threads
+ *        are interleaved by draining. The timestamps of the `.log` files are the draining time,
+ *        i.e., delayed by LOG_BUFFER_INTERVAL at most.
+ */
+class LogBuffer: NotCopyable {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] capacity Messages kept per thread
+     * \param[in] sink Sink of drained messages, nullptr for the standard output
+     * \param[in] max_threads Maximum threads with their own slot, the others write to the sink directly
+     */
+    LogBuffer(int capacity, LogSinkFunc sink, int max_threads);
+
+    //! Destructor, stop the background thread and drain all messages
+    ~LogBuffer();
+
+    //! Start the background thread to drain every `interval_ms` milliseconds
+    void Start(int interval_ms = LOG_BUFFER_INTERVAL);
+
+    //! Stop the background thread and drain the remained messages
+    void Stop();
+
+    /*!
+     * \brief Push a message into the slot of the calling thread, `msg` is swapped out.
+     *        The message is written to the sink directly if the buffer is stopped or no slot is available.
+     */
+    void Push(int level, const char* logger, const char* file, int line, string& msg);
+
+    //! Write all buffered messages to the sink, which is serialized with the background thread
+    void Drain();
+
+    //! Log context of current program, which is modified by the main program, e.g., Logging::startAsync()
+    static LogContext& Context() { return context_; }
+
+    //! Active log context, i.e., the context of the main program for the modules
+    static const LogContext* ActiveContext() { return active_; }
+
+    /*!
+     * \brief Use the log context of the main program.
+     *        The modules are shared libraries with their own copy of the static members,
+     *        the context should be shared by the main program, see SimulationModule::SetLogContext().
+     */
+    static void ShareContext(const LogContext* ctx) { active_ = nullptr != ctx ? ctx : &context_; }
+
+    //! Set the minimum enabled level at runtime
+    static void SetLevel(const int level) { context_.level = level; }
+
+    //! Is the level enabled at runtime
+    static bool IsEnabled(const int level) { return level >= active_->level; }
+
+    //! Write a message by the active context, i.e., push into the buffer or write to the sink directly
+    static void Write(int level, const char* logger, const char* file, int line, string& msg);
+
+private:
+    //! Formatted message
+    struct LogRecord {
+        LogRecord() : level(SEIMS_LOG_INFO), logger(nullptr), file(nullptr), line(0) {}
+        int level;
+        const char* logger;
+        const char* file;
+        int line;
+        string msg;
+    };
+
+    //! Ring buffer of one thread, padded to avoid false sharing of counters
+    struct Slot {
+        Slot() : owner(std::thread::id()), head(0), tail(0), dropped(0) {}
+        vector<LogRecord> records;
+        std::atomic<std::thread::id> owner; ///< Thread that claimed this slot
+        std::atomic<vint64_t> head;    ///< Next record to write, updated by the owner thread
+        std::atomic<vint64_t> tail;    ///< Next record to read, updated by the draining thread
+        std::atomic<vint64_t> dropped; ///< Messages dropped since the last draining
+        char padding[64];
+    };
+
+    //! Slot of the calling thread, nullptr if all slots have been claimed
+    Slot* ThreadSlot();
+
+    //! Write to the sink
+    void ToSink(int level, const char* logger, const char* file, int line, const string& msg) const;
+
+    //! Background thread
+    void Run(int interval_ms);
+
+private:
+    int capacity_;                   ///< Messages kept per thread
+    LogSinkFunc sink_;               ///< Sink
+    vector<Slot> slots_;             ///< Slots of threads
+    std::atomic<int> claimed_;       ///< Number of claimed slots
+    std::atomic<bool> accepting_;    ///< Are messages buffered, i.e., between Start() and Stop()
+    std::mutex drain_mutex_;         ///< Serialize the draining, e.g., by Stop() and the background thread
+    std::mutex run_mutex_;           ///< Protect running_
+    std::condition_variable run_cv_; ///< Wake up the background thread to stop
+    bool running_;                   ///< Is the background thread running
+    std::thread thread_;             ///< Background thread
+
+    static LogContext context_;       ///< Log context of current program or module
+    static const LogContext* active_; ///< Active log context, &context_ or shared by the main program
+};
+
+/*!
+ * \class LogLine
+ * \ingroup util
+ * \brief Scoped message, which is written by LogBuffer::Write() on destruction
+ */
+class LogLine: NotCopyable {
+public:
+    LogLine(const int level, const char* logger, const char* file, const int line) :
+        level_(level), logger_(logger), file_(file), line_(line) {}
+
+    ~LogLine() {
+        string msg = os_.str();
+        LogBuffer::Write(level_, logger_, file_, line_, msg);
+    }
+
+    std::ostringstream& stream() { return os_; }
+
+private:
+    int level_;
+    const char* logger_;
+    const char* file_;
+    int line_;
+    std::ostringstream os_;
+};
+
+/*!
+ * \class LogSampler
+ * \ingroup util
+ * \brief Rate limiter of frequent messages per time step, thread-safe and lock-free.
+ *
+ *        The first `first` messages of each time step are sampled, then one of every `every` messages
+ *        if `every` is positive. The time step and the count of its messages are packed into one word,
+ *        thus switching the time step and resetting the count are done by one compare-and-swap, i.e.,
+ *        the first messages of each time step are always sampled. The count of suppressed messages is
+ *        derived from the count of the previous time step, which is reported by the first message of a
+ *        new time step, or on destruction.
+ *
+ *        The time steps are kept by the lower 40 bits, i.e., about 34,800 years in seconds, and the
+ *        counts of more than 2^24 - 1 messages of one time step are saturated.
+ */
+class LogSampler: NotCopyable {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] level Log level, e.g., SEIMS_LOG_WARNING
+     * \param[in] logger Logger ID, which should be a string literal
+     * \param[in] first Messages sampled at the beginning of each time step
+     * \param[in] every Sample one of every `every` messages after the first ones, 0 for none
+     */
+    LogSampler(int level, const char* logger, int first, int every = 0);
+
+    //! Destructor, report the suppressed messages
+    ~LogSampler();
+
+    int Level() const { return level_; }
+
+    const char* Logger() const { return logger_; }
+
+    //! Total messages, both sampled and suppressed
+    vint64_t Count() const { return total_.load(std::memory_order_relaxed); }
+
+    //! Should the message of the time step be logged
+    bool Sample(time_t step);
+
+private:
+    //! Number of suppressed messages of `n` messages of one time step
+    vint64_t Suppressed(vint64_t n) const;
+
+    //! Report the messages suppressed in the time step of the packed state, if any
+    void ReportSuppressed(vuint64_t state) const;
+
+private:
+    int level_;
+    const char* logger_;
+    vint64_t first_;
+    vint64_t every_;
+    std::atomic<vuint64_t> state_; ///< Time step (upper 40 bits) and its messages (lower 24 bits), 0 for none
+    std::atomic<vint64_t> total_;  ///< Total messages
+};
+
+#endif /* SEIMS_UTIL_LOG_BUFFER */
@@ -1,6 +1,10 @@
 #include "utils_string.h"
 #include "Logging.h"
 
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
 using namespace ccgl::utils_string;
 using std::string;
 
@@ -19,6 +23,49 @@ el::base::type::StoragePointer sharedLoggingRepository() {
 }
 
 el::Configurations Logging::gDefaultConf;
+LogBuffer* Logging::gBuffer = nullptr;
+
+namespace {
+//! Rank of easylogging++ level in ascending severity, see SEIMS_LOG_TRACE etc.
+int levelRank(el::Level level) {
+    switch (level) {
+        case el::Level::Global:
+        case el::Level::Trace:
+            return SEIMS_LOG_TRACE;
+        case el::Level::Debug:
+        case el::Level::Verbose:
+            return SEIMS_LOG_DEBUG;
+        case el::Level::Info:
+            return SEIMS_LOG_INFO;
+        case el::Level::Warning:
+            return SEIMS_LOG_WARNING;
+        case el::Level::Error:
+            return SEIMS_LOG_ERROR;
+        case el::Level::Fatal:
+            return SEIMS_LOG_FATAL;
+        case el::Level::Unknown:
+            return SEIMS_LOG_NONE;
+    }
+    return SEIMS_LOG_INFO;
+}
+
+el::Level levelFromRank(int rank) {
+    switch (rank) {
+        case SEIMS_LOG_TRACE:
+            return el::Level::Trace;
+        case SEIMS_LOG_DEBUG:
+            return el::Level::Debug;
+        case SEIMS_LOG_WARNING:
+            return el::Level::Warning;
+        case SEIMS_LOG_ERROR:
+            return el::Level::Error;
+        case SEIMS_LOG_FATAL:
+            return el::Level::Fatal;
+        default:
+            return el::Level::Info;
+    }
+}
+} /* namespace */
 
 void Logging::setFmt(bool timestamps) {
     std::string datetime;
@@ -52,6 +99,10 @@ void Logging::init() {
     gDefaultConf.setGlobally(el::ConfigurationType::ToFile, "false");
     gDefaultConf.setGlobally(el::ConfigurationType::LogFlushThreshold, "100");
     setFmt();
+
+    // All levels are enabled by default, the same as easylogging++
+    LogBuffer::Context().sink = &Logging::write;
+    LogBuffer::SetLevel(SEIMS_LOG_TRACE);
 }
 
 void Logging::setLoggingToFile(std::string const& filename) {
@@ -129,6 +180,11 @@ void Logging::setLogLevel(el::Level level, const char* partition) {
         el::Loggers::reconfigureLogger(partition, config);
     else
         el::Loggers::reconfigureAllLoggers(config);
+
+    // The runtime level of SLOG/SCLOG is shared by all loggers, the most verbose one is kept
+    int rank = levelRank(level);
+    if (partition && LogBuffer::Context().level < rank) { rank = LogBuffer::Context().level; }
+    LogBuffer::SetLevel(rank);
 }
 
 std::string Logging::getStringFromLL(el::Level level) {
@@ -191,3 +247,29 @@ void Logging::rotate() {
     el::Loggers::getLogger(LOG_OUTPUT)->reconfigure();
     el::Loggers::getLogger(LOG_RELEASE)->reconfigure();
 }
+
+void Logging::startAsync(const int capacity /* = LOG_BUFFER_CAPACITY */,
+                         const int interval_ms /* = LOG_BUFFER_INTERVAL */) {
+    if (nullptr != gBuffer) { return; }
+    int n_threads = 1;
+#ifdef SUPPORT_OMP
+    n_threads = omp_get_max_threads();
+#endif /* SUPPORT_OMP */
+    // Slots for the OpenMP threads of nested parallel regions and other threads, e.g., the main thread
+    gBuffer = new LogBuffer(capacity, &Logging::write, 2 * n_threads + 2);
+    gBuffer->Start(interval_ms);
+    LogBuffer::Context().buffer = gBuffer;
+}
+
+void Logging::stopAsync() {
+    if (nullptr == gBuffer) { return; }
+    LogBuffer::Context().buffer = nullptr;
+    gBuffer->Stop();
+    delete gBuffer;
+    gBuffer = nullptr;
+}
+
+void Logging::write(const int level, const char* logger, const char* file, const int line,
+                    std::string const& msg) {
+    el::base::Writer(levelFromRank(level), file, line, "").construct(1, logger) << msg;
+}
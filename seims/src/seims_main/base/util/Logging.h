@@ -7,6 +7,9 @@
  *    under the ISC License. See the COPYING file at the top-level directory of
  *    this distribution or at http://opensource.org/licenses/ISC
  *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Add asynchronous logging of SLOG/SCLOG messages by per-thread buffers, see LogBuffer.
+ *
  * \author Liangjun Zhu
  * \date 19/08/2020
  */
@@ -29,6 +32,7 @@
 // NOTE: Nothing else should include "easylogging++.h" directly,
 //  include this file ("Logging.h") instead
 #include "easylogging++.h"
+#include "LogBuffer.h"
 
 // Define logger IDs
 static const char LOG_DEFAULT[] = "default";
@@ -47,6 +51,7 @@ el::base::type::StoragePointer sharedLoggingRepository();
  */
 class Logging {
     static el::Configurations gDefaultConf;
+    static LogBuffer* gBuffer;
 public:
     static void init();
     static void setFmt(bool timestamps = true);
@@ -58,6 +63,16 @@ public:
     static bool logDebug(std::string const& partition);
     static bool logTrace(std::string const& partition);
     static void rotate();
+    /*!
+     * \brief Write the messages of SLOG/SCLOG by a background thread, which are buffered by each thread
+     * \param[in] capacity Messages kept per thread
+     * \param[in] interval_ms Interval of writing, milliseconds
+     */
+    static void startAsync(int capacity = LOG_BUFFER_CAPACITY, int interval_ms = LOG_BUFFER_INTERVAL);
+    //! Stop the background thread and write all buffered messages, which should be called before exit
+    static void stopAsync();
+    //! Sink of SLOG/SCLOG messages, i.e., easylogging++
+    static void write(int level, const char* logger, const char* file, int line, std::string const& msg);
 };
 
 #endif  // SEIMS_UTIL_LOGGING
@@ -0,0 +1,162 @@
+#include "Tracing.h"
+
+#include <chrono>
+#include <fstream>
+
+#include "LogBuffer.h"
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
+using std::ofstream;
+
+namespace {
+const char TRACE_MAGIC[8] = {'S', 'E', 'I', 'M', 'S', 'T', 'R', 'C'};
+const vint32_t TRACE_VERSION = 1;
+
+double SteadySeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+double EpochSeconds() {
+    return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+void WriteBinary(ofstream& ofs, const T& value) {
+    ofs.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void WriteInt32(ofstream& ofs, const T& value) {
+    WriteBinary(ofs, static_cast<vint32_t>(value));
+}
+} /* namespace */
+
+bool Tracer::enabled_ = false;
+string Tracer::filename_;
+int Tracer::rank_ = 0;
+int Tracer::capacity_ = 0;
+double Tracer::origin_ = 0.;
+vector<Tracer::ThreadBuffer> Tracer::buffers_;
+std::atomic<vint64_t> Tracer::unbuffered_(0);
+vector<string> Tracer::names_;
+map<string, int> Tracer::name_ids_;
+
+void Tracer::Init(const string& filename, const int rank, const int capacity, const int max_threads /* = 1 */) {
+    enabled_ = false;
+    if (capacity < 1 || filename.empty()) { return; }
+    filename_ = filename;
+    rank_ = rank;
+    capacity_ = capacity;
+    int n_threads = max_threads > 1 ? max_threads : 1;
+#ifdef SUPPORT_OMP
+    if (omp_get_max_threads() > n_threads) { n_threads = omp_get_max_threads(); }
+#endif /* SUPPORT_OMP */
+    buffers_.clear();
+    buffers_.resize(n_threads);
+    for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+        it->events.resize(capacity);
+    }
+    unbuffered_.store(0);
+    // Spans are timed by the steady clock, the origin is the epoch time of its zero,
+    //   which is used to align traces of different ranks.
+    origin_ = EpochSeconds() - SteadySeconds();
+    enabled_ = true;
+}
+
+double Tracer::Now() {
+    return SteadySeconds();
+}
+
+int Tracer::RegisterName(const string& name) {
+    int id = -1;
+#pragma omp critical(TracerRegisterName)
+    {
+        auto it = name_ids_.find(name);
+        if (it != name_ids_.end()) {
+            id = it->second;
+        } else {
+            id = CVT_INT(names_.size());
+            names_.emplace_back(name);
+#ifdef HAS_VARIADIC_TEMPLATES
+            name_ids_.emplace(name, id);
+#else
+            name_ids_.insert(make_pair(name, id));
+#endif
+        }
+    }
+    return id;
+}
+
+void Tracer::Record(const TraceCategory category, const int name_id, const double begin, const double end,
+                    const time_t sim_time, const int subbasin_id, const int layer /* = -1 */) {
+    if (!enabled_) { return; }
+    int tid = 0;
+#ifdef SUPPORT_OMP
+    tid = omp_get_thread_num();
+#endif /* SUPPORT_OMP */
+    if (tid >= CVT_INT(buffers_.size())) {
+        // e.g., more threads than allocated by Init()
+        unbuffered_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ThreadBuffer& buf = buffers_[tid];
+    TraceEvent& evt = buf.events[buf.recorded % capacity_];
+    evt.category = category;
+    evt.name_id = name_id;
+    evt.begin = begin;
+    evt.end = end;
+    evt.sim_time = sim_time;
+    evt.subbasin_id = subbasin_id;
+    evt.layer = layer;
+    buf.recorded++;
+}
+
+bool Tracer::Flush() {
+    if (!enabled_) { return false; }
+    enabled_ = false;
+    vint64_t unbuffered = unbuffered_.exchange(0);
+    if (unbuffered > 0) {
+        SLOG(WARNING) << unbuffered << " trace events are dropped since only " << buffers_.size()
+                << " threads have trace buffers";
+    }
+    ofstream ofs(filename_.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        buffers_.clear();
+        return false;
+    }
+    ofs.write(TRACE_MAGIC, sizeof TRACE_MAGIC);
+    WriteBinary(ofs, TRACE_VERSION);
+    WriteInt32(ofs, rank_);
+    WriteBinary(ofs, origin_);
+    WriteInt32(ofs, names_.size());
+    for (auto it = names_.begin(); it != names_.end(); ++it) {
+        WriteInt32(ofs, it->size());
+        ofs.write(it->c_str(), it->size());
+    }
+    WriteInt32(ofs, buffers_.size());
+    for (size_t tid = 0; tid < buffers_.size(); tid++) {
+        ThreadBuffer& buf = buffers_[tid];
+        vint64_t count = buf.recorded < capacity_ ? buf.recorded : capacity_;
+        WriteInt32(ofs, tid);
+        WriteBinary(ofs, buf.recorded);
+        WriteBinary(ofs, count);
+        // Oldest first
+        vint64_t start = buf.recorded - count;
+        for (vint64_t i = start; i < buf.recorded; i++) {
+            const TraceEvent& evt = buf.events[i % capacity_];
+            WriteInt32(ofs, evt.category);
+            WriteInt32(ofs, evt.name_id);
+            WriteBinary(ofs, evt.begin);
+            WriteBinary(ofs, evt.end);
+            WriteBinary(ofs, static_cast<vint64_t>(evt.sim_time));
+            WriteInt32(ofs, evt.subbasin_id);
+            WriteInt32(ofs, evt.layer);
+        }
+    }
+    ofs.close();
+    buffers_.clear();
+    return true;
+}
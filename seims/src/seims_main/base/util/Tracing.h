@@ -0,0 +1,174 @@
+/*!
+ * \file Tracing.h
+ * \brief Low-overhead timeline tracing of module execution and MPI communication.
+ *
+ *        Each thread records spans into its own fixed-capacity ring buffer without any lock,
+ *        the buffers are flushed to a compact binary file (one file per process/rank),
+ *        which can be converted to Chrome-trace/Perfetto JSON by
+ *        `seims/postprocess/trace_timeline.py`.
+ *
+ *        Binary layout (native byte order, little-endian on all supported platforms):
+ *          - char[8]  magic "SEIMSTRC"
+ *          - int32    version
+ *          - int32    rank
+ *          - double   origin, wall-clock seconds since epoch of the time zero of this trace
+ *          - int32    name count, then for each name: int32 length, char[length]
+ *          - int32    thread count, then for each thread:
+ *              int32 thread id, int64 recorded count, int64 event count, then for each event:
+ *              int32 category, int32 name id, double begin (s), double end (s),
+ *              int64 simulation time, int32 subbasin ID, int32 layer ID
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Allocate buffers for the thread number of `-thread`, report the unbuffered events.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_UTIL_TRACING
+#define SEIMS_UTIL_TRACING
+
+#include <atomic>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "basic.h"
+
+using namespace ccgl;
+using std::map;
+using std::string;
+using std::vector;
+
+/*!
+ * \enum TraceCategory
+ * \brief Category of trace span
+ */
+enum TraceCategory {
+    TRACE_MODULE = 0,   ///< Execute() of a simulation module
+    TRACE_STEP = 1,     ///< Hillslope/channel step of one subbasin, e.g., in one routing layer
+    TRACE_MPI_WAIT = 2, ///< Blocking MPI communication, e.g., MPI_Wait and MPI_Barrier
+    TRACE_IO = 3        ///< Input/Output
+};
+
+/*!
+ * \struct TraceEvent
+ * \brief One complete span
+ */
+struct TraceEvent {
+    int category;      ///< TraceCategory
+    int name_id;       ///< Interned name ID, see Tracer::RegisterName()
+    double begin;      ///< Begin time relative to the trace origin, seconds
+    double end;        ///< End time relative to the trace origin, seconds
+    time_t sim_time;   ///< Current simulation time
+    int subbasin_id;   ///< Subbasin ID, 0 for the entire basin
+    int layer;         ///< Routing layer ID, -1 if not applicable
+};
+
+/*!
+ * \class Tracer
+ * \ingroup util
+ * \brief Timeline tracer with per-thread ring buffers, disabled by default.
+ *
+ * Usage:
+ *   - Tracer::Init(filename, rank, capacity, thread_num) once before simulation, e.g., by `-trace <capacity>`
+ *   - int id = Tracer::RegisterName("IKW_CH") during setup (not in hot loops)
+ *   - if (Tracer::Enabled()) { Tracer::Record(TRACE_MODULE, id, t1, t2, t, subbasin_id); }
+ *   - Tracer::Flush() at the end, as well as before aborting, e.g., in the exception handlers
+ *
+ * When the ring buffer of a thread is full, the oldest events are overwritten,
+ * the recorded count is kept to report the number of dropped events.
+ * The events of threads without buffer, e.g., more threads than allocated, are counted
+ * and reported as a warning by Flush().
+ */
+class Tracer {
+public:
+    /*!
+     * \brief Enable tracing and allocate ring buffers for all OpenMP threads
+     * \param[in] filename Output binary trace file
+     * \param[in] rank Rank ID of MPI process, 0 for the OpenMP version
+     * \param[in] capacity Maximum events kept per thread, tracing is disabled if less than 1
+     * \param[in] max_threads Thread number of the simulation, e.g., by `-thread`, which may be
+     *                        applied after Init(). The buffers are allocated for the maximum of
+     *                        it and the current maximum OpenMP threads.
+     */
+    static void Init(const string& filename, int rank, int capacity, int max_threads = 1);
+
+    //! Is tracing enabled?
+    static bool Enabled() { return enabled_; }
+
+    //! Current time relative to the trace origin, seconds
+    static double Now();
+
+    //! Intern a span name and return its ID, thread-safe but intended for setup stage
+    static int RegisterName(const string& name);
+
+    /*!
+     * \brief Record a span into the ring buffer of the calling thread, lock-free
+     * \param[in] category Span category
+     * \param[in] name_id Name ID returned by RegisterName()
+     * \param[in] begin Begin time returned by Now()
+     * \param[in] end End time returned by Now()
+     * \param[in] sim_time Current simulation time
+     * \param[in] subbasin_id Subbasin ID
+     * \param[in] layer Routing layer ID, -1 if not applicable
+     */
+    static void Record(TraceCategory category, int name_id, double begin, double end,
+                       time_t sim_time, int subbasin_id, int layer = -1);
+
+    /*!
+     * \brief Write all buffered events to the trace file and release the buffers, only once.
+     *        The events recorded afterward are ignored.
+     */
+    static bool Flush();
+
+private:
+    //! Ring buffer owned by one thread, padded to avoid false sharing of counters
+    struct ThreadBuffer {
+        vector<TraceEvent> events;
+        vint64_t recorded;
+        char padding[64];
+        ThreadBuffer() : recorded(0) {}
+    };
+
+    static bool enabled_;
+    static string filename_;
+    static int rank_;
+    static int capacity_;
+    static double origin_;
+    static vector<ThreadBuffer> buffers_;
+    static std::atomic<vint64_t> unbuffered_; ///< Events of threads without buffer
+    static vector<string> names_;
+    static map<string, int> name_ids_;
+};
+
+/*!
+ * \class TraceSpan
+ * \ingroup util
+ * \brief Scoped span that records on destruction if tracing is enabled.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const TraceCategory category, const int name_id, const time_t sim_time,
+              const int subbasin_id, const int layer = -1) :
+        category_(category), name_id_(name_id), sim_time_(sim_time),
+        subbasin_id_(subbasin_id), layer_(layer),
+        begin_(Tracer::Enabled() ? Tracer::Now() : 0.) {}
+
+    ~TraceSpan() {
+        if (Tracer::Enabled()) {
+            Tracer::Record(category_, name_id_, begin_, Tracer::Now(),
+                           sim_time_, subbasin_id_, layer_);
+        }
+    }
+
+private:
+    TraceCategory category_;
+    int name_id_;
+    time_t sim_time_;
+    int subbasin_id_;
+    int layer_;
+    double begin_;
+};
+
+#endif /* SEIMS_UTIL_TRACING */
@@ -0,0 +1,747 @@
+#include "SyntheticBasin.h"
+
+#include <cmath>
+#include <set>
+#include <sstream>
+#include <iomanip>
+
+#include "utils_filesystem.h"
+#include "utils_string.h"
+#include "utils_time.h"
+#include "data_raster.hpp"
+#include "LocalDataFile.h"
+#include "DataCenter.h"
+#include "text.h"
+#include "Logging.h"
+
+using namespace utils_filesystem;
+using namespace utils_string;
+using namespace utils_time;
+using namespace data_raster;
+
+namespace {
+const float SYN_NODATA = -9999.f;
+const FLTPT SYN_XLL = 500000.;  ///< X coordinate of the center of the lower left cell
+const FLTPT SYN_YLL = 3300000.; ///< Y coordinate of the center of the lower left cell
+const FLTPT SYN_LAT = 30.;      ///< Latitude of the lower boundary
+const FLTPT SYN_VELOCITY = 8640.; ///< Overland flow velocity for IUH, m/day, i.e., 0.1 m/s
+/// D8 flow direction codes of ArcGIS
+const int D8_E = 1;
+const int D8_SE = 2;
+const int D8_S = 4;
+const int D8_SW = 8;
+const int D8_W = 16;
+/// Landuse codes existed in both LanduseLookup.csv and CropLookup.csv, i.e., AGRL, FRST, PAST, and RICE
+const int SYN_LANDUSES[] = {1, 6, 12, 33};
+const int SYN_LANDUSE_NUM = 4;
+
+/// Single value parameters which are set by DataCenter directly, see DataCenter::SetValue()
+const char* DC_SINGLE_PARAMS[] = {
+    Tag_CellWidth[0], Tag_CellSize[0], Tag_SubbasinId, Tag_TimeStep[0],
+    Tag_HillSlopeTimeStep[0], Tag_ChannelTimeStep[0], Tag_LayeringMethod[0],
+    Tag_FlowDirectionMethod[0], Tag_DataType, ""
+};
+
+struct ValueRange {
+    const char* name;
+    float low;
+    float high;
+};
+
+/// Ranges of single layer raster parameters, most of which are derived from lookup tables in practice
+const ValueRange RASTER_RANGES[] = {
+    {VAR_CN2[0], 60.f, 85.f}, {VAR_MANNING[0], 0.05f, 0.3f},
+    {VAR_INTERC_MAX[0], 1.f, 3.f}, {VAR_INTERC_MIN[0], 0.f, 0.5f},
+    {VAR_ROOTDEPTH[0], 500.f, 1500.f}, {VAR_DEPRESSION[0], 0.5f, 5.f},
+    {VAR_RUNOFF_CO[0], 0.1f, 0.5f}, {VAR_MOIST_IN[0], 0.6f, 0.8f},
+    {VAR_SOIL_T10[0], 0.5f, 1.f}, {VAR_USLE_C[0], 0.05f, 0.3f},
+    {VAR_USLE_K[0], 0.2f, 0.4f}, {VAR_USLE_P[0], 1.f, 1.f},
+    {VAR_GSI[0], 0.005f, 0.008f}, {VAR_VPDFR[0], 4.f, 4.f}, {VAR_FRGMAX[0], 0.75f, 0.75f},
+    {VAR_PHUTOT[0], 2500.f, 3500.f}, {VAR_PHUPLT[0], 1500.f, 2000.f},
+    {VAR_CHT[0], 0.5f, 5.f}, {VAR_CHTMX[0], 1.f, 6.f},
+    {VAR_DAYLEN_MIN[0], 9.f, 10.f}, {VAR_DORMHR[0], 0.f, 0.5f},
+    {VAR_TMEAN_ANN[0], 14.f, 16.f}, {VAR_SOL_ALB[0], 0.1f, 0.2f},
+    {VAR_ALAIMIN[0], 0.f, 0.75f}, {VAR_BIO_E[0], 15.f, 40.f}, {VAR_BIOEHI[0], 20.f, 45.f},
+    {VAR_BIOLEAF[0], 0.f, 0.3f}, {VAR_BLAI[0], 2.f, 6.f}, {VAR_BMX_TREES[0], 0.f, 1000.f},
+    {VAR_BN1[0], 0.006f, 0.06f}, {VAR_BN2[0], 0.002f, 0.03f}, {VAR_BN3[0], 0.0015f, 0.025f},
+    {VAR_BP1[0], 0.0007f, 0.006f}, {VAR_BP2[0], 0.0004f, 0.003f}, {VAR_BP3[0], 0.0003f, 0.0025f},
+    {VAR_CO2HI[0], 660.f, 660.f}, {VAR_DLAI[0], 0.5f, 0.99f}, {VAR_EXT_COEF[0], 0.65f, 0.65f},
+    {VAR_FRGRW1[0], 0.05f, 0.15f}, {VAR_FRGRW2[0], 0.45f, 0.5f}, {VAR_HVSTI[0], 0.4f, 0.5f},
+    {VAR_LAIMX1[0], 0.05f, 0.15f}, {VAR_LAIMX2[0], 0.7f, 0.95f}, {VAR_MAT_YRS[0], 0.f, 30.f},
+    {VAR_T_BASE[0], 0.f, 10.f}, {VAR_T_OPT[0], 20.f, 30.f}, {VAR_WAVP[0], 5.f, 10.f},
+    {VAR_SOL_RSDIN[0], 0.f, 1000.f}, {VAR_EPCO[0], 1.f, 1.f}, {VAR_TREEYRS[0], 0.f, 10.f},
+    {VAR_LAIINIT[0], 0.f, 1.f}, {VAR_BIOINIT[0], 0.f, 1000.f}, {VAR_PL_RSDCO[0], 0.05f, 0.05f},
+    {VAR_IGRO[0], 1.f, 1.f}, {VAR_DORMI[0], 0.f, 0.f}, {VAR_IDC[0], 4.f, 7.f},
+    {"", 0.f, 0.f}
+};
+
+/// Ranges of soil properties of each soil layer
+const ValueRange SOIL_RANGES[] = {
+    {VAR_CONDUCT[0], 5.f, 30.f}, {VAR_POREIDX[0], 0.2f, 0.5f}, {VAR_POROST[0], 0.4f, 0.5f},
+    {VAR_FIELDCAP[0], 0.2f, 0.35f}, {VAR_WILTPOINT[0], 0.08f, 0.15f}, {VAR_SOL_BD[0], 1.3f, 1.6f},
+    {VAR_CLAY[0], 10.f, 30.f}, {VAR_SAND[0], 30.f, 50.f}, {VAR_SILT[0], 20.f, 40.f},
+    {VAR_ROCK[0], 0.f, 5.f}, {VAR_SOL_OM[0], 1.f, 3.f}, {VAR_SOL_CBN[0], 0.5f, 2.f},
+    {VAR_SOL_NO3[0], 1.f, 10.f}, {VAR_SOL_NH4[0], 0.1f, 1.f}, {VAR_SOL_SORGN[0], 100.f, 1000.f},
+    {VAR_SOL_HORGP[0], 10.f, 100.f}, {VAR_SOL_SOLP[0], 1.f, 10.f},
+    {"", 0.f, 0.f}
+};
+
+/// Soil parameters of each layer which are derived from soil thickness and properties
+const char* SOIL_DERIVED[] = {
+    VAR_SOILDEPTH[0], VAR_SOILTHICK[0], VAR_SOL_AWC[0], VAR_SOL_UL[0], VAR_SOL_WPMM[0], ""
+};
+
+bool FindRange(const ValueRange* ranges, const string& name, float& low, float& high) {
+    for (int i = 0; *ranges[i].name != '\0'; i++) {
+        if (StringMatch(name, ranges[i].name)) {
+            low = ranges[i].low;
+            high = ranges[i].high;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool InList(const char** list, const string& name) {
+    for (int i = 0; *list[i] != '\0'; i++) {
+        if (StringMatch(name, list[i])) { return true; }
+    }
+    return false;
+}
+
+/// Numeric value to string without loss of precision, e.g., coordinates
+string FormatValue(const double value) {
+    std::ostringstream oss;
+    oss << std::setprecision(10) << value;
+    return oss.str();
+}
+} /* namespace */
+
+SyntheticBasin::SyntheticBasin(const SyntheticOptions& opts) : opts_(opts), n_cells_(0) {
+    BuildTerrain();
+    BuildRouting();
+}
+
+float SyntheticBasin::Noise(const int idx, const string& key) {
+    // FNV-1a hash of key, then mixed with index by the finalizer of splitmix64
+    vuint64_t z = 14695981039346656037ULL;
+    for (auto it = key.begin(); it != key.end(); ++it) {
+        z ^= static_cast<unsigned char>(toupper(*it));
+        z *= 1099511628211ULL;
+    }
+    z += static_cast<vuint64_t>(idx + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    return static_cast<float>(static_cast<double>(z >> 40) / 16777216.);
+}
+
+void SyntheticBasin::BuildTerrain() {
+    int nrows = opts_.rows;
+    int ncols = opts_.cols;
+    int c0 = ncols / 2; // column of the main channel
+    FLTPT rc = (nrows - 1) * 0.5;
+    FLTPT half_rows = Max(nrows * 0.5, 1.);
+    FLTPT half_cols = Max(ncols * 0.5, 1.);
+    pos_index_.assign(CVT_VINT(nrows) * ncols, -1);
+    for (int r = 0; r < nrows; r++) {
+        for (int c = 0; c < ncols; c++) {
+            FLTPT dr = (r - rc) / half_rows;
+            FLTPT dc = (c - c0) / half_cols;
+            if (c != c0 && dr * dr + dc * dc > 1.) { continue; }
+            pos_index_[r * ncols + c] = n_cells_++;
+            cell_row_.emplace_back(r);
+            cell_col_.emplace_back(c);
+            subbasin_.emplace_back(1 + r * opts_.subbasins / nrows);
+        }
+    }
+    FLTPT cs = opts_.cellsize;
+    dem_.resize(n_cells_);
+    for (int i = 0; i < n_cells_; i++) {
+        dem_[i] = static_cast<float>(100. + 0.002 * cs * (nrows - 1 - cell_row_[i])
+                                     + 0.05 * cs * Abs(cell_col_[i] - c0)
+                                     + 0.01 * Noise(i, VAR_DEM[0]));
+    }
+    flow_out_.assign(n_cells_, -1);
+    flow_dir_.assign(n_cells_, D8_S);
+    slope_.assign(n_cells_, 0.002f);
+    for (int i = 0; i < n_cells_; i++) {
+        int r = cell_row_[i];
+        int c = cell_col_[i];
+        int tr = r;
+        int tc = c;
+        if (c == c0) {
+            if (r == nrows - 1) { continue; } // outlet
+            tr = r + 1;
+        } else {
+            // toward the channel, which is always valid since it is closer to the center
+            tc = c < c0 ? c + 1 : c - 1;
+            flow_dir_[i] = c < c0 ? D8_E : D8_W;
+            if (r + 1 < nrows && Noise(i, VAR_FLOWDIR[0]) < 0.25f) {
+                int diag = pos_index_[(r + 1) * ncols + tc];
+                if (diag >= 0 && subbasin_[diag] == subbasin_[i]) {
+                    tr = r + 1;
+                    flow_dir_[i] = c < c0 ? D8_SE : D8_SW;
+                }
+            }
+        }
+        int down = pos_index_[tr * ncols + tc];
+        flow_out_[i] = down;
+        FLTPT dist = tr != r && tc != c ? cs * SQ2 : cs;
+        slope_[i] = static_cast<float>(Max((dem_[i] - dem_[down]) / dist, 0.001));
+    }
+}
+
+void SyntheticBasin::BuildRouting() {
+    flow_in_.assign(n_cells_, vector<int>());
+    for (int i = 0; i < n_cells_; i++) {
+        if (flow_out_[i] >= 0) { flow_in_[flow_out_[i]].emplace_back(i); }
+    }
+    // Topological sort from sources, and the layer of each cell is the longest path from sources
+    vector<int> indegree(n_cells_);
+    vector<int> level(n_cells_, 0);
+    topo_order_.clear();
+    topo_order_.reserve(n_cells_);
+    for (int i = 0; i < n_cells_; i++) {
+        indegree[i] = CVT_INT(flow_in_[i].size());
+        if (indegree[i] == 0) { topo_order_.emplace_back(i); }
+    }
+    for (size_t k = 0; k < topo_order_.size(); k++) {
+        int i = topo_order_[k];
+        int down = flow_out_[i];
+        if (down < 0) { continue; }
+        level[down] = Max(level[down], level[i] + 1);
+        if (--indegree[down] == 0) { topo_order_.emplace_back(down); }
+    }
+    int max_level = 0;
+    for (int i = 0; i < n_cells_; i++) { max_level = Max(max_level, level[i]); }
+    layers_up_.assign(max_level + 1, vector<int>());
+    for (int i = 0; i < n_cells_; i++) { layers_up_[level[i]].emplace_back(i); }
+    // The layer from outlet is determined by the flow distance to outlet
+    vector<int> dist(n_cells_, 0);
+    int max_dist = 0;
+    for (auto it = topo_order_.rbegin(); it != topo_order_.rend(); ++it) {
+        int down = flow_out_[*it];
+        dist[*it] = down < 0 ? 0 : dist[down] + 1;
+        max_dist = Max(max_dist, dist[*it]);
+    }
+    layers_down_.assign(max_dist + 1, vector<int>());
+    for (int i = 0; i < n_cells_; i++) { layers_down_[max_dist - dist[i]].emplace_back(i); }
+}
+
+bool SyntheticBasin::Write(const string& local_path, ModuleFactory* factory, const string& param_file) {
+    string dirs[] = {local_path, local_path + SEP + DB_TAB_SPATIAL, local_path + SEP + "CLIMATE"};
+    for (int i = 0; i < 3; i++) {
+        if (!DirectoryExists(dirs[i]) && !MakeDirectory(dirs[i])) {
+            LOG(ERROR) << "Failed to create directory: " << dirs[i];
+            return false;
+        }
+    }
+    return WriteTables(local_path, factory, param_file) && WriteClimate(local_path)
+            && WriteSpatial(local_path, factory);
+}
+
+bool SyntheticBasin::WriteTables(const string& local_path, ModuleFactory* factory, const string& param_file) {
+    time_t start_time = ConvertToTime(opts_.start_date, "%d-%d-%d %d:%d:%d", true);
+    string stime = ConvertToString2(start_time);
+    string etime = ConvertToString2(start_time + CVT_TIMET(opts_.days - 1) * 86400);
+    /// MANIFEST
+    STRING_MAP manifest;
+    manifest["FORMAT"] = "SEIMS_LOCAL";
+    manifest["VERSION"] = ValueToString(LOCAL_DATA_VERSION);
+    manifest["MODEL"] = "synthetic_" + ValueToString(opts_.rows) + "x" + ValueToString(opts_.cols);
+    if (!WriteLocalKeyValues(local_path + SEP + "MANIFEST", manifest)) { return false; }
+    /// FILE_IN, daily mode
+    vector<string> fields = {Tag_ConfTag, Tag_ConfValue};
+    vector<STRING_MAP> records(4);
+    string file_in[4][2] = {
+        {Tag_Mode, "Daily"}, {Tag_Interval, "1"}, {Tag_StartTime, stime}, {Tag_EndTime, etime}
+    };
+    for (int i = 0; i < 4; i++) {
+        records[i][Tag_ConfTag] = file_in[i][0];
+        records[i][Tag_ConfValue] = file_in[i][1];
+    }
+    if (!WriteLocalRecords(local_path + SEP + DB_TAB_FILE_IN + ".tsv", fields, records)) { return false; }
+    /// FILE_OUT, discharge at the outlet, which will be ignored if no module outputs QRECH
+    fields = {Tag_OutputID, Tag_AggType, Tag_StartTime, Tag_EndTime, Tag_Interval,
+        Tag_IntervalUnit, Tag_OutputSubbsn, Tag_FileName, Tag_OutputUSE};
+    records.assign(1, STRING_MAP());
+    records[0][Tag_OutputID] = VAR_QRECH[0];
+    records[0][Tag_AggType] = "NONE";
+    records[0][Tag_StartTime] = stime;
+    records[0][Tag_EndTime] = etime;
+    records[0][Tag_Interval] = "1";
+    records[0][Tag_IntervalUnit] = "DAY";
+    records[0][Tag_OutputSubbsn] = Tag_Outlet;
+    records[0][Tag_FileName] = "Q.txt";
+    records[0][Tag_OutputUSE] = "1";
+    if (!WriteLocalRecords(local_path + SEP + DB_TAB_FILE_OUT + ".tsv", fields, records)) { return false; }
+    /// SITELIST, the same sites for P and M
+    string sites;
+    for (int i = 1; i <= opts_.sites; i++) { sites += (i == 1 ? "" : ",") + ValueToString(i); }
+    fields = {Tag_SubbasinId, Tag_Mode, SITELIST_TABLE_P, SITELIST_TABLE_M};
+    records.assign(1, STRING_MAP());
+    records[0][Tag_SubbasinId] = "0";
+    records[0][Tag_Mode] = Tag_Mode_Daily;
+    records[0][SITELIST_TABLE_P] = sites;
+    records[0][SITELIST_TABLE_M] = sites;
+    if (!WriteLocalRecords(local_path + SEP + DB_TAB_SITELIST + ".tsv", fields, records)) { return false; }
+    /// REACHES, reach of each subbasin flows into the next one, and the last one is the outlet
+    int nsub = opts_.subbasins;
+    FLTPT cs = opts_.cellsize;
+    vector<int> sub_cells(nsub + 1, 0);
+    vector<vector<int> > ch_cells(nsub + 1);
+    for (int i = 0; i < n_cells_; i++) {
+        sub_cells[subbasin_[i]]++;
+        if (cell_col_[i] == opts_.cols / 2) { ch_cells[subbasin_[i]].emplace_back(i); }
+    }
+    fields = {REACH_SUBBASIN, REACH_NUMCELLS, REACH_DOWNSTREAM, REACH_UPDOWN_ORDER, REACH_DOWNUP_ORDER,
+        REACH_WIDTH, REACH_LENGTH, REACH_DEPTH, REACH_WDRATIO, REACH_AREA, REACH_SIDESLP, REACH_SLOPE,
+        REACH_MANNING, REACH_BEDK, REACH_BNKK, REACH_BEDBD, REACH_BNKBD, REACH_BEDCOV, REACH_BNKCOV,
+        REACH_BEDEROD, REACH_BNKEROD, REACH_BEDD50, REACH_BNKD50,
+        REACH_GROUP, REACH_KMETIS, REACH_PMETIS, REACH_COORX, REACH_COORY};
+    records.assign(nsub, STRING_MAP());
+    int acc_cells = 0;
+    for (int k = 1; k <= nsub; k++) {
+        STRING_MAP& rec = records[k - 1];
+        acc_cells += sub_cells[k];
+        FLTPT width = 5. + 10. * k / nsub;
+        FLTPT depth = 0.5 + 1.5 * k / nsub;
+        FLTPT ch_slp = 0.;
+        string coorx;
+        string coory;
+        for (auto it = ch_cells[k].begin(); it != ch_cells[k].end(); ++it) {
+            ch_slp += slope_[*it];
+            coorx += (it == ch_cells[k].begin() ? "" : ",") + FormatValue(SYN_XLL + cell_col_[*it] * cs);
+            coory += (it == ch_cells[k].begin() ? "" : ",")
+                    + FormatValue(SYN_YLL + (opts_.rows - 1 - cell_row_[*it]) * cs);
+        }
+        if (!ch_cells[k].empty()) { ch_slp /= ch_cells[k].size(); }
+        rec[REACH_SUBBASIN] = ValueToString(k);
+        rec[REACH_NUMCELLS] = ValueToString(sub_cells[k]);
+        rec[REACH_DOWNSTREAM] = ValueToString(k == nsub ? 0 : k + 1);
+        rec[REACH_UPDOWN_ORDER] = ValueToString(k);
+        rec[REACH_DOWNUP_ORDER] = ValueToString(k);
+        rec[REACH_WIDTH] = FormatValue(width);
+        rec[REACH_LENGTH] = FormatValue(Max(CVT_INT(ch_cells[k].size()), 1) * cs);
+        rec[REACH_DEPTH] = FormatValue(depth);
+        rec[REACH_WDRATIO] = FormatValue(width / depth);
+        rec[REACH_AREA] = FormatValue(acc_cells * cs * cs);
+        rec[REACH_SIDESLP] = "2";
+        rec[REACH_SLOPE] = FormatValue(ch_slp);
+        rec[REACH_MANNING] = "0.035";
+        rec[REACH_BEDK] = "0.5";
+        rec[REACH_BNKK] = "0.5";
+        rec[REACH_BEDBD] = "1.4";
+        rec[REACH_BNKBD] = "1.4";
+        rec[REACH_BEDCOV] = "0.1";
+        rec[REACH_BNKCOV] = "0.1";
+        rec[REACH_BEDEROD] = "0.1";
+        rec[REACH_BNKEROD] = "0.1";
+        rec[REACH_BEDD50] = "50";
+        rec[REACH_BNKD50] = "50";
+        rec[REACH_GROUP] = "1";
+        rec[REACH_KMETIS] = "0";
+        rec[REACH_PMETIS] = "0";
+        rec[REACH_COORX] = coorx;
+        rec[REACH_COORY] = coory;
+    }
+    if (!WriteLocalRecords(local_path + SEP + DB_TAB_REACH + ".tsv", fields, records)) { return false; }
+    /// PARAMETERS, initial parameters and single value parameters required by modules
+    vector<string> lines;
+    if (!LoadPlainTextFile(param_file, lines) || lines.size() < 2) {
+        LOG(ERROR) << "Failed to read initial parameters from " << param_file;
+        return false;
+    }
+    fields = {PARAM_FLD_NAME, PARAM_FLD_DESC, PARAM_FLD_UNIT, PARAM_FLD_MIDS, PARAM_FLD_VALUE,
+        PARAM_FLD_IMPACT, PARAM_FLD_CHANGE, PARAM_FLD_MAX, PARAM_FLD_MIN, PARAM_FLD_DTYPE};
+    records.clear();
+    std::set<string> names;
+    vector<string> header = SplitString(lines[0], ',');
+    for (size_t i = 1; i < lines.size(); i++) {
+        vector<string> items = SplitString(lines[i], ',');
+        STRING_MAP rec;
+        for (size_t j = 0; j < header.size() && j < items.size(); j++) {
+            rec[GetUpper(Trim(header[j]))] = Trim(items[j]);
+        }
+        string name = GetUpper(rec[PARAM_FLD_NAME]);
+        if (name.empty() || !names.insert(name).second) { continue; }
+        rec[PARAM_FLD_NAME] = name;
+        records.emplace_back(rec);
+    }
+    string basin_params[2][2] = {
+        {VAR_OUTLETID[0], ValueToString(nsub)}, {VAR_SUBBSNID_NUM[0], ValueToString(nsub)}
+    };
+    for (int i = 0; i < 2; i++) {
+        STRING_MAP rec;
+        rec[PARAM_FLD_NAME] = GetUpper(basin_params[i][0]);
+        rec[PARAM_FLD_VALUE] = basin_params[i][1];
+        rec[PARAM_FLD_CHANGE] = "NC";
+        rec[PARAM_FLD_DTYPE] = "INT";
+        names.insert(rec[PARAM_FLD_NAME]);
+        records.emplace_back(rec);
+    }
+    map<string, vector<ParamInfo<FLTPT>*> >& params = factory->GetModuleParams();
+    map<string, vector<ParamInfo<int>*> >& params_int = factory->GetModuleParamsInt();
+    vector<string>& module_ids = factory->GetModuleIDs();
+    for (auto it = module_ids.begin(); it != module_ids.end(); ++it) {
+        vector<std::pair<string, bool> > singles;
+        for (auto itp = params[*it].begin(); itp != params[*it].end(); ++itp) {
+            if ((*itp)->Dimension != DT_Single) { continue; }
+            if (!StringMatch((*itp)->Source, Source_ParameterDB)) { continue; }
+            singles.emplace_back((*itp)->Name, false);
+        }
+        for (auto itp = params_int[*it].begin(); itp != params_int[*it].end(); ++itp) {
+            if ((*itp)->Dimension != DT_SingleInt) { continue; }
+            if (!StringMatch((*itp)->Source, Source_ParameterDB)) { continue; }
+            singles.emplace_back((*itp)->Name, true);
+        }
+        for (auto its = singles.begin(); its != singles.end(); ++its) {
+            string name = GetUpper(its->first);
+            if (InList(DC_SINGLE_PARAMS, name) || !names.insert(name).second) { continue; }
+            LOG(WARNING) << "Parameter " << name << " of " << *it << " is not found in "
+                    << param_file << ", 0 is used.";
+            STRING_MAP rec;
+            rec[PARAM_FLD_NAME] = name;
+            rec[PARAM_FLD_MIDS] = *it;
+            rec[PARAM_FLD_VALUE] = "0";
+            rec[PARAM_FLD_CHANGE] = "NC";
+            rec[PARAM_FLD_DTYPE] = its->second ? "INT" : "FLT";
+            records.emplace_back(rec);
+        }
+    }
+    return WriteLocalRecords(local_path + SEP + DB_TAB_PARAMETERS + ".tsv", fields, records);
+}
+
+bool SyntheticBasin::WriteClimate(const string& local_path) {
+    int nsites = opts_.sites;
+    int ndays = opts_.days;
+    int c0 = opts_.cols / 2;
+    time_t start_time = ConvertToTime(opts_.start_date, "%d-%d-%d %d:%d:%d", true);
+    int start_doy = DayOfYear(start_time);
+    /// Sites locate evenly along the main channel
+    string ids;
+    string lats;
+    string elevs;
+    for (int s = 0; s < nsites; s++) {
+        int row = CVT_INT((s + 0.5) * opts_.rows / nsites);
+        int idx = pos_index_[row * opts_.cols + c0];
+        ids += (s == 0 ? "" : ",") + ValueToString(s + 1);
+        lats += (s == 0 ? "" : ",") + FormatValue(SYN_LAT + (opts_.rows - 1 - row) * opts_.cellsize / 111000.);
+        elevs += (s == 0 ? "" : ",") + FormatValue(dem_[idx]);
+    }
+    const char* types[] = {
+        DataType_Precipitation, DataType_MeanTemperature, DataType_MaximumTemperature,
+        DataType_MinimumTemperature, DataType_SolarRadiation, DataType_WindSpeed,
+        DataType_RelativeAirMoisture
+    };
+    vector<float> values(CVT_VINT(ndays) * nsites);
+    for (int t = 0; t < 7; t++) {
+        string type = types[t];
+        for (int d = 0; d < ndays; d++) {
+            double season = sin(2. * PI * ((start_doy + d) % 365 - 105) / 365.);
+            float storm = Noise(d, DataType_Precipitation);
+            for (int s = 0; s < nsites; s++) {
+                int idx = d * nsites + s;
+                float tmean = static_cast<float>(15. + 12. * season + 3. * (Noise(idx, "T") - 0.5));
+                float value = 0.f;
+                if (type == DataType_Precipitation) {
+                    // Rainy days are the same for all sites, and the amounts are slightly different
+                    value = storm < 0.3f ? 40.f * storm / 0.3f * (0.8f + 0.4f * Noise(idx, type)) : 0.f;
+                } else if (type == DataType_MeanTemperature) {
+                    value = tmean;
+                } else if (type == DataType_MaximumTemperature) {
+                    value = tmean + 5.f + 2.f * Noise(idx, type);
+                } else if (type == DataType_MinimumTemperature) {
+                    value = tmean - 5.f - 2.f * Noise(idx, type);
+                } else if (type == DataType_SolarRadiation) {
+                    value = static_cast<float>(15. + 8. * season + 4. * (Noise(idx, type) - 0.5));
+                } else if (type == DataType_WindSpeed) {
+                    value = 1.f + 3.f * Noise(idx, type);
+                } else {
+                    value = storm < 0.3f ? 90.f : 50.f + 30.f * Noise(idx, type);
+                }
+                values[idx] = value;
+            }
+        }
+        STRING_MAP meta;
+        meta["SITES"] = ids;
+        meta["LAT"] = lats;
+        meta["ELEV"] = elevs;
+        meta[Tag_StartTime] = ConvertToString2(start_time);
+        meta[Tag_Interval] = "86400";
+        meta["RECORDS"] = ValueToString(ndays);
+        if (!WriteLocalDataFile(local_path + SEP + "CLIMATE" + SEP + type + ".sbin", meta,
+                                reinterpret_cast<const char*>(values.data()),
+                                CVT_VINT(values.size() * sizeof(float)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SyntheticBasin::WriteSpatial(const string& local_path, ModuleFactory* factory) {
+    string spatial_path = local_path + SEP + DB_TAB_SPATIAL + SEP;
+    string fdir = FlowDirMethodString[D8];
+    int nl = opts_.soil_layers;
+    std::set<string> written;
+    /// Mask, i.e., subbasin raster with NODATA, and slope are required by DataCenter
+    vector<float> values(pos_index_.size(), SYN_NODATA);
+    for (int i = 0; i < n_cells_; i++) {
+        values[cell_row_[i] * opts_.cols + cell_col_[i]] = CVT_FLT(subbasin_[i]);
+    }
+    string mask_name = GetUpper(string("0_") + VAR_SUBBSN[0]);
+    if (!WriteRaster(spatial_path + mask_name + ".sbin", values, 1, true)) { return false; }
+    written.insert(mask_name);
+    RasterValues(GetUpper(VAR_SLOPE[0]), 1, values);
+    if (!WriteRaster(spatial_path + GetUpper(string("0_") + VAR_SLOPE[0]) + ".sbin", values, 1)) { return false; }
+    written.insert(GetUpper(string("0_") + VAR_SLOPE[0]));
+    /// Parameters required by modules, the remote filenames are the same as DataCenter::SetData()
+    map<string, SEIMSModuleSetting*>& settings = factory->GetModuleSettings();
+    map<string, vector<ParamInfo<FLTPT>*> >& params = factory->GetModuleParams();
+    map<string, vector<ParamInfo<int>*> >& params_int = factory->GetModuleParamsInt();
+    vector<string>& module_ids = factory->GetModuleIDs();
+    for (auto it = module_ids.begin(); it != module_ids.end(); ++it) {
+        string dtype = settings[*it]->dataTypeString();
+        vector<std::pair<string, dimensionTypes> > required;
+        for (auto itp = params[*it].begin(); itp != params[*it].end(); ++itp) {
+            if (!StringMatch((*itp)->Source, Source_ParameterDB)
+                && !StringMatch((*itp)->Source, Source_ParameterDB_Optional)) { continue; }
+            required.emplace_back((*itp)->BasicName, (*itp)->Dimension);
+        }
+        for (auto itp = params_int[*it].begin(); itp != params_int[*it].end(); ++itp) {
+            if (!StringMatch((*itp)->Source, Source_ParameterDB)
+                && !StringMatch((*itp)->Source, Source_ParameterDB_Optional)) { continue; }
+            required.emplace_back((*itp)->BasicName, (*itp)->Dimension);
+        }
+        for (auto itr = required.begin(); itr != required.end(); ++itr) {
+            string name = GetUpper(itr->first);
+            dimensionTypes dim = itr->second;
+            string remote = name.find("LOOKUP") == string::npos ? "0_" + name : name;
+            if (StringMatch(name, Tag_Weight[0])) {
+                remote += StringMatch(dtype, DataType_Precipitation) ? "_P" : "_M";
+            }
+            if (written.find(remote) != written.end()) { continue; }
+            bool done = true;
+            if (dim == DT_Raster1D || dim == DT_Raster1DInt || dim == DT_Raster2D || dim == DT_Raster2DInt) {
+                float low = 0.f;
+                float high = 0.f;
+                bool layered = dim == DT_Raster2D || dim == DT_Raster2DInt
+                        || InList(SOIL_DERIVED, name) || FindRange(SOIL_RANGES, name, low, high);
+                int layers = layered ? nl : 1;
+                if (!RasterValues(name, layers, values)) {
+                    LOG(WARNING) << "Raster " << name << " of " << *it << " is unknown, generic values are used.";
+                }
+                done = WriteRaster(spatial_path + remote + ".sbin", values, layers);
+            } else if (dim == DT_Array2D || dim == DT_Array2DInt) {
+                vector<vector<float> > rows;
+                if (StringMatch(name, Tag_ROUTING_LAYERS[0])) {
+                    const vector<vector<int> >* lyrs[2] = {&layers_up_, &layers_down_};
+                    for (int m = 0; m < 2 && done; m++) {
+                        rows.clear();
+                        for (auto itl = lyrs[m]->begin(); itl != lyrs[m]->end(); ++itl) {
+                            rows.emplace_back(itl->begin(), itl->end());
+                        }
+                        done = Write2DArray(spatial_path + remote + LayeringMethodString[m] + fdir + ".sbin", rows);
+                    }
+                } else if (StringMatch(name, Tag_FLOWIN_INDEX[0])) {
+                    for (int i = 0; i < n_cells_; i++) {
+                        rows.emplace_back(flow_in_[i].begin(), flow_in_[i].end());
+                    }
+                    done = Write2DArray(spatial_path + remote + fdir + ".sbin", rows);
+                } else if (StringMatch(name, Tag_FLOWOUT_INDEX[0])) {
+                    for (int i = 0; i < n_cells_; i++) {
+                        rows.emplace_back(flow_out_[i] < 0 ? vector<float>() : vector<float>(1, flow_out_[i]));
+                    }
+                    done = Write2DArray(spatial_path + remote + fdir + ".sbin", rows);
+                } else if (StringMatch(name, Tag_FLOWIN_FRACTION[0]) || StringMatch(name, Tag_FLOWOUT_FRACTION[0])) {
+                    // Not required by D8
+                } else if (StringMatch(name, TAG_OUT_OL_IUH)) {
+                    done = WriteIuh(spatial_path + remote + ".sbin");
+                } else if (StringMatch(name, Tag_Weight[0])) {
+                    done = WriteWeight(spatial_path + remote + ".sbin");
+                } else if (!StringMatch(name, Tag_LapseRate)) {
+                    LOG(WARNING) << "2D array " << name << " of " << *it << " is not supported yet.";
+                }
+            } else if (dim == DT_Array1D || dim == DT_Array1DInt) {
+                LOG(WARNING) << "1D array " << name << " of " << *it << " is not supported yet.";
+            } else if (dim == DT_Scenario) {
+                LOG(WARNING) << "BMPs scenario required by " << *it << " is not supported by local data.";
+            }
+            if (!done) {
+                LOG(ERROR) << "Failed to write " << remote << " of " << *it;
+                return false;
+            }
+            written.insert(remote);
+        }
+    }
+    return true;
+}
+
+bool SyntheticBasin::RasterValues(const string& name, const int layers, vector<float>& values) const {
+    values.assign(CVT_VINT(n_cells_) * layers, 0.f);
+    int c0 = opts_.cols / 2;
+    FLTPT cs = opts_.cellsize;
+    float low = 0.f;
+    float high = 0.f;
+    /// Terrain and watershed
+    if (StringMatch(name, VAR_SUBBSN[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = CVT_FLT(subbasin_[i]); }
+    } else if (StringMatch(name, VAR_STREAM_LINK[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = cell_col_[i] == c0 ? CVT_FLT(subbasin_[i]) : 0.f; }
+    } else if (StringMatch(name, VAR_CHWIDTH[0])) {
+        for (int i = 0; i < n_cells_; i++) {
+            values[i * layers] = cell_col_[i] == c0 ? CVT_FLT(5. + 10. * subbasin_[i] / opts_.subbasins) : 0.f;
+        }
+    } else if (StringMatch(name, VAR_DEM[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = dem_[i]; }
+    } else if (StringMatch(name, VAR_SLOPE[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = slope_[i]; }
+    } else if (StringMatch(name, VAR_FLOWDIR[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = CVT_FLT(flow_dir_[i]); }
+    } else if (StringMatch(name, VAR_ACC[0])) {
+        vector<float> acc(n_cells_, 1.f);
+        for (auto it = topo_order_.begin(); it != topo_order_.end(); ++it) {
+            if (flow_out_[*it] >= 0) { acc[flow_out_[*it]] += acc[*it]; }
+        }
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = acc[i]; }
+    } else if (StringMatch(name, VAR_CELL_LAT[0])) {
+        for (int i = 0; i < n_cells_; i++) {
+            values[i * layers] = CVT_FLT(SYN_LAT + (opts_.rows - 1 - cell_row_[i]) * cs / 111000.);
+        }
+    } else if (StringMatch(name, VAR_LANDUSE[0]) || StringMatch(name, VAR_LANDCOVER[0])) {
+        // Landcover (i.e., crop code) is the same as landuse code
+        for (int i = 0; i < n_cells_; i++) {
+            int k = Min(CVT_INT(Noise(i, VAR_LANDUSE[0]) * SYN_LANDUSE_NUM), SYN_LANDUSE_NUM - 1);
+            values[i * layers] = CVT_FLT(SYN_LANDUSES[k]);
+        }
+    } else if (StringMatch(name, VAR_SOILLAYERS[0])) {
+        for (int i = 0; i < n_cells_; i++) { values[i * layers] = CVT_FLT(opts_.soil_layers); }
+    }
+    /// Soil properties, which are consistent with each other
+    else if (InList(SOIL_DERIVED, name) || StringMatch(name, VAR_SOL_ZMX[0])
+        || StringMatch(name, VAR_SOL_SUMAWC[0]) || StringMatch(name, VAR_SOL_SUMSAT[0])) {
+        int nl = opts_.soil_layers;
+        float fc_low, fc_high, wp_low, wp_high, por_low, por_high;
+        FindRange(SOIL_RANGES, VAR_FIELDCAP[0], fc_low, fc_high);
+        FindRange(SOIL_RANGES, VAR_WILTPOINT[0], wp_low, wp_high);
+        FindRange(SOIL_RANGES, VAR_POROST[0], por_low, por_high);
+        for (int i = 0; i < n_cells_; i++) {
+            float total = 600.f + 600.f * Noise(i, VAR_SOILDEPTH[0]);
+            float thick = total / nl;
+            float sum_awc = 0.f;
+            float sum_ul = 0.f;
+            for (int j = 0; j < nl; j++) {
+                int idx = i * nl + j;
+                float fc = fc_low + (fc_high - fc_low) * Noise(idx, VAR_FIELDCAP[0]);
+                float wp = wp_low + (wp_high - wp_low) * Noise(idx, VAR_WILTPOINT[0]);
+                float por = por_low + (por_high - por_low) * Noise(idx, VAR_POROST[0]);
+                float value = 0.f;
+                if (StringMatch(name, VAR_SOILDEPTH[0])) {
+                    value = thick * (j + 1);
+                } else if (StringMatch(name, VAR_SOILTHICK[0])) {
+                    value = thick;
+                } else if (StringMatch(name, VAR_SOL_AWC[0])) {
+                    value = (fc - wp) * thick;
+                } else if (StringMatch(name, VAR_SOL_UL[0])) {
+                    value = (por - wp) * thick;
+                } else if (StringMatch(name, VAR_SOL_WPMM[0])) {
+                    value = wp * thick;
+                }
+                if (j < layers) { values[i * layers + j] = value; }
+                sum_awc += (fc - wp) * thick;
+                sum_ul += (por - wp) * thick;
+            }
+            if (StringMatch(name, VAR_SOL_ZMX[0])) {
+                values[i * layers] = total;
+            } else if (StringMatch(name, VAR_SOL_SUMAWC[0])) {
+                values[i * layers] = sum_awc;
+            } else if (StringMatch(name, VAR_SOL_SUMSAT[0])) {
+                values[i * layers] = sum_ul;
+            }
+        }
+    }
+    /// Others are uniformly distributed in the ranges, e.g., parameters from lookup tables
+    else {
+        bool known = FindRange(RASTER_RANGES, name, low, high) || FindRange(SOIL_RANGES, name, low, high);
+        if (!known) {
+            low = 0.1f;
+            high = 0.5f;
+        }
+        for (int i = 0; i < n_cells_; i++) {
+            for (int j = 0; j < layers; j++) {
+                values[i * layers + j] = low + (high - low) * Noise(i * layers + j, name);
+            }
+        }
+        return known;
+    }
+    return true;
+}
+
+bool SyntheticBasin::WriteRaster(const string& filename, const vector<float>& values, const int layers,
+                                 const bool include_nodata /* = false */) const {
+    STRING_MAP meta;
+    meta[HEADER_RS_NCOLS] = ValueToString(opts_.cols);
+    meta[HEADER_RS_NROWS] = ValueToString(opts_.rows);
+    meta[HEADER_RS_CELLSNUM] = ValueToString(include_nodata ? CVT_INT(pos_index_.size()) : n_cells_);
+    meta[HEADER_RS_LAYERS] = ValueToString(layers);
+    meta[HEADER_RS_NODATA] = FormatValue(SYN_NODATA);
+    meta[HEADER_RS_CELLSIZE] = FormatValue(opts_.cellsize);
+    meta[HEADER_RS_XLL] = FormatValue(SYN_XLL);
+    meta[HEADER_RS_YLL] = FormatValue(SYN_YLL);
+    meta[HEADER_RS_DATATYPE] = RasterDataTypeToString(RDT_Float);
+    meta[HEADER_RSOUT_DATATYPE] = RasterDataTypeToString(RDT_Float);
+    meta[HEADER_INC_NODATA] = include_nodata ? "TRUE" : "FALSE";
+    return WriteLocalDataFile(filename, meta, reinterpret_cast<const char*>(values.data()),
+                              CVT_VINT(values.size() * sizeof(float)));
+}
+
+bool SyntheticBasin::Write2DArray(const string& filename, const vector<vector<float> >& rows) const {
+    vector<float> values;
+    values.emplace_back(CVT_FLT(rows.size()));
+    for (auto it = rows.begin(); it != rows.end(); ++it) {
+        values.emplace_back(CVT_FLT(it->size()));
+        values.insert(values.end(), it->begin(), it->end());
+    }
+    return WriteLocalDataFile(filename, STRING_MAP(), reinterpret_cast<const char*>(values.data()),
+                              CVT_VINT(values.size() * sizeof(float)));
+}
+
+bool SyntheticBasin::WriteWeight(const string& filename) const {
+    int nsites = opts_.sites;
+    int c0 = opts_.cols / 2;
+    FLTPT cs = opts_.cellsize;
+    vector<float> values(CVT_VINT(n_cells_) * nsites);
+    for (int i = 0; i < n_cells_; i++) {
+        // Inverse distance weights to the sites along the main channel
+        FLTPT sum = 0.;
+        for (int s = 0; s < nsites; s++) {
+            FLTPT dr = (cell_row_[i] - (s + 0.5) * opts_.rows / nsites) * cs;
+            FLTPT dc = (cell_col_[i] - c0) * cs;
+            FLTPT w = 1. / (dr * dr + dc * dc + cs * cs);
+            values[i * nsites + s] = CVT_FLT(w);
+            sum += w;
+        }
+        for (int s = 0; s < nsites; s++) { values[i * nsites + s] /= CVT_FLT(sum); }
+    }
+    STRING_MAP meta;
+    meta[MONG_GRIDFS_WEIGHT_CELLS] = ValueToString(n_cells_);
+    meta[MONG_GRIDFS_WEIGHT_SITES] = ValueToString(nsites);
+    return WriteLocalDataFile(filename, meta, reinterpret_cast<const char*>(values.data()),
+                              CVT_VINT(values.size() * sizeof(float)));
+}
+
+bool SyntheticBasin::WriteIuh(const string& filename) const {
+    int c0 = opts_.cols / 2;
+    vector<float> values;
+    values.emplace_back(CVT_FLT(n_cells_));
+    for (int i = 0; i < n_cells_; i++) {
+        // Travel time to the channel in days, the unit hydrograph is uniformly distributed
+        int days = Min(CVT_INT(Abs(cell_col_[i] - c0) * opts_.cellsize / SYN_VELOCITY), 10);
+        values.emplace_back(0.f);
+        values.emplace_back(CVT_FLT(days));
+        for (int d = 0; d <= days; d++) { values.emplace_back(1.f / (days + 1)); }
+    }
+    return WriteLocalDataFile(filename, STRING_MAP(), reinterpret_cast<const char*>(values.data()),
+                              CVT_VINT(values.size() * sizeof(float)));
+}
@@ -0,0 +1,139 @@
+/*!
+ * \file SyntheticBasin.h
+ * \brief Synthetic watershed of configurable size for benchmarking modules and the driver.
+ *
+ *        The basin is written as local model data (see LocalDataFile.h), which can be read
+ *        by DataCenterLocal, i.e., no MongoDB is required. The terrain is a V-shaped valley
+ *        within an elliptic boundary:
+ *          - The main channel is the central column which flows from north to south
+ *          - Hillslope cells flow toward the channel (W or E), sometimes diagonally (SW or SE)
+ *          - Subbasins are horizontal bands along the channel, whose reaches form a chain
+ *
+ *        Spatial data are generated according to the parameters required by the modules
+ *        of a ModuleFactory, so that different module configurations can be benchmarked.
+ *        All values are deterministic, i.e., the same options result in the same data.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_SYNTHETIC_BASIN_H
+#define SEIMS_SYNTHETIC_BASIN_H
+
+#include <string>
+#include <vector>
+
+#include "basic.h"
+#include "seims.h"
+#include "ModuleFactory.h"
+
+using namespace ccgl;
+using std::string;
+using std::vector;
+
+/*!
+ * \ingroup seims_benchmark
+ * \struct SyntheticOptions
+ * \brief Size and simulation period of synthetic watershed
+ */
+struct SyntheticOptions {
+    SyntheticOptions() : rows(200), cols(200), cellsize(30.), soil_layers(3), subbasins(5),
+                         sites(3), days(365), start_date("2010-01-01 00:00:00") {}
+    int rows;          ///< Rows of raster
+    int cols;          ///< Columns of raster
+    FLTPT cellsize;    ///< Cell size in meters
+    int soil_layers;   ///< Soil layers of all cells
+    int subbasins;     ///< Subbasins (and reaches) number
+    int sites;         ///< Climate sites number, for both P and M
+    int days;          ///< Simulation days
+    string start_date; ///< Start date of simulation, YYYY-MM-DD HH:MM:SS
+};
+
+/*!
+ * \ingroup seims_benchmark
+ * \class SyntheticBasin
+ * \brief Generate and write synthetic watershed data
+ */
+class SyntheticBasin: NotCopyable {
+public:
+    //! Constructor, build the terrain and routing topology
+    explicit SyntheticBasin(const SyntheticOptions& opts);
+
+    /*!
+     * \brief Write model data required by the modules of factory
+     * \param[in] local_path Local data directory, see DataCenterLocal
+     * \param[in] factory Module factory initialized by the model configuration
+     * \param[in] param_file Initial parameters, i.e., `seims/preprocess/database/model_param_ini.csv`
+     * \return True if succeed
+     */
+    bool Write(const string& local_path, ModuleFactory* factory, const string& param_file);
+
+    //! Number of valid cells
+    int GetValidCellNumber() const { return n_cells_; }
+
+    //! Number of routing layers (UP_DOWN)
+    int GetRoutingLayers() const { return CVT_INT(layers_up_.size()); }
+
+    //! Options
+    const SyntheticOptions& GetOptions() const { return opts_; }
+
+private:
+    //! Mask, subbasins, DEM, slope, and flow directions
+    void BuildTerrain();
+    //! Flow in/out indexes and routing layers
+    void BuildRouting();
+
+    //! Write MANIFEST, FILE_IN, FILE_OUT, SITELIST, REACHES, and PARAMETERS
+    bool WriteTables(const string& local_path, ModuleFactory* factory, const string& param_file);
+    //! Write regular climate data of P and M sites
+    bool WriteClimate(const string& local_path);
+    //! Write spatial data of all parameters required by modules
+    bool WriteSpatial(const string& local_path, ModuleFactory* factory);
+
+    /*!
+     * \brief Write raster data
+     * \param[in] filename Output file
+     * \param[in] values Values of valid cells in cell-major order, or values of all cells if include_nodata
+     * \param[in] layers Layers number
+     * \param[in] include_nodata Values include NODATA or not, only the mask raster includes NODATA
+     */
+    bool WriteRaster(const string& filename, const vector<float>& values, int layers,
+                     bool include_nodata = false) const;
+    //! Write irregular 2D array, i.e., rows and (count, values...) of each row
+    bool Write2DArray(const string& filename, const vector<vector<float> >& rows) const;
+    //! Write interpolation weights of cells and sites
+    bool WriteWeight(const string& filename) const;
+    //! Write overland IUH of cells
+    bool WriteIuh(const string& filename) const;
+
+    /*!
+     * \brief Values of raster parameter
+     * \param[in] name Parameter name, upper case
+     * \param[in] layers Layers number, 1 or soil layers
+     * \param[out] values Values of valid cells in cell-major order
+     * \return False if the parameter is unknown, and generic values are generated
+     */
+    bool RasterValues(const string& name, int layers, vector<float>& values) const;
+
+    //! Deterministic pseudo-random value in [0, 1) of cell (or any index) and key
+    static float Noise(int idx, const string& key);
+
+private:
+    SyntheticOptions opts_;
+    int n_cells_;                        ///< Valid cells number
+    vector<int> pos_index_;              ///< Full-size raster index to valid cell index, -1 if invalid
+    vector<int> cell_row_;               ///< Row of valid cells
+    vector<int> cell_col_;               ///< Column of valid cells
+    vector<int> subbasin_;               ///< Subbasin ID of valid cells
+    vector<int> flow_out_;               ///< Downstream cell index, -1 for outlet
+    vector<int> flow_dir_;               ///< D8 flow direction code (ArcGIS)
+    vector<float> dem_;                  ///< Elevation
+    vector<float> slope_;                ///< Slope, drop/distance
+    vector<vector<int> > flow_in_;       ///< Upstream cells of each cell
+    vector<int> topo_order_;             ///< Cells in topological order, from sources to outlet
+    vector<vector<int> > layers_up_;     ///< Routing layers from sources (UP_DOWN)
+    vector<vector<int> > layers_down_;   ///< Routing layers from outlet (DOWN_UP)
+};
+
+#endif /* SEIMS_SYNTHETIC_BASIN_H */
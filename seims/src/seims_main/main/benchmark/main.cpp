@@ -0,0 +1,298 @@
+/*!
+ * \file main.cpp
+ * \brief Benchmark of SEIMS modules and the OpenMP driver based on synthetic watersheds.
+ *
+ *        A synthetic watershed of the given size is written as local model data
+ *        (see SyntheticBasin.h), then the model configured by a module chain is executed
+ *        for the given days by ModelMain without MongoDB. The throughput of each module and
+ *        the entire model, i.e., cells x steps per second, is reported as JSON, which can be
+ *        compared across commits to catch performance regressions.
+ *
+ *        Usage:
+ *          seims_benchmark -wp <workPath> -param <model_param_ini.csv> [-suite <config.fig>
+ *                          -rows <rows> -cols <cols> -layers <soilLayers> -subbasins <subbasins>
+ *                          -sites <sites> -days <days> -thread <threads> -lyr <layeringMethod>
+ *                          -repeat <repeat> -save <saveOutputs> -o <output.json>]
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Optionally save simulated outputs for numerical regression of builds.
+ *
+ * \author Liangjun Zhu
+ */
+#include <fstream>
+
+#include "basic.h"
+#include "seims.h"
+#include "invoke.h"
+#include "ModelMain.h"
+#include "DataCenterLocal.h"
+#include "Logging.h"
+#include "SyntheticBasin.h"
+
+#include "utils_filesystem.h"
+#include "utils_string.h"
+
+INITIALIZE_EASYLOGGINGPP
+
+using namespace utils_filesystem;
+using namespace utils_string;
+
+namespace {
+/// Default module chain for benchmarking, which requires no BMPs scenario.
+const char* DEFAULT_SUITE[] = {
+    "0 | TimeSeries | | TSD_RD",
+    "0 | Interpolation_0 | Thiessen | ITP",
+    "0 | Soil temperature | Finn Plauborg | STP_FP",
+    "0 | PET | PenmanMonteith | PET_PM",
+    "0 | Interception | Maximum Canopy Storage | PI_MCS",
+    "0 | Snow melt | Snowpeak Daily | SNO_SP",
+    "0 | Infiltration | Modified rational | SUR_MR",
+    "0 | Depression and Surface Runoff | Linsley | DEP_LINSLEY",
+    "0 | Percolation | Storage routing | PER_STR",
+    "0 | Subsurface | Darcy and Kinematic | SSR_DA",
+    "0 | SET | Linearly Method from WetSpa | SET_LM",
+    "0 | PG | Simplified EPIC | PG_EPIC",
+    "0 | NUTR_TF | Nutrient Transformation of C, N, and P | NUTR_TF",
+    "0 | Water overland routing | IUH | IUH_OL",
+    "0 | Soil water | Water balance | SOL_WB",
+    "0 | Groundwater | Linear reservoir | GWA_RE",
+    "0 | Water channel routing | MUSK | MUSK_CH",
+    ""
+};
+
+/// Version of the JSON report, increase it when the keys are changed.
+const int BENCHMARK_REPORT_VERSION = 1;
+
+struct ModuleTiming {
+    string id;
+    double seconds;
+};
+
+void BenchmarkUsage(const string& appname, const string& error_msg) {
+    if (!error_msg.empty()) {
+        cout << "FAILURE: " << error_msg << endl;
+    }
+    cout << "Usage:\n" << appname << " -wp <workPath> -param <paramFile> [-suite <configFile>"
+            " -rows <rows> -cols <cols> -layers <soilLayers> -subbasins <subbasins>"
+            " -sites <sites> -days <days> -thread <threadsNum> -lyr <layeringMethod>"
+            " -repeat <repeat> -save <saveOutputs> -o <outputFile>]\n";
+    cout << "\t<workPath> is the working directory to write synthetic data and outputs.\n";
+    cout << "\t<paramFile> is the initial parameters, i.e., seims/preprocess/database/model_param_ini.csv.\n";
+    cout << "\t<configFile> is the module chain in the format of config.fig, "
+            "modules require BMPs scenario are not supported.\n";
+    cout << "\t\tBy default, a hydrological chain from TSD_RD to MUSK_CH is used.\n";
+    cout << "\t<rows> and <cols> are the size of raster, 200 x 200 by default.\n";
+    cout << "\t<soilLayers>, <subbasins>, and <sites> are 3, 5, and 3 by default.\n";
+    cout << "\t<days> is the simulation days, i.e., time steps of daily modules, 365 by default.\n";
+    cout << "\t<threadsNum> is the number of thread used by OpenMP, 1 by default.\n";
+    cout << "\t<layeringMethod> can be 0 and 1, which means UP_DOWN (default) and DOWN_UP, respectively.\n";
+    cout << "\t<repeat> is the repeated times of execution, the fastest one is reported, 1 by default.\n";
+    cout << "\t<saveOutputs> can be 0 and 1, 1 means saving the simulated outputs of the last execution "
+            "into <workPath>, e.g., for comparing outputs of float64 and mixed precision builds "
+            "by seims/postprocess/compare_precision.py, 0 by default.\n";
+    cout << "\t<outputFile> is the JSON report, which is printed to the screen if not specified.\n\n";
+    exit(1);
+}
+
+bool ParsePositiveInt(const char* value, int& result) {
+    bool success = false;
+    int v = CVT_INT(IsInt(value, success));
+    if (!success || v < 1) { return false; }
+    result = v;
+    return true;
+}
+
+bool WriteConfig(const string& suite_file, const string& config_file) {
+    vector<string> lines;
+    if (!suite_file.empty()) {
+        if (!LoadPlainTextFile(suite_file, lines)) { return false; }
+    } else {
+        for (int i = 0; *DEFAULT_SUITE[i] != '\0'; i++) { lines.emplace_back(DEFAULT_SUITE[i]); }
+    }
+    std::ofstream ofs(config_file.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) { return false; }
+    for (auto it = lines.begin(); it != lines.end(); ++it) { ofs << *it << endl; }
+    ofs.close();
+    return true;
+}
+
+/// Cells x steps per second, the module is regarded as executed once per day
+double Throughput(const int cells, const int steps, const double seconds) {
+    return seconds > 0. ? cells * CVT_DBL(steps) / seconds : 0.;
+}
+
+string JsonNumber(const double value) {
+    std::ostringstream oss;
+    oss << std::fixed << setprecision(6) << value;
+    return oss.str();
+}
+} /* namespace */
+
+int main(const int argc, const char** argv) {
+    string work_path;
+    string param_file;
+    string suite_file;
+    string output_file;
+    SyntheticOptions opts;
+    int num_thread = 1;
+    LayeringMethod layering_method = UP_DOWN;
+    int repeat = 1;
+    bool save_outputs = false;
+    /// Parse input arguments.
+    if (argc < 5) { BenchmarkUsage(argv[0], ""); }
+    for (int i = 1; i < argc; i += 2) {
+        if (i + 1 >= argc) { BenchmarkUsage(argv[0], "No value is specified for " + string(argv[i])); }
+        string key = argv[i];
+        const char* value = argv[i + 1];
+        bool valid = true;
+        if (StringMatch(key, "-wp")) {
+            work_path = value;
+        } else if (StringMatch(key, "-param")) {
+            param_file = value;
+        } else if (StringMatch(key, "-suite")) {
+            suite_file = value;
+        } else if (StringMatch(key, "-o")) {
+            output_file = value;
+        } else if (StringMatch(key, "-rows")) {
+            valid = ParsePositiveInt(value, opts.rows);
+        } else if (StringMatch(key, "-cols")) {
+            valid = ParsePositiveInt(value, opts.cols);
+        } else if (StringMatch(key, "-layers")) {
+            valid = ParsePositiveInt(value, opts.soil_layers);
+        } else if (StringMatch(key, "-subbasins")) {
+            valid = ParsePositiveInt(value, opts.subbasins);
+        } else if (StringMatch(key, "-sites")) {
+            valid = ParsePositiveInt(value, opts.sites);
+        } else if (StringMatch(key, "-days")) {
+            valid = ParsePositiveInt(value, opts.days);
+        } else if (StringMatch(key, "-thread")) {
+            valid = ParsePositiveInt(value, num_thread);
+        } else if (StringMatch(key, "-repeat")) {
+            valid = ParsePositiveInt(value, repeat);
+        } else if (StringMatch(key, "-lyr")) {
+            valid = StringMatch(value, "0") || StringMatch(value, "1");
+            layering_method = StringMatch(value, "1") ? DOWN_UP : UP_DOWN;
+        } else if (StringMatch(key, "-save")) {
+            valid = StringMatch(value, "0") || StringMatch(value, "1");
+            save_outputs = StringMatch(value, "1");
+        } else {
+            BenchmarkUsage(argv[0], "Unknown argument: " + key);
+        }
+        if (!valid) { BenchmarkUsage(argv[0], "Invalid value of " + key + ": " + string(value)); }
+    }
+    if (work_path.empty() || param_file.empty()) {
+        BenchmarkUsage(argv[0], "Both -wp and -param are required.");
+    }
+    if (opts.subbasins > opts.rows) { BenchmarkUsage(argv[0], "Subbasins should not be greater than rows."); }
+    if (opts.sites > opts.rows) { BenchmarkUsage(argv[0], "Sites should not be greater than rows."); }
+
+    /// Initialize easylogging++
+    START_EASYLOGGINGPP(argc, argv);
+    Logging::init();
+    Logging::setLogLevel(Logging::getLLfromString("Warning"), nullptr);
+    /// Register GDAL
+    GDALAllRegister();
+
+    try {
+        if (!DirectoryExists(work_path) && !MakeDirectory(work_path)) {
+            throw ModelException("Benchmark", "main", "Failed to create " + work_path);
+        }
+        if (!WriteConfig(suite_file, work_path + SEP + "config.fig")) {
+            throw ModelException("Benchmark", "main", "Failed to write config.fig from " + suite_file);
+        }
+        string local_path = work_path + SEP + "local";
+        InputArgs* input_args = new InputArgs(work_path, "", num_thread, D8, layering_method,
+                                              "127.0.0.1", 27017, -1, -1, 0, KMETIS, SPATIAL, -1,
+                                              "Warning", 0, local_path);
+        ModuleFactory* module_factory = ModuleFactory::Init(GetAppPath(), input_args);
+        if (nullptr == module_factory) {
+            throw ModelException("ModuleFactory", "Constructor", "Failed in constructing ModuleFactory!");
+        }
+        double gen_t = TimeCounting();
+        SyntheticBasin basin(opts);
+        if (!basin.Write(local_path, module_factory, param_file)) {
+            throw ModelException("SyntheticBasin", "Write", "Failed to write synthetic watershed data!");
+        }
+        gen_t = TimeCounting() - gen_t;
+
+        /// Execute the model repeatedly, and keep the fastest one
+        double best_setup = -1.;
+        double best_execute = -1.;
+        vector<ModuleTiming> timings;
+        for (int r = 0; r < repeat; r++) {
+            double setup_t = TimeCounting();
+            DataCenter* data_center = new DataCenterLocal(input_args, module_factory, 0);
+            ModelMain* model_main = new ModelMain(data_center, module_factory);
+            setup_t = TimeCounting() - setup_t;
+            double exec_t = TimeCounting();
+            model_main->Execute();
+            exec_t = TimeCounting() - exec_t;
+            if (save_outputs && r == repeat - 1) { model_main->Output(); }
+            if (best_execute < 0. || exec_t < best_execute) {
+                best_setup = setup_t;
+                best_execute = exec_t;
+                timings.clear();
+                for (int i = 0; i < model_main->GetModuleCount(); i++) {
+                    ModuleTiming timing;
+                    timing.id = model_main->GetModuleID(i);
+                    timing.seconds = model_main->GetModuleExecuteTime(i);
+                    timings.emplace_back(timing);
+                }
+            }
+            delete model_main;
+            delete data_center;
+        }
+
+        /// Report as JSON, the keys are kept in a stable order for comparison
+        int cells = basin.GetValidCellNumber();
+        std::ostringstream oss;
+        oss << "{\n";
+        oss << "  \"version\": " << BENCHMARK_REPORT_VERSION << ",\n";
+        oss << "  \"basin\": {\"rows\": " << opts.rows << ", \"cols\": " << opts.cols
+                << ", \"cells\": " << cells << ", \"soil_layers\": " << opts.soil_layers
+                << ", \"subbasins\": " << opts.subbasins << ", \"sites\": " << opts.sites
+                << ", \"routing_layers\": " << basin.GetRoutingLayers()
+                << ", \"generate_seconds\": " << JsonNumber(gen_t) << "},\n";
+        oss << "  \"run\": {\"steps\": " << opts.days << ", \"threads\": " << num_thread
+                << ", \"layering\": \"" << LayeringMethodString[layering_method] + 1
+                << "\", \"repeat\": " << repeat << "},\n";
+        oss << "  \"modules\": [\n";
+        for (auto it = timings.begin(); it != timings.end(); ++it) {
+            oss << "    {\"id\": \"" << it->id << "\", \"seconds\": " << JsonNumber(it->seconds)
+                    << ", \"cells_steps_per_sec\": " << JsonNumber(Throughput(cells, opts.days, it->seconds))
+                    << "}" << (it + 1 == timings.end() ? "" : ",") << "\n";
+        }
+        oss << "  ],\n";
+        oss << "  \"model\": {\"setup_seconds\": " << JsonNumber(best_setup)
+                << ", \"execute_seconds\": " << JsonNumber(best_execute)
+                << ", \"cells_steps_per_sec\": " << JsonNumber(Throughput(cells, opts.days, best_execute))
+                << "}\n";
+        oss << "}\n";
+        if (output_file.empty()) {
+            cout << oss.str();
+        } else {
+            std::ofstream ofs(output_file.c_str(), std::ios::out | std::ios::trunc);
+            if (!ofs.is_open()) {
+                throw ModelException("Benchmark", "main", "Failed to write " + output_file);
+            }
+            ofs << oss.str();
+            ofs.close();
+        }
+        delete module_factory;
+        delete input_args;
+        el::Loggers::flushAll();
+    } catch (ModelException& e) {
+        LOG(ERROR) << e.ToString();
+        exit(EXIT_FAILURE);
+    }
+    catch (std::exception& e) {
+        LOG(ERROR) << e.what();
+        exit(EXIT_FAILURE);
+    }
+    catch (...) {
+        LOG(ERROR) << "Unknown exception occurred!";
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
@@ -9,16 +9,604 @@
 #include "ModelMain.h"
 #include "text.h"
 #include "Logging.h"
+#include "Tracing.h"
 
 #include "parallel.h"
 #include "TaskInformation.h"
 #include "LoadParallelTasks.h"
+#include "PartitionTasks.h"
+#include "NodeSharedInputs.h"
+#include "TransferExchange.h"
+#include "SubbasinResultCache.h"
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
 
 using namespace utils_time;
 using namespace utils_array;
 using std::map;
 using std::vector;
 
+namespace {
+/*!
+ * \brief Shared context of stepping the subbasins of a routing layer.
+ *
+ *        The subbasins of the same routing layer are independent with each other, and each of them
+ *        owns its ModelMain. The maps are only looked up during stepping except for the entries of
+ *        the stepped subbasin itself, thus the same-layer subbasins can be stepped concurrently.
+ */
+struct LayerStepContext {
+    int rank;
+    int n_hs;                ///< Hillslope steps of a channel step
+    time_t dt_hs;
+    bool include_channel;
+    map<int, ModelMain *>* model_map;
+    map<int, int>* subbasin_rank;
+    map<int, int>* downstream;
+    map<int, vector<int> >* upstreams;
+    map<int, int>* subbasin_layer;                ///< Routing layer of each subbasin
+    map<int, double>* priority;                   ///< Execution priorities of subbasins in current rank
+    map<int, map<int, float *> >* tf_values;      ///< Transferred values of subbasins in current rank
+    map<int, map<int, float *> >* recv_tf_values; ///< Transferred values received from other ranks
+    map<int, int>* subbsn_loop;                   ///< Actual simulation loop number of each subbasin
+    map<int, double>* subbsn_cost;                ///< Accumulated computing time of each subbasin
+    TransferExchange* exchange;                   ///< Slots of transferred values to other ranks
+    SubbasinResultCache* cache;                   ///< Cached results of subbasins, nullptr if not used
+    int trace_slope;
+    int trace_channel;
+};
+
+/*!
+ * \brief Replay one subbasin from the cached results of the baseline run,
+ *        i.e., fill the transferred values to its downstream subbasin without simulation.
+ */
+void ReplaySubbasin(const LayerStepContext& ctx, const int subbasin_id, const time_t cur_time,
+                    const int cur_sim_loop_num, const int act_loop_num) {
+    if (!ctx.include_channel) { return; }
+    ctx.subbsn_loop->at(subbasin_id) = act_loop_num;
+    int downstream_id = ctx.downstream->at(subbasin_id);
+    if (downstream_id < 0) { return; }
+    float* tf_values = ctx.subbasin_rank->at(downstream_id) == ctx.rank
+                       ? ctx.tf_values->at(cur_sim_loop_num).at(subbasin_id)
+                       : ctx.exchange->GetSendValues(subbasin_id);
+    if (!ctx.cache->GetTransferredValues(subbasin_id, cur_time, tf_values)) {
+        throw ModelException("CalculateProcess", "ReplaySubbasin",
+                             "No cached transferred values of subbasin " + ValueToString(subbasin_id));
+    }
+}
+
+/*!
+ * \brief Step the hillslope and channel processes of one subbasin.
+ *
+ *        The transferred values from upstream subbasins of other ranks have been received,
+ *        and the transferred values to the downstream subbasin of another rank are packed into
+ *        the slot of the aggregated message, which will be sent after the entire layer is stepped.
+ * \param[in] ctx Shared context
+ * \param[in] subbasin_id Subbasin ID
+ * \param[in] cur_time Current time
+ * \param[in] year_idx Year index
+ * \param[in] cur_ilyr Current routing layer
+ * \param[in] cur_sim_loop_num Simulation loop number, i.e., stamp of transferred values
+ * \param[in] act_loop_num Actual simulation loop number
+ * \param[out] t_slope Accumulated time of hillslope processes
+ * \param[out] t_channel Accumulated time of channel processes
+ */
+void StepSubbasin(const LayerStepContext& ctx, const int subbasin_id, const time_t cur_time,
+                  const int year_idx, const int cur_ilyr, const int cur_sim_loop_num,
+                  const int act_loop_num, double& t_slope, double& t_channel) {
+    if (nullptr != ctx.cache && ctx.cache->IsReplayed(subbasin_id)) {
+        ReplaySubbasin(ctx, subbasin_id, cur_time, cur_sim_loop_num, act_loop_num);
+        return;
+    }
+    // 1. Execute hillslope processes
+    double t_slope_start = MPI_Wtime();
+    double trace_t = Tracer::Now();
+    ModelMain* psubbasin = ctx.model_map->at(subbasin_id);
+    for (int i = 0; i < ctx.n_hs; i++) {
+        psubbasin->StepHillSlope(cur_time + i * ctx.dt_hs, year_idx, i);
+    }
+    double t_slope_step = MPI_Wtime() - t_slope_start;
+    t_slope += t_slope_step;
+    ctx.subbsn_cost->at(subbasin_id) += t_slope_step;
+    if (Tracer::Enabled()) {
+        Tracer::Record(TRACE_STEP, ctx.trace_slope, trace_t, Tracer::Now(),
+                       cur_time, subbasin_id, cur_ilyr);
+    }
+    if (!ctx.include_channel) { return; }
+
+    // 2. Execute channel processes
+    double t_channel_start = MPI_Wtime();
+    TraceSpan channel_span(TRACE_STEP, ctx.trace_channel, cur_time, subbasin_id, cur_ilyr);
+
+    // 2.1 Set transferred data from upstreams
+    auto it_ups = ctx.upstreams->find(subbasin_id);
+    if (it_ups != ctx.upstreams->end()) {
+        for (auto it_upid = it_ups->second.begin(); it_upid != it_ups->second.end(); ++it_upid) {
+            int up_rank = ctx.subbasin_rank->at(*it_upid);
+            if (up_rank == ctx.rank) {
+                psubbasin->SetTransferredValue(*it_upid, ctx.tf_values->at(cur_sim_loop_num).at(*it_upid));
+                continue;
+            }
+            // received before stepping the layer, see TransferExchange::Receive()
+            psubbasin->SetTransferredValue(*it_upid, ctx.recv_tf_values->at(cur_sim_loop_num).at(*it_upid));
+        }
+    }
+    psubbasin->StepChannel(cur_time, year_idx);
+    psubbasin->AppendOutputData(cur_time);
+    ctx.subbsn_loop->at(subbasin_id) = act_loop_num;
+
+    // 2.2 The outlet subbasin has no downstream
+    int downstream_id = ctx.downstream->at(subbasin_id);
+    if (downstream_id < 0) {
+        // There is no need to get transferred values
+        double t_channel_step = MPI_Wtime() - t_channel_start;
+        t_channel += t_channel_step;
+        ctx.subbsn_cost->at(subbasin_id) += t_channel_step;
+        return;
+    }
+    // 2.3 If the downstream subbasin is in this process, there is no need to transfer values to other ranks,
+    //     otherwise, the transferred values of current subbasin should be sent to another rank
+    float* tf_values = ctx.subbasin_rank->at(downstream_id) == ctx.rank
+                       ? ctx.tf_values->at(cur_sim_loop_num).at(subbasin_id)
+                       : ctx.exchange->GetSendValues(subbasin_id);
+    psubbasin->GetTransferredValue(tf_values);
+    // 2.4 Record the transferred values as baseline for incremental simulation
+    if (nullptr != ctx.cache) { ctx.cache->Record(subbasin_id, cur_time, tf_values); }
+    double t_channel_step = MPI_Wtime() - t_channel_start;
+    t_channel += t_channel_step;
+    ctx.subbsn_cost->at(subbasin_id) += t_channel_step;
+}
+
+/*!
+ * \brief Step the hillslope processes of one independent subbasin through the entire simulation period.
+ *
+ *        Without channel processes and transferred values, the subbasin does not interact with the others,
+ *        thus its entire time loop runs without synchronization, and the outputs are combined at the end.
+ * \param[in] ctx Shared context
+ * \param[in] subbasin_id Subbasin ID
+ * \param[in] start_time Start time
+ * \param[in] end_time End time
+ * \param[in] dt_ch Time step of channel processes, i.e., the interval of appending outputs
+ * \param[in] start_year Start year
+ * \param[out] t_slope Accumulated time of hillslope processes
+ */
+void StepSubbasinPeriod(const LayerStepContext& ctx, const int subbasin_id, const time_t start_time,
+                        const time_t end_time, const time_t dt_ch, const int start_year, double& t_slope) {
+    if (nullptr != ctx.cache && ctx.cache->IsReplayed(subbasin_id)) { return; }
+    double t_slope_start = MPI_Wtime();
+    ModelMain* psubbasin = ctx.model_map->at(subbasin_id);
+    for (time_t ts = start_time; ts <= end_time; ts += dt_ch) {
+        int year_idx = GetYear(ts) - start_year;
+        double trace_t = Tracer::Now();
+        for (int i = 0; i < ctx.n_hs; i++) {
+            psubbasin->StepHillSlope(ts + i * ctx.dt_hs, year_idx, i);
+        }
+        psubbasin->AppendOutputData(ts);
+        if (Tracer::Enabled()) {
+            Tracer::Record(TRACE_STEP, ctx.trace_slope, trace_t, Tracer::Now(), ts, subbasin_id);
+        }
+    }
+    double t_slope_period = MPI_Wtime() - t_slope_start;
+    t_slope += t_slope_period;
+    ctx.subbsn_cost->at(subbasin_id) += t_slope_period;
+}
+
+/*!
+ * \brief Subbasins of current rank in one time step of the ready-driven execution, see StepReadySubbasins().
+ *        The members are accessed in the critical section SEIMS_MPI_READY_QUEUE.
+ */
+struct ReadyQueue {
+    map<int, int> pending;          ///< Number of upstream subbasins whose transferred values are not available
+    map<int, int> downstream;       ///< Downstream subbasin of each upstream subbasin of current rank
+    vector<int> ready;              ///< Subbasins whose transferred values from upstreams are all available
+    int n_remaining;                ///< Number of subbasins not finished
+    int n_running;                  ///< Number of subbasins being stepped
+    map<int, float *>* recv_values; ///< Received transferred values of the simulation loop
+    string error;                   ///< Error of stepping subbasins or exchanging messages
+};
+
+/*!
+ * \brief Initialize the ready queue of the subbasins of current rank, the source subbasins are ready
+ */
+void InitReadyQueue(const LayerStepContext& ctx, const vector<int>& subbasin_ids,
+                    map<int, float *>* recv_values, ReadyQueue& queue) {
+    queue.pending.clear();
+    queue.downstream.clear();
+    queue.ready.clear();
+    queue.n_remaining = CVT_INT(subbasin_ids.size());
+    queue.n_running = 0;
+    queue.recv_values = recv_values;
+    queue.error.clear();
+    for (auto it = subbasin_ids.begin(); it != subbasin_ids.end(); ++it) {
+        auto it_ups = ctx.upstreams->find(*it);
+        int n_ups = 0;
+        if (it_ups != ctx.upstreams->end()) {
+            n_ups = CVT_INT(it_ups->second.size());
+            for (auto it_up = it_ups->second.begin(); it_up != it_ups->second.end(); ++it_up) {
+                queue.downstream[*it_up] = *it;
+            }
+        }
+        queue.pending[*it] = n_ups;
+        if (n_ups == 0) { queue.ready.push_back(*it); }
+    }
+}
+
+/*!
+ * \brief Pop the ready subbasin with the longest critical path to the outlet, and the smallest ID if equal,
+ *        which should be called in the critical section
+ * \return -1 if none of the subbasins is ready
+ */
+int PopReadySubbasin(const LayerStepContext& ctx, ReadyQueue& queue) {
+    if (queue.ready.empty()) { return -1; }
+    size_t best = 0;
+    for (size_t i = 1; i < queue.ready.size(); i++) {
+        double p = ctx.priority->at(queue.ready[i]);
+        double p_best = ctx.priority->at(queue.ready[best]);
+        if (p > p_best || (p == p_best && queue.ready[i] < queue.ready[best])) { best = i; }
+    }
+    int subbasin_id = queue.ready[best];
+    queue.ready.erase(queue.ready.begin() + best);
+    return subbasin_id;
+}
+
+/*!
+ * \brief The transferred values of the upstream subbasin (of either current rank or another rank)
+ *        are available for its downstream subbasin, which should be called in the critical section
+ */
+void ReleaseDownstream(const int upstream_id, ReadyQueue& queue) {
+    // The outlet subbasin, or the downstream subbasin of another rank
+    auto it_down = queue.downstream.find(upstream_id);
+    if (it_down == queue.downstream.end()) { return; }
+    int& n_pending = queue.pending.at(it_down->second);
+    if (--n_pending == 0) { queue.ready.push_back(it_down->second); }
+}
+
+/*!
+ * \brief Send the filled messages, and release the downstream subbasins of the arrived messages
+ * \param[in] ctx Shared context
+ * \param[in] sim_loop Simulation loop number
+ * \param[in] wait Wait until any message arrives, i.e., none of the subbasins is ready or being stepped
+ * \param[in,out] queue Ready queue
+ */
+void ExchangeReadyValues(const LayerStepContext& ctx, const int sim_loop, const bool wait, ReadyQueue& queue) {
+    ctx.exchange->SendFilled(sim_loop);
+    vector<int> arrived;
+    int n_pending = ctx.exchange->TestReceives(sim_loop, *queue.recv_values, wait, arrived);
+    if (wait && arrived.empty() && n_pending == 0) {
+        throw ModelException("CalculateProcess", "ExchangeReadyValues",
+                             "None of the subbasins is ready while no transferred values are pending.");
+    }
+    if (arrived.empty()) { return; }
+#pragma omp critical(SEIMS_MPI_READY_QUEUE)
+    {
+        for (auto it = arrived.begin(); it != arrived.end(); ++it) {
+            ReleaseDownstream(*it, queue);
+        }
+    }
+}
+
+/*!
+ * \brief Step the subbasins of current rank in one time step once ready rather than layer by layer,
+ *        i.e., the transferred values from upstream subbasins are available, which is called by each
+ *        thread of the concurrent region. The ready subbasins with longer critical paths are started first,
+ *        thus the subbasins blocking the longest downstream chains finish first.
+ *
+ *        MPI calls are only made by the master thread (MPI_THREAD_FUNNELED) between stepping subbasins,
+ *        i.e., the messages are sent once all slots are filled, and the arrived messages release the
+ *        downstream subbasins, see TransferExchange::StartStep().
+ * \param[in] ctx Shared context
+ * \param[in,out] queue Ready queue initialized by InitReadyQueue()
+ * \param[in] cur_time Current time
+ * \param[in] year_idx Year index
+ * \param[in] sim_loop Simulation loop number, i.e., stamp of transferred values
+ * \param[in] act_loop_num Actual simulation loop number
+ * \param[out] t_slope Accumulated time of hillslope processes
+ * \param[out] t_channel Accumulated time of channel processes
+ */
+void StepReadySubbasins(const LayerStepContext& ctx, ReadyQueue& queue, const time_t cur_time,
+                        const int year_idx, const int sim_loop, const int act_loop_num,
+                        double& t_slope, double& t_channel) {
+    bool master = true;
+#ifdef SUPPORT_OMP
+    master = omp_get_thread_num() == 0;
+#endif /* SUPPORT_OMP */
+    while (true) {
+        int subbasin_id = -1;
+        bool finished = false;
+        bool idle = false;
+#pragma omp critical(SEIMS_MPI_READY_QUEUE)
+        {
+            if (queue.n_remaining == 0 || !queue.error.empty()) {
+                finished = true;
+            } else {
+                subbasin_id = PopReadySubbasin(ctx, queue);
+                if (subbasin_id >= 0) {
+                    queue.n_running++;
+                } else {
+                    idle = queue.n_running == 0;
+                }
+            }
+        }
+        if (finished) { break; }
+        if (subbasin_id >= 0) {
+            try {
+                StepSubbasin(ctx, subbasin_id, cur_time, year_idx, ctx.subbasin_layer->at(subbasin_id),
+                             sim_loop, act_loop_num, t_slope, t_channel);
+            } catch (std::exception& e) {
+#pragma omp critical(SEIMS_MPI_READY_QUEUE)
+                queue.error = e.what();
+            }
+            ctx.exchange->Fill(subbasin_id);
+#pragma omp critical(SEIMS_MPI_READY_QUEUE)
+            {
+                queue.n_running--;
+                queue.n_remaining--;
+                ReleaseDownstream(subbasin_id, queue);
+            }
+        }
+        if (!master) { continue; }
+        try {
+            ExchangeReadyValues(ctx, sim_loop, idle, queue);
+        } catch (std::exception& e) {
+#pragma omp critical(SEIMS_MPI_READY_QUEUE)
+            queue.error = e.what();
+        }
+    }
+}
+
+/*!
+ * \brief Find the raster output item by core name (appended by aggregation type after flushed)
+ * \return nullptr if not existed
+ */
+PrintInfoItem* FindRasterItem(SettingsOutput* outputs, const string& corename) {
+    for (auto it = outputs->m_printInfos.begin(); it != outputs->m_printInfos.end(); ++it) {
+        for (auto item_it = (*it)->m_PrintItems.begin(); item_it != (*it)->m_PrintItems.end(); ++item_it) {
+            if ((*item_it)->m_nLayers >= 1 && (*item_it)->Corename == corename) { return *item_it; }
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Gather the raster data of one output item of all subbasins into the subsets of
+ *        the combined raster on master rank, collective over MPI_COMM_WORLD.
+ *
+ *        The valid cells of each subbasin are in the same order as the corresponding subset
+ *        of the combined raster, thus the gathered values are set to the subset directly.
+ * \param[in] corename Core name of the output item
+ * \param[in] rank_subbsn_ids Subbasin IDs of current rank
+ * \param[in] data_center_map Data centers of subbasins of current rank
+ * \param[in] rank Rank number
+ * \param[in] size Number of all ranks
+ * \param[in] cache Cached results of the replayed subbasins, nullptr if not used
+ * \param[in,out] subset Subsets of the combined raster, only used by master rank
+ */
+void GatherRasterItem(const string& corename, vector<int>& rank_subbsn_ids,
+                      map<int, DataCenterMongoDB *>& data_center_map,
+                      const int rank, const int size, SubbasinResultCache* cache,
+                      map<int, SubsetPositions*>* subset) {
+    /// 1. Pack subbasin ID, cells number, layers number, and values of the subbasins of current rank
+    vector<int> headers;
+    vector<float> values;
+    for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+        int n_cells = 0;
+        int n_lyrs = 0;
+        if (nullptr != cache && cache->IsReplayed(*it_id)) {
+            const float* data = cache->GetRasterData(*it_id, corename, &n_cells, &n_lyrs);
+            if (nullptr != data) { values.insert(values.end(), data, data + CVT_SIZET(n_cells) * n_lyrs); }
+            headers.push_back(*it_id);
+            headers.push_back(n_cells);
+            headers.push_back(n_lyrs);
+            continue;
+        }
+        PrintInfoItem* item = FindRasterItem(data_center_map.at(*it_id)->GetSettingOutput(), corename);
+        if (nullptr != item && nullptr != item->m_1DData && item->m_nLayers == 1) {
+            n_cells = item->m_nRows;
+            n_lyrs = 1;
+            values.insert(values.end(), item->m_1DData, item->m_1DData + n_cells);
+        } else if (nullptr != item && nullptr != item->m_2DData) {
+            n_cells = item->m_nRows;
+            n_lyrs = item->m_nLayers;
+            for (int i = 0; i < n_cells; i++) {
+                values.insert(values.end(), item->m_2DData[i], item->m_2DData[i] + n_lyrs);
+            }
+        }
+        headers.push_back(*it_id);
+        headers.push_back(n_cells);
+        headers.push_back(n_lyrs);
+    }
+    /// 2. Gather to master rank
+    int n_header = CVT_INT(headers.size());
+    int n_value = CVT_INT(values.size());
+    vector<int> header_counts(size, 0);
+    vector<int> value_counts(size, 0);
+    MPI_Gather(&n_header, 1, MPI_INT, &header_counts[0], 1, MPI_INT, MASTER_RANK, MCW);
+    MPI_Gather(&n_value, 1, MPI_INT, &value_counts[0], 1, MPI_INT, MASTER_RANK, MCW);
+    vector<int> header_displs(size, 0);
+    vector<int> value_displs(size, 0);
+    vector<int> all_headers;
+    vector<float> all_values;
+    if (rank == MASTER_RANK) {
+        for (int i = 1; i < size; i++) {
+            header_displs[i] = header_displs[i - 1] + header_counts[i - 1];
+            value_displs[i] = value_displs[i - 1] + value_counts[i - 1];
+        }
+        all_headers.resize(header_displs[size - 1] + header_counts[size - 1]);
+        all_values.resize(value_displs[size - 1] + value_counts[size - 1]);
+    }
+    MPI_Gatherv(headers.empty() ? nullptr : &headers[0], n_header, MPI_INT,
+                all_headers.empty() ? nullptr : &all_headers[0], &header_counts[0], &header_displs[0],
+                MPI_INT, MASTER_RANK, MCW);
+    MPI_Gatherv(values.empty() ? nullptr : &values[0], n_value, MPI_FLOAT,
+                all_values.empty() ? nullptr : &all_values[0], &value_counts[0], &value_displs[0],
+                MPI_FLOAT, MASTER_RANK, MCW);
+    if (rank != MASTER_RANK) { return; }
+    /// 3. Set to the subsets of the combined raster
+    for (auto it_sub = subset->begin(); it_sub != subset->end(); ++it_sub) {
+        it_sub->second->usable = false;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i + 2 < all_headers.size(); i += 3) {
+        int subbasin_id = all_headers[i];
+        int n_cells = all_headers[i + 1];
+        int n_lyrs = all_headers[i + 2];
+        if (n_cells <= 0) { continue; }
+        float* data = &all_values[offset];
+        offset += CVT_SIZET(n_cells) * n_lyrs;
+        auto it_sub = subset->find(subbasin_id);
+        if (it_sub == subset->end() || it_sub->second->n_cells != n_cells) {
+            CLOG(WARNING, LOG_OUTPUT) << "\t\tRaster data of subbasin " << subbasin_id
+                    << " mismatch the mask layer, skipped!";
+            continue;
+        }
+        SubsetPositions* sub = it_sub->second;
+        if (n_lyrs == 1) {
+            sub->usable = sub->SetData(n_cells, data);
+            continue;
+        }
+        // Layers number may be different from the previous output item
+        if (sub->n_lyrs != n_lyrs) { Release2DArray(sub->data2d_); }
+        vector<float*> rows(n_cells);
+        for (int j = 0; j < n_cells; j++) { rows[j] = data + CVT_SIZET(j) * n_lyrs; }
+        sub->usable = sub->Set2DData(n_cells, n_lyrs, &rows[0]);
+    }
+}
+
+/*!
+ * \brief Combine the raster outputs of all subbasins to the whole watershed in memory,
+ *        and save to MongoDB and GeoTIFF files by master rank, collective over MPI_COMM_WORLD.
+ *
+ *        Previous implementation reads back the raster data of each subbasin from GridFS by master rank,
+ *        see `seims/src/combine_raster/CombineRaster.cpp` and the input argument `-outsub`.
+ *
+ *        The raster outputs of the subbasins replayed by incremental simulation are read from cache.
+ */
+void CombineRasterOutputs(InputArgs* input_args, const int rank, const int size,
+                          vector<int>& rank_subbsn_ids, map<int, DataCenterMongoDB *>& data_center_map,
+                          SubbasinResultCache* cache,
+                          MongoGridFs* spatial_gfs_in, MongoGridFs* spatial_gfs_out) {
+    FloatRaster* subbsn_lyr = nullptr;
+    /// 1. Master rank loads the mask layer and broadcasts core names of raster outputs
+    string corenames;
+    if (rank == MASTER_RANK) {
+        CLOG(TRACE, LOG_OUTPUT) << "Combining raster data to GeoTIFF file(s)...";
+        map<string, string> mask_opts;
+        UpdateStringMap(mask_opts, HEADER_INC_NODATA, "TRUE");
+        CLOG(TRACE, LOG_OUTPUT) << "\tLoad 0_SUBBASIN with NoData value as mask layer...";
+        subbsn_lyr = FloatRaster::Init(spatial_gfs_in, "0_SUBBASIN", true, nullptr, true,
+                                       NODATA_VALUE, mask_opts);
+        if (nullptr == subbsn_lyr) {
+            CLOG(TRACE, LOG_OUTPUT) << "\t\tFAILED!";
+        } else {
+            subbsn_lyr->BuildSubSet();
+            int first_id = data_center_map.begin()->first;
+            if (nullptr != cache && cache->IsReplayed(first_id)) {
+                // Core names of the output items are appended by aggregation type after flushed
+                vector<string> cached_names;
+                cache->GetRasterNames(first_id, cached_names);
+                for (auto it = cached_names.begin(); it != cached_names.end(); ++it) {
+                    corenames += *it + "\n";
+                }
+            } else {
+                SettingsOutput* outputs = data_center_map.begin()->second->GetSettingOutput();
+                for (auto it = outputs->m_printInfos.begin(); it != outputs->m_printInfos.end(); ++it) {
+                    for (auto item_it = (*it)->m_PrintItems.begin(); item_it != (*it)->m_PrintItems.end(); ++item_it) {
+                        // Only need to handle raster data
+                        if ((*item_it)->m_nLayers < 1) { continue; }
+                        corenames += (*item_it)->Corename + "\n";
+                    }
+                }
+            }
+        }
+    }
+    int names_len = CVT_INT(corenames.size());
+    MPI_Bcast(&names_len, 1, MPI_INT, MASTER_RANK, MCW);
+    if (names_len == 0) {
+        delete subbsn_lyr;
+        return;
+    }
+    vector<char> names_buf(corenames.begin(), corenames.end());
+    names_buf.resize(names_len);
+    MPI_Bcast(&names_buf[0], names_len, MPI_CHAR, MASTER_RANK, MCW);
+    vector<string> items = SplitString(string(names_buf.begin(), names_buf.end()), '\n');
+
+    map<string, string> valid_opts;
+    UpdateStringMap(valid_opts, HEADER_INC_NODATA, "FALSE");
+    UpdateStringMap(valid_opts, HEADER_RSOUT_DATATYPE, "FLOAT");
+    string sce_str = itoa(input_args->scenario_id);
+    string cali_str = itoa(input_args->calibration_id);
+    /// 2. Gather and save each raster output
+    for (auto it = items.begin(); it != items.end(); ++it) {
+        GatherRasterItem(*it, rank_subbsn_ids, data_center_map, rank, size, cache,
+                         rank == MASTER_RANK ? &subbsn_lyr->GetSubset() : nullptr);
+        if (rank != MASTER_RANK) { continue; }
+        // Concatenate real filename
+        string real_name = *it + "_";
+        if (input_args->scenario_id >= 0) { real_name += sce_str; }
+        real_name += "_";
+        if (input_args->calibration_id >= 0) { real_name += cali_str; }
+        CLOG(TRACE, LOG_OUTPUT) << "\tCombining raster: " << *it << " -> " << real_name << "...";
+        string out_fname = "0_" + real_name;
+        spatial_gfs_out->RemoveFile(out_fname, nullptr, valid_opts);
+        bool save = subbsn_lyr->OutputToMongoDB(spatial_gfs_out, out_fname,
+                                                valid_opts, false, false);
+        if (save) { CLOG(TRACE, LOG_OUTPUT) << "\t\tSUCCEED To MongoDB!"; }
+        string outpath = data_center_map.begin()->second->GetOutputScenePath();
+        if (!outpath.empty()) {
+            // Output as gtiff file will not contain ScenarioID and CalibrationID information
+            save = subbsn_lyr->OutputToFile(outpath + SEP + *it + "." + GTiffExtension, false);
+            if (save) { CLOG(TRACE, LOG_OUTPUT) << "\t\tSUCCEED To GTiff!"; }
+        }
+    }
+    delete subbsn_lyr;
+}
+
+//! Is any BMP of the scenario located in the subbasin of the data center
+bool IsAffectedByScenario(DataCenterMongoDB* data_center) {
+    Scenario* scenario = data_center->GetScenarioData();
+    return nullptr != scenario && scenario->IsLocatedInSubbasin();
+}
+
+/*!
+ * \brief Determine the subbasins to be replayed from the cached results of the baseline run,
+ *        collective over MPI_COMM_WORLD.
+ *
+ *        A subbasin is simulated if it is affected by the BMPs scenario of either current or the
+ *        baseline run, or its cache is unavailable. All downstream subbasins of the simulated ones
+ *        and the outlet subbasin are simulated too. The others are replayed.
+ * \return Number of simulated subbasins of the whole watershed
+ */
+int SetReplayedSubbasins(InputArgs* input_args, SubbasinResultCache* cache, vector<int>& rank_subbsn_ids,
+                         map<int, DataCenterMongoDB *>& data_center_map, map<int, int>& downstream) {
+    int n_flags = downstream.rbegin()->first + 1;
+    vector<int> rank_flags(n_flags, 0);
+    for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+        if (!cache->Load(*it_id, input_args->calibration_id) || cache->IsBaselineAffected(*it_id) ||
+            IsAffectedByScenario(data_center_map.at(*it_id))) {
+            rank_flags[*it_id] = 1;
+        }
+    }
+    vector<int> flags(n_flags, 0);
+    MPI_Allreduce(&rank_flags[0], &flags[0], n_flags, MPI_INT, MPI_MAX, MCW);
+    for (auto it = downstream.begin(); it != downstream.end(); ++it) {
+        if (it->second <= 0) { flags[it->first] = 1; }
+        if (flags[it->first] == 0) { continue; }
+        for (int down_id = it->second; down_id > 0; down_id = downstream.at(down_id)) {
+            flags[down_id] = 1;
+        }
+    }
+    for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+        if (flags[*it_id] == 0) { cache->SetReplayed(*it_id); }
+    }
+    int n_simulated = 0;
+    for (auto it = downstream.begin(); it != downstream.end(); ++it) {
+        n_simulated += flags[it->first];
+    }
+    return n_simulated;
+}
+} /* namespace */
+
 void CalculateProcess(InputArgs* input_args, const int rank, const int size,
                       mongoc_client_pool_t* mongo_pool /* = nullptr */) {
     LOG(TRACE) << "Computing process, Rank: " << rank;
@@ -88,6 +676,12 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
     /// TODO, when transfer_count differs among module_factorys, we need to find out a way to transfer data correctly.
     int transfer_count = default_module_factory->GetTransferredInputsCount();
 
+    /// Load static inputs once per computing node into shared memory, i.e., HydroClimate data
+    NodeSharedInputs* node_shared = new NodeSharedInputs();
+    node_shared->Load(mongo_client, input_args);
+    /// Query results shared by the data centers of current rank, e.g., parameters and lookup tables
+    DataCenterCache* rank_cache = new DataCenterCache();
+
     /// Create lists of data center objects and SEIMS model objects
     map<int, DataCenterMongoDB *> data_center_map;
     map<int, ModelMain *> model_map;
@@ -118,7 +712,8 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
         }
         /// Create data center according to subbasin number
         DataCenterMongoDB* data_center = new DataCenterMongoDB(input_args, mongo_client, spatial_gfs_in, spatial_gfs_out,
-                                                               tmp_module_factory, *it_id);
+                                                               tmp_module_factory, *it_id,
+                                                               node_shared->GetClimateData(), rank_cache);
         /// Create SEIMS model by dataCenter and moduleFactory
         ModelMain* model = new ModelMain(data_center, tmp_module_factory);
 #ifdef HAS_VARIADIC_TEMPLATES
@@ -129,6 +724,8 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
         model_map.insert(make_pair(*it_id, model));
 #endif
     }
+    CLOG(TRACE, LOG_INIT) << "Rank " << rank << " reused cached query results " << rank_cache->GetHitCount()
+    << " times for " << rank_subbsn_ids.size() << " subbasins.";
     /// Specific handling code, which maybe improved in the future version.
     ///   S1: SetSlopeCoefofBasin(), the algorithm is coincident with `clsSubbasins::Subbasin2Basin()`.
     int unit_count = 0;
@@ -170,10 +767,42 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
     map<int, vector<int> >& upstreams = task_info->GetUpstreamIDs();
     map<int, vector<int> >& subbsn_layers = task_info->GetLayerSubbasinIDs();
 
-    /// Create buffer for passing values across subbasins
-    float* buf = nullptr;
-    int buflen = MSG_LEN + transfer_count;
-    Initialize1DArray(buflen, buf, NODATA_VALUE);
+    /// Threads to step the same-layer subbasins of current rank concurrently,
+    ///   MPI calls are only made by the master thread out of the concurrent region (MPI_THREAD_FUNNELED).
+    int max_subbsn_threads = 1;
+#ifdef SUPPORT_OMP
+    if (input_args->thread_num > 1) {
+        max_subbsn_threads = input_args->thread_num;
+        // Enable the module-level parallel regions nested in the concurrent subbasins
+#if defined(_OPENMP) && _OPENMP >= 200805
+        omp_set_max_active_levels(2);
+#else
+        omp_set_nested(1);
+#endif
+    }
+#endif /* SUPPORT_OMP */
+
+    /// Aggregated messages of transferred values across ranks
+    TransferExchange* exchange = new TransferExchange(rank, transfer_count, task_info);
+
+    /// Cached results of subbasins, which are saved as the baseline or replayed by incremental simulation
+    SubbasinResultCache* result_cache = nullptr;
+    if (!input_args->cache_path.empty()) {
+        result_cache = new SubbasinResultCache(input_args->cache_path, transfer_count,
+                                               start_time, end_time, dt_ch);
+        if (input_args->incremental) {
+            int n_simulated = SetReplayedSubbasins(input_args, result_cache, rank_subbsn_ids,
+                                                   data_center_map, downstream);
+            if (rank == MASTER_RANK) {
+                LOG(INFO) << "Incremental simulation: " << n_simulated << " of " << downstream.size()
+                        << " subbasins are simulated, the others are replayed from " << input_args->cache_path;
+            }
+        } else {
+            for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+                result_cache->CreateEntry(*it_id, IsAffectedByScenario(data_center_map.at(*it_id)));
+            }
+        }
+    }
 
     /// Initialize the transferred values of subbasins in current process and received from other processes
     ///   NO NEED to create and release in each timestep.
@@ -189,7 +818,14 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
     /// Transferred values of subbasins in current rank with timestep stamp
     map<int, map<int, float *> >& ts_subbsn_tf_values = task_info->GetSubbasinTransferredValues();
     /// Record the actual simulation loop number of each subbasin
+    ///   all subbasins are inserted here to avoid modifying the map by concurrent threads
     map<int, int> ts_subbsn_loop;
+    /// Record the computing time of each subbasin, which is the weight of partitioning for the next run
+    map<int, double> subbsn_cost;
+    for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+        ts_subbsn_loop[*it_id] = 0;
+        subbsn_cost[*it_id] = 0.;
+    }
     /// Received transferred values of subbasins in current rank with timestep stamp
     map<int, map<int, float *> >& recv_ts_subbsn_tf_values = task_info->GetReceivedSubbasinTransferredValues();
 
@@ -197,16 +833,40 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
     double t_model_construct = MPI_Wtime() - tstart;
     LOG(TRACE) << "Rank " << rank << " construct models done!";
 
-    MPI_Request request;
-    MPI_Status status;
-
     // Simulation loop
     double t_slope = 0.;         ///< Time of hillslope processes
     double t_channel = 0.;       ///< Time of channel routing processes
     double t_barrier = 0.;       ///< Time of MPI barrier
-    double t_slope_start = 0.;   ///< Temporary variables to counting time of hillslope processes
-    double t_channel_start = 0.; ///< Temporary variables to counting time of channel processes
     double t_barrier_start = 0.; ///< Temporary variables to counting time of MPI barrier
+    /// Timeline trace names of steps and MPI waits, only recorded if tracing is enabled
+    int trace_slope = Tracer::RegisterName("HillSlope");
+    int trace_channel = Tracer::RegisterName("Channel");
+    int trace_recv = Tracer::RegisterName("MPI_Wait(Irecv)");
+    int trace_send = Tracer::RegisterName("MPI_Wait(Isend)");
+    int trace_barrier = Tracer::RegisterName("MPI_Barrier");
+    int trace_output = Tracer::RegisterName("Output");
+    int trace_combine = Tracer::RegisterName("CombineRaster");
+    double trace_t = 0.;
+
+    LayerStepContext step_ctx;
+    step_ctx.rank = rank;
+    step_ctx.n_hs = n_hs;
+    step_ctx.dt_hs = dt_hs;
+    step_ctx.include_channel = include_channel;
+    step_ctx.model_map = &model_map;
+    step_ctx.subbasin_rank = &subbasin_rank;
+    step_ctx.downstream = &downstream;
+    step_ctx.upstreams = &upstreams;
+    step_ctx.subbasin_layer = &task_info->GetSubbasinLayer();
+    step_ctx.priority = &task_info->GetSubbasinPriority();
+    step_ctx.tf_values = &ts_subbsn_tf_values;
+    step_ctx.recv_tf_values = &recv_ts_subbsn_tf_values;
+    step_ctx.subbsn_loop = &ts_subbsn_loop;
+    step_ctx.subbsn_cost = &subbsn_cost;
+    step_ctx.exchange = exchange;
+    step_ctx.cache = result_cache;
+    step_ctx.trace_slope = trace_slope;
+    step_ctx.trace_channel = trace_channel;
 
     int sim_loop_num = 0; /// Simulation loop number, which will be ciculated at 1 ~ max_lyr_id_all
     int act_loop_num = 0; /// Actual simulation loop number, which will be 1 ~ N
@@ -214,110 +874,225 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
     int max_loop_num = max_lyr_id_all * multiplier;
     tstart = MPI_Wtime(); /// Start simulation
     int pre_year_idx = -1;
-    for (time_t ts = start_time; ts <= end_time; ts += dt_ch) {
-        sim_loop_num += 1;
-        act_loop_num += 1;
-        int year_idx = GetYear(ts) - start_year;
+    /// Subbasins without channel processes and transferred values are independent of each other,
+    ///   thus each of them runs its entire time loop without the per-step synchronization among ranks.
+    ///   The detection by module metadata can be overridden by the input argument, i.e., `-indep`.
+    int independent = input_args->independent == INDEPENDENT_OFF ? 0 : 1;
+    for (auto it = model_map.begin(); independent > 0 && it != model_map.end(); ++it) {
+        if (input_args->independent == INDEPENDENT_ON) {
+            if (it->second->IncludeChannelProcesses()) {
+                LOG(WARNING) << "Subbasin " << it->first << " includes channel processes, "
+                        "which cannot be simulated independently.";
+                independent = 0;
+            }
+        } else if (!it->second->IsSubbasinIndependent()) {
+            independent = 0;
+        }
+    }
+    int independent_all = 0;
+    MPI_Allreduce(&independent, &independent_all, 1, MPI_INT, MPI_MIN, MCW);
+    /// The subbasins of each time step are executed once ready by the critical-path priorities,
+    ///   instead of layer by layer, which is not applicable to the TEMPOROSPATIAL scheduling method.
+    bool ready_driven = input_args->task_order == CRITICAL_PATH && include_channel;
+    if (ready_driven && input_args->skd_mtd != SPATIAL) {
         if (rank == MASTER_RANK) {
-            if (pre_year_idx != year_idx) {
-                LOG(DEBUG) << "  Simulation year: " << start_year + year_idx;
+            LOG(WARNING) << "The ready-driven execution of subbasins requires the SPATIAL scheduling method, "
+                    "the subbasins are executed layer by layer by the critical-path priorities instead.";
+        }
+        ready_driven = false;
+    }
+    ReadyQueue ready_queue;
+    if (independent_all > 0) {
+        if (rank == MASTER_RANK) {
+            LOG(INFO) << "Each subbasin is simulated through the entire period independently.";
+        }
+        int n_rank_subbsns = CVT_INT(rank_subbsn_ids.size());
+        int n_outer = Min(max_subbsn_threads, n_rank_subbsns);
+        if (n_outer <= 1) {
+            for (int i = 0; i < n_rank_subbsns; i++) {
+                StepSubbasinPeriod(step_ctx, rank_subbsn_ids[i], start_time, end_time, dt_ch,
+                                   start_year, t_slope);
             }
-            LOG(DEBUG) << ConvertToString2(ts);
+        } else {
+#ifdef SUPPORT_OMP
+            int n_inner = Max(1, input_args->thread_num / n_outer);
+            string step_error;
+#pragma omp parallel for num_threads(n_outer) schedule(dynamic, 1) reduction(+:t_slope)
+            for (int i = 0; i < n_rank_subbsns; i++) {
+                SetOpenMPThread(n_inner);
+                try {
+                    StepSubbasinPeriod(step_ctx, rank_subbsn_ids[i], start_time, end_time, dt_ch,
+                                       start_year, t_slope);
+                } catch (std::exception& e) {
+#pragma omp critical(SEIMS_MPI_STEP_ERROR)
+                    step_error = e.what();
+                }
+            }
+            if (!step_error.empty()) {
+                throw ModelException("CalculateProcess", "StepSubbasinPeriod", step_error);
+            }
+#endif /* SUPPORT_OMP */
         }
-        // Execute by layering orders
-        for (int ilyr = 1; ilyr <= max_lyr_id_all; ilyr++) {
-            // if (subbsn_layers.find(ilyr) == subbsn_layers.end()) continue; // DO NOT UNCOMMENT THIS!
-
-            if (input_args->skd_mtd == TEMPOROSPATIAL) exec_lyr_num = ilyr;
-
-            for (int lyr_dlt = 0; lyr_dlt < exec_lyr_num; lyr_dlt++) {
-                if (ts + dt_ch * lyr_dlt > end_time) break;
-                int cur_ilyr = ilyr - lyr_dlt;
-                int cur_sim_loop_num = sim_loop_num + lyr_dlt;
-                // When cur_sim_loop_num exceeds max_lyr_id_all, recount it!
-                if (cur_sim_loop_num > max_loop_num) cur_sim_loop_num %= max_loop_num;
-                for (auto it = subbsn_layers[cur_ilyr].begin(); it != subbsn_layers[cur_ilyr].end(); ++it) {
-                    int subbasin_id = *it;
-                    time_t cur_time = ts + lyr_dlt * dt_ch;
-                    // If subbasin_id of the actual loop already executed, continue.
-                    if (ts_subbsn_loop[subbasin_id] >= act_loop_num + lyr_dlt) {
-                        continue;
-                    }
-                    // 1. Execute hillslope processes
-                    t_slope_start = MPI_Wtime();
-                    ModelMain* psubbasin = model_map[*it];
-                    for (int i = 0; i < n_hs; i++) {
-                        psubbasin->StepHillSlope(cur_time + i * dt_hs, year_idx, i);
+    } else {
+        for (time_t ts = start_time; ts <= end_time; ts += dt_ch) {
+            sim_loop_num += 1;
+            act_loop_num += 1;
+            int year_idx = GetYear(ts) - start_year;
+            if (rank == MASTER_RANK) {
+                if (pre_year_idx != year_idx) {
+                    SLOG(DEBUG) << "  Simulation year: " << start_year + year_idx;
+                }
+                SLOG(DEBUG) << ConvertToString2(ts);
+            }
+            if (ready_driven) {
+                double t_exchange_start = MPI_Wtime();
+                trace_t = Tracer::Now();
+                exchange->StartStep(sim_loop_num);
+                if (Tracer::Enabled()) {
+                    Tracer::Record(TRACE_MPI_WAIT, trace_send, trace_t, Tracer::Now(), ts, 0);
+                }
+                t_channel += MPI_Wtime() - t_exchange_start;
+                InitReadyQueue(step_ctx, rank_subbsn_ids, &recv_ts_subbsn_tf_values[sim_loop_num], ready_queue);
+                int n_outer = Min(max_subbsn_threads, CVT_INT(rank_subbsn_ids.size()));
+                if (n_outer <= 1) {
+                    StepReadySubbasins(step_ctx, ready_queue, ts, year_idx, sim_loop_num, act_loop_num,
+                                       t_slope, t_channel);
+                } else {
+#ifdef SUPPORT_OMP
+                    // Note that t_slope and t_channel become the sums of all threads' time.
+                    int n_inner = Max(1, input_args->thread_num / n_outer);
+#pragma omp parallel num_threads(n_outer) reduction(+:t_slope, t_channel)
+                    {
+                        SetOpenMPThread(n_inner);
+                        StepReadySubbasins(step_ctx, ready_queue, ts, year_idx, sim_loop_num, act_loop_num,
+                                           t_slope, t_channel);
                     }
-                    t_slope += MPI_Wtime() - t_slope_start;
-                    if (!include_channel) continue;
+#endif /* SUPPORT_OMP */
+                }
+                if (!ready_queue.error.empty()) {
+                    throw ModelException("CalculateProcess", "StepReadySubbasins", ready_queue.error);
+                }
+                // The messages filled by the last subbasins
+                exchange->SendFilled(sim_loop_num);
+            } else {
+                // Execute by layering orders
+                for (int ilyr = 1; ilyr <= max_lyr_id_all; ilyr++) {
+                    // if (subbsn_layers.find(ilyr) == subbsn_layers.end()) continue; // DO NOT UNCOMMENT THIS!
 
-                    // 2. Execute channel processes
-                    t_channel_start = MPI_Wtime();
+                    if (input_args->skd_mtd == TEMPOROSPATIAL) exec_lyr_num = ilyr;
 
-                    // 2.1 Set transferred data from upstreams
-                    for (auto it_upid = upstreams[subbasin_id].begin();
-                         it_upid != upstreams[subbasin_id].end(); ++it_upid) {
-                        if (subbasin_rank[*it_upid] == rank) {
-                            psubbasin->SetTransferredValue(*it_upid, ts_subbsn_tf_values[cur_sim_loop_num][*it_upid]);
+                    for (int lyr_dlt = 0; lyr_dlt < exec_lyr_num; lyr_dlt++) {
+                        if (ts + dt_ch * lyr_dlt > end_time) break;
+                        int cur_ilyr = ilyr - lyr_dlt;
+                        int cur_sim_loop_num = sim_loop_num + lyr_dlt;
+                        // When cur_sim_loop_num exceeds max_lyr_id_all, recount it!
+                        if (cur_sim_loop_num > max_loop_num) cur_sim_loop_num %= max_loop_num;
+                        time_t cur_time = ts + lyr_dlt * dt_ch;
+                        // Subbasins of current layer that have not been executed in the actual loop
+                        vector<int> lyr_subbsn_ids;
+                        for (auto it = subbsn_layers[cur_ilyr].begin(); it != subbsn_layers[cur_ilyr].end(); ++it) {
+                            if (ts_subbsn_loop[*it] >= act_loop_num + lyr_dlt) { continue; }
+                            lyr_subbsn_ids.push_back(*it);
+                        }
+                        int n_lyr_subbsns = CVT_INT(lyr_subbsn_ids.size());
+                        if (n_lyr_subbsns == 0) { continue; }
+                        if (include_channel) {
+                            // Slots of the messages of current layer are reused after the previous sends completed,
+                            //   and the messages from other ranks required by current layer are received.
+                            double t_exchange_start = MPI_Wtime();
+                            trace_t = Tracer::Now();
+                            exchange->WaitSends(cur_ilyr);
+                            if (Tracer::Enabled()) {
+                                Tracer::Record(TRACE_MPI_WAIT, trace_send, trace_t, Tracer::Now(), cur_time, 0, cur_ilyr);
+                            }
+                            trace_t = Tracer::Now();
+                            exchange->Receive(cur_ilyr, cur_sim_loop_num, recv_ts_subbsn_tf_values[cur_sim_loop_num]);
+                            if (Tracer::Enabled()) {
+                                Tracer::Record(TRACE_MPI_WAIT, trace_recv, trace_t, Tracer::Now(), cur_time, 0, cur_ilyr);
+                            }
+                            t_channel += MPI_Wtime() - t_exchange_start;
+                        }
+                        int n_outer = Min(max_subbsn_threads, n_lyr_subbsns);
+                        if (n_outer <= 1) {
+                            for (int i = 0; i < n_lyr_subbsns; i++) {
+                                StepSubbasin(step_ctx, lyr_subbsn_ids[i], cur_time, year_idx, cur_ilyr,
+                                             cur_sim_loop_num, act_loop_num + lyr_dlt, t_slope, t_channel);
+                            }
                         } else {
-                            // receive data from the specific rank according to work_tag
-                            int work_tag = *it_upid * 10000 + cur_sim_loop_num;
-                            MPI_Irecv(buf, buflen, MPI_FLOAT, subbasin_rank[*it_upid], work_tag, MCW, &request);
-                            MPI_Wait(&request, &status);
-
-                            for (int vi = 0; vi < transfer_count; vi++) {
-                                recv_ts_subbsn_tf_values[cur_sim_loop_num][*it_upid][vi] = buf[MSG_LEN + vi];
+    #ifdef SUPPORT_OMP
+                            // Same-layer subbasins are stepped concurrently, the remaining threads are shared
+                            //   by the module-level parallel regions nested in each subbasin.
+                            //   Subbasins are dispatched in the order of layer, i.e., the most costly ones are
+                            //   started first if the priorities are available, which shortens the layer barrier.
+                            //   Note that t_slope and t_channel become the sums of all threads' time.
+                            int n_inner = Max(1, input_args->thread_num / n_outer);
+                            string step_error;
+    #pragma omp parallel for num_threads(n_outer) schedule(dynamic, 1) reduction(+:t_slope, t_channel)
+                            for (int i = 0; i < n_lyr_subbsns; i++) {
+                                SetOpenMPThread(n_inner);
+                                try {
+                                    StepSubbasin(step_ctx, lyr_subbsn_ids[i], cur_time, year_idx, cur_ilyr,
+                                                 cur_sim_loop_num, act_loop_num + lyr_dlt, t_slope, t_channel);
+                                } catch (std::exception& e) {
+    #pragma omp critical(SEIMS_MPI_STEP_ERROR)
+                                    step_error = e.what();
+                                }
+                            }
+                            if (!step_error.empty()) {
+                                throw ModelException("CalculateProcess", "StepSubbasin", step_error);
                             }
-                            psubbasin->SetTransferredValue(*it_upid,
-                                                           recv_ts_subbsn_tf_values[cur_sim_loop_num][*it_upid]);
+    #endif /* SUPPORT_OMP */
                         }
-                    }
-                    psubbasin->StepChannel(cur_time, year_idx);
-                    psubbasin->AppendOutputData(cur_time);
-                    ts_subbsn_loop[subbasin_id] = act_loop_num + lyr_dlt;
-
-                    // 2.2 If the downstream subbasin is in this process,
-                    //     there is no need to transfer values to the master process
-                    int downstream_id = downstream[subbasin_id];
-                    if (downstream_id > 0 && subbasin_rank[downstream_id] == rank) {
-                        psubbasin->GetTransferredValue(ts_subbsn_tf_values[cur_sim_loop_num][subbasin_id]);
-                        t_channel += MPI_Wtime() - t_channel_start;
-                        continue;
-                    }
-                    if (downstream_id < 0) {
-                        // There is no need to get transferred values
-                        t_channel += MPI_Wtime() - t_channel_start;
-                        continue;
-                    }
-                    // 2.3 Otherwise, the transferred values of current subbasin should be sent to another rank
-                    psubbasin->GetTransferredValue(&buf[MSG_LEN]);
-
-                    int dest_rank = subbasin_rank[downstream[subbasin_id]];
-                    buf[0] = CVT_FLT(subbasin_id);      // subbasin ID
-                    buf[1] = CVT_FLT(cur_sim_loop_num); // simulation loop number
-                    int work_tag = subbasin_id * 10000 + cur_sim_loop_num;
-                    MPI_Isend(buf, buflen, MPI_FLOAT, dest_rank, work_tag, MCW, &request);
-                    MPI_Wait(&request, &status);
-                    t_channel += MPI_Wtime() - t_channel_start;
-                } /* subbsn_layers[cur_ilyr] loop */
-            }     /* loop of lyr_dlt = 0 to exec_lyr_num */
-        }         /* If subbsn_layers has ilyr */
-
-        if (sim_loop_num % max_loop_num == 0) {
-            sim_loop_num = 0;
-            t_barrier_start = MPI_Wtime();
-            MPI_Barrier(MCW);
-            t_barrier += MPI_Wtime() - t_barrier_start;
-        }
-        pre_year_idx = year_idx;
-    } /* timestep loop */
+                        // All transferred values of current layer to the same rank are sent by one message
+                        if (include_channel) { exchange->Send(cur_ilyr, cur_sim_loop_num); }
+                    }     /* loop of lyr_dlt = 0 to exec_lyr_num */
+                }         /* If subbsn_layers has ilyr */
+            }
+
+            if (sim_loop_num % max_loop_num == 0) {
+                sim_loop_num = 0;
+                t_barrier_start = MPI_Wtime();
+                trace_t = Tracer::Now();
+                MPI_Barrier(MCW);
+                t_barrier += MPI_Wtime() - t_barrier_start;
+                if (Tracer::Enabled()) {
+                    Tracer::Record(TRACE_MPI_WAIT, trace_barrier, trace_t, Tracer::Now(), ts, 0);
+                }
+            }
+            pre_year_idx = year_idx;
+        } /* timestep loop */
+    }
+    delete exchange; // Wait all pending sends
     double t_comp = MPI_Wtime() - tstart;
 
     /***************  Outputs ***************/
     tstart = MPI_Wtime();
     for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
-        model_map[*it_id]->Output();
+        // Raster outputs of the replayed subbasins are read from cache, and others are not available
+        if (nullptr != result_cache && result_cache->IsReplayed(*it_id)) { continue; }
+        TraceSpan output_span(TRACE_IO, trace_output, end_time, *it_id);
+        model_map[*it_id]->Output(input_args->out_subbasin_gfs);
+    }
+    /// Combine raster outputs of all subbasins in memory, which is included in the time of outputs
+    {
+        TraceSpan combine_span(TRACE_IO, trace_combine, end_time, 0);
+        CombineRasterOutputs(input_args, rank, size, rank_subbsn_ids, data_center_map, result_cache,
+                             spatial_gfs_in, spatial_gfs_out);
+    }
+    /// Save results of subbasins as the baseline of incremental simulation
+    if (nullptr != result_cache && !input_args->incremental) {
+        for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+            if (!result_cache->Save(*it_id, input_args->scenario_id, input_args->calibration_id,
+                                    data_center_map.at(*it_id)->GetSettingOutput())) {
+                LOG(WARNING) << "Rank: " << rank << ", save cached results of subbasin " << *it_id << " failed!";
+            }
+        }
+    }
+    delete result_cache;
+    /// Save computing costs of subbasins in the output folder, which can be specified by `-costs` of later runs,
+    ///   except the incremental simulation in which some are replayed
+    if (!input_args->incremental) {
+        SaveSubbasinCosts(input_args, rank, size, subbsn_cost);
     }
     double t_output = MPI_Wtime() - tstart;
 
@@ -412,77 +1187,6 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
         CLOG(INFO, LOG_TIMESPAN) << "[AVG][SIMU][ALL]     " << std::fixed << setprecision(3) << all_tavg;
     }
 
-    /*** Combine raster outputs serially by one processor. ***/
-    /// The operation could be considered as post-process,
-    ///   therefore, the time-consuming is not included.
-    if (rank == MASTER_RANK) {
-        CLOG(TRACE, LOG_OUTPUT) << "Combining raster data to GeoTIFF file(s)...";
-        map<string, string> mask_opts;
-        UpdateStringMap(mask_opts, HEADER_INC_NODATA, "TRUE");
-        map<string, string> valid_opts;
-        UpdateStringMap(valid_opts, HEADER_INC_NODATA, "FALSE");
-        UpdateStringMap(valid_opts, HEADER_RSOUT_DATATYPE, "FLOAT");
-        CLOG(TRACE, LOG_OUTPUT) << "\tLoad 0_SUBBASIN with NoData value as mask layer...";
-        FloatRaster* subbsn_lyr = FloatRaster::Init(spatial_gfs_in, "0_SUBBASIN",
-                                                    true, nullptr, true,
-                                                    NODATA_VALUE, mask_opts);
-        if (nullptr == subbsn_lyr) {
-            CLOG(TRACE, LOG_OUTPUT) << "\t\tFAILED!";
-        }
-        else {
-            subbsn_lyr->BuildSubSet();
-            map<int, SubsetPositions*>& subset = subbsn_lyr->GetSubset();
-
-            SettingsOutput* outputs = data_center_map.begin()->second->GetSettingOutput();
-            for (auto it = outputs->m_printInfos.begin(); it != outputs->m_printInfos.end(); ++it) {
-                for (auto item_it = (*it)->m_PrintItems.begin(); item_it != (*it)->m_PrintItems.end(); ++item_it) {
-                    PrintInfoItem* item = *item_it;
-                    if (item->m_nLayers < 1) { continue; }
-                    // Only need to handle raster data
-                    // Previous implementation in `seims/src/combine_raster/CombineRaster.cpp`
-                    // Change to new API of CCGL by LJ, 2022-07-06
-                    // bool CombineRasterResultsMongo(MongoGridFs* gfs, const string& s_var,
-                    //                                const int n_subbasins, const string& folder /* = "" */,
-                    //                                int scenario_id /* = 0 */, int calibration_id /* = -1 */)
-
-                    // Concatenate real filename
-                    string real_name = item->Corename + "_";
-                    string sce_str = itoa(input_args->scenario_id);
-                    string cali_str = itoa(input_args->calibration_id);
-                    if (input_args->scenario_id >= 0) { real_name += sce_str; }
-                    real_name += "_";
-                    if (input_args->calibration_id >= 0) { real_name += cali_str; }
-                    CLOG(TRACE, LOG_OUTPUT) << "\tCombining raster: " << item->Corename << " -> " << real_name << "...";
-                    bool read_data_flag = true;
-                    map<string, string> opts;
-                    UpdateStringMap(opts, "SCENARIO_ID", sce_str);
-                    UpdateStringMap(opts, "CALIBRATION_ID", cali_str);
-                    UpdateStringMap(opts, HEADER_INC_NODATA, "FALSE");
-                    for (auto it_sub = subset.begin(); it_sub != subset.end(); ++it_sub) {
-                        string cfname = itoa(it_sub->first) + "_" + real_name;
-                        it_sub->second->usable = it_sub->second->ReadFromMongoDB(spatial_gfs_out, cfname, opts);
-                    }
-
-                    string out_fname = "0_" + real_name;
-                    spatial_gfs_out->RemoveFile(out_fname, nullptr, valid_opts);
-                    bool save = subbsn_lyr->OutputToMongoDB(spatial_gfs_out, out_fname,
-                                                            valid_opts, false, false);
-                    if (save) { CLOG(TRACE, LOG_OUTPUT) << "\t\tSUCCEED To MongoDB!"; }
-                    string outpath = data_center_map.begin()->second->GetOutputScenePath();
-                    if (!outpath.empty()) {
-                        // Output as gtiff file will not contain ScenarioID and CalibrationID information
-                        save = subbsn_lyr->OutputToFile(outpath + SEP + item->Corename + "." + GTiffExtension,
-                                                        false);
-                        if (save) { CLOG(TRACE, LOG_OUTPUT) << "\t\tSUCCEED To GTiff!"; }
-                    }
-                }
-            }
-        }
-
-        delete subbsn_lyr;
-    }
-    /*** End of Combine raster outputs. ***/
-
     MPI_Barrier(MCW);
 
     // clean up
@@ -497,6 +1201,8 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
         it->second = nullptr;
     }
     data_center_map.clear();
+    delete node_shared; // after all data centers that reference the shared data are released
+    delete rank_cache;
 
     for (auto it = factory_map.begin(); it != factory_map.end(); ++it) {
         delete it->second;
@@ -519,5 +1225,4 @@ void CalculateProcess(InputArgs* input_args, const int rank, const int size,
         delete mongo_client;
     }
     delete task_info;
-    if (buf != nullptr) { Release1DArray(buf); }
 }
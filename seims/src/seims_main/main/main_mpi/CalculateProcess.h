@@ -4,6 +4,16 @@
  *
  * Changelog:
  *   - 1. 2018-06-12  - lj -  Initial implementation.
+ *   - 2. 2026-10-19  - lj -  Record timeline trace spans of steps, MPI waits, and outputs.
+ *   - 3. 2026-10-19  - lj -  Execute the same-layer subbasins of each rank concurrently by OpenMP threads.
+ *   - 4. 2026-10-19  - lj -  Gather raster outputs of subbasins to master rank in memory instead of via GridFS.
+ *   - 5. 2026-10-19  - lj -  Aggregate transferred values of each layer to the same rank into one message.
+ *   - 6. 2026-10-19  - lj -  Incremental scenario simulation by replaying cached results of unaffected subbasins.
+ *   - 7. 2026-10-19  - lj -  Share parameters, site lists, and lookup tables among data centers of each rank.
+ *   - 8. 2026-10-19  - lj -  Record computing costs of subbasins as the weights of partitioning for the next run.
+ *   - 9. 2026-10-19  - lj -  Simulate each independent subbasin through the entire period without synchronization.
+ *   - 10. 2026-10-19 - lj -  Format the date of each step only if DEBUG logging is enabled.
+ *   - 11. 2026-10-19 - lj -  Execute the subbasins of each time step once ready by the critical-path priorities.
  *
  * \author Liangjun Zhu
  */
@@ -14,6 +24,31 @@
 
 /*!
  * \brief Calculation process
+ *
+ *        If more than one thread is specified (i.e., `-thread`), the same-layer subbasins of current
+ *        rank are executed concurrently, and the remaining threads are used by the nested module-level
+ *        parallel regions of each subbasin.
+ *
+ *        The transferred values of each layer to the same rank are sent by one message after the
+ *        layer is stepped, and the messages required by a layer are received before it is stepped,
+ *        see TransferExchange. Thus, the MPI calls are only made by the master thread.
+ *
+ *        With the critical-path execution order (i.e., `-ord 2`) and SPATIAL scheduling method, the
+ *        subbasins of each time step are executed once the transferred values from their upstreams are
+ *        available instead of layer by layer, and the ready ones with the longest critical paths to the
+ *        outlet are started first. Each message is sent once all of its slots are filled.
+ *
+ *        The raster outputs of all subbasins are gathered to master rank by MPI_Gatherv and combined
+ *        in memory, which is counted in the time of outputs. The raster outputs of each subbasin
+ *        are saved to GridFS only if required (i.e., `-outsub 1`).
+ *
+ *        If a cache folder is specified (i.e., `-cache`), the transferred values and raster outputs of
+ *        each subbasin are saved as the baseline, or, for incremental simulation (i.e., `-incr 1`), the
+ *        subbasins unaffected by the BMPs scenarios and not downstream of any affected one are replayed from
+ *        the cache, see SubbasinResultCache.
+ *
+ *        The data centers of the subbasins of current rank share the query results of initial parameters,
+ *        climate site lists, and lookup tables, see DataCenterCache.
  * \ingroup seims_mpi
  * \param input_args Input arguments
  * \param rank Rank number
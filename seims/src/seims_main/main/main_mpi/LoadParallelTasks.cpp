@@ -1,6 +1,7 @@
 #include "LoadParallelTasks.h"
 
 #include "ReadReachTopology.h"
+#include "PartitionTasks.h"
 #include "parallel.h"
 #include "Logging.h"
 
@@ -13,10 +14,29 @@ int ManagementProcess(MongoClient* mclient, InputArgs* input_args, const int siz
         LOG(TRACE) << "Read and create reaches topology information failed.";
         MPI_Abort(MCW, 1);
     }
+    /// 1.1 Partition subbasins in-process if the groups of current processes number are not prepared,
+    ///     or the computing costs of subbasins measured by a previous run are specified.
+    map<int, double> costs;
+    bool has_costs = false;
+    if (!input_args->costs_file.empty()) {
+        has_costs = ReadSubbasinCosts(input_args->costs_file, costs);
+        if (has_costs) {
+            CLOG(TRACE, LOG_INIT) << "Read computing costs of " << costs.size() << " subbasins from "
+                    << input_args->costs_file;
+        } else {
+            LOG(WARNING) << "No computing costs of subbasins are read from " << input_args->costs_file;
+        }
+    }
+    if (has_costs || group_set.count(-1) > 0 || size_t(size) != group_set.size()) {
+        if (PartitionSubbasins(subbasin_map, input_args->grp_mtd, size, costs, group_set) != 0) {
+            LOG(TRACE) << "Partition subbasins into " << size << " groups failed.";
+            MPI_Abort(MCW, 1);
+        }
+    }
     if (size_t(size) != group_set.size()) {
-        group_set.clear();
         LOG(TRACE) << "The number of slave processes (" << size << ") is not consist with the group number("
         << group_set.size() << ").";
+        group_set.clear();
         MPI_Abort(MCW, 1);
     }
     /// 2. Scatter the group set (i.e., parallel tasks) to all processes
@@ -63,6 +83,20 @@ int ManagementProcess(MongoClient* mclient, InputArgs* input_args, const int siz
     Initialize1DArray(n_task_all, task->down_id, -1);
     Initialize1DArray(n_task_all, task->up_count, 0);
     Initialize1DArray(n_task_all * MAX_UPSTREAM, task->up_ids, -1);
+    /// 2.2 Execution priorities, i.e., estimated costs of subbasins for longest processing time first,
+    ///     or critical-path lengths to the outlet
+    map<int, double> priorities;
+    if (input_args->task_order != LAYER_ORDER) {
+        Initialize1DArray(n_task_all, task->priority, 0.);
+        bool measured = EstimateSubbasinCosts(subbasin_map, costs, priorities);
+        if (input_args->task_order == CRITICAL_PATH) {
+            map<int, double> est_costs(priorities);
+            CriticalPathLengths(subbasin_map, est_costs, priorities);
+        }
+        CLOG(TRACE, LOG_INIT) << "Execution priorities are the "
+                << (input_args->task_order == CRITICAL_PATH ? "critical-path lengths" : "costs of subbasins")
+                << " estimated by " << (measured ? "measured costs." : "cells numbers.");
+    }
 
     int igroup = 0;
     for (auto it = group_set.begin(); it != group_set.end(); ++it) {
@@ -76,6 +110,7 @@ int ManagementProcess(MongoClient* mclient, InputArgs* input_args, const int siz
             if (subbasin_map[id]->down_stream != nullptr) {
                 task->down_id[group_index + i] = subbasin_map[id]->down_stream->id;
             }
+            if (nullptr != task->priority) { task->priority[group_index + i] = priorities.at(id); }
             int n_ups = CVT_INT(subbasin_map[id]->up_streams.size());
             task->up_count[group_index + i] = n_ups;
             if (n_ups > MAX_UPSTREAM) {
@@ -120,6 +155,7 @@ int LoadTasks(MongoClient* client, InputArgs* input_args, const int size, const
         Initialize1DArray(n_task_all, task->down_id, -1);
         Initialize1DArray(n_task_all, task->up_count, 0);
         Initialize1DArray(n_task_all * MAX_UPSTREAM, task->up_ids, -1);
+        if (input_args->task_order != LAYER_ORDER) { Initialize1DArray(n_task_all, task->priority, 0.); }
     }
     MPI_Barrier(MCW); /// Wait for non-master rank
 
@@ -133,6 +169,10 @@ int LoadTasks(MongoClient* client, InputArgs* input_args, const int size, const
     MPI_Barrier(MCW);
     MPI_Bcast(task->up_ids, n_task_all * MAX_UPSTREAM, MPI_INT, MASTER_RANK, MCW);
     MPI_Barrier(MCW);
+    if (nullptr != task->priority) {
+        MPI_Bcast(task->priority, n_task_all, MPI_DOUBLE, MASTER_RANK, MCW);
+        MPI_Barrier(MCW);
+    }
     if (rank == MASTER_RANK) {
         CLOG(TRACE, LOG_INIT) << "Tasks are dispatched.";
     }
@@ -4,6 +4,9 @@
  *
  * Changelog:
  *   - 1. 2018-06-12  - lj -  Initial implementation.
+ *   - 2. 2026-10-19  - lj -  Partition subbasins in-process by METIS for any number of processes.
+ *   - 3. 2026-10-19  - lj -  Scatter estimated costs of subbasins as the execution priorities.
+ *   - 4. 2026-10-19  - lj -  Scatter critical-path lengths of subbasins as the execution priorities.
  *
  * \author Liangjun Zhu
  */
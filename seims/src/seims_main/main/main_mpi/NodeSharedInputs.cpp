@@ -0,0 +1,268 @@
+#include "NodeSharedInputs.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "utils_time.h"
+#include "DataCenterMongoDB.h"
+#include "text.h"
+#include "Logging.h"
+
+using namespace utils_time;
+using std::istringstream;
+using std::ostringstream;
+
+NodeSharedInputs::NodeSharedInputs() :
+#if MPI_VERSION >= 3
+    node_comm_(MPI_COMM_NULL), win_(MPI_WIN_NULL),
+#endif
+    node_rank_(-1), allocated_(false), climate_(nullptr) {
+}
+
+NodeSharedInputs::~NodeSharedInputs() {
+    delete climate_;
+    climate_ = nullptr;
+#if MPI_VERSION >= 3
+    if (allocated_) { MPI_Win_free(&win_); }
+    if (node_comm_ != MPI_COMM_NULL) { MPI_Comm_free(&node_comm_); }
+#endif
+}
+
+bool NodeSharedInputs::Load(MongoClient* client, InputArgs* input_args) {
+#if MPI_VERSION >= 3
+    MPI_Comm_split_type(MCW, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm_);
+    MPI_Comm_rank(node_comm_, &node_rank_);
+    /// 1. The leader rank reads the data of the entire watershed
+    string header;
+    InputStation* station = nullptr;
+    if (node_rank_ == 0) {
+        try {
+            station = ReadClimateData(client, input_args->model_name, header);
+        } catch (std::exception& e) {
+            // Any error must not skip the following collective calls of the node
+            LOG(WARNING) << "Read HydroClimate data to share failed: " << e.what();
+        }
+        if (nullptr == station) { header.clear(); }
+    }
+    /// 2. Broadcast the description of the shared data
+    int header_len = CVT_INT(header.size());
+    MPI_Bcast(&header_len, 1, MPI_INT, 0, node_comm_);
+    if (header_len == 0) {
+        delete station;
+        return false;
+    }
+    vector<char> header_buf(header.begin(), header.end());
+    header_buf.resize(header_len);
+    MPI_Bcast(&header_buf[0], header_len, MPI_CHAR, 0, node_comm_);
+    vector<size_t> offsets;
+    size_t n_values = ParseHeader(string(header_buf.begin(), header_buf.end()), offsets);
+
+    /// 3. Allocate the shared memory window on the leader rank and query its address by the others
+    MPI_Aint win_size = node_rank_ == 0 ? static_cast<MPI_Aint>(n_values * sizeof(FLTPT)) : 0;
+    FLTPT* base = nullptr;
+    MPI_Win_allocate_shared(win_size, sizeof(FLTPT), MPI_INFO_NULL, node_comm_, &base, &win_);
+    allocated_ = true;
+    if (node_rank_ != 0) {
+        MPI_Aint size;
+        int disp_unit;
+        MPI_Win_shared_query(win_, 0, &size, &disp_unit, &base);
+    }
+
+    /// 4. The leader rank copies data into shared memory, which are read-only afterward
+    MPI_Win_fence(0, win_);
+    int copied = 1;
+    if (node_rank_ == 0) {
+        try {
+            copied = CopyClimateData(station, base, offsets) ? 1 : 0;
+        } catch (std::exception& e) {
+            LOG(WARNING) << "Copy HydroClimate data to share failed: " << e.what();
+            copied = 0;
+        }
+        delete station;
+    }
+    MPI_Win_fence(0, win_);
+    /// 5. All ranks of the node give up the shared data together if the leader failed
+    MPI_Bcast(&copied, 1, MPI_INT, 0, node_comm_);
+    if (copied == 0) {
+        MPI_Win_free(&win_);
+        allocated_ = false;
+        delete climate_;
+        climate_ = nullptr;
+        return false;
+    }
+    SetDataAddress(base, offsets);
+    if (node_rank_ == 0) {
+        LOG(INFO) << "HydroClimate data of " << n_values * sizeof(FLTPT) / 1048576.
+                << " MB are shared by ranks of the node.";
+    }
+    return true;
+#else
+    return false;
+#endif /* MPI_VERSION >= 3 */
+}
+
+bool NodeSharedInputs::CopyClimateData(InputStation* station, FLTPT* base, const vector<size_t>& offsets) {
+    vector<string> types;
+    climate_->GetSeriesTypes(types);
+    size_t idx = 0;
+    for (auto it = types.begin(); it != types.end(); ++it, idx++) {
+        const SharedSiteSeries* series = climate_->GetSeries(*it);
+        size_t n_sites = series->site_ids.size();
+        for (int i = 0; i < series->n_records; i++) {
+            int n = 0;
+            FLTPT* record = nullptr;
+            time_t t = series->start_time + i * series->interval;
+            station->GetTimeSeriesData(t, *it, &n, &record);
+            if (nullptr == record || CVT_SIZET(n) != n_sites) {
+                LOG(WARNING) << "HydroClimate data of " << *it << " at " << ConvertToString2(t)
+                        << " have " << n << " sites rather than " << n_sites << ", which cannot be shared.";
+                return false;
+            }
+            std::copy(record, record + n_sites, base + offsets[idx] + i * n_sites);
+        }
+    }
+    climate_->GetSiteInfoTypes(types);
+    for (auto it = types.begin(); it != types.end(); ++it, idx += 2) {
+        size_t n_sites = climate_->GetSiteInfo(*it)->site_ids.size();
+        FLTPT* lats = nullptr;
+        FLTPT* elevs = nullptr;
+        if (!station->GetLatitude(it->c_str(), lats) || !station->GetElevation(it->c_str(), elevs) ||
+            nullptr == lats || nullptr == elevs) {
+            LOG(WARNING) << "Sites information of " << *it << " is not available, which cannot be shared.";
+            return false;
+        }
+        std::copy(lats, lats + n_sites, base + offsets[idx]);
+        std::copy(elevs, elevs + n_sites, base + offsets[idx + 1]);
+    }
+    return true;
+}
+
+InputStation* NodeSharedInputs::ReadClimateData(MongoClient* client, const string& model_name, string& header) {
+    header.clear();
+    vector<string> file_in_strs;
+    if (!DataCenterMongoDB::ReadFileInStrings(client, model_name, file_in_strs)) { return nullptr; }
+    SettingsInput* input = SettingsInput::Init(file_in_strs);
+    if (nullptr == input) { return nullptr; }
+    // Only the regular time series are shared
+    if (input->isStormMode()) {
+        delete input;
+        return nullptr;
+    }
+    InputStation* station = new InputStation(client, input->getDtHillslope(), input->getDtChannel());
+    map<string, string> site_lists;
+    string clim_dbname = DataCenterMongoDB::ReadClimateSites(client, model_name, 0, input, station, &site_lists);
+    if (clim_dbname.empty() || site_lists.empty()) {
+        delete station;
+        delete input;
+        return nullptr;
+    }
+    time_t interval = input->getDtHillslope();
+    int n_records = CVT_INT((input->getEndTime() - input->getStartTime()) / interval + 1);
+    ostringstream oss;
+    oss << clim_dbname << " " << input->getStartTime() << " " << interval << "\n";
+    // Time series of each data type, sites are in ascending order as Measurement
+    for (auto it = site_lists.begin(); it != site_lists.end(); ++it) {
+        vector<int> site_ids;
+        SplitStringForValues(it->second, ',', site_ids);
+        sort(site_ids.begin(), site_ids.end());
+        oss << "S " << it->first << " " << n_records << " " << site_ids.size();
+        for (auto it_id = site_ids.begin(); it_id != site_ids.end(); ++it_id) { oss << " " << *it_id; }
+        oss << "\n";
+    }
+    // Sites information in the order of site list, the meteorology sites information is read
+    //   by the first non-precipitation data type, see InputStation::ReadSitesData().
+    map<string, string> info_lists;
+    if (site_lists.find(DataType_Precipitation) != site_lists.end()) {
+        info_lists[DataType_Precipitation] = site_lists.at(DataType_Precipitation);
+    }
+    if (site_lists.find(METEO_VARS[0]) != site_lists.end()) {
+        info_lists[DataType_Meteorology] = site_lists.at(METEO_VARS[0]);
+    } else if (site_lists.find(DataType_PotentialEvapotranspiration) != site_lists.end()) {
+        info_lists[DataType_Meteorology] = site_lists.at(DataType_PotentialEvapotranspiration);
+    }
+    for (auto it = info_lists.begin(); it != info_lists.end(); ++it) {
+        int n_sites = -1;
+        if (!station->NumberOfSites(it->first.c_str(), n_sites)) { continue; }
+        vector<int> site_ids;
+        SplitStringForValues(it->second, ',', site_ids);
+        if (CVT_INT(site_ids.size()) != n_sites) { continue; }
+        oss << "I " << it->first << " " << n_sites;
+        for (auto it_id = site_ids.begin(); it_id != site_ids.end(); ++it_id) { oss << " " << *it_id; }
+        oss << "\n";
+    }
+    delete input;
+    header = oss.str();
+    return station;
+}
+
+size_t NodeSharedInputs::ParseHeader(const string& header, vector<size_t>& offsets) {
+    istringstream iss(header);
+    string clim_dbname;
+    vint64_t start_time = 0;
+    vint64_t interval = 0;
+    iss >> clim_dbname >> start_time >> interval;
+    climate_ = new SharedClimateData(clim_dbname);
+    // Offsets of time series of each data type, then latitudes and elevations of each site type,
+    //   the data types and site types are ordered by name, the same as SharedClimateData.
+    vector<size_t> info_offsets;
+    size_t n_values = 0;
+    string flag;
+    while (iss >> flag) {
+        string site_type;
+        iss >> site_type;
+        if (flag == "S") {
+            SharedSiteSeries series;
+            size_t n_sites = 0;
+            iss >> series.n_records >> n_sites;
+            series.site_ids.resize(n_sites);
+            for (size_t i = 0; i < n_sites; i++) { iss >> series.site_ids[i]; }
+            series.start_time = static_cast<time_t>(start_time);
+            series.interval = static_cast<time_t>(interval);
+            series.values = nullptr;
+            climate_->AddSeries(site_type, series);
+        } else {
+            SharedSiteInfo info;
+            size_t n_sites = 0;
+            iss >> n_sites;
+            info.site_ids.resize(n_sites);
+            for (size_t i = 0; i < n_sites; i++) { iss >> info.site_ids[i]; }
+            info.lats = nullptr;
+            info.elevs = nullptr;
+            climate_->AddSiteInfo(site_type, info);
+        }
+    }
+    offsets.clear();
+    vector<string> types;
+    climate_->GetSeriesTypes(types);
+    for (auto it = types.begin(); it != types.end(); ++it) {
+        const SharedSiteSeries* series = climate_->GetSeries(*it);
+        offsets.push_back(n_values);
+        n_values += static_cast<size_t>(series->n_records) * series->site_ids.size();
+    }
+    climate_->GetSiteInfoTypes(types);
+    for (auto it = types.begin(); it != types.end(); ++it) {
+        size_t n_sites = climate_->GetSiteInfo(*it)->site_ids.size();
+        offsets.push_back(n_values);
+        offsets.push_back(n_values + n_sites);
+        n_values += n_sites * 2;
+    }
+    return n_values;
+}
+
+void NodeSharedInputs::SetDataAddress(FLTPT* base, const vector<size_t>& offsets) {
+    vector<string> types;
+    climate_->GetSeriesTypes(types);
+    size_t idx = 0;
+    for (auto it = types.begin(); it != types.end(); ++it, idx++) {
+        SharedSiteSeries series = *climate_->GetSeries(*it);
+        series.values = base + offsets[idx];
+        climate_->AddSeries(*it, series);
+    }
+    climate_->GetSiteInfoTypes(types);
+    for (auto it = types.begin(); it != types.end(); ++it, idx += 2) {
+        SharedSiteInfo info = *climate_->GetSiteInfo(*it);
+        info.lats = base + offsets[idx];
+        info.elevs = base + offsets[idx + 1];
+        climate_->AddSiteInfo(*it, info);
+    }
+}
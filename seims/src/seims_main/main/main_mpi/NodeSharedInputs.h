@@ -0,0 +1,100 @@
+/*!
+ * \file NodeSharedInputs.h
+ * \brief Static inputs shared by the ranks of the same computing node.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19  - lj -  Initial implementation.
+ *   - 2. 2026-10-19  - lj -  Validate the data copied by the leader rank, all ranks give up the shared data if failed.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_MPI_NODE_SHARED_INPUTS_H
+#define SEIMS_MPI_NODE_SHARED_INPUTS_H
+
+#include "parallel.h"
+#include "invoke.h"
+#include "InputStation.h"
+#include "SharedClimateData.h"
+
+/*!
+ * \ingroup seims_mpi
+ * \class NodeSharedInputs
+ * \brief Static and read-only inputs loaded once by one rank of each computing node into
+ *        a MPI-3 shared memory window, which are referenced by the data centers of all
+ *        subbasins of all ranks on the node.
+ *
+ *        Currently, the regular time series and sites information of HydroClimate data of
+ *        the entire watershed are shared, which are the largest inputs duplicated by the
+ *        data centers. If the shared data are not available (e.g., MPI version lower than 3,
+ *        storm mode, or query failed), each data center reads its own data as before.
+ *
+ * \code
+ *      NodeSharedInputs* node_shared = new NodeSharedInputs();
+ *      node_shared->Load(mongo_client, input_args); // Collective over MPI_COMM_WORLD
+ *      DataCenterMongoDB* data_center = new DataCenterMongoDB(..., subbasin_id,
+ *                                                             node_shared->GetClimateData());
+ *      ...
+ *      delete data_center;
+ *      delete node_shared; // Collective, after all data centers are released
+ * \endcode
+ */
+class NodeSharedInputs: NotCopyable {
+public:
+    //! Constructor
+    NodeSharedInputs();
+
+    //! Destructor, collective over all ranks of the node
+    ~NodeSharedInputs();
+
+    /*!
+     * \brief Load shared inputs by the leader rank of each node, collective over MPI_COMM_WORLD
+     * \param[in] client MongoDB client
+     * \param[in] input_args Input arguments
+     * \return True if the shared data are available
+     */
+    bool Load(MongoClient* client, InputArgs* input_args);
+
+    //! Shared HydroClimate data, nullptr if not available
+    SharedClimateData* GetClimateData() { return climate_; }
+
+private:
+    /*!
+     * \brief Read HydroClimate data of the entire watershed by the leader rank
+     * \param[in] client MongoDB client
+     * \param[in] model_name Main model database name
+     * \param[out] header Description of the shared data, empty if failed
+     * \return InputStation that holds the data to be copied into shared memory
+     */
+    InputStation* ReadClimateData(MongoClient* client, const string& model_name, string& header);
+
+    /*!
+     * \brief Copy HydroClimate data into shared memory by the leader rank
+     * \param[in] station InputStation read by ReadClimateData()
+     * \param[in] base Base address of window
+     * \param[in] offsets Offsets of the shared arrays in window, ordered by the header
+     * \return False if any record or sites information is not available or mismatches the header
+     */
+    bool CopyClimateData(InputStation* station, FLTPT* base, const vector<size_t>& offsets);
+
+    /*!
+     * \brief Parse the description of the shared data and create `climate_`
+     * \param[in] header Description of the shared data
+     * \param[out] offsets Offsets of the shared arrays in window, ordered by the header
+     * \return Total number of values
+     */
+    size_t ParseHeader(const string& header, vector<size_t>& offsets);
+
+    //! Set data pointers of `climate_` by the base address of window
+    void SetDataAddress(FLTPT* base, const vector<size_t>& offsets);
+
+private:
+#if MPI_VERSION >= 3
+    MPI_Comm node_comm_;         ///< Communicator of ranks on the same node
+    MPI_Win win_;                ///< Shared memory window
+#endif
+    int node_rank_;              ///< Rank in node_comm_, 0 is the leader
+    bool allocated_;             ///< Is the shared memory window allocated
+    SharedClimateData* climate_; ///< Shared HydroClimate data
+};
+
+#endif /* SEIMS_MPI_NODE_SHARED_INPUTS_H */
@@ -0,0 +1,220 @@
+#include "PartitionTasks.h"
+
+#include <fstream>
+
+#include "metis.h"
+#include "parallel.h"
+#include "utils_filesystem.h"
+#include "utils_string.h"
+#include "Logging.h"
+
+using namespace utils_filesystem;
+using namespace utils_string;
+using std::ifstream;
+using std::ofstream;
+
+string SubbasinCostsFile(InputArgs* input_args) {
+    return input_args->output_path + SUBBASIN_COSTS_FILE;
+}
+
+bool ReadSubbasinCosts(const string& filename, map<int, double>& costs) {
+    costs.clear();
+    if (!FileExists(filename)) { return false; }
+    ifstream ifs(filename.c_str(), std::ios::in);
+    if (!ifs.is_open()) { return false; }
+    string line;
+    while (getline(ifs, line)) {
+        TrimSpaces(line);
+        if (line.empty() || line[0] == '#') { continue; }
+        vector<string> items = SplitString(line, ',');
+        if (items.size() < 2) { continue; }
+        bool id_ok = false;
+        bool cost_ok = false;
+        int id = CVT_INT(IsInt(items[0], id_ok));
+        double cost = IsDouble(items[1], cost_ok);
+        // header line, e.g., SUBBASINID,COST
+        if (!id_ok || !cost_ok || cost < 0.) { continue; }
+        costs[id] = cost;
+    }
+    ifs.close();
+    return !costs.empty();
+}
+
+bool EstimateSubbasinCosts(const map<int, SubbasinStruct *>& subbasins, const map<int, double>& measured,
+                           map<int, double>& costs) {
+    costs.clear();
+    bool use_measured = !measured.empty();
+    for (auto it = subbasins.begin(); it != subbasins.end() && use_measured; ++it) {
+        auto mit = measured.find(it->first);
+        if (mit == measured.end() || mit->second <= 0.) { use_measured = false; }
+    }
+    for (auto it = subbasins.begin(); it != subbasins.end(); ++it) {
+        if (use_measured) {
+            costs[it->first] = measured.at(it->first);
+        } else {
+            costs[it->first] = it->second->cells > 0 ? CVT_DBL(it->second->cells) : 1.;
+        }
+    }
+    return use_measured;
+}
+
+void CriticalPathLengths(const map<int, SubbasinStruct *>& subbasins, const map<int, double>& costs,
+                         map<int, double>& lengths) {
+    lengths.clear();
+    for (auto it = subbasins.begin(); it != subbasins.end(); ++it) {
+        // Walk downstream until the outlet or a subbasin whose length is known
+        vector<SubbasinStruct *> chain;
+        SubbasinStruct* cur = it->second;
+        while (nullptr != cur && lengths.find(cur->id) == lengths.end()) {
+            chain.emplace_back(cur);
+            cur = cur->down_stream;
+        }
+        double length = nullptr != cur ? lengths.at(cur->id) : 0.;
+        for (auto rit = chain.rbegin(); rit != chain.rend(); ++rit) {
+            length += costs.at((*rit)->id);
+            lengths[(*rit)->id] = length;
+        }
+    }
+}
+
+int PartitionSubbasins(map<int, SubbasinStruct *>& subbasins, const GroupMethod group_method, const int size,
+                       const map<int, double>& costs, set<int>& group_set) {
+    group_set.clear();
+    idx_t nvtxs = CVT_INT(subbasins.size());
+    if (size <= 0 || nvtxs < size) {
+        LOG(ERROR) << "Can not partition " << nvtxs << " subbasins into " << size << " groups!";
+        return -1;
+    }
+    if (size == 1) {
+        for (auto it = subbasins.begin(); it != subbasins.end(); ++it) { it->second->group = 0; }
+        group_set.insert(0);
+        return 0;
+    }
+    // Vertex index of subbasins
+    map<int, idx_t> index;
+    vector<SubbasinStruct *> vertices;
+    for (auto it = subbasins.begin(); it != subbasins.end(); ++it) {
+        index[it->first] = CVT_INT(vertices.size());
+        vertices.emplace_back(it->second);
+    }
+    // Vertex weights, the measured costs are scaled to integers, which are at least 1.
+    //   The sum of weights should not overflow idx_t (32-bit by default), i.e., less than 1e9 + nvtxs.
+    map<int, double> weights;
+    bool use_costs = EstimateSubbasinCosts(subbasins, costs, weights);
+    double max_cost = 0.;
+    for (auto it = weights.begin(); it != weights.end(); ++it) {
+        if (it->second > max_cost) { max_cost = it->second; }
+    }
+    double scale = 1.e9 / CVT_DBL(nvtxs);
+    vector<idx_t> vwgt(nvtxs, 1);
+    for (idx_t i = 0; i < nvtxs; i++) {
+        double w = weights.at(vertices[i]->id);
+        vwgt[i] = use_costs ? CVT_INT(w / max_cost * scale) + 1 : CVT_INT(w);
+    }
+    // Undirected graph in CSR format, each upstream-downstream link is an edge.
+    // All edges transfer the same count of values at each time step, thus the edge weights are uniform.
+    vector<idx_t> xadj(nvtxs + 1, 0);
+    vector<idx_t> adjncy;
+    for (idx_t i = 0; i < nvtxs; i++) {
+        if (nullptr != vertices[i]->down_stream) {
+            adjncy.emplace_back(index[vertices[i]->down_stream->id]);
+        }
+        for (auto it = vertices[i]->up_streams.begin(); it != vertices[i]->up_streams.end(); ++it) {
+            adjncy.emplace_back(index[(*it)->id]);
+        }
+        xadj[i + 1] = CVT_INT(adjncy.size());
+    }
+    vector<idx_t> adjwgt(adjncy.size(), 1);
+    if (adjncy.empty()) {
+        // METIS requires non-empty adjacency
+        adjncy.emplace_back(0);
+        adjwgt.emplace_back(1);
+    }
+
+    idx_t ncon = 1;
+    idx_t nparts = size;
+    idx_t objval = 0;
+    vector<idx_t> part(nvtxs, 0);
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+    options[METIS_OPTION_NUMBERING] = 0;
+    options[METIS_OPTION_SEED] = 1; // reproducible partition
+    int ret = group_method == PMETIS
+                  ? METIS_PartGraphRecursive(&nvtxs, &ncon, &xadj[0], &adjncy[0], &vwgt[0], nullptr,
+                                             &adjwgt[0], &nparts, nullptr, nullptr, options, &objval, &part[0])
+                  : METIS_PartGraphKway(&nvtxs, &ncon, &xadj[0], &adjncy[0], &vwgt[0], nullptr,
+                                        &adjwgt[0], &nparts, nullptr, nullptr, options, &objval, &part[0]);
+    if (ret != METIS_OK) {
+        LOG(ERROR) << "METIS partition failed with error code: " << ret;
+        return -1;
+    }
+    // Each group should have at least one subbasin, move the lightest one from the largest groups
+    vector<int> counts(size, 0);
+    for (idx_t i = 0; i < nvtxs; i++) { counts[part[i]]++; }
+    for (int g = 0; g < size; g++) {
+        if (counts[g] > 0) { continue; }
+        int largest = 0;
+        for (int k = 1; k < size; k++) {
+            if (counts[k] > counts[largest]) { largest = k; }
+        }
+        idx_t lightest = -1;
+        for (idx_t i = 0; i < nvtxs; i++) {
+            if (part[i] != largest) { continue; }
+            if (lightest < 0 || vwgt[i] < vwgt[lightest]) { lightest = i; }
+        }
+        part[lightest] = g;
+        counts[largest]--;
+        counts[g]++;
+    }
+    for (idx_t i = 0; i < nvtxs; i++) {
+        vertices[i]->group = part[i];
+        group_set.insert(part[i]);
+    }
+    CLOG(TRACE, LOG_INIT) << "Partitioned " << nvtxs << " subbasins into " << size << " groups by "
+            << GroupMethodString[CVT_INT(group_method)] << (use_costs ? " weighted by measured costs" : "")
+            << ", edge cut: " << objval;
+    return 0;
+}
+
+bool SaveSubbasinCosts(InputArgs* input_args, const int rank, const int size, const map<int, double>& costs) {
+    int n = CVT_INT(costs.size());
+    vector<int> ids;
+    vector<double> values;
+    for (auto it = costs.begin(); it != costs.end(); ++it) {
+        ids.emplace_back(it->first);
+        values.emplace_back(it->second);
+    }
+    vector<int> counts(size, 0);
+    MPI_Gather(&n, 1, MPI_INT, &counts[0], 1, MPI_INT, MASTER_RANK, MCW);
+    vector<int> displs(size, 0);
+    int total = 0;
+    if (rank == MASTER_RANK) {
+        for (int i = 0; i < size; i++) {
+            displs[i] = total;
+            total += counts[i];
+        }
+    }
+    vector<int> all_ids(total > 0 ? total : 1, -1);
+    vector<double> all_values(total > 0 ? total : 1, 0.);
+    MPI_Gatherv(n > 0 ? &ids[0] : nullptr, n, MPI_INT,
+                &all_ids[0], &counts[0], &displs[0], MPI_INT, MASTER_RANK, MCW);
+    MPI_Gatherv(n > 0 ? &values[0] : nullptr, n, MPI_DOUBLE,
+                &all_values[0], &counts[0], &displs[0], MPI_DOUBLE, MASTER_RANK, MCW);
+    if (rank != MASTER_RANK || total == 0) { return true; }
+    string filename = SubbasinCostsFile(input_args);
+    ofstream ofs(filename.c_str(), std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        LOG(WARNING) << "Can not write computing costs of subbasins to " << filename;
+        return false;
+    }
+    ofs << "# Computing costs (seconds) of subbasins measured by the latest MPI run" << endl;
+    ofs << "SUBBASINID,COST" << endl;
+    map<int, double> sorted;
+    for (int i = 0; i < total; i++) { sorted[all_ids[i]] = all_values[i]; }
+    for (auto it = sorted.begin(); it != sorted.end(); ++it) {
+        ofs << it->first << "," << it->second << endl;
+    }
+    ofs.close();
+    CLOG(TRACE, LOG_INIT) << "Computing costs of subbasins are saved to " << filename;
+    return true;
+}
@@ -0,0 +1,105 @@
+/*!
+ * \file PartitionTasks.h
+ * \brief Partition subbasins into parallel tasks by METIS at startup, and estimate the costs of subbasins.
+ *
+ *        The groups of subbasins prepared by preprocessing (i.e., KMETIS and PMETIS fields of
+ *        the REACHES collection) are available for a few numbers of processes, and weighted by
+ *        the cells number of subbasins. Instead, the subbasin graph is partitioned in-process
+ *        for any number of processes, weighted by the computing costs of subbasins measured by
+ *        a previous run if specified (i.e., `-costs`).
+ *
+ * Changelog:
+ *   - 1. 2026-10-19 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Add estimated costs of subbasins as the execution priorities.
+ *   - 3. 2026-10-19 - lj - Read costs from the specified file, and save measured costs in the output folder.
+ *   - 4. 2026-10-19 - lj - Add critical-path lengths of subbasins as the execution priorities.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_MPI_PARTITION_TASKS_H
+#define SEIMS_MPI_PARTITION_TASKS_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "invoke.h"
+#include "ReadReachTopology.h"
+
+using std::map;
+using std::set;
+using std::vector;
+
+/*! File name of the measured computing costs of subbasins, which is saved in the output folder of the run */
+const char* const SUBBASIN_COSTS_FILE = "subbasin_costs.csv";
+
+/*!
+ * \brief Full path of the measured computing costs file of subbasins, i.e., in the output folder of the run
+ * \ingroup seims_mpi
+ */
+string SubbasinCostsFile(InputArgs* input_args);
+
+/*!
+ * \brief Read computing costs of subbasins, each line is `subbasinID,cost`
+ * \ingroup seims_mpi
+ * \param[in] filename Costs file
+ * \param[out] costs Computing costs (seconds) of subbasins
+ * \return False if the file is not existed or empty
+ */
+bool ReadSubbasinCosts(const string& filename, map<int, double>& costs);
+
+/*!
+ * \brief Estimate computing costs of subbasins, i.e., the measured costs if they cover all subbasins,
+ *        otherwise the cells numbers.
+ * \ingroup seims_mpi
+ * \param[in] subbasins Map of subbasin data
+ * \param[in] measured Computing costs of subbasins measured by the previous run, can be empty
+ * \param[out] costs Estimated costs of subbasins
+ * \return True if the measured costs are used
+ */
+bool EstimateSubbasinCosts(const map<int, SubbasinStruct *>& subbasins, const map<int, double>& measured,
+                           map<int, double>& costs);
+
+/*!
+ * \brief Critical-path length of each subbasin to the outlet, i.e., the sum of the costs of the subbasin
+ *        and all its downstream subbasins, which is the lower bound of the time to finish the outlet
+ *        once the subbasin starts.
+ * \ingroup seims_mpi
+ * \param[in] subbasins Map of subbasin data
+ * \param[in] costs Estimated costs of subbasins, see EstimateSubbasinCosts()
+ * \param[out] lengths Critical-path lengths of subbasins
+ */
+void CriticalPathLengths(const map<int, SubbasinStruct *>& subbasins, const map<int, double>& costs,
+                         map<int, double>& lengths);
+
+/*!
+ * \brief Partition subbasins into groups by METIS, KMETIS (default) or PMETIS.
+ *
+ *        The vertices are subbasins weighted by the measured computing costs, or the cells
+ *        numbers if the costs do not cover all subbasins. The edges are the upstream-downstream
+ *        relationships, i.e., transferred values, which have the same volume for all subbasins.
+ *
+ * \ingroup seims_mpi
+ * \param[in,out] subbasins Map of subbasin data, the group of each subbasin will be updated
+ * \param[in] group_method Group method
+ * \param[in] size Number of groups, i.e., number of processes
+ * \param[in] costs Computing costs of subbasins, can be empty
+ * \param[out] group_set Group ID set, i.e., 0 ~ size - 1
+ * \return 0 for success
+ */
+int PartitionSubbasins(map<int, SubbasinStruct *>& subbasins, GroupMethod group_method, int size,
+                       const map<int, double>& costs, set<int>& group_set);
+
+/*!
+ * \brief Gather the computing costs of subbasins of all ranks and save by the master rank,
+ *        which should be called by all ranks.
+ * \ingroup seims_mpi
+ * \param[in] input_args Input arguments
+ * \param[in] rank Rank ID
+ * \param[in] size Number of process
+ * \param[in] costs Computing costs (seconds) of subbasins of current rank
+ * \return True if succeed
+ */
+bool SaveSubbasinCosts(InputArgs* input_args, int rank, int size, const map<int, double>& costs);
+
+#endif /* SEIMS_MPI_PARTITION_TASKS_H */
@@ -6,7 +6,7 @@
 #include "Logging.h"
 
 SubbasinStruct::SubbasinStruct(const int sid, const int gidx) :
-    id(sid), group(gidx),
+    id(sid), group(gidx), cells(0),
     updown_order(-1), downup_order(-1), calculated(false),
     transfer_count(-1), transfer_values(nullptr),
     down_stream(nullptr) {
@@ -42,6 +42,7 @@ int CreateReachTopology(MongoClient* client, const string& dbname,
         // set layering order
         subbasins[id]->updown_order = CVT_INT(tmp_reach->Get(REACH_UPDOWN_ORDER));
         subbasins[id]->downup_order = CVT_INT(tmp_reach->Get(REACH_DOWNUP_ORDER));
+        subbasins[id]->cells = CVT_INT(tmp_reach->Get(REACH_NUMCELLS));
 
         group_set.insert(group);
     }
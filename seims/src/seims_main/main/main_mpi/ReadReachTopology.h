@@ -4,6 +4,7 @@
  *
  * Changelog:
  *   - 1. 2018-03-20  - lj -  Refactor as a more flexible framework to support various transferred variables.
+ *   - 2. 2026-10-19  - lj -  Add cells number of subbasin as the default weight of partitioning.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
@@ -38,6 +39,7 @@ public:
 public:
     int id;           ///< Subbasin ID, start from 1
     int group;        ///< Group index, start from 0 to (group number - 1)
+    int cells;        ///< Cells number of subbasin
     int updown_order; ///< up-down stream order
     int downup_order; ///< down-up stream order
     bool calculated;  ///< whether this subbasin is already calculated
@@ -58,7 +60,8 @@ public:
  * \param[in] group_method GroupMethod
  * \param[in] group_size number of parallel tasks, i.e., number of processes
  * \param[out] subbasins Map of subbasin data struct, SubbasinStruct
- * \param[out] group_set Group ID set, e.g., 1, 2, 3, 4
+ * \param[out] group_set Group ID set, e.g., 1, 2, 3, 4, which contains -1 if the group method with
+ *                       `group_size` is not prepared
  */
 int CreateReachTopology(MongoClient* client, const string& dbname,
                         GroupMethod group_method, int group_size,
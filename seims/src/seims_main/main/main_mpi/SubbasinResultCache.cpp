@@ -0,0 +1,216 @@
+#include "SubbasinResultCache.h"
+
+#include <fstream>
+
+#include "utils_filesystem.h"
+#include "utils_string.h"
+#include "text.h"
+#include "Logging.h"
+
+using namespace utils_filesystem;
+using namespace utils_string;
+using std::ifstream;
+using std::ofstream;
+
+SubbasinResultCache::SubbasinResultCache(const string& cache_path, const int transfer_count,
+                                         const time_t start_time, const time_t end_time,
+                                         const time_t interval) :
+    cache_path_(cache_path), n_values_(transfer_count), n_steps_(0),
+    start_time_(start_time), interval_(interval) {
+    if (interval_ > 0) { n_steps_ = CVT_INT((end_time - start_time) / interval_) + 1; }
+    if (!PathExists(cache_path_)) { MakeDirectory(cache_path_); }
+}
+
+SubbasinResultCache::~SubbasinResultCache() {
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        delete it->second;
+        it->second = nullptr;
+    }
+    entries_.clear();
+}
+
+void SubbasinResultCache::CreateEntry(const int subbasin_id, const bool affected) {
+    if (entries_.find(subbasin_id) != entries_.end()) { return; }
+    Entry* entry = new Entry();
+    entry->affected = affected;
+    entry->replayed = false;
+    entry->tf_values.resize(CVT_SIZET(n_steps_) * n_values_, 0.f);
+    entries_[subbasin_id] = entry;
+}
+
+void SubbasinResultCache::Record(const int subbasin_id, const time_t cur_time, const float* values) {
+    auto it = entries_.find(subbasin_id);
+    if (it == entries_.end() || it->second->replayed || nullptr == values) { return; }
+    int idx = StepIndex(cur_time);
+    if (idx < 0) { return; }
+    std::copy(values, values + n_values_, &it->second->tf_values[CVT_SIZET(idx) * n_values_]);
+}
+
+bool SubbasinResultCache::Save(const int subbasin_id, const int scenario_id, const int calibration_id,
+                               SettingsOutput* outputs) {
+    auto it = entries_.find(subbasin_id);
+    if (it == entries_.end()) { return false; }
+    Entry* entry = it->second;
+    /// Raster outputs that have been flushed, the same as gathered by the MPI driver
+    entry->rasters.clear();
+    for (auto it_info = outputs->m_printInfos.begin(); it_info != outputs->m_printInfos.end(); ++it_info) {
+        for (auto it_item = (*it_info)->m_PrintItems.begin(); it_item != (*it_info)->m_PrintItems.end(); ++it_item) {
+            PrintInfoItem* item = *it_item;
+            if (item->m_nLayers < 1) { continue; }
+            RasterEntry raster;
+            raster.corename = item->Corename;
+            raster.n_cells = item->m_nRows;
+            raster.n_lyrs = item->m_nLayers;
+            if (nullptr != item->m_1DData && item->m_nLayers == 1) {
+                raster.values.assign(item->m_1DData, item->m_1DData + raster.n_cells);
+            } else if (nullptr != item->m_2DData) {
+                for (int i = 0; i < raster.n_cells; i++) {
+                    raster.values.insert(raster.values.end(), item->m_2DData[i],
+                                         item->m_2DData[i] + raster.n_lyrs);
+                }
+            } else {
+                continue;
+            }
+            entry->rasters.push_back(raster);
+        }
+    }
+    SubbasinCacheHeader header;
+    header.version = SUBBASIN_CACHE_VERSION;
+    header.subbasin_id = subbasin_id;
+    header.scenario_id = scenario_id;
+    header.calibration_id = calibration_id;
+    header.affected = entry->affected ? 1 : 0;
+    header.n_values = n_values_;
+    header.n_steps = n_steps_;
+    header.n_items = CVT_INT(entry->rasters.size());
+    header.start_time = static_cast<vint64_t>(start_time_);
+    header.interval = static_cast<vint64_t>(interval_);
+
+    ofstream ofs(CacheFile(subbasin_id).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+        CLOG(WARNING, LOG_OUTPUT) << "Create cache file " << CacheFile(subbasin_id) << " failed!";
+        return false;
+    }
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(SubbasinCacheHeader));
+    if (!entry->tf_values.empty()) {
+        ofs.write(reinterpret_cast<const char*>(&entry->tf_values[0]), entry->tf_values.size() * sizeof(float));
+    }
+    for (auto it_rs = entry->rasters.begin(); it_rs != entry->rasters.end(); ++it_rs) {
+        int name_len = CVT_INT(it_rs->corename.size());
+        ofs.write(reinterpret_cast<const char*>(&name_len), sizeof(int));
+        ofs.write(it_rs->corename.c_str(), name_len);
+        ofs.write(reinterpret_cast<const char*>(&it_rs->n_cells), sizeof(int));
+        ofs.write(reinterpret_cast<const char*>(&it_rs->n_lyrs), sizeof(int));
+        ofs.write(reinterpret_cast<const char*>(&it_rs->values[0]), it_rs->values.size() * sizeof(float));
+    }
+    bool done = ofs.good();
+    ofs.close();
+    // Release the cached raster outputs, which are kept by the output items
+    entry->rasters.clear();
+    return done;
+}
+
+bool SubbasinResultCache::Load(const int subbasin_id, const int calibration_id) {
+    string filename = CacheFile(subbasin_id);
+    if (!FileExists(filename)) { return false; }
+    ifstream ifs(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!ifs.is_open()) { return false; }
+    SubbasinCacheHeader header;
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(SubbasinCacheHeader));
+    if (!ifs.good() || header.version != SUBBASIN_CACHE_VERSION || header.subbasin_id != subbasin_id ||
+        header.calibration_id != calibration_id || header.n_values != n_values_ ||
+        header.n_steps != n_steps_ || header.start_time != static_cast<vint64_t>(start_time_) ||
+        header.interval != static_cast<vint64_t>(interval_)) {
+        CLOG(WARNING, LOG_INIT) << "Cache file " << filename << " mismatches current simulation, ignored!";
+        return false;
+    }
+    Entry* entry = new Entry();
+    entry->affected = header.affected != 0;
+    entry->replayed = false;
+    entry->tf_values.resize(CVT_SIZET(n_steps_) * n_values_);
+    if (!entry->tf_values.empty()) {
+        ifs.read(reinterpret_cast<char*>(&entry->tf_values[0]), entry->tf_values.size() * sizeof(float));
+    }
+    for (int i = 0; i < header.n_items && ifs.good(); i++) {
+        RasterEntry raster;
+        int name_len = 0;
+        ifs.read(reinterpret_cast<char*>(&name_len), sizeof(int));
+        if (!ifs.good() || name_len <= 0) { break; }
+        raster.corename.resize(name_len);
+        ifs.read(&raster.corename[0], name_len);
+        ifs.read(reinterpret_cast<char*>(&raster.n_cells), sizeof(int));
+        ifs.read(reinterpret_cast<char*>(&raster.n_lyrs), sizeof(int));
+        if (!ifs.good() || raster.n_cells <= 0 || raster.n_lyrs <= 0) { break; }
+        raster.values.resize(CVT_SIZET(raster.n_cells) * raster.n_lyrs);
+        ifs.read(reinterpret_cast<char*>(&raster.values[0]), raster.values.size() * sizeof(float));
+        entry->rasters.push_back(raster);
+    }
+    if (!ifs.good() || CVT_INT(entry->rasters.size()) != header.n_items) {
+        CLOG(WARNING, LOG_INIT) << "Cache file " << filename << " is incomplete, ignored!";
+        delete entry;
+        return false;
+    }
+    auto it = entries_.find(subbasin_id);
+    if (it != entries_.end()) { delete it->second; }
+    entries_[subbasin_id] = entry;
+    return true;
+}
+
+bool SubbasinResultCache::IsBaselineAffected(const int subbasin_id) {
+    auto it = entries_.find(subbasin_id);
+    return it == entries_.end() || it->second->affected;
+}
+
+void SubbasinResultCache::SetReplayed(const int subbasin_id) {
+    auto it = entries_.find(subbasin_id);
+    if (it == entries_.end()) { return; }
+    it->second->replayed = true;
+}
+
+bool SubbasinResultCache::IsReplayed(const int subbasin_id) const {
+    auto it = entries_.find(subbasin_id);
+    return it != entries_.end() && it->second->replayed;
+}
+
+bool SubbasinResultCache::GetTransferredValues(const int subbasin_id, const time_t cur_time, float* values) {
+    auto it = entries_.find(subbasin_id);
+    int idx = StepIndex(cur_time);
+    if (it == entries_.end() || idx < 0 || nullptr == values) { return false; }
+    const float* cached = &it->second->tf_values[CVT_SIZET(idx) * n_values_];
+    std::copy(cached, cached + n_values_, values);
+    return true;
+}
+
+void SubbasinResultCache::GetRasterNames(const int subbasin_id, vector<string>& corenames) {
+    corenames.clear();
+    auto it = entries_.find(subbasin_id);
+    if (it == entries_.end()) { return; }
+    for (auto it_rs = it->second->rasters.begin(); it_rs != it->second->rasters.end(); ++it_rs) {
+        corenames.push_back(it_rs->corename);
+    }
+}
+
+const float* SubbasinResultCache::GetRasterData(const int subbasin_id, const string& corename,
+                                                int* n_cells, int* n_lyrs) {
+    *n_cells = 0;
+    *n_lyrs = 0;
+    auto it = entries_.find(subbasin_id);
+    if (it == entries_.end()) { return nullptr; }
+    for (auto it_rs = it->second->rasters.begin(); it_rs != it->second->rasters.end(); ++it_rs) {
+        if (it_rs->corename != corename) { continue; }
+        *n_cells = it_rs->n_cells;
+        *n_lyrs = it_rs->n_lyrs;
+        return &it_rs->values[0];
+    }
+    return nullptr;
+}
+
+string SubbasinResultCache::CacheFile(const int subbasin_id) const {
+    return cache_path_ + SEP + itoa(subbasin_id) + "_result.cache";
+}
+
+int SubbasinResultCache::StepIndex(const time_t cur_time) const {
+    if (interval_ <= 0 || cur_time < start_time_) { return -1; }
+    int idx = CVT_INT((cur_time - start_time_) / interval_);
+    return idx < n_steps_ ? idx : -1;
+}
@@ -0,0 +1,171 @@
+/*!
+ * \file SubbasinResultCache.h
+ * \brief Cached results of subbasins for incremental scenario simulation.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19  - lj -  Initial implementation.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_MPI_SUBBASIN_RESULT_CACHE_H
+#define SEIMS_MPI_SUBBASIN_RESULT_CACHE_H
+
+#include "basic.h"
+#include "SettingsOutput.h"
+
+#include <map>
+#include <vector>
+
+using namespace ccgl;
+using std::map;
+using std::vector;
+
+/// Version of the layout of cache files, which should be increased once the layout changed
+#define SUBBASIN_CACHE_VERSION 1
+
+/*!
+ * \ingroup seims_mpi
+ * \struct SubbasinCacheHeader
+ * \brief Header of the cache file of a subbasin, followed by `n_steps * n_values` transferred values
+ *        (float) and `n_items` raster outputs, each of which is stored as the length of core name (int),
+ *        core name, cells number (int), layers number (int), and `n_cells * n_lyrs` values (float).
+ */
+struct SubbasinCacheHeader {
+    int version;          ///< Layout version, i.e., SUBBASIN_CACHE_VERSION
+    int subbasin_id;      ///< Subbasin ID
+    int scenario_id;      ///< BMPs scenario ID of the baseline run
+    int calibration_id;   ///< Calibration ID of the baseline run
+    int affected;         ///< Is the subbasin affected by the BMPs scenario of the baseline run
+    int n_values;         ///< Number of transferred values of each channel step
+    int n_steps;          ///< Number of channel steps
+    int n_items;          ///< Number of raster outputs
+    vint64_t start_time;  ///< Start time of simulation
+    vint64_t interval;    ///< Time interval of channel steps
+};
+
+/*!
+ * \ingroup seims_mpi
+ * \class SubbasinResultCache
+ * \brief Results of subbasins cached from a baseline run, i.e., the transferred values to the downstream
+ *        subbasin of each channel step (the outputs of `ModelMain::GetTransferredValue()`) and the raster
+ *        outputs, which are saved to one binary file of each subbasin in the cache folder.
+ *
+ *        For incremental simulation of another BMPs scenario, the subbasins that are unaffected by
+ *        both scenarios and not downstream of any affected subbasin reproduce the baseline results,
+ *        thus they are replayed from the cache rather than simulated.
+ *
+ *        The entries of all subbasins of current rank are created before simulation, and each of them
+ *        is only accessed by the thread that steps the subbasin.
+ *
+ * \code
+ *      // Baseline run
+ *      SubbasinResultCache* cache = new SubbasinResultCache(cache_path, transfer_count, start, end, dt_ch);
+ *      cache->CreateEntry(subbasin_id, affected);
+ *      cache->Record(subbasin_id, cur_time, tf_values); // for each channel step
+ *      cache->Save(subbasin_id, scenario_id, calibration_id, outputs);
+ *      // Incremental run
+ *      if (cache->Load(subbasin_id, calibration_id)) { ... cache->SetReplayed(subbasin_id); }
+ *      cache->GetTransferredValues(subbasin_id, cur_time, tf_values);
+ * \endcode
+ */
+class SubbasinResultCache: NotCopyable {
+public:
+    /*!
+     * \brief Constructor
+     * \param[in] cache_path Directory of cache files, which will be created if not existed
+     * \param[in] transfer_count Number of transferred values of each subbasin
+     * \param[in] start_time Start time of simulation
+     * \param[in] end_time End time of simulation
+     * \param[in] interval Time interval of channel steps
+     */
+    SubbasinResultCache(const string& cache_path, int transfer_count,
+                        time_t start_time, time_t end_time, time_t interval);
+
+    //! Destructor
+    ~SubbasinResultCache();
+
+    //! Create the entry of a subbasin to be recorded by baseline run
+    void CreateEntry(int subbasin_id, bool affected);
+
+    //! Record the transferred values of a channel step, do nothing if no entry
+    void Record(int subbasin_id, time_t cur_time, const float* values);
+
+    /*!
+     * \brief Save the recorded transferred values and the flushed raster outputs of a subbasin
+     * \param[in] subbasin_id Subbasin ID
+     * \param[in] scenario_id BMPs scenario ID
+     * \param[in] calibration_id Calibration ID
+     * \param[in] outputs Output settings, after `ModelMain::Output()`
+     */
+    bool Save(int subbasin_id, int scenario_id, int calibration_id, SettingsOutput* outputs);
+
+    /*!
+     * \brief Load the cached results of a subbasin
+     * \param[in] subbasin_id Subbasin ID
+     * \param[in] calibration_id Calibration ID, which should be the same as the baseline run
+     * \return False if the cache file is not existed or mismatches current simulation
+     */
+    bool Load(int subbasin_id, int calibration_id);
+
+    //! Is the loaded subbasin affected by the BMPs scenario of the baseline run
+    bool IsBaselineAffected(int subbasin_id);
+
+    //! Replay the loaded subbasin rather than simulating it
+    void SetReplayed(int subbasin_id);
+
+    //! Is the subbasin replayed from cache
+    bool IsReplayed(int subbasin_id) const;
+
+    //! Copy the cached transferred values of a channel step of the replayed subbasin
+    bool GetTransferredValues(int subbasin_id, time_t cur_time, float* values);
+
+    //! Core names of the cached raster outputs of the subbasin
+    void GetRasterNames(int subbasin_id, vector<string>& corenames);
+
+    /*!
+     * \brief Cached raster output of the subbasin
+     * \param[in] subbasin_id Subbasin ID
+     * \param[in] corename Core name of the flushed output item, i.e., appended by aggregation type
+     * \param[out] n_cells Cells number
+     * \param[out] n_lyrs Layers number
+     * \return Values ordered by cells, nullptr if not existed
+     */
+    const float* GetRasterData(int subbasin_id, const string& corename, int* n_cells, int* n_lyrs);
+
+private:
+    /*!
+     * \brief Raster output of a subbasin
+     */
+    struct RasterEntry {
+        string corename;        ///< Core name of output item
+        int n_cells;            ///< Cells number
+        int n_lyrs;             ///< Layers number
+        vector<float> values;   ///< Values ordered by cells
+    };
+
+    /*!
+     * \brief Results of a subbasin
+     */
+    struct Entry {
+        bool affected;               ///< Is affected by the BMPs scenario of the baseline run
+        bool replayed;               ///< Is replayed from cache by incremental run
+        vector<float> tf_values;     ///< Transferred values of all channel steps
+        vector<RasterEntry> rasters; ///< Raster outputs
+    };
+
+    //! Cache file name of the subbasin
+    string CacheFile(int subbasin_id) const;
+
+    //! Index of channel step
+    int StepIndex(time_t cur_time) const;
+
+private:
+    string cache_path_;       ///< Directory of cache files
+    int n_values_;            ///< Number of transferred values of each subbasin
+    int n_steps_;             ///< Number of channel steps
+    time_t start_time_;       ///< Start time of simulation
+    time_t interval_;         ///< Time interval of channel steps
+    map<int, Entry *> entries_; ///< Subbasin ID -> Results
+};
+
+#endif /* SEIMS_MPI_SUBBASIN_RESULT_CACHE_H */
@@ -1,4 +1,7 @@
 #include "TaskInformation.h"
+
+#include <algorithm>
+
 #include "utils_array.h"
 #include "parallel.h"
 #include "Logging.h"
@@ -6,10 +9,27 @@
 using namespace ccgl::utils_array;
 using std::make_pair;
 
+namespace {
+/*!
+ * \brief Compare subbasins by the descending priorities, and the ascending IDs if equal
+ */
+class PriorityGreater {
+public:
+    explicit PriorityGreater(const map<int, double>& priorities) : priorities_(priorities) {}
+    bool operator()(const int a, const int b) const {
+        double pa = priorities_.at(a);
+        double pb = priorities_.at(b);
+        return pa != pb ? pa > pb : a < b;
+    }
+private:
+    const map<int, double>& priorities_;
+};
+} /* namespace */
+
 TaskInfo::TaskInfo(const int size, const int rank):
     max_len(-1), subbsn_count(-1), subbsn_id(nullptr),
     lyr_id(nullptr), down_id(nullptr), up_count(nullptr),
-    up_ids(nullptr), size_(size),
+    up_ids(nullptr), priority(nullptr), size_(size),
     rank_(rank), subbsn_count_rank_(nullptr), max_lyr_(-1), max_lyr_all_(-1) {
 
 }
@@ -20,6 +40,7 @@ TaskInfo::~TaskInfo() {
     if (down_id != nullptr) Release1DArray(down_id);
     if (up_count != nullptr) Release1DArray(up_count);
     if (up_ids != nullptr) Release1DArray(up_ids);
+    if (priority != nullptr) Release1DArray(priority);
     if (subbsn_count_rank_ != nullptr) Release1DArray(subbsn_count_rank_);
     for (auto it = subbsn_tfvalues_.begin(); it != subbsn_tfvalues_.end(); ++it) {
         for (auto it2 = it->second.begin(); it2 != it->second.end(); ++it2) {
@@ -124,6 +145,22 @@ bool TaskInfo::Build() {
             nonsrclyr_subbsns_[stream_order].emplace_back(sub_id);
         }
     }
+    /// The same-layer subbasins with higher priorities are executed first
+    if (nullptr != priority) {
+        for (int i = 0; i < subbsn_count_rank_[rank_]; i++) {
+            priorities_[subbsn_id[rank_ * max_len + i]] = priority[rank_ * max_len + i];
+        }
+        PriorityGreater greater(priorities_);
+        for (auto it = lyr_subbsns_.begin(); it != lyr_subbsns_.end(); ++it) {
+            std::sort(it->second.begin(), it->second.end(), greater);
+        }
+        for (auto it = srclyr_subbsns_.begin(); it != srclyr_subbsns_.end(); ++it) {
+            std::sort(it->second.begin(), it->second.end(), greater);
+        }
+        for (auto it = nonsrclyr_subbsns_.begin(); it != nonsrclyr_subbsns_.end(); ++it) {
+            std::sort(it->second.begin(), it->second.end(), greater);
+        }
+    }
 
     CLOG(TRACE, LOG_INIT) << "Rank: " << rank_ << ", Source subbasins: ";
     for (auto it = srclyr_subbsns_.begin(); it != srclyr_subbsns_.end(); ++it) {
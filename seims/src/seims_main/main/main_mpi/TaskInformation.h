@@ -4,6 +4,8 @@
  *
  * Changelog:
  *   - 1. 2018-06-12 - lj - Initial implementation.
+ *   - 2. 2026-10-19 - lj - Order the same-layer subbasins of current rank by execution priorities.
+ *   - 3. 2026-10-19 - lj - Keep the execution priorities of subbasins in current rank.
  *
  * \author Liangjun Zhu
  */
@@ -50,7 +52,10 @@ public:
     map<int, int>& GetSubbasinLayer() { return subbsn_layer_; }
     map<int, int>& GetDownstreamID() { return downstream_; }
     map<int, vector<int> >& GetUpstreamIDs() { return upstreams_; }
+    /// Execution priorities of subbasins in current rank, empty if not available
+    map<int, double>& GetSubbasinPriority() { return priorities_; }
     map<int, bool>& GetUpstreamsInRank() { return upstreams_inrank_; }
+    /// Subbasins of each layer of current rank, ordered by the descending priorities if available
     map<int, vector<int> >& GetLayerSubbasinIDs() { return lyr_subbsns_; }
     map<int, vector<int> >& GetSourceLayerSubbasinIDs() { return srclyr_subbsns_; }
     map<int, vector<int> >& GetNonSourceLayerSubbasinIDs() { return nonsrclyr_subbsns_; }
@@ -64,6 +69,7 @@ public:
     int* down_id;     ///< Down stream subbasin ID of each subbasin, length: max_len * size_
     int* up_count;    ///< Upstream subbasin numbers of each subbasin, length: max_len * size_
     int* up_ids;      ///< Upstream subbasin IDs of each subbasin, length: max_len * size_ * MAX_UPSTREAM
+    double* priority; ///< Execution priority of each subbasin, length: max_len * size_, nullptr if not used
 
 private:
     int size_;                   ///< Number of process
@@ -97,6 +103,11 @@ private:
      * Value: true or false
      */
     map<int, bool> upstreams_inrank_;
+    /*! Execution priorities of subbasins in current rank, see TaskOrderMethod
+     * Key: Subbasin ID of the whole basin
+     * Value: Priority, the higher the earlier
+     */
+    map<int, double> priorities_;
     /*! Subbasins of each layer of current rank
      * Key: Layering ID
      * Value: Source subbasin IDs in current rank
@@ -0,0 +1,239 @@
+#include "TransferExchange.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "utils_string.h"
+#include "text.h"
+#include "Logging.h"
+
+using namespace utils_string;
+using std::make_pair;
+using std::pair;
+
+TransferExchange::TransferExchange(const int rank, const int transfer_count, TaskInfo* task_info) :
+    rank_(rank), n_values_(transfer_count) {
+    map<int, int>& subbasin_rank = task_info->GetSubbasinRank();
+    map<int, int>& subbasin_layer = task_info->GetSubbasinLayer();
+    map<int, int>& downstream = task_info->GetDownstreamID();
+    map<int, vector<int> >& upstreams = task_info->GetUpstreamIDs();
+    vector<int>& rank_subbsn_ids = task_info->GetRankSubbasinIDs();
+    /// Subbasins of messages, the key is (layer of the sending subbasins, peer rank)
+    map<pair<int, int>, vector<int> > send_ids;
+    map<pair<int, int>, vector<int> > recv_ids;
+    map<pair<int, int>, int> recv_first_lyr; ///< The first layer of current rank requires the message
+    for (auto it_id = rank_subbsn_ids.begin(); it_id != rank_subbsn_ids.end(); ++it_id) {
+        int down_id = downstream.at(*it_id);
+        if (down_id > 0 && subbasin_rank.at(down_id) != rank_) {
+            send_ids[make_pair(subbasin_layer.at(*it_id), subbasin_rank.at(down_id))].push_back(*it_id);
+        }
+        auto it_ups = upstreams.find(*it_id);
+        if (it_ups == upstreams.end()) { continue; }
+        int cur_lyr = subbasin_layer.at(*it_id);
+        for (auto it_up = it_ups->second.begin(); it_up != it_ups->second.end(); ++it_up) {
+            int up_rank = subbasin_rank.at(*it_up);
+            if (up_rank == rank_) { continue; }
+            pair<int, int> key = make_pair(subbasin_layer.at(*it_up), up_rank);
+            recv_ids[key].push_back(*it_up);
+            auto it_first = recv_first_lyr.find(key);
+            if (it_first == recv_first_lyr.end() || it_first->second > cur_lyr) {
+                recv_first_lyr[key] = cur_lyr;
+            }
+        }
+    }
+    /// Both sides sort the subbasins of a message by ID, thus the layouts are identical
+    for (auto it = send_ids.begin(); it != send_ids.end(); ++it) {
+        sort(it->second.begin(), it->second.end());
+        Message* msg = CreateMessage(it->first.second, it->first.first, it->second, rank_);
+        float* values = MessageValues(msg);
+        for (size_t i = 0; i < msg->ids.size(); i++) {
+            send_slots_[msg->ids[i]] = values + i * n_values_;
+            send_msg_of_[msg->ids[i]] = msg;
+        }
+        send_msgs_by_lyr_[msg->layer].push_back(msg);
+        send_msgs_.push_back(msg);
+    }
+    for (auto it = recv_ids.begin(); it != recv_ids.end(); ++it) {
+        sort(it->second.begin(), it->second.end());
+        Message* msg = CreateMessage(it->first.second, it->first.first, it->second, it->first.second);
+        recv_plan_[recv_first_lyr.at(it->first)].push_back(msg);
+        recv_msgs_.push_back(msg);
+    }
+    recv_requests_.resize(recv_msgs_.size(), MPI_REQUEST_NULL);
+    recv_done_.resize(recv_msgs_.size(), -1);
+    CLOG(TRACE, LOG_INIT) << "Rank: " << rank_ << ", transfer messages of each simulation loop, send: "
+            << send_msgs_.size() << " (subbasins: " << send_slots_.size() << "), receive: "
+            << recv_msgs_.size();
+}
+
+TransferExchange::~TransferExchange() {
+    WaitAll();
+    for (auto it = send_msgs_.begin(); it != send_msgs_.end(); ++it) {
+        delete *it;
+    }
+    for (auto it = recv_msgs_.begin(); it != recv_msgs_.end(); ++it) {
+        delete *it;
+    }
+    send_msgs_.clear();
+    recv_msgs_.clear();
+}
+
+float* TransferExchange::GetSendValues(const int subbasin_id) {
+    auto it = send_slots_.find(subbasin_id);
+    if (it == send_slots_.end()) { return nullptr; }
+    return it->second;
+}
+
+void TransferExchange::WaitSends(const int layer) {
+    auto it = send_msgs_by_lyr_.find(layer);
+    if (it == send_msgs_by_lyr_.end()) { return; }
+    for (auto it_msg = it->second.begin(); it_msg != it->second.end(); ++it_msg) {
+        MPI_Wait(&(*it_msg)->request, MPI_STATUS_IGNORE);
+    }
+}
+
+void TransferExchange::Receive(const int layer, const int sim_loop, map<int, float *>& recv_values) {
+    auto it = recv_plan_.find(layer);
+    if (it == recv_plan_.end()) { return; }
+    vector<Message *>& msgs = it->second;
+    vector<MPI_Request> requests(msgs.size(), MPI_REQUEST_NULL);
+    for (size_t i = 0; i < msgs.size(); i++) {
+        MPI_Irecv(&msgs[i]->buf[0], CVT_INT(msgs[i]->buf.size()), MPI_BYTE, msgs[i]->peer,
+                  MessageTag(msgs[i]->layer, sim_loop), MCW, &requests[i]);
+    }
+    MPI_Waitall(CVT_INT(requests.size()), &requests[0], MPI_STATUSES_IGNORE);
+    for (auto it_msg = msgs.begin(); it_msg != msgs.end(); ++it_msg) {
+        Unpack(*it_msg, sim_loop, recv_values);
+    }
+}
+
+void TransferExchange::Send(const int layer, const int sim_loop) {
+    auto it = send_msgs_by_lyr_.find(layer);
+    if (it == send_msgs_by_lyr_.end()) { return; }
+    for (auto it_msg = it->second.begin(); it_msg != it->second.end(); ++it_msg) {
+        Message* msg = *it_msg;
+        reinterpret_cast<TransferMsgHeader*>(&msg->buf[0])->sim_loop = sim_loop;
+        MPI_Isend(&msg->buf[0], CVT_INT(msg->buf.size()), MPI_BYTE, msg->peer,
+                  MessageTag(layer, sim_loop), MCW, &msg->request);
+    }
+}
+
+void TransferExchange::WaitAll() {
+    for (auto it = send_msgs_.begin(); it != send_msgs_.end(); ++it) {
+        MPI_Wait(&(*it)->request, MPI_STATUS_IGNORE);
+    }
+}
+
+void TransferExchange::StartStep(const int sim_loop) {
+    WaitAll();
+    for (auto it = send_msgs_.begin(); it != send_msgs_.end(); ++it) {
+        (*it)->unfilled.store(CVT_INT((*it)->ids.size()), std::memory_order_relaxed);
+        (*it)->sent = false;
+    }
+    for (size_t i = 0; i < recv_msgs_.size(); i++) {
+        MPI_Irecv(&recv_msgs_[i]->buf[0], CVT_INT(recv_msgs_[i]->buf.size()), MPI_BYTE, recv_msgs_[i]->peer,
+                  MessageTag(recv_msgs_[i]->layer, sim_loop), MCW, &recv_requests_[i]);
+    }
+}
+
+void TransferExchange::Fill(const int subbasin_id) {
+    auto it = send_msg_of_.find(subbasin_id);
+    if (it == send_msg_of_.end()) { return; }
+    // Release the filled values to the thread sending the message
+    it->second->unfilled.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+int TransferExchange::SendFilled(const int sim_loop) {
+    int n_unsent = 0;
+    for (auto it = send_msgs_.begin(); it != send_msgs_.end(); ++it) {
+        Message* msg = *it;
+        if (msg->sent) { continue; }
+        if (msg->unfilled.load(std::memory_order_acquire) > 0) {
+            n_unsent++;
+            continue;
+        }
+        reinterpret_cast<TransferMsgHeader*>(&msg->buf[0])->sim_loop = sim_loop;
+        MPI_Isend(&msg->buf[0], CVT_INT(msg->buf.size()), MPI_BYTE, msg->peer,
+                  MessageTag(msg->layer, sim_loop), MCW, &msg->request);
+        msg->sent = true;
+    }
+    return n_unsent;
+}
+
+int TransferExchange::TestReceives(const int sim_loop, map<int, float *>& recv_values, const bool wait,
+                                   vector<int>& arrived) {
+    arrived.clear();
+    if (recv_requests_.empty()) { return 0; }
+    int n_done = 0;
+    if (wait) {
+        MPI_Waitsome(CVT_INT(recv_requests_.size()), &recv_requests_[0], &n_done, &recv_done_[0],
+                     MPI_STATUSES_IGNORE);
+    } else {
+        MPI_Testsome(CVT_INT(recv_requests_.size()), &recv_requests_[0], &n_done, &recv_done_[0],
+                     MPI_STATUSES_IGNORE);
+    }
+    if (n_done == MPI_UNDEFINED) { return 0; } // No pending receives
+    for (int i = 0; i < n_done; i++) {
+        Message* msg = recv_msgs_[recv_done_[i]];
+        Unpack(msg, sim_loop, recv_values);
+        arrived.insert(arrived.end(), msg->ids.begin(), msg->ids.end());
+    }
+    int n_pending = 0;
+    for (auto it = recv_requests_.begin(); it != recv_requests_.end(); ++it) {
+        if (*it != MPI_REQUEST_NULL) { n_pending++; }
+    }
+    return n_pending;
+}
+
+TransferExchange::Message* TransferExchange::CreateMessage(const int peer, const int layer,
+                                                           const vector<int>& ids, const int src_rank) {
+    Message* msg = new Message();
+    msg->peer = peer;
+    msg->layer = layer;
+    msg->ids = ids;
+    msg->request = MPI_REQUEST_NULL;
+    msg->unfilled.store(CVT_INT(ids.size()));
+    msg->sent = false;
+    msg->buf.resize(sizeof(TransferMsgHeader) + ids.size() * sizeof(int) +
+                    ids.size() * n_values_ * sizeof(float), 0);
+    TransferMsgHeader* header = reinterpret_cast<TransferMsgHeader*>(&msg->buf[0]);
+    header->version = TRANSFER_MSG_VERSION;
+    header->src_rank = src_rank;
+    header->src_layer = layer;
+    header->sim_loop = 0;
+    header->n_entries = CVT_INT(ids.size());
+    header->n_values = n_values_;
+    memcpy(header + 1, &ids[0], ids.size() * sizeof(int));
+    return msg;
+}
+
+float* TransferExchange::MessageValues(Message* msg) {
+    return reinterpret_cast<float*>(&msg->buf[0] + sizeof(TransferMsgHeader) + msg->ids.size() * sizeof(int));
+}
+
+void TransferExchange::Unpack(Message* msg, const int sim_loop, map<int, float *>& recv_values) {
+    TransferMsgHeader* header = reinterpret_cast<TransferMsgHeader*>(&msg->buf[0]);
+    int n_entries = CVT_INT(msg->ids.size());
+    if (header->version != TRANSFER_MSG_VERSION) {
+        throw ModelException("TransferExchange", "Receive",
+                             "Unsupported version " + itoa(header->version) +
+                             " of transfer message from rank " + itoa(msg->peer));
+    }
+    const int* ids = reinterpret_cast<const int*>(header + 1);
+    if (header->src_rank != msg->peer || header->src_layer != msg->layer ||
+        header->sim_loop != sim_loop || header->n_entries != n_entries ||
+        header->n_values != n_values_ ||
+        !std::equal(msg->ids.begin(), msg->ids.end(), ids)) {
+        throw ModelException("TransferExchange", "Receive",
+                             "Mismatched transfer message of layer " + itoa(msg->layer) +
+                             " from rank " + itoa(msg->peer));
+    }
+    const float* values = MessageValues(msg);
+    for (int i = 0; i < n_entries; i++) {
+        std::copy(values + i * n_values_, values + (i + 1) * n_values_, recv_values.at(ids[i]));
+    }
+}
+
+int TransferExchange::MessageTag(const int layer, const int sim_loop) {
+    return layer * 10000 + sim_loop;
+}
@@ -0,0 +1,179 @@
+/*!
+ * \file TransferExchange.h
+ * \brief Exchange transferred values of subbasins across ranks by aggregated messages.
+ *
+ * Changelog:
+ *   - 1. 2026-10-19  - lj -  Initial implementation.
+ *   - 2. 2026-10-19  - lj -  Send and receive messages once ready for the ready-driven execution of subbasins.
+ *
+ * \author Liangjun Zhu
+ */
+#ifndef SEIMS_MPI_TRANSFER_EXCHANGE_H
+#define SEIMS_MPI_TRANSFER_EXCHANGE_H
+
+#include <atomic>
+
+#include "parallel.h"
+#include "TaskInformation.h"
+
+/// Version of the layout of transfer messages, which should be increased once the layout changed
+#define TRANSFER_MSG_VERSION 1
+
+/*!
+ * \ingroup seims_mpi
+ * \struct TransferMsgHeader
+ * \brief Header of a transfer message, followed by `n_entries` subbasin IDs (int)
+ *        and `n_entries * n_values` transferred values (float) ordered by subbasins.
+ */
+struct TransferMsgHeader {
+    int version;   ///< Layout version, i.e., TRANSFER_MSG_VERSION
+    int src_rank;  ///< Rank of the sender
+    int src_layer; ///< Routing layer of the sending subbasins
+    int sim_loop;  ///< Simulation loop number, i.e., stamp of transferred values
+    int n_entries; ///< Number of subbasins
+    int n_values;  ///< Number of transferred values of each subbasin
+};
+
+/*!
+ * \ingroup seims_mpi
+ * \class TransferExchange
+ * \brief Exchange transferred values between upstream and downstream subbasins of different ranks.
+ *
+ *        All values of the same routing layer to be sent to the same rank are packed into one message,
+ *        which is received once and unpacked into the received transferred values of the downstream
+ *        subbasins. The subbasins of each message are determined by the task information on both sides,
+ *        thus the message buffers are allocated once and the slots of values are fixed, which could be
+ *        filled by the concurrent subbasins of a layer without lock.
+ *
+ *        All MPI calls are made by the calling thread outside of the concurrent stepping of subbasins.
+ *
+ * \code
+ *      TransferExchange* exchange = new TransferExchange(rank, transfer_count, task_info);
+ *      // for each layer of each time step
+ *      exchange->WaitSends(ilyr);                               // Slots of the layer are writable
+ *      exchange->Receive(ilyr, sim_loop, recv_tf_values.at(sim_loop));
+ *      // step subbasins of the layer, e.g., concurrently
+ *      psubbasin->GetTransferredValue(exchange->GetSendValues(subbasin_id));
+ *      exchange->Send(ilyr, sim_loop);
+ *      ...
+ *      delete exchange; // Wait all pending sends
+ * \endcode
+ *
+ *        Alternatively, the subbasins of a time step could be executed once ready rather than layer by layer,
+ *        in which the messages are sent once all slots are filled, and received in any order.
+ *
+ * \code
+ *      exchange->StartStep(sim_loop);                           // Post receives of the time step
+ *      // step subbasins once ready, e.g., concurrently
+ *      psubbasin->GetTransferredValue(exchange->GetSendValues(subbasin_id));
+ *      exchange->Fill(subbasin_id);                             // Thread-safe
+ *      // by the calling thread only
+ *      exchange->SendFilled(sim_loop);
+ *      exchange->TestReceives(sim_loop, recv_tf_values.at(sim_loop), false, arrived_ids);
+ * \endcode
+ */
+class TransferExchange: NotCopyable {
+public:
+    /*!
+     * \brief Constructor, build the layouts of messages to be sent and received
+     * \param[in] rank Rank number
+     * \param[in] transfer_count Number of transferred values of each subbasin
+     * \param[in] task_info Task information which has been built
+     */
+    TransferExchange(int rank, int transfer_count, TaskInfo* task_info);
+
+    //! Destructor, wait all pending sends
+    ~TransferExchange();
+
+    /*!
+     * \brief Slot of transferred values of the subbasin whose downstream is in another rank
+     * \return nullptr if the downstream is in current rank or no downstream
+     */
+    float* GetSendValues(int subbasin_id);
+
+    //! Wait the pending sends of the layer, thus its slots could be refilled
+    void WaitSends(int layer);
+
+    /*!
+     * \brief Receive the messages firstly required by the subbasins of the layer
+     * \param[in] layer Routing layer of current rank
+     * \param[in] sim_loop Simulation loop number
+     * \param[out] recv_values Received transferred values of upstream subbasins of the simulation loop
+     */
+    void Receive(int layer, int sim_loop, map<int, float *>& recv_values);
+
+    //! Send the packed messages of the layer
+    void Send(int layer, int sim_loop);
+
+    //! Wait all pending sends
+    void WaitAll();
+
+    /*!
+     * \brief Start a time step of the ready-driven execution, i.e., wait the sends of the previous
+     *        time step thus all slots could be refilled, and post the receives of all messages
+     * \param[in] sim_loop Simulation loop number
+     */
+    void StartStep(int sim_loop);
+
+    //! The slot of the subbasin is filled, which can be called by concurrent threads
+    void Fill(int subbasin_id);
+
+    /*!
+     * \brief Send the messages whose slots are all filled but not sent yet in current time step
+     * \return Number of messages not sent yet
+     */
+    int SendFilled(int sim_loop);
+
+    /*!
+     * \brief Test the posted receives, and unpack the arrived messages
+     * \param[in] sim_loop Simulation loop number
+     * \param[out] recv_values Received transferred values of upstream subbasins of the simulation loop
+     * \param[in] wait Wait until at least one message arrives if any receive is pending
+     * \param[out] arrived Upstream subbasin IDs of the arrived messages
+     * \return Number of pending receives
+     */
+    int TestReceives(int sim_loop, map<int, float *>& recv_values, bool wait, vector<int>& arrived);
+
+    //! Number of messages sent by current rank in each simulation loop
+    int GetSendMessageCount() const { return CVT_INT(send_msgs_.size()); }
+
+private:
+    /*!
+     * \brief Message of a routing layer between current rank and a peer rank
+     */
+    struct Message {
+        int peer;               ///< Destination rank for sending or source rank for receiving
+        int layer;              ///< Routing layer of the sending subbasins
+        vector<int> ids;        ///< Subbasin IDs in ascending order
+        vector<char> buf;       ///< Packed header, IDs, and values
+        MPI_Request request;    ///< Request of the pending send
+        std::atomic<int> unfilled; ///< Number of slots not filled in current time step, ready-driven only
+        bool sent;              ///< Has been sent in current time step, ready-driven only
+    };
+
+    //! Create a message and write header and IDs into buffer
+    Message* CreateMessage(int peer, int layer, const vector<int>& ids, int src_rank);
+
+    //! Values of the message
+    float* MessageValues(Message* msg);
+
+    //! Check the received message and copy its values to the received transferred values
+    void Unpack(Message* msg, int sim_loop, map<int, float *>& recv_values);
+
+    //! Tag of messages, unique for each layer of each simulation loop
+    static int MessageTag(int layer, int sim_loop);
+
+private:
+    int rank_;                                  ///< Rank number
+    int n_values_;                              ///< Number of transferred values of each subbasin
+    map<int, vector<Message *> > send_msgs_by_lyr_; ///< Messages to be sent of each layer of current rank
+    vector<Message *> send_msgs_;               ///< All messages to be sent
+    map<int, vector<Message *> > recv_plan_;    ///< Messages firstly required by each layer of current rank
+    vector<Message *> recv_msgs_;               ///< All messages to be received
+    map<int, float *> send_slots_;              ///< Subbasin ID -> Slot of values in the message buffer
+    map<int, Message *> send_msg_of_;           ///< Subbasin ID -> Message to be sent
+    vector<MPI_Request> recv_requests_;         ///< Requests of all messages to be received, ready-driven only
+    vector<int> recv_done_;                     ///< Indexes of the completed receives, ready-driven only
+};
+
+#endif /* SEIMS_MPI_TRANSFER_EXCHANGE_H */
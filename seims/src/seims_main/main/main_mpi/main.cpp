@@ -8,6 +8,7 @@
 #include "parallel.h"
 #include "CalculateProcess.h"
 #include "Logging.h"
+#include "Tracing.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -43,6 +44,8 @@ int main(int argc, const char** argv) {
     char hostname[MPI_MAX_PROCESSOR_NAME];
 
     int provided;
+    // Multiple threads are used to execute the same-layer subbasins of each rank concurrently,
+    //   whereas the MPI calls are only made by the master thread. See CalculateProcess().
     MPI_Init_thread(NULL, NULL, MPI_THREAD_FUNNELED, &provided);
     if (provided < MPI_THREAD_FUNNELED) {
         cout << "Not a high enough level of thread support!" << endl;
@@ -65,8 +68,18 @@ int main(int argc, const char** argv) {
                                       ValueToString(rank) + ".log");
         }
         Logging::setLogLevel(Logging::getLLfromString(input_args->log_level), nullptr);
+        /// Write the messages of SLOG/SCLOG, e.g., of modules, by a background thread
+        Logging::startAsync();
+        /// Initialize timeline tracing of each rank, disabled by default
+        Tracer::Init(input_args->output_path + SEP + input_args->output_scene + "-mpi-rank" +
+                     ValueToString(rank) + ".trace", rank, input_args->trace_capacity,
+                     input_args->thread_num);
 
         LOG(INFO) << "Process " << rank << " out of " << size << " running on " << hostname;
+        if (rank == 0 && !input_args->local_path.empty()) {
+            LOG(WARNING) << "Local data is not supported by the MPI version yet, "
+                    "MongoDB will be used.";
+        }
 
         try {
             if (conn2mongo == 1) {
@@ -75,18 +88,27 @@ int main(int argc, const char** argv) {
                 CalculateProcess(input_args, rank, size, mongoc_pool);
             }
         } catch (ModelException& e) {
+            // Keep the trace of this rank before aborting, which is useful to locate the failure
+            Tracer::Flush();
+            Logging::stopAsync();
             LOG(ERROR) << e.what();
             MPI_Abort(MCW, 3);
         }
         catch (std::exception& e) {
+            Tracer::Flush();
+            Logging::stopAsync();
             LOG(ERROR) << e.what();
             MPI_Abort(MCW, 4);
         }
         catch (...) {
+            Tracer::Flush();
+            Logging::stopAsync();
             LOG(ERROR) << "Unknown exception occurred!";
             MPI_Abort(MCW, 5);
         }
         MPI_Barrier(MCW);
+        Tracer::Flush();
+        Logging::stopAsync();
         el::Loggers::flushAll();
     }
     /// Finalize the MPI environment
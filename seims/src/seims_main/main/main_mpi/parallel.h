@@ -4,6 +4,7 @@
  *
  * Changelog:
  *   - 1. 2018-05-31 - lj - Separate the original header to headers by functionality.
+ *   - 2. 2026-10-19 - lj - Remove MSG_LEN, transfer messages are described by TransferMsgHeader.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
@@ -21,7 +22,6 @@
 #define MASTER_RANK 0
 #define SLAVE0_RANK 1 ///< Rank of this slave processor in SlaveGroup is 0
 #define MAX_UPSTREAM 4
-#define MSG_LEN 5
 #define MCW MPI_COMM_WORLD
 
 #endif /* SEIMS_MPI_PARALLEL_BASIC_H */
@@ -3,10 +3,11 @@
 #include "utils_time.h"
 #include "text.h"
 #include "Logging.h"
+#include "Tracing.h"
 
 using namespace ccgl::utils_time;
 
-ModelMain::ModelMain(DataCenterMongoDB* data_center, ModuleFactory* factory) :
+ModelMain::ModelMain(DataCenter* data_center, ModuleFactory* factory) :
     m_dataCenter(data_center), m_factory(factory), m_readFileTime(0.),
     m_firstRunOverland(true), m_firstRunChannel(true) {
     /// Get SettingInput and SettingOutput
@@ -46,7 +47,10 @@ ModelMain::ModelMain(DataCenterMongoDB* data_center, ModuleFactory* factory) :
     int n = CVT_INT(m_simulationModules.size());
     m_executeTime.resize(n, 0.);
     for (int i = 0; i < n; i++) {
+        m_traceNameIDs.emplace_back(Tracer::RegisterName(m_factory->GetModuleID(i)));
         SimulationModule* p_module = m_simulationModules[i];
+        p_module->SetActiveCellsMode(m_dataCenter->GetActiveCellsMode());
+        if (m_dataCenter->GetActiveCellsMode() != ACTIVE_CELLS_OFF) { p_module->SetActiveCells(&m_activeCells); }
         switch (p_module->GetTimeStepType()) {
             case TIMESTEP_HILLSLOPE: {
                 m_hillslopeModules.emplace_back(i);
@@ -63,6 +67,7 @@ ModelMain::ModelMain(DataCenterMongoDB* data_center, ModuleFactory* factory) :
             default: break;
         }
     }
+    InitializeCalendar();
     /// Check the validation of settings of output files, i.e. available of parameter and time ranges
     CheckAvailableOutput();
     /// Update model data if the scenario has requested.
@@ -70,15 +75,36 @@ ModelMain::ModelMain(DataCenterMongoDB* data_center, ModuleFactory* factory) :
     m_dataCenter->UpdateScenarioParametersStable(m_dataCenter->GetSubbasinID());
 }
 
+void ModelMain::InitializeCalendar() {
+    string lat_name = ValueToString(m_dataCenter->GetSubbasinID()) + "_" + VAR_CELL_LAT[0];
+    map<string, FloatRaster*>& rs_map = m_dataCenter->GetRasterDataMap();
+    for (auto it = rs_map.begin(); it != rs_map.end(); ++it) {
+        if (!StringMatch(it->first, lat_name) || nullptr == it->second || it->second->Is2DRaster()) {
+            continue;
+        }
+        int n = -1;
+        FLTPT* lats = nullptr;
+        if (it->second->GetRasterData(&n, &lats)) {
+            m_calendar.SetLatitudes(n, lats);
+            LOG(DEBUG) << "Latitude bands of the calendar: " << m_calendar.GetBandNumber();
+        }
+        break;
+    }
+}
+
 void ModelMain::StepHillSlope(const time_t t, const int year_idx, const int sub_index) {
     m_dataCenter->UpdateInput(m_simulationModules, t);
     if (m_hillslopeModules.empty()) { return; }
+    m_calendar.Update(t, year_idx);
     for (auto it = m_hillslopeModules.begin(); it != m_hillslopeModules.end(); ++it) {
-        m_simulationModules[*it]->SetDate(t, year_idx);
+        m_simulationModules[*it]->SetCalendar(&m_calendar);
     }
+    // The active cells are evaluated by the first module that refreshes them in this step
+    m_activeCells.NextStep();
     for (auto it = m_hillslopeModules.begin(); it != m_hillslopeModules.end(); ++it) {
         SimulationModule* p_module = m_simulationModules[*it];
         //cout << "Executing hillslope " << m_moduleIDs[*it] << "timestep " << t << endl; // for debug
+        TraceSpan span(TRACE_MODULE, m_traceNameIDs[*it], t, m_dataCenter->GetSubbasinID());
         double sub_t1 = TimeCounting();
         if (m_firstRunOverland) {
             m_factory->GetValueFromDependencyModule(*it, m_simulationModules);
@@ -96,14 +122,16 @@ void ModelMain::StepHillSlope(const time_t t, const int year_idx, const int sub_
 
 void ModelMain::StepChannel(const time_t t, const int year_idx) {
     if (m_channelModules.empty()) { return; }
+    m_calendar.Update(t, year_idx);
     for (auto it = m_channelModules.begin(); it != m_channelModules.end(); ++it) {
-        m_simulationModules[*it]->SetDate(t, year_idx);
+        m_simulationModules[*it]->SetCalendar(&m_calendar);
     }
     for (auto it = m_channelModules.begin(); it != m_channelModules.end(); ++it) {
         SimulationModule* p_module = m_simulationModules[*it];
         if (m_firstRunChannel) {
             m_factory->GetValueFromDependencyModule(*it, m_simulationModules);
         }
+        TraceSpan span(TRACE_MODULE, m_traceNameIDs[*it], t, m_dataCenter->GetSubbasinID());
         double sub_t1 = TimeCounting();
         p_module->Execute();
         double sub_t2 = TimeCounting();
@@ -119,6 +147,7 @@ void ModelMain::StepOverall(time_t start_t, time_t end_t) {
     for (size_t i = 0; i < m_overallModules.size(); i++) {
         int index = m_overallModules[i];
         SimulationModule* p_module = m_simulationModules[index];
+        TraceSpan span(TRACE_MODULE, m_traceNameIDs[index], end_t, m_dataCenter->GetSubbasinID());
         double sub_t1 = TimeCounting();
         p_module->Execute();
         double sub_t2 = TimeCounting();
@@ -157,9 +186,9 @@ void ModelMain::Execute() {
         }
 
         if (preYearIdx != yearIdx) {
-            LOG(DEBUG) << "Simulation year: " << startYear + yearIdx;
+            SLOG(DEBUG) << "Simulation year: " << startYear + yearIdx;
         }
-        LOG(DEBUG) << ConvertToString2(t);
+        SLOG(DEBUG) << ConvertToString2(t);
         for (int i = 0; i < nHs; i++) {
             StepHillSlope(t + i * m_dtHs, yearIdx, i);
         }
@@ -191,14 +220,14 @@ void ModelMain::SetTransferredValue(const int index, const FLTPT* tfvalues) {
     }
 }
 
-double ModelMain::Output() {
+double ModelMain::Output(const bool out_subbasin_gfs /* = true */) {
     double t1 = TimeCounting();
     //MongoGridFs* gfs = new MongoGridFs(m_dataCenter->GetMongoClient()->GetGridFs(m_dataCenter->GetModelName(),
     //                                                                             DB_TAB_OUT_SPATIAL));
     for (auto it = m_output->m_printInfos.begin(); it != m_output->m_printInfos.end(); ++it) {
         for (auto itemIt = (*it)->m_PrintItems.begin(); itemIt != (*it)->m_PrintItems.end(); ++itemIt) {
             (*itemIt)->Flush(m_outputPath, m_dataCenter->GetMongoGridFsOutput(),
-                             m_maskRaster, (*it)->getOutputTimeSeriesHeader());
+                             m_maskRaster, (*it)->getOutputTimeSeriesHeader(), out_subbasin_gfs);
         }
     }
     //delete gfs;
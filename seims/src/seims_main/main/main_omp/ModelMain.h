@@ -4,6 +4,14 @@
  *
  * Changelog:
  *   - 1. 2017-05-20 - lj - Refactoring. The ModelMain class mainly focuses on the entire workflow.
+ *   - 2. 2026-10-19 - lj - Record timeline trace span of each module execution if tracing is enabled.
+ *   - 3. 2026-10-19 - lj - Independent to the type of DataCenter, e.g., DataCenterMongoDB and DataCenterLocal.
+ *   - 4. 2026-10-19 - lj - Raster outputs of subbasin could be kept in memory for MPI version.
+ *   - 5. 2026-10-19 - lj - Set active-cell tracking mode of modules.
+ *   - 6. 2026-10-19 - lj - Date and solar geometry of each step are shared by modules via SimulationCalendar.
+ *   - 7. 2026-10-19 - lj - Check whether the subbasin can be simulated independently of the others.
+ *   - 8. 2026-10-19 - lj - Format the date of each step only if DEBUG logging is enabled.
+ *   - 9. 2026-10-19 - lj - Active cells are shared by modules and refreshed once per hillslope step.
  *
  * \author Junzhi Liu, LiangJun Zhu
  * \version 2.0
@@ -23,9 +31,7 @@
 // include utility classes and const definition of SEIMS
 #include "seims.h"
 // include data related
-#ifdef USE_MONGODB
-#include "DataCenterMongoDB.h"
-#endif /* USE_MONGODB */
+#include "DataCenter.h"
 #include "SettingsInput.h"
 #include "SettingsOutput.h"
 // include module_setting related
@@ -40,16 +46,19 @@ class ModelMain: Interface {
 public:
     /*!
      * \brief Constructor independent to any database IO, instead of the DataCenter object
-     * \param[in] data_center DataCenter, DataCenterMongoDB, or others in future
+     * \param[in] data_center DataCenter, e.g., DataCenterMongoDB and DataCenterLocal
      * \param[in] factory ModuleFactory, assemble the module workspace
      */
-    ModelMain(DataCenterMongoDB* data_center, ModuleFactory* factory);
+    ModelMain(DataCenter* data_center, ModuleFactory* factory);
 
     //! Execute all the modules, aggregate output data, and write the total time-consuming, etc.
     void Execute();
 
-    //! Write output files, e.g., Q.txt, return time-consuming (s).
-    double Output();
+    /*!
+     * \brief Write output files, e.g., Q.txt, return time-consuming (s).
+     * \param[in] out_subbasin_gfs Optional, write raster data of subbasin to GridFS for MPI version
+     */
+    double Output(bool out_subbasin_gfs = true);
 
     /*!
     * \brief Check whether the validation of outputs
@@ -105,13 +114,25 @@ public:
     double GetReadDataTime() const { return m_readFileTime; }
     //! Include channel processes or not?
     bool IncludeChannelProcesses() { return !m_channelModules.empty(); }
+    /*!
+     * \brief Is the subbasin independent of the others, i.e., no channel processes and no values
+     *        transferred across subbasins (the `transferTypes` of module metadata).
+     *
+     *        The lateral routing within the subbasin (e.g., IKW_OL) does not matter, since the data
+     *        of the whole subbasin are simulated together.
+     */
+    bool IsSubbasinIndependent() const { return m_channelModules.empty() && m_nTFValues == 0; }
+
+private:
+    //! Set latitudes of cells to the calendar if loaded by any module
+    void InitializeCalendar();
 
 private:
     /************************************************************************/
     /*             Input parameters                                         */
     /************************************************************************/
 
-    DataCenterMongoDB* m_dataCenter; ///< inherited DataCenter
+    DataCenter* m_dataCenter; ///< inherited DataCenter
     ModuleFactory* m_factory;        ///< Modules factory
 private:
     /************************************************************************/
@@ -138,6 +159,9 @@ private:
     vector<int> m_channelModules;                   ///< Channel modules index list
     vector<int> m_overallModules;                   ///< Whole simulation scale modules index list
     vector<double> m_executeTime;                   ///< Execute time list of each module
+    vector<int> m_traceNameIDs;                     ///< Trace name ID of each module, see Tracer
+    SimulationCalendar m_calendar;                  ///< Date and solar geometry shared by modules
+    ActiveCells m_activeCells;                      ///< Active cells shared by modules, if tracking is on
 
     int m_nTFValues;                     ///< transferred value inputs cout
     vector<int> m_tfValueFromModuleIdxs; ///< from module index corresponding to each transferred value inputs
@@ -12,7 +12,10 @@
 #include <text.h>
 #include "invoke.h"
 #include "ModelMain.h"
+#include "DataCenterMongoDB.h"
+#include "DataCenterLocal.h"
 #include "Logging.h"
+#include "Tracing.h"
 
 INITIALIZE_EASYLOGGINGPP
 
@@ -26,6 +29,11 @@ int main(const int argc, const char** argv) {
     Logging::init();
     Logging::setLoggingToFile(input_args->output_path + SEP + input_args->output_scene + ".log");
     Logging::setLogLevel(Logging::getLLfromString(input_args->log_level), nullptr);
+    /// Write the messages of SLOG/SCLOG, e.g., of modules, by a background thread
+    Logging::startAsync();
+    /// Initialize timeline tracing, disabled by default
+    Tracer::Init(input_args->output_path + SEP + input_args->output_scene + ".trace",
+                 0, input_args->trace_capacity, input_args->thread_num);
 
     /// Register GDAL
     GDALAllRegister();
@@ -33,29 +41,49 @@ int main(const int argc, const char** argv) {
     /// Run model.
     try {
         double input_t = TimeCounting();
+        double trace_input_t = Tracer::Now();
         /// Get module path
         string module_path = GetAppPath();
-        /// Initialize the MongoDB connection client
-        MongoClient* mongo_client = MongoClient::Init(input_args->host.c_str(), input_args->port);
-        if (nullptr == mongo_client) {
-            throw ModelException("MongoDBClient", "Constructor", "Failed to connect to MongoDB!");
-        }
-        MongoGridFs* spatial_gfs_in = new MongoGridFs(mongo_client->GetGridFs(input_args->model_name, DB_TAB_SPATIAL));
-        MongoGridFs* spatial_gfs_out = new MongoGridFs(mongo_client->GetGridFs(input_args->model_name, DB_TAB_OUT_SPATIAL));
         /// Create module factory
         ModuleFactory* module_factory = ModuleFactory::Init(module_path, input_args);
         if (nullptr == module_factory) {
             throw ModelException("ModuleFactory", "Constructor", "Failed in constructing ModuleFactory!");
         }
+        MongoClient* mongo_client = nullptr;
+        MongoGridFs* spatial_gfs_in = nullptr;
+        MongoGridFs* spatial_gfs_out = nullptr;
+        DataCenter* data_center = nullptr;
         /// Create data center according to subbasin number, 0 means the whole basin which is default for omp version.
-        DataCenterMongoDB* data_center = new DataCenterMongoDB(input_args, mongo_client, spatial_gfs_in, spatial_gfs_out,
-                                                               module_factory, input_args->subbasin_id);
+        if (!input_args->local_path.empty()) {
+            /// Read model data from local files, no MongoDB connection is required
+            data_center = new DataCenterLocal(input_args, module_factory, input_args->subbasin_id);
+        } else {
+            /// Initialize the MongoDB connection client
+            mongo_client = MongoClient::Init(input_args->host.c_str(), input_args->port);
+            if (nullptr == mongo_client) {
+                throw ModelException("MongoDBClient", "Constructor", "Failed to connect to MongoDB!");
+            }
+            spatial_gfs_in = new MongoGridFs(mongo_client->GetGridFs(input_args->model_name, DB_TAB_SPATIAL));
+            spatial_gfs_out = new MongoGridFs(mongo_client->GetGridFs(input_args->model_name, DB_TAB_OUT_SPATIAL));
+            data_center = new DataCenterMongoDB(input_args, mongo_client, spatial_gfs_in, spatial_gfs_out,
+                                                module_factory, input_args->subbasin_id);
+        }
         /// Create SEIMS model by dataCenter and moduleFactory
         ModelMain* model_main = new ModelMain(data_center, module_factory);
         CLOG(INFO, LOG_TIMESPAN) << "[IO  ][Input] " << std::fixed << setprecision(3) << TimeCounting() - input_t;
+        if (Tracer::Enabled()) {
+            Tracer::Record(TRACE_IO, Tracer::RegisterName("Input"), trace_input_t, Tracer::Now(),
+                           0, input_args->subbasin_id);
+        }
         /// Execute model and write outputs
         model_main->Execute();
+        double output_t = Tracer::Now();
         model_main->Output();
+        if (Tracer::Enabled()) {
+            Tracer::Record(TRACE_IO, Tracer::RegisterName("Output"), output_t, Tracer::Now(),
+                           0, input_args->subbasin_id);
+            Tracer::Flush();
+        }
         CLOG(INFO, LOG_TIMESPAN) << "[SIMU][ALL] " << std::fixed << setprecision(3) << TimeCounting() - input_t;
         /// Clean up
         delete model_main;
@@ -63,20 +91,29 @@ int main(const int argc, const char** argv) {
         delete module_factory;
         delete spatial_gfs_in;
         delete spatial_gfs_out;
-        mongo_client->Destroy();
-        delete mongo_client;
+        if (nullptr != mongo_client) {
+            mongo_client->Destroy();
+            delete mongo_client;
+        }
         delete input_args;
+        Logging::stopAsync();
         /// Manually to flush all log files for all levels
         el::Loggers::flushAll();
     } catch (ModelException& e) {
+        Tracer::Flush();
+        Logging::stopAsync();
         LOG(ERROR) << e.ToString();
         exit(EXIT_FAILURE);
     }
     catch (std::exception& e) {
+        Tracer::Flush();
+        Logging::stopAsync();
         LOG(ERROR) << e.what();
         exit(EXIT_FAILURE);
     }
     catch (...) {
+        Tracer::Flush();
+        Logging::stopAsync();
         LOG(ERROR) << "Unknown exception occurred!";
         exit(EXIT_FAILURE);
     }
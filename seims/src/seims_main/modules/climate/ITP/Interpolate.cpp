@@ -7,7 +7,7 @@ Interpolate::Interpolate() :
     m_dataType(0), m_nStations(-1),
     m_stationData(nullptr), m_nCells(-1), m_itpWeights(nullptr), m_itpVertical(false),
     m_hStations(nullptr), m_dem(nullptr), m_lapseRate(nullptr),
-    m_itpOutput(nullptr) {
+    m_itpOutput(nullptr), m_nanLog(SEIMS_LOG_WARNING, "default", 10) {
 }
 
 void Interpolate::SetClimateDataType(const int data_type) {
@@ -41,8 +41,8 @@ int Interpolate::Execute() {
             value += m_stationData[j] * m_itpWeights[i][j];
             if (value != value) {
                 err_count++;
-                cout << "CELL:" << i << ", Site: " << j << ", Weight: " << m_itpWeights[i][j] <<
-                        ", siteData: " << m_stationData[j] << ", Value:" << value << ";" << endl;
+                SLOG_SAMPLED(m_nanLog, m_date) << "ITP: CELL:" << i << ", Site: " << j << ", Weight: "
+                        << m_itpWeights[i][j] << ", siteData: " << m_stationData[j] << ", Value:" << value;
             }
             if (m_itpVertical) {
                 FLTPT delta = m_dem[i] - m_hStations[j];
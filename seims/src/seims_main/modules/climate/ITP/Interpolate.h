@@ -5,6 +5,7 @@
  * Changelog:
  *   - 1. 2018-05-07 - lj - Code reformat.
  *   - 2. 2022-08-18 - lj - Change float to FLTPT.
+ *   - 3. 2026-10-19 - lj - Log the invalid values of cells by sampled warnings instead of cout.
  *
  * \author Junzhi Liu, Liangjun Zhu
  * \date Jan. 2010
@@ -71,5 +72,7 @@ private:
     FLTPT** m_lapseRate;
     /// interpolation result
     FLTPT* m_itpOutput;
+    /// warnings of invalid interpolated values, sampled per time step
+    LogSampler m_nanLog;
 };
 #endif /* SEIMS_MODULE_ITP_H */
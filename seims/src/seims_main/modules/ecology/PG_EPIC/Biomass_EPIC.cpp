@@ -15,18 +15,7 @@ Biomass_EPIC::Biomass_EPIC() :
     m_soilFC(nullptr), m_soilSumFC(nullptr), m_soilSumSat(nullptr), m_soilWtrSto(nullptr),
     m_soilWtrStoPrfl(nullptr), m_rsdInitSoil(nullptr), m_rsdCovSoil(nullptr),
     m_soilRsd(nullptr), m_biomTrgt(nullptr),
-    m_igro(nullptr), m_landCoverCls(nullptr), m_minLaiDorm(nullptr),
-    m_biomEnrgRatio(nullptr),
-    m_biomEnrgRatio2ndPt(nullptr),
-    m_biomDropFr(nullptr), m_maxLai(nullptr), m_maxBiomTree(nullptr),
-    m_biomNFr1(nullptr), m_biomNFr2(nullptr),
-    m_biomNFr3(nullptr), m_biomPFr1(nullptr), m_biomPFr2(nullptr),
-    m_biomPFr3(nullptr), m_maxCanHgt(nullptr), m_co2Conc2ndPt(nullptr), m_dormPHUFr(nullptr),
-    m_epco(nullptr), m_lightExtCoef(nullptr),
-    m_frGrow1stPt(nullptr), m_frGrow2ndPt(nullptr), m_hvstIdx(nullptr),
-    m_frMaxLai1stPt(nullptr), m_frMaxLai2ndPt(nullptr),
-    m_matYrs(nullptr), m_pgTempBase(nullptr),
-    m_pgOptTemp(nullptr), m_wavp(nullptr), m_canHgt(nullptr), m_alb(nullptr),
+    m_igro(nullptr), m_landCoverCls(nullptr), m_co2Conc2ndPt(nullptr), m_canHgt(nullptr), m_alb(nullptr),
     m_curYrMat(nullptr),
     m_initBiom(nullptr), m_initLai(nullptr),
     m_phuPlt(nullptr), m_dormFlag(nullptr), m_totActPltET(nullptr), m_totPltPET(nullptr),
@@ -96,6 +85,12 @@ void Biomass_EPIC::SetValue(const char* key, const FLTPT value) {
 void Biomass_EPIC::Set1DData(const char* key, const int n, FLTPT* data) {
     string sk(key);
     CheckInputSize(M_PG_EPIC[0], key, n, m_nCells);
+    //// plant parameters of crop lookup table
+    ParamRaster1D* plant_param = PlantParameter(sk);
+    if (nullptr != plant_param) {
+        plant_param->Set(data);
+        return;
+    }
     //// climate
     if (StringMatch(sk, VAR_TMEAN[0])) m_meanTemp = data;
     else if (StringMatch(sk, VAR_TMIN[0])) m_minTemp = data;
@@ -118,32 +113,7 @@ void Biomass_EPIC::Set1DData(const char* key, const int n, FLTPT* data) {
     else if (StringMatch(sk, VAR_BIOTARG[0])) m_biomTrgt = data;
     else if (StringMatch(sk, VAR_SNAC[0])) m_snowAccum = data;
     else if (StringMatch(sk, VAR_SOL_RSDIN[0])) m_rsdInitSoil = data;
-    else if (StringMatch(sk, VAR_ALAIMIN[0])) m_minLaiDorm = data;
-    else if (StringMatch(sk, VAR_BIO_E[0])) m_biomEnrgRatio = data;
-    else if (StringMatch(sk, VAR_BIOEHI[0])) m_biomEnrgRatio2ndPt = data;
-    else if (StringMatch(sk, VAR_BIOLEAF[0])) m_biomDropFr = data;
-    else if (StringMatch(sk, VAR_BLAI[0])) m_maxLai = data;
-    else if (StringMatch(sk, VAR_BMX_TREES[0])) m_maxBiomTree = data;
-    else if (StringMatch(sk, VAR_BN1[0])) m_biomNFr1 = data;
-    else if (StringMatch(sk, VAR_BN2[0])) m_biomNFr2 = data;
-    else if (StringMatch(sk, VAR_BN3[0])) m_biomNFr3 = data;
-    else if (StringMatch(sk, VAR_BP1[0])) m_biomPFr1 = data;
-    else if (StringMatch(sk, VAR_BP2[0])) m_biomPFr2 = data;
-    else if (StringMatch(sk, VAR_BP3[0])) m_biomPFr3 = data;
-    else if (StringMatch(sk, VAR_CHTMX[0])) m_maxCanHgt = data;
     else if (StringMatch(sk, VAR_CO2HI[0])) m_co2Conc2ndPt = data;
-    else if (StringMatch(sk, VAR_DLAI[0])) m_dormPHUFr = data;
-    else if (StringMatch(sk, VAR_EXT_COEF[0])) m_lightExtCoef = data;
-    else if (StringMatch(sk, VAR_FRGRW1[0])) m_frGrow1stPt = data;
-    else if (StringMatch(sk, VAR_FRGRW2[0])) m_frGrow2ndPt = data;
-    else if (StringMatch(sk, VAR_HVSTI[0])) m_hvstIdx = data;
-    else if (StringMatch(sk, VAR_LAIMX1[0])) m_frMaxLai1stPt = data;
-    else if (StringMatch(sk, VAR_LAIMX2[0])) m_frMaxLai2ndPt = data;
-    else if (StringMatch(sk, VAR_MAT_YRS[0])) m_matYrs = data;
-    else if (StringMatch(sk, VAR_T_BASE[0])) m_pgTempBase = data;
-    else if (StringMatch(sk, VAR_T_OPT[0])) m_pgOptTemp = data;
-    else if (StringMatch(sk, VAR_WAVP[0])) m_wavp = data;
-    else if (StringMatch(sk, VAR_EPCO[0])) m_epco = data;
     else if (StringMatch(sk, VAR_TREEYRS[0])) m_curYrMat = data;
     else if (StringMatch(sk, VAR_LAIINIT[0])) m_initLai = data;
     else if (StringMatch(sk, VAR_BIOINIT[0])) m_initBiom = data;
@@ -169,6 +139,43 @@ void Biomass_EPIC::Set1DData(const char* key, const int n, int* data) {
     }
 }
 
+bool Biomass_EPIC::SetClassData(const char* key, const ClassParameter* data) {
+    ParamRaster1D* plant_param = PlantParameter(key);
+    if (nullptr == plant_param) { return false; }
+    CheckInputSize(M_PG_EPIC[0], key, data->GetCellNumber(), m_nCells);
+    plant_param->Set(data);
+    return true;
+}
+
+ParamRaster1D* Biomass_EPIC::PlantParameter(const string& key) {
+    if (StringMatch(key, VAR_ALAIMIN[0])) return &m_minLaiDorm;
+    else if (StringMatch(key, VAR_BIO_E[0])) return &m_biomEnrgRatio;
+    else if (StringMatch(key, VAR_BIOEHI[0])) return &m_biomEnrgRatio2ndPt;
+    else if (StringMatch(key, VAR_BIOLEAF[0])) return &m_biomDropFr;
+    else if (StringMatch(key, VAR_BLAI[0])) return &m_maxLai;
+    else if (StringMatch(key, VAR_BMX_TREES[0])) return &m_maxBiomTree;
+    else if (StringMatch(key, VAR_BN1[0])) return &m_biomNFr1;
+    else if (StringMatch(key, VAR_BN2[0])) return &m_biomNFr2;
+    else if (StringMatch(key, VAR_BN3[0])) return &m_biomNFr3;
+    else if (StringMatch(key, VAR_BP1[0])) return &m_biomPFr1;
+    else if (StringMatch(key, VAR_BP2[0])) return &m_biomPFr2;
+    else if (StringMatch(key, VAR_BP3[0])) return &m_biomPFr3;
+    else if (StringMatch(key, VAR_CHTMX[0])) return &m_maxCanHgt;
+    else if (StringMatch(key, VAR_DLAI[0])) return &m_dormPHUFr;
+    else if (StringMatch(key, VAR_EXT_COEF[0])) return &m_lightExtCoef;
+    else if (StringMatch(key, VAR_FRGRW1[0])) return &m_frGrow1stPt;
+    else if (StringMatch(key, VAR_FRGRW2[0])) return &m_frGrow2ndPt;
+    else if (StringMatch(key, VAR_HVSTI[0])) return &m_hvstIdx;
+    else if (StringMatch(key, VAR_LAIMX1[0])) return &m_frMaxLai1stPt;
+    else if (StringMatch(key, VAR_LAIMX2[0])) return &m_frMaxLai2ndPt;
+    else if (StringMatch(key, VAR_MAT_YRS[0])) return &m_matYrs;
+    else if (StringMatch(key, VAR_T_BASE[0])) return &m_pgTempBase;
+    else if (StringMatch(key, VAR_T_OPT[0])) return &m_pgOptTemp;
+    else if (StringMatch(key, VAR_WAVP[0])) return &m_wavp;
+    else if (StringMatch(key, VAR_EPCO[0])) return &m_epco;
+    return nullptr;
+}
+
 void Biomass_EPIC::Set2DData(const char* key, const int nrows, const int ncols, FLTPT** data) {
     string sk(key);
     CheckInputSize2D(M_PG_EPIC[0], key, nrows, ncols, m_nCells, m_maxSoilLyrs);
@@ -8,6 +8,7 @@
  *   - 2. 2016-10-07 - lj - Add some code of CENTURY model calculation.
  *   - 3. 2018-05-14 - lj - Code review and reformat code style.
  *   - 4. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 5. 2026-10-19 - lj - Read plant parameters of crop lookup table as class-indexed data.
  *
  * \author Liangjun Zhu
  */
@@ -39,6 +40,8 @@ public:
 
     void Set1DData(const char* key, int n, int* data) OVERRIDE;
 
+    bool SetClassData(const char* key, const ClassParameter* data) OVERRIDE;
+
     void Set2DData(const char* key, int nrows, int ncols, FLTPT** data) OVERRIDE;
 
     bool CheckInputData() OVERRIDE;
@@ -54,6 +57,9 @@ public:
     void Get2DData(const char* key, int* nrows, int* ncols, FLTPT*** data) OVERRIDE;
 
 private:
+    //! Plant parameters of crop lookup table, which can be set as class-indexed data, nullptr for others
+    ParamRaster1D* PlantParameter(const string& key);
+
     //////////////////////////////////////////////////////////////////////////
     //  The following code is transferred from swu.f of SWAT rev. 637
     //  Distribute potential plant evaporation through
@@ -161,57 +167,57 @@ private:
     /// land cover/crop  classification:1-7, i.e., IDC
     int* m_landCoverCls;
     /// minimum LAI during winter dormant period, alai_min
-    FLTPT* m_minLaiDorm;
+    ParamRaster1D m_minLaiDorm;
     /// Radiation-use efficicency or biomass-energy ratio ((kg/ha)/(MJ/m**2)), BIO_E in SWAT
-    FLTPT* m_biomEnrgRatio;
+    ParamRaster1D m_biomEnrgRatio;
     /// Biomass-energy ratio corresponding to the 2nd point on the radiation use efficiency curve
-    FLTPT* m_biomEnrgRatio2ndPt;
+    ParamRaster1D m_biomEnrgRatio2ndPt;
     /// fraction of biomass that drops during dormancy (for tree only), bio_leaf
-    FLTPT* m_biomDropFr;
+    ParamRaster1D m_biomDropFr;
     /// maximum (potential) leaf area index (BLAI in cropLookup db)
-    FLTPT* m_maxLai;
+    ParamRaster1D m_maxLai;
     /// Maximum biomass for a forest (metric tons/ha), BMX_TREES in SWAT
-    FLTPT* m_maxBiomTree;
+    ParamRaster1D m_maxBiomTree;
     /// nitrogen uptake parameter #1: normal fraction of N in crop biomass at emergence
-    FLTPT* m_biomNFr1;
+    ParamRaster1D m_biomNFr1;
     /// nitrogen uptake parameter #2: normal fraction of N in crop biomass at 50% maturity
-    FLTPT* m_biomNFr2;
+    ParamRaster1D m_biomNFr2;
     /// nitrogen uptake parameter #3: normal fraction of N in crop biomass at maturity
-    FLTPT* m_biomNFr3;
+    ParamRaster1D m_biomNFr3;
     /// phosphorus uptake parameter #1: normal fraction of P in crop biomass at emergence
-    FLTPT* m_biomPFr1;
+    ParamRaster1D m_biomPFr1;
     /// phosphorus uptake parameter #2: normal fraction of P in crop biomass at 50% maturity
-    FLTPT* m_biomPFr2;
+    ParamRaster1D m_biomPFr2;
     /// phosphorus uptake parameter #3: normal fraction of P in crop biomass at maturity
-    FLTPT* m_biomPFr3;
+    ParamRaster1D m_biomPFr3;
     /// maximum canopy height (m)
-    FLTPT* m_maxCanHgt;
+    ParamRaster1D m_maxCanHgt;
     /// elevated CO2 atmospheric concentration corresponding the 2nd point on the radiation use efficiency curve
     FLTPT* m_co2Conc2ndPt;
     /// fraction of growing season(PHU) when senescence becomes dominant
-    FLTPT* m_dormPHUFr;
+    ParamRaster1D m_dormPHUFr;
     /// plant water uptake compensation factor
-    FLTPT* m_epco;
+    ParamRaster1D m_epco;
     /// light extinction coefficient, ext_coef
-    FLTPT* m_lightExtCoef;
+    ParamRaster1D m_lightExtCoef;
     /// fraction of the growing season corresponding to the 1st point on optimal leaf area development curve
-    FLTPT* m_frGrow1stPt;
+    ParamRaster1D m_frGrow1stPt;
     /// fraction of the growing season corresponding to the 2nd point on optimal leaf area development curve
-    FLTPT* m_frGrow2ndPt;
+    ParamRaster1D m_frGrow2ndPt;
     /// harvest index: crop yield/aboveground biomass (kg/ha)/(kg/ha)
-    FLTPT* m_hvstIdx;
+    ParamRaster1D m_hvstIdx;
     /// fraction of maximum leaf area index corresponding to the 1st point on optimal leaf area development curve
-    FLTPT* m_frMaxLai1stPt;
+    ParamRaster1D m_frMaxLai1stPt;
     /// fraction of maximum leaf area index corresponding to the 2nd point on optimal leaf area development curve
-    FLTPT* m_frMaxLai2ndPt;
+    ParamRaster1D m_frMaxLai2ndPt;
     /// the number of years for the tree species to reach full development (years), MAT_YRS in SWAT
-    FLTPT* m_matYrs;
+    ParamRaster1D m_matYrs;
     /// minimum temperature for plant growth
-    FLTPT* m_pgTempBase;
+    ParamRaster1D m_pgTempBase;
     /// optional temperature for plant growth
-    FLTPT* m_pgOptTemp;
+    ParamRaster1D m_pgOptTemp;
     /// Rate of decline in radiation use efficiency per unit increase in vapor pressure deficit, wavp in SWAT
-    FLTPT* m_wavp;
+    ParamRaster1D m_wavp;
 
     /**  parameters need to be initialized in this module if they are NULL, i.e., in initialOutputs(void)  **/
     /// canopy height (m)
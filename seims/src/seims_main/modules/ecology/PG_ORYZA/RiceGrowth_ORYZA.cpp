@@ -37,7 +37,7 @@ ORYZA::ORYZA() :
     m_actPltET(nullptr), m_epco(nullptr), m_cropsta(nullptr),
     m_ts(nullptr), m_celllat(nullptr),
     // rice
-    m_cellLat(NODATA_VALUE), m_dayL(nullptr), m_sinLD(nullptr), m_cosLD(nullptr),
+    m_sinDec(0.f), m_cosDec(1.f), m_solconDay(0.f), m_dayL(nullptr), m_sinLD(nullptr), m_cosLD(nullptr),
     // parameters related to the current day and latitude
     m_dsinbe(nullptr), m_sinb(nullptr), m_solcon(nullptr), m_rdpdf(nullptr), m_rdpdr(nullptr),
     m_gaid(nullptr),
@@ -248,17 +248,23 @@ float ORYZA::CalDevelopmentRate(int i) {
     return dvr;
 }
 
+void ORYZA::CalDaySolarTerms() {
+    float DEGTRAD = 0.017453292f;
+    float dec = -asin(sin(23.45f * DEGTRAD) * cos(2.f * PI * (m_dayOfYear + 10.f) / 365.f));
+    m_sinDec = sin(dec);
+    m_cosDec = cos(dec);
+    m_solconDay = 1370.f * (1.f + 0.033f * cos(2.f * PI * m_dayOfYear / 365.f));
+}
+
 void ORYZA::CalDayLengthAndSINB(int i) {
     float DEGTRAD = 0.017453292f, zzcos, zzsin;
     // float dayLenP = 0.f; // not used?
-    /// compute the params according to lat
-
-    float dec = -asin(sin(23.45f * DEGTRAD) * cos(2.f * PI * (m_dayOfYear + 10.f) / 365.f));
+    /// compute the params according to lat, the terms of current day are from CalDaySolarTerms()
     /*m_sinLD[i] = sin (DEGTRAD * 31.2f) * sin (dec);
     m_cosLD[i] = cos (DEGTRAD * 31.2f) * cos (dec);*/
 
-    m_sinLD[i] = sin(DEGTRAD * m_cellLat) * sin(dec);
-    m_cosLD[i] = cos(DEGTRAD * m_cellLat) * cos(dec);
+    m_sinLD[i] = sin(DEGTRAD * m_celllat[i]) * m_sinDec;
+    m_cosLD[i] = cos(DEGTRAD * m_celllat[i]) * m_cosDec;
     float aob = m_sinLD[i] / m_cosLD[i];
 
     if (aob < -1) {
@@ -282,7 +288,7 @@ void ORYZA::CalDayLengthAndSINB(int i) {
         CalPow(m_cosLD[i], 2.f)) - (12.f * m_cosLD[i] * zzcos + 9.6f * m_sinLD[i] * m_cosLD[i] *
         zzcos + 2.4f * CalPow(m_cosLD[i], 2.f) * zzcos * zzsin) / PI);
 
-    m_solcon[i] = 1370.f * (1.f + 0.033f * cos(2.f * PI * m_dayOfYear / 365.f));
+    m_solcon[i] = m_solconDay;
 }
 
 void ORYZA::CalDirectRadiation(int i) {
@@ -841,6 +847,7 @@ void ORYZA::CalPlantNUptake(int i) {
 int ORYZA::Execute() {
     CheckInputData();
     InitialOutputs();
+    CalDaySolarTerms();
 
 #pragma omp parallel for
     for (int i = 0; i < m_nCells; i++) {
@@ -856,7 +863,6 @@ int ORYZA::Execute() {
         /// calculate residue on soil surface for current day
         m_rsdCovSoil[i] = Max((m_wagt[i] + m_soilRsd[i][0]), 0.f);
         /// calculate the parameters related to the lat and date
-        m_cellLat = m_celllat[i];
         CalDayLengthAndSINB(i);
 
         if (m_cropsta[i] > 0.f && m_dvs[i] < 2.f) {
@@ -7,6 +7,7 @@
  * Changelog:
  *   - 1. 2018-03-26 - sf - Initial implementation.
  *   - 2. 2018-06-12 - lj - Code review and reformat code style.
+ *   - 3. 2026-10-19 - lj - Solar declination and constant are calculated once per day for all cells.
  *
  * \author Fang Shen
  */
@@ -235,7 +236,12 @@ private:
 
     ///latitude of the stations
     float* m_celllat;
-    float m_cellLat;
+    /// Sine of solar declination of current day
+    float m_sinDec;
+    /// Cosine of solar declination of current day
+    float m_cosDec;
+    /// Solar constant of current day
+    float m_solconDay;
     /// Photoperiodic daylength (base = -4 degrees)
     //float *m_dayLenP;
     /// Astronomical daylength (base = 0 degrees)
@@ -403,6 +409,8 @@ private:
     //  calculates solar constant, daily  extraterrestrial radiation, daylength and some intermediate variables required by other routines
     //////////////////////////////////////////////////////////////////////////
     void CalDayLengthAndSINB(int i);
+    /// Calculate the terms of current day shared by all cells, i.e., solar declination and solar constant
+    void CalDaySolarTerms();
     //////////////////////////////////////////////////////////////////////////
     //  estimates solar inclination and fluxes of  diffuse and direct irradiation at a particular time of the day
     //////////////////////////////////////////////////////////////////////////
@@ -250,16 +250,14 @@ void KinWavSed_OL::initial() {
             m_fract[i] = 0.0f;
         }
     }
-
-    CalcuVelocityOverlandFlow();
-    WaterVolumeCalc();
 }
 
-void KinWavSed_OL::CalcuVelocityOverlandFlow() {
+void KinWavSed_OL::CalcuVelocityOverlandFlow(const int nIter) {
     const float beta = 0.6f;
     float Perim, R, S, n;
 
-    for (int i = 0; i < m_nCells; i++) {
+    for (int idx = 0; idx < nIter; idx++) {
+        int i = ActiveCellIndex(idx);
         if (m_WH[i] > 0.0001f) {
             Perim = 2 * m_WH[i] / 1000 + m_FlowWidth[i];    // mm to m -> /1000
             if (Perim > 0) {
@@ -392,9 +390,10 @@ void KinWavSed_OL::MaxConcentration(float watvol, float sedvol, int id) {
 //	Vol = DX * m_cellWith * wh;  // m3
 //	return Vol;
 //}
-void KinWavSed_OL::WaterVolumeCalc() {
+void KinWavSed_OL::WaterVolumeCalc(const int nIter) {
     float slope, DX, wh;
-    for (int i = 0; i < m_nCells; i++) {
+    for (int idx = 0; idx < nIter; idx++) {
+        int i = ActiveCellIndex(idx);
         slope = atan(m_Slope[i]);
         DX = m_CellWidth / cos(slope);
         wh = m_WH[i] / 1000;  //mm -> m
@@ -496,6 +495,23 @@ void KinWavSed_OL::OverlandflowSedRouting(int id) {
         Sin += m_Qsn[flowInID];        // kg/s
     }
 
+    // the dry cell without upstream inflow produces nothing
+    if (IsDryCell(id)) {
+        if (Sin != 0.f || Qin != 0.f) {
+            ActivateCell(id);
+        } else if (SkipDryCells()) {
+            m_SedToChannel[id] = 0.f;
+            if (m_streamLink[id] < 0 || flowwidth > 0) {
+                m_Ctrans[id] = 0.f;
+                m_DETOverland[id] = 0.f;
+                m_SedDep[id] = 0.f;
+                m_Qsn[id] = 0.f;
+                m_fract[id] = 0.f;
+            }
+            return;
+        }
+    }
+
     // if the channel width is greater than the cell width
     if (m_streamLink[id] >= 0 && flowwidth <= 0) {
         m_SedToChannel[id] = Sin * m_TimeStep;
@@ -550,6 +566,14 @@ int KinWavSed_OL::Execute() {
     CheckInputData();
 
     initial();
+    // the cells without overland flow, splash detachment, and sediment in flow are dry
+    const float* states[4] = {m_WH, m_Qkin, m_DETSplash, m_Sed_kg};
+    int nIter = RefreshActiveCells(m_nCells, states, 4);
+    ResetReleasedCells(m_V);
+    ResetReleasedCells(m_QV);
+    ResetReleasedCells(m_Vol);
+    CalcuVelocityOverlandFlow(nIter);
+    WaterVolumeCalc(nIter);
     /*for (int i=0;i<m_nCells;i++)
     {
         if (m_chWidth[i] > 0)
@@ -559,17 +583,14 @@ int KinWavSed_OL::Execute() {
     }*/
 
     //StatusMsg("executing KinWavSed_OL");
-    for (int iLayer = 0; iLayer < m_nLayers; ++iLayer) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int nCells = (int) m_routingLayers[iLayer][0];
-        //SetOpenMPThread(2);
-#pragma omp parallel for
-        for (int iCell = 1; iCell <= nCells; ++iCell) {
-            int id = (int) m_routingLayers[iLayer][iCell];
-            OverlandflowSedRouting(id);
-        }
-    }
+    // Each cell is routed once all of its upstream cells are finished
+    if (!m_executor.IsBuilt()) {
+        m_executor.Build(m_nCells, m_flowInIndex, m_routingLayers, m_nLayers);
+    }
+    m_executor.Execute(this, &KinWavSed_OL::OverlandflowSedRouting);
+    CheckInactiveCells(M_KINWAVSED_OL[0], VAR_SED_FLUX[0], m_Qsn);
+    CheckInactiveCells(M_KINWAVSED_OL[0], VAR_SED_TO_CH[0], m_SedToChannel);
+    CheckInactiveCells(M_KINWAVSED_OL[0], VAR_SED_FLOW[0], m_Sed_kg);
     //StatusMsg("end of executing KinWavSed_OL");
 
     return 0;
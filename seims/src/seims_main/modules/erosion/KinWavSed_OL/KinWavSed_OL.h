@@ -9,6 +9,7 @@
 #define KINWAVESED_OL_H
 
 #include "SimulationModule.h"
+#include "RoutingExecutor.h"
 
 // using namespace std;  // Avoid this statement! by lj.
 
@@ -67,8 +68,9 @@ private:
 
     /**
     *	@brief calculate the velocity of overland flow.
+    *	@param nIter   number of iterated cells, see SimulationModule::RefreshActiveCells()
     */
-    void CalcuVelocityOverlandFlow(void);
+    void CalcuVelocityOverlandFlow(int nIter);
 
     /**
     *	@brief calculate the velocity of overland flow.
@@ -127,7 +129,7 @@ private:
     float complexSedCalc(float Qj1i1, float Qj1i, float Qji1, float Sj1i, float Sji1, float alpha, float dt, float dx);
 
     //float WaterVolumeCalc(int id);  //m3
-    void WaterVolumeCalc(void);
+    void WaterVolumeCalc(int nIter);
 
     //set the input data which was not available right now, this will be delete when the data or module is available
     //void setNotAvailableInput();
@@ -156,6 +158,8 @@ private:
     float **m_flowInIndex;
 
     int m_nLayers;
+    /// Dataflow executor of cells according to the flow in relationships
+    RoutingExecutor m_executor;
 
     /// cell width of grid map (m)
     float m_CellWidth;
@@ -193,21 +193,12 @@ int SEDR_SBAGNOLD::Execute() {
     InitialOutputs();
     /// load point source water volume from m_ptSrcFactory
     PointSourceLoading();
-    for (auto it = m_reachLayers.begin(); it != m_reachLayers.end(); ++it) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int nReaches = CVT_INT(it->second.size());
-#pragma omp parallel for
-        for (int i = 0; i < nReaches; i++) {
-            int reachIndex = it->second[i]; // index in the array, which is equal to reach ID
-            if (m_inputSubbsnID == 0 || m_inputSubbsnID == reachIndex) {
-                // for OpenMP version, all reaches will be executed,
-                // for MPI version, only the current reach will be executed.
-                SedChannelRouting(reachIndex);
-                // compute changes in channel dimensions caused by downcutting and widening
-                ChannelDowncuttingWidening(reachIndex);
-            }
-        }
+    if (m_inputSubbsnID > 0) {
+        // for MPI version, only the current reach will be executed.
+        ReachRouting(m_inputSubbsnID);
+    } else {
+        // for OpenMP version, each reach will be executed once its upstream reaches are finished.
+        m_reachScheduler.Execute(this, &SEDR_SBAGNOLD::ReachRouting);
     }
     return 0;
 }
@@ -403,6 +394,13 @@ void SEDR_SBAGNOLD::SetReaches(clsReaches* reaches) {
 
     m_reachUpStream = reaches->GetUpStreamIDs();
     m_reachLayers = reaches->GetReachLayers();
+    m_reachScheduler.Build(m_reachUpStream, m_reachLayers);
+}
+
+void SEDR_SBAGNOLD::ReachRouting(const int i) {
+    SedChannelRouting(i);
+    // compute changes in channel dimensions caused by downcutting and widening
+    ChannelDowncuttingWidening(i);
 }
 
 void SEDR_SBAGNOLD::SedChannelRouting(const int i) {
@@ -21,6 +21,7 @@
  *        -# Bug fixed about code related to the IN/OUTPUT variables.
  *   - 7. 2018-08-15 - lj - Update from rtsed.f to rtsed_bagnold.f of SWAT.
  *   - 8. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 9. 2026-10-19 - lj - Route reaches by ReachScheduler instead of stream order layers.
  *
  * \author Liangjun Zhu, Hui Wu, Junzhi Liu
  */
@@ -28,6 +29,7 @@
 #define SEIMS_MODULE_SEDR_SBAGNOLD_H
 
 #include "SimulationModule.h"
+#include "ChannelRoutingCommon.h"
 
 /** \defgroup SEDR_SBAGNOLD
  * \ingroup Erosion
@@ -76,6 +78,9 @@ private:
     void SedChannelRouting(int i);
 
     void ChannelDowncuttingWidening(int i);
+
+    /// Sediment routing and channel downcutting and widening of reach \a i
+    void ReachRouting(int i);
 private:
     int m_dt;            ///< time step (sec)
     int m_inputSubbsnID; ///< current subbasin ID, 0 for the entire watershed
@@ -115,6 +120,7 @@ private:
     FLTPT* m_chBedGravel; ///< Fraction of gravel in channel bed sediment
 
     map<int, vector<int> > m_reachLayers; ///< Reach layers according to \a LayeringMethod
+    ReachScheduler m_reachScheduler; ///< Reach-tree scheduler according to upstream reaches
     /*!
      * Index of upstream Ids (The value is -1 if there if no upstream reach)
      * m_reachUpStream.size() = N+1
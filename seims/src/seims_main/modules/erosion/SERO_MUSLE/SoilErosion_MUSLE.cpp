@@ -174,8 +174,18 @@ int SERO_MUSLE::Execute() {
     CheckInputData();
     InitialIntermediates();
     InitialOutputs();
+    // the cells without surface runoff produce no sediment
+    const FLTPT* states[1] = {m_surfRf};
+    int n_iter = RefreshActiveCells(m_nCells, states, 1);
+    ResetReleasedCells(m_eroSed);
+    ResetReleasedCells(m_eroSand);
+    ResetReleasedCells(m_eroSilt);
+    ResetReleasedCells(m_eroClay);
+    ResetReleasedCells(m_eroSmAgg);
+    ResetReleasedCells(m_eroLgAgg);
 #pragma omp parallel for
-    for (int i = 0; i < m_nCells; i++) {
+    for (int idx = 0; idx < n_iter; idx++) {
+        int i = ActiveCellIndex(idx);
         if (m_surfRf[i] < 0.0001 || m_rchID[i] > 0) {
             m_eroSed[i] = 0.;
             m_eroSand[i] = 0.;
@@ -244,6 +254,7 @@ int SERO_MUSLE::Execute() {
         m_eroSmAgg[i] = m_eroSed[i] * m_detSmAgg[i];
         m_eroLgAgg[i] = m_eroSed[i] * m_detLgAgg[i];
     }
+    CheckInactiveCells(M_SERO_MUSLE[0], VAR_SOER[0], m_eroSed);
 
     //debug
     //cout << ConvertToString2(m_date) << ": " << m_usleK[50608][0] << ", " << m_eroSed[50608] << endl;
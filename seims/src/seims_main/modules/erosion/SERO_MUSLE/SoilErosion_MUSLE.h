@@ -17,6 +17,7 @@
  *        -# Change the calculation of LS factor, and add USLE_L and USLE_S as outputs.
  *   - 4. 2021-10-29 - ss,lj -
  *   - 5. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 6. 2026-10-19 - lj - Skip the cells without surface runoff by active-cell tracking.
  *
  * \author Liangjun Zhu, Zhiqiang Yu
  */
@@ -167,8 +167,13 @@ int SplashEro_Park::Execute() {
     CheckInputData();
     InitialOutputs();
     //StatusMsg("executing SplashEro_Park");
+    // no splash erosion without rainfall
+    const float* states[1] = {m_Rain};
+    int nIter = RefreshActiveCells(m_nCells, states, 1);
+    ResetReleasedCells(m_DETSplash);
 #pragma omp parallel for
-    for (int i = 0; i < m_nCells; i++) {
+    for (int idx = 0; idx < nIter; idx++) {
+        int i = ActiveCellIndex(idx);
         //intensity in mm/h
         float RainInten = m_Rain[i] * 3600.f / m_TimeStep;
 
@@ -196,6 +201,7 @@ int SplashEro_Park::Execute() {
         //}
 
     }
+    CheckInactiveCells(M_SplashEro_Park[0], VAR_DETSPLASH[0], m_DETSplash);
     //StatusMsg("end of executing SplashEro_Park");
     return 0;
 }
@@ -3,10 +3,11 @@
 #include "text.h"
 
 DiffusiveWave::DiffusiveWave() :
-    m_nCells(-1), m_dt(-1.0f), m_CellWidth(-1.0f), m_chNumber(-1),
+    m_nCells(-1), m_CellWidth(-1.0f), m_dt(-1.0f), m_courant(0.f), m_chNumber(-1),
     m_s0(nullptr), m_direction(nullptr), m_reachDownStream(nullptr), m_reachN(nullptr),
     m_chWidth(nullptr),
     m_qs(nullptr), m_hCh(nullptr), m_qCh(nullptr), m_prec(nullptr), m_qSubbasin(nullptr),
+    m_subSteps(nullptr),
     m_elevation(nullptr),
     m_flowLen(nullptr), m_qi(nullptr), m_flowInIndex(nullptr), m_flowOutIdx(nullptr),
     m_streamLink(nullptr),
@@ -25,6 +26,7 @@ DiffusiveWave::~DiffusiveWave() {
     Release2DArray(m_flowLen);
     Release1DArray(m_sourceCellIds);
     Release1DArray(m_qSubbasin);
+    Release1DArray(m_subSteps);
 }
 
 //! Check input data
@@ -128,6 +130,7 @@ void DiffusiveWave:: InitialOutputs() {
         m_flowLen = new float *[m_chNumber];
 
         m_qSubbasin = new float[m_chNumber];
+        m_subSteps = new float[m_chNumber];
         for (int i = 0; i < m_chNumber; ++i) {
             int n = m_reachs[i].size();
             m_hCh[i] = new float[n];
@@ -136,6 +139,7 @@ void DiffusiveWave:: InitialOutputs() {
             m_flowLen[i] = new float[n];
 
             m_qSubbasin[i] = 0.f;
+            m_subSteps[i] = 1.f;
 
             int id;
             float s0, dx;
@@ -163,7 +167,7 @@ void DiffusiveWave:: InitialOutputs() {
 }
 
 //! Channel flow
-void DiffusiveWave::ChannelFlow(int iReach, int iCell, int id) {
+void DiffusiveWave::ChannelFlow(int iReach, int iCell, int id, const float dt) {
 
     float qUp = 0.f;
     float hUp = 0.f;
@@ -227,8 +231,8 @@ void DiffusiveWave::ChannelFlow(int iReach, int iCell, int id) {
     }
 
     while (abs(d) > MIN_FLUX && counter < 10) {
-        d = (qNew * m_dt / dx + c * Power(qNew, 0.6f) - qUp * m_dt / dx - c * Power(qLast, 0.6f) - qLat * m_dt) /
-            (m_dt / dx + c * 0.6f / Power(qNew, 0.4f));
+        d = (qNew * dt / dx + c * Power(qNew, 0.6f) - qUp * dt / dx - c * Power(qLast, 0.6f) - qLat * dt) /
+            (dt / dx + c * 0.6f / Power(qNew, 0.4f));
 
         //if(d != d)
         //	int test = 1;
@@ -240,7 +244,7 @@ void DiffusiveWave::ChannelFlow(int iReach, int iCell, int id) {
         qNew = 0.f;
     }
 
-    float qAvail = m_hCh[iReach][iCell] * m_chWidth[iReach] * dx / m_dt + qLat * dx + qUp;
+    float qAvail = m_hCh[iReach][iCell] * m_chWidth[iReach] * dx / dt + qLat * dx + qUp;
 
     if (qNew > qAvail) {
         m_qCh[iReach][iCell] = qAvail;
@@ -252,26 +256,38 @@ void DiffusiveWave::ChannelFlow(int iReach, int iCell, int id) {
     }
 }
 
+int DiffusiveWave::ReachSubSteps(const int iReach) {
+    if (m_courant <= 0.f) { return 1; }
+    FLTPT courant = 0.;
+    int n = CVT_INT(m_reachs[iReach].size());
+    for (int iCell = 0; iCell < n; iCell++) {
+        FLTPT cr = KinematicCourant(m_qCh[iReach][iCell], m_hCh[iReach][iCell] * m_chWidth[iReach],
+                                    m_dt, m_flowLen[iReach][iCell]);
+        if (cr > courant) { courant = cr; }
+    }
+    return CourantSubSteps(courant, m_courant);
+}
+
+void DiffusiveWave::ReachFlow(const int iReach) {
+    vector<int> &vecCells = m_reachs[iReach];
+    int n = vecCells.size();
+    int nSteps = ReachSubSteps(iReach);
+    float dt = m_dt / nSteps;
+    for (int iStep = 0; iStep < nSteps; iStep++) {
+        for (int iCell = 0; iCell < n; iCell++) {
+            ChannelFlow(iReach, iCell, vecCells[iCell], dt);
+        }
+    }
+    m_subSteps[iReach] = CVT_FLT(nSteps);
+    m_qSubbasin[iReach] = m_qCh[iReach][n - 1];
+}
+
 //! Main execute function
 int DiffusiveWave::Execute() {
     CheckInputData();
     InitialOutputs();
-    for (auto it = m_reachLayers.begin(); it != m_reachLayers.end(); ++it) {
-        // There are no flow relationships within each routing layer.
-        //   So parallelization can be done here.
-        int nReaches = it->second.size();
-        // the size of m_reachLayers (map) is equal to the maximum stream order
-#pragma omp parallel for
-        for (int i = 0; i < nReaches; ++i) {
-            int reachIndex = it->second[i]; // index in the array
-            vector<int> &vecCells = m_reachs[reachIndex];
-            int n = vecCells.size();
-            for (int iCell = 0; iCell < n; iCell++) {
-                ChannelFlow(reachIndex, iCell, vecCells[iCell]);
-            }
-            m_qSubbasin[reachIndex] = m_qCh[reachIndex][n - 1];
-        }
-    }
+    // Each reach will be executed once its upstream reaches are finished.
+    m_reachScheduler.Execute(this, &DiffusiveWave::ReachFlow);
     return 0;
 }
 
@@ -279,6 +295,8 @@ void DiffusiveWave::SetValue(const char *key, const float value) {
     string sk(key);
     if (StringMatch(sk, Tag_HillSlopeTimeStep[0])) {
         m_dt = value;
+    } else if (StringMatch(sk, VAR_CH_COURANT[0])) {
+        m_courant = value;
     } else if (StringMatch(sk, Tag_CellSize[0])) {
         m_nCells = CVT_INT(value);
     } else if (StringMatch(sk, Tag_CellWidth[0])) {
@@ -336,6 +354,7 @@ void DiffusiveWave::SetReaches(clsReaches *reaches) {
 
     m_reachUpStream = reaches->GetUpStreamIDs();
     m_reachLayers = reaches->GetReachLayers();
+    m_reachScheduler.Build(m_reachUpStream, m_reachLayers);
 }
 
 void DiffusiveWave::Get1DData(const char *key, int *n, float **data) {
@@ -344,6 +363,8 @@ void DiffusiveWave::Get1DData(const char *key, int *n, float **data) {
     *n = m_chNumber;
     if (StringMatch(sk, VAR_QSUBBASIN[0])) {
         *data = m_qSubbasin;
+    } else if (StringMatch(sk, VAR_CH_SUBSTEP[0])) {
+        *data = m_subSteps;
     }
         /*else if (StringMatch(sk, "CHWATH"))
         {
@@ -3,6 +3,8 @@
  *
  * Changelog:
  *   - 1. 2021-07-09 - lj - Code reformat.
+ *   - 2. 2026-10-19 - lj - Route reaches by ReachScheduler instead of stream order layers.
+ *   - 3. 2026-10-19 - lj - Adaptive sub-steps of each reach by the Courant condition.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
@@ -10,6 +12,7 @@
 #define SEIMS_MODULE_CH_DW_H
 
 #include "SimulationModule.h"
+#include "ChannelRoutingCommon.h"
 
 /*! \defgroup CH_DW
  * \ingroup Hydrology
@@ -22,6 +25,10 @@
  *
  * \brief Routing in the channel
  *
+ *        If the Courant number limit (i.e., CH_Courant) is positive, each reach is routed by the
+ *        sub-steps determined from the Courant condition on its current velocities, while the
+ *        inflow from upstream reaches, which have finished the whole time step, is kept constant.
+ *        The number of sub-steps of each reach is exported as CH_SUBSTEP.
  */
 class DiffusiveWave : public SimulationModule {
 public:
@@ -48,11 +55,18 @@ public:
     void Get2DData(const char *key, int *nrows, int *ncols, float ***data) OVERRIDE;
 
 private:
-    void ChannelFlow(int iReach, int iCell, int id);
+    void ChannelFlow(int iReach, int iCell, int id, float dt);
+
+    /// Number of sub-steps of reach \a iReach by the Courant condition on current velocities
+    int ReachSubSteps(int iReach);
+
+    /// Channel routing of all cells of reach \a iReach
+    void ReachFlow(int iReach);
 
     int m_nCells;  ///< Valid cells number
     float m_CellWidth; ///< cell width of the grid (m)
     float m_dt; ///< channel routing time step (seconds)
+    float m_courant; ///< Courant number limit of sub-steps, 0 means the whole time step
     float *m_s0; ///< slope (percent)
     float *m_chWidth; ///< channel width (raster type to keep consistent with the one in IKW_CH, zero for overland cells) 
     float *m_elevation; ///< elevation
@@ -88,6 +102,8 @@ private:
 
     /// discharge at subasin outlet
     float *m_qSubbasin;
+    /// number of sub-steps of each reach in current step
+    float *m_subSteps;
 
     // id of the outlet
     int m_idOutlet;
@@ -124,6 +140,8 @@ private:
     map<int, int> m_idToIndex;
 
     map<int, vector<int> > m_reachLayers;
+    /// Reach-tree scheduler according to upstream reaches
+    ReachScheduler m_reachScheduler;
 
     /**
     *	@brief reach links
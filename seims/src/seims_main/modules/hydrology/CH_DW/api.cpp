@@ -22,6 +22,7 @@ extern "C" SEIMS_MODULE_API const char *MetadataInformation() {
 
     // Parameters from database
     mdi.AddParameter(Tag_HillSlopeTimeStep[0], UNIT_SECOND, Tag_HillSlopeTimeStep[1], Source_ParameterDB, DT_Single);
+    mdi.AddParameter(VAR_CH_COURANT[0], UNIT_NON_DIM, VAR_CH_COURANT[1], Source_ParameterDB_Optional, DT_Single);
     mdi.AddParameter(Tag_CellSize[0], UNIT_NON_DIM, Tag_CellSize[1], Source_ParameterDB, DT_Single);
     mdi.AddParameter(Tag_CellWidth[0], UNIT_LEN_M, Tag_CellWidth[1], Source_ParameterDB, DT_Single);
     mdi.AddParameter(VAR_DEM[0], UNIT_LEN_M, VAR_DEM[1], Source_ParameterDB, DT_Raster1D);
@@ -41,6 +42,7 @@ extern "C" SEIMS_MODULE_API const char *MetadataInformation() {
     // Outputs
     mdi.AddOutput(VAR_QCH[0], UNIT_FLOW_CMS, VAR_QCH[1], DT_Array2D);
     mdi.AddOutput(VAR_QSUBBASIN[0], UNIT_FLOW_CMS, VAR_QSUBBASIN[1], DT_Array1D);
+    mdi.AddOutput(VAR_CH_SUBSTEP[0], UNIT_NON_DIM, VAR_CH_SUBSTEP[1], DT_Array1D);
     mdi.AddOutput(VAR_HCH[0], UNIT_DEPTH_MM, VAR_HCH[1], DT_Array2D);
 
     string res = mdi.GetXMLDocument();
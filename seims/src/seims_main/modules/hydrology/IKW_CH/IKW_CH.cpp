@@ -4,12 +4,12 @@
 //using namespace std;  // Avoid this statement! by lj.
 
 ImplicitKinematicWave_CH::ImplicitKinematicWave_CH() :
-    m_nCells(-1), m_chNumber(-1), m_dt(-1.0f),
-    m_CellWidth(-1.0f), //m_layeringMethod(UP_DOWN),
+    m_nCells(-1), m_chNumber(-1), m_CellWidth(-1.0f), //m_layeringMethod(UP_DOWN),
+    m_dt(-1.0f), m_courant(0.f),
     m_sRadian(nullptr), m_direction(nullptr), m_reachDownStream(nullptr),
     m_chWidth(nullptr),
     m_qs(nullptr), m_hCh(nullptr), m_qCh(nullptr), m_prec(nullptr),
-    m_qSubbasin(nullptr), m_qg(nullptr),
+    m_qSubbasin(nullptr), m_subSteps(nullptr), m_qg(nullptr),
     m_flowLen(nullptr), m_qi(nullptr), m_streamLink(nullptr),
     m_sourceCellIds(nullptr),
     m_idUpReach(-1), m_qUpReach(0.f),
@@ -25,6 +25,7 @@ ImplicitKinematicWave_CH::~ImplicitKinematicWave_CH(void) {
 
     Release1DArray(m_sourceCellIds);
     Release1DArray(m_qSubbasin);
+    Release1DArray(m_subSteps);
 }
 
 //---------------------------------------------------------------------------
@@ -191,6 +192,7 @@ void ImplicitKinematicWave_CH:: InitialOutputs() {
         //m_flowLen = new float *[m_chNumber];
 
         m_qSubbasin = new float[m_chNumber];
+        m_subSteps = new float[m_chNumber];
         for (int i = 0; i < m_chNumber; ++i) {
             int n = CVT_INT(m_reachs[i].size());
             m_hCh[i] = new float[n];
@@ -199,6 +201,7 @@ void ImplicitKinematicWave_CH:: InitialOutputs() {
             //m_flowLen[i] = new float[n];
 
             m_qSubbasin[i] = 0.f;
+            m_subSteps[i] = 1.f;
 
             //int id;
             //float dx;
@@ -239,7 +242,7 @@ void ImplicitKinematicWave_CH::initialOutputs2() {
     }
 }
 
-void ImplicitKinematicWave_CH::ChannelFlow(int iReach, int iCell, int id, float qgEachCell) {
+void ImplicitKinematicWave_CH::ChannelFlow(int iReach, int iCell, int id, float qgEachCell, const float dt) {
     float qUp = 0.f;
 
     if (iReach == 0 && iCell == 0) {
@@ -288,13 +291,27 @@ void ImplicitKinematicWave_CH::ChannelFlow(int iReach, int iCell, int id, float
 
     float qIn = m_qCh[iReach][iCell];
 
-    m_qCh[iReach][iCell] = GetNewQ(qUp, qIn, 0.f, alpha, m_dt, dx);
+    m_qCh[iReach][iCell] = GetNewQ(qUp, qIn, 0.f, alpha, dt, dx);
 
-    float hTest = m_hCh[iReach][iCell] + (qUp - m_qCh[iReach][iCell]) * m_dt / m_chWidth[id] / dx;
+    float hTest = m_hCh[iReach][iCell] + (qUp - m_qCh[iReach][iCell]) * dt / m_chWidth[id] / dx;
     float hNew = (alpha * CalPow(m_qCh[iReach][iCell], 0.6f)) / m_chWidth[id]; // unit m
     m_hCh[iReach][iCell] = (alpha * CalPow(m_qCh[iReach][iCell], 0.6f)) / m_chWidth[id]; // unit m
 }
 
+int ImplicitKinematicWave_CH::ReachSubSteps(const int iReach) {
+    if (m_courant <= 0.f) { return 1; }
+    FLTPT courant = 0.;
+    vector<int> &vecCells = m_reachs[iReach];
+    int n = CVT_INT(vecCells.size());
+    for (int iCell = 0; iCell < n; iCell++) {
+        int id = vecCells[iCell];
+        FLTPT cr = KinematicCourant(m_qCh[iReach][iCell], m_hCh[iReach][iCell] * m_chWidth[id],
+                                    m_dt, m_flowLen[iReach][iCell]);
+        if (cr > courant) { courant = cr; }
+    }
+    return CourantSubSteps(courant, m_courant);
+}
+
 int ImplicitKinematicWave_CH::Execute() {
     //check the data
     CheckInputData();
@@ -323,11 +340,16 @@ int ImplicitKinematicWave_CH::Execute() {
                 qgEachCell = m_qg[i + 1] / n;
             }
             //cout << "\tGroundwater: " << qgEachCell << endl;
-            for (int iCell = 0; iCell < n; ++iCell) {
-                int idCell = vecCells[iCell];
-                //m_qsInput[reachIndex+1] += m_qs[idCell];
-                ChannelFlow(reachIndex, iCell, idCell, qgEachCell);
+            int nSteps = ReachSubSteps(reachIndex);
+            float dt = m_dt / nSteps;
+            for (int iStep = 0; iStep < nSteps; iStep++) {
+                for (int iCell = 0; iCell < n; ++iCell) {
+                    int idCell = vecCells[iCell];
+                    //m_qsInput[reachIndex+1] += m_qs[idCell];
+                    ChannelFlow(reachIndex, iCell, idCell, qgEachCell, dt);
+                }
             }
+            m_subSteps[reachIndex] = CVT_FLT(nSteps);
             m_qSubbasin[reachIndex] = m_qCh[reachIndex][n - 1];
         }
     }
@@ -377,6 +399,8 @@ void ImplicitKinematicWave_CH::SetValue(const char *key, float value) {
     string sk(key);
     if (StringMatch(sk, Tag_HillSlopeTimeStep[0])) {
         m_dt = value;
+    } else if (StringMatch(sk, VAR_CH_COURANT[0])) {
+        m_courant = value;
     } else if (StringMatch(sk, Tag_CellWidth[0])) {
         m_CellWidth = value;
     } else {
@@ -432,6 +456,9 @@ void ImplicitKinematicWave_CH::Get1DData(const char *key, int *n, float **data)
     if (StringMatch(sk, VAR_QRECH[0])) {
         *data = m_qSubbasin;
     }
+    else if (StringMatch(sk, VAR_CH_SUBSTEP[0])) {
+        *data = m_subSteps;
+    }
     else if (StringMatch(sk, VAR_QRECH[0])) {
         auto it = m_reachLayers.end();
         --it;
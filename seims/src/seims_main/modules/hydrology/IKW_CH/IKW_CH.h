@@ -6,6 +6,7 @@
  * Changelog:
  *   - 1. 2011-02-28 - jz - Original implementation.
  *   - 2. 2021-10-29 - lj - Update to new SEIMS designs and code styles.
+ *   - 3. 2026-10-19 - lj - Adaptive sub-steps of each reach by the Courant condition.
  *
  */
 
@@ -13,6 +14,7 @@
 #define SEIMS_IKW_CH_H
 
 #include "SimulationModule.h"
+#include "ChannelRoutingCommon.h"
 
 //using namespace std;  // Avoid this statement! by lj.
 
@@ -27,6 +29,10 @@
  * \ingroup IKW_CH
  * \brief kinematic wave method in LISEM model
  *
+ *        If the Courant number limit (i.e., CH_Courant) is positive, each reach is routed by the
+ *        sub-steps determined from the Courant condition on its current velocities, while the
+ *        inflow from upstream reaches of previous layers is kept constant during sub-steps.
+ *        The number of sub-steps of each reach is exported as CH_SUBSTEP.
  */
 class ImplicitKinematicWave_CH : public SimulationModule {
 public:
@@ -62,7 +68,10 @@ public:
 private:
     float GetNewQ(float qIn, float qLast, float surplus, float alpha, float dt, float dx);
 
-    void ChannelFlow(int iReach, int iCell, int id, float qgEachCell);
+    void ChannelFlow(int iReach, int iCell, int id, float qgEachCell, float dt);
+
+    /// Number of sub-steps of reach \a iReach by the Courant condition on current velocities
+    int ReachSubSteps(int iReach);
 
     void InitialOutputs(void);
 
@@ -76,6 +85,8 @@ private:
     //LayeringMethod m_layeringMethod;
     /// time step (second)
     float m_dt;
+    /// Courant number limit of sub-steps, 0 means the whole time step
+    float m_courant;
 
     /// slope (radian)
     float *m_sRadian;
@@ -123,6 +134,8 @@ private:
 
     /// discharge at subasin outlet
     float *m_qSubbasin;
+    /// number of sub-steps of each reach in current step
+    float *m_subSteps;
     //float *m_qsInput;
 
     // id of the outlet
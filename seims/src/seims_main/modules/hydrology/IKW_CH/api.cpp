@@ -25,6 +25,7 @@ extern "C" SEIMS_MODULE_API const char *MetadataInformation() {
 
     //mdi.AddParameter(Tag_LayeringMethod[0], UNIT_NON_DIM, Tag_LayeringMethod[1], File_Input, DT_Single);
     mdi.AddParameter(Tag_HillSlopeTimeStep[0], UNIT_SECOND, Tag_TimeStep[1], File_Input, DT_Single);
+    mdi.AddParameter(VAR_CH_COURANT[0], UNIT_NON_DIM, VAR_CH_COURANT[1], Source_ParameterDB_Optional, DT_Single);
     mdi.AddParameter(Tag_CellWidth[0], UNIT_LEN_M, Tag_CellWidth[1], Source_ParameterDB, DT_Single);
 
     mdi.AddParameter(VAR_FLOWDIR[0], UNIT_NON_DIM, VAR_FLOWDIR[1], Source_ParameterDB, DT_Raster1D);
@@ -48,6 +49,7 @@ extern "C" SEIMS_MODULE_API const char *MetadataInformation() {
     mdi.AddOutput(VAR_QRECH[0], UNIT_FLOW_CMS, VAR_QRECH[1], DT_Array1D);
     mdi.AddOutput(VAR_QTOTAL[0], UNIT_FLOW_CMS, VAR_QTOTAL[1], DT_Single);
     mdi.AddOutput(VAR_QSUBBASIN[0], UNIT_FLOW_CMS, VAR_QSUBBASIN[1], DT_Array1D);
+    mdi.AddOutput(VAR_CH_SUBSTEP[0], UNIT_NON_DIM, VAR_CH_SUBSTEP[1], DT_Array1D);
     mdi.AddOutput(VAR_HCH[0], UNIT_DEPTH_MM, VAR_HCH[1], DT_Array2D);
 
     res = mdi.GetXMLDocument();
@@ -168,23 +168,17 @@ int InterFlow_IKW::Execute() {
 
     InitialOutputs();
 
-    for (int iLayer = 0; iLayer < m_nLayers; ++iLayer) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int nCells = (int) m_routingLayers[iLayer][0];
-        //SetOpenMPThread(2);
-		int errCount = 0; //similar to SSR_DA, such that FlowInSoil(id) isn't called in omp loop
-#pragma omp parallel for
-        for (int iCell = 1; iCell <= nCells; ++iCell) {
-            int id = (int) m_routingLayers[iLayer][iCell];
-            if (!FlowInSoil(id)) errCount++;
-        }
-        if (errCount > 0) {
-            throw ModelException(M_IKW_IF[0], "Execute:FlowInSoil",
-                                 "Please check the error message for more information");
-        }
+    // Each cell is routed once all of its upstream cells are finished
+    if (!m_executor.IsBuilt()) {
+        m_executor.Build(m_nCells, m_flowInIndex, m_routingLayers, m_nLayers);
+    }
+    // similar to SSR_DA, such that exception isn't thrown in FlowInSoil(id) within omp region
+    int errCount = m_executor.Execute(this, &InterFlow_IKW::FlowInSoil);
+    if (errCount > 0) {
+        throw ModelException(M_IKW_IF[0], "Execute:FlowInSoil",
+                             "Please check the error message for more information");
     }
-    //return 0;
+    return 0;
 }
 
 bool InterFlow_IKW::CheckInputSize(const char *key, int n) {
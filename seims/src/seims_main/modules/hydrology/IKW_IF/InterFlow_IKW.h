@@ -8,6 +8,7 @@
 #define SEIMS_IKW_IF_H
 
 #include "SimulationModule.h"
+#include "RoutingExecutor.h"
 
 // using namespace std;  // Avoid this statement! by lj.
 
@@ -101,6 +102,8 @@ private:
     */
     float **m_routingLayers;
     int m_nLayers;
+    /// Dataflow executor of cells according to the flow in relationships
+    RoutingExecutor m_executor;
 
     /// depression storage
     float *m_sr;
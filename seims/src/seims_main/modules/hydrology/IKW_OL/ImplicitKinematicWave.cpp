@@ -194,6 +194,27 @@ void ImplicitKinematicWave_OL::OverlandFlow(int id) {
     const float beta = 0.6f;
     float beta1 = 1 / beta;
 
+    //sum the upstream overland flow
+    float qUp = 0.0f;
+    for (int k = 1; k <= (int) m_flowInIndex[id][0]; ++k) {
+        int flowInID = (int) m_flowInIndex[id][k];
+        if (m_streamLink[flowInID] <= 0) { // if the upstream cell is not a channel cell
+            qUp += m_q[flowInID];
+        }
+    }
+
+    // the dry cell without upstream inflow stays dry
+    if (IsDryCell(id)) {
+        if (qUp >= MIN_FLUX) {
+            ActivateCell(id);
+        } else if (SkipDryCells()) {
+            m_q[id] = m_streamLink[id] >= 0 && m_flowWidth[id] <= 0 ? qUp : 0.f;
+            m_vel[id] = 0.f;
+            m_sr[id] = 0.f;
+            return;
+        }
+    }
+
     float h = m_sr[id] / 1000.f;
 
     float Perim = 2.f * h + m_flowWidth[id];
@@ -216,15 +237,6 @@ void ImplicitKinematicWave_OL::OverlandFlow(int id) {
     float flowWidth = m_flowWidth[id]; //(little question: why not use m_flowWidth[[id]? by Gao)
     float flowLen = m_flowLen[id];
 
-    //sum the upstream overland flow
-    float qUp = 0.0f;
-    for (int k = 1; k <= (int) m_flowInIndex[id][0]; ++k) {
-        int flowInID = (int) m_flowInIndex[id][k];
-        if (m_streamLink[flowInID] <= 0) { // if the upstream cell is not a channel cell
-            qUp += m_q[flowInID];
-        }
-    }
-
     // if the channel width is greater than the cell width
     if (m_streamLink[id] >= 0 && flowWidth <= 0) {
         m_q[id] = qUp;
@@ -295,18 +307,16 @@ void ImplicitKinematicWave_OL::OverlandFlow(int id) {
 
 int ImplicitKinematicWave_OL::Execute() {
     InitialOutputs();
+    // the cells without surface runoff are dry
+    const float* states[1] = {m_sr};
+    RefreshActiveCells(m_nCells, states, 1);
 
-    for (int iLayer = 0; iLayer < m_nLayers; ++iLayer) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int nCells = (int) m_routingLayers[iLayer][0];
-        //SetOpenMPThread(2);
-#pragma omp parallel for
-        for (int iCell = 1; iCell <= nCells; ++iCell) {
-            int id = (int) m_routingLayers[iLayer][iCell];
-            OverlandFlow(id);
-        }
+    // Each cell is routed once all of its upstream cells are finished
+    if (!m_executor.IsBuilt()) {
+        m_executor.Build(m_nCells, m_flowInIndex, m_routingLayers, m_nLayers);
     }
+    m_executor.Execute(this, &ImplicitKinematicWave_OL::OverlandFlow);
+    CheckInactiveCells(M_IKW_OL[0], VAR_SURU[0], m_sr);
 
     return 0;
 }
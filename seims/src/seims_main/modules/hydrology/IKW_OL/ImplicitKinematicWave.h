@@ -7,6 +7,7 @@
 #define SEIMS_IKW_OL_H
 
 #include "SimulationModule.h"
+#include "RoutingExecutor.h"
 
 // using namespace std;  // Avoid this statement! by lj.
 
@@ -95,6 +96,8 @@ private:
     */
     float **m_routingLayers;
     int m_nLayers;
+    /// Dataflow executor of cells according to the flow in relationships
+    RoutingExecutor m_executor;
 
     /// water height available for runoff (surface runoff)
     float *m_sr;
@@ -54,7 +54,7 @@ int ReservoirMethod::Execute() {
         Subbasin* curSub = m_subbasinsInfo->GetSubbasinByID(subID);
         // get percolation from the bottom soil layer at the subbasin scale
         int curCellsNum = curSub->GetCellCount();
-        int* curCells = curSub->GetCells();
+        const int* curCells = curSub->GetCells();
         FLTPT perco = 0.;
         FLTPT fPET = 0.;
         FLTPT revap = 0.;
@@ -171,7 +171,7 @@ int ReservoirMethod::Execute() {
     // update soil moisture
     for (auto it = m_subbasinIDs.begin(); it != m_subbasinIDs.end(); ++it) {
         Subbasin* sub = m_subbasinsInfo->GetSubbasinByID(*it);
-        int* cells = sub->GetCells();
+        const int* cells = sub->GetCells();
         int nCells = sub->GetCellCount();
         int index = 0;
 #pragma omp parallel for
@@ -4,7 +4,7 @@
 
 IUH_OL::IUH_OL() :
     m_TimeStep(-1), m_nCells(-1), m_CellWth(NODATA_VALUE), m_cellArea(NODATA_VALUE),
-    m_nSubbsns(-1), m_inputSubbsnID(-1), m_subbsnID(nullptr),
+    m_nSubbsns(-1), m_inputSubbsnID(-1), m_subbasinsInfo(nullptr), m_subbsnIndex(nullptr),
     m_iuhCell(nullptr), m_iuhCols(-1), m_surfRf(nullptr),
     m_cellFlow(nullptr), m_cellFlowCols(-1), m_Q_SBOF(nullptr), m_OL_Flow(nullptr) {
 }
@@ -22,7 +22,7 @@ bool IUH_OL::CheckInputData() {
     CHECK_POSITIVE(M_IUH_OL[0], m_nCells);
     CHECK_POSITIVE(M_IUH_OL[0], m_CellWth);
     CHECK_NONNEGATIVE(M_IUH_OL[0], m_TimeStep);
-    CHECK_POINTER(M_IUH_OL[0], m_subbsnID);
+    CHECK_POINTER(M_IUH_OL[0], m_subbasinsInfo);
     CHECK_POINTER(M_IUH_OL[0], m_iuhCell);
     CHECK_POINTER(M_IUH_OL[0], m_surfRf);
     return true;
@@ -43,6 +43,14 @@ void IUH_OL::InitialOutputs() {
     if (nullptr == m_OL_Flow) {
         Initialize1DArray(m_nCells, m_OL_Flow, 0.);
     }
+    if (nullptr == m_subbsnIndex) {
+        // Reuse the CSR index of subbasins, which is owned by clsSubbasins
+        m_subbsnIndex = m_subbasinsInfo->GetSubbasinIndex();
+        if (m_subbsnIndex->GetMaxZoneID() > m_nSubbsns) {
+            throw ModelException(M_IUH_OL[0], "InitialOutputs",
+                                 "Subbasin ID should not be greater than the subbasin number!");
+        }
+    }
 }
 
 int IUH_OL::Execute() {
@@ -71,27 +79,15 @@ int IUH_OL::Execute() {
         }
     }
     // See https://github.com/lreis2415/SEIMS/issues/36 for more descriptions. By lj
-#pragma omp parallel
-    {
-        FLTPT* tmp_qsSub = new FLTPT[m_nSubbsns + 1];
-        for (int i = 0; i <= m_nSubbsns; i++) {
-            tmp_qsSub[i] = 0.;
-        }
-#pragma omp for
-        for (int i = 0; i < m_nCells; i++) {
-            tmp_qsSub[CVT_INT(m_subbsnID[i])] += m_cellFlow[i][0]; //get new value
-            m_OL_Flow[i] = m_cellFlow[i][0];
-            m_OL_Flow[i] = m_OL_Flow[i] * m_TimeStep * 1000. / m_cellArea; // m3/s -> mm
-        }
-#pragma omp critical
-        {
-            for (int i = 1; i <= m_nSubbsns; i++) {
-                m_Q_SBOF[i] += tmp_qsSub[i];
-            }
-        }
-        delete[] tmp_qsSub;
-        tmp_qsSub = nullptr;
-    } /* END of #pragma omp parallel */
+#pragma omp parallel for
+    for (int i = 0; i < m_nCells; i++) {
+        m_OL_Flow[i] = m_cellFlow[i][0];
+        m_OL_Flow[i] = m_OL_Flow[i] * m_TimeStep * 1000. / m_cellArea; // m3/s -> mm
+    }
+    // Segmented sum by subbasins, no private copies and critical section are needed.
+    FLTPT** cell_flow = m_cellFlow;
+    m_subbsnIndex->Reduce([cell_flow](const int i) { return CVT_DBL(cell_flow[i][0]); }, m_Q_SBOF);
+    m_Q_SBOF[0] = 0.;
 
     for (int n = 1; n <= m_nSubbsns; n++) {
         //get overland flow routing for entire watershed.
@@ -131,13 +127,9 @@ void IUH_OL::Set1DData(const char* key, const int n, FLTPT* data) {
     }
 }
 
-void IUH_OL::Set1DData(const char* key, const int n, int* data) {
-    CheckInputSize(M_IUH_OL[0], key, n, m_nCells);
-    string sk(key);
-    if (StringMatch(sk, VAR_SUBBSN[0])) m_subbsnID = data;
-    else {
-        throw ModelException(M_IUH_OL[0], "Set1DData",
-                             "Integer Parameter " + sk + " does not exist.");
+void IUH_OL::SetSubbasins(clsSubbasins* subbasins) {
+    if (nullptr == m_subbasinsInfo) {
+        m_subbasinsInfo = subbasins;
     }
 }
 
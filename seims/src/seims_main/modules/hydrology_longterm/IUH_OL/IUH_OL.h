@@ -24,6 +24,8 @@
  *   - 4. 2018-03-20 - lj - The length of subbasin related array should equal to
  *                            the count of subbasins, for both mpi version and omp version.
  *   - 5. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 6. 2026-10-19 - lj - Aggregate overland flow of subbasins by segmented reduction of ZoneIndex.
+ *   - 7. 2026-10-19 - lj - Reuse the subbasin index of clsSubbasins rather than the subbasin grid.
  *
  * \author Wu hui, Zhiqiang Yu, Liangjun Zhu
  */
@@ -31,6 +33,7 @@
 #define SEIMS_MODULE_IUH_OL_H
 
 #include "SimulationModule.h"
+#include "clsSubbasin.h"
 
 /** \defgroup IUH_OL
  * \ingroup Hydrology
@@ -56,7 +59,7 @@ public:
 
     void Set1DData(const char* key, int n, FLTPT* data) OVERRIDE;
 
-    void Set1DData(const char* key, int n, int* data) OVERRIDE;
+    void SetSubbasins(clsSubbasins* subbasins) OVERRIDE;
 
     void Set2DData(const char* key, int nrows, int ncols, FLTPT** data) OVERRIDE;
 
@@ -83,8 +86,10 @@ private:
     int m_nSubbsns;
     /// current subbasin ID, 0 for the entire watershed
     int m_inputSubbsnID;
-    /// subbasin grid (subbasins ID)
-    int* m_subbsnID;
+    /// subbasins information
+    clsSubbasins* m_subbasinsInfo;
+    /// CSR index of cells grouped by subbasin ID, owned by m_subbasinsInfo
+    ZoneIndex* m_subbsnIndex;
 
     /// IUH of each grid cell (1/s)
     FLTPT** m_iuhCell;
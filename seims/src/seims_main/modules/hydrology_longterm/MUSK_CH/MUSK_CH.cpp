@@ -19,6 +19,7 @@ MUSK_CH::MUSK_CH() :
     m_olQ2Rch(nullptr), m_ifluQ2Rch(nullptr), m_gndQ2Rch(nullptr),
     // Temporary variables
     m_ptSub(nullptr), m_flowIn(nullptr), m_flowOut(nullptr), m_seepage(nullptr),
+    m_chStoAcc(nullptr), m_bankStoAcc(nullptr),
     // Outputs
     m_qRchOut(nullptr), m_qsRchOut(nullptr), m_qiRchOut(nullptr), m_qgRchOut(nullptr),
     m_chSto(nullptr), m_rteWtrIn(nullptr), m_rteWtrOut(nullptr), m_bankSto(nullptr),
@@ -33,6 +34,8 @@ MUSK_CH::~MUSK_CH() {
     if (nullptr != m_flowIn) Release1DArray(m_flowIn);
     if (nullptr != m_flowOut) Release1DArray(m_flowOut);
     if (nullptr != m_seepage) Release1DArray(m_seepage);
+    if (nullptr != m_chStoAcc) Release1DArray(m_chStoAcc);
+    if (nullptr != m_bankStoAcc) Release1DArray(m_bankStoAcc);
 
     if (nullptr != m_qRchOut) Release1DArray(m_qRchOut);
     if (nullptr != m_qsRchOut) Release1DArray(m_qsRchOut);
@@ -90,8 +93,8 @@ void MUSK_CH::InitialOutputs() {
     }
     m_mskCoef2 = 1. - m_mskCoef1;
 
-    m_flowIn = new(nothrow) FLTPT[m_nreach + 1];
-    m_flowOut = new(nothrow) FLTPT[m_nreach + 1];
+    m_flowIn = new(nothrow) FLTACC[m_nreach + 1];
+    m_flowOut = new(nothrow) FLTACC[m_nreach + 1];
     m_seepage = new(nothrow) FLTPT[m_nreach + 1];
 
     m_qRchOut = new(nothrow) FLTPT[m_nreach + 1];
@@ -103,6 +106,8 @@ void MUSK_CH::InitialOutputs() {
     m_rteWtrIn = new(nothrow) FLTPT[m_nreach + 1];
     m_rteWtrOut = new(nothrow) FLTPT[m_nreach + 1];
     m_bankSto = new(nothrow) FLTPT[m_nreach + 1];
+    m_chStoAcc = new(nothrow) FLTACC[m_nreach + 1];
+    m_bankStoAcc = new(nothrow) FLTACC[m_nreach + 1];
 
     m_chWtrDepth = new(nothrow) FLTPT[m_nreach + 1];
     m_chWtrWth = new(nothrow) FLTPT[m_nreach + 1];
@@ -125,14 +130,16 @@ void MUSK_CH::InitialOutputs() {
             m_qgRchOut[i] = 0.;
         }
         m_seepage[i] = 0.;
-        m_bankSto[i] = m_Bnk0 * m_chLen[i];
+        m_bankStoAcc[i] = m_Bnk0 * m_chLen[i];
+        m_bankSto[i] = m_bankStoAcc[i];
         m_chBtmWth[i] = ChannleBottomWidth(m_chWth[i], m_chSideSlope[i], m_chDepth[i]);
         m_chCrossArea[i] = ChannelCrossSectionalArea(m_chBtmWth[i], m_chDepth[i], m_chSideSlope[i]);
         m_chWtrDepth[i] = m_chDepth[i] * m_Chs0_perc;
         m_chWtrWth[i] = m_chBtmWth[i] + 2. * m_chSideSlope[i] * m_chWtrDepth[i];
-        m_chSto[i] = m_chLen[i] * m_chWtrDepth[i] * (m_chBtmWth[i] + m_chSideSlope[i] * m_chWtrDepth[i]);
-        m_flowIn[i] = m_chSto[i];
-        m_flowOut[i] = m_chSto[i];
+        m_chStoAcc[i] = m_chLen[i] * m_chWtrDepth[i] * (m_chBtmWth[i] + m_chSideSlope[i] * m_chWtrDepth[i]);
+        m_chSto[i] = m_chStoAcc[i];
+        m_flowIn[i] = m_chStoAcc[i];
+        m_flowOut[i] = m_chStoAcc[i];
         m_rteWtrIn[i] = 0.;
         m_rteWtrOut[i] = 0.;
     }
@@ -181,26 +188,16 @@ int MUSK_CH::Execute() {
     InitialOutputs();
     /// load point source water volume from m_ptSrcFactory
     PointSourceLoading();
-    for (auto it = m_rteLyrs.begin(); it != m_rteLyrs.end(); ++it) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int reachNum = CVT_INT(it->second.size());
-        size_t errCount = 0;
-        // the size of m_rteLyrs (map) is equal to the maximum stream order
-#pragma omp parallel for reduction(+:errCount)
-        for (int i = 0; i < reachNum; i++) {
-            int reachIndex = it->second[i]; // index in the array, i.e., subbasinID
-            if (m_inputSubbsnID == 0 || m_inputSubbsnID == reachIndex) {
-                // for OpenMP version, all reaches will be executed,
-                // for MPI version, only the current reach will be executed.
-                if (!ChannelFlow(reachIndex)) {
-                    errCount++;
-                }
-            }
-        }
-        if (errCount > 0) {
-            throw ModelException(M_MUSK_CH[0], "Execute", "Error occurred!");
-        }
+    int errCount = 0;
+    if (m_inputSubbsnID > 0) {
+        // for MPI version, only the current reach will be executed.
+        if (!ChannelFlow(m_inputSubbsnID)) { errCount++; }
+    } else {
+        // for OpenMP version, each reach will be executed once its upstream reaches are finished.
+        errCount = m_reachScheduler.Execute(this, &MUSK_CH::ChannelFlow);
+    }
+    if (errCount > 0) {
+        throw ModelException(M_MUSK_CH[0], "Execute", "Error occurred!");
     }
     return 0;
 }
@@ -380,11 +377,12 @@ void MUSK_CH::SetReaches(clsReaches* reaches) {
 
     m_reachUpStream = reaches->GetUpStreamIDs();
     m_rteLyrs = reaches->GetReachLayers();
+    m_reachScheduler.Build(reaches->GetUpStreamIDs(), m_rteLyrs);
 }
 
 bool MUSK_CH::ChannelFlow(const int i) {
     // 1. first add all the inflow water
-    FLTPT qIn = 0.; /// Water entering reach on current day from both current subbasin and upstreams
+    FLTACC qIn = 0.; /// Water entering reach on current day from both current subbasin and upstreams
     // 1.1. water from this subbasin
     qIn += m_olQ2Rch[i]; /// surface flow
     FLTPT qiSub = 0.;   /// interflow flow
@@ -433,13 +431,13 @@ bool MUSK_CH::ChannelFlow(const int i) {
         ", UPsurfaceQ: " << qsUp << ", UPsubsurface: " << qiUp << ", UPground: " << qgUp << endl;
 #endif
     // 1.3. water from bank storage
-    FLTPT bankOut = m_bankSto[i] * (1. - CalExp(-m_aBank));
-    m_bankSto[i] -= bankOut;
+    FLTACC bankOut = m_bankStoAcc[i] * (1. - CalExp(-m_aBank));
+    m_bankStoAcc[i] -= bankOut;
     qIn += bankOut / m_dt;
 
     // loss the water from bank storage to the adjacent unsaturated zone and groundwater storage
-    FLTPT bankOutGw = m_bankSto[i] * (1. - CalExp(-m_bBank));
-    m_bankSto[i] -= bankOutGw;
+    FLTACC bankOutGw = m_bankStoAcc[i] * (1. - CalExp(-m_bBank));
+    m_bankStoAcc[i] -= bankOutGw;
     if (nullptr != m_gwSto) {
         m_gwSto[i] += bankOutGw / m_chArea[i] * 1000.; // updated groundwater storage
     }
@@ -502,8 +500,8 @@ bool MUSK_CH::ChannelFlow(const int i) {
     cout << " chStorage before routing " << m_chStorage[i] << endl;
 #endif
     m_rteWtrOut[i] = qIn * m_dt;   // m^3
-    FLTPT wtrin = qIn * m_dt / nn; // Inflow during a sub time interval, m^3
-    FLTPT vol = 0.;               // volume of water in reach, m^3
+    FLTACC wtrin = qIn * m_dt / nn; // Inflow during a sub time interval, m^3
+    FLTACC vol = 0.;              // volume of water in reach, m^3
     FLTPT volrt = 0.;             // flow rate, m^3/s
     FLTPT max_rate = 0.;          // maximum flow capacity of the channel at bank full (m^3/s)
     FLTPT sdti = 0.;              // average flow on day in reach, m^3/s, i.e., m_qRchOut
@@ -511,15 +509,15 @@ bool MUSK_CH::ChannelFlow(const int i) {
     FLTPT rchp = 0.;              // wet perimeter, m
     FLTPT rcharea = 0.;           // cross-sectional area, m^2
     FLTPT rchradius = 0.;         // hydraulic radius
-    FLTPT rtwtr = 0.;             // water leaving reach on day, m^3, i.e., m_rteWtrOut
-    FLTPT rttlc = 0.;             // transmission losses from reach on day, m^3
-    FLTPT qinday = 0.;            // m^3
-    FLTPT qoutday = 0.;           // m^3
+    FLTACC rtwtr = 0.;            // water leaving reach on day, m^3, i.e., m_rteWtrOut
+    FLTACC rttlc = 0.;            // transmission losses from reach on day, m^3
+    FLTACC qinday = 0.;           // m^3
+    FLTACC qoutday = 0.;          // m^3
 
     // Iterate for the day
     for (int ii = 0; ii < nn; ii++) {
         // Calculate volume of water in reach
-        vol = m_chSto[i] + wtrin; // m^3
+        vol = m_chStoAcc[i] + wtrin; // m^3
         // Find average flowrate in a sub time interval, m^3/s
         volrt = vol / (86400. / nn);
         // Find maximum flow capacity of the channel at bank full, m^3/s
@@ -568,23 +566,23 @@ bool MUSK_CH::ChannelFlow(const int i) {
             // Compute water leaving reach on day
             rtwtr = c1 * wtrin + c2 * m_flowIn[i] + c3 * m_flowOut[i];
             if (rtwtr < 0.) rtwtr = 0.;
-            rtwtr = Min(rtwtr, wtrin + m_chSto[i]);
+            rtwtr = Min(rtwtr, wtrin + m_chStoAcc[i]);
             // Calculate amount of water in channel at end of day
-            m_chSto[i] += wtrin - rtwtr;
+            m_chStoAcc[i] += wtrin - rtwtr;
             // Add if statement to keep m_chStorage from becoming negative
-            if (m_chSto[i] < 0.) m_chSto[i] = 0.;
+            if (m_chStoAcc[i] < 0.) m_chStoAcc[i] = 0.;
 
             // Transmission and evaporation losses are proportionally taken from the channel storage
             //   and from volume flowing out
             if (rtwtr > 0.) {
                 // Total time in hours to clear the water
                 rttlc = det * m_Kchb[i] * 0.001 * m_chLen[i] * rchp; // m^3
-                FLTPT rttlc2 = rttlc * m_chSto[i] / (rtwtr + m_chSto[i]);
-                FLTPT rttlc1 = 0.;
-                if (m_chSto[i] <= rttlc2) {
-                    rttlc2 = Min(rttlc2, m_chSto[i]);
+                FLTACC rttlc2 = rttlc * m_chStoAcc[i] / (rtwtr + m_chStoAcc[i]);
+                FLTACC rttlc1 = 0.;
+                if (m_chStoAcc[i] <= rttlc2) {
+                    rttlc2 = Min(rttlc2, m_chStoAcc[i]);
                 }
-                m_chSto[i] -= rttlc2;
+                m_chStoAcc[i] -= rttlc2;
                 rttlc1 = rttlc - rttlc2;
                 if (rtwtr <= rttlc1) {
                     rttlc1 = Min(rttlc1, rtwtr);
@@ -593,9 +591,9 @@ bool MUSK_CH::ChannelFlow(const int i) {
                 rttlc = rttlc1 + rttlc2; // Total water loss by transmission
             }
             // Calculate evaporation
-            FLTPT rtevp = 0.;
-            FLTPT rtevp1 = 0.;
-            FLTPT rtevp2 = 0.;
+            FLTACC rtevp = 0.;
+            FLTACC rtevp1 = 0.;
+            FLTACC rtevp2 = 0.;
             if (rtwtr > 0.) {
                 /// In SWAT source code, line 306 of rtmusk.f, I think aaa should be divided by nn! By lj.
                 FLTPT aaa = m_Epch * m_petSubbsn[i] * 0.001 / nn; // m
@@ -610,11 +608,11 @@ bool MUSK_CH::ChannelFlow(const int i) {
                         rtevp *= m_chLen[i] * m_chWtrWth[i]; // m^3
                     }
                 }
-                rtevp2 = rtevp * m_chSto[i] / (rtwtr + m_chSto[i]);
-                if (m_chSto[i] <= rtevp2) {
-                    rtevp2 = Min(rtevp2, m_chSto[i]);
+                rtevp2 = rtevp * m_chStoAcc[i] / (rtwtr + m_chStoAcc[i]);
+                if (m_chStoAcc[i] <= rtevp2) {
+                    rtevp2 = Min(rtevp2, m_chStoAcc[i]);
                 }
-                m_chSto[i] -= rtevp2;
+                m_chStoAcc[i] -= rtevp2;
                 rtevp1 = rtevp - rtevp2;
                 if (rtwtr <= rtevp1) {
                     rtevp1 = Min(rtevp1, rtwtr);
@@ -633,19 +631,20 @@ bool MUSK_CH::ChannelFlow(const int i) {
         } else {
             rtwtr = 0.;
             sdti = 0.;
-            m_chSto[i] = 0.;
+            m_chStoAcc[i] = 0.;
             m_flowIn[i] = 0.;
             m_flowOut[i] = 0.;
         }
     } /* Iterate for the day */
     if (rtwtr < 0.) rtwtr = 0.;
-    if (m_chSto[i] < 0.) m_chSto[i] = 0.;
-    if (m_chSto[i] < 10.) {
-        rtwtr += m_chSto[i];
-        m_chSto[i] = 0.;
+    if (m_chStoAcc[i] < 0.) m_chStoAcc[i] = 0.;
+    if (m_chStoAcc[i] < 10.) {
+        rtwtr += m_chStoAcc[i];
+        m_chStoAcc[i] = 0.;
     }
     m_qRchOut[i] = sdti;
     m_rteWtrOut[i] = rtwtr;
+    m_chSto[i] = m_chStoAcc[i];
     m_chCrossArea[i] = rcharea;
 
     FLTPT qInSum = m_olQ2Rch[i] + qiSub + qgSub + qsUp + qiUp + qgUp;
@@ -668,11 +667,12 @@ bool MUSK_CH::ChannelFlow(const int i) {
         if (rchp > 0.) {
             trnsrch = m_chBtmWth[i] / rchp; // Use bottom width / wetting perimeter to estimate.
         }
-        m_bankSto[i] += rttlc * (1. - trnsrch); // m^3
+        m_bankStoAcc[i] += rttlc * (1. - trnsrch); // m^3
         if (nullptr != m_gwSto) {
             m_gwSto[i] += rttlc * trnsrch / m_chArea[i] * 1000.; // mm
         }
     }
+    m_bankSto[i] = m_bankStoAcc[i];
 
     // todo, compute revap from bank storage. In SWAT, revap coefficient is equal to gw_revap.
 
@@ -17,6 +17,8 @@
  *                            subbasins for MPI version. And code style review.
  *   - 4. 2018-08-14 - lj - Updates according to SWAT.
  *   - 5. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 6. 2026-10-19 - lj - Channel and bank storages are routed in the precision of accumulators (FLTACC).
+ *   - 7. 2026-10-19 - lj - Route reaches by ReachScheduler instead of stream order layers.
  *
  * \author Liangjun Zhu, Junzhi Liu
  */
@@ -25,6 +27,7 @@
 
 #include "SimulationModule.h"
 #include "Scenario.h"
+#include "ChannelRoutingCommon.h"
 
 using namespace bmps;
 
@@ -123,6 +126,8 @@ private:
      * value: reach ID
      */
     map<int, vector<int> > m_rteLyrs;
+    /// Reach-tree scheduler according to upstream reaches
+    ReachScheduler m_reachScheduler;
 
     /// scenario data
 
@@ -145,9 +150,11 @@ private:
     // Temporary variables
 
     FLTPT* m_ptSub;   ///< The point source discharge (m^3/s) load from m_ptSrcFactory
-    FLTPT* m_flowIn;  ///< flow into reach for routing iteration, m^3
-    FLTPT* m_flowOut; ///< flow out of reach for routing iteration, m^3
+    FLTACC* m_flowIn;  ///< flow into reach for routing iteration, m^3
+    FLTACC* m_flowOut; ///< flow out of reach for routing iteration, m^3
     FLTPT* m_seepage; ///< seepage to deep aquifer
+    FLTACC* m_chStoAcc;   ///< reach storage (m^3) for routing, m_chSto is its copy for outputs
+    FLTACC* m_bankStoAcc; ///< bank storage (m^3) for routing, m_bankSto is its copy for outputs
 
     // Ouputs
 
@@ -81,7 +81,7 @@ int PETHargreaves::Execute() {
         }
         /// calculate the max solar radiation
         FLTPT srMax; /// maximum solar radiation of current day
-        MaxSolarRadiation(m_dayOfYear, m_cellLat[i], m_dayLen[i], srMax);
+        CellMaxSolarRadiation(i, m_cellLat, m_dayLen[i], srMax);
         ///calculate latent heat of vaporization(from swat)
         FLTPT latentHeat = 2.501 - 0.002361 * m_meanTemp[i];
         /// extraterrestrial radiation
@@ -138,7 +138,7 @@ int PETPenmanMonteith::Execute() {
 
         //calculate the max solar radiation
         FLTPT srMax = 0.f;
-        MaxSolarRadiation(m_dayOfYear, m_cellLat[j], m_dayLen[j], srMax);
+        CellMaxSolarRadiation(j, m_cellLat, m_dayLen[j], srMax);
         //calculate net long-wave radiation
         //net emissivity  equation 2.2.20 in SWAT manual
         FLTPT satVaporPressure = SaturationVaporPressure(m_meanTemp[j]); //kPa
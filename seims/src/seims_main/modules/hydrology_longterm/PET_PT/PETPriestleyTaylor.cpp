@@ -79,7 +79,7 @@ int PETPriestleyTaylor::Execute() {
 
         /// calculate the max solar radiation
         FLTPT srMax; /// maximum solar radiation of current day
-        MaxSolarRadiation(m_dayOfYear, m_cellLat[i], m_dayLen[i], srMax);
+        CellMaxSolarRadiation(i, m_cellLat, m_dayLen[i], srMax);
 
         /// calculate net long-wave radiation
         /// net emissivity  equation 2.2.20 in SWAT manual
@@ -130,9 +130,9 @@ int PETPriestleyTaylor::Execute() {
         FLTPT petValue = pet_alpha * (dlt / (dlt + gma)) * raNet / latentHeat;
         m_pet[i] = m_petFactor * Max(0., petValue);
         if (m_pet[i] != m_pet[i]) {
-            cout << "cell id: " << i << ", pet: " << m_pet[i] << ", meanT: " << m_meanTemp[i] <<
+            SLOG(ERROR) << "PET_PT: cell id: " << i << ", pet: " << m_pet[i] << ", meanT: " << m_meanTemp[i] <<
                     ", rhd: " << m_rhd[i] << ", rbo: " << rbo << ", sr: " << m_sr[i] << ", m_srMax: "
-                    << srMax << ", rto: " << rto << ", satVaporPressure: " << satVaporPressure << endl;
+                    << srMax << ", rto: " << rto << ", satVaporPressure: " << satVaporPressure;
             throw ModelException(M_PET_PT[0], "Execute", "Calculation error occurred!\n");
         }
     }
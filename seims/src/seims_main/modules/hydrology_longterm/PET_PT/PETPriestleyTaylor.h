@@ -10,6 +10,7 @@
  *        -# Add m_VPD, m_dayLen as outputs, which will be used in PG_EPIC module
  *        -# Add m_phuBase as outputs, which will be used in MGT_SWAT module
  *   - 3. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 4. 2026-10-19 - lj - Log the invalid PET of cell by SLOG.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
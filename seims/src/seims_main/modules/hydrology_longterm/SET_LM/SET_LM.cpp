@@ -4,11 +4,11 @@
 
 SET_LM::SET_LM() :
     m_nCells(-1), m_maxSoilLyrs(-1), m_nSoilLyrs(nullptr),
-    m_soilThk(nullptr), m_soilWtrSto(nullptr), m_soilFC(nullptr),
+    m_soilThk(nullptr), m_soilWtrSto(nullptr), m_soilFC(),
     m_pet(nullptr), m_IntcpET(nullptr),
     m_deprStoET(nullptr), m_maxPltET(nullptr), m_soilTemp(nullptr),
     m_soilFrozenTemp(NODATA_VALUE),
-    m_soilET(nullptr) {
+    m_soilET(nullptr), m_errLog(SEIMS_LOG_WARNING, "default", 10) {
 }
 
 SET_LM::~SET_LM() {
@@ -42,7 +42,8 @@ int SET_LM::Execute() {
                 m_soilWtrSto[i][j] -= et2d;
             }
             if (isinf(m_soilWtrSto[i][j]) || isnan(m_soilWtrSto[i][j]) || m_soilWtrSto[i][j] < 0.) {
-                cout << "SET_LM: moisture is less than zero" << m_soilWtrSto[i][j] << "\t" << et2d << endl;
+                SLOG_SAMPLED(m_errLog, m_date) << "SET_LM: moisture is less than zero, cell: " << i
+                        << ", layer: " << j << ", moisture: " << m_soilWtrSto[i][j] << ", et: " << et2d;
                 errCount++;
             }
             etDeficiency -= et2d;
@@ -102,7 +103,7 @@ void SET_LM::Set1DData(const char* key, const int nrows, int* data) {
 void SET_LM::Set2DData(const char* key, const int nrows, const int ncols, FLTPT** data) {
     string sk(key);
     CheckInputSize2D(M_SET_LM[0], key, nrows, ncols, m_nCells, m_maxSoilLyrs);
-    if (StringMatch(sk, VAR_SOL_AWC[0])) m_soilFC = data;
+    if (StringMatch(sk, VAR_SOL_AWC[0])) m_soilFC.Set(data);
     else if (StringMatch(sk, VAR_SOL_ST[0])) m_soilWtrSto = data;
     else if (StringMatch(sk, VAR_SOILTHICK[0])) m_soilThk = data;
     else {
@@ -111,6 +112,14 @@ void SET_LM::Set2DData(const char* key, const int nrows, const int ncols, FLTPT*
     }
 }
 
+bool SET_LM::SetClassData(const char* key, const ClassParameter* data) {
+    string sk(key);
+    if (!StringMatch(sk, VAR_SOL_AWC[0])) { return false; }
+    CheckInputSize2D(M_SET_LM[0], key, data->GetCellNumber(), data->GetLayers(), m_nCells, m_maxSoilLyrs);
+    m_soilFC.Set(data);
+    return true;
+}
+
 bool SET_LM::CheckInputData() {
     CHECK_POSITIVE(M_SET_LM[0], m_nCells);
     CHECK_POINTER(M_SET_LM[0], m_soilFC);
@@ -6,6 +6,8 @@
  * Changelog:
  *   - 1. 2018-06-26 - lj - Remove Wilting point since SOL_AWC is preprocessed by FC-WP.
  *   - 2. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 3. 2026-10-19 - lj - Read field capacity of soil layers as class-indexed data.
+ *   - 4. 2026-10-19 - lj - Report negative soil moisture by SLOG_SAMPLED.
  *
  * \author Chunping Ou, Liangjun Zhu
  */
@@ -39,6 +41,8 @@ public:
 
     void Set2DData(const char* key, int nrows, int ncols, FLTPT** data) OVERRIDE;
 
+    bool SetClassData(const char* key, const ClassParameter* data) OVERRIDE;
+
     bool CheckInputData() OVERRIDE;
 
     void InitialOutputs() OVERRIDE;
@@ -54,7 +58,7 @@ private:
     FLTPT** m_soilThk;  ///< Soil thickness of each layer, mm
 
     FLTPT** m_soilWtrSto; ///< soil moisture, mm
-    FLTPT** m_soilFC;     ///< field capacity (FC-WP, same as SWAT), mm
+    ParamRaster2D m_soilFC; ///< field capacity (FC-WP, same as SWAT), mm
     FLTPT* m_pet;         ///< Potential evapotranspiration
     FLTPT* m_IntcpET;     ///< Evaporation from interception
     FLTPT* m_deprStoET;   ///< Evaporation from depression storage
@@ -64,5 +68,7 @@ private:
     FLTPT m_soilFrozenTemp; ///< Freezing temperature
 
     FLTPT* m_soilET; ///< Output, actual soil evaporation
+
+    LogSampler m_errLog; ///< Warnings of invalid soil moisture of cells, sampled per time step
 };
 #endif /* SEIMS_MODULE_SET_LM_H */
@@ -37,10 +37,15 @@ void SOL_WB::SetValue(const char* key, int value) {
 
 void SOL_WB::SetValueToSubbasins() {
     if (m_subbasinsInfo != nullptr) {
-        for (auto it = m_subbasinIDs.begin(); it != m_subbasinIDs.end(); ++it) {
-            Subbasin* curSub = m_subbasinsInfo->GetSubbasinByID(*it);
-            int* cells = curSub->GetCells();
-            int cellsNum = curSub->GetCellCount();
+        // Each subbasin is a segment of the CSR index, thus can be aggregated independently
+        ZoneIndex* subbsn_index = m_subbasinsInfo->GetSubbasinIndex();
+        const vector<int>& subbsn_ids = subbsn_index->GetZoneIDs();
+        int n_subbsns = subbsn_index->GetZoneNumber();
+#pragma omp parallel for schedule(dynamic)
+        for (int k = 0; k < n_subbsns; k++) {
+            int sub_id = subbsn_ids[k];
+            const int* cells = subbsn_index->GetZoneCells(k);
+            int cellsNum = subbsn_index->GetZoneCellCount(k);
             FLTPT ratio = 1. / CVT_FLT(cellsNum);
             FLTPT ri = 0.; // total subsurface runoff of soil profile (mm)
             FLTPT sm = 0.; // total soil moisture of soil profile (mm)
@@ -81,25 +86,25 @@ void SOL_WB::SetValueToSubbasins() {
                 rs += m_surfRf[cell] * ratio;
                 r += (m_surfRf[cell] + ri) * ratio;
             }
-            FLTPT rg = m_RG[*it];
+            FLTPT rg = m_RG[sub_id];
             r += rg;
 
-            m_soilWtrBal[*it][0] = pcp;
-            m_soilWtrBal[*it][1] = meanT;
-            m_soilWtrBal[*it][2] = soilT;
-            m_soilWtrBal[*it][3] = netPcp;
-            m_soilWtrBal[*it][4] = itpET;
-            m_soilWtrBal[*it][5] = depET;
-            m_soilWtrBal[*it][6] = infil;
-            m_soilWtrBal[*it][7] = totalET;
-            m_soilWtrBal[*it][8] = es;
-            m_soilWtrBal[*it][9] = netPerc;
-            m_soilWtrBal[*it][10] = revap;
-            m_soilWtrBal[*it][11] = rs;
-            m_soilWtrBal[*it][12] = ri;
-            m_soilWtrBal[*it][13] = rg;
-            m_soilWtrBal[*it][14] = r;
-            m_soilWtrBal[*it][15] = sm;
+            m_soilWtrBal[sub_id][0] = pcp;
+            m_soilWtrBal[sub_id][1] = meanT;
+            m_soilWtrBal[sub_id][2] = soilT;
+            m_soilWtrBal[sub_id][3] = netPcp;
+            m_soilWtrBal[sub_id][4] = itpET;
+            m_soilWtrBal[sub_id][5] = depET;
+            m_soilWtrBal[sub_id][6] = infil;
+            m_soilWtrBal[sub_id][7] = totalET;
+            m_soilWtrBal[sub_id][8] = es;
+            m_soilWtrBal[sub_id][9] = netPerc;
+            m_soilWtrBal[sub_id][10] = revap;
+            m_soilWtrBal[sub_id][11] = rs;
+            m_soilWtrBal[sub_id][12] = ri;
+            m_soilWtrBal[sub_id][13] = rg;
+            m_soilWtrBal[sub_id][14] = r;
+            m_soilWtrBal[sub_id][15] = sm;
         }
     }
 }
@@ -5,6 +5,7 @@
  * Changelog:
  *   - 1. 2016-07-28 - lj - Move subbasin class to base/data/clsSubbasin, to keep consistent with other modules.
  *   - 2. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 3. 2026-10-19 - lj - Aggregate subbasins in parallel by the CSR index of clsSubbasins.
  *
  * \author Chunping Ou, Liangjun Zhu
  */
@@ -13,7 +13,8 @@ SSR_DA::SSR_DA() :
     m_rchID(nullptr), m_flowInIdx(nullptr), m_flowInFrac(nullptr), m_rteLyrs(nullptr),
     m_nRteLyrs(-1), m_nSubbsns(-1), m_subbsnID(nullptr),
     /// outputs
-    m_subSurfRf(nullptr), m_subSurfRfVol(nullptr), m_ifluQ2Rch(nullptr) {
+    m_subSurfRf(nullptr), m_subSurfRfVol(nullptr), m_ifluQ2Rch(nullptr),
+    m_errLog(SEIMS_LOG_WARNING, "default", 10) {
 }
 
 SSR_DA::~SSR_DA() {
@@ -77,9 +78,9 @@ bool SSR_DA::FlowInSoil(const int id) {
             continue;
         }
         if (m_soilWtrSto[id][j] != m_soilWtrSto[id][j] || m_soilWtrSto[id][j] < 0.) {
-            cout << "cell id: " << id << ", layer: " << j << ", moisture is less than zero: "
-                    << m_soilWtrSto[id][j] << ", previous: " << smOld << ", qUp: " << qUp << ", depth:"
-                    << m_soilThk[id][j] << endl;
+            SLOG_SAMPLED(m_errLog, m_date) << "SSR_DA: cell id: " << id << ", layer: " << j
+                    << ", moisture is less than zero: " << m_soilWtrSto[id][j] << ", previous: " << smOld
+                    << ", qUp: " << qUp << ", depth:" << m_soilThk[id][j];
             return false;
         }
 
@@ -131,9 +132,9 @@ bool SSR_DA::FlowInSoil(const int id) {
         m_soilWtrStoPrfl[id] += m_soilWtrSto[id][j];
 
         if (isinf(m_soilWtrSto[id][j]) ||isnan(m_soilWtrSto[id][j]) || m_soilWtrSto[id][j] < 0.) {
-            cout << "cell id: " << id << ", layer: " << j << ", moisture is less than zero: "
-                    << m_soilWtrSto[id][j] << ", subsurface runoff: " << m_subSurfRf[id][j] << ", depth:"
-                    << m_soilThk[id][j] << endl;
+            SLOG_SAMPLED(m_errLog, m_date) << "SSR_DA: cell id: " << id << ", layer: " << j
+                    << ", moisture is less than zero: " << m_soilWtrSto[id][j] << ", subsurface runoff: "
+                    << m_subSurfRf[id][j] << ", depth:" << m_soilThk[id][j];
             return false;
         }
     }
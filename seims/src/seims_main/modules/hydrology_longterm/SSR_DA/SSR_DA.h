@@ -9,6 +9,7 @@
  *                           raster data according to subbasin ID.
  *   - 3. 2021-04-07 - lj - Support different flow direction algorithms
  *   - 4. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 5. 2026-10-19 - lj - Invalid soil moisture of cells are logged by sampled warnings.
  *
  * \author Zhiqiang Yu, Junzhi Liu, Liangjun Zhu
  */
@@ -150,6 +151,9 @@ private:
     FLTPT **m_subSurfRfVol;
     /// subsurface to streams from each subbasin, the first element is the whole watershed, m^3/s, VAR_SBIF
     FLTPT *m_ifluQ2Rch;
+
+    /// warnings of invalid soil moisture of cells, sampled per time step
+    LogSampler m_errLog;
 };
 
 #endif /* SEIMS_MODULE_SSR_DA_H */
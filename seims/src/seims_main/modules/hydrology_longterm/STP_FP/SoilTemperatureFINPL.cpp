@@ -12,7 +12,7 @@ SoilTemperatureFINPL::SoilTemperatureFINPL() :
     m_soilTempRelFactor10(nullptr),
     m_landUse(nullptr), m_meanTemp(nullptr), m_meanTempPre1(nullptr),
     m_meanTempPre2(nullptr),
-    m_soilTemp(nullptr) {
+    m_soilTemp(nullptr), m_errLog(SEIMS_LOG_WARNING, "default", 10) {
 }
 
 SoilTemperatureFINPL::~SoilTemperatureFINPL() {
@@ -31,7 +31,8 @@ int SoilTemperatureFINPL::Execute() {
         FLTPT t1 = m_meanTempPre1[i];
         FLTPT t2 = m_meanTempPre2[i];
         if ((t > 60. || t < -90.) || (t1 > 60. || t1 < -90.) || (t2 > 60. || t2 < -90.)) {
-            cout << "cell index: " << i << ", t1: " << t1 << ", t2: " << t2 << endl;
+            SLOG_SAMPLED(m_errLog, m_date) << "STP_FP: cell index: " << i << ", t: " << t << ", t1: " << t1
+                    << ", t2: " << t2;
             errCount++;
         } else {
             if (m_landUse[i] == LANDUSE_ID_WATR) { /// if current landuse is water
@@ -42,10 +43,10 @@ int SoilTemperatureFINPL::Execute() {
                         + m_b2 * sin(2. * radWt * m_dayOfYear) + m_d2 * cos(2. * radWt * m_dayOfYear);
                 m_soilTemp[i] = t10 * m_kSoil10 + m_soilTempRelFactor10[i];
                 if (m_soilTemp[i] > 60. || m_soilTemp[i] < -90.) {
-                    cout << "The calculated soil temperature at cell (" << i
+                    SLOG_SAMPLED(m_errLog, m_date) << "STP_FP: The calculated soil temperature at cell (" << i
                             << ") is out of reasonable range: " << m_soilTemp[i]
                             << ". JulianDay: " << m_dayOfYear << ",t: " << t << ", t1: "
-                            << t1 << ", t2: " << t2 << ", relativeFactor: " << m_soilTempRelFactor10[i] << endl;
+                            << t1 << ", t2: " << t2 << ", relativeFactor: " << m_soilTempRelFactor10[i];
                     errCount++;
                 }
             }
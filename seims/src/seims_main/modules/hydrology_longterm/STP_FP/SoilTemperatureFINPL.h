@@ -6,6 +6,7 @@
  *   - 1. 2011-01-05 - jz - Initial implementation.
  *   - 2. 2016-05-27 - lj - Code review and reformat.
  *   - 3. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 4. 2026-10-19 - lj - Sampled warnings of out-of-range temperature in the OpenMP loop.
  *
  * \author Junzhi Liu, Liangjun Zhu
  */
@@ -75,5 +76,8 @@ private:
 
     /// output soil temperature
     FLTPT* m_soilTemp;
+
+    /// warnings of out-of-range temperature of cells, sampled per time step
+    LogSampler m_errLog;
 };
 #endif /* SEIMS_MODULE_STP_FP_H */
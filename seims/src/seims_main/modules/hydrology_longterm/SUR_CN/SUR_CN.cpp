@@ -3,7 +3,7 @@
 
 SUR_CN::SUR_CN(void) : m_nCells(-1), m_Tsnow(NODATA_VALUE), m_Tsoil(NODATA_VALUE), m_T0(NODATA_VALUE),
                        m_Sfrozen(NODATA_VALUE),
-                       m_cn2(NULL), m_initSoilMoisture(NULL), m_rootDepth(NULL),
+                       m_initSoilMoisture(NULL), m_rootDepth(NULL),
                        m_soilDepth(NULL), m_porosity(NULL), m_fieldCap(NULL), m_wiltingPoint(NULL),
                        m_P_NET(NULL), m_SD(NULL), m_tMean(NULL), m_TS(NULL), m_SM(NULL), m_SA(NULL),
                        m_PE(NULL), m_INFIL(NULL), m_soilMoisture(NULL),
@@ -53,7 +53,7 @@ bool SUR_CN::CheckInputData(void) {
                              "The snowmelt threshold temperature of the input data can not be NULL.");
         return false;
     }
-    if (m_cn2 == NULL) {
+    if (m_cn2.IsNull()) {
         throw ModelException(M_SUR_CN[0], "CheckInputData",
                              "The CN under moisture condition II of the input data can not be NULL.");
         return false;
@@ -120,16 +120,16 @@ void SUR_CN:: InitialOutputs() {
     }
     // allocate the output variables
     if (m_PE == NULL) {
-        m_PE = new float[m_nCells];
-        m_INFIL = new float[m_nCells];
+        m_PE = new FLTPT[m_nCells];
+        m_INFIL = new FLTPT[m_nCells];
 
-        m_soilMoisture = new float *[m_nCells];
+        m_soilMoisture = new FLTPT *[m_nCells];
 #pragma omp parallel for
         for (int i = 0; i < m_nCells; i++) {
             m_PE[i] = 0.0f;
             m_INFIL[i] = 0.0f;
 
-            m_soilMoisture[i] = new float[m_nSoilLayers];
+            m_soilMoisture[i] = new FLTPT[m_nSoilLayers];
             for (int j = 0; j < m_nSoilLayers; j++) {
                 m_soilMoisture[i][j] = m_initSoilMoisture[i] * m_fieldCap[i][j];
             }
@@ -142,19 +142,25 @@ int SUR_CN::Execute() {
     CheckInputData();
     InitialOutputs();
 
-    float cnday;
-    float pNet, surfq, infil;
+    FLTPT cnday;
+    FLTPT pNet, surfq, infil;
 
+    // the dry cells without net precipitation, depression storage, and snowmelt produce nothing
+    const FLTPT* states[3] = {m_P_NET, m_SD, m_SM};
+    int nIter = RefreshActiveCells(m_nCells, states, 3);
+    ResetReleasedCells(m_PE);
+    ResetReleasedCells(m_INFIL);
 #pragma omp parallel for
-    for (int iCell = 0; iCell < m_nCells; iCell++) {
+    for (int idx = 0; idx < nIter; idx++) {
+        int iCell = ActiveCellIndex(idx);
         //initialize the variables
         surfq = 0.0f;
         infil = 0.0f;
         pNet = 0.0f;
-        float pcp = m_P_NET[iCell];  //rainfall - interception
-        float dep = 0.0f;  //depression storage
-        float snm = 0.0f;  //snowmelt
-        float t = 0.0f;  // air temperature
+        FLTPT pcp = m_P_NET[iCell];  //rainfall - interception
+        FLTPT dep = 0.0f;  //depression storage
+        FLTPT snm = 0.0f;  //snowmelt
+        FLTPT t = 0.0f;  // air temperature
 
         //set values to variables
         if (m_SD == NULL)        // the depression storage module is not available, set the initial depression storage
@@ -188,8 +194,8 @@ int SUR_CN::Execute() {
         }
 
         if (pNet > 0.0f) {
-            float sm = 0.f;
-            float por = 0.f;
+            FLTPT sm = 0.f;
+            FLTPT por = 0.f;
             //float aboveDepth = 0.f;
 
             int curSoilLayers = -1, j;
@@ -227,8 +233,8 @@ int SUR_CN::Execute() {
                 //for CN method
             else {
                 cnday = Calculate_CN(sm, iCell);
-                float bb, pb;
-                float s = 0.0f;
+                FLTPT bb, pb;
+                FLTPT s = 0.0f;
                 bb = 0.0f;
                 pb = 0.0f;
                 s = 25400.0f / cnday - 254.0f;
@@ -268,6 +274,8 @@ int SUR_CN::Execute() {
             m_INFIL[iCell] = 0.0f;
         }
     }
+    CheckInactiveCells(M_SUR_CN[0], VAR_EXCP[0], m_PE);
+    CheckInactiveCells(M_SUR_CN[0], VAR_INFIL[0], m_INFIL);
     return 0;
 }
 
@@ -288,7 +296,7 @@ bool SUR_CN::CheckInputSize(const char *key, int n) {
     return true;
 }
 
-void SUR_CN::SetValue(const char *key, float value) {
+void SUR_CN::SetValue(const char *key, FLTPT value) {
     string sk(key);
     if (StringMatch(sk, VAR_T_SNOW[0])) { m_Tsnow = value; }
     else if (StringMatch(sk, VAR_T_SOIL[0])) { m_Tsoil = value; }
@@ -301,11 +309,11 @@ void SUR_CN::SetValue(const char *key, float value) {
     }
 }
 
-void SUR_CN::Set1DData(const char *key, int n, float *data) {
+void SUR_CN::Set1DData(const char *key, int n, FLTPT *data) {
     CheckInputSize(key, n);
     string sk(key);
 
-    if (StringMatch(sk, VAR_CN2[0])) { m_cn2 = data; }
+    if (StringMatch(sk, VAR_CN2[0])) { m_cn2.Set(data); }
     else if (StringMatch(sk, VAR_MOIST_IN[0])) { m_initSoilMoisture = data; }
     else if (StringMatch(sk, VAR_ROOTDEPTH[0])) { m_rootDepth = data; }
     else if (StringMatch(sk, VAR_NEPR[0])) { m_P_NET = data; }
@@ -321,7 +329,17 @@ void SUR_CN::Set1DData(const char *key, int n, float *data) {
     }
 }
 
-void SUR_CN::Set2DData(const char *key, int nrows, int ncols, float **data) {
+bool SUR_CN::SetClassData(const char *key, const ClassParameter *data) {
+    string sk(key);
+    if (StringMatch(sk, VAR_CN2[0])) {
+        CheckInputSize(key, data->GetCellNumber());
+        m_cn2.Set(data);
+        return true;
+    }
+    return false;
+}
+
+void SUR_CN::Set2DData(const char *key, int nrows, int ncols, FLTPT **data) {
     string sk(key);
     CheckInputSize(key, nrows);
     m_nSoilLayers = ncols;
@@ -335,7 +353,7 @@ void SUR_CN::Set2DData(const char *key, int nrows, int ncols, float **data) {
     }
 }
 
-void SUR_CN::Get1DData(const char *key, int *n, float **data) {
+void SUR_CN::Get1DData(const char *key, int *n, FLTPT **data) {
     string sk(key);
 
     if (StringMatch(sk, VAR_INFIL[0])) { *data = m_INFIL; }
@@ -348,7 +366,7 @@ void SUR_CN::Get1DData(const char *key, int *n, float **data) {
     *n = m_nCells;
 }
 
-void SUR_CN::Get2DData(const char *key, int *nRows, int *nCols, float ***data) {
+void SUR_CN::Get2DData(const char *key, int *nRows, int *nCols, FLTPT ***data) {
     string sk(key);
     *nRows = m_nCells;
     *nCols = m_nSoilLayers;
@@ -359,8 +377,8 @@ void SUR_CN::Get2DData(const char *key, int *nRows, int *nCols, float ***data) {
     }
 }
 
-float SUR_CN::Calculate_CN(float sm, int cell) {
-    float sw, s, CNday, xx;
+FLTPT SUR_CN::Calculate_CN(FLTPT sm, int cell) {
+    FLTPT sw, s, CNday, xx;
 
     s = 0.;
     sw = sm * m_rootDepth[cell];
@@ -380,16 +398,16 @@ float SUR_CN::Calculate_CN(float sm, int cell) {
 }
 
 void SUR_CN::initalW1W2() {
-    m_w1 = new float[m_nCells];
-    m_w2 = new float[m_nCells];
-    m_sMax = new float[m_nCells];
+    m_w1 = new FLTPT[m_nCells];
+    m_w2 = new FLTPT[m_nCells];
+    m_sMax = new FLTPT[m_nCells];
     if (m_upSoilDepth == NULL) {
-        m_upSoilDepth = new float[m_nSoilLayers];
+        m_upSoilDepth = new FLTPT[m_nSoilLayers];
     }
 
     for (int i = 0; i < m_nCells; i++) {
-        float fieldcap = 0.f;
-        float wsat = 0.f;
+        FLTPT fieldcap = 0.f;
+        FLTPT wsat = 0.f;
         //float aboveDepth = 0.f;
         ///// add by LJ.
         int curSoilLayers = -1, j;
@@ -411,10 +429,10 @@ void SUR_CN::initalW1W2() {
         /* fieldcap += m_fieldCap[i][m_nSoilLayers - 1] * (m_rootDepth[i] - aboveDepth);
          wsat += m_porosity[i][m_nSoilLayers - 1] * (m_rootDepth[i] - aboveDepth);*/
 
-        float cnn = m_cn2[i];
+        FLTPT cnn = m_cn2[i];
         //float fieldcap = m_fieldCap[i] * m_rootDepth[i];
         //float wsat = m_porosity[i] * m_rootDepth[i];
-        float c1, c3, c2, smx, s3, rto3, rtos, xx, wrt1, wrt2;
+        FLTPT c1, c3, c2, smx, s3, rto3, rtos, xx, wrt1, wrt2;
         c2 = 100.0f - cnn;
         c1 = cnn - 20.f * c2 / (c2 + CalExp(2.533f - 0.0636f * c2));    //CN1  2:1.1.4
         c1 = Max(c1, 0.4f * cnn);
@@ -194,8 +194,14 @@ int SUR_GreenAmpt::Execute() {
     float adj_hc, sol_k, cnday, psidt, tst, f1, pNet;
     float rateinf0, rateinf, cuminf, rintns, wfmp;
 
+    // the dry cells without net precipitation, depression storage, and snowmelt produce nothing
+    const float* states[3] = {m_P_NET, m_SD, m_SM};
+    int nIter = RefreshActiveCells(m_cellSize, states, 3);
+    ResetReleasedCells(m_PE);
+    ResetReleasedCells(m_INFIL);
 #pragma omp parallel for
-    for (int iCell = 0; iCell < m_cellSize; iCell++) {
+    for (int idx = 0; idx < nIter; idx++) {
+        int iCell = ActiveCellIndex(idx);
         //initialize the variables
         rateinf = 0.0f;
         cuminf = 0.0f;
@@ -327,6 +333,8 @@ int SUR_GreenAmpt::Execute() {
                                      + oss.str() + "Please contact the module developer. ");
         }
     }
+    CheckInactiveCells("SUR_GreenAmpt", VAR_EXCP[0], m_PE);
+    CheckInactiveCells("SUR_GreenAmpt", VAR_INFIL[0], m_INFIL);
     return 0;
 }
 
@@ -9,10 +9,10 @@ Nutrient_Transformation::Nutrient_Transformation() :
     m_tillSwitch(nullptr), m_tillDepth(nullptr), m_tillDays(nullptr), m_tillFactor(nullptr),
     m_minrlCoef(-1.), m_orgNFrActN(-1.), m_denitThres(-1.), m_phpSorpIdxBsn(-1.),
     m_phpSorpIdx(nullptr), m_psp_store(nullptr), m_ssp_store(nullptr), m_denitCoef(-1.), m_landCover(nullptr),
-    m_pltRsdDecCoef(nullptr), m_rsdCovSoil(nullptr), m_rsdInitSoil(nullptr), m_soilTemp(nullptr),
+    m_pltRsdDecCoef(), m_rsdCovSoil(nullptr), m_rsdInitSoil(nullptr), m_soilTemp(nullptr),
     m_soilBD(nullptr), m_soilMass(nullptr), m_soilCbn(nullptr),
     m_soilWtrSto(nullptr), m_soilFC(nullptr), m_soilDepth(nullptr),
-    m_soilClay(nullptr), m_soilRock(nullptr), m_soilThk(nullptr),
+    m_soilClay(), m_soilRock(), m_soilThk(nullptr),
     m_soilActvOrgN(nullptr), m_soilFrshOrgN(nullptr), m_soilFrshOrgP(nullptr),
     m_soilActvMinP(nullptr), m_soilStabMinP(nullptr), m_soilSat(nullptr), m_soilPor(nullptr),
     /// from other modules
@@ -146,7 +146,7 @@ void Nutrient_Transformation::Set1DData(const char* key, const int n, FLTPT* dat
     CheckInputSize(M_NUTR_TF[0], key, n, m_nCells);
     string sk(key);
     if (StringMatch(sk, VAR_PL_RSDCO[0])) {
-        m_pltRsdDecCoef = data;
+        m_pltRsdDecCoef.Set(data);
     } else if (StringMatch(sk, VAR_SOL_RSDIN[0])) {
         m_rsdInitSoil = data;
     } else if (StringMatch(sk, VAR_SOL_COV[0])) {
@@ -195,9 +195,9 @@ void Nutrient_Transformation::Set2DData(const char* key, const int nrows, const
     } else if (StringMatch(sk, VAR_SOL_BD[0])) {
         m_soilBD = data;
     } else if (StringMatch(sk, VAR_CLAY[0])) {
-        m_soilClay = data;
+        m_soilClay.Set(data);
     } else if (StringMatch(sk, VAR_ROCK[0])) {
-        m_soilRock = data;
+        m_soilRock.Set(data);
     } else if (StringMatch(sk, VAR_SOL_ST[0])) {
         m_soilWtrSto = data;
     } else if (StringMatch(sk, VAR_SOL_AWC[0])) {
@@ -232,6 +232,26 @@ void Nutrient_Transformation::Set2DData(const char* key, const int nrows, const
     }
 }
 
+bool Nutrient_Transformation::SetClassData(const char* key, const ClassParameter* data) {
+    string sk(key);
+    if (StringMatch(sk, VAR_PL_RSDCO[0])) {
+        CheckInputSize(M_NUTR_TF[0], key, data->GetCellNumber(), m_nCells);
+        m_pltRsdDecCoef.Set(data);
+        return true;
+    }
+    if (StringMatch(sk, VAR_CLAY[0]) || StringMatch(sk, VAR_ROCK[0])) {
+        CheckInputSize2D(M_NUTR_TF[0], key, data->GetCellNumber(), data->GetLayers(),
+                         m_nCells, m_maxSoilLyrs);
+        if (StringMatch(sk, VAR_CLAY[0])) {
+            m_soilClay.Set(data);
+        } else {
+            m_soilRock.Set(data);
+        }
+        return true;
+    }
+    return false;
+}
+
 void Nutrient_Transformation::InitialOutputs() {
     CHECK_POSITIVE(M_NUTR_TF[0], m_nCells);
     if (m_cellAreaFr < 0.) m_cellAreaFr = 1. / m_nCells;
@@ -11,6 +11,7 @@
  *   - 3. 2018-05-08 - lj - Reformat, especially naming style (sync update in "text.h").
  *                          Code optimization, e.g., use multiply instead of divide.
  *   - 4. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 5. 2026-10-19 - lj - Read residue decomposition coefficient, clay and rock content as class-indexed data.
  *
  * \author Huiran Gao, Liangjun Zhu
  */
@@ -52,6 +53,8 @@ public:
 
     void Set2DData(const char* key, int nRows, int nCols, FLTPT** data) OVERRIDE;
 
+    bool SetClassData(const char* key, const ClassParameter* data) OVERRIDE;
+
     bool CheckInputData() OVERRIDE;
 
     void InitialOutputs() OVERRIDE;
@@ -158,7 +161,7 @@ private:
     ///plant residue decomposition coefficient.
     ///  The fraction of residue which will decompose in a day assuming optimal moisture,
     ///  temperature, C:N ratio, and C:P ratio
-    FLTPT* m_pltRsdDecCoef;
+    ParamRaster1D m_pltRsdDecCoef;
     ///amount of residue on soil surface (kg/ha)
     FLTPT* m_rsdCovSoil;
     /// initial amount of organic matter in the soil classified as residue(kg/ha)
@@ -179,9 +182,9 @@ private:
     ///depth to bottom of soil layer
     FLTPT** m_soilDepth;
     ///Percent of clay content
-    FLTPT** m_soilClay;
+    ParamRaster2D m_soilClay;
     /// percent of rock content
-    FLTPT** m_soilRock;
+    ParamRaster2D m_soilRock;
     /// thick of each soil layer
     FLTPT** m_soilThk;
     ///amount of nitrogen stored in the active organic (humic) nitrogen pool(kg N/ha)
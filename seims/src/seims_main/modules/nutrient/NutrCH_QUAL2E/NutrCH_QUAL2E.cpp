@@ -26,7 +26,9 @@ NutrCH_QUAL2E::NutrCH_QUAL2E() :
     m_chNH4(nullptr),
     // nutrient storage in channel
     m_chNO2(nullptr), m_chNO3(nullptr), m_chTN(nullptr), m_chOrgP(nullptr), m_chSolP(nullptr), m_chTP(nullptr),
-    m_chCOD(nullptr), m_chDOx(nullptr), m_chChlora(nullptr), m_chSatDOx(NODATA_VALUE), m_chOutAlgae(nullptr),
+    m_chCOD(nullptr), m_chDOx(nullptr), m_chChlora(nullptr),
+    m_chStrNO3(nullptr), m_chStrNH4(nullptr), m_chStrTN(nullptr), m_chStrTP(nullptr),
+    m_chSatDOx(NODATA_VALUE), m_chOutAlgae(nullptr),
     m_chOutAlgaeConc(nullptr),
     m_chOutChlora(nullptr),
     // nutrient amount outputs of channels
@@ -52,9 +54,22 @@ NutrCH_QUAL2E::~NutrCH_QUAL2E() {
     if (nullptr != m_ptTPToCh) Release1DArray(m_ptTPToCh);
     if (nullptr != m_ptCODToCh) Release1DArray(m_ptCODToCh);
     /// storage in channel
+    if (nullptr != m_chAlgae) Release1DArray(m_chAlgae);
+    if (nullptr != m_chOrgN) Release1DArray(m_chOrgN);
+    if (nullptr != m_chOrgP) Release1DArray(m_chOrgP);
+    if (nullptr != m_chNH4) Release1DArray(m_chNH4);
+    if (nullptr != m_chNO2) Release1DArray(m_chNO2);
+    if (nullptr != m_chNO3) Release1DArray(m_chNO3);
+    if (nullptr != m_chSolP) Release1DArray(m_chSolP);
+    if (nullptr != m_chDOx) Release1DArray(m_chDOx);
+    if (nullptr != m_chCOD) Release1DArray(m_chCOD);
     if (nullptr != m_chTN) Release1DArray(m_chTN);
     if (nullptr != m_chTP) Release1DArray(m_chTP);
     if (nullptr != m_chChlora) Release1DArray(m_chChlora);
+    if (nullptr != m_chStrNO3) Release1DArray(m_chStrNO3);
+    if (nullptr != m_chStrNH4) Release1DArray(m_chStrNH4);
+    if (nullptr != m_chStrTN) Release1DArray(m_chStrTN);
+    if (nullptr != m_chStrTP) Release1DArray(m_chStrTP);
     /// amount out of channel
     if (nullptr != m_chOutChlora) Release1DArray(m_chOutChlora);
     if (nullptr != m_chOutAlgae) Release1DArray(m_chOutAlgae);
@@ -298,10 +313,10 @@ void NutrCH_QUAL2E::SetValueByIndex(const char* key, const int index, const FLTP
     else if (StringMatch(sk, VAR_CH_TP[0])) m_chOutTP[index] = data;
     else if (StringMatch(sk, VAR_CH_TPConc[0])) m_chOutTPConc[index] = data;
         // nutrient stored in reaches
-    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) m_chNO3[index] = data;
-    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) m_chNH4[index] = data;
-    else if (StringMatch(sk, VAR_CHSTR_TN[0])) m_chTN[index] = data;
-    else if (StringMatch(sk, VAR_CHSTR_TP[0])) m_chTP[index] = data;
+    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) m_chStrNO3[index] = m_chNO3[index] = data;
+    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) m_chStrNH4[index] = m_chNH4[index] = data;
+    else if (StringMatch(sk, VAR_CHSTR_TN[0])) m_chStrTN[index] = m_chTN[index] = data;
+    else if (StringMatch(sk, VAR_CHSTR_TP[0])) m_chStrTP[index] = m_chTP[index] = data;
     else {
         throw ModelException(M_NUTRCH_QUAL2E[0], "SetValueByIndex",
                              "Parameter " + sk + " does not exist.");
@@ -342,6 +357,7 @@ void NutrCH_QUAL2E::Set1DData(const char* key, const int n, FLTPT* data) {
             m_chSolP[i] *= cvt_conc2amount;
             m_chDOx[i] *= cvt_conc2amount;
             m_chCOD[i] *= cvt_conc2amount;
+            UpdateExportedStorage(i);
         }
     } else if (StringMatch(sk, VAR_RTE_WTRIN[0])) m_rteWtrIn = data;
     else if (StringMatch(sk, VAR_RTE_WTROUT[0])) m_rteWtrOut = data;
@@ -405,22 +421,30 @@ void NutrCH_QUAL2E::SetReaches(clsReaches* reaches) {
     if (nullptr == m_rs4) reaches->GetReachesSingleProperty(REACH_RS4, &m_rs4);
     if (nullptr == m_rs5) reaches->GetReachesSingleProperty(REACH_RS5, &m_rs5);
     /// these parameters' unit is mg/L now, and will be converted to kg in Set1DData.
-    if (nullptr == m_chAlgae) reaches->GetReachesSingleProperty(REACH_ALGAE, &m_chAlgae);
-    if (nullptr == m_chOrgN) reaches->GetReachesSingleProperty(REACH_ORGN, &m_chOrgN);
-    if (nullptr == m_chOrgP) reaches->GetReachesSingleProperty(REACH_ORGP, &m_chOrgP);
-    if (nullptr == m_chNH4) reaches->GetReachesSingleProperty(REACH_NH4, &m_chNH4);
-    if (nullptr == m_chNO2) reaches->GetReachesSingleProperty(REACH_NO2, &m_chNO2);
-    if (nullptr == m_chNO3) reaches->GetReachesSingleProperty(REACH_NO3, &m_chNO3);
-    if (nullptr == m_chSolP) reaches->GetReachesSingleProperty(REACH_SOLP, &m_chSolP);
-    if (nullptr == m_chDOx) reaches->GetReachesSingleProperty(REACH_DISOX, &m_chDOx);
-    if (nullptr == m_chCOD) reaches->GetReachesSingleProperty(REACH_BOD, &m_chCOD);
+    /// The storages are copied since they are accumulated in the precision of accumulators.
+    const char* storage_keys[9] = {REACH_ALGAE, REACH_ORGN, REACH_ORGP, REACH_NH4, REACH_NO2,
+                                   REACH_NO3, REACH_SOLP, REACH_DISOX, REACH_BOD};
+    FLTACC** storages[9] = {&m_chAlgae, &m_chOrgN, &m_chOrgP, &m_chNH4, &m_chNO2,
+                            &m_chNO3, &m_chSolP, &m_chDOx, &m_chCOD};
+    for (int i = 0; i < 9; i++) {
+        if (nullptr != *storages[i]) continue;
+        FLTPT* tmp = nullptr;
+        reaches->GetReachesSingleProperty(storage_keys[i], &tmp);
+        Initialize1DArray(m_nReaches + 1, *storages[i], tmp);
+    }
 
     if (nullptr == m_chChlora) Initialize1DArray(m_nReaches + 1, m_chChlora, 0.);
     if (nullptr == m_chTP) Initialize1DArray(m_nReaches + 1, m_chTP, 0.);
     if (nullptr == m_chTN) Initialize1DArray(m_nReaches + 1, m_chTN, 0.);
 
+    if (nullptr == m_chStrNO3) Initialize1DArray(m_nReaches + 1, m_chStrNO3, m_chNO3);
+    if (nullptr == m_chStrNH4) Initialize1DArray(m_nReaches + 1, m_chStrNH4, m_chNH4);
+    if (nullptr == m_chStrTN) Initialize1DArray(m_nReaches + 1, m_chStrTN, m_chTN);
+    if (nullptr == m_chStrTP) Initialize1DArray(m_nReaches + 1, m_chStrTP, m_chTP);
+
     m_reachUpStream = reaches->GetUpStreamIDs();
     m_reachLayers = reaches->GetReachLayers();
+    m_reachScheduler.Build(m_reachUpStream, m_reachLayers);
 }
 
 void NutrCH_QUAL2E::SetScenario(Scenario* sce) {
@@ -556,24 +580,23 @@ int NutrCH_QUAL2E::Execute() {
     // Calculate average day length, solar radiation, and temperature for each channel
     ParametersSubbasinForChannel();
 
-    for (auto it = m_reachLayers.begin(); it != m_reachLayers.end(); ++it) {
-        // There are not any flow relationship within each routing layer.
-        // So parallelization can be done here.
-        int reachNum = CVT_INT(it->second.size());
-        // the size of m_reachLayers (map) is equal to the maximum stream order
-#pragma omp parallel for
-        for (int i = 0; i < reachNum; i++) {
-            int reachIndex = it->second[i];
-            if (m_inputSubbsnID == 0 || m_inputSubbsnID == reachIndex) {
-                NutrientTransform(reachIndex);
-                AddInputNutrient(reachIndex);
-                RouteOut(reachIndex);
-            }
-        }
+    if (m_inputSubbsnID > 0) {
+        // for MPI version, only the current reach will be executed.
+        ReachRouting(m_inputSubbsnID);
+    } else {
+        // for OpenMP version, each reach will be executed once its upstream reaches are finished.
+        m_reachScheduler.Execute(this, &NutrCH_QUAL2E::ReachRouting);
     }
     return 0;
 }
 
+void NutrCH_QUAL2E::ReachRouting(const int i) {
+    NutrientTransform(i);
+    AddInputNutrient(i);
+    RouteOut(i);
+    UpdateExportedStorage(i);
+}
+
 void NutrCH_QUAL2E::AddInputNutrient(const int i) {
     /// nutrient amount from upstream routing will be accumulated to current storage
     for (auto upRchID = m_reachUpStream.at(i).begin(); upRchID != m_reachUpStream.at(i).end(); ++upRchID) {
@@ -1080,6 +1103,13 @@ void NutrCH_QUAL2E::NutrientTransform(const int i) {
     m_chDOx[i] = ddisox * wtrTotal / 1000.;
 }
 
+void NutrCH_QUAL2E::UpdateExportedStorage(const int i) {
+    m_chStrNO3[i] = m_chNO3[i];
+    m_chStrNH4[i] = m_chNH4[i];
+    m_chStrTN[i] = m_chTN[i];
+    m_chStrTP[i] = m_chTP[i];
+}
+
 FLTPT NutrCH_QUAL2E::corTempc(const FLTPT r20, const FLTPT thk, const FLTPT tmp) {
     return r20 * CalPow(thk, tmp - 20.);
 }
@@ -1113,10 +1143,10 @@ void NutrCH_QUAL2E::GetValue(const char* key, FLTPT* value) {
     else if (StringMatch(sk, VAR_CH_TP[0])) *value = m_chOutTP[m_inputSubbsnID];
     else if (StringMatch(sk, VAR_CH_TPConc[0])) *value = m_chOutTPConc[m_inputSubbsnID];
         /// output nutrient storage in channel
-    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) *value = m_chNO3[m_inputSubbsnID];
-    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) *value = m_chNH4[m_inputSubbsnID];
-    else if (StringMatch(sk, VAR_CHSTR_TN[0])) *value = m_chTN[m_inputSubbsnID];
-    else if (StringMatch(sk, VAR_CHSTR_TP[0])) *value = m_chTP[m_inputSubbsnID];
+    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) *value = m_chStrNO3[m_inputSubbsnID];
+    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) *value = m_chStrNH4[m_inputSubbsnID];
+    else if (StringMatch(sk, VAR_CHSTR_TN[0])) *value = m_chStrTN[m_inputSubbsnID];
+    else if (StringMatch(sk, VAR_CHSTR_TP[0])) *value = m_chStrTP[m_inputSubbsnID];
     else {
         throw ModelException(M_NUTRCH_QUAL2E[0], "GetValue",
                              "Parameter " + sk + " does not exist.");
@@ -1155,10 +1185,10 @@ void NutrCH_QUAL2E::Get1DData(const char* key, int* n, FLTPT** data) {
     else if (StringMatch(sk, VAR_PTTP2CH[0])) *data = m_ptTPToCh;
     else if (StringMatch(sk, VAR_PTCOD2CH[0])) *data = m_ptCODToCh;
         /// output nutrient storage in channel
-    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) *data = m_chNO3;
-    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) *data = m_chNH4;
-    else if (StringMatch(sk, VAR_CHSTR_TN[0])) *data = m_chTN;
-    else if (StringMatch(sk, VAR_CHSTR_TP[0])) *data = m_chTP;
+    else if (StringMatch(sk, VAR_CHSTR_NO3[0])) *data = m_chStrNO3;
+    else if (StringMatch(sk, VAR_CHSTR_NH4[0])) *data = m_chStrNH4;
+    else if (StringMatch(sk, VAR_CHSTR_TN[0])) *data = m_chStrTN;
+    else if (StringMatch(sk, VAR_CHSTR_TP[0])) *data = m_chStrTP;
     else {
         throw ModelException(M_NUTRCH_QUAL2E[0], "Get1DData",
                              "Parameter " + sk + " does not exist.");
@@ -14,6 +14,9 @@
  *        -# Remove LayeringMethod variable and m_qUpReach, which are useless.
  *        -# Code review and reformat.
  *   - 5. 2022-08-22 - lj - Change float to FLTPT.
+ *   - 6. 2026-10-19 - lj - Nutrient storages in reach are accumulated in the precision of
+ *                          accumulators (FLTACC), and exported by FLTPT copies.
+ *   - 7. 2026-10-19 - lj - Route reaches by ReachScheduler instead of stream order layers.
  *
  * \author Huiran Gao, Junzhi Liu, Liangjun Zhu
  */
@@ -21,6 +24,7 @@
 #define SEIMS_MODULE_NUTRCH_QUAL2E_H
 
 #include "SimulationModule.h"
+#include "ChannelRoutingCommon.h"
 
 /** \defgroup NutrCH_QUAL2E
  * \ingroup Nutrient
@@ -75,6 +79,12 @@ private:
 
     void NutrientTransform(int i);
 
+    /// Update exported copies of nutrient storages of reach \a i
+    void UpdateExportedStorage(int i);
+
+    /// Nutrient transformation and routing of reach \a i
+    void ReachRouting(int i);
+
     /*!
     * \brief Corrects rate constants for temperature.
     *
@@ -108,6 +118,8 @@ private:
      * value: reach ID of current stream order
      */
     map<int, vector<int> > m_reachLayers;
+    /// Reach-tree scheduler according to upstream reaches
+    ReachScheduler m_reachScheduler;
     /// scenario data
 
     /* point source operations
@@ -238,29 +250,34 @@ private:
 
     /// nutrient amount stored in reach
     /// algal biomass storage in reach (kg)
-    FLTPT* m_chAlgae;
+    FLTACC* m_chAlgae;
     /// organic nitrogen storage in reach (kg)
-    FLTPT* m_chOrgN;
+    FLTACC* m_chOrgN;
     /// ammonia storage in reach (kg)
-    FLTPT* m_chNH4;
+    FLTACC* m_chNH4;
     /// nitrite storage in reach (kg)
-    FLTPT* m_chNO2;
+    FLTACC* m_chNO2;
     /// nitrate storage in reach (kg)
-    FLTPT* m_chNO3;
+    FLTACC* m_chNO3;
     /// total nitrogen in reach (kg)
-    FLTPT* m_chTN;
+    FLTACC* m_chTN;
     /// organic phosphorus storage in reach (kg)
-    FLTPT* m_chOrgP;
+    FLTACC* m_chOrgP;
     /// dissolved phosphorus storage in reach (kg)
-    FLTPT* m_chSolP;
+    FLTACC* m_chSolP;
     /// total phosphorus storage in reach (kg)
-    FLTPT* m_chTP;
+    FLTACC* m_chTP;
     /// carbonaceous oxygen demand in reach (kg)
-    FLTPT* m_chCOD;
+    FLTACC* m_chCOD;
     /// dissolved oxygen storage in reach (kg)
-    FLTPT* m_chDOx;
+    FLTACC* m_chDOx;
     /// chlorophyll-a storage in reach (kg)
-    FLTPT* m_chChlora;
+    FLTACC* m_chChlora;
+    /// exported copies of nitrate, ammonia, total nitrogen, and total phosphorus storage (kg)
+    FLTPT* m_chStrNO3;
+    FLTPT* m_chStrNH4;
+    FLTPT* m_chStrTN;
+    FLTPT* m_chStrTP;
     // saturation storage of dissolved oxygen (kg)
     FLTPT m_chSatDOx;
 
@@ -159,7 +159,7 @@ int NutrientinGroundwater::Execute() {
         FLTPT solpToSoil = revap * 0.001 * m_gwSolPConc[id] * 10.;
         FLTPT no3ToSoil_kg = no3ToSoil * subArea * 0.0001; /// kg/ha * m^2 / 10000. = kg
         FLTPT solpToSoil_kg = solpToSoil * subArea * 0.0001;
-        int* cells = subbasin->GetCells();
+        const int* cells = subbasin->GetCells();
         int index = 0;
         for (int i = 0; i < nCells; i++) {
             index = cells[i];
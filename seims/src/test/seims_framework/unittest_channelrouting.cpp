@@ -0,0 +1,46 @@
+#include "gtest/gtest.h"
+#include "src/seims_main/base/common_algorithm/ChannelRoutingCommon.h"
+#include "src/seims_main/base/util/easylogging++.h"
+
+// Storage of easylogging++ for the unit test executable, which is required by the SEIMS libraries
+INITIALIZE_EASYLOGGINGPP
+
+TEST(TestChannelRouting, KinematicCourant) {
+    // c = 5/3 * v, i.e., 5/3 * 2 m/s * 300 s / 100 m
+    EXPECT_NEAR(10., KinematicCourant(4., 2., 300., 100.), 1.e-9);
+    // Dry channel or degenerated geometry
+    EXPECT_DOUBLE_EQ(0., KinematicCourant(0., 2., 300., 100.));
+    EXPECT_DOUBLE_EQ(0., KinematicCourant(-1., 2., 300., 100.));
+    EXPECT_DOUBLE_EQ(0., KinematicCourant(4., 0., 300., 100.));
+    EXPECT_DOUBLE_EQ(0., KinematicCourant(4., 2., 300., 0.));
+}
+
+TEST(TestChannelRouting, CourantSubStepsZeroVelocity) {
+    EXPECT_EQ(1, CourantSubSteps(KinematicCourant(0., 2., 300., 100.), 1.));
+    EXPECT_EQ(1, CourantSubSteps(0., 1.));
+    // Limit 0 means the whole time step
+    EXPECT_EQ(1, CourantSubSteps(100., 0.));
+}
+
+TEST(TestChannelRouting, CourantSubStepsBoundary) {
+    // Exactly at the limit, the whole time step is used
+    EXPECT_EQ(1, CourantSubSteps(1., 1.));
+    EXPECT_EQ(2, CourantSubSteps(1. + 1.e-6, 1.));
+    // Exact multiples of the limit
+    EXPECT_EQ(2, CourantSubSteps(2., 1.));
+    EXPECT_EQ(4, CourantSubSteps(2., 0.5));
+    EXPECT_EQ(3, CourantSubSteps(2.5, 1.));
+    // Exactly the maximum number of sub-steps
+    EXPECT_EQ(MAX_CH_SUBSTEPS, CourantSubSteps(CVT_FLT(MAX_CH_SUBSTEPS), 1.));
+    EXPECT_EQ(MAX_CH_SUBSTEPS - 1, CourantSubSteps(CVT_FLT(MAX_CH_SUBSTEPS - 1), 1.));
+}
+
+TEST(TestChannelRouting, CourantSubStepsClamped) {
+    EXPECT_EQ(64, MAX_CH_SUBSTEPS);
+    EXPECT_EQ(MAX_CH_SUBSTEPS, CourantSubSteps(CVT_FLT(MAX_CH_SUBSTEPS) + 0.5f, 1.));
+    EXPECT_EQ(MAX_CH_SUBSTEPS, CourantSubSteps(1.e6, 1.));
+    EXPECT_EQ(MAX_CH_SUBSTEPS, CourantSubSteps(KinematicCourant(1000., 1., 3600., 10.), 1.));
+    // User-specified maximum
+    EXPECT_EQ(8, CourantSubSteps(100., 1., 8));
+    EXPECT_EQ(5, CourantSubSteps(5., 1., 8));
+}
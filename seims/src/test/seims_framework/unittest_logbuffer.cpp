@@ -0,0 +1,186 @@
+#include "gtest/gtest.h"
+#include "src/seims_main/base/util/LogBuffer.h"
+#include "utils_string.h"
+#include "utils_time.h"
+
+#include <thread>
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
+using namespace utils_string;
+using namespace utils_time;
+
+namespace {
+struct CapturedLog {
+    int level;
+    string msg;
+};
+
+std::mutex captured_mutex;
+vector<CapturedLog> captured;
+
+void CaptureSink(const int level, const char* logger, const char* file, const int line, const string& msg) {
+    std::lock_guard<std::mutex> lock(captured_mutex);
+    CapturedLog log = {level, msg};
+    captured.push_back(log);
+}
+
+int CountCaptured(const string& substr) {
+    std::lock_guard<std::mutex> lock(captured_mutex);
+    int count = 0;
+    for (auto it = captured.begin(); it != captured.end(); ++it) {
+        if (it->msg.find(substr) != string::npos) { count++; }
+    }
+    return count;
+}
+
+int Evaluate(int& evaluated) {
+    evaluated++;
+    return evaluated;
+}
+
+// Write to the capturing sink directly, i.e., without active buffer
+class TestLogBuffer: public testing::Test {
+protected:
+    void SetUp() OVERRIDE {
+        captured.clear();
+        LogBuffer::Context().buffer = nullptr;
+        LogBuffer::Context().sink = CaptureSink;
+        LogBuffer::SetLevel(SEIMS_LOG_INFO);
+    }
+
+    void TearDown() OVERRIDE {
+        LogBuffer::Context().sink = nullptr;
+        LogBuffer::SetLevel(SEIMS_LOG_INFO);
+        captured.clear();
+    }
+};
+} /* namespace */
+
+TEST_F(TestLogBuffer, RingOverflow) {
+    // Long interval so that the messages are drained explicitly
+    LogBuffer buffer(4, CaptureSink, 1);
+    buffer.Start(60000);
+    for (int i = 0; i < 10; i++) {
+        string msg = "message " + ValueToString(i);
+        buffer.Push(SEIMS_LOG_INFO, "default", __FILE__, __LINE__, msg);
+    }
+    EXPECT_EQ(0, CountCaptured("message"));
+    buffer.Drain();
+    ASSERT_EQ(5, CVT_INT(captured.size()));
+    // The messages kept by the ring are in order, the others are dropped and counted
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ("message " + ValueToString(i), captured[i].msg);
+    }
+    EXPECT_EQ(SEIMS_LOG_WARNING, captured[4].level);
+    EXPECT_EQ(1, CountCaptured("6 log messages are dropped"));
+    // The ring is available again after draining
+    string msg = "message 10";
+    buffer.Push(SEIMS_LOG_INFO, "default", __FILE__, __LINE__, msg);
+    buffer.Stop();
+    EXPECT_EQ(1, CountCaptured("message 10"));
+    EXPECT_EQ(6, CVT_INT(captured.size()));
+}
+
+TEST_F(TestLogBuffer, NoSlotOrStopped) {
+    LogBuffer buffer(4, CaptureSink, 1);
+    // Not started, written to the sink directly
+    string msg = "before start";
+    buffer.Push(SEIMS_LOG_INFO, "default", __FILE__, __LINE__, msg);
+    EXPECT_EQ(1, CountCaptured("before start"));
+    buffer.Start(60000);
+    msg = "main thread";
+    buffer.Push(SEIMS_LOG_INFO, "default", __FILE__, __LINE__, msg);
+    // The only slot has been claimed by the main thread
+    std::thread other([&buffer]() {
+        string other_msg = "other thread";
+        buffer.Push(SEIMS_LOG_INFO, "default", __FILE__, __LINE__, other_msg);
+    });
+    other.join();
+    EXPECT_EQ(1, CountCaptured("other thread"));
+    EXPECT_EQ(0, CountCaptured("main thread"));
+    buffer.Stop();
+    EXPECT_EQ(1, CountCaptured("main thread"));
+}
+
+TEST_F(TestLogBuffer, LevelGating) {
+    int evaluated = 0;
+    LogBuffer::SetLevel(SEIMS_LOG_WARNING);
+    SLOG(DEBUG) << "debug " << Evaluate(evaluated);
+    SLOG(INFO) << "info " << Evaluate(evaluated);
+    SCLOG(INFO, "default") << "info " << Evaluate(evaluated);
+    EXPECT_EQ(0, evaluated);
+    EXPECT_TRUE(captured.empty());
+    SLOG(WARNING) << "warning " << Evaluate(evaluated);
+    SLOG(ERROR) << "error " << Evaluate(evaluated);
+    EXPECT_EQ(2, evaluated);
+    ASSERT_EQ(2, CVT_INT(captured.size()));
+    EXPECT_EQ(SEIMS_LOG_WARNING, captured[0].level);
+    EXPECT_EQ("warning 1", captured[0].msg);
+    EXPECT_EQ("error 2", captured[1].msg);
+    // Sampled messages are gated by the level of sampler as well
+    LogSampler sampler(SEIMS_LOG_INFO, "default", 10);
+    SLOG_SAMPLED(sampler, 0) << Evaluate(evaluated);
+    EXPECT_EQ(2, evaluated);
+    EXPECT_EQ(0, sampler.Count());
+}
+
+TEST_F(TestLogBuffer, SamplerPerStep) {
+    time_t step1 = 1420070400; // 2015-01-01
+    time_t step2 = step1 + 86400;
+    int evaluated = 0;
+    {
+        // The first 2 messages, then one of every 3 messages
+        LogSampler sampler(SEIMS_LOG_WARNING, "default", 2, 3);
+        for (int i = 0; i < 10; i++) {
+            SLOG_SAMPLED(sampler, step1) << "sampled " << Evaluate(evaluated);
+        }
+        // i.e., 0, 1, 2, 5, and 8
+        EXPECT_EQ(5, evaluated);
+        EXPECT_EQ(0, CountCaptured("suppressed"));
+        // The first message of a new step reports the suppressed ones of the previous step
+        SLOG_SAMPLED(sampler, step2) << "sampled " << Evaluate(evaluated);
+        EXPECT_EQ(6, evaluated);
+        EXPECT_EQ(1, CountCaptured("5 similar messages are suppressed at " + ConvertToString2(step1)));
+        for (int i = 0; i < 2; i++) {
+            SLOG_SAMPLED(sampler, step2) << "sampled " << Evaluate(evaluated);
+        }
+        EXPECT_EQ(8, evaluated);
+        EXPECT_EQ(13, sampler.Count());
+    }
+    // The destructor reports nothing since all messages of step2 are sampled
+    EXPECT_EQ(1, CountCaptured("suppressed"));
+    EXPECT_EQ(8, CountCaptured("sampled"));
+    {
+        LogSampler sampler(SEIMS_LOG_WARNING, "default", 1);
+        for (int i = 0; i < 4; i++) {
+            SLOG_SAMPLED(sampler, step2) << "once";
+        }
+    }
+    EXPECT_EQ(1, CountCaptured("once"));
+    EXPECT_EQ(1, CountCaptured("3 similar messages are suppressed at " + ConvertToString2(step2)));
+}
+
+TEST_F(TestLogBuffer, SamplerParallel) {
+    // The first messages of each step are always sampled, even the step is switched concurrently
+    LogSampler sampler(SEIMS_LOG_WARNING, "default", 5);
+    time_t step0 = 1420070400;
+    const int n_steps = 50;
+    const int n_msgs = 200;
+#ifdef SUPPORT_OMP
+    omp_set_num_threads(4);
+#endif /* SUPPORT_OMP */
+    for (int s = 0; s < n_steps; s++) {
+        time_t step = step0 + s * 86400;
+        int sampled = 0;
+#pragma omp parallel for reduction(+:sampled)
+        for (int i = 0; i < n_msgs; i++) {
+            if (sampler.Sample(step)) { sampled++; }
+        }
+        EXPECT_EQ(5, sampled);
+    }
+    EXPECT_EQ(n_steps * n_msgs, sampler.Count());
+    EXPECT_EQ(n_steps - 1, CountCaptured("195 similar messages are suppressed"));
+}
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "src/seims_main/base/data/clsZoneIndex.h"
+
+#ifdef SUPPORT_OMP
+#include <omp.h>
+#endif /* SUPPORT_OMP */
+
+namespace {
+// 10 cells of zone 1, 3, and 4, zone 0 and 2 are absent, negative IDs are ignored
+const int kCells = 10;
+const int kZones[kCells] = {3, 1, -9999, 3, 4, 1, 3, -1, 4, 3};
+const FLTPT kValues[kCells] = {1., 2., 100., 3., 4., 5., 6., 100., 7., 8.};
+
+// Set the number of threads in a scope, so that both paths of ZoneIndex::Reduce() are covered
+class ScopedThreads {
+public:
+    explicit ScopedThreads(const int n) : n_(1) {
+#ifdef SUPPORT_OMP
+        n_ = omp_get_max_threads();
+        omp_set_num_threads(n);
+#endif /* SUPPORT_OMP */
+    }
+    ~ScopedThreads() {
+#ifdef SUPPORT_OMP
+        omp_set_num_threads(n_);
+#endif /* SUPPORT_OMP */
+    }
+private:
+    int n_;
+};
+} /* namespace */
+
+TEST(TestZoneIndex, Build) {
+    ZoneIndex index(kCells, kZones);
+    EXPECT_EQ(kCells, index.GetCellNumber());
+    EXPECT_EQ(3, index.GetZoneNumber());
+    EXPECT_EQ(4, index.GetMaxZoneID());
+    ASSERT_EQ(3, CVT_INT(index.GetZoneIDs().size()));
+    EXPECT_EQ(1, index.GetZoneIDs()[0]);
+    EXPECT_EQ(3, index.GetZoneIDs()[1]);
+    EXPECT_EQ(4, index.GetZoneIDs()[2]);
+    EXPECT_EQ(-1, index.GetZoneSequence(0));
+    EXPECT_EQ(-1, index.GetZoneSequence(2));
+    EXPECT_EQ(1, index.GetZoneSequence(3));
+    EXPECT_EQ(-1, index.GetZoneSequence(5));
+    // Cells are ascending within each zone, and the ignored cells are excluded
+    EXPECT_EQ(8, index.GetOffsets().back());
+    ASSERT_EQ(4, index.GetZoneCellCount(1));
+    const int* cells = index.GetZoneCells(1);
+    EXPECT_EQ(0, cells[0]);
+    EXPECT_EQ(3, cells[1]);
+    EXPECT_EQ(6, cells[2]);
+    EXPECT_EQ(9, cells[3]);
+}
+
+TEST(TestZoneIndex, SumManyZones) {
+    ScopedThreads threads(1); // 3 zones >= 2 * threads
+    ZoneIndex index(kCells, kZones);
+    FLTPT sums[5] = {-1., -1., -1., -1., -1.};
+    index.Sum(kValues, sums);
+    EXPECT_DOUBLE_EQ(7., sums[1]);
+    EXPECT_DOUBLE_EQ(18., sums[3]);
+    EXPECT_DOUBLE_EQ(11., sums[4]);
+    // Absent zones are untouched
+    EXPECT_DOUBLE_EQ(-1., sums[0]);
+    EXPECT_DOUBLE_EQ(-1., sums[2]);
+}
+
+TEST(TestZoneIndex, SumFewZones) {
+    ScopedThreads threads(2); // 3 zones < 2 * threads if OpenMP is supported
+    ZoneIndex index(kCells, kZones);
+    FLTPT sums[5] = {-1., -1., -1., -1., -1.};
+    index.Sum(kValues, sums);
+    EXPECT_DOUBLE_EQ(7., sums[1]);
+    EXPECT_DOUBLE_EQ(18., sums[3]);
+    EXPECT_DOUBLE_EQ(11., sums[4]);
+    EXPECT_DOUBLE_EQ(-1., sums[0]);
+    EXPECT_DOUBLE_EQ(-1., sums[2]);
+}
+
+TEST(TestZoneIndex, Mean) {
+    ZoneIndex index(kCells, kZones);
+    FLTPT means[5] = {0., 0., 0., 0., 0.};
+    index.Mean(kValues, means);
+    EXPECT_DOUBLE_EQ(3.5, means[1]);
+    EXPECT_DOUBLE_EQ(4.5, means[3]);
+    EXPECT_DOUBLE_EQ(5.5, means[4]);
+}
+
+TEST(TestZoneIndex, ReduceFunctor) {
+    ZoneIndex index(kCells, kZones);
+    FLTPT sums[5] = {0., 0., 0., 0., 0.};
+    // e.g., the first column of a 2D array in IUH_OL
+    index.Reduce([](const int i) { return CVT_DBL(i); }, sums);
+    EXPECT_DOUBLE_EQ(6., sums[1]);  // 1 + 5
+    EXPECT_DOUBLE_EQ(18., sums[3]); // 0 + 3 + 6 + 9
+    EXPECT_DOUBLE_EQ(12., sums[4]); // 4 + 8
+    index.Reduce([](const int i) { return CVT_DBL(i); }, sums, true);
+    EXPECT_DOUBLE_EQ(3., sums[1]);
+    EXPECT_DOUBLE_EQ(4.5, sums[3]);
+    EXPECT_DOUBLE_EQ(6., sums[4]);
+}
+
+TEST(TestZoneIndex, FloatingZones) {
+    FLTPT zones[kCells];
+    for (int i = 0; i < kCells; i++) {
+        zones[i] = CVT_FLT(kZones[i]);
+    }
+    ZoneIndex index(kCells, zones);
+    EXPECT_EQ(3, index.GetZoneNumber());
+    EXPECT_EQ(4, index.GetMaxZoneID());
+    FLTPT sums[5] = {0., 0., 0., 0., 0.};
+    index.Sum(kValues, sums);
+    EXPECT_DOUBLE_EQ(7., sums[1]);
+    EXPECT_DOUBLE_EQ(18., sums[3]);
+    EXPECT_DOUBLE_EQ(11., sums[4]);
+}
+
+TEST(TestZoneIndex, SingleZone) {
+    // One subbasin in the MPI version, parallel within the segment
+    const int n = 1000;
+    int zones[n];
+    FLTPT values[n];
+    for (int i = 0; i < n; i++) {
+        zones[i] = 2;
+        values[i] = CVT_FLT(i % 10);
+    }
+    ScopedThreads threads(2);
+    ZoneIndex index(n, zones);
+    EXPECT_EQ(1, index.GetZoneNumber());
+    FLTPT sums[3] = {0., 0., 0.};
+    index.Sum(values, sums);
+    EXPECT_DOUBLE_EQ(4500., sums[2]);
+    index.Mean(values, sums);
+    EXPECT_DOUBLE_EQ(4.5, sums[2]);
+}
+
+TEST(TestZoneIndex, NoValidZone) {
+    const int zones[3] = {-1, -9999, -1};
+    ZoneIndex index(3, zones);
+    EXPECT_EQ(0, index.GetZoneNumber());
+    EXPECT_EQ(-1, index.GetMaxZoneID());
+    EXPECT_EQ(1, CVT_INT(index.GetOffsets().size()));
+    FLTPT sums[1] = {-1.};
+    index.Sum(kValues, sums);
+    EXPECT_DOUBLE_EQ(-1., sums[0]);
+}